@@ -0,0 +1,204 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_audio_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  AAC bitstream filter handle
+ *
+ * @note  Bitstream filter converts AAC transport format without decoding, frame payload is kept bit exact:
+ *          - Raw AAC: MP4 sample or RTMP AAC packet, stream information is carried by AudioSpecificConfig (ASC)
+ *          - ADTS: TS (stream type 0x0F) or `.aac` file
+ *          - LOAS: LATM in LOAS AudioSyncStream, TS stream type 0x11 used by DVB and ATSC
+ *        When output is the same as input or output is raw AAC from ADTS, output points into input directly (zero copy)
+ *        Otherwise header is rewritten into user provided output buffer together with payload
+ *        Each process call handles one frame, input can start with garbage before sync word for ADTS and LOAS
+ */
+typedef void *esp_aac_bsf_handle_t;
+
+/**
+ * @brief  AAC transport format
+ */
+typedef enum {
+    ESP_AAC_BSF_FMT_RAW  = 0, /*!< Raw AAC frame (raw_data_block), stream information from ASC */
+    ESP_AAC_BSF_FMT_ADTS = 1, /*!< AAC frame with ADTS header */
+    ESP_AAC_BSF_FMT_LOAS = 2, /*!< LOAS AudioSyncStream carrying LATM AudioMuxElement */
+} esp_aac_bsf_fmt_t;
+
+/**
+ * @brief  AAC stream information carried by AudioSpecificConfig
+ */
+typedef struct {
+    uint8_t  object_type;     /*!< Audio object type, 2 for AAC-LC */
+    uint32_t sample_rate;     /*!< Core sample rate */
+    uint32_t ext_sample_rate; /*!< SBR output sample rate for explicit HE-AAC signaling, 0 if not signaled */
+    uint8_t  channel;         /*!< Channel number, 1 to 6 or 8 */
+    bool     frame_960;       /*!< Frame has 960 samples instead of 1024 */
+} esp_aac_bsf_asc_info_t;
+
+/**
+ * @brief  AAC bitstream filter configuration
+ */
+typedef struct {
+    esp_aac_bsf_fmt_t in_fmt;              /*!< Input format */
+    esp_aac_bsf_fmt_t out_fmt;             /*!< Output format */
+    const uint8_t    *asc;                 /*!< AudioSpecificConfig, required when `in_fmt` is raw */
+    uint8_t           asc_len;             /*!< AudioSpecificConfig length */
+    uint16_t          mux_config_interval; /*!< For LOAS output, repeat StreamMuxConfig every N frames
+                                                0 means write it in first frame only */
+} esp_aac_bsf_cfg_t;
+
+/**
+ * @brief  AAC bitstream filter input
+ */
+typedef struct {
+    uint8_t *buffer;   /*!< Input data */
+    uint32_t len;      /*!< Input data size, one frame for raw AAC */
+    uint32_t consumed; /*!< Consumed input size (output) */
+} esp_aac_bsf_in_t;
+
+/**
+ * @brief  AAC bitstream filter output
+ */
+typedef struct {
+    uint8_t *buffer;      /*!< User buffer to hold rewritten frame */
+    uint32_t len;         /*!< User buffer size */
+    uint8_t *data;        /*!< Converted frame (output), points into input buffer when zero copy */
+    uint32_t size;        /*!< Converted frame size (output), 0 if input frame is dropped */
+    uint32_t needed_size; /*!< Set when `buffer` is not enough to hold converted frame (output) */
+} esp_aac_bsf_out_t;
+
+/**
+ * @brief  Generate AudioSpecificConfig
+ *
+ * @param[in]      info     Stream information
+ * @param[out]     asc      Buffer to store AudioSpecificConfig
+ * @param[in,out]  asc_len  Input buffer size (at least 2, 8 is enough for all cases), output AudioSpecificConfig size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Buffer not enough
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_gen_asc(esp_aac_bsf_asc_info_t *info, uint8_t *asc, uint8_t *asc_len);
+
+/**
+ * @brief  Parse AudioSpecificConfig
+ *
+ * @param[in]   asc      AudioSpecificConfig
+ * @param[in]   asc_len  AudioSpecificConfig size
+ * @param[out]  info     Stream information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Not AAC object or program config element used
+ *       - ESP_AUDIO_ERR_HEADER_PARSE       Broken AudioSpecificConfig
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_parse_asc(const uint8_t *asc, uint32_t asc_len, esp_aac_bsf_asc_info_t *info);
+
+/**
+ * @brief  Generate 7 bytes ADTS header for raw AAC frame
+ *
+ * @note  Used for scatter write (header then payload) so that payload need not be copied
+ *        HE-AAC is written as AAC-LC with core sample rate (implicit SBR signaling)
+ *
+ * @param[in]   info          Stream information
+ * @param[in]   payload_size  Raw AAC frame size
+ * @param[out]  header        Buffer to store ADTS header (7 bytes)
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Object type, sample rate or frame size not representable by ADTS
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_gen_adts_header(esp_aac_bsf_asc_info_t *info, uint32_t payload_size, uint8_t *header);
+
+/**
+ * @brief  Open AAC bitstream filter
+ *
+ * @param[in]   cfg     Bitstream filter configuration
+ * @param[out]  handle  Bitstream filter handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        AudioSpecificConfig not supported
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_open(esp_aac_bsf_cfg_t *cfg, esp_aac_bsf_handle_t *handle);
+
+/**
+ * @brief  Convert one frame
+ *
+ * @note  When `ESP_AUDIO_ERR_BUFF_NOT_ENOUGH` is returned, `consumed` is 0,
+ *        enlarge `out->buffer` to `needed_size` and call again with the same input
+ *        LOAS frames before first StreamMuxConfig are consumed with `out->size` set to 0
+ *        When `ESP_AUDIO_ERR_NOT_SUPPORT` is returned, the whole frame is consumed so that
+ *        the caller can go on with the next frame
+ *
+ * @param[in]      handle  Bitstream filter handle
+ * @param[in,out]  in      Input data
+ * @param[in,out]  out     Output frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success or data skipped
+ *       - ESP_AUDIO_ERR_DATA_LACK          Input not hold one whole frame, feed more data
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output buffer not enough
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Frame can not be converted (multiple raw data blocks or sub frames),
+ *                                          it is skipped
+ *       - ESP_AUDIO_ERR_HEADER_PARSE       Broken header, sync word is consumed so that next call can resync
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_process(esp_aac_bsf_handle_t handle, esp_aac_bsf_in_t *in, esp_aac_bsf_out_t *out);
+
+/**
+ * @brief  Get stream information
+ *
+ * @note  Use `esp_aac_bsf_gen_asc` to get AudioSpecificConfig for MP4 or RTMP from it
+ *
+ * @param[in]   handle  Bitstream filter handle
+ * @param[out]  info    Stream information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND          No frame header parsed yet
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_get_asc_info(esp_aac_bsf_handle_t handle, esp_aac_bsf_asc_info_t *info);
+
+/**
+ * @brief  Reset AAC bitstream filter
+ *
+ * @note  Stream information is kept, LOAS output writes StreamMuxConfig in next frame
+ *
+ * @param[in]  handle  Bitstream filter handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_bsf_reset(esp_aac_bsf_handle_t handle);
+
+/**
+ * @brief  Close AAC bitstream filter
+ *
+ * @param[in]  handle  Bitstream filter handle
+ */
+void esp_aac_bsf_close(esp_aac_bsf_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -36,6 +36,9 @@ extern "C" {
 
 /**
  * @brief  Recovery strategy for tht current frame
+ *
+ * @note  Lost frame is only recovered by PLC. Recovering lost OPUS frame from in-band FEC (LBRR) data
+ *        carried by the next packet is not supported by decoder, the redundancy in next packet is ignored
  */
 typedef enum {
     ESP_AUDIO_DEC_RECOVERY_NONE = 0, /*!< The current frame is a normal decoded frame */
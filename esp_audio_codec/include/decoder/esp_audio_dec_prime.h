@@ -0,0 +1,120 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_audio_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Audio decoder prime handle
+ *
+ * @note  After seek (e.g. `esp_extractor_seek`) decoders with inter-frame state need some frames to warm up
+ *        (MDCT overlap, MP3 bit reservoir, LPC or predictor state), output of these frames is not wanted
+ *        Prime updates decoder state with those frames without handing any PCM to user:
+ *          - Decoders without inter-frame state (PCM, G711, ADPCM, FLAC, ALAC) skip the data directly, no decoding at all
+ *          - Other decoders decode into one internal scratch buffer reused for all prime frames,
+ *            output buffer reallocation and PCM post-processing in user side are avoided
+ *        Priming is a full decode of each prime frame, it costs the same CPU as normal decoding and only saves
+ *        the output handling. Keep prime frame count small, for MP3 use `esp_audio_dec_get_prime_frames_by_frame`
+ *        to get the count the target frame really needs
+ *        Typical usage:
+ *
+ * @code{c}
+ *           // Seek to `esp_audio_dec_get_prime_frames(type)` frames before target position
+ *           esp_audio_dec_reset(decoder);
+ *           esp_audio_dec_prime_open(type, decoder, &prime);
+ *           for (int i = 0; i < prime_frames; i++) {
+ *               esp_audio_dec_in_raw_t raw = {.buffer = frame_data, .len = frame_size};
+ *               esp_audio_dec_prime_process(prime, &raw);
+ *           }
+ *           esp_audio_dec_prime_close(prime);
+ *           // Continue `esp_audio_dec_process` from target frame
+ * @endcode
+ */
+typedef void *esp_audio_dec_prime_handle_t;
+
+/**
+ * @brief  Get recommended frame count to prime decoder after seek
+ *
+ * @note  Returned count covers MDCT overlap, for MP3 it covers the full bit reservoir of MPEG1 at 128 kbps
+ *        and above only, lower bitrate and MPEG2 need more, see `esp_audio_dec_get_prime_frames_by_frame`
+ *        For OPUS it covers 80ms pre-roll (RFC 7845 section 4.6) with 20ms frame, adjust for other frame duration
+ *        Returns 0 for decoders without inter-frame state, they can start decoding from target frame directly
+ *
+ * @param[in]  type  Audio decoder type
+ *
+ * @return
+ *       - Frame count to be primed before target frame
+ */
+uint8_t esp_audio_dec_get_prime_frames(esp_audio_type_t type);
+
+/**
+ * @brief  Get frame count to prime decoder after seek from the target frame data
+ *
+ * @note  For MP3 Layer III the count is derived from `main_data_begin` of the target frame: enough previous frames
+ *        to hold the bit reservoir bytes it refers to, plus one for IMDCT overlap. Previous frames are assumed to
+ *        have the same size as the target frame, VBR streams with smaller previous frames may need more
+ *        For other types, free format MP3 or data not holding the frame header and side info,
+ *        it falls back to `esp_audio_dec_get_prime_frames`
+ *
+ * @param[in]  type   Audio decoder type
+ * @param[in]  frame  Target frame data starting from frame header
+ * @param[in]  len    Length of `frame`
+ *
+ * @return
+ *       - Frame count to be primed before target frame
+ */
+uint8_t esp_audio_dec_get_prime_frames_by_frame(esp_audio_type_t type, const uint8_t *frame, uint32_t len);
+
+/**
+ * @brief  Open prime handle for opened audio decoder
+ *
+ * @param[in]   type     Audio type of `decoder`
+ * @param[in]   decoder  Audio decoder handle opened by `esp_audio_dec_open`
+ * @param[out]  prime    Prime handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - ESP_AUDIO_ERR_MEM_LACK           No enough memory
+ */
+esp_audio_err_t esp_audio_dec_prime_open(esp_audio_type_t type, esp_audio_dec_handle_t decoder,
+                                         esp_audio_dec_prime_handle_t *prime);
+
+/**
+ * @brief  Prime decoder with encoded data, no PCM data is output
+ *
+ * @note  Input data and `consumed` follow the same rule as `esp_audio_dec_process`
+ *        Output buffer not enough is handled internally, no need to retry
+ *
+ * @param[in]      prime  Prime handle
+ * @param[in,out]  raw    Input encoded data
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - ESP_AUDIO_ERR_MEM_LACK           No enough memory
+ *       - Others                           Error returned by `esp_audio_dec_process`
+ */
+esp_audio_err_t esp_audio_dec_prime_process(esp_audio_dec_prime_handle_t prime, esp_audio_dec_in_raw_t *raw);
+
+/**
+ * @brief  Close prime handle
+ *
+ * @note  Decoder handle is not closed, user can continue `esp_audio_dec_process` with it
+ *
+ * @param[in]  prime  Prime handle
+ */
+void esp_audio_dec_prime_close(esp_audio_dec_prime_handle_t prime);
+
+#ifdef __cplusplus
+}
+#endif
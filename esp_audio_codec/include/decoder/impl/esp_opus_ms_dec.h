@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_audio_dec_reg.h"
+#include "esp_opus_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OPUS_MS_DEC_MAX_CHANNEL (8)
+
+/**
+ * @brief  Configuration for OPUS multistream decoder
+ *
+ * @note  Stream layout follows `OpusHead` identification header (RFC 7845 section 5.1.1),
+ *        use `esp_opus_ms_dec_parse_head` to fill it from `codec_spec_info` of encoder or OGG extractor.
+ *        Each input packet must be one complete multistream packet,
+ *        all but the last stream use self-delimited framing (RFC 6716 appendix B).
+ *        Output PCM is 16 bits interleaved in channel order of the header (Vorbis order for channel mapping family 1).
+ */
+typedef struct {
+    uint32_t                      sample_rate;                           /*!< Output sample rate, support 8000, 12000, 16000, 24000, 48000 */
+    uint8_t                       channel;                               /*!< Output channel, support 1 - 8 */
+    uint8_t                       stream_count;                          /*!< Stream count in each packet */
+    uint8_t                       coupled_count;                         /*!< Coupled (stereo) stream count, they come first in packet */
+    uint8_t                       mapping[ESP_OPUS_MS_DEC_MAX_CHANNEL];  /*!< Decoded channel index of each output channel
+                                                                              Index below 2 * `coupled_count` select channel inside coupled stream,
+                                                                              other index select mono stream, 255 output silence */
+    esp_opus_dec_frame_duration_t frame_duration;                        /*!< OPUS frame duration.
+                                                                              If frame duration set to `ESP_OPUS_DEC_FRAME_DURATION_INVALID`,
+                                                                              the out pcm size is counted as 60 ms frame */
+} esp_opus_ms_dec_cfg_t;
+
+/**
+ * @brief  Default decoder configuration for OPUS multistream (5.1 surround)
+ */
+#define ESP_OPUS_MS_DEC_CONFIG_DEFAULT() {                    \
+    .sample_rate       = ESP_AUDIO_SAMPLE_RATE_48K,           \
+    .channel           = 6,                                   \
+    .stream_count      = 4,                                   \
+    .coupled_count     = 2,                                   \
+    .mapping           = {0, 4, 1, 2, 3, 5},                  \
+    .frame_duration    = ESP_OPUS_DEC_FRAME_DURATION_INVALID, \
+}
+
+/**
+ * @brief  Register decoder operations for OPUS multistream
+ *
+ * @note  It is registered as `ESP_AUDIO_TYPE_OPUS` and overwrites the default OPUS decoder,
+ *        then `esp_opus_ms_dec_cfg_t` must be used as decoder configuration for OPUS type.
+ *        It is not registered by `esp_audio_dec_register_default`.
+ *        When user want to use OPUS multistream decoder only and not manage it by common part, no need to call this API,
+ *        And call `esp_opus_ms_dec_open`, `esp_opus_ms_dec_decode`, `esp_opus_ms_dec_close` instead.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_opus_ms_dec_register(void);
+
+/**
+ * @brief  Fill stream layout of decoder configuration from `OpusHead`
+ *
+ * @note  Only `channel`, `stream_count`, `coupled_count` and `mapping` are updated,
+ *        channel mapping family 0 gives one stream for mono or stereo
+ *
+ * @param[in]   head  `OpusHead` identification header
+ * @param[in]   size  Header size
+ * @param[out]  cfg   OPUS multistream decoder configuration
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_HEADER_PARSE       Not valid `OpusHead`
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Not supported channel mapping family or channel count
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_dec_parse_head(const uint8_t *head, uint32_t size, esp_opus_ms_dec_cfg_t *cfg);
+
+/**
+ * @brief  Open OPUS multistream decoder
+ *
+ * @param[in]   cfg         Should be pointer to `esp_opus_ms_dec_cfg_t`
+ * @param[in]   cfg_sz      Should be sizeof(esp_opus_ms_dec_cfg_t)
+ * @param[out]  dec_handle  The OPUS multistream decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - ESP_AUDIO_ERR_FAIL               Fail to initial decoder
+ */
+esp_audio_err_t esp_opus_ms_dec_open(void *cfg, uint32_t cfg_sz, void **dec_handle);
+
+/**
+ * @brief  Decode one OPUS multistream packet
+ *
+ * @note  Packet loss concealment request in `raw->frame_recover` is forwarded to every stream
+ *
+ * @param[in]      dec_handle  Decoder handle
+ * @param[in,out]  raw         Raw data to be decoded
+ * @param[in,out]  frame       Decoded PCM frame data
+ * @param[out]     dec_info    Information of decoder
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    No enough frame buffer to hold output PCM frame data
+ *       - ESP_AUDIO_ERR_FAIL               Fail to decode data
+ */
+esp_audio_err_t esp_opus_ms_dec_decode(void *dec_handle, esp_audio_dec_in_raw_t *raw, esp_audio_dec_out_frame_t *frame,
+                                       esp_audio_dec_info_t *dec_info);
+
+/**
+ * @brief  Reset of OPUS multistream decoder to its initial state
+ *
+ * @note  Reset mostly do following action:
+ *          - Reset internal processing state
+ *          - Flushing cached input or output buffer
+ *        After reset, user can reuse the handle without re-open which may time consuming
+ *        Typically use cases like: Seeking in same audio stream
+ *        This API is not thread-safe, avoid call it during processing
+ *
+ * @param[in]  dec_handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_dec_reset(void *dec_handle);
+
+/**
+ * @brief  Close OPUS multistream decoder
+ *
+ * @param[in]  dec_handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_dec_close(void *dec_handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  DSP kernel backend
+ *
+ * @note  All backends use integer arithmetic with the same rounding, so outputs are bit-exact with the reference.
+ *        Vector backend is built with GCC vector extensions (GCC 9 or later) using 64 bits lanes,
+ *        `ESP_AUDIO_DSP_BACKEND_AUTO` selects it on hosts with AVX2 or AArch64 where the lanes map to SIMD.
+ *        On chips without vector unit reachable by the compiler it is lowered to scalar code and reference is used.
+ */
+typedef enum {
+    ESP_AUDIO_DSP_BACKEND_AUTO   = 0,  /*!< Select the fastest backend for current platform */
+    ESP_AUDIO_DSP_BACKEND_REF    = 1,  /*!< Portable scalar reference */
+    ESP_AUDIO_DSP_BACKEND_VECTOR = 2,  /*!< GCC vector extension backend */
+} esp_audio_dsp_backend_t;
+
+/**
+ * @brief  Fixed-point MDCT description
+ *
+ * @note  Kernel is a `n / 2` rows by `n` columns matrix in Q30 with analysis window and gain folded in,
+ *        it suits short transforms like the 36 and 12 points MDCT of MP3 layer 3.
+ *        With sine window, overlap-add of `imdct(mdct(x))` gives `x * n / 4 / gain^2`
+ */
+typedef struct {
+    int            n;     /*!< Input length of MDCT (output length of IMDCT), must be even */
+    const int32_t *kern;  /*!< Q30 kernel generated by `esp_audio_dsp_mdct_gen_kernel` */
+} esp_audio_dsp_mdct_t;
+
+/**
+ * @brief  DSP kernel operations
+ *
+ * @note  `dot`, `fir`, `mdct` and `imdct` accumulate products in 64 bits without saturation, so the caller must keep
+ *        the sum of `|a[i] * b[i]|` below 2^63. Full scale 32 bits values on both sides overflow from 3 terms,
+ *        e.g. a 32 taps FIR on full scale input needs coefficients within 27 bits.
+ *        Only the final rounding right shift of `fir` and `interleave_s16` saturates.
+ */
+typedef struct {
+    int64_t (*dot)(const int32_t *a, const int32_t *b, int n);  /*!< Sum of a[i] * b[i] in 64 bits */
+    void (*fir)(const int32_t *coef, int taps, const int32_t *in, int32_t *out, int n,
+                int shift);                                     /*!< out[i] = (sum coef[k] * in[i + k]) >> shift with
+                                                                     rounding and saturation, `in` holds `n + taps - 1`
+                                                                     samples */
+    void (*mdct)(const esp_audio_dsp_mdct_t *mdct, const int32_t *in,
+                 int32_t *out);                                 /*!< `n` inputs to `n / 2` coefficients */
+    void (*imdct)(const esp_audio_dsp_mdct_t *mdct, const int32_t *in,
+                  int32_t *out);                                /*!< `n / 2` coefficients to `n` windowed outputs,
+                                                                     overlap-add is left to caller */
+    void (*interleave_s16)(const int32_t *const *in, int ch, int n, int shift,
+                           int16_t *out);                       /*!< Planar 32 bits to interleaved 16 bits with rounding
+                                                                     right shift and saturation */
+    void (*deinterleave_s16)(const int16_t *in, int ch, int n, int shift,
+                             int32_t *const *out);              /*!< Interleaved 16 bits to planar 32 bits with left
+                                                                     shift */
+} esp_audio_dsp_ops_t;
+
+/**
+ * @brief  Select DSP kernel backend used by codecs
+ *
+ * @note  Call it before opening codecs, not thread-safe with codecs running
+ *        If not called, `ESP_AUDIO_DSP_BACKEND_AUTO` is used
+ *
+ * @param[in]  backend  DSP kernel backend
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK           On success
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT  Backend not built for current platform
+ */
+esp_audio_err_t esp_audio_dsp_init(esp_audio_dsp_backend_t backend);
+
+/**
+ * @brief  Get operations of selected DSP kernel backend
+ *
+ * @return  DSP kernel operations, never NULL
+ */
+const esp_audio_dsp_ops_t *esp_audio_dsp_get_ops(void);
+
+/**
+ * @brief  Get operations of specified DSP kernel backend
+ *
+ * @note  Used to compare backends without changing the one used by codecs
+ *
+ * @param[in]  backend  DSP kernel backend
+ *
+ * @return
+ *       - NULL    Backend not built for current platform
+ *       - Others  DSP kernel operations
+ */
+const esp_audio_dsp_ops_t *esp_audio_dsp_get_backend_ops(esp_audio_dsp_backend_t backend);
+
+/**
+ * @brief  Generate Q30 MDCT kernel
+ *
+ * @note  kern[m][i] = win[i] * cos(pi / (2 * n) * (2 * i + 1 + n / 2) * (2 * m + 1)) / gain
+ *
+ * @param[in]   n     Input length of MDCT, must be even
+ * @param[in]   win   Analysis window of `n` points, NULL to use sine window
+ * @param[in]   gain  Gain divided from each kernel value
+ * @param[out]  kern  Kernel storage of `n * n / 2` values
+ */
+void esp_audio_dsp_mdct_gen_kernel(int n, const float *win, double gain, int32_t *kern);
+
+#ifdef __cplusplus
+}
+#endif
@@ -26,16 +26,21 @@
 #pragma once
 
 #include "esp_aac_enc.h"
+#include "esp_aac_mc_enc.h"
 #include "esp_adpcm_enc.h"
 #include "esp_alac_enc.h"
 #include "esp_g711_enc.h"
 #include "esp_amrwb_enc.h"
 #include "esp_amrnb_enc.h"
 #include "esp_opus_enc.h"
+#include "esp_opus_ms_enc.h"
 #include "esp_pcm_enc.h"
 #include "esp_sbc_enc.h"
 #include "esp_lc3_enc.h"
+#include "esp_lc3_batch_enc.h"
 #include "esp_g722_enc.h"
+#include "esp_mp3_enc.h"
+#include "esp_flac_enc.h"
 
 #ifdef __cplusplus
 extern "C" {
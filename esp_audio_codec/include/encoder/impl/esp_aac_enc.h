@@ -34,6 +34,10 @@ extern "C" {
 
 /**
  * @brief  AAC Encoder configurations
+ *
+ * @note  Encoder only outputs AAC-LC object type, HE-AAC (SBR) and HE-AACv2 (PS) encoding are not supported.
+ *        `codec_spec_info` always carries AAC-LC AudioSpecificConfig.
+ *        For low bitrate stereo stream (e.g. 48 Kbps), lower the sample rate (e.g. 16000 Hz) to fit the bitrate range below
  */
 typedef struct {
     int sample_rate;     /*!< Support sample rate(Hz) : 96000, 88200, 64000, 48000,
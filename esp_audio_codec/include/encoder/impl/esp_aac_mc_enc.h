@@ -0,0 +1,198 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "esp_audio_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_AAC_MC_ENC_MAX_CHANNEL (8)
+
+/**
+ * @brief  AAC multichannel encoder configurations
+ *
+ * @note  Channels are mapped to AAC-LC channel configuration (ISO/IEC 14496-3) by channel num.
+ *        Input channel order follows syntactic element order of the configuration:
+ *          | channel | configuration | input channel order          | elements                |
+ *          |   1     |   1           | C                            | SCE                     |
+ *          |   2     |   2           | L, R                         | CPE                     |
+ *          |   3     |   3           | C, L, R                      | SCE, CPE                |
+ *          |   4     |   4           | C, L, R, Cs                  | SCE, CPE, SCE           |
+ *          |   5     |   5           | C, L, R, Ls, Rs              | SCE, CPE, CPE           |
+ *          |   6     |   6 (5.1)     | C, L, R, Ls, Rs, LFE         | SCE, CPE, CPE, LFE      |
+ *          |   8     |   7 (7.1)     | C, L, R, Ls, Rs, Lb, Rb, LFE | SCE, CPE, CPE, CPE, LFE |
+ *        Each channel pair element is coded with joint stereo by one stereo encoder core,
+ *        single channel elements share the frame timing and are packed into the same raw data block.
+ *        LFE channel is low pass filtered at 120 Hz before encoding. Its core runs in VBR so the band limited
+ *        channel only takes a small share of the bitrate, and a frame where the core switches to short windows
+ *        is written as a silent LFE element to keep the stream conforming (LFE allows ONLY_LONG_SEQUENCE only).
+ */
+typedef struct {
+    int  sample_rate;     /*!< Support sample rate(Hz) : 96000, 88200, 64000, 48000,
+                               44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000 */
+    int  channel;         /*!< Support channel : 1, 2, 3, 4, 5, 6, 8 */
+    int  bits_per_sample; /*!< Support bits per sample : 16, 24, 32 bit
+                               24 bit input is packed as 3 bytes little endian
+                               Note : The encoder core codes 16 bit PCM, 24 and 32 bit input is rounded to 16 bit while
+                                      de-interleaving. It only saves a separate conversion pass, precision beyond
+                                      16 bit is not kept */
+    int  bitrate;         /*!< Total bitrate(bps) of all channels, for 5.1 and 7.1 12 kbps is kept for LFE,
+                               the rest is split to other elements by channel num and clamped into the range
+                               supported by `esp_aac_enc` per channel
+                               Set to 0 to use unconstrained VBR for all elements */
+    bool adts_used;       /*!< Whether write ADTS header: true - add ADTS header, false - raw aac data only */
+} esp_aac_mc_enc_config_t;
+
+#define ESP_AAC_MC_ENC_CONFIG_DEFAULT() {           \
+    .sample_rate     = ESP_AUDIO_SAMPLE_RATE_48K,   \
+    .channel         = 6,                           \
+    .bits_per_sample = ESP_AUDIO_BIT16,             \
+    .bitrate         = 384000,                      \
+    .adts_used       = true,                        \
+}
+
+/**
+ * @brief  Register AAC multichannel encoder
+ *
+ * @note  It is registered as `ESP_AUDIO_TYPE_AAC` and overwrites the default AAC encoder,
+ *        then `esp_aac_mc_enc_config_t` must be used as encoder configuration for AAC type.
+ *        It is not registered by `esp_audio_enc_register_default`.
+ *        When user want to use AAC multichannel encoder only and not manage it by common part, no need to call this API,
+ *        Directly call `esp_aac_mc_enc_open`, `esp_aac_mc_enc_process`, `esp_aac_mc_enc_close` instead.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_aac_mc_enc_register(void);
+
+/**
+ * @brief  Query frame information with encoder configuration
+ *
+ * @param[in]   cfg         AAC multichannel encoder configuration
+ * @param[out]  frame_info  The structure of frame information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to query frame information of encoder core
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info);
+
+/**
+ * @brief  Create AAC multichannel encoder handle through encoder configuration
+ *
+ * @param[in]   cfg     AAC multichannel encoder configuration
+ * @param[in]   cfg_sz  Size of "esp_aac_mc_enc_config_t"
+ * @param[out]  enc_hd  The AAC multichannel encoder handle. If handle allocation failed, will be set to NULL.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encoder initialize failed
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd);
+
+/**
+ * @brief  Set AAC multichannel encoder total bitrate
+ *
+ * @note  1. The current set function and processing function do not have lock protection, so when performing
+ *           asynchronous processing, special attention in needed to ensure data consistency and thread safety,
+ *           avoiding race conditions and resource conflicts.
+ *        2. The bitrate value can be get by `esp_aac_mc_enc_get_info`
+ *
+ * @param[in]  enc_hd   The AAC multichannel encoder handle
+ * @param[in]  bitrate  The total bitrate of all channels
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to set bitrate
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_set_bitrate(void *enc_hd, int bitrate);
+
+/**
+ * @brief  Get the input PCM data length and recommended output buffer length needed by encoding one frame
+ *
+ * @param[in]   enc_hd    The AAC multichannel encoder handle
+ * @param[out]  in_size   The input frame size
+ * @param[out]  out_size  The output frame size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size);
+
+/**
+ * @brief  Encode one or multi AAC frame which the frame num is dependent on input data length
+ *
+ * @param[in]      enc_hd     The AAC multichannel encoder handle
+ * @param[in]      in_frame   Pointer to input data frame
+ * @param[in,out]  out_frame  Pointer to output data frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encode error
+ *       - ESP_AUDIO_ERR_DATA_LACK          Not enough input data to encode one or several frames
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output buffer is not enough to hold encoded frames
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                       esp_audio_enc_out_frame_t *out_frame);
+
+/**
+ * @brief  Get AAC multichannel encoder information from encoder handle
+ *
+ * @note  1. `codec_spec_info` holds AudioSpecificConfig with channel configuration (2 bytes)
+ *        2. `bitrate` is the sum of element bitrates after clamping, it includes the 12 kbps LFE budget
+ *           only for layouts with an LFE channel
+ *
+ * @param[in]  enc_hd    The AAC multichannel encoder handle
+ * @param[in]  enc_info  The AAC multichannel encoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info);
+
+/**
+ * @brief  Reset of AAC multichannel encoder to its initial state
+ *
+ * @note  Reset mostly do following action:
+ *          - Reset internal processing state
+ *          - Flushing cached input or output buffer
+ *        After reset, user can reuse the handle without re-open which may time consuming
+ *        Typically use cases like: During encoding need to encode different audio stream
+ *        which the audio information (sample rate, channel, bits per sample) is not changed
+ *        This API is not thread-safe, avoid call it during processing
+ *
+ * @param[in]  enc_hd  The AAC multichannel encoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to reset
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_aac_mc_enc_reset(void *enc_hd);
+
+/**
+ * @brief  Deinitialize AAC multichannel encoder
+ *
+ * @param[in]  enc_hd  The AAC multichannel encoder handle.
+ */
+void esp_aac_mc_enc_close(void *enc_hd);
+
+#ifdef __cplusplus
+}
+#endif
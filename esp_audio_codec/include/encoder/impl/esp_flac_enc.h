@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_audio_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_FLAC_ENC_MAX_COMPRESSION_LEVEL     (8)
+#define ESP_FLAC_ENC_DEFAULT_COMPRESSION_LEVEL (5)
+
+/**
+ * @brief  FLAC Encoder configurations
+ *
+ * @note  Compression level trades CPU load for output size:
+ *          - Level 0 ~ 2: Fixed predictors only, block size 1152
+ *          - Level 3 ~ 6: LPC up to order 6 ~ 8, only the order estimated from prediction error is verified
+ *          - Level 7: LPC up to order 12, estimated order and its neighbours are verified
+ *          - Level 8: LPC up to order 12, all orders are verified
+ *        For stereo, level 0 and 3 code channels independently, level 1 and 4 select stereo mode by a quick
+ *        estimation, other levels try left/right, left/side, right/side and mid/side and keep the smallest.
+ *        FLAC format only defines decorrelation for stereo, so channels are always coded independently
+ *        when channel is larger than 2.
+ */
+typedef struct {
+    int     sample_rate;       /*!< The sample rate of audio. Support range: [1, 655350] */
+    uint8_t channel;           /*!< The channel num of audio. Support range: [1, 8] */
+    uint8_t bits_per_sample;   /*!< The bits per sample of audio. Support bits per sample: 16, 24 bit
+                                    24 bit input is packed as 3 bytes little endian */
+    uint8_t compression_level; /*!< Compression level. Support range: [0, 8] */
+    int     block_size;        /*!< Samples per channel of each frame. Support range: [16, 65535]
+                                    Set to 0 to use compression level default: 1152 for level 0 ~ 2, 4096 for others */
+} esp_flac_enc_config_t;
+
+#define ESP_FLAC_ENC_CONFIG_DEFAULT() {                             \
+    .sample_rate       = ESP_AUDIO_SAMPLE_RATE_44K,                 \
+    .channel           = ESP_AUDIO_DUAL,                            \
+    .bits_per_sample   = ESP_AUDIO_BIT16,                           \
+    .compression_level = ESP_FLAC_ENC_DEFAULT_COMPRESSION_LEVEL,    \
+    .block_size        = 0,                                         \
+}
+
+/**
+ * @brief  Register FLAC encoder
+ *
+ * @note  If user want to use encoder through encoder common API, need register it firstly.
+ *        Register can use either of following methods:
+ *          1: Manually call `esp_flac_enc_register`.
+ *          2: Call `esp_audio_enc_register_default` and use menuconfig to enable it.
+ *        When user want to use FLAC encoder only and not manage it by common part, no need to call this API,
+ *        Directly call `esp_flac_enc_open`, `esp_flac_enc_process`, `esp_flac_enc_close` instead.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_flac_enc_register(void);
+
+/**
+ * @brief  Query frame information with encoder configuration
+ *
+ * @note  The output frame size is the worst case size of one frame, real frame is much smaller in general
+ *
+ * @param[in]   cfg         FLAC encoder configuration
+ * @param[out]  frame_info  The structure of frame information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info);
+
+/**
+ * @brief  Create FLAC encoder handle through encoder configuration
+ *
+ * @param[in]   cfg     FLAC encoder configuration
+ * @param[in]   cfg_sz  Size of "esp_flac_enc_config_t"
+ * @param[out]  enc_hd  The FLAC encoder handle. If FLAC encoder handle allocation failed, will be set to NULL.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encoder initialize failed
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd);
+
+/**
+ * @brief  Get the input PCM data length and recommended output buffer length needed by encoding one frame
+ *
+ * @param[in]   enc_hd    The FLAC encoder handle
+ * @param[out]  in_size   The input frame size
+ * @param[out]  out_size  The output frame size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size);
+
+/**
+ * @brief  Encode one or multi FLAC frame which the frame num is dependent on input data length
+ *
+ * @note  When input data is less than one frame but holds at least one sample for every channel,
+ *        it is encoded as a shorter frame. This is only allowed for the last frame of the stream.
+ *
+ * @param[in]      enc_hd     The FLAC encoder handle
+ * @param[in]      in_frame   Pointer to input data frame
+ * @param[in,out]  out_frame  Pointer to output data frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_DATA_LACK          Not enough input data to encode one or several frames
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output buffer is not enough to hold encoded frames
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                     esp_audio_enc_out_frame_t *out_frame);
+
+/**
+ * @brief  Get FLAC encoder information from encoder handle
+ *
+ * @note  `codec_spec_info` holds the "fLaC" stream marker followed by STREAMINFO metadata block (42 bytes).
+ *        Write it before the first frame to produce a native FLAC file, or hand it to container which needs
+ *        FLAC stream header such as OGG or CAF.
+ *        Minimum and maximum frame size and total samples are updated by encoded frames, so call it again
+ *        after encoding finished to get the final one. MD5 signature is not calculated and is set to 0.
+ *
+ * @param[in]  enc_hd    The FLAC encoder handle
+ * @param[in]  enc_info  The FLAC encoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info);
+
+/**
+ * @brief  Reset of FLAC encoder to its initial state
+ *
+ * @note  Reset mostly do following action:
+ *          - Reset internal processing state
+ *          - Flushing cached input or output buffer
+ *        After reset, user can reuse the handle without re-open which may time consuming
+ *        Typically use cases like: During encoding need to encode different audio stream
+ *        which the audio information (sample rate, channel, bits per sample) is not changed
+ *        This API is not thread-safe, avoid call it during processing
+ *
+ * @param[in]  enc_hd  The FLAC encoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_flac_enc_reset(void *enc_hd);
+
+/**
+ * @brief  Deinitialize FLAC encoder
+ *
+ * @param[in]  enc_hd  The FLAC encoder handle.
+ */
+void esp_flac_enc_close(void *enc_hd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_audio_types.h"
+#include "esp_audio_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_LC3_BATCH_ENC_MAX_BIS (8)
+
+/**
+ * @brief  LC3 batch encoder handle
+ *
+ * @note  Used for LE Audio broadcast (Auracast) where one source sends several Broadcast Isochronous Streams (BIS),
+ *        like left, right and per-language tracks. Each BIS carries one channel and has its own `nbyte`.
+ *        All BIS share sample rate, bits per sample and frame duration, so configuration check, frame size query
+ *        and timestamp are done once per call, and packets for all BIS are emitted by one call.
+ *        Frame data of each BIS is identical to `esp_lc3_enc` opened with channel 1 and the same `nbyte`.
+ */
+typedef void *esp_lc3_batch_enc_handle_t;
+
+/**
+ * @brief  LC3 batch encoder configuration
+ */
+typedef struct {
+    uint32_t sample_rate;                          /*!< The audio sample rate,
+                                                        this must be 8000, 16000, 24000, 32000, 44100 or 48000 Hz */
+    uint8_t  bits_per_sample;                      /*!< The audio bits per sample, this must be 16, 24, 32 */
+    uint8_t  frame_dms;                            /*!< The audio frame duration in dms, this must be 75 or 100 */
+    uint8_t  bis_num;                              /*!< Number of BIS, range [1, ESP_LC3_BATCH_ENC_MAX_BIS] */
+    uint16_t nbyte[ESP_LC3_BATCH_ENC_MAX_BIS];     /*!< Bytes per frame of each BIS, the supported range is (20, 400) */
+    bool     len_prefixed;                         /*!< Prefix each packet with 2-byte big endian frame length */
+} esp_lc3_batch_enc_config_t;
+
+#define ESP_LC3_BATCH_ENC_CONFIG_DEFAULT() {  \
+    .sample_rate     = 48000,                 \
+    .bits_per_sample = 16,                    \
+    .frame_dms       = 100,                   \
+    .bis_num         = 2,                     \
+    .nbyte           = {100, 100},            \
+    .len_prefixed    = false,                 \
+}
+
+/**
+ * @brief  Open LC3 batch encoder
+ *
+ * @param[in]   cfg     LC3 batch encoder configuration
+ * @param[out]  handle  The LC3 batch encoder handle. If handle allocation failed, will be set to NULL
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encoder initialize failed
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_open(esp_lc3_batch_enc_config_t *cfg, esp_lc3_batch_enc_handle_t *handle);
+
+/**
+ * @brief  Get the input PCM size of one channel and output buffer size of each BIS needed by encoding one frame
+ *
+ * @param[in]   handle    The LC3 batch encoder handle
+ * @param[out]  in_size   The input frame size of one BIS (one channel)
+ * @param[out]  out_size  Array of `bis_num` to store output frame size of each BIS (can be NULL)
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_get_frame_size(esp_lc3_batch_enc_handle_t handle, int *in_size, int *out_size);
+
+/**
+ * @brief  Change `nbyte` of one BIS
+ *
+ * @note  Takes effect from next frame, not thread-safe with `esp_lc3_batch_enc_process`
+ *
+ * @param[in]  handle  The LC3 batch encoder handle
+ * @param[in]  bis     BIS index
+ * @param[in]  nbyte   Bytes per frame, the supported range is (20, 400)
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_set_nbyte(esp_lc3_batch_enc_handle_t handle, uint8_t bis, uint16_t nbyte);
+
+/**
+ * @brief  Encode one or multiple frames for all BIS from separated channel buffers
+ *
+ * @note  `in[i].len` must be the same for all BIS and one or several times of `in_size`
+ *        `out[i].len` must be not less than frame count multiply output frame size of BIS `i`
+ *        `out[i].pts` is set to the presentation time of first frame in millisecond
+ *
+ * @param[in]      handle  The LC3 batch encoder handle
+ * @param[in]      in      Array of `bis_num` input channel buffers
+ * @param[in,out]  out     Array of `bis_num` output packets
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encode error
+ *       - ESP_AUDIO_ERR_DATA_LACK          Input length mismatch or not an integer multiple of the frame size
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Not enough output buffer to store encoded data
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_process(esp_lc3_batch_enc_handle_t handle, esp_audio_enc_in_frame_t *in,
+                                          esp_audio_enc_out_frame_t *out);
+
+/**
+ * @brief  Encode one or multiple frames for all BIS from interleaved input
+ *
+ * @note  Input holds `bis_num` interleaved channels, channel `i` is sent to BIS `i`
+ *        `in->len` must be one or several times of `in_size * bis_num`
+ *
+ * @param[in]      handle  The LC3 batch encoder handle
+ * @param[in]      in      Interleaved input PCM
+ * @param[in,out]  out     Array of `bis_num` output packets
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encode error
+ *       - ESP_AUDIO_ERR_DATA_LACK          Input length is not an integer multiple of the frame size
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Not enough output buffer to store encoded data
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_process_interleaved(esp_lc3_batch_enc_handle_t handle, esp_audio_enc_in_frame_t *in,
+                                                      esp_audio_enc_out_frame_t *out);
+
+/**
+ * @brief  Get encoder information of one BIS
+ *
+ * @param[in]   handle    The LC3 batch encoder handle
+ * @param[in]   bis       BIS index
+ * @param[out]  enc_info  The LC3 encoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_get_info(esp_lc3_batch_enc_handle_t handle, uint8_t bis, esp_audio_enc_info_t *enc_info);
+
+/**
+ * @brief  Reset LC3 batch encoder to its initial state
+ *
+ * @param[in]  handle  The LC3 batch encoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_lc3_batch_enc_reset(esp_lc3_batch_enc_handle_t handle);
+
+/**
+ * @brief  Close LC3 batch encoder
+ *
+ * @param[in]  handle  The LC3 batch encoder handle
+ */
+void esp_lc3_batch_enc_close(esp_lc3_batch_enc_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
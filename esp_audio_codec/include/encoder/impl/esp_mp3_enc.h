@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_audio_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Encoder delay in samples, output of decoder is further delayed by `ESP_MP3_ENC_DECODER_DELAY`
+ */
+#define ESP_MP3_ENC_DELAY_SAMPLES (528)
+
+/**
+ * @brief  Decoder delay in samples of MPEG Layer III synthesis filter bank (LAME tag convention)
+ */
+#define ESP_MP3_ENC_DECODER_DELAY (529)
+
+/**
+ * @brief  MP3 encoder rate control mode
+ */
+typedef enum {
+    ESP_MP3_ENC_RC_MODE_CBR = 0, /*!< Constant bitrate, every frame uses `bitrate` */
+    ESP_MP3_ENC_RC_MODE_VBR = 1, /*!< Variable bitrate, frame bitrate is selected by `vbr_quality`
+                                      and never exceeds `bitrate` */
+} esp_mp3_enc_rc_mode_t;
+
+/**
+ * @brief  MP3 encoder psychoacoustic mode
+ */
+typedef enum {
+    ESP_MP3_ENC_PSY_MODE_NORMAL = 0, /*!< Masking threshold per scale factor band with scale factor shaping,
+                                          mid/side stereo decision and Huffman region search */
+    ESP_MP3_ENC_PSY_MODE_FAST   = 1, /*!< Global gain only quantization for low CPU usage */
+} esp_mp3_enc_psy_mode_t;
+
+/**
+ * @brief  MP3 Encoder configurations
+ */
+typedef struct {
+    int                    sample_rate;     /*!< Support sample rate(Hz) : 48000, 44100, 32000 (MPEG-1 Layer III),
+                                                 24000, 22050, 16000 (MPEG-2 Layer III) */
+    int                    channel;         /*!< Support channel : mono, dual */
+    int                    bits_per_sample; /*!< Support bits per sample : 16 bit */
+    int                    bitrate;         /*!< Support bitrate(bps) :
+                                                 MPEG-1: 32000, 40000, 48000, 56000, 64000, 80000, 96000, 112000,
+                                                         128000, 160000, 192000, 224000, 256000, 320000
+                                                 MPEG-2: 8000, 16000, 24000, 32000, 40000, 48000, 56000, 64000,
+                                                         80000, 96000, 112000, 128000, 144000, 160000
+                                                 Note : 1) Unlisted value is rounded down to the nearest supported one
+                                                        2) In VBR mode it is the upper limit of frame bitrate,
+                                                           set to 0 to use the highest bitrate */
+    esp_mp3_enc_rc_mode_t  rc_mode;         /*!< Rate control mode */
+    int                    vbr_quality;     /*!< VBR quality from 0 (best) to 9 (smallest), only for VBR mode */
+    esp_mp3_enc_psy_mode_t psy_mode;        /*!< Psychoacoustic mode */
+} esp_mp3_enc_config_t;
+
+#define ESP_MP3_ENC_CONFIG_DEFAULT() {              \
+    .sample_rate     = ESP_AUDIO_SAMPLE_RATE_44K,   \
+    .channel         = ESP_AUDIO_DUAL,              \
+    .bits_per_sample = ESP_AUDIO_BIT16,             \
+    .bitrate         = 128000,                      \
+    .rc_mode         = ESP_MP3_ENC_RC_MODE_CBR,     \
+    .vbr_quality     = 4,                           \
+    .psy_mode        = ESP_MP3_ENC_PSY_MODE_NORMAL, \
+}
+
+/**
+ * @brief  Register MP3 encoder
+ *
+ * @note  If user want to use encoder through encoder common API, need register it firstly.
+ *        Register can use either of following methods:
+ *          1: Manually call `esp_mp3_enc_register`.
+ *          2: Call `esp_audio_enc_register_default` and use menuconfig to enable it.
+ *        When user want to use MP3 encoder only and not manage it by common part, no need to call this API,
+ *        Directly call `esp_mp3_enc_open`, `esp_mp3_enc_process`, `esp_mp3_enc_close` instead.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_mp3_enc_register(void);
+
+/**
+ * @brief  Query frame information with encoder configuration
+ *
+ * @note  The output frame size is the largest frame size allowed by the configured bitrate
+ *
+ * @param[in]   cfg         MP3 encoder configuration
+ * @param[out]  frame_info  The structure of frame information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info);
+
+/**
+ * @brief  Create MP3 encoder handle through encoder configuration
+ *
+ * @param[in]   cfg     MP3 encoder configuration
+ * @param[in]   cfg_sz  Size of "esp_mp3_enc_config_t"
+ * @param[out]  enc_hd  The MP3 encoder handle. If MP3 encoder handle allocation failed, will be set to NULL.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encoder initialize failed
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd);
+
+/**
+ * @brief  Set MP3 encoder bitrate
+ *
+ * @note  1. The current set function and processing function do not have lock protection, so when performing
+ *           asynchronous processing, special attention in needed to ensure data consistency and thread safety,
+ *           avoiding race conditions and resource conflicts.
+ *        2. The bitrate value can be get by `esp_mp3_enc_get_info`
+ *        3. In VBR mode it changes the upper limit of frame bitrate
+ *        4. Accepts the same values as `bitrate` in `esp_mp3_enc_config_t`, including 0 in VBR mode
+ *
+ * @param[in]  enc_hd   The MP3 encoder handle
+ * @param[in]  bitrate  The bitrate of MP3
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_set_bitrate(void *enc_hd, int bitrate);
+
+/**
+ * @brief  Get the input PCM data length and recommended output buffer length needed by encoding one frame
+ *
+ * @param[in]   enc_hd    The MP3 encoder handle
+ * @param[out]  in_size   The input frame size
+ * @param[out]  out_size  The output frame size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size);
+
+/**
+ * @brief  Encode one or multi MP3 frame which the frame num is dependent on input data length
+ *
+ * @note  Each output frame is self-contained (`main_data_begin` is always 0), so any frame boundary is a
+ *        valid cutting point for streaming. Bits are still shared between granules and channels inside one frame.
+ *
+ * @param[in]      enc_hd     The MP3 encoder handle
+ * @param[in]      in_frame   Pointer to input data frame
+ * @param[in,out]  out_frame  Pointer to output data frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_DATA_LACK          Not enough input data to encode one or several frames
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output buffer is not enough to hold encoded frames
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame, esp_audio_enc_out_frame_t *out_frame);
+
+/**
+ * @brief  Get MP3 encoder information from encoder handle
+ *
+ * @note  The reported bitrate is the one actually coded: the configured bitrate rounded down to the nearest
+ *        bitrate of current MPEG version, e.g. 320000 at 24000 Hz is reported as 160000.
+ *        In VBR mode it is the upper limit of frame bitrate
+ *
+ * @param[in]  enc_hd    The MP3 encoder handle
+ * @param[in]  enc_info  The MP3 encoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info);
+
+/**
+ * @brief  Get Xing/Info frame with LAME tag for gapless playback and seeking
+ *
+ * @note  The tag frame is a silent MP3 frame which should be placed before the first encoded frame.
+ *        It carries frame count, stream size, seek table, encoder delay and padding.
+ *        Typical usage:
+ *          1. Call with `buffer` set to NULL to query tag frame size, reserve space at start of file
+ *          2. Encode all frames, append silence after last valid sample to flush the encoder,
+ *             padding of at least `ESP_MP3_ENC_DECODER_DELAY` samples is required
+ *          3. Call again with total valid sample number, write tag frame into the reserved space
+ *        Tag for CBR is written as "Info" and VBR as "Xing" following LAME convention
+ *        Decoders start output after `ESP_MP3_ENC_DELAY_SAMPLES` + `ESP_MP3_ENC_DECODER_DELAY` samples
+ *        and stop after `valid_samples`
+ *
+ * @param[in]      enc_hd         The MP3 encoder handle
+ * @param[in]      valid_samples  Total valid input samples (per channel) excluding appended silence
+ *                                Set to 0 to keep all samples which decoder can output
+ * @param[out]     buffer         Buffer to hold tag frame, set to NULL to query size only
+ * @param[in,out]  size           Input buffer size, output tag frame size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Buffer is not enough to hold tag frame
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter or not enough padding samples encoded
+ */
+esp_audio_err_t esp_mp3_enc_get_info_tag(void *enc_hd, uint64_t valid_samples, uint8_t *buffer, int *size);
+
+/**
+ * @brief  Reset of MP3 encoder to its initial state
+ *
+ * @note  Reset mostly do following action:
+ *          - Reset internal processing state
+ *          - Flushing cached input or output buffer
+ *        After reset, user can reuse the handle without re-open which may time consuming
+ *        Typically use cases like: During encoding need to encode different audio stream
+ *        which the audio information (sample rate, channel, bits per sample) is not changed
+ *        This API is not thread-safe, avoid call it during processing
+ *
+ * @param[in]  enc_hd  The MP3 encoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_mp3_enc_reset(void *enc_hd);
+
+/**
+ * @brief  Deinitialize MP3 encoder
+ *
+ * @param[in]  enc_hd  The MP3 encoder handle.
+ */
+void esp_mp3_enc_close(void *enc_hd);
+
+#ifdef __cplusplus
+}
+#endif
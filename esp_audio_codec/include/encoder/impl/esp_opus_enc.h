@@ -88,7 +88,9 @@ typedef struct {
                                                            This must be 2.5, 5, 10, 20, 40, 60, 80, 100, 120 ms. */
     esp_opus_enc_application_t    application_mode;   /*!< The application mode. */
     int                           complexity;         /*!< Indicates the complexity of OPUS encoding. 0 is lowest. 10 is higest.*/
-    bool                          enable_fec;         /*!< Configures the encoder's use of inband forward error correction (FEC) */
+    bool                          enable_fec;         /*!< Configures the encoder's use of inband forward error correction (FEC)
+                                                           FEC data is used by far end decoder which supports it,
+                                                           `esp_opus_dec` recovers lost frame by PLC only */
     bool                          enable_dtx;         /*!< Configures the encoder's use of discontinuous transmission (DTX).
                                                            DTX activation condition: 1) The sample_rate must be 8000, 12000 or 16000Hz
                                                                                      2) The application_mode must set to `ESP_OPUS_ENC_APPLICATION_VOIP`
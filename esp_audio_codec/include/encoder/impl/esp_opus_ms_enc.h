@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include "esp_audio_enc.h"
+#include "esp_opus_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ESP_OPUS_MS_ENC_MAX_CHANNEL (8)
+
+/**
+ * @brief  OPUS multistream encoder configurations
+ *
+ * @note  Channels are coded as Opus multistream packet (RFC 7845 channel mapping family 1).
+ *        Input channel order follows Vorbis channel order:
+ *          | channel | input channel order                  | streams | coupled streams |
+ *          |   1     | C                                    |   1     |   0             |
+ *          |   2     | L, R                                 |   1     |   1             |
+ *          |   3     | L, C, R                              |   2     |   1             |
+ *          |   4     | FL, FR, RL, RR                       |   2     |   2             |
+ *          |   5     | FL, C, FR, RL, RR                    |   3     |   2             |
+ *          |   6     | FL, C, FR, RL, RR, LFE               |   4     |   2             |
+ *          |   7     | FL, C, FR, SL, SR, RC, LFE           |   4     |   3             |
+ *          |   8     | FL, C, FR, SL, SR, RL, RR, LFE       |   5     |   3             |
+ *        Each coupled stream is coded by one stereo encoder core with joint stereo between the channel pair,
+ *        other channels are coded by mono encoder cores.
+ *        Packets of all streams are concatenated into one multistream packet per frame,
+ *        all but the last stream use self-delimited framing (RFC 6716 appendix B).
+ *        1 and 2 channels produce normal Opus packet with channel mapping family 0.
+ */
+typedef struct {
+    int                           sample_rate;      /*!< The sample rate of OPUS audio, must be one of 8000, 12000, 16000, 24000, or 48000 */
+    int                           channel;          /*!< The number of channels, support 1 - 8 */
+    int                           bits_per_sample;  /*!< The bits per sample of OPUS audio, must be 16 */
+    int                           bitrate;          /*!< Total bitrate(bps) of all streams, it is split to streams by weight
+                                                         (coupled stream 3, mono stream 2, LFE stream 1)
+                                                         and clamped into the range of `esp_opus_enc_config_t` per stream
+                                                         Set to `ESP_OPUS_BITRATE_AUTO` to let each stream choose bitrate */
+    esp_opus_enc_frame_duration_t frame_duration;   /*!< The duration of one frame */
+    esp_opus_enc_application_t    application_mode; /*!< The application mode */
+    int                           complexity;       /*!< Indicates the complexity of OPUS encoding. 0 is lowest. 10 is highest */
+    bool                          enable_fec;       /*!< Configures the use of inband forward error correction (FEC) for all streams */
+    bool                          enable_dtx;       /*!< Configures the use of discontinuous transmission (DTX) for all streams */
+    bool                          enable_vbr;       /*!< Configures to enable or disable variable bitrate mode for all streams */
+} esp_opus_ms_enc_config_t;
+
+#define ESP_OPUS_MS_ENC_CONFIG_DEFAULT() {                   \
+    .sample_rate        = ESP_AUDIO_SAMPLE_RATE_48K,         \
+    .channel            = 6,                                 \
+    .bits_per_sample    = ESP_AUDIO_BIT16,                   \
+    .bitrate            = 256000,                            \
+    .frame_duration     = ESP_OPUS_ENC_FRAME_DURATION_20_MS, \
+    .application_mode   = ESP_OPUS_ENC_APPLICATION_AUDIO,    \
+    .complexity         = 0,                                 \
+    .enable_fec         = false,                             \
+    .enable_dtx         = false,                             \
+    .enable_vbr         = false,                             \
+}
+
+/**
+ * @brief  Register OPUS multistream encoder
+ *
+ * @note  It is registered as `ESP_AUDIO_TYPE_OPUS` and overwrites the default OPUS encoder,
+ *        then `esp_opus_ms_enc_config_t` must be used as encoder configuration for OPUS type.
+ *        It is not registered by `esp_audio_enc_register_default`.
+ *        When user want to use OPUS multistream encoder only and not manage it by common part, no need to call this API,
+ *        Directly call `esp_opus_ms_enc_open`, `esp_opus_ms_enc_process`, `esp_opus_ms_enc_close` instead.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_opus_ms_enc_register(void);
+
+/**
+ * @brief  Query frame information with encoder configuration
+ *
+ * @param[in]   cfg         OPUS multistream encoder configuration
+ * @param[out]  frame_info  The structure of frame information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to query frame information of encoder core
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info);
+
+/**
+ * @brief  Create OPUS multistream encoder handle through encoder configuration
+ *
+ * @param[in]   cfg     OPUS multistream encoder configuration
+ * @param[in]   cfg_sz  Size of "esp_opus_ms_enc_config_t"
+ * @param[out]  enc_hd  The OPUS multistream encoder handle. If handle allocation failed, will be set to NULL.
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encoder initialize failed
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd);
+
+/**
+ * @brief  Set OPUS multistream encoder total bitrate
+ *
+ * @note  1. The current set function and processing function do not have lock protection, so when performing
+ *           asynchronous processing, special attention in needed to ensure data consistency and thread safety,
+ *           avoiding race conditions and resource conflicts.
+ *        2. The bitrate value can be get by `esp_opus_ms_enc_get_info`
+ *
+ * @param[in]  enc_hd   The OPUS multistream encoder handle
+ * @param[in]  bitrate  The total bitrate of all streams
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to set bitrate
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_set_bitrate(void *enc_hd, int bitrate);
+
+/**
+ * @brief  Get the input PCM data length and recommended output buffer length needed by encoding one frame
+ *
+ * @param[in]   enc_hd    The OPUS multistream encoder handle
+ * @param[out]  in_size   The input frame size
+ * @param[out]  out_size  The output frame size
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size);
+
+/**
+ * @brief  Encode one or multi OPUS multistream frame which the frame num is dependent on input data length
+ *
+ * @note  Output contains one multistream packet per frame without length prefix,
+ *        to keep packet boundaries for container (like OGG) feed one frame per call
+ *
+ * @param[in]      enc_hd     The OPUS multistream encoder handle
+ * @param[in]      in_frame   Pointer to input data frame
+ * @param[in,out]  out_frame  Pointer to output data frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Encode error
+ *       - ESP_AUDIO_ERR_DATA_LACK          Not enough input data to encode one or several frames
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output buffer is not enough to hold encoded frames
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                        esp_audio_enc_out_frame_t *out_frame);
+
+/**
+ * @brief  Get OPUS multistream encoder information from encoder handle
+ *
+ * @note  `codec_spec_info` holds `OpusHead` identification header (RFC 7845 section 5.1)
+ *        with stream count, coupled stream count and channel mapping, it can be passed to OGG muxer directly
+ *        and to `esp_opus_ms_dec_parse_head` on decoder side
+ *
+ * @param[in]  enc_hd    The OPUS multistream encoder handle
+ * @param[in]  enc_info  The OPUS multistream encoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info);
+
+/**
+ * @brief  Reset of OPUS multistream encoder to its initial state
+ *
+ * @note  Reset mostly do following action:
+ *          - Reset internal processing state
+ *          - Flushing cached input or output buffer
+ *        After reset, user can reuse the handle without re-open which may time consuming
+ *        Typically use cases like: During encoding need to encode different audio stream
+ *        which the audio information (sample rate, channel, bits per sample) is not changed
+ *        This API is not thread-safe, avoid call it during processing
+ *
+ * @param[in]  enc_hd  The OPUS multistream encoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to reset
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_opus_ms_enc_reset(void *enc_hd);
+
+/**
+ * @brief  Deinitialize OPUS multistream encoder
+ *
+ * @param[in]  enc_hd  The OPUS multistream encoder handle.
+ */
+void esp_opus_ms_enc_close(void *enc_hd);
+
+#ifdef __cplusplus
+}
+#endif
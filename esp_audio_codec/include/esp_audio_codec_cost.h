@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_types.h"
+#include "esp_audio_enc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Codec direction which cost figures belong to
+ */
+typedef enum {
+    ESP_AUDIO_CODEC_DIR_ENC = 0,  /*!< Encoder */
+    ESP_AUDIO_CODEC_DIR_DEC = 1,  /*!< Decoder */
+} esp_audio_codec_dir_t;
+
+/**
+ * @brief  Cost figures of one codec under one sample rate and channel
+ *
+ * @note  Figures are kept per (direction, type, sample rate, channel), publishing another entry with the same key
+ *        replaces the old one. Built-in figures are measured on ESP32-S3 at 240 MHz (see Performance in README),
+ *        applications on other chips or settings should measure and publish their own figures.
+ */
+typedef struct {
+    esp_audio_codec_dir_t dir;               /*!< Encoder or decoder */
+    esp_audio_type_t      type;              /*!< Audio codec type */
+    uint32_t              sample_rate;       /*!< Sample rate the figures measured at */
+    uint8_t               channel;           /*!< Channel the figures measured at */
+    uint16_t              frame_samples;     /*!< Samples per channel of one frame */
+    uint32_t              cycles_per_frame;  /*!< CPU cycles to process one frame of one channel */
+    uint32_t              ram_size;          /*!< Internal RAM footprint in bytes */
+    uint32_t              psram_size;        /*!< PSRAM footprint in bytes */
+    uint32_t              delay_samples;     /*!< Algorithmic delay in samples, include frame buffering and look ahead */
+    uint32_t              min_bitrate;       /*!< Minimum bitrate (bps) of all channels, 0 if not applicable */
+    uint32_t              max_bitrate;       /*!< Maximum bitrate (bps) of all channels, 0 if not applicable */
+} esp_audio_codec_cost_t;
+
+/**
+ * @brief  Codec selection request
+ *
+ * @note  Zero value means no limit for all `max_xxx` fields
+ */
+typedef struct {
+    uint32_t min_sample_rate;  /*!< Lowest acceptable sample rate, entries of higher sample rate also take part */
+    uint8_t  channel;          /*!< Channel number */
+    uint32_t max_bitrate;      /*!< Bitrate budget (bps), codec whose minimum bitrate exceeds it is skipped */
+    uint32_t max_delay_ms;     /*!< Latency target in milliseconds */
+    uint32_t max_cycles;       /*!< CPU budget in cycles per second */
+    uint32_t max_ram_size;     /*!< Internal RAM budget in bytes */
+} esp_audio_codec_select_req_t;
+
+/**
+ * @brief  Codec selection result
+ */
+typedef struct {
+    esp_audio_codec_cost_t cost;     /*!< Cost figures of selected codec */
+    uint32_t               bitrate;  /*!< Suggested bitrate, highest one fit into the budget, 0 if not applicable */
+    uint32_t               cycles;   /*!< Estimated CPU cycles per second */
+    uint32_t               delay_ms; /*!< Algorithmic delay in milliseconds */
+} esp_audio_codec_select_res_t;
+
+/**
+ * @brief  Publish cost figures of one codec
+ *
+ * @note  Not thread-safe, call it before `esp_audio_codec_cost_select`.
+ *        Published figures take precedence over built-in ones with the same key.
+ *
+ * @param[in]  cost  Cost figures
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_codec_cost_publish(const esp_audio_codec_cost_t *cost);
+
+/**
+ * @brief  Get cost figures of one codec
+ *
+ * @param[in]   dir          Encoder or decoder
+ * @param[in]   type         Audio codec type
+ * @param[in]   sample_rate  Sample rate
+ * @param[in]   channel      Channel
+ * @param[out]  cost         Cost figures
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND          No figures for this setting
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_codec_cost_get(esp_audio_codec_dir_t dir, esp_audio_type_t type, uint32_t sample_rate,
+                                         uint8_t channel, esp_audio_codec_cost_t *cost);
+
+/**
+ * @brief  Measure cost figures of encoder on current chip
+ *
+ * @note  Encoder must be registered. CPU cycles are measured around `esp_audio_enc_process` with generated PCM,
+ *        so the result contains interrupt and task switch overhead if any.
+ *        Delay and bitrate range are copied from existing figures with the same key, if not exist,
+ *        delay is set to one frame and bitrate range is set to the configured bitrate.
+ *        The result is not published, call `esp_audio_codec_cost_publish` to make it take effect.
+ *
+ * @param[in]   cfg     Encoder configuration
+ * @param[in]   frames  Frames to encode for measurement
+ * @param[out]  cost    Measured cost figures
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - Others                           Fail to open encoder or encode
+ */
+esp_audio_err_t esp_audio_codec_cost_measure_enc(esp_audio_enc_config_t *cfg, int frames, esp_audio_codec_cost_t *cost);
+
+/**
+ * @brief  Select the cheapest registered codec which meets the request
+ *
+ * @note  Codec with least CPU cycles per second is selected, RAM footprint is compared when cycles are equal.
+ *        Only codecs registered by `esp_audio_enc_register` or `esp_audio_dec_register` are considered.
+ *        For dynamic downgrade under CPU pressure, lower `max_cycles` and select again.
+ *
+ * @param[in]   dir  Encoder or decoder
+ * @param[in]   req  Selection request
+ * @param[out]  res  Selection result
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND          No codec meets the request
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_codec_cost_select(esp_audio_codec_dir_t dir, esp_audio_codec_select_req_t *req,
+                                            esp_audio_codec_select_res_t *res);
+
+/**
+ * @brief  Remove all published cost figures, built-in figures are kept
+ */
+void esp_audio_codec_cost_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_types.h"
+#include "esp_audio_simple_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Gapless playback helper for audio simple decoder
+ *
+ * @note  Lossy encoders add priming samples (encoder delay) at start of stream and padding samples at end.
+ *        Without removing them, consecutive tracks get silence gaps and clicks at track transition.
+ *        This helper works in 2 steps:
+ *          1. `esp_audio_gapless_parse` extracts delay and valid sample count from stream metadata:
+ *             - MP3: Xing/Info frame with LAME tag (encoder delay, padding and frame count)
+ *             - M4A: `iTunSMPB` metadata, or edit list (`elst`) of the audio track
+ *             - OGG: Opus pre-skip from `OpusHead`, valid samples from granule position of last page
+ *          2. Gapless handle trims decoded PCM returned by `esp_audio_simple_dec_process` in place
+ *             Leading samples are dropped by moving data inside output frame, tail samples by shrinking `decoded_size`
+ *             So it needs no extra buffering and no flush at track end
+ *        Usage:
+ * @code{c}
+ *        esp_audio_gapless_info_t gapless = {0};
+ *        // Parse from file header, for OGG call again with file tail to get valid sample count
+ *        esp_audio_gapless_parse(ESP_AUDIO_SIMPLE_DEC_TYPE_MP3, head_data, head_size, &gapless);
+ *        esp_audio_gapless_handle_t trim = NULL;
+ *        esp_audio_gapless_open(&gapless, &trim);
+ *        while (decoding) {
+ *            esp_audio_simple_dec_process(decoder, &raw, &out);
+ *            if (out.decoded_size) {
+ *                esp_audio_simple_dec_get_info(decoder, &dec_info);
+ *                esp_audio_gapless_process(trim, &dec_info, &out);
+ *                // Play `out.decoded_size` bytes of `out.buffer`
+ *            }
+ *        }
+ *        esp_audio_gapless_close(trim);
+ * @endcode
+ */
+typedef void *esp_audio_gapless_handle_t;
+
+/**
+ * @brief  Gapless information of audio stream
+ *
+ * @note  Samples are counted per channel in time base of `sample_rate`
+ *        Decoder output begins after `enc_delay` + `dec_delay` samples and lasts `valid_samples`
+ */
+typedef struct {
+    uint32_t sample_rate;   /*!< Time base of following fields, Opus always use 48000
+                                 Set to 0 to use sample rate of decoded output */
+    uint32_t enc_delay;     /*!< Encoder delay (priming samples) at start of stream */
+    uint32_t dec_delay;     /*!< Extra decoder delay, for MP3 with LAME tag it is 529 samples */
+    uint32_t padding;       /*!< Padding samples at end of stream (informative) */
+    uint64_t valid_samples; /*!< Total valid samples, 0 means unknown and tail is not trimmed */
+} esp_audio_gapless_info_t;
+
+/**
+ * @brief  Parse gapless information from stream data
+ *
+ * @note  Only fields found in data are updated, other fields keep their input value
+ *        So it can be called several times on different part of stream (like file header then file tail)
+ *        For MP3, data should start from file begin (ID3v2 tag is skipped) and contain the first frame
+ *        The Xing/Info frame is treated as metadata which does not output samples
+ *        For M4A, data should contain `moov` box
+ *        For OGG Opus, data contain `OpusHead` or last page with end of stream flag
+ *
+ * @param[in]      type  Simple decoder type (support MP3, M4A, OGG)
+ * @param[in]      data  Stream data
+ * @param[in]      size  Stream data size
+ * @param[in,out]  info  Gapless information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 Gapless information found
+ *       - ESP_AUDIO_ERR_NOT_FOUND          No gapless information in data
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Not supported decoder type
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_gapless_parse(esp_audio_simple_dec_type_t type, const uint8_t *data, uint32_t size,
+                                        esp_audio_gapless_info_t *info);
+
+/**
+ * @brief  Open gapless trimming handle
+ *
+ * @param[in]   info  Gapless information
+ * @param[out]  hd    Gapless handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_gapless_open(esp_audio_gapless_info_t *info, esp_audio_gapless_handle_t *hd);
+
+/**
+ * @brief  Update gapless information during decoding
+ *
+ * @note  Used when valid sample count is only known later (like granule position of OGG last page)
+ *        Samples already dropped at start are not re-counted
+ *
+ * @param[in]  hd    Gapless handle
+ * @param[in]  info  Gapless information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_gapless_set_info(esp_audio_gapless_handle_t hd, esp_audio_gapless_info_t *info);
+
+/**
+ * @brief  Trim decoded PCM frame in place
+ *
+ * @note  `decoded_size` of `frame` is updated and may become 0 when whole frame is dropped
+ *
+ * @param[in]      hd        Gapless handle
+ * @param[in]      dec_info  Decoder information of current output (sample rate, channel, bits per sample)
+ * @param[in,out]  frame     Decoded PCM frame from `esp_audio_simple_dec_process`
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_gapless_process(esp_audio_gapless_handle_t hd, esp_audio_simple_dec_info_t *dec_info,
+                                          esp_audio_simple_dec_out_t *frame);
+
+/**
+ * @brief  Reset gapless handle to start of stream
+ *
+ * @note  Call it together with `esp_audio_simple_dec_reset` when replay same stream
+ *        For another stream, use `esp_audio_gapless_set_info` to update gapless information after reset
+ *
+ * @param[in]  hd  Gapless handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_gapless_reset(esp_audio_gapless_handle_t hd);
+
+/**
+ * @brief  Close gapless handle
+ *
+ * @param[in]  hd  Gapless handle
+ */
+void esp_audio_gapless_close(esp_audio_gapless_handle_t hd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -66,6 +66,7 @@ typedef enum {
     ESP_AUDIO_SIMPLE_DEC_TYPE_M4A        = ESP_AUDIO_FOURCC_TO_INT('M', '4', 'A', 'A'), /*!< Simple decoder for M4A, support input data of any size */
     ESP_AUDIO_SIMPLE_DEC_TYPE_TS         = ESP_AUDIO_FOURCC_TO_INT('T', 'S', ' ', ' '), /*!< Simple decoder for TS, support input data of any size */
     ESP_AUDIO_SIMPLE_DEC_TYPE_OGG        = ESP_AUDIO_FOURCC_TO_INT('O', 'G', 'G', ' '), /*!< Simple decoder for OGG, support input data of any size */
+    ESP_AUDIO_SIMPLE_DEC_TYPE_LATM       = ESP_AUDIO_FOURCC_TO_INT('L', 'A', 'T', 'M'), /*!< Simple decoder for AAC in LOAS/LATM (DVB, ATSC broadcast), support input data of any size */
     ESP_AUDIO_SIMPLE_DEC_TYPE_RAW_OPUS   = ESP_AUDIO_TYPE_OPUS,                         /*!< Simple decoder for OPUS (raw data with no extra header),
                                                                                              only supports input data with a size of one encoded frame */
     ESP_AUDIO_SIMPLE_DEC_TYPE_G711A      = ESP_AUDIO_TYPE_G711A,                        /*!< Simple decoder for G711A, support input data of any size */
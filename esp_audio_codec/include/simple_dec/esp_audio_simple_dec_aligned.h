@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_types.h"
+#include "esp_audio_simple_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Audio simple decoder for frame aligned input
+ *
+ * @note  `esp_audio_simple_dec_process` copies all input into parser cache even when input is already frame aligned
+ *        (e.g. data from `esp_extractor_read_frame`). This decoder validates frame boundary in place and hands
+ *        user input buffer directly to registered decoder operations (`esp_audio_dec_ops_t`) without copy.
+ *        Only when a frame is split across input calls, the partial frame is cached internally until completed.
+ *        Frame header is checked for following types, data before a valid header is skipped:
+ *          - AAC with ADTS header
+ *          - MP3 (ID3v2 tag at beginning is skipped)
+ *          - AMR-NB and AMR-WB (file magic at beginning is skipped)
+ *        Other frame based types (PCM, G711, ADPCM, SBC, LC3, RAW_OPUS etc) treat each input as one frame
+ *        Container types (WAV, M4A, TS, OGG) and FLAC need parser, use `esp_audio_simple_dec` instead
+ *        Decoder is got through `esp_audio_dec_get_ops`, so decoder must be registered before open
+ *        Usage is the same as `esp_audio_simple_dec`, when `ESP_AUDIO_ERR_BUFF_NOT_ENOUGH` is returned
+ *        reallocate output buffer to `needed_size` and call again with the same `raw`
+ */
+typedef void *esp_audio_simple_dec_aligned_handle_t;
+
+/**
+ * @brief  Open audio simple decoder for frame aligned input
+ *
+ * @note  `use_frame_dec` in configuration is ignored
+ *
+ * @param[in]   cfg     Simple decoder configuration
+ * @param[out]  handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Decoder type not support or not registered
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_aligned_open(esp_audio_simple_dec_cfg_t *cfg,
+                                                  esp_audio_simple_dec_aligned_handle_t *handle);
+
+/**
+ * @brief  Decode one frame from input data
+ *
+ * @note  Each call decodes at most one frame, `raw->consumed` reports input data being used (including skipped data)
+ *        When input ends inside a frame, data is cached and `decoded_size` is 0, frame is decoded in following call
+ *
+ * @param[in]      handle  Decoder handle
+ * @param[in,out]  raw     Raw data to be decoded
+ * @param[in,out]  frame   Decoded PCM frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 Decode success or data is cached
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output frame buffer not enough need reallocated and try again
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - Others                           Error returned by decoder
+ */
+esp_audio_err_t esp_audio_simple_dec_aligned_process(esp_audio_simple_dec_aligned_handle_t handle,
+                                                     esp_audio_simple_dec_raw_t *raw,
+                                                     esp_audio_simple_dec_out_t *frame);
+
+/**
+ * @brief  Get decoder information
+ *
+ * @param[in]   handle  Decoder handle
+ * @param[out]  info    Decoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND          Decode information not ready yet
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_aligned_get_info(esp_audio_simple_dec_aligned_handle_t handle,
+                                                      esp_audio_simple_dec_info_t *info);
+
+/**
+ * @brief  Reset decoder and drop cached partial frame
+ *
+ * @param[in]  handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - Others                           Error returned by decoder
+ */
+esp_audio_err_t esp_audio_simple_dec_aligned_reset(esp_audio_simple_dec_aligned_handle_t handle);
+
+/**
+ * @brief  Close audio simple decoder for frame aligned input
+ *
+ * @param[in]  handle  Decoder handle
+ */
+void esp_audio_simple_dec_aligned_close(esp_audio_simple_dec_aligned_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
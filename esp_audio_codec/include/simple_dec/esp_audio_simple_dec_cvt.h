@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_types.h"
+#include "esp_audio_simple_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Audio simple decoder with fused output conversion
+ *
+ * @note  It wraps audio simple decoder and converts decoded PCM to target sample rate, channel and bits per sample
+ *        Instead of running rate, channel and bit conversion one after another (3 passes and 3 intermediate buffers),
+ *        each decoded sample is read once, mixed to target channels, resampled and written in target bit width
+ *        directly into the user output frame, only one internal buffer holds the decoded frame
+ *        When decoded format already equals the target format, decoder writes into user output frame directly
+ *        Channel conversion has same behavior as `esp_ae_ch_cvt`: output channel is weighted sum of input channels
+ *        Rate conversion use windowed sinc interpolation with cutoff follow the lower sample rate
+ *        (16 taps, multiplied by down sampling ratio up to 6)
+ *        Output is aligned with input in time (no filter delay), the filter tail is output when `raw->eos` is set
+ *        and all input is consumed, so call process once more with `eos` set and `len` 0 at end of stream
+ *        Usage is the same as `esp_audio_simple_dec`, when `ESP_AUDIO_ERR_BUFF_NOT_ENOUGH` is returned
+ *        reallocate output buffer to `needed_size` and call again with the same `raw`
+ */
+typedef void *esp_audio_simple_dec_cvt_handle_t;
+
+/**
+ * @brief  Configuration of audio simple decoder with output conversion
+ */
+typedef struct {
+    esp_audio_simple_dec_cfg_t dec_cfg;          /*!< Simple decoder configuration */
+    uint32_t                   sample_rate;      /*!< Target sample rate, set to 0 to keep decoded sample rate */
+    uint8_t                    channel;          /*!< Target channel, set to 0 to keep decoded channel */
+    uint8_t                    bits_per_sample;  /*!< Target bits per sample (16, 24, 32), set to 0 to keep decoded bits per sample
+                                                      24 bits is packed as 3 bytes little endian */
+    const float               *weight;           /*!< Channel conversion weight array of `channel` * decoded channel
+                                                      Output channel `i` = sum(weight[i * src_ch + j] * input channel `j`)
+                                                      Set to NULL to use 1 / decoded channel for each weight (same as `esp_ae_ch_cvt`)
+                                                      Only used when decoded channel differs from target channel */
+    uint32_t                   weight_len;       /*!< Length of `weight` array */
+} esp_audio_simple_dec_cvt_cfg_t;
+
+/**
+ * @brief  Open audio simple decoder with output conversion
+ *
+ * @param[in]   cfg     Configuration
+ * @param[out]  handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Not supported decoder type
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_cvt_open(esp_audio_simple_dec_cvt_cfg_t *cfg,
+                                              esp_audio_simple_dec_cvt_handle_t *handle);
+
+/**
+ * @brief  Decode input raw data to PCM data in target format
+ *
+ * @note  Weight array length must match decoded channel, otherwise `ESP_AUDIO_ERR_NOT_SUPPORT` is returned
+ *        when decoded information is known
+ *
+ * @param[in]      handle  Decoder handle
+ * @param[in,out]  raw     Raw data to be decoded
+ * @param[in,out]  frame   Converted PCM frame
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 Decode success or data feed into cached buffer
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    Output frame buffer not enough need reallocated and try again
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Decoded format can not be converted
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_cvt_process(esp_audio_simple_dec_cvt_handle_t handle, esp_audio_simple_dec_raw_t *raw,
+                                                 esp_audio_simple_dec_out_t *frame);
+
+/**
+ * @brief  Get information of converted output
+ *
+ * @note  `sample_rate`, `channel` and `bits_per_sample` describe converted output
+ *        `bitrate` and `frame_size` are reported by decoder
+ *
+ * @param[in]   handle  Decoder handle
+ * @param[out]  info    Decoder information
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND          Decode information not ready yet
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_cvt_get_info(esp_audio_simple_dec_cvt_handle_t handle,
+                                                  esp_audio_simple_dec_info_t *info);
+
+/**
+ * @brief  Reset decoder and clear conversion history
+ *
+ * @param[in]  handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_FAIL               Fail to reset
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_audio_simple_dec_cvt_reset(esp_audio_simple_dec_cvt_handle_t handle);
+
+/**
+ * @brief  Close audio simple decoder with output conversion
+ *
+ * @param[in]  handle  Decoder handle
+ */
+void esp_audio_simple_dec_cvt_close(esp_audio_simple_dec_cvt_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
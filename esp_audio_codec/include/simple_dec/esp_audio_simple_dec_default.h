@@ -33,7 +33,12 @@
 #include "impl/esp_ts_parse.h"
 #include "impl/esp_ogg_dec.h"
 #include "impl/esp_ogg_parse.h"
+#include "impl/esp_latm_dec.h"
+#include "impl/esp_latm_parse.h"
 #include "esp_audio_simple_dec_reg.h"
+#include "esp_audio_gapless.h"
+#include "esp_audio_simple_dec_cvt.h"
+#include "esp_audio_simple_dec_aligned.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_es_parse_types.h"
+#include "esp_audio_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  LATM decoder configuration (optional)
+ *
+ * @note  LATM/LOAS (ISO/IEC 14496-3 1.7) is the AAC transport used by DVB and ATSC broadcast
+ *        where TS stream type is 0x11. Demuxed PES payload of such stream can be fed to simple decoder
+ *        with type `ESP_AUDIO_SIMPLE_DEC_TYPE_LATM` directly.
+ *        Audio information is gathered from StreamMuxConfig in stream, user need not set.
+ *        Below code show how to set it using simple decoder API.
+ *
+ * @code{c}
+ *       esp_latm_dec_cfg_t latm_cfg = {.aac_plus_enable = true};
+ *       esp_audio_simple_dec_cfg_t dec_cfg = {
+ *           .dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_LATM,
+ *           .dec_cfg = &latm_cfg,
+ *           .cfg_size = sizeof(esp_latm_dec_cfg_t)
+ *       };
+ *       esp_audio_simple_dec_handle_t latm_dec = NULL;
+ *       esp_audio_simple_dec_open(&dec_cfg, &latm_dec);
+ * @endcode
+ *
+ */
+typedef struct {
+    bool aac_plus_enable; /*!< Enable AAC plus decode or not (always enabled when SBR is signaled explicitly) */
+} esp_latm_dec_cfg_t;
+
+/**
+ * @brief  Default decoder operations for LATM
+ */
+#define ESP_LATM_DEC_DEFAULT_OPS() {   \
+    .open   = esp_latm_dec_open,       \
+    .decode = esp_latm_dec_decode,     \
+    .reset  = esp_latm_dec_reset,      \
+    .close  = esp_latm_dec_close,      \
+}
+
+/**
+ * @brief  Register LATM decoder
+ * @return
+ *       - ESP_AUDIO_ERR_OK        On success
+ *       - ESP_AUDIO_ERR_MEM_LACK  Fail to allocate memory
+ */
+esp_audio_err_t esp_latm_dec_register(void);
+
+/**
+ * @brief  Open LATM decoder
+ *
+ * @note  Internal AAC decoder is opened when first StreamMuxConfig is received
+ *        and reopened when audio object, sample rate or channel changes
+ *
+ * @param[in]   cfg         Pointer to `esp_es_parse_frame_info_t` (used by simple decoder) or `esp_latm_dec_cfg_t`
+ *                          Can be NULL to use default configuration
+ * @param[in]   cfg_sz      Set to sizeof(esp_es_parse_frame_info_t) or sizeof(esp_latm_dec_cfg_t)
+ * @param[out]  dec_handle  The LATM decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_latm_dec_open(void *cfg, uint32_t cfg_sz, void **dec_handle);
+
+/**
+ * @brief  Decode one LOAS frame
+ *
+ * @note  All sub frames in the AudioMuxElement are decoded, output PCM is concatenated
+ *        Frames before the first StreamMuxConfig are consumed with `decoded_size` set to 0
+ *
+ * @param[in]      dec_handle  Decoder handle
+ * @param[in,out]  raw         Raw data information to be decoded
+ * @param[in,out]  frame       Decoded PCM frame information
+ * @param[out]     dec_info    Information of decoder
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ *       - ESP_AUDIO_ERR_DATA_LACK          Input data shorter than LOAS frame
+ *       - ESP_AUDIO_ERR_BUFF_NOT_ENOUGH    No enough frame buffer to hold output PCM frame data
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT        Multiple program or layer, or not AAC audio object
+ *       - ESP_AUDIO_ERR_HEADER_PARSE       Broken StreamMuxConfig
+ *       - ESP_AUDIO_ERR_FAIL               Fail to decode data
+ */
+esp_audio_err_t esp_latm_dec_decode(void *dec_handle, esp_audio_dec_in_raw_t *raw, esp_audio_dec_out_frame_t *frame,
+                                    esp_audio_dec_info_t *dec_info);
+
+/**
+ * @brief  Reset LATM decoder
+ *
+ * @note  Stream mux configuration is kept so that decode can continue after seek
+ *
+ * @param[in]  dec_handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_latm_dec_reset(void *dec_handle);
+
+/**
+ * @brief  Close LATM decoder
+ *
+ * @param[in]  dec_handle  Decoder handle
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK                 On success
+ *       - ESP_AUDIO_ERR_INVALID_PARAMETER  Invalid parameter
+ */
+esp_audio_err_t esp_latm_dec_close(void *dec_handle);
+
+/**
+ * @brief  Unregister LATM decoder
+ * @return
+ *       - ESP_AUDIO_ERR_OK         On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND  LATM decoder not register yet
+ */
+esp_audio_err_t esp_latm_dec_unregister(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include "esp_es_parse_types.h"
+#include "esp_audio_dec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Parser for LOAS (AudioSyncStream) wrapped LATM AAC to get audio frame data
+ *
+ * @note  Each LOAS frame carries one AudioMuxElement, `frame_size` covers the whole LOAS frame
+ *        StreamMuxConfig is kept in extra data so that frames with `useSameStreamMux` can be reported
+ *        Frames received before the first StreamMuxConfig are skipped (common when tuning into broadcast)
+ *        Only single program single layer AAC with `frameLengthType` 0 is supported
+ *
+ * @param[in,out]  data  Data to be parsed
+ * @param[out]     info  Frame information
+ *
+ * @return
+ *       - ESP_ES_PARSE_ERR_OK               Frame check all right or data need skip
+ *       - ESP_ES_PARSE_ERR_DATA_NOT_ENOUGH  Input data not enough
+ *       - ESP_ES_PARSE_ERR_NO_MEM           Not enough memory
+ *       - ESP_ES_PARSE_ERR_NOT_SUPPORT      Stream mux configuration not supported
+ */
+esp_es_parse_err_t esp_latm_parse_frame(esp_es_parse_raw_t *data, esp_es_parse_frame_info_t *info);
+
+/**
+ * @brief  Free extra data used by LATM parser
+ *
+ * @param  extra_data  Extra data to be freed
+ *
+ */
+void esp_latm_parse_free_extra(void *extra_data);
+
+#ifdef __cplusplus
+}
+#endif
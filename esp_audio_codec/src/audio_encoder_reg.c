@@ -56,6 +56,13 @@ esp_audio_err_t esp_audio_enc_register_default(void)
 #ifdef CONFIG_AUDIO_ENCODER_G722_SUPPORT
     ret |= esp_g722_enc_register();
 #endif /* CONFIG_AUDIO_ENCODER_G722_SUPPORT */
+
+#ifdef CONFIG_AUDIO_ENCODER_MP3_SUPPORT
+    ret |= esp_mp3_enc_register();
+#endif /* CONFIG_AUDIO_ENCODER_MP3_SUPPORT */
+#ifdef CONFIG_AUDIO_ENCODER_FLAC_SUPPORT
+    ret |= esp_flac_enc_register();
+#endif /* CONFIG_AUDIO_ENCODER_FLAC_SUPPORT */
     return ret;
 }
 
@@ -105,4 +112,11 @@ void esp_audio_enc_unregister_default(void)
 #ifdef CONFIG_AUDIO_ENCODER_G722_SUPPORT
     esp_audio_enc_unregister(ESP_AUDIO_TYPE_G722);
 #endif /* CONFIG_AUDIO_ENCODER_G722_SUPPORT */
+
+#ifdef CONFIG_AUDIO_ENCODER_MP3_SUPPORT
+    esp_audio_enc_unregister(ESP_AUDIO_TYPE_MP3);
+#endif /* CONFIG_AUDIO_ENCODER_MP3_SUPPORT */
+#ifdef CONFIG_AUDIO_ENCODER_FLAC_SUPPORT
+    esp_audio_enc_unregister(ESP_AUDIO_TYPE_FLAC);
+#endif /* CONFIG_AUDIO_ENCODER_FLAC_SUPPORT */
 }
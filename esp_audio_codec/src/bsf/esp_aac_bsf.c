@@ -0,0 +1,442 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_aac_bsf.h"
+#include "latm_mux.h"
+#include "esp_log.h"
+
+#define TAG "AAC_BSF"
+
+#define ADTS_HEADER_SIZE     (7)
+#define ADTS_HEADER_CRC_SIZE (9)
+#define ADTS_MAX_FRAME_SIZE  (0x1FFF)
+#define ASC_MAX_SIZE         (8)
+
+static const uint32_t adts_sample_rates[] = {
+    96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350,
+};
+
+typedef struct {
+    esp_aac_bsf_cfg_t cfg;
+    latm_mux_cfg_t    mux;
+    uint32_t          frame_count;
+} aac_bsf_t;
+
+typedef struct {
+    uint32_t       skip;         /*!< Garbage before frame */
+    uint32_t       frame_size;   /*!< Whole frame size include header */
+    const uint8_t *payload;      /*!< Byte aligned payload, NULL if payload is not byte aligned */
+    uint32_t       payload_size;
+    latm_bits_t    bits;         /*!< Bit position of payload for LOAS */
+} aac_bsf_frame_t;
+
+static void info_to_mux(esp_aac_bsf_asc_info_t *info, latm_mux_cfg_t *mux)
+{
+    mux->object_type = info->object_type;
+    mux->sample_rate = info->sample_rate;
+    mux->ext_sample_rate = info->ext_sample_rate;
+    mux->channel = info->channel;
+    mux->frame_960 = info->frame_960;
+}
+
+static void mux_to_info(latm_mux_cfg_t *mux, esp_aac_bsf_asc_info_t *info)
+{
+    info->object_type = mux->object_type;
+    info->sample_rate = mux->sample_rate;
+    info->ext_sample_rate = mux->ext_sample_rate;
+    info->channel = mux->channel;
+    info->frame_960 = mux->frame_960;
+}
+
+static int get_adts_sample_rate_index(uint32_t sample_rate)
+{
+    for (int i = 0; i < (int)(sizeof(adts_sample_rates) / sizeof(adts_sample_rates[0])); i++) {
+        if (adts_sample_rates[i] == sample_rate) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static inline bool is_adts_sync(const uint8_t *buf)
+{
+    // Syncword and layer 0
+    return buf[0] == 0xFF && (buf[1] & 0xF6) == 0xF0;
+}
+
+static inline bool is_loas_sync(const uint8_t *buf)
+{
+    return buf[0] == 0x56 && (buf[1] & 0xE0) == 0xE0;
+}
+
+static uint32_t find_sync(esp_aac_bsf_fmt_t fmt, const uint8_t *buf, uint32_t len)
+{
+    uint32_t i = 0;
+    for (; i + 1 < len; i++) {
+        if (fmt == ESP_AAC_BSF_FMT_ADTS ? is_adts_sync(buf + i) : is_loas_sync(buf + i)) {
+            break;
+        }
+    }
+    return i;
+}
+
+static esp_audio_err_t read_adts(aac_bsf_t *bsf, uint8_t *buf, uint32_t len, aac_bsf_frame_t *frame)
+{
+    if (len < ADTS_HEADER_SIZE) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    uint8_t profile = buf[2] >> 6;
+    uint8_t sr_idx = (buf[2] >> 2) & 0xF;
+    uint8_t channel_cfg = ((buf[2] & 1) << 2) | (buf[3] >> 6);
+    uint32_t frame_size = ((buf[3] & 3) << 11) | (buf[4] << 3) | (buf[5] >> 5);
+    uint32_t header_size = (buf[1] & 1) ? ADTS_HEADER_SIZE : ADTS_HEADER_CRC_SIZE;
+    if (sr_idx >= sizeof(adts_sample_rates) / sizeof(adts_sample_rates[0]) || channel_cfg == 0 ||
+        frame_size <= header_size) {
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    if (len < frame_size) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    uint8_t channel = (channel_cfg == 7) ? 8 : channel_cfg;
+    if (bsf->mux.valid && (bsf->mux.object_type != profile + 1 ||
+                           bsf->mux.sample_rate != adts_sample_rates[sr_idx] || bsf->mux.channel != channel)) {
+        // Send StreamMuxConfig again for LOAS output
+        bsf->frame_count = 0;
+    }
+    bsf->mux.object_type = profile + 1;
+    bsf->mux.sample_rate = adts_sample_rates[sr_idx];
+    bsf->mux.ext_sample_rate = 0;
+    bsf->mux.channel = channel;
+    bsf->mux.frame_960 = false;
+    bsf->mux.valid = true;
+    frame->frame_size = frame_size;
+    // Multiple raw data blocks carry per block CRC and positions, can only pass through
+    if ((buf[6] & 3) == 0) {
+        frame->payload = buf + header_size;
+        frame->payload_size = frame_size - header_size;
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t read_loas(aac_bsf_t *bsf, uint8_t *buf, uint32_t len, aac_bsf_frame_t *frame)
+{
+    if (len < LATM_LOAS_HEAD_SIZE) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    uint32_t frame_size = latm_loas_frame_size(buf, len);
+    if (len < frame_size) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    frame->frame_size = frame_size;
+    frame->bits.data = buf + LATM_LOAS_HEAD_SIZE;
+    frame->bits.size = frame_size - LATM_LOAS_HEAD_SIZE;
+    esp_audio_err_t ret = latm_parse_mux_element(&frame->bits, &bsf->mux);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    if (bsf->mux.sub_frames == 1) {
+        frame->payload_size = latm_read_payload_len(&frame->bits);
+        if (frame->payload_size == 0 || frame->bits.pos + frame->payload_size * 8 > frame->bits.size * 8) {
+            return ESP_AUDIO_ERR_HEADER_PARSE;
+        }
+        if ((frame->bits.pos & 7) == 0) {
+            frame->payload = frame->bits.data + (frame->bits.pos >> 3);
+        }
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t read_frame(aac_bsf_t *bsf, esp_aac_bsf_in_t *in, aac_bsf_frame_t *frame)
+{
+    if (bsf->cfg.in_fmt == ESP_AAC_BSF_FMT_RAW) {
+        frame->frame_size = in->len;
+        frame->payload = in->buffer;
+        frame->payload_size = in->len;
+        return ESP_AUDIO_ERR_OK;
+    }
+    frame->skip = find_sync(bsf->cfg.in_fmt, in->buffer, in->len);
+    uint8_t *buf = in->buffer + frame->skip;
+    uint32_t len = in->len - frame->skip;
+    if (bsf->cfg.in_fmt == ESP_AAC_BSF_FMT_ADTS) {
+        return read_adts(bsf, buf, len, frame);
+    }
+    return read_loas(bsf, buf, len, frame);
+}
+
+static esp_audio_err_t check_out_size(esp_aac_bsf_out_t *out, uint32_t size)
+{
+    if (out->buffer == NULL || out->len < size) {
+        out->needed_size = size;
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+static const uint8_t *get_payload(aac_bsf_frame_t *frame, uint8_t *dst)
+{
+    if (frame->payload) {
+        return frame->payload;
+    }
+    // LOAS payload after StreamMuxConfig is rarely byte aligned
+    latm_read_payload(&frame->bits, dst, frame->payload_size);
+    return dst;
+}
+
+static esp_audio_err_t write_frame(aac_bsf_t *bsf, uint8_t *frame_start, aac_bsf_frame_t *frame,
+                                   esp_aac_bsf_out_t *out)
+{
+    esp_aac_bsf_fmt_t out_fmt = bsf->cfg.out_fmt;
+    if (out_fmt == bsf->cfg.in_fmt) {
+        out->data = frame_start;
+        out->size = frame->frame_size;
+        return ESP_AUDIO_ERR_OK;
+    }
+    if (frame->payload == NULL && frame->payload_size == 0) {
+        ESP_LOGE(TAG, "Frame with multiple raw data blocks or sub frames can not be converted");
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    esp_audio_err_t ret;
+    switch (out_fmt) {
+        case ESP_AAC_BSF_FMT_RAW:
+            if (frame->payload) {
+                out->data = (uint8_t *)frame->payload;
+                out->size = frame->payload_size;
+                return ESP_AUDIO_ERR_OK;
+            }
+            ret = check_out_size(out, frame->payload_size);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+            get_payload(frame, out->buffer);
+            out->data = out->buffer;
+            out->size = frame->payload_size;
+            return ESP_AUDIO_ERR_OK;
+        case ESP_AAC_BSF_FMT_ADTS: {
+            ret = check_out_size(out, ADTS_HEADER_SIZE + frame->payload_size);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+            esp_aac_bsf_asc_info_t info;
+            mux_to_info(&bsf->mux, &info);
+            ret = esp_aac_bsf_gen_adts_header(&info, frame->payload_size, out->buffer);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+            const uint8_t *payload = get_payload(frame, out->buffer + ADTS_HEADER_SIZE);
+            if (payload != out->buffer + ADTS_HEADER_SIZE) {
+                memcpy(out->buffer + ADTS_HEADER_SIZE, payload, frame->payload_size);
+            }
+            out->data = out->buffer;
+            out->size = ADTS_HEADER_SIZE + frame->payload_size;
+            return ESP_AUDIO_ERR_OK;
+        }
+        case ESP_AAC_BSF_FMT_LOAS: {
+            bool with_cfg = (bsf->frame_count == 0) ||
+                            (bsf->cfg.mux_config_interval && bsf->frame_count % bsf->cfg.mux_config_interval == 0);
+            uint32_t max_size = latm_get_loas_max_size(frame->payload_size, with_cfg);
+            if (max_size > LATM_LOAS_MAX_SIZE) {
+                ESP_LOGE(TAG, "Frame size %d too large for LOAS", (int)frame->payload_size);
+                return ESP_AUDIO_ERR_NOT_SUPPORT;
+            }
+            ret = check_out_size(out, max_size);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+            // Input is ADTS or raw here, payload is always byte aligned
+            out->size = latm_write_loas(&bsf->mux, with_cfg, frame->payload, frame->payload_size, out->buffer);
+            out->data = out->buffer;
+            return ESP_AUDIO_ERR_OK;
+        }
+        default:
+            return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+}
+
+esp_audio_err_t esp_aac_bsf_gen_asc(esp_aac_bsf_asc_info_t *info, uint8_t *asc, uint8_t *asc_len)
+{
+    if (info == NULL || asc == NULL || asc_len == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    uint8_t buf[ASC_MAX_SIZE];
+    latm_mux_cfg_t mux = {0};
+    info_to_mux(info, &mux);
+    uint32_t size = (latm_write_asc(&mux, buf, 0) + 7) >> 3;
+    if (*asc_len < size) {
+        *asc_len = size;
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    memcpy(asc, buf, size);
+    *asc_len = size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_parse_asc(const uint8_t *asc, uint32_t asc_len, esp_aac_bsf_asc_info_t *info)
+{
+    if (asc == NULL || asc_len == 0 || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    latm_bits_t bits = {
+        .data = asc,
+        .size = asc_len,
+    };
+    latm_mux_cfg_t mux = {0};
+    esp_audio_err_t ret = latm_parse_asc(&bits, &mux);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    if (bits.pos > asc_len * 8) {
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    mux_to_info(&mux, info);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_gen_adts_header(esp_aac_bsf_asc_info_t *info, uint32_t payload_size, uint8_t *header)
+{
+    if (info == NULL || header == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    int sr_idx = get_adts_sample_rate_index(info->sample_rate);
+    uint32_t frame_size = payload_size + ADTS_HEADER_SIZE;
+    if (info->object_type == 0 || info->object_type > 4 || sr_idx < 0 || info->channel == 0 ||
+        info->channel == 7 || info->channel > 8 || info->frame_960 || frame_size > ADTS_MAX_FRAME_SIZE) {
+        ESP_LOGE(TAG, "Not support ADTS for object %d sample rate %d channel %d size %d",
+                 info->object_type, (int)info->sample_rate, info->channel, (int)payload_size);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    uint8_t profile = info->object_type - 1;
+    uint8_t channel_cfg = info->channel == 8 ? 7 : info->channel;
+    header[0] = 0xFF;
+    // MPEG-4, layer 0, no CRC
+    header[1] = 0xF1;
+    header[2] = (profile << 6) | (sr_idx << 2) | (channel_cfg >> 2);
+    header[3] = ((channel_cfg & 3) << 6) | (frame_size >> 11);
+    header[4] = (frame_size >> 3) & 0xFF;
+    // Buffer fullness 0x7FF means VBR
+    header[5] = ((frame_size & 7) << 5) | 0x1F;
+    header[6] = 0xFC;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_open(esp_aac_bsf_cfg_t *cfg, esp_aac_bsf_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL || cfg->in_fmt > ESP_AAC_BSF_FMT_LOAS || cfg->out_fmt > ESP_AAC_BSF_FMT_LOAS) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    esp_aac_bsf_asc_info_t info = {0};
+    if (cfg->in_fmt == ESP_AAC_BSF_FMT_RAW) {
+        if (cfg->asc == NULL || cfg->asc_len == 0) {
+            ESP_LOGE(TAG, "AudioSpecificConfig is needed for raw input");
+            return ESP_AUDIO_ERR_INVALID_PARAMETER;
+        }
+        esp_audio_err_t ret = esp_aac_bsf_parse_asc(cfg->asc, cfg->asc_len, &info);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to parse AudioSpecificConfig ret %d", ret);
+            return ret;
+        }
+    }
+    aac_bsf_t *bsf = (aac_bsf_t *)calloc(1, sizeof(aac_bsf_t));
+    if (bsf == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    bsf->cfg = *cfg;
+    // ASC content is parsed, no need to keep user pointer
+    bsf->cfg.asc = NULL;
+    if (cfg->in_fmt == ESP_AAC_BSF_FMT_RAW) {
+        info_to_mux(&info, &bsf->mux);
+        bsf->mux.sub_frames = 1;
+        bsf->mux.valid = true;
+    }
+    *handle = bsf;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_process(esp_aac_bsf_handle_t handle, esp_aac_bsf_in_t *in, esp_aac_bsf_out_t *out)
+{
+    if (handle == NULL || in == NULL || in->buffer == NULL || out == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_bsf_t *bsf = (aac_bsf_t *)handle;
+    in->consumed = 0;
+    out->data = NULL;
+    out->size = 0;
+    aac_bsf_frame_t frame = {0};
+    esp_audio_err_t ret = read_frame(bsf, in, &frame);
+    if (ret == ESP_AUDIO_ERR_DATA_LACK) {
+        // Drop garbage before sync word and wait for whole frame
+        in->consumed = frame.skip;
+        return ret;
+    }
+    if (ret == ESP_AUDIO_ERR_NOT_FOUND) {
+        // LOAS frame before StreamMuxConfig can not be converted
+        in->consumed = frame.skip + frame.frame_size;
+        return ESP_AUDIO_ERR_OK;
+    }
+    if (ret == ESP_AUDIO_ERR_HEADER_PARSE) {
+        // Sync word emulation, skip it so that next call can resync
+        in->consumed = frame.skip + 1;
+        return ret;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to read frame ret %d", ret);
+        return ret;
+    }
+    ret = write_frame(bsf, in->buffer + frame.skip, &frame, out);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        out->data = NULL;
+        out->size = 0;
+        if (ret == ESP_AUDIO_ERR_NOT_SUPPORT) {
+            // Drop the frame so that the stream keeps going from the next one
+            in->consumed = frame.skip + frame.frame_size;
+        }
+        return ret;
+    }
+    in->consumed = frame.skip + frame.frame_size;
+    bsf->frame_count++;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_get_asc_info(esp_aac_bsf_handle_t handle, esp_aac_bsf_asc_info_t *info)
+{
+    if (handle == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_bsf_t *bsf = (aac_bsf_t *)handle;
+    if (bsf->mux.valid == false) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    mux_to_info(&bsf->mux, info);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_bsf_reset(esp_aac_bsf_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_bsf_t *bsf = (aac_bsf_t *)handle;
+    bsf->frame_count = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_aac_bsf_close(esp_aac_bsf_handle_t handle)
+{
+    if (handle) {
+        free(handle);
+    }
+}
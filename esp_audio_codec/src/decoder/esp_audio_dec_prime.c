@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include "esp_audio_dec_prime.h"
+#include "esp_log.h"
+
+#define TAG "AUD_DEC_PRIME"
+
+#define PRIME_SCRATCH_SIZE (4096)
+#define PRIME_MAX_FRAMES   (255)
+
+typedef struct {
+    esp_audio_dec_handle_t    decoder;
+    bool                      skip;
+    esp_audio_dec_out_frame_t scratch;
+} audio_dec_prime_t;
+
+static const uint16_t mp3_l3_bitrate[2][15] = {
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},  // MPEG1 Layer III
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},      // MPEG2/2.5 Layer III
+};
+
+static const uint16_t mp3_sample_rate[3] = {44100, 48000, 32000};
+
+/**
+ * Frames needed before a Layer III frame: previous frames of the same size until the `main_data_begin`
+ * bytes it reads back from the bit reservoir are covered, plus one for the IMDCT overlap
+ */
+static int get_mp3_prime_frames(const uint8_t *h, uint32_t len)
+{
+    if (len < 4 || h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) {
+        return -1;
+    }
+    int version = (h[1] >> 3) & 3;  // 0: MPEG2.5, 2: MPEG2, 3: MPEG1
+    int layer = 4 - ((h[1] >> 1) & 3);
+    int bitrate_idx = h[2] >> 4;
+    int rate_idx = (h[2] >> 2) & 3;
+    if (version == 1 || layer == 4 || bitrate_idx == 15 || rate_idx == 3) {
+        return -1;
+    }
+    if (layer != 3) {
+        // No bit reservoir, only the synthesis filter bank delay
+        return 1;
+    }
+    int crc_size = (h[1] & 1) ? 0 : 2;
+    if (bitrate_idx == 0 || len < 4 + crc_size + 2) {
+        // Free format or side info not available
+        return -1;
+    }
+    bool lsf = (version != 3);
+    bool mono = ((h[3] >> 6) == 3);
+    int padding = (h[2] >> 1) & 1;
+    int bitrate = mp3_l3_bitrate[lsf][bitrate_idx] * 1000;
+    int sample_rate = mp3_sample_rate[rate_idx] >> (3 - version - (version == 0));
+    int side_size = lsf ? (mono ? 9 : 17) : (mono ? 17 : 32);
+    int main_size = (lsf ? 72 : 144) * bitrate / sample_rate + padding - 4 - crc_size - side_size;
+    if (main_size <= 0) {
+        return -1;
+    }
+    const uint8_t *side = h + 4 + crc_size;
+    int main_data_begin = lsf ? side[0] : ((side[0] << 1) | (side[1] >> 7));
+    int frames = (main_data_begin + main_size - 1) / main_size + 1;
+    return frames > PRIME_MAX_FRAMES ? PRIME_MAX_FRAMES : frames;
+}
+
+uint8_t esp_audio_dec_get_prime_frames(esp_audio_type_t type)
+{
+    switch (type) {
+        case ESP_AUDIO_TYPE_PCM:
+        case ESP_AUDIO_TYPE_G711A:
+        case ESP_AUDIO_TYPE_G711U:
+        case ESP_AUDIO_TYPE_ADPCM:
+        case ESP_AUDIO_TYPE_FLAC:
+        case ESP_AUDIO_TYPE_ALAC:
+            // Each frame decodes independently
+            return 0;
+        case ESP_AUDIO_TYPE_MP3:
+            // Full 511 bytes bit reservoir of MPEG1 at 128 kbps and above, plus IMDCT overlap
+            return 3;
+        case ESP_AUDIO_TYPE_AAC:
+            // MDCT overlap and SBR delay
+            return 2;
+        case ESP_AUDIO_TYPE_OPUS:
+            // 80ms pre-roll for 20ms frame
+            return 4;
+        case ESP_AUDIO_TYPE_VORBIS:
+            return 2;
+        default:
+            // Overlap or predictor state of one frame
+            return 1;
+    }
+}
+
+uint8_t esp_audio_dec_get_prime_frames_by_frame(esp_audio_type_t type, const uint8_t *frame, uint32_t len)
+{
+    if (type == ESP_AUDIO_TYPE_MP3 && frame) {
+        int frames = get_mp3_prime_frames(frame, len);
+        if (frames >= 0) {
+            return (uint8_t)frames;
+        }
+    }
+    return esp_audio_dec_get_prime_frames(type);
+}
+
+esp_audio_err_t esp_audio_dec_prime_open(esp_audio_type_t type, esp_audio_dec_handle_t decoder,
+                                         esp_audio_dec_prime_handle_t *prime)
+{
+    if (decoder == NULL || prime == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *prime = NULL;
+    audio_dec_prime_t *dec_prime = (audio_dec_prime_t *)calloc(1, sizeof(audio_dec_prime_t));
+    if (dec_prime == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    dec_prime->decoder = decoder;
+    dec_prime->skip = (esp_audio_dec_get_prime_frames(type) == 0);
+    if (dec_prime->skip == false) {
+        dec_prime->scratch.buffer = (uint8_t *)malloc(PRIME_SCRATCH_SIZE);
+        if (dec_prime->scratch.buffer == NULL) {
+            ESP_LOGE(TAG, "No memory for scratch buffer");
+            free(dec_prime);
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+        dec_prime->scratch.len = PRIME_SCRATCH_SIZE;
+    }
+    *prime = dec_prime;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_dec_prime_process(esp_audio_dec_prime_handle_t prime, esp_audio_dec_in_raw_t *raw)
+{
+    if (prime == NULL || raw == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    audio_dec_prime_t *dec_prime = (audio_dec_prime_t *)prime;
+    if (dec_prime->skip) {
+        // No state carried between frames, skip without decoding
+        raw->consumed = raw->len;
+        return ESP_AUDIO_ERR_OK;
+    }
+    while (1) {
+        esp_audio_err_t ret = esp_audio_dec_process(dec_prime->decoder, raw, &dec_prime->scratch);
+        if (ret != ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+            return ret;
+        }
+        // Grow scratch once, later prime frames reuse it
+        uint8_t *buffer = (uint8_t *)realloc(dec_prime->scratch.buffer, dec_prime->scratch.needed_size);
+        if (buffer == NULL) {
+            ESP_LOGE(TAG, "No memory for scratch buffer size %d", (int)dec_prime->scratch.needed_size);
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+        dec_prime->scratch.buffer = buffer;
+        dec_prime->scratch.len = dec_prime->scratch.needed_size;
+    }
+}
+
+void esp_audio_dec_prime_close(esp_audio_dec_prime_handle_t prime)
+{
+    if (prime == NULL) {
+        return;
+    }
+    audio_dec_prime_t *dec_prime = (audio_dec_prime_t *)prime;
+    if (dec_prime->scratch.buffer) {
+        free(dec_prime->scratch.buffer);
+    }
+    free(dec_prime);
+}
@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_opus_ms_dec.h"
+#include "opus_ms_pkt.h"
+#include "esp_log.h"
+
+#define TAG "OPUS_MS_DEC"
+
+typedef struct {
+    void   *core;
+    uint8_t ch_num;
+} opus_ms_dec_stream_t;
+
+typedef struct {
+    esp_opus_ms_dec_cfg_t cfg;
+    opus_ms_dec_stream_t  stream[OPUS_MS_MAX_CHANNEL];
+    int8_t                src_stream[OPUS_MS_MAX_CHANNEL];
+    uint8_t               src_sub[OPUS_MS_MAX_CHANNEL];
+    uint8_t              *pkt_buf;
+    int                   pkt_buf_size;
+    int16_t              *pcm;
+    int                   pcm_size;
+    int                   last_samples;
+} opus_ms_dec_t;
+
+/* Frame duration in unit of 0.5 ms */
+static const uint8_t opus_ms_duration[] = {5, 10, 20, 40, 80, 120, 160, 200, 240};
+
+static int check_config(esp_opus_ms_dec_cfg_t *cfg)
+{
+    if (cfg->sample_rate != 8000 && cfg->sample_rate != 12000 && cfg->sample_rate != 16000 &&
+        cfg->sample_rate != 24000 && cfg->sample_rate != 48000) {
+        ESP_LOGE(TAG, "Not support sample rate %d", (int)cfg->sample_rate);
+        return -1;
+    }
+    if (cfg->channel < 1 || cfg->channel > OPUS_MS_MAX_CHANNEL) {
+        ESP_LOGE(TAG, "Not support channel %d", cfg->channel);
+        return -1;
+    }
+    if (cfg->stream_count < 1 || cfg->stream_count > OPUS_MS_MAX_CHANNEL || cfg->coupled_count > cfg->stream_count) {
+        ESP_LOGE(TAG, "Bad stream count %d coupled %d", cfg->stream_count, cfg->coupled_count);
+        return -1;
+    }
+    for (int i = 0; i < cfg->channel; i++) {
+        if (cfg->mapping[i] != OPUS_MS_MAPPING_SILENT && cfg->mapping[i] >= cfg->stream_count + cfg->coupled_count) {
+            ESP_LOGE(TAG, "Bad mapping %d for channel %d", cfg->mapping[i], i);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int get_default_samples(esp_opus_ms_dec_cfg_t *cfg)
+{
+    // Same as `esp_opus_dec`, count as 60 ms frame when duration is not set
+    int duration = opus_ms_duration[ESP_OPUS_DEC_FRAME_DURATION_60_MS];
+    if (cfg->frame_duration >= ESP_OPUS_DEC_FRAME_DURATION_2_5_MS &&
+        cfg->frame_duration <= ESP_OPUS_DEC_FRAME_DURATION_120_MS) {
+        duration = opus_ms_duration[cfg->frame_duration];
+    }
+    return cfg->sample_rate * duration / 2000;
+}
+
+static int prepare_buffer(uint8_t **buf, int *size, int need)
+{
+    if (need <= *size) {
+        return 0;
+    }
+    uint8_t *new_buf = (uint8_t *)realloc(*buf, need);
+    if (new_buf == NULL) {
+        ESP_LOGE(TAG, "No memory for buffer size %d", need);
+        return -1;
+    }
+    *buf = new_buf;
+    *size = need;
+    return 0;
+}
+
+/* Decode one stream packet into PCM buffer, grow buffer when core require more */
+static esp_audio_err_t decode_stream(opus_ms_dec_t *dec, int s, esp_audio_dec_in_raw_t *in, int *samples)
+{
+    opus_ms_dec_stream_t *stream = &dec->stream[s];
+    while (1) {
+        esp_audio_dec_out_frame_t out = {
+            .buffer = (uint8_t *)dec->pcm,
+            .len = dec->pcm_size,
+        };
+        esp_audio_dec_info_t info = {0};
+        esp_audio_err_t ret = esp_opus_dec_decode(stream->core, in, &out, &info);
+        if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH && (int)out.needed_size > dec->pcm_size) {
+            if (prepare_buffer((uint8_t **)&dec->pcm, &dec->pcm_size, out.needed_size) != 0) {
+                return ESP_AUDIO_ERR_MEM_LACK;
+            }
+            continue;
+        }
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to decode stream %d ret %d", s, ret);
+            return ret;
+        }
+        *samples = out.decoded_size / (stream->ch_num * sizeof(int16_t));
+        return ESP_AUDIO_ERR_OK;
+    }
+}
+
+esp_audio_err_t esp_opus_ms_dec_parse_head(const uint8_t *head, uint32_t size, esp_opus_ms_dec_cfg_t *cfg)
+{
+    if (head == NULL || cfg == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    if (size < OPUS_MS_HEAD_MIN_SIZE || memcmp(head, "OpusHead", 8) != 0 || (head[8] & 0xF0) != 0) {
+        ESP_LOGE(TAG, "Not valid OpusHead");
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    uint8_t channel = head[9];
+    uint8_t family = head[18];
+    if (channel < 1 || channel > OPUS_MS_MAX_CHANNEL) {
+        ESP_LOGE(TAG, "Not support channel %d", channel);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    if (family == 0) {
+        if (channel > 2) {
+            ESP_LOGE(TAG, "Bad channel %d for mapping family 0", channel);
+            return ESP_AUDIO_ERR_HEADER_PARSE;
+        }
+        const opus_ms_layout_t *layout = opus_ms_get_layout(channel);
+        cfg->stream_count = layout->stream_count;
+        cfg->coupled_count = layout->coupled_count;
+        memcpy(cfg->mapping, layout->mapping, channel);
+    } else if (family == 1) {
+        if (size < (uint32_t)(OPUS_MS_HEAD_MIN_SIZE + 2 + channel)) {
+            ESP_LOGE(TAG, "OpusHead too short for channel mapping table");
+            return ESP_AUDIO_ERR_HEADER_PARSE;
+        }
+        cfg->stream_count = head[19];
+        cfg->coupled_count = head[20];
+        memcpy(cfg->mapping, head + 21, channel);
+    } else {
+        ESP_LOGE(TAG, "Not support channel mapping family %d", family);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    cfg->channel = channel;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_dec_open(void *cfg, uint32_t cfg_sz, void **dec_handle)
+{
+    if (cfg == NULL || dec_handle == NULL || cfg_sz != sizeof(esp_opus_ms_dec_cfg_t)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *dec_handle = NULL;
+    esp_opus_ms_dec_cfg_t *ms_cfg = (esp_opus_ms_dec_cfg_t *)cfg;
+    if (check_config(ms_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_dec_t *dec = (opus_ms_dec_t *)calloc(1, sizeof(opus_ms_dec_t));
+    if (dec == NULL) {
+        ESP_LOGE(TAG, "No memory for decoder");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    dec->cfg = *ms_cfg;
+    for (int i = 0; i < ms_cfg->channel; i++) {
+        int sub = 0;
+        dec->src_stream[i] = (int8_t)opus_ms_get_stream(ms_cfg->mapping[i], ms_cfg->coupled_count, &sub);
+        dec->src_sub[i] = (uint8_t)sub;
+    }
+    esp_audio_err_t ret = ESP_AUDIO_ERR_OK;
+    for (int s = 0; s < ms_cfg->stream_count; s++) {
+        opus_ms_dec_stream_t *stream = &dec->stream[s];
+        stream->ch_num = s < ms_cfg->coupled_count ? 2 : 1;
+        esp_opus_dec_cfg_t core_cfg = {
+            .sample_rate = ms_cfg->sample_rate,
+            .channel = stream->ch_num,
+            .frame_duration = ms_cfg->frame_duration,
+            .self_delimited = false,
+        };
+        ret = esp_opus_dec_open(&core_cfg, sizeof(esp_opus_dec_cfg_t), &stream->core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to open decoder core for stream %d ret %d", s, ret);
+            break;
+        }
+    }
+    if (ret == ESP_AUDIO_ERR_OK &&
+        prepare_buffer((uint8_t **)&dec->pcm, &dec->pcm_size, get_default_samples(ms_cfg) * 2 * sizeof(int16_t)) != 0) {
+        ret = ESP_AUDIO_ERR_MEM_LACK;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        esp_opus_ms_dec_close(dec);
+        return ret;
+    }
+    *dec_handle = dec;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_dec_decode(void *dec_handle, esp_audio_dec_in_raw_t *raw, esp_audio_dec_out_frame_t *frame,
+                                       esp_audio_dec_info_t *dec_info)
+{
+    if (dec_handle == NULL || raw == NULL || frame == NULL || dec_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_dec_t *dec = (opus_ms_dec_t *)dec_handle;
+    int stream_num = dec->cfg.stream_count;
+    int ch = dec->cfg.channel;
+    bool plc = raw->frame_recover == ESP_AUDIO_DEC_RECOVERY_PLC;
+    int pkt_pos[OPUS_MS_MAX_CHANNEL] = {0};
+    int samples = 0;
+    raw->consumed = 0;
+    if (plc) {
+        samples = dec->last_samples ? dec->last_samples : get_default_samples(&dec->cfg);
+    } else {
+        if (raw->buffer == NULL || raw->len == 0) {
+            ESP_LOGE(TAG, "Invalid parameter");
+            return ESP_AUDIO_ERR_INVALID_PARAMETER;
+        }
+        // Validate framing of all streams before decoding so that no stream state changes on error
+        int pos = 0;
+        for (int s = 0; s < stream_num; s++) {
+            opus_ms_pkt_t pkt;
+            bool last = (s == stream_num - 1);
+            pkt_pos[s] = pos;
+            if (opus_ms_pkt_parse(raw->buffer + pos, raw->len - pos, !last, &pkt) != 0) {
+                ESP_LOGE(TAG, "Bad packet of stream %d", s);
+                return ESP_AUDIO_ERR_FAIL;
+            }
+            if (s == 0) {
+                samples = opus_ms_pkt_get_samples(&pkt, dec->cfg.sample_rate);
+            }
+            pos += pkt.size;
+        }
+        if (prepare_buffer(&dec->pkt_buf, &dec->pkt_buf_size, raw->len) != 0) {
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+    }
+    uint32_t out_size = samples * ch * sizeof(int16_t);
+    if (frame->buffer == NULL || frame->len < out_size) {
+        frame->needed_size = out_size;
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    int16_t *out = (int16_t *)frame->buffer;
+    for (int i = 0; i < ch; i++) {
+        if (dec->src_stream[i] < 0) {
+            for (int j = 0; j < samples; j++) {
+                out[j * ch + i] = 0;
+            }
+        }
+    }
+    for (int s = 0; s < stream_num; s++) {
+        esp_audio_dec_in_raw_t in = {
+            .frame_recover = raw->frame_recover,
+        };
+        if (plc == false) {
+            if (s < stream_num - 1) {
+                int consumed = 0;
+                in.buffer = dec->pkt_buf;
+                in.len = opus_ms_pkt_to_undelimited(raw->buffer + pkt_pos[s], raw->len - pkt_pos[s], dec->pkt_buf, &consumed);
+            } else {
+                in.buffer = raw->buffer + pkt_pos[s];
+                in.len = raw->len - pkt_pos[s];
+            }
+        }
+        int stream_samples = 0;
+        esp_audio_err_t ret = decode_stream(dec, s, &in, &stream_samples);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        if (stream_samples != samples) {
+            ESP_LOGE(TAG, "Stream %d decoded %d samples, expect %d", s, stream_samples, samples);
+            return ESP_AUDIO_ERR_FAIL;
+        }
+        int stream_ch = dec->stream[s].ch_num;
+        for (int i = 0; i < ch; i++) {
+            if (dec->src_stream[i] != s) {
+                continue;
+            }
+            const int16_t *src = dec->pcm + dec->src_sub[i];
+            for (int j = 0; j < samples; j++) {
+                out[j * ch + i] = src[j * stream_ch];
+            }
+        }
+    }
+    dec->last_samples = samples;
+    raw->consumed = raw->len;
+    frame->decoded_size = out_size;
+    dec_info->sample_rate = dec->cfg.sample_rate;
+    dec_info->channel = ch;
+    dec_info->bits_per_sample = ESP_AUDIO_BIT16;
+    dec_info->frame_size = out_size;
+    if (plc == false && samples) {
+        dec_info->bitrate = (uint32_t)((uint64_t)raw->len * 8 * dec->cfg.sample_rate / samples);
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_dec_reset(void *dec_handle)
+{
+    if (dec_handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_dec_t *dec = (opus_ms_dec_t *)dec_handle;
+    for (int s = 0; s < dec->cfg.stream_count; s++) {
+        esp_audio_err_t ret = esp_opus_dec_reset(dec->stream[s].core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+    }
+    dec->last_samples = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_dec_close(void *dec_handle)
+{
+    if (dec_handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_dec_t *dec = (opus_ms_dec_t *)dec_handle;
+    for (int s = 0; s < dec->cfg.stream_count; s++) {
+        if (dec->stream[s].core) {
+            esp_opus_dec_close(dec->stream[s].core);
+        }
+    }
+    if (dec->pkt_buf) {
+        free(dec->pkt_buf);
+    }
+    if (dec->pcm) {
+        free(dec->pcm);
+    }
+    free(dec);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_dec_register(void)
+{
+    static const esp_audio_dec_ops_t opus_ms_dec_ops = {
+        .open = esp_opus_ms_dec_open,
+        .decode = esp_opus_ms_dec_decode,
+        .reset = esp_opus_ms_dec_reset,
+        .close = esp_opus_ms_dec_close,
+    };
+    return esp_audio_dec_register(ESP_AUDIO_TYPE_OPUS, &opus_ms_dec_ops);
+}
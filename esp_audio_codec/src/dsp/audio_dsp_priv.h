@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_audio_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Generic vectors with __builtin_convertvector need GCC 9 or clang */
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9)
+#define AUDIO_DSP_VECTOR_SUPPORT
+#endif  /* defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) */
+
+/* Platforms where 64 bits vector lanes map to real SIMD instructions, SSE only is slower than scalar */
+#if defined(AUDIO_DSP_VECTOR_SUPPORT) && (defined(__AVX2__) || defined(__aarch64__))
+#define AUDIO_DSP_VECTOR_PREFERRED
+#endif  /* defined(AUDIO_DSP_VECTOR_SUPPORT) && (defined(__AVX2__) || defined(__aarch64__)) */
+
+static inline int32_t audio_dsp_sat32(int64_t v)
+{
+    if (v > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (v < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)v;
+}
+
+static inline int16_t audio_dsp_sat16(int64_t v)
+{
+    if (v > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (v < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)v;
+}
+
+static inline int64_t audio_dsp_round(int64_t v, int shift)
+{
+    return shift > 0 ? (v + ((int64_t)1 << (shift - 1))) >> shift : v;
+}
+
+static inline int32_t audio_dsp_shl(int32_t v, int shift)
+{
+    // Left shift of negative value is undefined, shift the bit pattern as unsigned
+    return (int32_t)((uint32_t)v << shift);
+}
+
+extern const esp_audio_dsp_ops_t audio_dsp_ref_ops;
+
+#ifdef AUDIO_DSP_VECTOR_SUPPORT
+extern const esp_audio_dsp_ops_t audio_dsp_vec_ops;
+#endif  /* AUDIO_DSP_VECTOR_SUPPORT */
+
+#ifdef __cplusplus
+}
+#endif
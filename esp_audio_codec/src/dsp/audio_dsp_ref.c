@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include "audio_dsp_priv.h"
+
+#define MDCT_FRAC_BITS (30)
+
+static int64_t dot_ref(const int32_t *a, const int32_t *b, int n)
+{
+    int64_t acc = 0;
+    for (int i = 0; i < n; i++) {
+        acc += (int64_t)a[i] * b[i];
+    }
+    return acc;
+}
+
+static void fir_ref(const int32_t *coef, int taps, const int32_t *in, int32_t *out, int n, int shift)
+{
+    for (int i = 0; i < n; i++) {
+        out[i] = audio_dsp_sat32(audio_dsp_round(dot_ref(coef, in + i, taps), shift));
+    }
+}
+
+static void mdct_ref(const esp_audio_dsp_mdct_t *mdct, const int32_t *in, int32_t *out)
+{
+    int n = mdct->n;
+    const int32_t *kern = mdct->kern;
+    for (int m = 0; m < n / 2; m++) {
+        out[m] = (int32_t)audio_dsp_round(dot_ref(kern, in, n), MDCT_FRAC_BITS);
+        kern += n;
+    }
+}
+
+static void imdct_ref(const esp_audio_dsp_mdct_t *mdct, const int32_t *in, int32_t *out)
+{
+    int n = mdct->n;
+    for (int i = 0; i < n; i++) {
+        const int32_t *kern = mdct->kern + i;
+        int64_t acc = 0;
+        for (int m = 0; m < n / 2; m++) {
+            acc += (int64_t)kern[m * n] * in[m];
+        }
+        out[i] = (int32_t)audio_dsp_round(acc, MDCT_FRAC_BITS);
+    }
+}
+
+static void interleave_s16_ref(const int32_t *const *in, int ch, int n, int shift, int16_t *out)
+{
+    for (int i = 0; i < n; i++) {
+        for (int c = 0; c < ch; c++) {
+            *(out++) = audio_dsp_sat16(audio_dsp_round(in[c][i], shift));
+        }
+    }
+}
+
+static void deinterleave_s16_ref(const int16_t *in, int ch, int n, int shift, int32_t *const *out)
+{
+    for (int i = 0; i < n; i++) {
+        for (int c = 0; c < ch; c++) {
+            out[c][i] = audio_dsp_shl(*(in++), shift);
+        }
+    }
+}
+
+const esp_audio_dsp_ops_t audio_dsp_ref_ops = {
+    .dot = dot_ref,
+    .fir = fir_ref,
+    .mdct = mdct_ref,
+    .imdct = imdct_ref,
+    .interleave_s16 = interleave_s16_ref,
+    .deinterleave_s16 = deinterleave_s16_ref,
+};
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include "audio_dsp_priv.h"
+
+#ifdef AUDIO_DSP_VECTOR_SUPPORT
+
+#if defined(__GNUC__) && !defined(__clang__)
+/* 32 bytes vectors are passed in memory without AVX, only static functions use them */
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif  /* defined(__GNUC__) && !defined(__clang__) */
+
+#define MDCT_FRAC_BITS (30)
+
+typedef int32_t v4si __attribute__((vector_size(16)));
+typedef uint32_t v4su __attribute__((vector_size(16)));
+typedef int64_t v4di __attribute__((vector_size(32)));
+
+static inline v4di load_v4di(const int32_t *p)
+{
+    v4si v;
+    // Input may not be 16 bytes aligned
+    memcpy(&v, p, sizeof(v));
+    return __builtin_convertvector(v, v4di);
+}
+
+static inline v4di round_v4di(v4di v, int shift)
+{
+    return shift > 0 ? (v + ((int64_t)1 << (shift - 1))) >> shift : v;
+}
+
+static inline v4di clamp_v4di(v4di v, int64_t lo, int64_t hi)
+{
+    v4di hi_mask = v > hi;
+    v = (v & ~hi_mask) | (hi_mask & hi);
+    v4di lo_mask = v < lo;
+    return (v & ~lo_mask) | (lo_mask & lo);
+}
+
+static int64_t dot_vec(const int32_t *a, const int32_t *b, int n)
+{
+    v4di acc = {0};
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc += load_v4di(a + i) * load_v4di(b + i);
+    }
+    int64_t sum = acc[0] + acc[1] + acc[2] + acc[3];
+    for (; i < n; i++) {
+        sum += (int64_t)a[i] * b[i];
+    }
+    return sum;
+}
+
+static void fir_vec(const int32_t *coef, int taps, const int32_t *in, int32_t *out, int n, int shift)
+{
+    int i = 0;
+    // Four outputs share one broadcast coefficient per tap
+    for (; i + 4 <= n; i += 4) {
+        v4di acc = {0};
+        for (int k = 0; k < taps; k++) {
+            acc += load_v4di(in + i + k) * (int64_t)coef[k];
+        }
+        acc = clamp_v4di(round_v4di(acc, shift), INT32_MIN, INT32_MAX);
+        for (int j = 0; j < 4; j++) {
+            out[i + j] = (int32_t)acc[j];
+        }
+    }
+    for (; i < n; i++) {
+        out[i] = audio_dsp_sat32(audio_dsp_round(dot_vec(coef, in + i, taps), shift));
+    }
+}
+
+static void mdct_vec(const esp_audio_dsp_mdct_t *mdct, const int32_t *in, int32_t *out)
+{
+    int n = mdct->n;
+    const int32_t *kern = mdct->kern;
+    for (int m = 0; m < n / 2; m++) {
+        out[m] = (int32_t)audio_dsp_round(dot_vec(kern, in, n), MDCT_FRAC_BITS);
+        kern += n;
+    }
+}
+
+static void imdct_vec(const esp_audio_dsp_mdct_t *mdct, const int32_t *in, int32_t *out)
+{
+    int n = mdct->n;
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v4di acc = {0};
+        for (int m = 0; m < n / 2; m++) {
+            acc += load_v4di(mdct->kern + m * n + i) * (int64_t)in[m];
+        }
+        acc = round_v4di(acc, MDCT_FRAC_BITS);
+        for (int j = 0; j < 4; j++) {
+            out[i + j] = (int32_t)acc[j];
+        }
+    }
+    for (; i < n; i++) {
+        int64_t acc = 0;
+        for (int m = 0; m < n / 2; m++) {
+            acc += (int64_t)mdct->kern[m * n + i] * in[m];
+        }
+        out[i] = (int32_t)audio_dsp_round(acc, MDCT_FRAC_BITS);
+    }
+}
+
+static void interleave_s16_vec(const int32_t *const *in, int ch, int n, int shift, int16_t *out)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int c = 0; c < ch; c++) {
+            v4di v = clamp_v4di(round_v4di(load_v4di(in[c] + i), shift), INT16_MIN, INT16_MAX);
+            for (int j = 0; j < 4; j++) {
+                out[j * ch + c] = (int16_t)v[j];
+            }
+        }
+        out += 4 * ch;
+    }
+    for (; i < n; i++) {
+        for (int c = 0; c < ch; c++) {
+            *(out++) = audio_dsp_sat16(audio_dsp_round(in[c][i], shift));
+        }
+    }
+}
+
+static void deinterleave_s16_vec(const int16_t *in, int ch, int n, int shift, int32_t *const *out)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        for (int c = 0; c < ch; c++) {
+            // Unsigned lanes, left shift of negative value is undefined
+            v4su v = {in[c], in[ch + c], in[2 * ch + c], in[3 * ch + c]};
+            v <<= shift;
+            memcpy(out[c] + i, &v, sizeof(v));
+        }
+        in += 4 * ch;
+    }
+    for (; i < n; i++) {
+        for (int c = 0; c < ch; c++) {
+            out[c][i] = audio_dsp_shl(*(in++), shift);
+        }
+    }
+}
+
+const esp_audio_dsp_ops_t audio_dsp_vec_ops = {
+    .dot = dot_vec,
+    .fir = fir_vec,
+    .mdct = mdct_vec,
+    .imdct = imdct_vec,
+    .interleave_s16 = interleave_s16_vec,
+    .deinterleave_s16 = deinterleave_s16_vec,
+};
+
+#endif  /* AUDIO_DSP_VECTOR_SUPPORT */
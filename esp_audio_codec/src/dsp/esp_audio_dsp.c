@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <math.h>
+#include "esp_log.h"
+#include "audio_dsp_priv.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define TAG "AUD_DSP"
+
+static const esp_audio_dsp_ops_t *dsp_ops;
+
+const esp_audio_dsp_ops_t *esp_audio_dsp_get_backend_ops(esp_audio_dsp_backend_t backend)
+{
+    switch (backend) {
+        case ESP_AUDIO_DSP_BACKEND_AUTO:
+#ifdef AUDIO_DSP_VECTOR_PREFERRED
+            return &audio_dsp_vec_ops;
+#else
+            return &audio_dsp_ref_ops;
+#endif  /* AUDIO_DSP_VECTOR_PREFERRED */
+        case ESP_AUDIO_DSP_BACKEND_REF:
+            return &audio_dsp_ref_ops;
+#ifdef AUDIO_DSP_VECTOR_SUPPORT
+        case ESP_AUDIO_DSP_BACKEND_VECTOR:
+            return &audio_dsp_vec_ops;
+#endif  /* AUDIO_DSP_VECTOR_SUPPORT */
+        default:
+            return NULL;
+    }
+}
+
+esp_audio_err_t esp_audio_dsp_init(esp_audio_dsp_backend_t backend)
+{
+    const esp_audio_dsp_ops_t *ops = esp_audio_dsp_get_backend_ops(backend);
+    if (ops == NULL) {
+        ESP_LOGE(TAG, "Backend %d not supported", backend);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    dsp_ops = ops;
+    return ESP_AUDIO_ERR_OK;
+}
+
+const esp_audio_dsp_ops_t *esp_audio_dsp_get_ops(void)
+{
+    if (dsp_ops == NULL) {
+        dsp_ops = esp_audio_dsp_get_backend_ops(ESP_AUDIO_DSP_BACKEND_AUTO);
+    }
+    return dsp_ops;
+}
+
+void esp_audio_dsp_mdct_gen_kernel(int n, const float *win, double gain, int32_t *kern)
+{
+    for (int m = 0; m < n / 2; m++) {
+        for (int i = 0; i < n; i++) {
+            double w = win ? win[i] : sin(M_PI / n * (i + 0.5));
+            double v = w * cos(M_PI / (2 * n) * (2 * i + 1 + n / 2) * (2 * m + 1)) / gain;
+            *(kern++) = (int32_t)lrint(v * 1073741824.0);
+        }
+    }
+}
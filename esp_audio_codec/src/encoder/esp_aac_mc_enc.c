@@ -0,0 +1,628 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_aac_mc_enc.h"
+#include "esp_aac_enc.h"
+#include "esp_audio_enc_reg.h"
+#include "esp_log.h"
+
+#define TAG "AAC_MC_ENC"
+
+#define AAC_MC_FRAME_SAMPLES  (1024)
+#define AAC_MC_MAX_ELEMENTS   (5)
+#define AAC_MC_ADTS_SIZE      (7)
+#define AAC_MC_ASC_SIZE       (2)
+#define AAC_MC_LFE_CUTOFF     (120.0f)
+#define AAC_MC_LFE_BITRATE    (12000)
+#define AAC_MC_ID_SCE         (0)
+#define AAC_MC_ID_CPE         (1)
+#define AAC_MC_ID_LFE         (3)
+#define AAC_MC_ID_END         (7)
+#define AAC_MC_ID_BITS        (3)
+#define AAC_MC_TAG_BITS       (4)
+#define AAC_MC_WIN_SEQ_POS    (16)
+#define AAC_MC_ONLY_LONG      (0)
+
+typedef struct {
+    float b0, b1, b2, a1, a2;
+    float z1, z2;
+} aac_mc_biquad_t;
+
+typedef struct {
+    uint8_t         id;
+    uint8_t         tag;
+    uint8_t         ch_num;
+    uint8_t         ch_start;
+    void           *core;
+    int             core_out_size;
+    int             bitrate;
+    aac_mc_biquad_t lfe_lpf;
+} aac_mc_elem_t;
+
+typedef struct {
+    esp_aac_mc_enc_config_t cfg;
+    uint8_t                 ch_config;
+    uint8_t                 sr_idx;
+    uint8_t                 elem_num;
+    aac_mc_elem_t           elem[AAC_MC_MAX_ELEMENTS];
+    int16_t                *pcm;
+    uint8_t                *core_out;
+    int                     core_out_size;
+    int                     out_frame_size;
+    uint64_t                samples;
+    uint8_t                 asc[AAC_MC_ASC_SIZE];
+} aac_mc_enc_t;
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t acc;
+    int      acc_bits;
+    int      pos;
+} aac_mc_bs_t;
+
+typedef struct {
+    uint8_t channel;
+    uint8_t ch_config;
+    uint8_t elem_num;
+    uint8_t elem_id[AAC_MC_MAX_ELEMENTS];
+} aac_mc_layout_t;
+
+static const aac_mc_layout_t aac_mc_layouts[] = {
+    {1, 1, 1, {AAC_MC_ID_SCE}},
+    {2, 2, 1, {AAC_MC_ID_CPE}},
+    {3, 3, 2, {AAC_MC_ID_SCE, AAC_MC_ID_CPE}},
+    {4, 4, 3, {AAC_MC_ID_SCE, AAC_MC_ID_CPE, AAC_MC_ID_SCE}},
+    {5, 5, 3, {AAC_MC_ID_SCE, AAC_MC_ID_CPE, AAC_MC_ID_CPE}},
+    {6, 6, 4, {AAC_MC_ID_SCE, AAC_MC_ID_CPE, AAC_MC_ID_CPE, AAC_MC_ID_LFE}},
+    {8, 7, 5, {AAC_MC_ID_SCE, AAC_MC_ID_CPE, AAC_MC_ID_CPE, AAC_MC_ID_CPE, AAC_MC_ID_LFE}},
+};
+
+static const int aac_mc_sample_rates[] = {
+    96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000,
+};
+
+/* Supported mono bitrate range of `esp_aac_enc` for each sample rate index */
+static const int aac_mc_mono_bitrate[][2] = {
+    {70000, 160000}, {67000, 160000}, {65000, 160000}, {59000, 160000},
+    {57000, 160000}, {33000, 160000}, {31000, 144000}, {25000, 132000},
+    {22000, 96000},  {20000, 72000},  {18000, 66000},  {12000, 48000},
+};
+
+static inline void bs_put(aac_mc_bs_t *bs, uint32_t val, int bits)
+{
+    bs->acc = (bs->acc << bits) | (val & ((1u << bits) - 1));
+    bs->acc_bits += bits;
+    while (bs->acc_bits >= 8) {
+        bs->acc_bits -= 8;
+        bs->buf[bs->pos++] = (uint8_t)(bs->acc >> bs->acc_bits);
+    }
+}
+
+static inline int get_bit(const uint8_t *buf, int pos)
+{
+    return (buf[pos >> 3] >> (7 - (pos & 7))) & 1;
+}
+
+static void bs_copy(aac_mc_bs_t *bs, const uint8_t *src, int start, int end)
+{
+    int pos = start;
+    // Copy leading bits until source is byte aligned, then copy byte by byte
+    while ((pos & 7) && pos < end) {
+        bs_put(bs, get_bit(src, pos), 1);
+        pos++;
+    }
+    for (; pos + 8 <= end; pos += 8) {
+        bs_put(bs, src[pos >> 3], 8);
+    }
+    for (; pos < end; pos++) {
+        bs_put(bs, get_bit(src, pos), 1);
+    }
+}
+
+static const aac_mc_layout_t *get_layout(int channel)
+{
+    for (int i = 0; i < (int)(sizeof(aac_mc_layouts) / sizeof(aac_mc_layouts[0])); i++) {
+        if (aac_mc_layouts[i].channel == channel) {
+            return &aac_mc_layouts[i];
+        }
+    }
+    return NULL;
+}
+
+static int get_sample_rate_index(int sample_rate)
+{
+    for (int i = 0; i < (int)(sizeof(aac_mc_sample_rates) / sizeof(aac_mc_sample_rates[0])); i++) {
+        if (aac_mc_sample_rates[i] == sample_rate) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int check_config(esp_aac_mc_enc_config_t *cfg)
+{
+    if (get_sample_rate_index(cfg->sample_rate) < 0) {
+        ESP_LOGE(TAG, "Not support sample rate %d", cfg->sample_rate);
+        return -1;
+    }
+    if (get_layout(cfg->channel) == NULL) {
+        ESP_LOGE(TAG, "Not support channel %d", cfg->channel);
+        return -1;
+    }
+    if (cfg->bits_per_sample != ESP_AUDIO_BIT16 && cfg->bits_per_sample != ESP_AUDIO_BIT24 &&
+        cfg->bits_per_sample != ESP_AUDIO_BIT32) {
+        ESP_LOGE(TAG, "Not support bits per sample %d", cfg->bits_per_sample);
+        return -1;
+    }
+    if (cfg->bitrate < 0) {
+        ESP_LOGE(TAG, "Not support bitrate %d", cfg->bitrate);
+        return -1;
+    }
+    return 0;
+}
+
+static void split_bitrate(const aac_mc_layout_t *layout, int sr_idx, int bitrate, int *elem_bitrate)
+{
+    int min_rate = aac_mc_mono_bitrate[sr_idx][0];
+    int max_rate = aac_mc_mono_bitrate[sr_idx][1];
+    if (bitrate == 0) {
+        memset(elem_bitrate, 0, layout->elem_num * sizeof(int));
+        return;
+    }
+    // LFE only carries low band, layouts with LFE keep a small budget for it and share the rest by channel
+    int full_ch = 0;
+    int lfe_num = 0;
+    for (int i = 0; i < layout->elem_num; i++) {
+        if (layout->elem_id[i] == AAC_MC_ID_LFE) {
+            lfe_num++;
+        } else {
+            full_ch += (layout->elem_id[i] == AAC_MC_ID_CPE) ? 2 : 1;
+        }
+    }
+    int per_ch = (bitrate - lfe_num * AAC_MC_LFE_BITRATE) / full_ch;
+    per_ch = per_ch < min_rate ? min_rate : (per_ch > max_rate ? max_rate : per_ch);
+    for (int i = 0; i < layout->elem_num; i++) {
+        uint8_t id = layout->elem_id[i];
+        elem_bitrate[i] = (id == AAC_MC_ID_LFE) ? AAC_MC_LFE_BITRATE : per_ch * (id == AAC_MC_ID_CPE ? 2 : 1);
+    }
+}
+
+static inline int get_core_bitrate(aac_mc_elem_t *elem)
+{
+    // The minimum CBR bitrate of the core is far above what a 120 Hz band needs,
+    // LFE core runs in VBR so only the few coded low bands consume bits
+    return elem->id == AAC_MC_ID_LFE ? 0 : elem->bitrate;
+}
+
+static void lfe_lpf_init(aac_mc_biquad_t *bq, int sample_rate)
+{
+    // Second order Butterworth low pass
+    float w0 = 2.0f * (float)M_PI * AAC_MC_LFE_CUTOFF / sample_rate;
+    float cs = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * 0.70710678f);
+    float a0 = 1.0f + alpha;
+    bq->b0 = (1.0f - cs) * 0.5f / a0;
+    bq->b1 = (1.0f - cs) / a0;
+    bq->b2 = bq->b0;
+    bq->a1 = -2.0f * cs / a0;
+    bq->a2 = (1.0f - alpha) / a0;
+    bq->z1 = 0;
+    bq->z2 = 0;
+}
+
+static inline int16_t sat16(int32_t v)
+{
+    return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+}
+
+static inline int16_t read_sample(const uint8_t *p, int bits)
+{
+    // Round to nearest while converting to 16 bits
+    if (bits == ESP_AUDIO_BIT16) {
+        return *(const int16_t *)p;
+    }
+    if (bits == ESP_AUDIO_BIT24) {
+        int32_t v = p[0] | (p[1] << 8) | ((int8_t)p[2] * 65536);
+        return sat16((v + 128) >> 8);
+    }
+    int32_t v = *(const int32_t *)p;
+    return sat16((int32_t)(((int64_t)v + 32768) >> 16));
+}
+
+static void load_element(aac_mc_enc_t *enc, aac_mc_elem_t *elem, const uint8_t *in)
+{
+    int sample_bytes = enc->cfg.bits_per_sample >> 3;
+    int stride = enc->cfg.channel * sample_bytes;
+    int16_t *dst = enc->pcm;
+    for (int c = 0; c < elem->ch_num; c++) {
+        const uint8_t *src = in + (elem->ch_start + c) * sample_bytes;
+        for (int i = 0; i < AAC_MC_FRAME_SAMPLES; i++, src += stride) {
+            dst[i * elem->ch_num + c] = read_sample(src, enc->cfg.bits_per_sample);
+        }
+    }
+    if (elem->id == AAC_MC_ID_LFE) {
+        aac_mc_biquad_t *bq = &elem->lfe_lpf;
+        for (int i = 0; i < AAC_MC_FRAME_SAMPLES; i++) {
+            float x = dst[i];
+            float y = bq->b0 * x + bq->z1;
+            bq->z1 = bq->b1 * x - bq->a1 * y + bq->z2;
+            bq->z2 = bq->b2 * x - bq->a2 * y;
+            dst[i] = sat16((int32_t)lrintf(y));
+        }
+    }
+}
+
+/* Get bit position of ID_END in raw data block, only trailing byte alignment bits can follow it */
+static int find_end_element(const uint8_t *buf, int len)
+{
+    int pos = len * 8 - 1;
+    while (pos >= 0 && get_bit(buf, pos) == 0) {
+        pos--;
+    }
+    pos -= AAC_MC_ID_BITS - 1;
+    if (pos < AAC_MC_ID_BITS + AAC_MC_TAG_BITS) {
+        return -1;
+    }
+    for (int i = 0; i < AAC_MC_ID_BITS; i++) {
+        if (get_bit(buf, pos + i) == 0) {
+            return -1;
+        }
+    }
+    return pos;
+}
+
+/* Get window_sequence of the SCE written by encoder core, it follows id, tag, global_gain and ics_reserved_bit */
+static inline int get_window_sequence(const uint8_t *buf)
+{
+    return (get_bit(buf, AAC_MC_WIN_SEQ_POS) << 1) | get_bit(buf, AAC_MC_WIN_SEQ_POS + 1);
+}
+
+/* Write LFE element with ONLY_LONG_SEQUENCE and no scale factor band, decoded as silence */
+static void write_silent_lfe(aac_mc_bs_t *bs, uint8_t tag)
+{
+    bs_put(bs, AAC_MC_ID_LFE, AAC_MC_ID_BITS);
+    bs_put(bs, tag, AAC_MC_TAG_BITS);
+    // global_gain
+    bs_put(bs, 100, 8);
+    // ics_reserved_bit, window_sequence ONLY_LONG_SEQUENCE, window_shape, max_sfb 0, predictor_data_present
+    bs_put(bs, 0, 1 + 2 + 1 + 6 + 1);
+    // pulse_data_present, tns_data_present, gain_control_data_present
+    bs_put(bs, 0, 3);
+}
+
+static void write_adts_header(aac_mc_enc_t *enc, uint8_t *out, int frame_len)
+{
+    aac_mc_bs_t bs = {
+        .buf = out,
+    };
+    bs_put(&bs, 0xFFF, 12);
+    // MPEG-4, layer 0, no CRC
+    bs_put(&bs, 0, 1);
+    bs_put(&bs, 0, 2);
+    bs_put(&bs, 1, 1);
+    // AAC-LC profile
+    bs_put(&bs, 1, 2);
+    bs_put(&bs, enc->sr_idx, 4);
+    bs_put(&bs, 0, 1);
+    bs_put(&bs, enc->ch_config, 3);
+    bs_put(&bs, 0, 4);
+    bs_put(&bs, frame_len, 13);
+    // VBR buffer fullness, one raw data block
+    bs_put(&bs, 0x7FF, 11);
+    bs_put(&bs, 0, 2);
+}
+
+static int encode_frame(aac_mc_enc_t *enc, const uint8_t *in, uint8_t *out, int *out_len)
+{
+    int header = enc->cfg.adts_used ? AAC_MC_ADTS_SIZE : 0;
+    aac_mc_bs_t bs = {
+        .buf = out + header,
+    };
+    int empty = 0;
+    for (int e = 0; e < enc->elem_num; e++) {
+        aac_mc_elem_t *elem = &enc->elem[e];
+        load_element(enc, elem, in);
+        esp_audio_enc_in_frame_t core_in = {
+            .buffer = (uint8_t *)enc->pcm,
+            .len = AAC_MC_FRAME_SAMPLES * elem->ch_num * sizeof(int16_t),
+        };
+        esp_audio_enc_out_frame_t core_out = {
+            .buffer = enc->core_out,
+            .len = enc->core_out_size,
+        };
+        if (esp_aac_enc_process(elem->core, &core_in, &core_out) != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to encode element %d", e);
+            return -1;
+        }
+        if (core_out.encoded_bytes == 0) {
+            empty++;
+            continue;
+        }
+        int end = find_end_element(enc->core_out, core_out.encoded_bytes);
+        uint8_t core_id = (enc->core_out[0] >> 5) & 0x7;
+        if (end < 0 || core_id != (elem->ch_num == 2 ? AAC_MC_ID_CPE : AAC_MC_ID_SCE)) {
+            ESP_LOGE(TAG, "Unexpected raw data block of element %d", e);
+            return -1;
+        }
+        if (elem->id == AAC_MC_ID_LFE && get_window_sequence(enc->core_out) != AAC_MC_ONLY_LONG) {
+            // LFE must use long window only, mute it for this frame instead of writing a non-conforming element
+            ESP_LOGW(TAG, "Drop LFE frame with window sequence %d", get_window_sequence(enc->core_out));
+            write_silent_lfe(&bs, elem->tag);
+            continue;
+        }
+        // Re-tag the element and keep the rest including fill elements
+        bs_put(&bs, elem->id, AAC_MC_ID_BITS);
+        bs_put(&bs, elem->tag, AAC_MC_TAG_BITS);
+        bs_copy(&bs, enc->core_out, AAC_MC_ID_BITS + AAC_MC_TAG_BITS, end);
+    }
+    if (empty) {
+        // All cores share the same delay, nothing is output until all of them produce data
+        if (empty != enc->elem_num) {
+            ESP_LOGE(TAG, "Element output mismatch");
+            return -1;
+        }
+        *out_len = 0;
+        return 0;
+    }
+    bs_put(&bs, AAC_MC_ID_END, AAC_MC_ID_BITS);
+    if (bs.acc_bits) {
+        bs_put(&bs, 0, 8 - bs.acc_bits);
+    }
+    if (header) {
+        write_adts_header(enc, out, header + bs.pos);
+    }
+    *out_len = header + bs.pos;
+    return 0;
+}
+
+static void close_elements(aac_mc_enc_t *enc)
+{
+    for (int e = 0; e < enc->elem_num; e++) {
+        if (enc->elem[e].core) {
+            esp_aac_enc_close(enc->elem[e].core);
+            enc->elem[e].core = NULL;
+        }
+    }
+}
+
+static int get_out_frame_size(const esp_aac_mc_enc_config_t *cfg)
+{
+    // Each channel of AAC raw data block is limited to 6144 bits
+    return AAC_MC_ADTS_SIZE + cfg->channel * 768 + 1;
+}
+
+esp_audio_err_t esp_aac_mc_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info)
+{
+    if (cfg == NULL || frame_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_aac_mc_enc_config_t *mc_cfg = (esp_aac_mc_enc_config_t *)cfg;
+    if (check_config(mc_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    int sample_bytes = mc_cfg->channel * (mc_cfg->bits_per_sample >> 3);
+    frame_info->in_frame_size = AAC_MC_FRAME_SAMPLES * sample_bytes;
+    frame_info->in_frame_align = sample_bytes;
+    frame_info->out_frame_size = get_out_frame_size(mc_cfg);
+    frame_info->out_frame_align = 1;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd)
+{
+    if (cfg == NULL || enc_hd == NULL || cfg_sz != sizeof(esp_aac_mc_enc_config_t)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *enc_hd = NULL;
+    esp_aac_mc_enc_config_t *mc_cfg = (esp_aac_mc_enc_config_t *)cfg;
+    if (check_config(mc_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)calloc(1, sizeof(aac_mc_enc_t));
+    if (enc == NULL) {
+        ESP_LOGE(TAG, "No memory for encoder");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    const aac_mc_layout_t *layout = get_layout(mc_cfg->channel);
+    enc->cfg = *mc_cfg;
+    enc->ch_config = layout->ch_config;
+    enc->sr_idx = (uint8_t)get_sample_rate_index(mc_cfg->sample_rate);
+    enc->elem_num = layout->elem_num;
+    enc->out_frame_size = get_out_frame_size(mc_cfg);
+    int elem_bitrate[AAC_MC_MAX_ELEMENTS];
+    split_bitrate(layout, enc->sr_idx, mc_cfg->bitrate, elem_bitrate);
+    esp_audio_err_t ret = ESP_AUDIO_ERR_OK;
+    uint8_t tag_count[AAC_MC_ID_END + 1] = {0};
+    int ch_start = 0;
+    for (int e = 0; e < enc->elem_num; e++) {
+        aac_mc_elem_t *elem = &enc->elem[e];
+        elem->id = layout->elem_id[e];
+        elem->tag = tag_count[elem->id]++;
+        elem->ch_num = (elem->id == AAC_MC_ID_CPE) ? 2 : 1;
+        elem->ch_start = (uint8_t)ch_start;
+        elem->bitrate = elem_bitrate[e];
+        ch_start += elem->ch_num;
+        if (elem->id == AAC_MC_ID_LFE) {
+            lfe_lpf_init(&elem->lfe_lpf, mc_cfg->sample_rate);
+        }
+        esp_aac_enc_config_t core_cfg = {
+            .sample_rate = mc_cfg->sample_rate,
+            .channel = elem->ch_num,
+            .bits_per_sample = ESP_AUDIO_BIT16,
+            .bitrate = get_core_bitrate(elem),
+            .adts_used = false,
+        };
+        ret = esp_aac_enc_open(&core_cfg, sizeof(esp_aac_enc_config_t), &elem->core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to open encoder core for element %d ret %d", e, ret);
+            break;
+        }
+        int in_size = 0;
+        esp_aac_enc_get_frame_size(elem->core, &in_size, &elem->core_out_size);
+        if (elem->core_out_size > enc->core_out_size) {
+            enc->core_out_size = elem->core_out_size;
+        }
+    }
+    if (ret == ESP_AUDIO_ERR_OK) {
+        enc->pcm = (int16_t *)malloc(AAC_MC_FRAME_SAMPLES * 2 * sizeof(int16_t));
+        enc->core_out = (uint8_t *)malloc(enc->core_out_size);
+        if (enc->pcm == NULL || enc->core_out == NULL) {
+            ESP_LOGE(TAG, "No memory for encoder buffers");
+            ret = ESP_AUDIO_ERR_MEM_LACK;
+        }
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        esp_aac_mc_enc_close(enc);
+        return ret;
+    }
+    // AudioSpecificConfig: AAC-LC object type, sample rate index, channel configuration
+    enc->asc[0] = (uint8_t)((2 << 3) | (enc->sr_idx >> 1));
+    enc->asc[1] = (uint8_t)(((enc->sr_idx & 1) << 7) | (enc->ch_config << 3));
+    *enc_hd = enc;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_set_bitrate(void *enc_hd, int bitrate)
+{
+    if (enc_hd == NULL || bitrate < 0) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+    int elem_bitrate[AAC_MC_MAX_ELEMENTS];
+    split_bitrate(get_layout(enc->cfg.channel), enc->sr_idx, bitrate, elem_bitrate);
+    for (int e = 0; e < enc->elem_num; e++) {
+        aac_mc_elem_t *elem = &enc->elem[e];
+        int old_bitrate = elem->bitrate;
+        elem->bitrate = elem_bitrate[e];
+        esp_audio_err_t ret = esp_aac_enc_set_bitrate(elem->core, get_core_bitrate(elem));
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to set bitrate %d for element %d", elem_bitrate[e], e);
+            elem->bitrate = old_bitrate;
+            return ret;
+        }
+    }
+    enc->cfg.bitrate = bitrate;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size)
+{
+    if (enc_hd == NULL || in_size == NULL || out_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+    *in_size = AAC_MC_FRAME_SAMPLES * enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    *out_size = enc->out_frame_size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                       esp_audio_enc_out_frame_t *out_frame)
+{
+    if (enc_hd == NULL || in_frame == NULL || out_frame == NULL || in_frame->buffer == NULL || out_frame->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+    int in_size = AAC_MC_FRAME_SAMPLES * enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    int frames = in_frame->len / in_size;
+    if (frames == 0) {
+        ESP_LOGE(TAG, "Input data %d not enough for one frame %d", (int)in_frame->len, in_size);
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    if (out_frame->len < (uint32_t)(frames * enc->out_frame_size)) {
+        ESP_LOGE(TAG, "Output buffer %d not enough, need %d", (int)out_frame->len, frames * enc->out_frame_size);
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    out_frame->pts = enc->samples * 1000 / enc->cfg.sample_rate;
+    int out_pos = 0;
+    for (int i = 0; i < frames; i++) {
+        int out_len = 0;
+        if (encode_frame(enc, in_frame->buffer + i * in_size, out_frame->buffer + out_pos, &out_len) != 0) {
+            return ESP_AUDIO_ERR_FAIL;
+        }
+        out_pos += out_len;
+        enc->samples += AAC_MC_FRAME_SAMPLES;
+    }
+    out_frame->encoded_bytes = out_pos;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info)
+{
+    if (enc_hd == NULL || enc_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+    enc_info->sample_rate = enc->cfg.sample_rate;
+    enc_info->channel = enc->cfg.channel;
+    enc_info->bits_per_sample = enc->cfg.bits_per_sample;
+    enc_info->bitrate = 0;
+    for (int e = 0; e < enc->elem_num; e++) {
+        enc_info->bitrate += enc->elem[e].bitrate;
+    }
+    enc_info->codec_spec_info = enc->asc;
+    enc_info->spec_info_len = AAC_MC_ASC_SIZE;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_aac_mc_enc_reset(void *enc_hd)
+{
+    if (enc_hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+    for (int e = 0; e < enc->elem_num; e++) {
+        esp_audio_err_t ret = esp_aac_enc_reset(enc->elem[e].core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        enc->elem[e].lfe_lpf.z1 = 0;
+        enc->elem[e].lfe_lpf.z2 = 0;
+    }
+    enc->samples = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_aac_mc_enc_close(void *enc_hd)
+{
+    if (enc_hd) {
+        aac_mc_enc_t *enc = (aac_mc_enc_t *)enc_hd;
+        close_elements(enc);
+        if (enc->pcm) {
+            free(enc->pcm);
+        }
+        if (enc->core_out) {
+            free(enc->core_out);
+        }
+        free(enc);
+    }
+}
+
+esp_audio_err_t esp_aac_mc_enc_register(void)
+{
+    static const esp_audio_enc_ops_t aac_mc_enc_ops = {
+        .get_frame_info_by_cfg = esp_aac_mc_enc_get_frame_info_by_cfg,
+        .open = esp_aac_mc_enc_open,
+        .set_bitrate = esp_aac_mc_enc_set_bitrate,
+        .get_info = esp_aac_mc_enc_get_info,
+        .get_frame_size = esp_aac_mc_enc_get_frame_size,
+        .process = esp_aac_mc_enc_process,
+        .reset = esp_aac_mc_enc_reset,
+        .close = esp_aac_mc_enc_close,
+    };
+    return esp_audio_enc_register(ESP_AUDIO_TYPE_AAC, &aac_mc_enc_ops);
+}
@@ -0,0 +1,681 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_flac_enc.h"
+#include "esp_audio_enc_reg.h"
+#include "flac_enc_priv.h"
+#include "esp_log.h"
+
+#define TAG "FLAC_ENC"
+
+#define FLAC_ENC_MAX_CH             (8)
+#define FLAC_ENC_MIN_BLOCK_SIZE     (16)
+#define FLAC_ENC_MAX_BLOCK_SIZE     (65535)
+#define FLAC_ENC_MAX_SAMPLE_RATE    (655350)
+#define FLAC_ENC_STREAM_INFO_SIZE   (34)
+#define FLAC_ENC_SPEC_INFO_SIZE     (4 + 4 + FLAC_ENC_STREAM_INFO_SIZE)
+/* Sync code, fields, 6 bytes frame number, optional block size and sample rate, CRC-8 */
+#define FLAC_ENC_MAX_HEADER_BYTES   (16)
+#define FLAC_ENC_FOOTER_BYTES       (2)
+#define FLAC_ENC_CH_INDEPENDENT     (0)
+#define FLAC_ENC_CH_LEFT_SIDE       (8)
+#define FLAC_ENC_CH_RIGHT_SIDE      (9)
+#define FLAC_ENC_CH_MID_SIDE        (10)
+
+/**
+ * @brief  Stereo decorrelation mode
+ */
+typedef enum {
+    FLAC_ENC_STEREO_INDEPENDENT = 0, /*!< Code left and right directly */
+    FLAC_ENC_STEREO_ESTIMATE    = 1, /*!< Select channel assignment by fixed predictor estimation */
+    FLAC_ENC_STEREO_FULL        = 2, /*!< Analyze all channel candidates and keep the smallest */
+} flac_enc_stereo_t;
+
+typedef struct {
+    uint16_t          block_size;
+    uint8_t           stereo;
+    flac_enc_search_t search;
+} flac_enc_level_t;
+
+typedef struct {
+    esp_flac_enc_config_t cfg;
+    flac_enc_level_t      level;
+    int                   block_size;
+    int                   window_size;
+    int                   max_frame_bytes;
+    uint32_t              frame_num;
+    uint64_t              samples;
+    uint32_t              min_frame_seen;
+    uint32_t              max_frame_seen;
+    int32_t              *smp[FLAC_ENC_MAX_CH + 2];
+    flac_enc_work_t       work;
+    flac_enc_subframe_t   sf[FLAC_ENC_MAX_CH + 2];
+    uint8_t               spec_info[FLAC_ENC_SPEC_INFO_SIZE];
+} flac_enc_t;
+
+typedef struct {
+    uint8_t *buf;
+    uint64_t acc;
+    int      acc_bits;
+    int      pos;
+} flac_enc_bs_t;
+
+static const flac_enc_level_t flac_enc_levels[ESP_FLAC_ENC_MAX_COMPRESSION_LEVEL + 1] = {
+    {1152, FLAC_ENC_STEREO_INDEPENDENT, {0, 3, 1}},
+    {1152, FLAC_ENC_STEREO_ESTIMATE, {0, 3, 1}},
+    {1152, FLAC_ENC_STEREO_FULL, {0, 3, 1}},
+    {4096, FLAC_ENC_STEREO_INDEPENDENT, {6, 4, 1}},
+    {4096, FLAC_ENC_STEREO_ESTIMATE, {8, 4, 1}},
+    {4096, FLAC_ENC_STEREO_FULL, {8, 5, 1}},
+    {4096, FLAC_ENC_STEREO_FULL, {8, 6, 1}},
+    {4096, FLAC_ENC_STEREO_FULL, {12, 6, 3}},
+    {4096, FLAC_ENC_STEREO_FULL, {12, 6, 0}},
+};
+
+static const uint16_t flac_enc_crc16_tab[256] = {
+    0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011,
+    0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D, 0x8027, 0x0022,
+    0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072,
+    0x0050, 0x8055, 0x805F, 0x005A, 0x804B, 0x004E, 0x0044, 0x8041,
+    0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2,
+    0x00F0, 0x80F5, 0x80FF, 0x00FA, 0x80EB, 0x00EE, 0x00E4, 0x80E1,
+    0x00A0, 0x80A5, 0x80AF, 0x00AA, 0x80BB, 0x00BE, 0x00B4, 0x80B1,
+    0x8093, 0x0096, 0x009C, 0x8099, 0x0088, 0x808D, 0x8087, 0x0082,
+    0x8183, 0x0186, 0x018C, 0x8189, 0x0198, 0x819D, 0x8197, 0x0192,
+    0x01B0, 0x81B5, 0x81BF, 0x01BA, 0x81AB, 0x01AE, 0x01A4, 0x81A1,
+    0x01E0, 0x81E5, 0x81EF, 0x01EA, 0x81FB, 0x01FE, 0x01F4, 0x81F1,
+    0x81D3, 0x01D6, 0x01DC, 0x81D9, 0x01C8, 0x81CD, 0x81C7, 0x01C2,
+    0x0140, 0x8145, 0x814F, 0x014A, 0x815B, 0x015E, 0x0154, 0x8151,
+    0x8173, 0x0176, 0x017C, 0x8179, 0x0168, 0x816D, 0x8167, 0x0162,
+    0x8123, 0x0126, 0x012C, 0x8129, 0x0138, 0x813D, 0x8137, 0x0132,
+    0x0110, 0x8115, 0x811F, 0x011A, 0x810B, 0x010E, 0x0104, 0x8101,
+    0x8303, 0x0306, 0x030C, 0x8309, 0x0318, 0x831D, 0x8317, 0x0312,
+    0x0330, 0x8335, 0x833F, 0x033A, 0x832B, 0x032E, 0x0324, 0x8321,
+    0x0360, 0x8365, 0x836F, 0x036A, 0x837B, 0x037E, 0x0374, 0x8371,
+    0x8353, 0x0356, 0x035C, 0x8359, 0x0348, 0x834D, 0x8347, 0x0342,
+    0x03C0, 0x83C5, 0x83CF, 0x03CA, 0x83DB, 0x03DE, 0x03D4, 0x83D1,
+    0x83F3, 0x03F6, 0x03FC, 0x83F9, 0x03E8, 0x83ED, 0x83E7, 0x03E2,
+    0x83A3, 0x03A6, 0x03AC, 0x83A9, 0x03B8, 0x83BD, 0x83B7, 0x03B2,
+    0x0390, 0x8395, 0x839F, 0x039A, 0x838B, 0x038E, 0x0384, 0x8381,
+    0x0280, 0x8285, 0x828F, 0x028A, 0x829B, 0x029E, 0x0294, 0x8291,
+    0x82B3, 0x02B6, 0x02BC, 0x82B9, 0x02A8, 0x82AD, 0x82A7, 0x02A2,
+    0x82E3, 0x02E6, 0x02EC, 0x82E9, 0x02F8, 0x82FD, 0x82F7, 0x02F2,
+    0x02D0, 0x82D5, 0x82DF, 0x02DA, 0x82CB, 0x02CE, 0x02C4, 0x82C1,
+    0x8243, 0x0246, 0x024C, 0x8249, 0x0258, 0x825D, 0x8257, 0x0252,
+    0x0270, 0x8275, 0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261,
+    0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234, 0x8231,
+    0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202,
+};
+
+static uint8_t calc_crc8(const uint8_t *data, int len)
+{
+    uint8_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t calc_crc16(const uint8_t *data, int len)
+{
+    uint16_t crc = 0;
+    for (int i = 0; i < len; i++) {
+        crc = (uint16_t)((crc << 8) ^ flac_enc_crc16_tab[(crc >> 8) ^ data[i]]);
+    }
+    return crc;
+}
+
+static inline void bs_put(flac_enc_bs_t *bs, uint32_t val, int bits)
+{
+    if (bits == 0) {
+        return;
+    }
+    bs->acc = (bs->acc << bits) | (val & (((uint64_t)1 << bits) - 1));
+    bs->acc_bits += bits;
+    while (bs->acc_bits >= 8) {
+        bs->acc_bits -= 8;
+        bs->buf[bs->pos++] = (uint8_t)(bs->acc >> bs->acc_bits);
+    }
+}
+
+static inline void bs_put_rice(flac_enc_bs_t *bs, int32_t v, int k)
+{
+    uint32_t u = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+    uint32_t q = u >> k;
+    while (q >= 31) {
+        bs_put(bs, 0, 31);
+        q -= 31;
+    }
+    // Unary quotient with stop bit then binary remainder
+    bs_put(bs, 1, q + 1);
+    bs_put(bs, u, k);
+}
+
+static void bs_align(flac_enc_bs_t *bs)
+{
+    if (bs->acc_bits) {
+        bs_put(bs, 0, 8 - bs->acc_bits);
+    }
+}
+
+static int check_config(esp_flac_enc_config_t *cfg)
+{
+    if (cfg->sample_rate <= 0 || cfg->sample_rate > FLAC_ENC_MAX_SAMPLE_RATE) {
+        ESP_LOGE(TAG, "Not support sample rate %d", cfg->sample_rate);
+        return -1;
+    }
+    if (cfg->channel < 1 || cfg->channel > FLAC_ENC_MAX_CH) {
+        ESP_LOGE(TAG, "Not support channel %d", cfg->channel);
+        return -1;
+    }
+    if (cfg->bits_per_sample != ESP_AUDIO_BIT16 && cfg->bits_per_sample != ESP_AUDIO_BIT24) {
+        ESP_LOGE(TAG, "Not support bits per sample %d", cfg->bits_per_sample);
+        return -1;
+    }
+    if (cfg->compression_level > ESP_FLAC_ENC_MAX_COMPRESSION_LEVEL) {
+        ESP_LOGE(TAG, "Not support compression level %d", cfg->compression_level);
+        return -1;
+    }
+    if (cfg->block_size && (cfg->block_size < FLAC_ENC_MIN_BLOCK_SIZE || cfg->block_size > FLAC_ENC_MAX_BLOCK_SIZE)) {
+        ESP_LOGE(TAG, "Not support block size %d", cfg->block_size);
+        return -1;
+    }
+    return 0;
+}
+
+static int get_block_size(esp_flac_enc_config_t *cfg)
+{
+    return cfg->block_size ? cfg->block_size : flac_enc_levels[cfg->compression_level].block_size;
+}
+
+static int get_max_frame_bytes(esp_flac_enc_config_t *cfg, int block_size)
+{
+    // Every subframe falls back to verbatim at worst, side channel needs one more bit
+    uint32_t bits = (uint32_t)cfg->channel * (8 + block_size * (cfg->bits_per_sample + 1));
+    return FLAC_ENC_MAX_HEADER_BYTES + (int)((bits + 7) >> 3) + FLAC_ENC_FOOTER_BYTES;
+}
+
+static void update_spec_info(flac_enc_t *enc)
+{
+    uint8_t *p = enc->spec_info;
+    memcpy(p, "fLaC", 4);
+    // Last metadata block flag, STREAMINFO type and block length
+    p[4] = 0x80;
+    p[5] = 0;
+    p[6] = 0;
+    p[7] = FLAC_ENC_STREAM_INFO_SIZE;
+    flac_enc_bs_t bs = {
+        .buf = p + 8,
+    };
+    uint32_t min_frame = enc->frame_num ? enc->min_frame_seen : 0;
+    bs_put(&bs, enc->block_size, 16);
+    bs_put(&bs, enc->block_size, 16);
+    bs_put(&bs, min_frame, 24);
+    bs_put(&bs, enc->max_frame_seen, 24);
+    bs_put(&bs, enc->cfg.sample_rate, 20);
+    bs_put(&bs, enc->cfg.channel - 1, 3);
+    bs_put(&bs, enc->cfg.bits_per_sample - 1, 5);
+    bs_put(&bs, (uint32_t)(enc->samples >> 32), 4);
+    bs_put(&bs, (uint32_t)enc->samples, 32);
+    // MD5 signature is not calculated
+    memset(bs.buf + bs.pos, 0, 16);
+}
+
+static int get_block_size_code(int n, int *extra_bits)
+{
+    *extra_bits = 0;
+    if (n == 192) {
+        return 1;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (n == (576 << i)) {
+            return 2 + i;
+        }
+    }
+    for (int i = 0; i < 8; i++) {
+        if (n == (256 << i)) {
+            return 8 + i;
+        }
+    }
+    *extra_bits = (n <= 256) ? 8 : 16;
+    return (n <= 256) ? 6 : 7;
+}
+
+static int get_sample_rate_code(int sample_rate, int *extra_bits, int *extra_val)
+{
+    static const int rates[] = {
+        0, 88200, 176400, 192000, 8000, 16000, 22050, 24000, 32000, 44100, 48000, 96000,
+    };
+    *extra_bits = 0;
+    for (int i = 1; i < (int)(sizeof(rates) / sizeof(rates[0])); i++) {
+        if (sample_rate == rates[i]) {
+            return i;
+        }
+    }
+    if (sample_rate % 1000 == 0 && sample_rate / 1000 <= 255) {
+        *extra_bits = 8;
+        *extra_val = sample_rate / 1000;
+        return 12;
+    }
+    if (sample_rate <= 65535) {
+        *extra_bits = 16;
+        *extra_val = sample_rate;
+        return 13;
+    }
+    if (sample_rate % 10 == 0) {
+        *extra_bits = 16;
+        *extra_val = sample_rate / 10;
+        return 14;
+    }
+    // Get from STREAMINFO
+    return 0;
+}
+
+static void write_utf8(flac_enc_bs_t *bs, uint32_t v)
+{
+    if (v < 0x80) {
+        bs_put(bs, v, 8);
+        return;
+    }
+    int bytes = 2;
+    while (bytes < 6 && v >= (1u << (5 * bytes + 1))) {
+        bytes++;
+    }
+    // Leading byte holds `bytes` ones, a zero and the top bits of value
+    bs_put(bs, (1u << (bytes + 1)) - 2, bytes + 1);
+    bs_put(bs, v >> (6 * (bytes - 1)), 7 - bytes);
+    for (int i = bytes - 2; i >= 0; i--) {
+        bs_put(bs, 0x80 | ((v >> (6 * i)) & 0x3F), 8);
+    }
+}
+
+static void write_frame_header(flac_enc_t *enc, flac_enc_bs_t *bs, int n, int ch_assign)
+{
+    int bs_bits, sr_bits, sr_val = 0;
+    int bs_code = get_block_size_code(n, &bs_bits);
+    int sr_code = get_sample_rate_code(enc->cfg.sample_rate, &sr_bits, &sr_val);
+    // Sync code with fixed block size strategy
+    bs_put(bs, 0xFFF8, 16);
+    bs_put(bs, bs_code, 4);
+    bs_put(bs, sr_code, 4);
+    bs_put(bs, ch_assign, 4);
+    bs_put(bs, enc->cfg.bits_per_sample == ESP_AUDIO_BIT24 ? 6 : 4, 3);
+    bs_put(bs, 0, 1);
+    write_utf8(bs, enc->frame_num);
+    bs_put(bs, n - 1, bs_bits);
+    bs_put(bs, sr_val, sr_bits);
+    bs_put(bs, calc_crc8(bs->buf, bs->pos), 8);
+}
+
+static void write_subframe(flac_enc_bs_t *bs, const flac_enc_subframe_t *sf, int n, int32_t *residual)
+{
+    const int32_t *x = sf->samples;
+    bs_put(bs, 0, 1);
+    switch (sf->type) {
+        case FLAC_ENC_SUBFRAME_CONSTANT:
+            bs_put(bs, 0, 6);
+            break;
+        case FLAC_ENC_SUBFRAME_VERBATIM:
+            bs_put(bs, 1, 6);
+            break;
+        case FLAC_ENC_SUBFRAME_FIXED:
+            bs_put(bs, 8 | sf->order, 6);
+            break;
+        default:
+            bs_put(bs, 32 | (sf->order - 1), 6);
+            break;
+    }
+    if (sf->wasted) {
+        // Flag followed by unary coded wasted bits minus one
+        bs_put(bs, 1, 1);
+        bs_put(bs, 1, sf->wasted);
+    } else {
+        bs_put(bs, 0, 1);
+    }
+    if (sf->type == FLAC_ENC_SUBFRAME_CONSTANT) {
+        bs_put(bs, (uint32_t)x[0], sf->bps);
+        return;
+    }
+    if (sf->type == FLAC_ENC_SUBFRAME_VERBATIM) {
+        for (int i = 0; i < n; i++) {
+            bs_put(bs, (uint32_t)x[i], sf->bps);
+        }
+        return;
+    }
+    for (int i = 0; i < sf->order; i++) {
+        bs_put(bs, (uint32_t)x[i], sf->bps);
+    }
+    if (sf->type == FLAC_ENC_SUBFRAME_LPC) {
+        bs_put(bs, sf->precision - 1, 4);
+        bs_put(bs, (uint32_t)sf->shift, 5);
+        for (int i = 0; i < sf->order; i++) {
+            bs_put(bs, (uint32_t)sf->coef[i], sf->precision);
+        }
+    }
+    flac_enc_calc_residual(sf, n, residual);
+    bs_put(bs, sf->rice_5bit, 2);
+    bs_put(bs, sf->part_order, 4);
+    int param_bits = sf->rice_5bit ? 5 : 4;
+    int parts = 1 << sf->part_order;
+    int size = n >> sf->part_order;
+    for (int p = 0; p < parts; p++) {
+        int k = sf->rice_param[p];
+        int end = (p + 1) * size;
+        bs_put(bs, k, param_bits);
+        for (int i = p ? p * size : sf->order; i < end; i++) {
+            bs_put_rice(bs, residual[i], k);
+        }
+    }
+}
+
+static void load_samples(flac_enc_t *enc, const uint8_t *pcm, int n)
+{
+    int nch = enc->cfg.channel;
+    if (enc->cfg.bits_per_sample == ESP_AUDIO_BIT16) {
+        const int16_t *src = (const int16_t *)pcm;
+        for (int ch = 0; ch < nch; ch++) {
+            int32_t *dst = enc->smp[ch];
+            for (int i = 0; i < n; i++) {
+                dst[i] = src[i * nch + ch];
+            }
+        }
+    } else {
+        for (int ch = 0; ch < nch; ch++) {
+            int32_t *dst = enc->smp[ch];
+            const uint8_t *src = pcm + ch * 3;
+            for (int i = 0; i < n; i++, src += nch * 3) {
+                dst[i] = src[0] | (src[1] << 8) | ((int8_t)src[2] * 65536);
+            }
+        }
+    }
+}
+
+static int select_stereo(flac_enc_t *enc, int n, int bps, flac_enc_subframe_t **out)
+{
+    int32_t *l = enc->smp[0];
+    int32_t *r = enc->smp[1];
+    int32_t *m = enc->smp[2];
+    int32_t *s = enc->smp[3];
+    // Derive mid and side before analysis, left and right may be shifted in place for wasted bits
+    for (int i = 0; i < n; i++) {
+        m[i] = (l[i] + r[i]) >> 1;
+        s[i] = l[i] - r[i];
+    }
+    flac_enc_search_t *search = &enc->level.search;
+    flac_enc_subframe_t *sf = enc->sf;
+    // Candidate pairs: left/right, left/side, right/side, mid/side
+    static const uint8_t pairs[4][2] = {{0, 1}, {0, 3}, {3, 1}, {2, 3}};
+    static const uint8_t assign[4] = {FLAC_ENC_CH_INDEPENDENT + 1, FLAC_ENC_CH_LEFT_SIDE, FLAC_ENC_CH_RIGHT_SIDE, FLAC_ENC_CH_MID_SIDE};
+    int best = 0;
+    if (enc->level.stereo == FLAC_ENC_STEREO_ESTIMATE) {
+        uint64_t cost[4];
+        for (int c = 0; c < 4; c++) {
+            cost[c] = flac_enc_estimate_cost(enc->smp[c], n);
+        }
+        uint64_t best_cost = UINT64_MAX;
+        for (int i = 0; i < 4; i++) {
+            uint64_t c = cost[pairs[i][0]] + cost[pairs[i][1]];
+            if (c < best_cost) {
+                best_cost = c;
+                best = i;
+            }
+        }
+        for (int i = 0; i < 2; i++) {
+            int c = pairs[best][i];
+            flac_enc_analyze(search, enc->smp[c], n, c == 3 ? bps + 1 : bps, &enc->work, &sf[c]);
+        }
+    } else {
+        for (int c = 0; c < 4; c++) {
+            flac_enc_analyze(search, enc->smp[c], n, c == 3 ? bps + 1 : bps, &enc->work, &sf[c]);
+        }
+        uint32_t best_bits = UINT32_MAX;
+        for (int i = 0; i < 4; i++) {
+            uint32_t bits = sf[pairs[i][0]].bits + sf[pairs[i][1]].bits;
+            if (bits < best_bits) {
+                best_bits = bits;
+                best = i;
+            }
+        }
+    }
+    out[0] = &sf[pairs[best][0]];
+    out[1] = &sf[pairs[best][1]];
+    return assign[best];
+}
+
+static int encode_frame(flac_enc_t *enc, const uint8_t *pcm, int n, uint8_t *out)
+{
+    int nch = enc->cfg.channel;
+    int bps = enc->cfg.bits_per_sample;
+    if (enc->level.search.max_lpc_order && n != enc->window_size) {
+        flac_enc_init_window(enc->work.window, n);
+        enc->window_size = n;
+    }
+    load_samples(enc, pcm, n);
+    flac_enc_subframe_t *sf[FLAC_ENC_MAX_CH];
+    int ch_assign = nch - 1;
+    if (nch == 2 && enc->level.stereo != FLAC_ENC_STEREO_INDEPENDENT) {
+        ch_assign = select_stereo(enc, n, bps, sf);
+    } else {
+        for (int ch = 0; ch < nch; ch++) {
+            flac_enc_analyze(&enc->level.search, enc->smp[ch], n, bps, &enc->work, &enc->sf[ch]);
+            sf[ch] = &enc->sf[ch];
+        }
+    }
+    flac_enc_bs_t bs = {
+        .buf = out,
+    };
+    write_frame_header(enc, &bs, n, ch_assign);
+    for (int ch = 0; ch < nch; ch++) {
+        write_subframe(&bs, sf[ch], n, enc->work.residual);
+    }
+    bs_align(&bs);
+    uint16_t crc = calc_crc16(out, bs.pos);
+    out[bs.pos++] = (uint8_t)(crc >> 8);
+    out[bs.pos++] = (uint8_t)crc;
+    if (enc->frame_num == 0 || (uint32_t)bs.pos < enc->min_frame_seen) {
+        enc->min_frame_seen = bs.pos;
+    }
+    if ((uint32_t)bs.pos > enc->max_frame_seen) {
+        enc->max_frame_seen = bs.pos;
+    }
+    enc->frame_num++;
+    enc->samples += n;
+    return bs.pos;
+}
+
+static void free_buffers(flac_enc_t *enc)
+{
+    for (int i = 0; i < FLAC_ENC_MAX_CH + 2; i++) {
+        if (enc->smp[i]) {
+            free(enc->smp[i]);
+        }
+    }
+    if (enc->work.window) {
+        free(enc->work.window);
+    }
+    if (enc->work.windowed) {
+        free(enc->work.windowed);
+    }
+    if (enc->work.residual) {
+        free(enc->work.residual);
+    }
+}
+
+esp_audio_err_t esp_flac_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info)
+{
+    if (cfg == NULL || frame_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_flac_enc_config_t *flac_cfg = (esp_flac_enc_config_t *)cfg;
+    if (check_config(flac_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    int block_size = get_block_size(flac_cfg);
+    int sample_bytes = flac_cfg->channel * (flac_cfg->bits_per_sample >> 3);
+    frame_info->in_frame_size = block_size * sample_bytes;
+    frame_info->in_frame_align = sample_bytes;
+    frame_info->out_frame_size = get_max_frame_bytes(flac_cfg, block_size);
+    frame_info->out_frame_align = 1;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_flac_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd)
+{
+    if (cfg == NULL || enc_hd == NULL || cfg_sz != sizeof(esp_flac_enc_config_t)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *enc_hd = NULL;
+    esp_flac_enc_config_t *flac_cfg = (esp_flac_enc_config_t *)cfg;
+    if (check_config(flac_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    flac_enc_t *enc = (flac_enc_t *)calloc(1, sizeof(flac_enc_t));
+    if (enc == NULL) {
+        ESP_LOGE(TAG, "No memory for encoder");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    enc->cfg = *flac_cfg;
+    enc->level = flac_enc_levels[flac_cfg->compression_level];
+    enc->block_size = get_block_size(flac_cfg);
+    enc->max_frame_bytes = get_max_frame_bytes(flac_cfg, enc->block_size);
+    // Stereo decorrelation needs extra mid and side channel
+    int buf_num = flac_cfg->channel + (flac_cfg->channel == 2 ? 2 : 0);
+    size_t buf_size = enc->block_size * sizeof(int32_t);
+    bool mem_lack = false;
+    for (int i = 0; i < buf_num; i++) {
+        enc->smp[i] = (int32_t *)malloc(buf_size);
+        mem_lack |= (enc->smp[i] == NULL);
+    }
+    enc->work.residual = (int32_t *)malloc(buf_size);
+    mem_lack |= (enc->work.residual == NULL);
+    if (enc->level.search.max_lpc_order) {
+        enc->work.window = (float *)malloc(enc->block_size * sizeof(float));
+        enc->work.windowed = (float *)malloc(enc->block_size * sizeof(float));
+        mem_lack |= (enc->work.window == NULL || enc->work.windowed == NULL);
+    }
+    if (mem_lack) {
+        ESP_LOGE(TAG, "No memory for encoder buffers");
+        free_buffers(enc);
+        free(enc);
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    enc->work.block_size = enc->block_size;
+    update_spec_info(enc);
+    *enc_hd = enc;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_flac_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size)
+{
+    if (enc_hd == NULL || in_size == NULL || out_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    flac_enc_t *enc = (flac_enc_t *)enc_hd;
+    *in_size = enc->block_size * enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    *out_size = enc->max_frame_bytes;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_flac_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                     esp_audio_enc_out_frame_t *out_frame)
+{
+    if (enc_hd == NULL || in_frame == NULL || out_frame == NULL || in_frame->buffer == NULL || out_frame->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    flac_enc_t *enc = (flac_enc_t *)enc_hd;
+    int sample_bytes = enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    int in_size = enc->block_size * sample_bytes;
+    int frames = in_frame->len / in_size;
+    int last_samples = 0;
+    if (frames == 0) {
+        // Encode remaining data as the last short frame
+        last_samples = in_frame->len / sample_bytes;
+        if (last_samples == 0) {
+            ESP_LOGE(TAG, "Input data %d not enough for one frame %d", (int)in_frame->len, in_size);
+            return ESP_AUDIO_ERR_DATA_LACK;
+        }
+    }
+    int need = frames ? frames * enc->max_frame_bytes : enc->max_frame_bytes;
+    if (out_frame->len < (uint32_t)need) {
+        ESP_LOGE(TAG, "Output buffer %d not enough, need %d", (int)out_frame->len, need);
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    out_frame->pts = enc->samples * 1000 / enc->cfg.sample_rate;
+    int out_pos = 0;
+    if (last_samples) {
+        out_pos = encode_frame(enc, in_frame->buffer, last_samples, out_frame->buffer);
+    }
+    for (int i = 0; i < frames; i++) {
+        out_pos += encode_frame(enc, in_frame->buffer + i * in_size, enc->block_size, out_frame->buffer + out_pos);
+    }
+    out_frame->encoded_bytes = out_pos;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_flac_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info)
+{
+    if (enc_hd == NULL || enc_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    flac_enc_t *enc = (flac_enc_t *)enc_hd;
+    update_spec_info(enc);
+    enc_info->sample_rate = enc->cfg.sample_rate;
+    enc_info->channel = enc->cfg.channel;
+    enc_info->bits_per_sample = enc->cfg.bits_per_sample;
+    // Lossless coding has no target bitrate, report the PCM bitrate as upper bound
+    enc_info->bitrate = enc->cfg.sample_rate * enc->cfg.channel * enc->cfg.bits_per_sample;
+    enc_info->codec_spec_info = enc->spec_info;
+    enc_info->spec_info_len = FLAC_ENC_SPEC_INFO_SIZE;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_flac_enc_reset(void *enc_hd)
+{
+    if (enc_hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    flac_enc_t *enc = (flac_enc_t *)enc_hd;
+    enc->frame_num = 0;
+    enc->samples = 0;
+    enc->min_frame_seen = 0;
+    enc->max_frame_seen = 0;
+    update_spec_info(enc);
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_flac_enc_close(void *enc_hd)
+{
+    if (enc_hd) {
+        free_buffers((flac_enc_t *)enc_hd);
+        free(enc_hd);
+    }
+}
+
+esp_audio_err_t esp_flac_enc_register(void)
+{
+    static const esp_audio_enc_ops_t flac_enc_ops = {
+        .get_frame_info_by_cfg = esp_flac_enc_get_frame_info_by_cfg,
+        .open = esp_flac_enc_open,
+        .get_info = esp_flac_enc_get_info,
+        .get_frame_size = esp_flac_enc_get_frame_size,
+        .process = esp_flac_enc_process,
+        .reset = esp_flac_enc_reset,
+        .close = esp_flac_enc_close,
+    };
+    return esp_audio_enc_register(ESP_AUDIO_TYPE_FLAC, &flac_enc_ops);
+}
@@ -0,0 +1,327 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_lc3_batch_enc.h"
+#include "esp_lc3_enc.h"
+#include "esp_log.h"
+
+#define TAG "LC3_BATCH_ENC"
+
+#define LC3_NBYTE_MIN (20)
+#define LC3_NBYTE_MAX (400)
+
+typedef struct {
+    esp_lc3_batch_enc_config_t cfg;
+    void                      *core[ESP_LC3_BATCH_ENC_MAX_BIS];
+    int                        out_size[ESP_LC3_BATCH_ENC_MAX_BIS];
+    int                        in_size;
+    int                        frame_samples;
+    uint8_t                   *pcm;
+    uint64_t                   samples;
+} lc3_batch_enc_t;
+
+static bool nbyte_valid(uint16_t nbyte)
+{
+    return nbyte >= LC3_NBYTE_MIN && nbyte <= LC3_NBYTE_MAX;
+}
+
+static int nbyte_to_bitrate(esp_lc3_batch_enc_config_t *cfg, uint16_t nbyte)
+{
+    // Round up so that encoder converts bitrate back to the same nbyte
+    int unit = cfg->sample_rate == 44100 ? 73500 : 80000;
+    return (nbyte * unit + cfg->frame_dms - 1) / cfg->frame_dms;
+}
+
+static void close_cores(lc3_batch_enc_t *enc)
+{
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        if (enc->core[i]) {
+            esp_lc3_enc_close(enc->core[i]);
+            enc->core[i] = NULL;
+        }
+    }
+}
+
+esp_audio_err_t esp_lc3_batch_enc_open(esp_lc3_batch_enc_config_t *cfg, esp_lc3_batch_enc_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->bis_num == 0 || cfg->bis_num > ESP_LC3_BATCH_ENC_MAX_BIS) {
+        ESP_LOGE(TAG, "Not support BIS number %d", cfg->bis_num);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    for (int i = 0; i < cfg->bis_num; i++) {
+        if (nbyte_valid(cfg->nbyte[i]) == false) {
+            ESP_LOGE(TAG, "Not support nbyte %d for BIS %d", cfg->nbyte[i], i);
+            return ESP_AUDIO_ERR_INVALID_PARAMETER;
+        }
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)calloc(1, sizeof(lc3_batch_enc_t));
+    if (enc == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    enc->cfg = *cfg;
+    esp_audio_err_t ret = ESP_AUDIO_ERR_OK;
+    for (int i = 0; i < cfg->bis_num; i++) {
+        esp_lc3_enc_config_t core_cfg = {
+            .sample_rate = cfg->sample_rate,
+            .bits_per_sample = cfg->bits_per_sample,
+            .channel = 1,
+            .frame_dms = cfg->frame_dms,
+            .nbyte = cfg->nbyte[i],
+            .len_prefixed = cfg->len_prefixed,
+        };
+        ret = esp_lc3_enc_open(&core_cfg, sizeof(esp_lc3_enc_config_t), &enc->core[i]);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to open encoder for BIS %d ret %d", i, ret);
+            break;
+        }
+        int in_size = 0;
+        esp_lc3_enc_get_frame_size(enc->core[i], &in_size, &enc->out_size[i]);
+        enc->in_size = in_size;
+    }
+    if (ret == ESP_AUDIO_ERR_OK) {
+        // De-interleave scratch, one frame of one BIS is encoded at a time
+        enc->pcm = (uint8_t *)malloc(enc->in_size);
+        if (enc->pcm == NULL) {
+            ESP_LOGE(TAG, "No memory for PCM buffer");
+            ret = ESP_AUDIO_ERR_MEM_LACK;
+        }
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        esp_lc3_batch_enc_close(enc);
+        return ret;
+    }
+    enc->frame_samples = enc->in_size / (cfg->bits_per_sample >> 3);
+    *handle = enc;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_lc3_batch_enc_get_frame_size(esp_lc3_batch_enc_handle_t handle, int *in_size, int *out_size)
+{
+    if (handle == NULL || in_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    *in_size = enc->in_size;
+    if (out_size) {
+        memcpy(out_size, enc->out_size, enc->cfg.bis_num * sizeof(int));
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_lc3_batch_enc_set_nbyte(esp_lc3_batch_enc_handle_t handle, uint8_t bis, uint16_t nbyte)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    if (bis >= enc->cfg.bis_num || nbyte_valid(nbyte) == false) {
+        ESP_LOGE(TAG, "Invalid BIS %d or nbyte %d", bis, nbyte);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_audio_err_t ret = esp_lc3_enc_set_bitrate(enc->core[bis], nbyte_to_bitrate(&enc->cfg, nbyte));
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    enc->cfg.nbyte[bis] = nbyte;
+    int in_size = 0;
+    esp_lc3_enc_get_frame_size(enc->core[bis], &in_size, &enc->out_size[bis]);
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t check_out_size(lc3_batch_enc_t *enc, esp_audio_enc_out_frame_t *out, int frames)
+{
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        if (out[i].buffer == NULL) {
+            ESP_LOGE(TAG, "Invalid output for BIS %d", i);
+            return ESP_AUDIO_ERR_INVALID_PARAMETER;
+        }
+        if (out[i].len < (uint32_t)(frames * enc->out_size[i])) {
+            ESP_LOGE(TAG, "Output buffer %d too small for BIS %d", (int)out[i].len, i);
+            return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+        }
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+static void update_pts(lc3_batch_enc_t *enc, esp_audio_enc_out_frame_t *out, int frames)
+{
+    uint64_t pts = enc->samples * 1000 / enc->cfg.sample_rate;
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        out[i].pts = pts;
+    }
+    enc->samples += (uint64_t)frames * enc->frame_samples;
+}
+
+esp_audio_err_t esp_lc3_batch_enc_process(esp_lc3_batch_enc_handle_t handle, esp_audio_enc_in_frame_t *in,
+                                          esp_audio_enc_out_frame_t *out)
+{
+    if (handle == NULL || in == NULL || out == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    uint32_t len = in[0].len;
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        if (in[i].buffer == NULL) {
+            ESP_LOGE(TAG, "Invalid input for BIS %d", i);
+            return ESP_AUDIO_ERR_INVALID_PARAMETER;
+        }
+        if (in[i].len != len) {
+            ESP_LOGE(TAG, "Input size %d of BIS %d mismatch with %d", (int)in[i].len, i, (int)len);
+            return ESP_AUDIO_ERR_DATA_LACK;
+        }
+    }
+    if (len == 0 || len % enc->in_size) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    int frames = len / enc->in_size;
+    esp_audio_err_t ret = check_out_size(enc, out, frames);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        out[i].encoded_bytes = 0;
+        ret = esp_lc3_enc_process(enc->core[i], &in[i], &out[i]);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to encode BIS %d ret %d", i, ret);
+            return ret;
+        }
+    }
+    update_pts(enc, out, frames);
+    return ESP_AUDIO_ERR_OK;
+}
+
+static void deinterleave(uint8_t *dst, uint8_t *src, int samples, int ch_num, int ch, int sample_bytes)
+{
+    src += ch * sample_bytes;
+    int stride = ch_num * sample_bytes;
+    switch (sample_bytes) {
+        case 2: {
+            int16_t *d = (int16_t *)dst;
+            for (int i = 0; i < samples; i++) {
+                d[i] = *(int16_t *)src;
+                src += stride;
+            }
+            break;
+        }
+        case 4: {
+            int32_t *d = (int32_t *)dst;
+            for (int i = 0; i < samples; i++) {
+                d[i] = *(int32_t *)src;
+                src += stride;
+            }
+            break;
+        }
+        default:
+            for (int i = 0; i < samples; i++) {
+                memcpy(dst, src, sample_bytes);
+                dst += sample_bytes;
+                src += stride;
+            }
+            break;
+    }
+}
+
+esp_audio_err_t esp_lc3_batch_enc_process_interleaved(esp_lc3_batch_enc_handle_t handle, esp_audio_enc_in_frame_t *in,
+                                                      esp_audio_enc_out_frame_t *out)
+{
+    if (handle == NULL || in == NULL || in->buffer == NULL || out == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    int bis_num = enc->cfg.bis_num;
+    int frame_size = enc->in_size * bis_num;
+    if (in->len == 0 || in->len % frame_size) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    int frames = in->len / frame_size;
+    esp_audio_err_t ret = check_out_size(enc, out, frames);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    int sample_bytes = enc->cfg.bits_per_sample >> 3;
+    for (int i = 0; i < bis_num; i++) {
+        out[i].encoded_bytes = 0;
+    }
+    for (int f = 0; f < frames; f++) {
+        uint8_t *src = in->buffer + f * frame_size;
+        for (int i = 0; i < bis_num; i++) {
+            deinterleave(enc->pcm, src, enc->frame_samples, bis_num, i, sample_bytes);
+            esp_audio_enc_in_frame_t core_in = {
+                .buffer = enc->pcm,
+                .len = enc->in_size,
+            };
+            esp_audio_enc_out_frame_t core_out = {
+                .buffer = out[i].buffer + out[i].encoded_bytes,
+                .len = out[i].len - out[i].encoded_bytes,
+            };
+            ret = esp_lc3_enc_process(enc->core[i], &core_in, &core_out);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                ESP_LOGE(TAG, "Fail to encode BIS %d ret %d", i, ret);
+                return ret;
+            }
+            out[i].encoded_bytes += core_out.encoded_bytes;
+        }
+    }
+    update_pts(enc, out, frames);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_lc3_batch_enc_get_info(esp_lc3_batch_enc_handle_t handle, uint8_t bis, esp_audio_enc_info_t *enc_info)
+{
+    if (handle == NULL || enc_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    if (bis >= enc->cfg.bis_num) {
+        ESP_LOGE(TAG, "Invalid BIS %d", bis);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    return esp_lc3_enc_get_info(enc->core[bis], enc_info);
+}
+
+esp_audio_err_t esp_lc3_batch_enc_reset(esp_lc3_batch_enc_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    for (int i = 0; i < enc->cfg.bis_num; i++) {
+        esp_audio_err_t ret = esp_lc3_enc_reset(enc->core[i]);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+    }
+    enc->samples = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_lc3_batch_enc_close(esp_lc3_batch_enc_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    lc3_batch_enc_t *enc = (lc3_batch_enc_t *)handle;
+    close_cores(enc);
+    if (enc->pcm) {
+        free(enc->pcm);
+    }
+    free(enc);
+}
@@ -0,0 +1,833 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_mp3_enc.h"
+#include "esp_audio_enc_reg.h"
+#include "mp3_enc_priv.h"
+#include "esp_log.h"
+
+#define TAG "MP3_ENC"
+
+#define MP3_ENC_HEADER_BITS    (32)
+#define MP3_ENC_MAX_PART23     (4095)
+#define MP3_ENC_SPF_MPEG1      (1152)
+#define MP3_ENC_SPF_MPEG2      (576)
+/* Signal to mask ratio 20dB as log2 in Q8 */
+#define MP3_ENC_DEFAULT_SMR    (1701)
+/* Measured energy of full scale sine in one granule (Q32 energy, log2 in Q8), used to place absolute threshold */
+#define MP3_ENC_FULL_SCALE_LOG (8102)
+/* Assumed sound pressure level of full scale sine */
+#define MP3_ENC_FULL_SCALE_SPL (96.0)
+#define MP3_ENC_MS_RATIO_SHIFT (2)
+#define MP3_ENC_SQRT_HALF_Q31  (0x5A82799A)
+/* Seek points kept for Xing TOC, halved with doubled step when full */
+#define MP3_ENC_TOC_SLOTS      (128)
+#define MP3_ENC_XING_SIZE      (120)
+#define MP3_ENC_LAME_TAG_SIZE  (36)
+/* LAME tag CRC covers tag frame data before CRC field */
+#define MP3_ENC_LAME_CRC_BYTES (190)
+
+typedef struct {
+    esp_mp3_enc_config_t cfg;
+    bool                 lsf;
+    uint8_t              granules;
+    uint8_t              sr_idx;
+    uint8_t              br_idx;
+    uint8_t              side_bytes;
+    int                  samples_per_frame;
+    uint32_t             slot_rem;
+    uint64_t             samples;
+    int16_t              ath[MP3_ENC_SFB_NUM];
+    mp3_enc_fb_tab_t     fb_tab;
+    mp3_enc_fb_ch_t      fb[MP3_ENC_MAX_CH];
+    int32_t              xr[MP3_ENC_MAX_GR][MP3_ENC_MAX_CH][MP3_ENC_GRANULE_SIZE];
+    int16_t              ix[MP3_ENC_MAX_GR][MP3_ENC_MAX_CH][MP3_ENC_GRANULE_SIZE];
+    uint32_t             x34[MP3_ENC_MAX_CH][MP3_ENC_GRANULE_SIZE];
+    uint32_t             sqrt_sum[MP3_ENC_SFB_NUM];
+    mp3_enc_gr_ctx_t     gr_ctx[MP3_ENC_MAX_CH];
+    mp3_enc_gr_info_t    gi[MP3_ENC_MAX_GR][MP3_ENC_MAX_CH];
+    int                  pe[MP3_ENC_MAX_CH];
+    bool                 ms_stereo;
+    uint32_t             frames;
+    uint32_t             bytes;
+    uint16_t             music_crc;
+    uint16_t             toc_num;
+    uint32_t             toc_step;
+    uint32_t             toc_pos[MP3_ENC_TOC_SLOTS];
+} mp3_enc_t;
+
+typedef struct {
+    uint8_t *buf;
+    uint64_t acc;
+    int      acc_bits;
+    int      pos;
+} mp3_enc_bs_t;
+
+static const int mp3_sample_rates[2][3] = {
+    {44100, 48000, 32000},
+    {22050, 24000, 16000},
+};
+
+static uint16_t crc16_update(uint16_t crc, const uint8_t *data, int size)
+{
+    // CRC-16 with reflected polynomial 0x8005 as used by LAME tag
+    for (int i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : (crc >> 1);
+        }
+    }
+    return crc;
+}
+
+static inline void bs_put(mp3_enc_bs_t *bs, uint32_t val, int bits)
+{
+    if (bits == 0) {
+        return;
+    }
+    bs->acc = (bs->acc << bits) | (val & ((1u << bits) - 1));
+    bs->acc_bits += bits;
+    while (bs->acc_bits >= 8) {
+        bs->acc_bits -= 8;
+        bs->buf[bs->pos++] = (uint8_t)(bs->acc >> bs->acc_bits);
+    }
+}
+
+static int get_bitrate_index(bool lsf, int bitrate)
+{
+    const uint16_t *tab = mp3_enc_bitrate_tab[lsf];
+    int kbps = bitrate / 1000;
+    if (kbps < tab[1]) {
+        return -1;
+    }
+    int idx = 14;
+    while (tab[idx] > kbps) {
+        idx--;
+    }
+    return idx;
+}
+
+static int get_sample_rate_index(int sample_rate, bool *lsf)
+{
+    for (int v = 0; v < 2; v++) {
+        for (int i = 0; i < 3; i++) {
+            if (mp3_sample_rates[v][i] == sample_rate) {
+                *lsf = (v == 1);
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+static int check_config(esp_mp3_enc_config_t *cfg, bool *lsf, int *sr_idx, int *br_idx)
+{
+    if (cfg->channel != ESP_AUDIO_MONO && cfg->channel != ESP_AUDIO_DUAL) {
+        ESP_LOGE(TAG, "Not support channel %d", cfg->channel);
+        return -1;
+    }
+    if (cfg->bits_per_sample != ESP_AUDIO_BIT16) {
+        ESP_LOGE(TAG, "Not support bits per sample %d", cfg->bits_per_sample);
+        return -1;
+    }
+    *sr_idx = get_sample_rate_index(cfg->sample_rate, lsf);
+    if (*sr_idx < 0) {
+        ESP_LOGE(TAG, "Not support sample rate %d", cfg->sample_rate);
+        return -1;
+    }
+    if (cfg->rc_mode != ESP_MP3_ENC_RC_MODE_CBR && cfg->rc_mode != ESP_MP3_ENC_RC_MODE_VBR) {
+        ESP_LOGE(TAG, "Not support rate control mode %d", cfg->rc_mode);
+        return -1;
+    }
+    if (cfg->psy_mode != ESP_MP3_ENC_PSY_MODE_NORMAL && cfg->psy_mode != ESP_MP3_ENC_PSY_MODE_FAST) {
+        ESP_LOGE(TAG, "Not support psychoacoustic mode %d", cfg->psy_mode);
+        return -1;
+    }
+    if (cfg->rc_mode == ESP_MP3_ENC_RC_MODE_VBR && (cfg->vbr_quality < 0 || cfg->vbr_quality > 9)) {
+        ESP_LOGE(TAG, "Not support vbr quality %d", cfg->vbr_quality);
+        return -1;
+    }
+    if (cfg->rc_mode == ESP_MP3_ENC_RC_MODE_VBR && cfg->bitrate == 0) {
+        *br_idx = 14;
+        return 0;
+    }
+    *br_idx = get_bitrate_index(*lsf, cfg->bitrate);
+    if (*br_idx < 0) {
+        ESP_LOGE(TAG, "Not support bitrate %d", cfg->bitrate);
+        return -1;
+    }
+    return 0;
+}
+
+static inline int get_frame_bytes(bool lsf, int br_idx, int sample_rate)
+{
+    return (lsf ? 72 : 144) * mp3_enc_bitrate_tab[lsf][br_idx] * 1000 / sample_rate;
+}
+
+static void calc_ath(mp3_enc_t *enc)
+{
+    const uint16_t *sfb = enc->gr_ctx[0].sfb;
+    double line_hz = (double)enc->cfg.sample_rate / (2 * MP3_ENC_GRANULE_SIZE);
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        double min_db = 200;
+        for (int i = sfb[b]; i < sfb[b + 1]; i++) {
+            double f = (i + 0.5) * line_hz / 1000;
+            if (f < 0.02) {
+                f = 0.02;
+            }
+            // Terhardt absolute threshold of hearing in dB SPL
+            double db = 3.64 * pow(f, -0.8) - 6.5 * exp(-0.6 * (f - 3.3) * (f - 3.3)) + 0.001 * pow(f, 4);
+            if (db < min_db) {
+                min_db = db;
+            }
+        }
+        // Threshold applies to each line, so band threshold grows with band width
+        double log2_e = (min_db - MP3_ENC_FULL_SCALE_SPL) * 0.33219281 + log2(sfb[b + 1] - sfb[b]);
+        enc->ath[b] = (int16_t)(MP3_ENC_FULL_SCALE_LOG + (int)lrint(log2_e * 256));
+    }
+}
+
+static void ms_stereo_decide(mp3_enc_t *enc)
+{
+    uint64_t em = 0, es = 0;
+    for (int gr = 0; gr < enc->granules; gr++) {
+        int32_t *l = enc->xr[gr][0];
+        int32_t *r = enc->xr[gr][1];
+        for (int i = 0; i < MP3_ENC_GRANULE_SIZE; i++) {
+            int32_t m = (l[i] >> 9) + (r[i] >> 9);
+            int32_t s = (l[i] >> 9) - (r[i] >> 9);
+            em += (int64_t)m * m;
+            es += (int64_t)s * s;
+        }
+    }
+    uint64_t lo = em < es ? em : es;
+    uint64_t hi = em < es ? es : em;
+    // Use mid/side when one of them is at least 6dB weaker
+    enc->ms_stereo = (lo << MP3_ENC_MS_RATIO_SHIFT) < hi;
+    if (enc->ms_stereo == false) {
+        return;
+    }
+    for (int gr = 0; gr < enc->granules; gr++) {
+        int32_t *l = enc->xr[gr][0];
+        int32_t *r = enc->xr[gr][1];
+        for (int i = 0; i < MP3_ENC_GRANULE_SIZE; i++) {
+            int64_t m = (int64_t)l[i] + r[i];
+            int64_t s = (int64_t)l[i] - r[i];
+            l[i] = (int32_t)((m * MP3_ENC_SQRT_HALF_Q31) >> 31);
+            r[i] = (int32_t)((s * MP3_ENC_SQRT_HALF_Q31) >> 31);
+        }
+    }
+}
+
+static void prepare_granule(mp3_enc_t *enc, int gr, bool need_psy)
+{
+    for (int ch = 0; ch < enc->cfg.channel; ch++) {
+        mp3_enc_gr_ctx_t *ctx = &enc->gr_ctx[ch];
+        mp3_enc_pow34(enc->xr[gr][ch], ctx->sfb, enc->x34[ch], need_psy ? enc->sqrt_sum : NULL);
+        if (need_psy) {
+            bool normal = (enc->cfg.psy_mode == ESP_MP3_ENC_PSY_MODE_NORMAL);
+            enc->pe[ch] = mp3_enc_psy_calc(enc->xr[gr][ch], enc->sqrt_sum, enc->ath, MP3_ENC_DEFAULT_SMR, normal, ctx);
+        } else {
+            // Plain global gain search: every band is coded with the same step
+            memset(ctx->g_req, 0, sizeof(ctx->g_req));
+            for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+                ctx->margin[b] = INT16_MAX;
+            }
+            enc->pe[ch] = 1;
+        }
+    }
+}
+
+static int code_frame_cbr(mp3_enc_t *enc, int main_bits)
+{
+    bool need_psy = (enc->cfg.psy_mode == ESP_MP3_ENC_PSY_MODE_NORMAL);
+    int used = 0;
+    for (int gr = 0; gr < enc->granules; gr++) {
+        prepare_granule(enc, gr, need_psy);
+        int gr_bits = (main_bits - used) / (enc->granules - gr);
+        int gr_used = 0;
+        int pe_sum = 0;
+        for (int ch = 0; ch < enc->cfg.channel; ch++) {
+            pe_sum += enc->pe[ch] + 1;
+        }
+        for (int ch = 0; ch < enc->cfg.channel; ch++) {
+            int budget = gr_bits - gr_used;
+            if (ch + 1 < enc->cfg.channel) {
+                // Split granule bits among channels according to perceptual entropy
+                int share = (int)((int64_t)gr_bits * (enc->pe[ch] + 1) / pe_sum);
+                int min_share = gr_bits / (4 * enc->cfg.channel);
+                budget = share < min_share ? min_share : share;
+            }
+            if (budget > MP3_ENC_MAX_PART23) {
+                budget = MP3_ENC_MAX_PART23;
+            }
+            gr_used += mp3_enc_code_granule(&enc->gr_ctx[ch], enc->xr[gr][ch], enc->x34[ch], budget, 0, true,
+                                            &enc->gi[gr][ch], enc->ix[gr][ch]);
+        }
+        used += gr_used;
+    }
+    return used;
+}
+
+static int code_frame_vbr(mp3_enc_t *enc)
+{
+    int offset = 2 * (enc->cfg.vbr_quality - 4);
+    int used = 0;
+    for (int gr = 0; gr < enc->granules; gr++) {
+        prepare_granule(enc, gr, true);
+        for (int ch = 0; ch < enc->cfg.channel; ch++) {
+            used += mp3_enc_code_granule(&enc->gr_ctx[ch], enc->xr[gr][ch], enc->x34[ch], MP3_ENC_MAX_PART23,
+                                         offset, false, &enc->gi[gr][ch], enc->ix[gr][ch]);
+        }
+    }
+    return used;
+}
+
+static void write_header(mp3_enc_t *enc, mp3_enc_bs_t *bs, int br_idx, int padding)
+{
+    int mode = 3;
+    int mode_ext = 0;
+    if (enc->cfg.channel == ESP_AUDIO_DUAL) {
+        if (enc->cfg.psy_mode == ESP_MP3_ENC_PSY_MODE_NORMAL) {
+            mode = 1;
+            mode_ext = enc->ms_stereo ? 2 : 0;
+        } else {
+            mode = 0;
+        }
+    }
+    bs_put(bs, 0x7FF, 11);
+    bs_put(bs, enc->lsf ? 2 : 3, 2);
+    bs_put(bs, 1, 2);
+    bs_put(bs, 1, 1);
+    bs_put(bs, br_idx, 4);
+    bs_put(bs, enc->sr_idx, 2);
+    bs_put(bs, padding, 1);
+    bs_put(bs, 0, 1);
+    bs_put(bs, mode, 2);
+    bs_put(bs, mode_ext, 2);
+    bs_put(bs, 0, 1);
+    bs_put(bs, 1, 1);
+    bs_put(bs, 0, 2);
+}
+
+static void write_side_info(mp3_enc_t *enc, mp3_enc_bs_t *bs)
+{
+    int nch = enc->cfg.channel;
+    if (enc->lsf) {
+        bs_put(bs, 0, 8);
+        bs_put(bs, 0, nch == 1 ? 1 : 2);
+    } else {
+        bs_put(bs, 0, 9);
+        bs_put(bs, 0, nch == 1 ? 5 : 3);
+        bs_put(bs, 0, 4 * nch);
+    }
+    for (int gr = 0; gr < enc->granules; gr++) {
+        for (int ch = 0; ch < nch; ch++) {
+            mp3_enc_gr_info_t *gi = &enc->gi[gr][ch];
+            bs_put(bs, gi->part2_3_length, 12);
+            bs_put(bs, gi->big_values, 9);
+            bs_put(bs, gi->global_gain, 8);
+            bs_put(bs, gi->scalefac_compress, enc->lsf ? 9 : 4);
+            bs_put(bs, 0, 1);
+            for (int r = 0; r < 3; r++) {
+                bs_put(bs, gi->table_select[r], 5);
+            }
+            bs_put(bs, gi->region0_count, 4);
+            bs_put(bs, gi->region1_count, 3);
+            if (enc->lsf == false) {
+                bs_put(bs, 0, 1);
+            }
+            bs_put(bs, 0, 1);
+            bs_put(bs, gi->count1table_select, 1);
+        }
+    }
+}
+
+static void write_scalefac(mp3_enc_t *enc, mp3_enc_bs_t *bs, mp3_enc_gr_info_t *gi)
+{
+    static const uint8_t lsf_part_end[4] = {6, 11, 16, 21};
+    if (enc->lsf == false) {
+        for (int b = 0; b < MP3_ENC_SFB_NUM - 1; b++) {
+            bs_put(bs, gi->scalefac[b], b < 11 ? gi->slen[0] : gi->slen[1]);
+        }
+        return;
+    }
+    int b = 0;
+    for (int p = 0; p < 4; p++) {
+        for (; b < lsf_part_end[p]; b++) {
+            bs_put(bs, gi->scalefac[b], gi->slen[p]);
+        }
+    }
+}
+
+static void write_big_values(mp3_enc_bs_t *bs, const int16_t *ix, int start, int end, int table)
+{
+    if (table == 0) {
+        return;
+    }
+    const mp3_enc_huff_tab_t *tab = &mp3_enc_huff_tab[table];
+    int linbits = tab->linbits;
+    for (int i = start; i < end; i += 2) {
+        int x = ix[i];
+        int y = ix[i + 1];
+        int ax = abs(x);
+        int ay = abs(y);
+        if (linbits) {
+            int idx = (ax > 14 ? 15 : ax) * 16 + (ay > 14 ? 15 : ay);
+            bs_put(bs, tab->code[idx], tab->len[idx]);
+            if (ax > 14) {
+                bs_put(bs, ax - 15, linbits);
+            }
+            if (ax) {
+                bs_put(bs, x < 0, 1);
+            }
+            if (ay > 14) {
+                bs_put(bs, ay - 15, linbits);
+            }
+            if (ay) {
+                bs_put(bs, y < 0, 1);
+            }
+        } else {
+            int idx = ax * tab->xlen + ay;
+            bs_put(bs, tab->code[idx], tab->len[idx]);
+            if (ax) {
+                bs_put(bs, x < 0, 1);
+            }
+            if (ay) {
+                bs_put(bs, y < 0, 1);
+            }
+        }
+    }
+}
+
+static void write_huffman(mp3_enc_bs_t *bs, const uint16_t *sfb, mp3_enc_gr_info_t *gi, const int16_t *ix)
+{
+    int bv_end = gi->big_values * 2;
+    int r1 = sfb[gi->region0_count + 1];
+    int r2 = sfb[gi->region0_count + gi->region1_count + 2];
+    r1 = r1 > bv_end ? bv_end : r1;
+    r2 = r2 > bv_end ? bv_end : r2;
+    write_big_values(bs, ix, 0, r1, gi->table_select[0]);
+    write_big_values(bs, ix, r1, r2, gi->table_select[1]);
+    write_big_values(bs, ix, r2, bv_end, gi->table_select[2]);
+    int end = bv_end + gi->count1 * 4;
+    for (int i = bv_end; i < end; i += 4) {
+        int idx = 0;
+        for (int k = 0; k < 4; k++) {
+            idx = (idx << 1) | (ix[i + k] != 0);
+        }
+        if (gi->count1table_select) {
+            bs_put(bs, 15 - idx, 4);
+        } else {
+            bs_put(bs, mp3_enc_count1_code[idx], mp3_enc_count1_len[idx]);
+        }
+        for (int k = 0; k < 4; k++) {
+            if (ix[i + k]) {
+                bs_put(bs, ix[i + k] < 0, 1);
+            }
+        }
+    }
+}
+
+static int encode_frame(mp3_enc_t *enc, const int16_t *pcm, uint8_t *out)
+{
+    int nch = enc->cfg.channel;
+    for (int gr = 0; gr < enc->granules; gr++) {
+        for (int ch = 0; ch < nch; ch++) {
+            mp3_enc_fb_process(&enc->fb_tab, &enc->fb[ch], pcm + gr * MP3_ENC_GRANULE_SIZE * nch + ch, nch,
+                               enc->xr[gr][ch]);
+        }
+    }
+    enc->ms_stereo = false;
+    if (nch == ESP_AUDIO_DUAL && enc->cfg.psy_mode == ESP_MP3_ENC_PSY_MODE_NORMAL) {
+        ms_stereo_decide(enc);
+    }
+    int fixed_bits = MP3_ENC_HEADER_BITS + enc->side_bytes * 8;
+    int br_idx = enc->br_idx;
+    int padding = 0;
+    int frame_bytes;
+    if (enc->cfg.rc_mode == ESP_MP3_ENC_RC_MODE_VBR) {
+        int used = code_frame_vbr(enc);
+        int need = (used + fixed_bits + 7) >> 3;
+        br_idx = 1;
+        while (br_idx < enc->br_idx && get_frame_bytes(enc->lsf, br_idx, enc->cfg.sample_rate) < need) {
+            br_idx++;
+        }
+        frame_bytes = get_frame_bytes(enc->lsf, br_idx, enc->cfg.sample_rate);
+        if (frame_bytes < need) {
+            // Quality target exceeds bitrate limit, fall back to fit into the largest frame
+            code_frame_cbr(enc, frame_bytes * 8 - fixed_bits);
+        }
+    } else {
+        // Add padding slot to keep average bitrate for 44.1kHz family
+        uint32_t num = (enc->lsf ? 72 : 144) * mp3_enc_bitrate_tab[enc->lsf][br_idx] * 1000;
+        enc->slot_rem += num % enc->cfg.sample_rate;
+        if (enc->slot_rem >= (uint32_t)enc->cfg.sample_rate) {
+            enc->slot_rem -= enc->cfg.sample_rate;
+            padding = 1;
+        }
+        frame_bytes = get_frame_bytes(enc->lsf, br_idx, enc->cfg.sample_rate) + padding;
+        code_frame_cbr(enc, frame_bytes * 8 - fixed_bits);
+    }
+    mp3_enc_bs_t bs = {
+        .buf = out,
+    };
+    write_header(enc, &bs, br_idx, padding);
+    write_side_info(enc, &bs);
+    for (int gr = 0; gr < enc->granules; gr++) {
+        for (int ch = 0; ch < nch; ch++) {
+            mp3_enc_gr_info_t *gi = &enc->gi[gr][ch];
+            write_scalefac(enc, &bs, gi);
+            write_huffman(&bs, enc->gr_ctx[ch].sfb, gi, enc->ix[gr][ch]);
+        }
+    }
+    // Flush remaining bits and stuff the rest of frame with zero
+    if (bs.acc_bits) {
+        bs_put(&bs, 0, 8 - bs.acc_bits);
+    }
+    if (bs.pos < frame_bytes) {
+        memset(out + bs.pos, 0, frame_bytes - bs.pos);
+    }
+    return frame_bytes;
+}
+
+static int get_max_frame_bytes(bool lsf, int br_idx, int sample_rate)
+{
+    return get_frame_bytes(lsf, br_idx, sample_rate) + 1;
+}
+
+static void add_seek_point(mp3_enc_t *enc)
+{
+    if (enc->frames % enc->toc_step) {
+        return;
+    }
+    if (enc->toc_num == MP3_ENC_TOC_SLOTS) {
+        for (int i = 0; i < MP3_ENC_TOC_SLOTS / 2; i++) {
+            enc->toc_pos[i] = enc->toc_pos[i * 2];
+        }
+        enc->toc_num = MP3_ENC_TOC_SLOTS / 2;
+        enc->toc_step <<= 1;
+        if (enc->frames % enc->toc_step) {
+            return;
+        }
+    }
+    enc->toc_pos[enc->toc_num++] = enc->bytes;
+}
+
+static int get_tag_bitrate_index(mp3_enc_t *enc)
+{
+    int need = 4 + enc->side_bytes + MP3_ENC_XING_SIZE + MP3_ENC_LAME_TAG_SIZE;
+    if (need < MP3_ENC_LAME_CRC_BYTES + 2) {
+        need = MP3_ENC_LAME_CRC_BYTES + 2;
+    }
+    // Keep stream bitrate for CBR so that the tag frame also looks constant bitrate
+    if (enc->cfg.rc_mode == ESP_MP3_ENC_RC_MODE_CBR && get_frame_bytes(enc->lsf, enc->br_idx, enc->cfg.sample_rate) >= need) {
+        return enc->br_idx;
+    }
+    int br_idx = 1;
+    while (br_idx < 14 && get_frame_bytes(enc->lsf, br_idx, enc->cfg.sample_rate) < need) {
+        br_idx++;
+    }
+    return br_idx;
+}
+
+static inline void put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static void write_xing(mp3_enc_t *enc, uint8_t *p, uint32_t total_bytes)
+{
+    bool vbr = (enc->cfg.rc_mode == ESP_MP3_ENC_RC_MODE_VBR);
+    memcpy(p, vbr ? "Xing" : "Info", 4);
+    // Frames, bytes, TOC and quality are all present
+    put_be32(p + 4, 0x0F);
+    put_be32(p + 8, enc->frames);
+    put_be32(p + 12, total_bytes);
+    uint8_t *toc = p + 16;
+    uint32_t tag_bytes = total_bytes - enc->bytes;
+    for (int i = 0; i < 100; i++) {
+        uint32_t frame = (uint32_t)((uint64_t)enc->frames * i / 100);
+        uint32_t slot = frame / enc->toc_step;
+        uint32_t pos = (slot < enc->toc_num) ? enc->toc_pos[slot] : enc->bytes;
+        toc[i] = (uint8_t)((uint64_t)(pos + tag_bytes) * 256 / total_bytes);
+    }
+    put_be32(p + 116, vbr ? enc->cfg.vbr_quality * 10 : 0);
+}
+
+static void write_lame_tag(mp3_enc_t *enc, uint8_t *p, uint32_t delay, uint32_t padding, uint32_t total_bytes)
+{
+    bool vbr = (enc->cfg.rc_mode == ESP_MP3_ENC_RC_MODE_VBR);
+    memset(p, 0, MP3_ENC_LAME_TAG_SIZE);
+    // Tag layout follows LAME 3.100 so that players recognize it
+    memcpy(p, "LAME3.100", 9);
+    // Tag revision 0, VBR method: 1 for CBR, 4 for VBR
+    p[9] = vbr ? 4 : 1;
+    int kbps = vbr ? 0 : mp3_enc_bitrate_tab[enc->lsf][enc->br_idx];
+    p[20] = (uint8_t)(kbps > 255 ? 255 : kbps);
+    p[21] = (uint8_t)(delay >> 4);
+    p[22] = (uint8_t)(((delay & 0xF) << 4) | (padding >> 8));
+    p[23] = (uint8_t)padding;
+    put_be32(p + 28, total_bytes);
+    p[32] = (uint8_t)(enc->music_crc >> 8);
+    p[33] = (uint8_t)enc->music_crc;
+}
+
+esp_audio_err_t esp_mp3_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info)
+{
+    if (cfg == NULL || frame_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_mp3_enc_config_t *mp3_cfg = (esp_mp3_enc_config_t *)cfg;
+    bool lsf = false;
+    int sr_idx, br_idx;
+    if (check_config(mp3_cfg, &lsf, &sr_idx, &br_idx) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    int spf = lsf ? MP3_ENC_SPF_MPEG2 : MP3_ENC_SPF_MPEG1;
+    frame_info->in_frame_size = spf * mp3_cfg->channel * (mp3_cfg->bits_per_sample >> 3);
+    frame_info->in_frame_align = 2;
+    frame_info->out_frame_size = get_max_frame_bytes(lsf, br_idx, mp3_cfg->sample_rate);
+    frame_info->out_frame_align = 1;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd)
+{
+    if (cfg == NULL || enc_hd == NULL || cfg_sz != sizeof(esp_mp3_enc_config_t)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *enc_hd = NULL;
+    esp_mp3_enc_config_t *mp3_cfg = (esp_mp3_enc_config_t *)cfg;
+    bool lsf = false;
+    int sr_idx, br_idx;
+    if (check_config(mp3_cfg, &lsf, &sr_idx, &br_idx) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)calloc(1, sizeof(mp3_enc_t));
+    if (enc == NULL) {
+        ESP_LOGE(TAG, "No memory for encoder");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    enc->cfg = *mp3_cfg;
+    enc->lsf = lsf;
+    enc->sr_idx = (uint8_t)sr_idx;
+    enc->br_idx = (uint8_t)br_idx;
+    enc->granules = lsf ? 1 : 2;
+    enc->samples_per_frame = lsf ? MP3_ENC_SPF_MPEG2 : MP3_ENC_SPF_MPEG1;
+    if (lsf) {
+        enc->side_bytes = (mp3_cfg->channel == 1) ? 9 : 17;
+    } else {
+        enc->side_bytes = (mp3_cfg->channel == 1) ? 17 : 32;
+    }
+    int sfb_idx = sr_idx + (lsf ? 3 : 0);
+    for (int ch = 0; ch < MP3_ENC_MAX_CH; ch++) {
+        mp3_enc_gr_ctx_t *ctx = &enc->gr_ctx[ch];
+        ctx->sfb = mp3_enc_sfb_long[sfb_idx];
+        ctx->lsf = lsf;
+        if (mp3_cfg->psy_mode == ESP_MP3_ENC_PSY_MODE_NORMAL) {
+            ctx->search_region = true;
+            for (int b = 0; b < MP3_ENC_SFB_NUM - 1; b++) {
+                ctx->max_sf[b] = (b < 11) ? 15 : 7;
+            }
+        }
+    }
+    enc->toc_step = 1;
+    mp3_enc_fb_init(&enc->fb_tab);
+    calc_ath(enc);
+    *enc_hd = enc;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_set_bitrate(void *enc_hd, int bitrate)
+{
+    if (enc_hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    // Same as open: 0 in VBR mode lifts the upper limit to the highest bitrate
+    int br_idx = 14;
+    if (enc->cfg.rc_mode != ESP_MP3_ENC_RC_MODE_VBR || bitrate != 0) {
+        br_idx = get_bitrate_index(enc->lsf, bitrate);
+    }
+    if (br_idx < 0) {
+        ESP_LOGE(TAG, "Not support bitrate %d", bitrate);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    enc->br_idx = (uint8_t)br_idx;
+    enc->cfg.bitrate = bitrate;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size)
+{
+    if (enc_hd == NULL || in_size == NULL || out_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    *in_size = enc->samples_per_frame * enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    *out_size = get_max_frame_bytes(enc->lsf, enc->br_idx, enc->cfg.sample_rate);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame, esp_audio_enc_out_frame_t *out_frame)
+{
+    if (enc_hd == NULL || in_frame == NULL || out_frame == NULL || in_frame->buffer == NULL || out_frame->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    int in_size = enc->samples_per_frame * enc->cfg.channel * (enc->cfg.bits_per_sample >> 3);
+    int frames = in_frame->len / in_size;
+    if (frames == 0) {
+        ESP_LOGE(TAG, "Input data %d not enough for one frame %d", (int)in_frame->len, in_size);
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    int max_frame_bytes = get_max_frame_bytes(enc->lsf, enc->br_idx, enc->cfg.sample_rate);
+    if (out_frame->len < (uint32_t)(frames * max_frame_bytes)) {
+        ESP_LOGE(TAG, "Output buffer %d not enough, need %d", (int)out_frame->len, frames * max_frame_bytes);
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    out_frame->pts = enc->samples * 1000 / enc->cfg.sample_rate;
+    int out_pos = 0;
+    for (int i = 0; i < frames; i++) {
+        const int16_t *pcm = (const int16_t *)(in_frame->buffer + i * in_size);
+        add_seek_point(enc);
+        int frame_bytes = encode_frame(enc, pcm, out_frame->buffer + out_pos);
+        enc->music_crc = crc16_update(enc->music_crc, out_frame->buffer + out_pos, frame_bytes);
+        enc->frames++;
+        enc->bytes += frame_bytes;
+        out_pos += frame_bytes;
+        enc->samples += enc->samples_per_frame;
+    }
+    out_frame->encoded_bytes = out_pos;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info)
+{
+    if (enc_hd == NULL || enc_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    enc_info->sample_rate = enc->cfg.sample_rate;
+    enc_info->channel = enc->cfg.channel;
+    enc_info->bits_per_sample = enc->cfg.bits_per_sample;
+    // Bitrate actually coded, configured bitrate is rounded down to the table of current MPEG version
+    enc_info->bitrate = mp3_enc_bitrate_tab[enc->lsf][enc->br_idx] * 1000;
+    enc_info->codec_spec_info = NULL;
+    enc_info->spec_info_len = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_get_info_tag(void *enc_hd, uint64_t valid_samples, uint8_t *buffer, int *size)
+{
+    if (enc_hd == NULL || size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    int br_idx = get_tag_bitrate_index(enc);
+    int tag_size = get_frame_bytes(enc->lsf, br_idx, enc->cfg.sample_rate);
+    if (buffer == NULL) {
+        *size = tag_size;
+        return ESP_AUDIO_ERR_OK;
+    }
+    if (*size < tag_size) {
+        ESP_LOGE(TAG, "Tag buffer %d not enough, need %d", *size, tag_size);
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    uint64_t decodable = enc->samples;
+    if (decodable < ESP_MP3_ENC_DELAY_SAMPLES + ESP_MP3_ENC_DECODER_DELAY) {
+        ESP_LOGE(TAG, "Encoded samples %d too few for tag", (int)decodable);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    decodable -= ESP_MP3_ENC_DELAY_SAMPLES + ESP_MP3_ENC_DECODER_DELAY;
+    if (valid_samples == 0) {
+        valid_samples = decodable;
+    }
+    if (valid_samples > decodable) {
+        ESP_LOGE(TAG, "Need encode at least %d more samples to flush", (int)(valid_samples - decodable));
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    // Padding field only has 12 bits
+    uint32_t padding = (uint32_t)(enc->samples - ESP_MP3_ENC_DELAY_SAMPLES - valid_samples);
+    if (padding > 0xFFF) {
+        ESP_LOGE(TAG, "Padding %d exceed limit", (int)padding);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    uint32_t total_bytes = enc->bytes + tag_size;
+    mp3_enc_bs_t bs = {
+        .buf = buffer,
+    };
+    // Silent frame: header with zeroed side information
+    bool ms_stereo = enc->ms_stereo;
+    enc->ms_stereo = false;
+    write_header(enc, &bs, br_idx, 0);
+    enc->ms_stereo = ms_stereo;
+    memset(buffer + 4, 0, tag_size - 4);
+    uint8_t *xing = buffer + 4 + enc->side_bytes;
+    write_xing(enc, xing, total_bytes);
+    uint8_t *lame = xing + MP3_ENC_XING_SIZE;
+    write_lame_tag(enc, lame, ESP_MP3_ENC_DELAY_SAMPLES, padding, total_bytes);
+    uint16_t tag_crc = crc16_update(0, buffer, MP3_ENC_LAME_CRC_BYTES);
+    lame[34] = (uint8_t)(tag_crc >> 8);
+    lame[35] = (uint8_t)tag_crc;
+    *size = tag_size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_mp3_enc_reset(void *enc_hd)
+{
+    if (enc_hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    mp3_enc_t *enc = (mp3_enc_t *)enc_hd;
+    memset(enc->fb, 0, sizeof(enc->fb));
+    enc->slot_rem = 0;
+    enc->samples = 0;
+    enc->frames = 0;
+    enc->bytes = 0;
+    enc->music_crc = 0;
+    enc->toc_num = 0;
+    enc->toc_step = 1;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_mp3_enc_close(void *enc_hd)
+{
+    if (enc_hd) {
+        free(enc_hd);
+    }
+}
+
+esp_audio_err_t esp_mp3_enc_register(void)
+{
+    static const esp_audio_enc_ops_t mp3_enc_ops = {
+        .get_frame_info_by_cfg = esp_mp3_enc_get_frame_info_by_cfg,
+        .open = esp_mp3_enc_open,
+        .set_bitrate = esp_mp3_enc_set_bitrate,
+        .get_info = esp_mp3_enc_get_info,
+        .get_frame_size = esp_mp3_enc_get_frame_size,
+        .process = esp_mp3_enc_process,
+        .reset = esp_mp3_enc_reset,
+        .close = esp_mp3_enc_close,
+    };
+    return esp_audio_enc_register(ESP_AUDIO_TYPE_MP3, &mp3_enc_ops);
+}
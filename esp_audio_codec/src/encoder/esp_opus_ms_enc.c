@@ -0,0 +1,474 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_opus_ms_enc.h"
+#include "esp_audio_enc_reg.h"
+#include "opus_ms_pkt.h"
+#include "esp_log.h"
+
+#define TAG "OPUS_MS_ENC"
+
+#define OPUS_MS_PRE_SKIP_AUDIO    (312)
+#define OPUS_MS_PRE_SKIP_LOWDELAY (120)
+#define OPUS_MS_WEIGHT_COUPLED    (3)
+#define OPUS_MS_WEIGHT_MONO       (2)
+#define OPUS_MS_WEIGHT_LFE        (1)
+
+typedef struct {
+    void   *core;
+    uint8_t ch_num;
+    uint8_t src_ch[2];
+    bool    is_lfe;
+    int     bitrate;
+    int     core_out_size;
+    uint8_t toc;
+} opus_ms_stream_t;
+
+typedef struct {
+    esp_opus_ms_enc_config_t cfg;
+    opus_ms_layout_t         layout;
+    opus_ms_stream_t         stream[OPUS_MS_MAX_CHANNEL];
+    int                      frame_samples;
+    int                      out_frame_size;
+    int16_t                 *pcm;
+    uint8_t                 *core_out;
+    int                      core_out_size;
+    uint64_t                 samples;
+    uint8_t                  head[OPUS_MS_HEAD_MAX_SIZE];
+    int                      head_len;
+} opus_ms_enc_t;
+
+/* Frame duration in unit of 0.5 ms */
+static const uint8_t opus_ms_duration[] = {5, 10, 20, 40, 80, 120, 160, 200, 240};
+
+static int get_frame_samples(esp_opus_ms_enc_config_t *cfg)
+{
+    if (cfg->frame_duration < ESP_OPUS_ENC_FRAME_DURATION_2_5_MS ||
+        cfg->frame_duration > ESP_OPUS_ENC_FRAME_DURATION_120_MS) {
+        return 0;
+    }
+    return cfg->sample_rate * opus_ms_duration[cfg->frame_duration] / 2000;
+}
+
+static int check_config(esp_opus_ms_enc_config_t *cfg)
+{
+    if (cfg->sample_rate != 8000 && cfg->sample_rate != 12000 && cfg->sample_rate != 16000 &&
+        cfg->sample_rate != 24000 && cfg->sample_rate != 48000) {
+        ESP_LOGE(TAG, "Not support sample rate %d", cfg->sample_rate);
+        return -1;
+    }
+    if (opus_ms_get_layout(cfg->channel) == NULL) {
+        ESP_LOGE(TAG, "Not support channel %d", cfg->channel);
+        return -1;
+    }
+    if (cfg->bits_per_sample != ESP_AUDIO_BIT16) {
+        ESP_LOGE(TAG, "Not support bits per sample %d", cfg->bits_per_sample);
+        return -1;
+    }
+    if (get_frame_samples(cfg) == 0) {
+        ESP_LOGE(TAG, "Not support frame duration %d", cfg->frame_duration);
+        return -1;
+    }
+    return 0;
+}
+
+static void get_bitrate_range(esp_opus_ms_enc_config_t *cfg, int *min_rate, int *max_rate)
+{
+    // Follow the per stream bitrate range of `esp_opus_enc_config_t`
+    if (cfg->sample_rate <= 16000) {
+        *min_rate = cfg->frame_duration == ESP_OPUS_ENC_FRAME_DURATION_2_5_MS ? 30000 :
+                    (cfg->frame_duration == ESP_OPUS_ENC_FRAME_DURATION_5_MS ? 20000 : 6000);
+        *max_rate = cfg->sample_rate * 16;
+    } else if (cfg->sample_rate == 24000) {
+        *min_rate = cfg->frame_duration == ESP_OPUS_ENC_FRAME_DURATION_2_5_MS ? 50000 : 40000;
+        *max_rate = 384000;
+    } else {
+        *min_rate = cfg->frame_duration == ESP_OPUS_ENC_FRAME_DURATION_2_5_MS ? 40000 : 30000;
+        *max_rate = 510000;
+    }
+}
+
+static void split_bitrate(opus_ms_enc_t *enc, int bitrate, int *stream_bitrate)
+{
+    int stream_num = enc->layout.stream_count;
+    if (bitrate == ESP_OPUS_BITRATE_AUTO) {
+        for (int s = 0; s < stream_num; s++) {
+            stream_bitrate[s] = ESP_OPUS_BITRATE_AUTO;
+        }
+        return;
+    }
+    int min_rate, max_rate;
+    get_bitrate_range(&enc->cfg, &min_rate, &max_rate);
+    int weight[OPUS_MS_MAX_CHANNEL];
+    int total_weight = 0;
+    for (int s = 0; s < stream_num; s++) {
+        opus_ms_stream_t *stream = &enc->stream[s];
+        weight[s] = stream->is_lfe ? OPUS_MS_WEIGHT_LFE :
+                    (stream->ch_num == 2 ? OPUS_MS_WEIGHT_COUPLED : OPUS_MS_WEIGHT_MONO);
+        total_weight += weight[s];
+    }
+    for (int s = 0; s < stream_num; s++) {
+        int rate = (int)((int64_t)bitrate * weight[s] / total_weight);
+        stream_bitrate[s] = rate < min_rate ? min_rate : (rate > max_rate ? max_rate : rate);
+    }
+}
+
+static void setup_streams(opus_ms_enc_t *enc)
+{
+    int ch = enc->cfg.channel;
+    for (int i = 0; i < ch; i++) {
+        int sub = 0;
+        int s = opus_ms_get_stream(enc->layout.mapping[i], enc->layout.coupled_count, &sub);
+        enc->stream[s].src_ch[sub] = (uint8_t)i;
+    }
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        enc->stream[s].ch_num = s < enc->layout.coupled_count ? 2 : 1;
+    }
+    // LFE always use the last mono stream for 6, 7 and 8 channels
+    if (ch >= 6) {
+        enc->stream[enc->layout.stream_count - 1].is_lfe = true;
+    }
+}
+
+static void build_head(opus_ms_enc_t *enc, int pre_skip)
+{
+    uint8_t *head = enc->head;
+    memcpy(head, "OpusHead", 8);
+    head[8] = 1;
+    head[9] = (uint8_t)enc->cfg.channel;
+    head[10] = (uint8_t)(pre_skip & 0xFF);
+    head[11] = (uint8_t)(pre_skip >> 8);
+    uint32_t rate = (uint32_t)enc->cfg.sample_rate;
+    for (int i = 0; i < 4; i++) {
+        head[12 + i] = (uint8_t)(rate >> (i * 8));
+    }
+    // Output gain 0
+    head[16] = 0;
+    head[17] = 0;
+    if (enc->cfg.channel <= 2) {
+        head[18] = 0;
+        enc->head_len = OPUS_MS_HEAD_MIN_SIZE;
+        return;
+    }
+    head[18] = 1;
+    head[19] = enc->layout.stream_count;
+    head[20] = enc->layout.coupled_count;
+    memcpy(head + 21, enc->layout.mapping, enc->cfg.channel);
+    enc->head_len = OPUS_MS_HEAD_MIN_SIZE + 2 + enc->cfg.channel;
+}
+
+static int get_pre_skip(opus_ms_enc_t *enc)
+{
+    // Prefer lookahead reported by encoder core, it is in 48kHz sample unit
+    esp_audio_enc_info_t info = {0};
+    if (esp_opus_enc_get_info(enc->stream[0].core, &info) == ESP_AUDIO_ERR_OK &&
+        info.codec_spec_info && info.spec_info_len >= 12 && memcmp(info.codec_spec_info, "OpusHead", 8) == 0) {
+        return info.codec_spec_info[10] | (info.codec_spec_info[11] << 8);
+    }
+    return enc->cfg.application_mode == ESP_OPUS_ENC_APPLICATION_LOWDELAY ?
+           OPUS_MS_PRE_SKIP_LOWDELAY : OPUS_MS_PRE_SKIP_AUDIO;
+}
+
+static void close_streams(opus_ms_enc_t *enc)
+{
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        if (enc->stream[s].core) {
+            esp_opus_enc_close(enc->stream[s].core);
+            enc->stream[s].core = NULL;
+        }
+    }
+}
+
+static void get_stream_config(esp_opus_ms_enc_config_t *cfg, int ch_num, int bitrate, esp_opus_enc_config_t *core_cfg)
+{
+    core_cfg->sample_rate = cfg->sample_rate;
+    core_cfg->channel = ch_num;
+    core_cfg->bits_per_sample = ESP_AUDIO_BIT16;
+    core_cfg->bitrate = bitrate;
+    core_cfg->frame_duration = cfg->frame_duration;
+    core_cfg->application_mode = cfg->application_mode;
+    core_cfg->complexity = cfg->complexity;
+    core_cfg->enable_fec = cfg->enable_fec;
+    core_cfg->enable_dtx = cfg->enable_dtx;
+    core_cfg->enable_vbr = cfg->enable_vbr;
+}
+
+static int encode_frame(opus_ms_enc_t *enc, const int16_t *in, uint8_t *out, int *out_len)
+{
+    int ch = enc->cfg.channel;
+    int pos = 0;
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        opus_ms_stream_t *stream = &enc->stream[s];
+        for (int c = 0; c < stream->ch_num; c++) {
+            const int16_t *src = in + stream->src_ch[c];
+            for (int i = 0; i < enc->frame_samples; i++) {
+                enc->pcm[i * stream->ch_num + c] = src[i * ch];
+            }
+        }
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = (uint8_t *)enc->pcm,
+            .len = enc->frame_samples * stream->ch_num * sizeof(int16_t),
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = enc->core_out,
+            .len = enc->core_out_size,
+        };
+        esp_audio_err_t ret = esp_opus_enc_process(stream->core, &in_frame, &out_frame);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to encode stream %d ret %d", s, ret);
+            return -1;
+        }
+        int pkt_len = (int)out_frame.encoded_bytes;
+        if (pkt_len == 0) {
+            // Every stream must carry at least TOC byte, reuse last TOC with an empty frame
+            if (stream->toc == 0) {
+                ESP_LOGE(TAG, "Stream %d has no packet output", s);
+                return -1;
+            }
+            enc->core_out[0] = stream->toc & 0xFC;
+            pkt_len = 1;
+        }
+        stream->toc = enc->core_out[0];
+        if (s == enc->layout.stream_count - 1) {
+            memcpy(out + pos, enc->core_out, pkt_len);
+            pos += pkt_len;
+            break;
+        }
+        pkt_len = opus_ms_pkt_to_self_delimited(enc->core_out, pkt_len, out + pos);
+        if (pkt_len < 0) {
+            ESP_LOGE(TAG, "Bad packet of stream %d", s);
+            return -1;
+        }
+        pos += pkt_len;
+    }
+    *out_len = pos;
+    return 0;
+}
+
+esp_audio_err_t esp_opus_ms_enc_get_frame_info_by_cfg(void *cfg, esp_audio_enc_frame_info_t *frame_info)
+{
+    if (cfg == NULL || frame_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_opus_ms_enc_config_t *ms_cfg = (esp_opus_ms_enc_config_t *)cfg;
+    if (check_config(ms_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    const opus_ms_layout_t *layout = opus_ms_get_layout(ms_cfg->channel);
+    int out_size = 0;
+    for (int s = 0; s < layout->stream_count; s++) {
+        esp_opus_enc_config_t core_cfg;
+        get_stream_config(ms_cfg, s < layout->coupled_count ? 2 : 1, ESP_OPUS_BITRATE_AUTO, &core_cfg);
+        esp_audio_enc_frame_info_t core_info = {0};
+        if (esp_opus_enc_get_frame_info_by_cfg(&core_cfg, &core_info) != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to get frame information of stream %d", s);
+            return ESP_AUDIO_ERR_FAIL;
+        }
+        // Self-delimited length field takes at most 2 bytes
+        out_size += core_info.out_frame_size + 2;
+    }
+    int sample_bytes = ms_cfg->channel * sizeof(int16_t);
+    frame_info->in_frame_size = get_frame_samples(ms_cfg) * sample_bytes;
+    frame_info->in_frame_align = sample_bytes;
+    frame_info->out_frame_size = out_size;
+    frame_info->out_frame_align = 1;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_open(void *cfg, uint32_t cfg_sz, void **enc_hd)
+{
+    if (cfg == NULL || enc_hd == NULL || cfg_sz != sizeof(esp_opus_ms_enc_config_t)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *enc_hd = NULL;
+    esp_opus_ms_enc_config_t *ms_cfg = (esp_opus_ms_enc_config_t *)cfg;
+    if (check_config(ms_cfg) != 0) {
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)calloc(1, sizeof(opus_ms_enc_t));
+    if (enc == NULL) {
+        ESP_LOGE(TAG, "No memory for encoder");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    enc->cfg = *ms_cfg;
+    enc->layout = *opus_ms_get_layout(ms_cfg->channel);
+    enc->frame_samples = get_frame_samples(ms_cfg);
+    setup_streams(enc);
+    int stream_bitrate[OPUS_MS_MAX_CHANNEL];
+    split_bitrate(enc, ms_cfg->bitrate, stream_bitrate);
+    esp_audio_err_t ret = ESP_AUDIO_ERR_OK;
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        opus_ms_stream_t *stream = &enc->stream[s];
+        esp_opus_enc_config_t core_cfg;
+        get_stream_config(ms_cfg, stream->ch_num, stream_bitrate[s], &core_cfg);
+        ret = esp_opus_enc_open(&core_cfg, sizeof(esp_opus_enc_config_t), &stream->core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to open encoder core for stream %d ret %d", s, ret);
+            break;
+        }
+        stream->bitrate = stream_bitrate[s];
+        int in_size = 0;
+        esp_opus_enc_get_frame_size(stream->core, &in_size, &stream->core_out_size);
+        if (stream->core_out_size > enc->core_out_size) {
+            enc->core_out_size = stream->core_out_size;
+        }
+        enc->out_frame_size += stream->core_out_size + 2;
+    }
+    if (ret == ESP_AUDIO_ERR_OK) {
+        enc->pcm = (int16_t *)malloc(enc->frame_samples * 2 * sizeof(int16_t));
+        enc->core_out = (uint8_t *)malloc(enc->core_out_size);
+        if (enc->pcm == NULL || enc->core_out == NULL) {
+            ESP_LOGE(TAG, "No memory for encoder buffers");
+            ret = ESP_AUDIO_ERR_MEM_LACK;
+        }
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        esp_opus_ms_enc_close(enc);
+        return ret;
+    }
+    build_head(enc, get_pre_skip(enc));
+    *enc_hd = enc;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_set_bitrate(void *enc_hd, int bitrate)
+{
+    if (enc_hd == NULL || (bitrate < 0 && bitrate != ESP_OPUS_BITRATE_AUTO)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+    int stream_bitrate[OPUS_MS_MAX_CHANNEL];
+    split_bitrate(enc, bitrate, stream_bitrate);
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        esp_audio_err_t ret = esp_opus_enc_set_bitrate(enc->stream[s].core, stream_bitrate[s]);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to set bitrate %d for stream %d", stream_bitrate[s], s);
+            return ret;
+        }
+        enc->stream[s].bitrate = stream_bitrate[s];
+    }
+    enc->cfg.bitrate = bitrate;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_get_frame_size(void *enc_hd, int *in_size, int *out_size)
+{
+    if (enc_hd == NULL || in_size == NULL || out_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+    *in_size = enc->frame_samples * enc->cfg.channel * sizeof(int16_t);
+    *out_size = enc->out_frame_size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_process(void *enc_hd, esp_audio_enc_in_frame_t *in_frame,
+                                        esp_audio_enc_out_frame_t *out_frame)
+{
+    if (enc_hd == NULL || in_frame == NULL || out_frame == NULL || in_frame->buffer == NULL || out_frame->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+    int in_size = enc->frame_samples * enc->cfg.channel * sizeof(int16_t);
+    int frames = in_frame->len / in_size;
+    if (frames == 0) {
+        ESP_LOGE(TAG, "Input data %d not enough for one frame %d", (int)in_frame->len, in_size);
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    if (out_frame->len < (uint32_t)(frames * enc->out_frame_size)) {
+        ESP_LOGE(TAG, "Output buffer %d not enough, need %d", (int)out_frame->len, frames * enc->out_frame_size);
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    out_frame->pts = enc->samples * 1000 / enc->cfg.sample_rate;
+    int out_pos = 0;
+    for (int i = 0; i < frames; i++) {
+        int out_len = 0;
+        if (encode_frame(enc, (int16_t *)(in_frame->buffer + i * in_size), out_frame->buffer + out_pos, &out_len) != 0) {
+            return ESP_AUDIO_ERR_FAIL;
+        }
+        out_pos += out_len;
+        enc->samples += enc->frame_samples;
+    }
+    out_frame->encoded_bytes = out_pos;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_get_info(void *enc_hd, esp_audio_enc_info_t *enc_info)
+{
+    if (enc_hd == NULL || enc_info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+    enc_info->sample_rate = enc->cfg.sample_rate;
+    enc_info->channel = enc->cfg.channel;
+    enc_info->bits_per_sample = enc->cfg.bits_per_sample;
+    enc_info->bitrate = 0;
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        esp_audio_enc_info_t core_info = {0};
+        esp_opus_enc_get_info(enc->stream[s].core, &core_info);
+        enc_info->bitrate += core_info.bitrate;
+    }
+    enc_info->codec_spec_info = enc->head;
+    enc_info->spec_info_len = enc->head_len;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_opus_ms_enc_reset(void *enc_hd)
+{
+    if (enc_hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+    for (int s = 0; s < enc->layout.stream_count; s++) {
+        esp_audio_err_t ret = esp_opus_enc_reset(enc->stream[s].core);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        enc->stream[s].toc = 0;
+    }
+    enc->samples = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_opus_ms_enc_close(void *enc_hd)
+{
+    if (enc_hd) {
+        opus_ms_enc_t *enc = (opus_ms_enc_t *)enc_hd;
+        close_streams(enc);
+        if (enc->pcm) {
+            free(enc->pcm);
+        }
+        if (enc->core_out) {
+            free(enc->core_out);
+        }
+        free(enc);
+    }
+}
+
+esp_audio_err_t esp_opus_ms_enc_register(void)
+{
+    static const esp_audio_enc_ops_t opus_ms_enc_ops = {
+        .get_frame_info_by_cfg = esp_opus_ms_enc_get_frame_info_by_cfg,
+        .open = esp_opus_ms_enc_open,
+        .set_bitrate = esp_opus_ms_enc_set_bitrate,
+        .get_info = esp_opus_ms_enc_get_info,
+        .get_frame_size = esp_opus_ms_enc_get_frame_size,
+        .process = esp_opus_ms_enc_process,
+        .reset = esp_opus_ms_enc_reset,
+        .close = esp_opus_ms_enc_close,
+    };
+    return esp_audio_enc_register(ESP_AUDIO_TYPE_OPUS, &opus_ms_enc_ops);
+}
@@ -0,0 +1,450 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "flac_enc_priv.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define FLAC_ENC_BITS_INF          (0xFFFFFFFFu)
+#define FLAC_ENC_SUBFRAME_HDR_BITS (8)
+#define FLAC_ENC_MAX_RICE_4BIT     (14)
+#define FLAC_ENC_MAX_RICE_5BIT     (30)
+/* Residual beyond this magnitude may overflow the 32 bits decoder arithmetic */
+#define FLAC_ENC_MAX_RESIDUAL      (1 << 30)
+
+static inline int bit_len(uint64_t v)
+{
+    return v ? 64 - __builtin_clzll(v) : 0;
+}
+
+static inline uint32_t zigzag(int32_t v)
+{
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+void flac_enc_init_window(float *window, int n)
+{
+    // Tukey window with cosine taper on 25% of each side
+    int taper = n / 4;
+    for (int i = 0; i < n; i++) {
+        window[i] = 1.0f;
+    }
+    if (taper < 2) {
+        return;
+    }
+    for (int i = 0; i < taper; i++) {
+        float w = 0.5f - 0.5f * cosf((float)M_PI * i / taper);
+        window[i] = w;
+        window[n - 1 - i] = w;
+    }
+}
+
+uint64_t flac_enc_estimate_cost(const int32_t *smp, int n)
+{
+    uint64_t sum = 0;
+    for (int i = 2; i < n; i++) {
+        int64_t e = (int64_t)smp[i] - 2 * (int64_t)smp[i - 1] + smp[i - 2];
+        sum += (uint64_t)(e < 0 ? -e : e);
+    }
+    return sum;
+}
+
+static int get_qlp_precision(int n, int bps)
+{
+    int prec;
+    if (n <= 192) {
+        prec = 7;
+    } else if (n <= 384) {
+        prec = 8;
+    } else if (n <= 576) {
+        prec = 9;
+    } else if (n <= 1152) {
+        prec = 10;
+    } else if (n <= 2304) {
+        prec = 11;
+    } else if (n <= 4608) {
+        prec = 12;
+    } else {
+        prec = 13;
+    }
+    if (bps > 16) {
+        prec += 2;
+    }
+    return prec > FLAC_ENC_MAX_QLP_PREC ? FLAC_ENC_MAX_QLP_PREC : prec;
+}
+
+void flac_enc_calc_residual(const flac_enc_subframe_t *sf, int n, int32_t *residual)
+{
+    const int32_t *x = sf->samples;
+    int order = sf->order;
+    if (sf->type == FLAC_ENC_SUBFRAME_FIXED) {
+        switch (order) {
+            case 0:
+                memcpy(residual, x, n * sizeof(int32_t));
+                break;
+            case 1:
+                for (int i = 1; i < n; i++) {
+                    residual[i] = x[i] - x[i - 1];
+                }
+                break;
+            case 2:
+                for (int i = 2; i < n; i++) {
+                    residual[i] = x[i] - 2 * x[i - 1] + x[i - 2];
+                }
+                break;
+            case 3:
+                for (int i = 3; i < n; i++) {
+                    residual[i] = x[i] - 3 * x[i - 1] + 3 * x[i - 2] - x[i - 3];
+                }
+                break;
+            default:
+                for (int i = 4; i < n; i++) {
+                    residual[i] = x[i] - 4 * x[i - 1] + 6 * x[i - 2] - 4 * x[i - 3] + x[i - 4];
+                }
+                break;
+        }
+        return;
+    }
+    const int32_t *coef = sf->coef;
+    int shift = sf->shift;
+    // Use 32 bits accumulation when it can not overflow
+    if (sf->bps + sf->precision + bit_len(order) <= 32) {
+        for (int i = order; i < n; i++) {
+            int32_t sum = 0;
+            for (int j = 0; j < order; j++) {
+                sum += coef[j] * x[i - j - 1];
+            }
+            residual[i] = x[i] - (sum >> shift);
+        }
+    } else {
+        for (int i = order; i < n; i++) {
+            int64_t sum = 0;
+            for (int j = 0; j < order; j++) {
+                sum += (int64_t)coef[j] * x[i - j - 1];
+            }
+            residual[i] = (int32_t)(x[i] - (sum >> shift));
+        }
+    }
+}
+
+static uint32_t rice_partition_bits(uint64_t sum, int count, int max_param, uint8_t *param)
+{
+    // Mean of folded residual gives a good first guess of the Rice parameter
+    uint64_t mean = count ? sum / count : 0;
+    int k = bit_len(mean);
+    k = k > 0 ? k - 1 : 0;
+    uint64_t best = UINT64_MAX;
+    int best_k = 0;
+    for (int t = (k > 0 ? k - 1 : 0); t <= k + 1 && t <= max_param; t++) {
+        // Truncation drops half a unit per sample in average when parameter is not zero
+        uint64_t bits = (uint64_t)count * (t + 1) + (sum >> t) - (t ? (uint64_t)count >> 1 : 0);
+        if (bits < best) {
+            best = bits;
+            best_k = t;
+        }
+    }
+    *param = (uint8_t)best_k;
+    return best > FLAC_ENC_BITS_INF ? FLAC_ENC_BITS_INF : (uint32_t)best;
+}
+
+static uint32_t rice_exact_bits(const int32_t *res, int start, int end, int k)
+{
+    uint32_t bits = (uint32_t)(end - start) * (k + 1);
+    for (int i = start; i < end; i++) {
+        bits += zigzag(res[i]) >> k;
+    }
+    return bits;
+}
+
+/* Search Rice partition order and parameters, return residual bits including coding method header */
+static uint32_t rice_encode_search(const int32_t *res, int n, int order, int max_part_order, int bps,
+                                   flac_enc_subframe_t *sf)
+{
+    uint64_t sums[1 << FLAC_ENC_MAX_PART_ORDER];
+    uint8_t params[1 << FLAC_ENC_MAX_PART_ORDER];
+    int max_order = 0;
+    while (max_order < max_part_order && (n & ((1 << (max_order + 1)) - 1)) == 0 &&
+           (n >> (max_order + 1)) > order) {
+        max_order++;
+    }
+    int max_param = bps > 16 ? FLAC_ENC_MAX_RICE_5BIT : FLAC_ENC_MAX_RICE_4BIT;
+    // Folded sums at the finest partition, merged pairwise for lower orders
+    int parts = 1 << max_order;
+    int psize = n >> max_order;
+    for (int p = 0; p < parts; p++) {
+        int start = p ? p * psize : order;
+        int end = (p + 1) * psize;
+        uint64_t s = 0;
+        for (int i = start; i < end; i++) {
+            s += zigzag(res[i]);
+        }
+        sums[p] = s;
+    }
+    uint32_t best = FLAC_ENC_BITS_INF;
+    for (int po = max_order; po >= 0; po--) {
+        int cnt = 1 << po;
+        int size = n >> po;
+        uint32_t bits = 0;
+        int max_k = 0;
+        for (int p = 0; p < cnt; p++) {
+            int count = p ? size : size - order;
+            bits += rice_partition_bits(sums[p], count, max_param, &params[p]);
+            if (params[p] > max_k) {
+                max_k = params[p];
+            }
+        }
+        bits += cnt * (max_k > FLAC_ENC_MAX_RICE_4BIT ? 5 : 4);
+        if (bits < best) {
+            best = bits;
+            sf->part_order = (uint8_t)po;
+            sf->rice_5bit = max_k > FLAC_ENC_MAX_RICE_4BIT;
+            memcpy(sf->rice_param, params, cnt);
+        }
+        for (int p = 0; p < (cnt >> 1); p++) {
+            sums[p] = sums[2 * p] + sums[2 * p + 1];
+        }
+    }
+    // Count exact bits of the selected partition
+    int cnt = 1 << sf->part_order;
+    int size = n >> sf->part_order;
+    uint32_t bits = 2 + 4 + cnt * (sf->rice_5bit ? 5 : 4);
+    for (int p = 0; p < cnt; p++) {
+        bits += rice_exact_bits(res, p ? p * size : order, (p + 1) * size, sf->rice_param[p]);
+    }
+    return bits;
+}
+
+static bool residual_in_range(const int32_t *res, int start, int n)
+{
+    for (int i = start; i < n; i++) {
+        if (res[i] >= FLAC_ENC_MAX_RESIDUAL || res[i] <= -FLAC_ENC_MAX_RESIDUAL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int best_fixed_order(const int32_t *x, int n)
+{
+    uint64_t err[FLAC_ENC_MAX_FIXED_ORDER + 1] = {0};
+    if (n <= FLAC_ENC_MAX_FIXED_ORDER) {
+        return 0;
+    }
+    int64_t d1p = (int64_t)x[3] - x[2];
+    int64_t d2p = d1p - ((int64_t)x[2] - x[1]);
+    int64_t d3p = d2p - (((int64_t)x[2] - x[1]) - ((int64_t)x[1] - x[0]));
+    for (int i = FLAC_ENC_MAX_FIXED_ORDER; i < n; i++) {
+        int64_t e0 = x[i];
+        int64_t e1 = e0 - x[i - 1];
+        int64_t e2 = e1 - d1p;
+        int64_t e3 = e2 - d2p;
+        int64_t e4 = e3 - d3p;
+        d1p = e1;
+        d2p = e2;
+        d3p = e3;
+        err[0] += (uint64_t)(e0 < 0 ? -e0 : e0);
+        err[1] += (uint64_t)(e1 < 0 ? -e1 : e1);
+        err[2] += (uint64_t)(e2 < 0 ? -e2 : e2);
+        err[3] += (uint64_t)(e3 < 0 ? -e3 : e3);
+        err[4] += (uint64_t)(e4 < 0 ? -e4 : e4);
+    }
+    int order = 0;
+    for (int o = 1; o <= FLAC_ENC_MAX_FIXED_ORDER; o++) {
+        if (err[o] < err[order]) {
+            order = o;
+        }
+    }
+    return order;
+}
+
+static void levinson(const float *r, int max_order, float lpc[][FLAC_ENC_MAX_LPC_ORDER], float *err)
+{
+    float a[FLAC_ENC_MAX_LPC_ORDER];
+    float e = r[0];
+    for (int i = 0; i < max_order; i++) {
+        float acc = -r[i + 1];
+        for (int j = 0; j < i; j++) {
+            acc -= a[j] * r[i - j];
+        }
+        float k = acc / e;
+        a[i] = k;
+        for (int j = 0; j < (i >> 1); j++) {
+            float t = a[j];
+            a[j] += k * a[i - 1 - j];
+            a[i - 1 - j] += k * t;
+        }
+        if (i & 1) {
+            a[i >> 1] += a[i >> 1] * k;
+        }
+        e *= (1.0f - k * k);
+        // Predictor form: x[n] ~= sum(-a[j] * x[n - j - 1])
+        for (int j = 0; j <= i; j++) {
+            lpc[i][j] = -a[j];
+        }
+        err[i] = e;
+    }
+}
+
+static bool quantize_lpc(const float *lpc, int order, int precision, int32_t *coef, int8_t *shift)
+{
+    float cmax = 0;
+    for (int j = 0; j < order; j++) {
+        float v = fabsf(lpc[j]);
+        if (v > cmax) {
+            cmax = v;
+        }
+    }
+    if (cmax <= 0) {
+        return false;
+    }
+    int log2cmax;
+    frexpf(cmax, &log2cmax);
+    // One bit of precision is used for sign
+    int sh = precision - 1 - log2cmax;
+    if (sh > 15) {
+        sh = 15;
+    } else if (sh < 0) {
+        return false;
+    }
+    int32_t qmax = (1 << (precision - 1)) - 1;
+    int32_t qmin = -(1 << (precision - 1));
+    float err = 0;
+    for (int j = 0; j < order; j++) {
+        // Error feedback keeps the accumulated rounding error small
+        err += lpc[j] * (float)(1 << sh);
+        int32_t q = (int32_t)lrintf(err);
+        q = q > qmax ? qmax : (q < qmin ? qmin : q);
+        err -= (float)q;
+        coef[j] = q;
+    }
+    *shift = (int8_t)sh;
+    return true;
+}
+
+static uint32_t try_predictor(flac_enc_subframe_t *cand, int n, const flac_enc_search_t *search, int32_t *res)
+{
+    flac_enc_calc_residual(cand, n, res);
+    if (residual_in_range(res, cand->order, n) == false) {
+        return FLAC_ENC_BITS_INF;
+    }
+    uint32_t bits = FLAC_ENC_SUBFRAME_HDR_BITS + cand->wasted + cand->order * cand->bps;
+    if (cand->type == FLAC_ENC_SUBFRAME_LPC) {
+        bits += 4 + 5 + cand->order * cand->precision;
+    }
+    return bits + rice_encode_search(res, n, cand->order, search->max_part_order, cand->bps, cand);
+}
+
+static void search_lpc(const flac_enc_search_t *search, int n, flac_enc_work_t *work, flac_enc_subframe_t *sf)
+{
+    const int32_t *x = sf->samples;
+    int max_order = search->max_lpc_order;
+    if (max_order > n / 2) {
+        max_order = n / 2;
+    }
+    if (max_order < 1) {
+        return;
+    }
+    float *w = work->windowed;
+    for (int i = 0; i < n; i++) {
+        w[i] = (float)x[i] * work->window[i];
+    }
+    float r[FLAC_ENC_MAX_LPC_ORDER + 1];
+    for (int l = 0; l <= max_order; l++) {
+        float sum = 0;
+        for (int i = l; i < n; i++) {
+            sum += w[i] * w[i - l];
+        }
+        r[l] = sum;
+    }
+    if (r[0] <= 0) {
+        return;
+    }
+    float lpc[FLAC_ENC_MAX_LPC_ORDER][FLAC_ENC_MAX_LPC_ORDER];
+    float err[FLAC_ENC_MAX_LPC_ORDER];
+    levinson(r, max_order, lpc, err);
+    int precision = get_qlp_precision(n, sf->bps);
+    // Estimate coded size of each order from prediction error, then verify the best candidates
+    float est[FLAC_ENC_MAX_LPC_ORDER];
+    int best_est = 0;
+    for (int o = 0; o < max_order; o++) {
+        float e = err[o] > 1e-9f * r[0] ? err[o] / r[0] : 1e-9f;
+        est[o] = 0.5f * (n - o - 1) * log2f(e) + (o + 1) * (precision + sf->bps);
+        if (est[o] < est[best_est]) {
+            best_est = o;
+        }
+    }
+    int from = 0;
+    int to = max_order - 1;
+    if (search->order_search) {
+        from = best_est - (search->order_search - 1) / 2;
+        from = from < 0 ? 0 : from;
+        to = from + search->order_search - 1;
+        to = to >= max_order ? max_order - 1 : to;
+    }
+    flac_enc_subframe_t cand = *sf;
+    cand.type = FLAC_ENC_SUBFRAME_LPC;
+    cand.precision = (uint8_t)precision;
+    for (int o = from; o <= to; o++) {
+        cand.order = (uint8_t)(o + 1);
+        if (quantize_lpc(lpc[o], o + 1, precision, cand.coef, &cand.shift) == false) {
+            continue;
+        }
+        cand.bits = try_predictor(&cand, n, search, work->residual);
+        if (cand.bits < sf->bits) {
+            *sf = cand;
+        }
+    }
+}
+
+void flac_enc_analyze(const flac_enc_search_t *search, int32_t *smp, int n, int bps, flac_enc_work_t *work,
+                      flac_enc_subframe_t *sf)
+{
+    memset(sf, 0, offsetof(flac_enc_subframe_t, coef));
+    sf->samples = smp;
+    sf->bps = (uint8_t)bps;
+    uint32_t acc = 0;
+    bool constant = true;
+    for (int i = 0; i < n; i++) {
+        acc |= (uint32_t)smp[i];
+        if (smp[i] != smp[0]) {
+            constant = false;
+        }
+    }
+    if (constant) {
+        sf->type = FLAC_ENC_SUBFRAME_CONSTANT;
+        sf->bits = FLAC_ENC_SUBFRAME_HDR_BITS + bps;
+        return;
+    }
+    // Remove trailing zero bits common to all samples
+    int wasted = __builtin_ctz(acc);
+    if (wasted) {
+        for (int i = 0; i < n; i++) {
+            smp[i] >>= wasted;
+        }
+        sf->wasted = (uint8_t)wasted;
+        sf->bps = (uint8_t)(bps - wasted);
+    }
+    sf->type = FLAC_ENC_SUBFRAME_VERBATIM;
+    sf->bits = FLAC_ENC_SUBFRAME_HDR_BITS + sf->wasted + n * sf->bps;
+
+    flac_enc_subframe_t cand = *sf;
+    cand.type = FLAC_ENC_SUBFRAME_FIXED;
+    cand.order = (uint8_t)best_fixed_order(smp, n);
+    cand.bits = try_predictor(&cand, n, search, work->residual);
+    if (cand.bits < sf->bits) {
+        *sf = cand;
+    }
+    if (search->max_lpc_order) {
+        search_lpc(search, n, work, sf);
+    }
+}
@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAC_ENC_MAX_LPC_ORDER   (12)
+#define FLAC_ENC_MAX_FIXED_ORDER (4)
+#define FLAC_ENC_MAX_PART_ORDER  (8)
+#define FLAC_ENC_MAX_QLP_PREC    (15)
+
+/**
+ * @brief  Subframe types in FLAC
+ */
+typedef enum {
+    FLAC_ENC_SUBFRAME_CONSTANT = 0,
+    FLAC_ENC_SUBFRAME_VERBATIM = 1,
+    FLAC_ENC_SUBFRAME_FIXED    = 2,
+    FLAC_ENC_SUBFRAME_LPC      = 3,
+} flac_enc_subframe_type_t;
+
+/**
+ * @brief  Prediction search settings derived from compression level
+ */
+typedef struct {
+    uint8_t max_lpc_order;  /*!< Maximum LPC order, 0 to use fixed predictors only */
+    uint8_t max_part_order; /*!< Maximum Rice partition order */
+    uint8_t order_search;   /*!< Number of LPC orders verified by real residual around estimated one,
+                                 0 means verify all orders */
+} flac_enc_search_t;
+
+/**
+ * @brief  Encoded description of one subframe
+ */
+typedef struct {
+    uint8_t  type;                                     /*!< Subframe type, see `flac_enc_subframe_type_t` */
+    uint8_t  order;                                    /*!< Predictor order */
+    uint8_t  wasted;                                   /*!< Wasted bits per sample */
+    uint8_t  bps;                                      /*!< Bits per sample after removing wasted bits */
+    uint8_t  precision;                                /*!< Quantized LPC coefficient precision */
+    int8_t   shift;                                    /*!< Quantized LPC coefficient shift */
+    uint8_t  part_order;                               /*!< Rice partition order */
+    uint8_t  rice_5bit;                                /*!< Use 5 bits Rice parameter coding method */
+    int32_t  coef[FLAC_ENC_MAX_LPC_ORDER];             /*!< Quantized LPC coefficients */
+    uint8_t  rice_param[1 << FLAC_ENC_MAX_PART_ORDER]; /*!< Rice parameter of each partition */
+    uint32_t bits;                                     /*!< Total bits of this subframe */
+    const int32_t *samples;                            /*!< Samples after removing wasted bits */
+} flac_enc_subframe_t;
+
+/**
+ * @brief  Analysis scratch buffers shared by all channels
+ */
+typedef struct {
+    float   *window;     /*!< Apodization window with block size */
+    float   *windowed;   /*!< Windowed samples */
+    int32_t *residual;   /*!< Residual of current candidate */
+    int      block_size; /*!< Size of the buffers in samples */
+} flac_enc_work_t;
+
+/**
+ * @brief  Fill tukey(0.5) apodization window
+ *
+ * @param[out]  window  Window buffer
+ * @param[in]   n       Window length
+ */
+void flac_enc_init_window(float *window, int n);
+
+/**
+ * @brief  Estimate cost of one channel by fixed second order residual
+ *
+ * @param[in]  smp  Samples
+ * @param[in]  n    Sample count
+ *
+ * @return  Sum of absolute residual
+ */
+uint64_t flac_enc_estimate_cost(const int32_t *smp, int n);
+
+/**
+ * @brief  Find the cheapest subframe for one channel
+ *
+ * @note  Samples may be right shifted in place when wasted bits are detected.
+ *        Only predictor parameters are kept, residual is calculated again by `flac_enc_calc_residual`
+ *        when subframe is written, so that channel candidates do not need their own residual buffer.
+ *
+ * @param[in]      search  Search settings
+ * @param[in,out]  smp     Samples
+ * @param[in]      n       Sample count
+ * @param[in]      bps     Bits per sample of this channel
+ * @param[in]      work    Scratch buffers
+ * @param[out]     sf      Subframe description
+ */
+void flac_enc_analyze(const flac_enc_search_t *search, int32_t *smp, int n, int bps, flac_enc_work_t *work,
+                      flac_enc_subframe_t *sf);
+
+/**
+ * @brief  Calculate residual of fixed or LPC subframe
+ *
+ * @param[in]   sf        Subframe description
+ * @param[in]   n         Sample count
+ * @param[out]  residual  Residual output, first `sf->order` entries are not touched
+ */
+void flac_enc_calc_residual(const flac_enc_subframe_t *sf, int n, int32_t *residual);
+
+#ifdef __cplusplus
+}
+#endif
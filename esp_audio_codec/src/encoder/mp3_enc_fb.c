@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stddef.h>
+#include <math.h>
+#include "esp_audio_dsp.h"
+#include "mp3_enc_priv.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/* Prototype low-pass: Kaiser windowed sinc, cut-off tuned for power complementary crossover at pi/64 */
+#define MP3_ENC_PROTO_BETA   (9.0)
+#define MP3_ENC_PROTO_CUTOFF (1.1315 * M_PI / 64)
+/* Prototype DC gain so that the standard synthesis window (32 * C) reconstructs at unity */
+#define MP3_ENC_PROTO_GAIN   (2.0)
+/* Time domain aliasing cancellation gain of the unscaled 36 points IMDCT */
+#define MP3_ENC_MDCT_GAIN    (9.0)
+
+#define Q30(x) ((int32_t)lrint((x) * 1073741824.0))
+#define Q31(x) ((int32_t)lrint((x) * 2147483647.0))
+
+/* Alias reduction butterfly coefficients cs[i] and ca[i] in Q31 */
+static const int32_t alias_cs[8] = {
+    1841452036, 1893526521, 2039311996, 2111652008, 2137858231, 2145680960, 2147267171, 2147468949,
+};
+static const int32_t alias_ca[8] = {
+    -1104871222, -1013036689, -672972959, -390655622, -203096532, -87972919, -30491194, -7945635,
+};
+
+static double bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++) {
+        double h = x / (2 * k);
+        term *= h * h;
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+void mp3_enc_fb_init(mp3_enc_fb_tab_t *tab)
+{
+    double proto[MP3_ENC_FIFO_SIZE];
+    double sum = 0;
+    double i0_beta = bessel_i0(MP3_ENC_PROTO_BETA);
+    proto[0] = 0;
+    for (int n = 1; n < MP3_ENC_FIFO_SIZE; n++) {
+        int m = n - MP3_ENC_FIFO_SIZE / 2;
+        double r = (double)m / (MP3_ENC_FIFO_SIZE / 2);
+        double w = bessel_i0(MP3_ENC_PROTO_BETA * sqrt(1.0 - r * r)) / i0_beta;
+        double s = (m == 0) ? MP3_ENC_PROTO_CUTOFF / M_PI : sin(MP3_ENC_PROTO_CUTOFF * m) / (M_PI * m);
+        proto[n] = s * w;
+        sum += proto[n];
+    }
+    // C[i] = h[i] * (-1)^(i / 64) folds the modulation period into the window
+    for (int n = 0; n < MP3_ENC_FIFO_SIZE; n++) {
+        double c = proto[n] * MP3_ENC_PROTO_GAIN / sum;
+        tab->win[n] = Q31(((n >> 6) & 1) ? -c : c);
+    }
+    // Symmetric matrixing folded to 32 points: M[k][t] = cos((2k + 1) * t * pi / 64)
+    for (int k = 0; k < MP3_ENC_SUBBAND_NUM; k++) {
+        for (int t = 0; t < 32; t++) {
+            tab->mat[k][t] = Q30(cos((2 * k + 1) * t * M_PI / 64));
+        }
+    }
+    esp_audio_dsp_mdct_gen_kernel(36, NULL, MP3_ENC_MDCT_GAIN, &tab->mdct[0][0]);
+    tab->dsp = esp_audio_dsp_get_ops();
+}
+
+static void polyphase_analysis(const mp3_enc_fb_tab_t *tab, mp3_enc_fb_ch_t *ch, int32_t *sb)
+{
+    int32_t y[64];
+    int32_t z[32];
+    const int16_t *fifo = ch->fifo;
+    int pos = ch->fifo_pos;
+    for (int i = 0; i < 64; i++) {
+        int64_t acc = 0;
+        for (int j = 0; j < 8; j++) {
+            int n = i + (j << 6);
+            acc += (int64_t)tab->win[n] * fifo[(pos + n) & (MP3_ENC_FIFO_SIZE - 1)];
+        }
+        y[i] = (int32_t)((acc + (1 << 15)) >> 16);
+    }
+    z[0] = y[16];
+    for (int t = 1; t <= 16; t++) {
+        z[t] = y[16 + t] + y[16 - t];
+    }
+    for (int t = 17; t < 32; t++) {
+        z[t] = y[16 + t] - y[80 - t];
+    }
+    for (int k = 0; k < MP3_ENC_SUBBAND_NUM; k++) {
+        int64_t acc = tab->dsp->dot(tab->mat[k], z, 32);
+        sb[k] = (int32_t)((acc + ((int64_t)1 << 35)) >> 36);
+    }
+}
+
+void mp3_enc_fb_process(const mp3_enc_fb_tab_t *tab, mp3_enc_fb_ch_t *ch, const int16_t *pcm, int stride, int32_t *xr)
+{
+    int32_t cur[MP3_ENC_SUBBAND_LEN][MP3_ENC_SUBBAND_NUM];
+    for (int t = 0; t < MP3_ENC_SUBBAND_LEN; t++) {
+        ch->fifo_pos = (ch->fifo_pos - 32) & (MP3_ENC_FIFO_SIZE - 1);
+        for (int i = 0; i < 32; i++) {
+            ch->fifo[(ch->fifo_pos + 31 - i) & (MP3_ENC_FIFO_SIZE - 1)] = *pcm;
+            pcm += stride;
+        }
+        polyphase_analysis(tab, ch, cur[t]);
+    }
+    esp_audio_dsp_mdct_t mdct = {
+        .n = 36,
+        .kern = &tab->mdct[0][0],
+    };
+    for (int k = 0; k < MP3_ENC_SUBBAND_NUM; k++) {
+        int32_t z[36];
+        int32_t *prev = ch->prev[k];
+        for (int t = 0; t < MP3_ENC_SUBBAND_LEN; t++) {
+            int32_t v = cur[t][k];
+            // Compensate frequency inversion of odd subbands
+            if ((k & t) & 1) {
+                v = -v;
+            }
+            z[t] = prev[t];
+            z[18 + t] = v;
+            prev[t] = v;
+        }
+        tab->dsp->mdct(&mdct, z, xr + k * MP3_ENC_SUBBAND_LEN);
+    }
+    // Alias reduction butterflies between adjacent subbands
+    for (int k = 1; k < MP3_ENC_SUBBAND_NUM; k++) {
+        int32_t *lo = xr + k * MP3_ENC_SUBBAND_LEN - 1;
+        int32_t *up = xr + k * MP3_ENC_SUBBAND_LEN;
+        for (int i = 0; i < 8; i++) {
+            int64_t a = lo[-i];
+            int64_t b = up[i];
+            lo[-i] = (int32_t)((a * alias_cs[i] + b * alias_ca[i]) >> 31);
+            up[i] = (int32_t)((b * alias_cs[i] - a * alias_ca[i]) >> 31);
+        }
+    }
+}
@@ -0,0 +1,147 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mp3_enc_tab.h"
+#include "esp_audio_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MP3_ENC_GRANULE_SIZE (576)
+#define MP3_ENC_SUBBAND_NUM  (32)
+#define MP3_ENC_SUBBAND_LEN  (18)
+#define MP3_ENC_MAX_CH       (2)
+#define MP3_ENC_MAX_GR       (2)
+#define MP3_ENC_FIFO_SIZE    (512)
+
+/* Spectrum values are kept in Q24, 1.0 equals decoder full scale */
+#define MP3_ENC_XR_FRAC_BITS (24)
+
+/**
+ * @brief  Filter bank state of one channel
+ */
+typedef struct {
+    int16_t fifo[MP3_ENC_FIFO_SIZE];                      /*!< Polyphase input history, ring buffer */
+    int     fifo_pos;                                     /*!< Position of the newest sample inside `fifo` */
+    int32_t prev[MP3_ENC_SUBBAND_NUM][MP3_ENC_SUBBAND_LEN]; /*!< Subband samples of previous granule for MDCT */
+} mp3_enc_fb_ch_t;
+
+/**
+ * @brief  Shared filter bank tables, generated once at open
+ */
+typedef struct {
+    int32_t win[MP3_ENC_FIFO_SIZE];                   /*!< Analysis window C[i] in Q31 */
+    int32_t mat[MP3_ENC_SUBBAND_NUM][32];             /*!< Folded matrixing cosine in Q30 */
+    int32_t mdct[MP3_ENC_SUBBAND_LEN][36];            /*!< Windowed and scaled MDCT kernel in Q30 */
+    const esp_audio_dsp_ops_t *dsp;                 /*!< DSP kernels selected at open */
+} mp3_enc_fb_tab_t;
+
+/**
+ * @brief  Side information of one granule channel
+ */
+typedef struct {
+    uint16_t part2_3_length;
+    uint16_t big_values;
+    uint16_t count1;            /*!< Number of count1 quadruples (not written to stream) */
+    uint8_t  global_gain;
+    uint16_t scalefac_compress;
+    uint8_t  table_select[3];
+    uint8_t  region0_count;
+    uint8_t  region1_count;
+    uint8_t  count1table_select;
+    uint16_t part2_length;      /*!< Scale factor bits */
+    uint8_t  slen[4];           /*!< Scale factor lengths per partition */
+    uint8_t  scalefac[MP3_ENC_SFB_NUM];
+} mp3_enc_gr_info_t;
+
+/**
+ * @brief  Initialize filter bank tables
+ *
+ * @param[out]  tab  Table storage
+ */
+void mp3_enc_fb_init(mp3_enc_fb_tab_t *tab);
+
+/**
+ * @brief  Run polyphase analysis and MDCT for one granule
+ *
+ * @param[in]      tab     Filter bank tables
+ * @param[in,out]  ch      Channel state
+ * @param[in]      pcm     Interleaved 16 bits PCM of current granule
+ * @param[in]      stride  Distance between two samples of this channel
+ * @param[out]     xr      576 spectral lines in Q24
+ */
+void mp3_enc_fb_process(const mp3_enc_fb_tab_t *tab, mp3_enc_fb_ch_t *ch, const int16_t *pcm, int stride, int32_t *xr);
+
+/**
+ * @brief  Granule coding context
+ */
+typedef struct {
+    const uint16_t *sfb;                     /*!< Long block scale factor band boundaries */
+    bool            lsf;                     /*!< MPEG-2 low sampling frequency stream */
+    bool            search_region;           /*!< Search best Huffman region division */
+    uint8_t         max_sf[MP3_ENC_SFB_NUM]; /*!< Upper limit of scale factor for each band, 0 disables scale factor */
+    int16_t         g_req[MP3_ENC_SFB_NUM];  /*!< Gain required by masking threshold of each band */
+    int16_t         margin[MP3_ENC_SFB_NUM]; /*!< log2(energy / threshold) in Q8, INT16_MAX means always coded */
+} mp3_enc_gr_ctx_t;
+
+/**
+ * @brief  Calculate |xr|^(3/4) and square root sum of each band
+ *
+ * @param[in]   xr        576 spectral lines in Q24
+ * @param[in]   sfb       Scale factor band boundaries
+ * @param[out]  x34       |xr|^(3/4) in Q18
+ * @param[out]  sqrt_sum  Sum of |xr|^(1/2) in Q12 for each band, can be NULL
+ *
+ * @return  Maximum value of `x34`
+ */
+uint32_t mp3_enc_pow34(const int32_t *xr, const uint16_t *sfb, uint32_t *x34, uint32_t *sqrt_sum);
+
+/**
+ * @brief  Simple psychoacoustic model, fill `g_req` and `margin` of granule context
+ *
+ * @param[in]      xr        576 spectral lines in Q24
+ * @param[in]      sqrt_sum  Square root sum of each band
+ * @param[in]      ath       Absolute threshold of each band, log2 energy in Q8
+ * @param[in]      smr       Signal to mask ratio, log2 in Q8
+ * @param[in]      spread    Whether apply spreading function between bands
+ * @param[in,out]  ctx       Granule coding context
+ *
+ * @return  Perceptual entropy estimation of this granule
+ */
+int mp3_enc_psy_calc(const int32_t *xr, const uint32_t *sqrt_sum, const int16_t *ath, int smr, bool spread,
+                     mp3_enc_gr_ctx_t *ctx);
+
+/**
+ * @brief  Calculate log2 of unsigned value in Q8
+ */
+int mp3_enc_log2_q8(uint64_t v);
+
+/**
+ * @brief  Quantize and Huffman code one granule channel
+ *
+ * @param[in]   ctx       Granule coding context
+ * @param[in]   xr        Spectral lines, only sign is used
+ * @param[in]   x34       |xr|^(3/4) in Q18
+ * @param[in]   max_bits  Maximum bits of part2 and part3
+ * @param[in]   offset    Noise offset against masking threshold in gain unit, ignored if `search` is true
+ * @param[in]   search    Search the minimum offset which fits into `max_bits`
+ * @param[out]  gi        Side information
+ * @param[out]  ix        Quantized values
+ *
+ * @return  Bits used by part2 and part3
+ */
+int mp3_enc_code_granule(const mp3_enc_gr_ctx_t *ctx, const int32_t *xr, const uint32_t *x34, int max_bits, int offset,
+                         bool search, mp3_enc_gr_info_t *gi, int16_t *ix);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,607 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "mp3_enc_priv.h"
+
+#define MP3_ENC_BITS_INF     (0x7FFFFFF)
+#define MP3_ENC_NO_SF_SFB    (MP3_ENC_SFB_NUM - 1)
+/* Rounding offset of the power law quantizer, 0.5 - 0.0946 in Q16 */
+#define MP3_ENC_QUANT_ROUND  (26568)
+/* log2(27 / 4) in Q8 used by noise estimation */
+#define MP3_ENC_LOG2_27_4    (705)
+/* Huffman family number used by region division search */
+#define MP3_ENC_HUFF_FAMILY_NUM (15)
+
+/* m^(3/4) and m^(1/2) for mantissa m in [1, 2] with step 1/128, Q30 */
+static const uint32_t pow34_mant[129] = {
+    1073741824, 1080027156, 1086300319, 1092561429, 1098810602, 1105047950, 1111273585, 1117487616,
+    1123690150, 1129881292, 1136061147, 1142229817, 1148387402, 1154534000, 1160669710, 1166794628,
+    1172908846, 1179012459, 1185105557, 1191188231, 1197260568, 1203322657, 1209374583, 1215416431,
+    1221448284, 1227470224, 1233482332, 1239484689, 1245477371, 1251460458, 1257434025, 1263398148,
+    1269352900, 1275298356, 1281234586, 1287161662, 1293079655, 1298988633, 1304888665, 1310779818,
+    1316662159, 1322535752, 1328400663, 1334256956, 1340104692, 1345943936, 1351774747, 1357597186,
+    1363411314, 1369217189, 1375014869, 1380804412, 1386585874, 1392359312, 1398124782, 1403882337,
+    1409632032, 1415373920, 1421108054, 1426834486, 1432553268, 1438264449, 1443968082, 1449664214,
+    1455352895, 1461034174, 1466708099, 1472374717, 1478034074, 1483686217, 1489331192, 1494969044,
+    1500599818, 1506223558, 1511840307, 1517450109, 1523053006, 1528649042, 1534238257, 1539820694,
+    1545396392, 1550965392, 1556527736, 1562083461, 1567632607, 1573175214, 1578711319, 1584240960,
+    1589764175, 1595281001, 1600791475, 1606295634, 1611793512, 1617285147, 1622770572, 1628249824,
+    1633722937, 1639189945, 1644650881, 1650105780, 1655554675, 1660997598, 1666434583, 1671865660,
+    1677290864, 1682710224, 1688123773, 1693531540, 1698933558, 1704329857, 1709720466, 1715105416,
+    1720484736, 1725858455, 1731226603, 1736589208, 1741946299, 1747297904, 1752644051, 1757984767,
+    1763320081, 1768650019, 1773974608, 1779293875, 1784607847, 1789916550, 1795220009, 1800518251,
+    1805811301,
+};
+
+static const uint32_t sqrt_mant[129] = {
+    1073741824, 1077927968, 1082097918, 1086251860, 1090389977, 1094512449, 1098619452, 1102711159,
+    1106787739, 1110849359, 1114896182, 1118928370, 1122946079, 1126949464, 1130938678, 1134913870,
+    1138875187, 1142822774, 1146756771, 1150677318, 1154584553, 1158478610, 1162359621, 1166227717,
+    1170083026, 1173925673, 1177755783, 1181573478, 1185378878, 1189172100, 1192953261, 1196722475,
+    1200479854, 1204225510, 1207959552, 1211682086, 1215393219, 1219093055, 1222781696, 1226459243,
+    1230125796, 1233781453, 1237426310, 1241060463, 1244684005, 1248297028, 1251899625, 1255491884,
+    1259073893, 1262645741, 1266207514, 1269759295, 1273301169, 1276833217, 1280355523, 1283868164,
+    1287371222, 1290864773, 1294348895, 1297823663, 1301289153, 1304745438, 1308192592, 1311630686,
+    1315059792, 1318479979, 1321891318, 1325293875, 1328687719, 1332072916, 1335449532, 1338817632,
+    1342177280, 1345528539, 1348871473, 1352206141, 1355532607, 1358850929, 1362161168, 1365463381,
+    1368757628, 1372043966, 1375322451, 1378593139, 1381856086, 1385111346, 1388358974, 1391599023,
+    1394831545, 1398056593, 1401274219, 1404484474, 1407687407, 1410883069, 1414071510, 1417252777,
+    1420426919, 1423593984, 1426754019, 1429907071, 1433053185, 1436192407, 1439324782, 1442450355,
+    1445569171, 1448681271, 1451786701, 1454885502, 1457977717, 1461063388, 1464142555, 1467215261,
+    1470281545, 1473341447, 1476395008, 1479442266, 1482483261, 1485518030, 1488546612, 1491569045,
+    1494585366, 1497595611, 1500599818, 1503598022, 1506590260, 1509576567, 1512556978, 1515531527,
+    1518500250,
+};
+
+/* 2^(k/4), 2^(k/2) and 2^(k/16) in Q30 */
+static const uint32_t pow34_exp[4] = {
+    1073741824, 1276901417, 1518500250, 1805811301,
+};
+
+static const uint32_t sqrt_exp[2] = {
+    1073741824, 1518500250,
+};
+
+static const uint32_t quant_step[16] = {
+    1073741824, 1121280436, 1170923762, 1222764986, 1276901417, 1333434672, 1392470869, 1454120821,
+    1518500250, 1585730000, 1655936265, 1729250827, 1805811301, 1885761398, 1969251188, 2056437387,
+};
+
+/* MPEG-1 scale factor lengths (slen1, slen2) indexed by scalefac_compress */
+static const uint8_t slen_tab[16][2] = {
+    {0, 0}, {0, 1}, {0, 2}, {0, 3}, {3, 0}, {1, 1}, {1, 2}, {1, 3},
+    {2, 1}, {2, 2}, {2, 3}, {3, 1}, {3, 2}, {3, 3}, {4, 2}, {4, 3},
+};
+
+/* MPEG-2 scale factor band number of each partition for long blocks without intensity stereo */
+static const uint8_t lsf_part_sfb[4] = {6, 5, 5, 5};
+
+/* Default region division indexed by band count of big values, {region0_count, region1_count} */
+static const uint8_t region_div_tab[MP3_ENC_SFB_NUM + 1][2] = {
+    {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {0, 1}, {1, 1}, {1, 1},
+    {1, 2}, {2, 2}, {2, 3}, {2, 3}, {3, 4}, {3, 4}, {3, 4}, {4, 5},
+    {4, 5}, {4, 6}, {5, 6}, {5, 6}, {5, 7}, {6, 7}, {6, 7},
+};
+
+/* Tables sharing the same codes are grouped as one family */
+static const uint8_t huff_family_tab[MP3_ENC_HUFF_FAMILY_NUM] = {1, 2, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 15, 16, 24};
+
+static inline int bit_len(uint32_t v)
+{
+    return v ? 32 - __builtin_clz(v) : 0;
+}
+
+static inline uint32_t mant_interp(const uint32_t *tab, uint32_t v, int n)
+{
+    uint32_t f = (n >= 15) ? (v >> (n - 15)) : (v << (15 - n));
+    int idx = (f >> 8) & 0x7F;
+    int r = f & 0xFF;
+    return tab[idx] + (uint32_t)(((uint64_t)(tab[idx + 1] - tab[idx]) * r) >> 8);
+}
+
+int mp3_enc_log2_q8(uint64_t v)
+{
+    if (v == 0) {
+        return -(64 << 8);
+    }
+    int n = 63 - __builtin_clzll(v);
+    uint32_t m = (n >= 8) ? (uint32_t)(v >> (n - 8)) : (uint32_t)(v << (8 - n));
+    int x = m & 0xFF;
+    // log2(1 + x) ~= x + 0.3466 * x * (1 - x)
+    return (n << 8) + x + ((89 * x * (256 - x)) >> 16);
+}
+
+uint32_t mp3_enc_pow34(const int32_t *xr, const uint16_t *sfb, uint32_t *x34, uint32_t *sqrt_sum)
+{
+    uint32_t max34 = 0;
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        uint32_t sum = 0;
+        for (int i = sfb[b]; i < sfb[b + 1]; i++) {
+            uint32_t v = (uint32_t)abs(xr[i]);
+            if (v == 0) {
+                x34[i] = 0;
+                continue;
+            }
+            int n = 31 - __builtin_clz(v);
+            int e3 = 3 * n;
+            uint64_t p = (uint64_t)mant_interp(pow34_mant, v, n) * pow34_exp[e3 & 3];
+            x34[i] = (uint32_t)(p >> (60 - (e3 >> 2)));
+            if (x34[i] > max34) {
+                max34 = x34[i];
+            }
+            if (sqrt_sum) {
+                p = (uint64_t)mant_interp(sqrt_mant, v, n) * sqrt_exp[n & 1];
+                sum += (uint32_t)(p >> (60 - (n >> 1)));
+            }
+        }
+        if (sqrt_sum) {
+            sqrt_sum[b] = sum;
+        }
+    }
+    return max34;
+}
+
+int mp3_enc_psy_calc(const int32_t *xr, const uint32_t *sqrt_sum, const int16_t *ath, int smr, bool spread,
+                     mp3_enc_gr_ctx_t *ctx)
+{
+    uint64_t en[MP3_ENC_SFB_NUM];
+    const uint16_t *sfb = ctx->sfb;
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        uint64_t e = 0;
+        for (int i = sfb[b]; i < sfb[b + 1]; i++) {
+            int32_t v = xr[i] >> 8;
+            e += (int64_t)v * v;
+        }
+        en[b] = e;
+    }
+    int pe = 0;
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        if (en[b] == 0) {
+            ctx->margin[b] = INT16_MIN;
+            ctx->g_req[b] = 255;
+            continue;
+        }
+        uint64_t es = en[b];
+        if (spread) {
+            // Masking spreads stronger towards higher bands
+            if (b > 0) {
+                es += en[b - 1] >> 3;
+            }
+            if (b < MP3_ENC_SFB_NUM - 1) {
+                es += en[b + 1] >> 5;
+            }
+        }
+        int le = mp3_enc_log2_q8(en[b]);
+        int lt = mp3_enc_log2_q8(es) - smr;
+        if (lt < ath[b]) {
+            lt = ath[b];
+        }
+        int margin = le - lt;
+        if (margin > INT16_MAX - 1) {
+            margin = INT16_MAX - 1;
+        } else if (margin < INT16_MIN) {
+            margin = INT16_MIN;
+        }
+        ctx->margin[b] = (int16_t)margin;
+        // Quantization noise ~= 4/27 * 2^(3 * (gain - 210) / 8) * sum(|xr|^(1/2)), solve gain for noise = threshold
+        // Energy is in Q32 and square root sum is in Q12
+        int ls = mp3_enc_log2_q8(sqrt_sum[b]);
+        int g = 210 * 256 + 8 * (MP3_ENC_LOG2_27_4 + lt - ls - (20 << 8)) / 3;
+        g >>= 8;
+        ctx->g_req[b] = (int16_t)(g < 0 ? 0 : (g > 255 ? 255 : g));
+        if (margin > 0) {
+            pe += ((sfb[b + 1] - sfb[b]) * margin) >> 8;
+        }
+    }
+    return pe;
+}
+
+static int quantize(const mp3_enc_gr_ctx_t *ctx, const int32_t *xr, const uint32_t *x34, int gain,
+                    const uint8_t *scalefac, uint32_t zero_mask, int16_t *ix)
+{
+    const uint16_t *sfb = ctx->sfb;
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        int start = sfb[b];
+        int end = sfb[b + 1];
+        if (zero_mask & (1 << b)) {
+            memset(ix + start, 0, (end - start) * sizeof(int16_t));
+            continue;
+        }
+        // ix = (|xr| * 2^(-(gain - 2 * scalefac - 210) / 4))^(3/4) + 0.4054
+        int q = 3 * (210 - gain + 2 * scalefac[b]);
+        uint32_t step = quant_step[q & 15];
+        int sh = 48 - (q >> 4);
+        for (int i = start; i < end; i++) {
+            uint64_t val = (uint64_t)x34[i] * step;
+            uint32_t v;
+            if (sh >= 16) {
+                v = (uint32_t)(((val >> (sh - 16)) + MP3_ENC_QUANT_ROUND) >> 16);
+            } else {
+                if ((val >> sh) > MP3_ENC_MAX_QUANT_VAL) {
+                    return -1;
+                }
+                v = (uint32_t)((val + (((uint64_t)MP3_ENC_QUANT_ROUND << sh) >> 16)) >> sh);
+            }
+            if (v > MP3_ENC_MAX_QUANT_VAL) {
+                return -1;
+            }
+            ix[i] = (int16_t)(xr[i] < 0 ? -(int)v : (int)v);
+        }
+    }
+    return 0;
+}
+
+static int count_table_bits(int table, const int16_t *ix, int start, int end)
+{
+    const mp3_enc_huff_tab_t *tab = &mp3_enc_huff_tab[table];
+    int xlen = tab->xlen;
+    int linbits = tab->linbits;
+    int bits = 0;
+    for (int i = start; i < end; i += 2) {
+        int x = abs(ix[i]);
+        int y = abs(ix[i + 1]);
+        bits += (x != 0) + (y != 0);
+        if (x > 14 && linbits) {
+            x = 15;
+            bits += linbits;
+        }
+        if (y > 14 && linbits) {
+            y = 15;
+            bits += linbits;
+        }
+        bits += tab->len[x * xlen + y];
+    }
+    return bits;
+}
+
+static int choose_table(const int16_t *ix, int start, int end, uint8_t *table)
+{
+    int max = 0;
+    for (int i = start; i < end; i++) {
+        int v = abs(ix[i]);
+        if (v > max) {
+            max = v;
+        }
+    }
+    *table = 0;
+    if (max == 0) {
+        return 0;
+    }
+    int cand[3] = {0};
+    int n = 0;
+    if (max == 1) {
+        cand[n++] = 1;
+    } else if (max == 2) {
+        cand[n++] = 2;
+        cand[n++] = 3;
+    } else if (max == 3) {
+        cand[n++] = 5;
+        cand[n++] = 6;
+    } else if (max <= 5) {
+        cand[n++] = 7;
+        cand[n++] = 8;
+        cand[n++] = 9;
+    } else if (max <= 7) {
+        cand[n++] = 10;
+        cand[n++] = 11;
+        cand[n++] = 12;
+    } else if (max <= 15) {
+        cand[n++] = 13;
+        cand[n++] = 15;
+    } else {
+        int need = bit_len(max - 15);
+        for (int t = 16; t < 24; t++) {
+            if (mp3_enc_huff_tab[t].linbits >= need) {
+                cand[n++] = t;
+                break;
+            }
+        }
+        for (int t = 24; t < 32; t++) {
+            if (mp3_enc_huff_tab[t].linbits >= need) {
+                cand[n++] = t;
+                break;
+            }
+        }
+    }
+    int best = MP3_ENC_BITS_INF;
+    for (int k = 0; k < n; k++) {
+        int bits = count_table_bits(cand[k], ix, start, end);
+        if (bits < best) {
+            best = bits;
+            *table = (uint8_t)cand[k];
+        }
+    }
+    return best;
+}
+
+static int count1_bits(const int16_t *ix, int start, int end, uint8_t *table_sel)
+{
+    int bits_a = 0;
+    int bits_b = 0;
+    for (int i = start; i < end; i += 4) {
+        int idx = 0;
+        int sign = 0;
+        for (int k = 0; k < 4; k++) {
+            int v = abs(ix[i + k]);
+            idx = (idx << 1) | v;
+            sign += v;
+        }
+        bits_a += mp3_enc_count1_len[idx] + sign;
+        bits_b += 4 + sign;
+    }
+    *table_sel = bits_b < bits_a;
+    return *table_sel ? bits_b : bits_a;
+}
+
+static int region_bits(const mp3_enc_gr_ctx_t *ctx, const int16_t *ix, mp3_enc_gr_info_t *gi)
+{
+    int bv_end = gi->big_values * 2;
+    int r1 = ctx->sfb[gi->region0_count + 1];
+    int r2 = ctx->sfb[gi->region0_count + gi->region1_count + 2];
+    if (r1 > bv_end) {
+        r1 = bv_end;
+    }
+    if (r2 > bv_end) {
+        r2 = bv_end;
+    }
+    int bits = choose_table(ix, 0, r1, &gi->table_select[0]);
+    bits += choose_table(ix, r1, r2, &gi->table_select[1]);
+    bits += choose_table(ix, r2, bv_end, &gi->table_select[2]);
+    return bits;
+}
+
+static int count_bits(const mp3_enc_gr_ctx_t *ctx, const int16_t *ix, mp3_enc_gr_info_t *gi)
+{
+    int i = MP3_ENC_GRANULE_SIZE;
+    while (i > 1 && ix[i - 1] == 0 && ix[i - 2] == 0) {
+        i -= 2;
+    }
+    int count1_end = i;
+    while (i > 3 && abs(ix[i - 1]) <= 1 && abs(ix[i - 2]) <= 1 && abs(ix[i - 3]) <= 1 && abs(ix[i - 4]) <= 1) {
+        i -= 4;
+    }
+    gi->count1 = (uint16_t)((count1_end - i) >> 2);
+    gi->big_values = (uint16_t)(i >> 1);
+    int bits = count1_bits(ix, i, count1_end, &gi->count1table_select);
+    int n = 0;
+    while (n < MP3_ENC_SFB_NUM && ctx->sfb[n] < i) {
+        n++;
+    }
+    gi->region0_count = region_div_tab[n][0];
+    gi->region1_count = region_div_tab[n][1];
+    return bits + region_bits(ctx, ix, gi);
+}
+
+static int region_range_bits(const int prefix[][MP3_ENC_SFB_NUM + 1], const int *esc_prefix, const uint16_t *max_val,
+                             int from, int to, uint8_t *table)
+{
+    *table = 0;
+    if (from >= to) {
+        return 0;
+    }
+    int max = 0;
+    for (int b = from; b < to; b++) {
+        if (max_val[b] > max) {
+            max = max_val[b];
+        }
+    }
+    if (max == 0) {
+        return 0;
+    }
+    int best = MP3_ENC_BITS_INF;
+    int esc = esc_prefix[to] - esc_prefix[from];
+    for (int f = 0; f < MP3_ENC_HUFF_FAMILY_NUM; f++) {
+        int t = huff_family_tab[f];
+        int base = prefix[f][to] - prefix[f][from];
+        if (t < 16) {
+            if (max < mp3_enc_huff_tab[t].xlen && base < best) {
+                best = base;
+                *table = (uint8_t)t;
+            }
+            continue;
+        }
+        int need = max > 15 ? bit_len(max - 15) : 0;
+        for (int k = t; k < t + 8; k++) {
+            if (mp3_enc_huff_tab[k].linbits >= need) {
+                int bits = base + esc * mp3_enc_huff_tab[k].linbits;
+                if (bits < best) {
+                    best = bits;
+                    *table = (uint8_t)k;
+                }
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+static int optimize_region(const mp3_enc_gr_ctx_t *ctx, const int16_t *ix, mp3_enc_gr_info_t *gi)
+{
+    int bv_end = gi->big_values * 2;
+    if (bv_end == 0) {
+        return 0;
+    }
+    // Per band bit cost of each Huffman family, accumulated as prefix sums for fast range cost
+    int prefix[MP3_ENC_HUFF_FAMILY_NUM][MP3_ENC_SFB_NUM + 1];
+    int esc_prefix[MP3_ENC_SFB_NUM + 1];
+    uint16_t max_val[MP3_ENC_SFB_NUM];
+    int nb = 0;
+    for (int f = 0; f < MP3_ENC_HUFF_FAMILY_NUM; f++) {
+        prefix[f][0] = 0;
+    }
+    esc_prefix[0] = 0;
+    while (nb < MP3_ENC_SFB_NUM && ctx->sfb[nb] < bv_end) {
+        int start = ctx->sfb[nb];
+        int end = ctx->sfb[nb + 1] < bv_end ? ctx->sfb[nb + 1] : bv_end;
+        int max = 0;
+        int esc = 0;
+        for (int i = start; i < end; i++) {
+            int v = abs(ix[i]);
+            if (v > max) {
+                max = v;
+            }
+            esc += (v > 14);
+        }
+        max_val[nb] = (uint16_t)max;
+        esc_prefix[nb + 1] = esc_prefix[nb] + esc;
+        for (int f = 0; f < MP3_ENC_HUFF_FAMILY_NUM; f++) {
+            int t = huff_family_tab[f];
+            int cost = 0;
+            // Bands exceeding table range are never selected since range maximum is checked before use
+            if (t >= 16 || max < mp3_enc_huff_tab[t].xlen) {
+                // Linbits are added later according to the selected table
+                cost = count_table_bits(t, ix, start, end) - (t >= 16 ? esc * mp3_enc_huff_tab[t].linbits : 0);
+            }
+            prefix[f][nb + 1] = prefix[f][nb] + cost;
+        }
+        nb++;
+    }
+    int best = MP3_ENC_BITS_INF;
+    mp3_enc_gr_info_t tmp = *gi;
+    for (int r0 = 0; r0 < 16; r0++) {
+        int a = r0 + 1 < nb ? r0 + 1 : nb;
+        uint8_t t0;
+        int bits0 = region_range_bits(prefix, esc_prefix, max_val, 0, a, &t0);
+        if (bits0 >= best) {
+            continue;
+        }
+        for (int r1 = 0; r1 < 8 && r0 + r1 + 2 <= MP3_ENC_SFB_NUM; r1++) {
+            int b = r0 + r1 + 2 < nb ? r0 + r1 + 2 : nb;
+            uint8_t t1, t2;
+            int bits = bits0 + region_range_bits(prefix, esc_prefix, max_val, a, b, &t1);
+            if (bits >= best) {
+                continue;
+            }
+            bits += region_range_bits(prefix, esc_prefix, max_val, b, nb, &t2);
+            if (bits < best) {
+                best = bits;
+                tmp.region0_count = (uint8_t)r0;
+                tmp.region1_count = (uint8_t)r1;
+                tmp.table_select[0] = t0;
+                tmp.table_select[1] = t1;
+                tmp.table_select[2] = t2;
+            }
+            if (b == nb) {
+                break;
+            }
+        }
+        if (a == nb) {
+            break;
+        }
+    }
+    *gi = tmp;
+    return best;
+}
+
+static int scalefac_bits(const mp3_enc_gr_ctx_t *ctx, mp3_enc_gr_info_t *gi)
+{
+    const uint8_t *sf = gi->scalefac;
+    if (ctx->lsf == false) {
+        int max1 = 0, max2 = 0;
+        for (int b = 0; b < 11; b++) {
+            max1 |= sf[b];
+        }
+        for (int b = 11; b < MP3_ENC_NO_SF_SFB; b++) {
+            max2 |= sf[b];
+        }
+        int need1 = bit_len(max1);
+        int need2 = bit_len(max2);
+        int best = MP3_ENC_BITS_INF;
+        for (int i = 0; i < 16; i++) {
+            if (slen_tab[i][0] >= need1 && slen_tab[i][1] >= need2) {
+                int bits = 11 * slen_tab[i][0] + 10 * slen_tab[i][1];
+                if (bits < best) {
+                    best = bits;
+                    gi->scalefac_compress = (uint16_t)i;
+                }
+            }
+        }
+        gi->slen[0] = slen_tab[gi->scalefac_compress][0];
+        gi->slen[1] = slen_tab[gi->scalefac_compress][1];
+        return best;
+    }
+    int b = 0;
+    int bits = 0;
+    for (int p = 0; p < 4; p++) {
+        int max = 0;
+        for (int k = 0; k < lsf_part_sfb[p]; k++, b++) {
+            max |= sf[b];
+        }
+        gi->slen[p] = (uint8_t)bit_len(max);
+        bits += gi->slen[p] * lsf_part_sfb[p];
+    }
+    gi->scalefac_compress = (uint16_t)((((gi->slen[0] * 5) + gi->slen[1]) << 4) + (gi->slen[2] << 2) + gi->slen[3]);
+    return bits;
+}
+
+static int try_offset(const mp3_enc_gr_ctx_t *ctx, const int32_t *xr, const uint32_t *x34, int offset,
+                      mp3_enc_gr_info_t *gi, int16_t *ix)
+{
+    // Bands whose energy is below the shifted threshold are masked and coded as zero
+    int skip_margin = 96 * offset;
+    uint32_t zero_mask = 0;
+    int gain = 255;
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        if (ctx->margin[b] != INT16_MAX && ctx->margin[b] <= skip_margin) {
+            zero_mask |= (1 << b);
+            continue;
+        }
+        int lim = ctx->g_req[b] + offset + 2 * ctx->max_sf[b];
+        if (lim < gain) {
+            gain = lim;
+        }
+    }
+    if (gain < 0) {
+        gain = 0;
+    }
+    for (int b = 0; b < MP3_ENC_SFB_NUM; b++) {
+        int sf = 0;
+        if ((zero_mask & (1 << b)) == 0) {
+            sf = (gain - ctx->g_req[b] - offset + 1) >> 1;
+            sf = sf < 0 ? 0 : (sf > ctx->max_sf[b] ? ctx->max_sf[b] : sf);
+        }
+        gi->scalefac[b] = (uint8_t)sf;
+    }
+    gi->global_gain = (uint8_t)gain;
+    if (quantize(ctx, xr, x34, gain, gi->scalefac, zero_mask, ix) != 0) {
+        return MP3_ENC_BITS_INF;
+    }
+    gi->part2_length = (uint16_t)scalefac_bits(ctx, gi);
+    return gi->part2_length + count_bits(ctx, ix, gi);
+}
+
+int mp3_enc_code_granule(const mp3_enc_gr_ctx_t *ctx, const int32_t *xr, const uint32_t *x34, int max_bits, int offset,
+                         bool search, mp3_enc_gr_info_t *gi, int16_t *ix)
+{
+    int bits = MP3_ENC_BITS_INF;
+    if (search == false) {
+        bits = try_offset(ctx, xr, x34, offset, gi, ix);
+    }
+    if (bits > max_bits) {
+        // Binary search the smallest noise offset which fits into bit budget, offset 256 always produces silence
+        int lo = search ? -256 : offset;
+        int hi = 256;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) >> 1;
+            if (try_offset(ctx, xr, x34, mid, gi, ix) <= max_bits) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        bits = try_offset(ctx, xr, x34, hi, gi, ix);
+    }
+    if (ctx->search_region) {
+        int part3 = optimize_region(ctx, ix, gi);
+        int bv_end = gi->big_values * 2;
+        bits = gi->part2_length + part3 + count1_bits(ix, bv_end, bv_end + gi->count1 * 4, &gi->count1table_select);
+    }
+    gi->part2_3_length = (uint16_t)bits;
+    return bits;
+}
@@ -0,0 +1,55 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MP3_ENC_SFB_NUM       (22)
+#define MP3_ENC_HUFF_TAB_NUM  (32)
+#define MP3_ENC_MAX_QUANT_VAL (8206)
+
+/**
+ * @brief  Huffman table description for big values region
+ *
+ * @note  Codes are stored row-major with index `x * ylen + y`
+ *        Tables 16-23 and 24-31 share codes and only differ in linbits
+ */
+typedef struct {
+    uint8_t         xlen;    /*!< Table dimension, values greater than `xlen - 1` need escape */
+    uint8_t         linbits; /*!< Escape bits for value 15 in tables 16-31 */
+    const uint16_t *code;    /*!< Huffman codes, NULL for unused tables */
+    const uint8_t  *len;     /*!< Huffman code lengths */
+} mp3_enc_huff_tab_t;
+
+extern const mp3_enc_huff_tab_t mp3_enc_huff_tab[MP3_ENC_HUFF_TAB_NUM];
+
+/**
+ * @brief  Count1 region quadruple table A, index `v * 8 + w * 4 + x * 2 + y`
+ *         Table B uses fixed 4 bits code `15 - index`
+ */
+extern const uint8_t mp3_enc_count1_code[16];
+extern const uint8_t mp3_enc_count1_len[16];
+
+/**
+ * @brief  Long block scale factor band boundaries
+ *         Order: 44100, 48000, 32000, 22050, 24000, 16000
+ */
+extern const uint16_t mp3_enc_sfb_long[6][MP3_ENC_SFB_NUM + 1];
+
+/**
+ * @brief  Layer III bitrate table in kbps, first row for MPEG-1 and second row for MPEG-2 LSF
+ */
+extern const uint16_t mp3_enc_bitrate_tab[2][15];
+
+#ifdef __cplusplus
+}
+#endif
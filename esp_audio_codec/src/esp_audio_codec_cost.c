@@ -0,0 +1,311 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "esp_idf_version.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_audio_codec_cost.h"
+#include "esp_audio_enc_reg.h"
+#include "esp_audio_dec_reg.h"
+
+#define TAG "AUD_COST"
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define GET_CYCLE_COUNT() esp_cpu_get_cycle_count()
+#else
+#define GET_CYCLE_COUNT() esp_cpu_get_ccount()
+#endif  /* ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0) */
+
+#define ENC ESP_AUDIO_CODEC_DIR_ENC
+#define DEC ESP_AUDIO_CODEC_DIR_DEC
+
+/**
+ * Built-in figures converted from Performance table in README (ESP32-S3 at 240 MHz)
+ * cycles_per_frame = cpu_loading * 240 MHz * frame_samples / sample_rate / channel
+ */
+static const esp_audio_codec_cost_t builtin_cost[] = {
+    {ENC, ESP_AUDIO_TYPE_AAC,   48000, 2, 1024, 330240,  52634, 0, 2048, 118000, 320000},
+    {ENC, ESP_AUDIO_TYPE_G711A, 8000,  1, 160,  15360,   61,    0, 160,  64000,  64000},
+    {ENC, ESP_AUDIO_TYPE_G711U, 8000,  1, 160,  15840,   61,    0, 160,  64000,  64000},
+    {ENC, ESP_AUDIO_TYPE_AMRNB, 8000,  1, 160,  854880,  3379,  0, 200,  4750,   12200},
+    {ENC, ESP_AUDIO_TYPE_AMRWB, 16000, 1, 320,  1809120, 5734,  0, 400,  6600,   23850},
+    {ENC, ESP_AUDIO_TYPE_ADPCM, 48000, 2, 505,  33961,   10,    0, 505,  384000, 384000},
+    {ENC, ESP_AUDIO_TYPE_OPUS,  48000, 2, 960,  597600,  30106, 0, 1272, 6000,   510000},
+    {ENC, ESP_AUDIO_TYPE_SBC,   48000, 2, 128,  30560,   1894,  0, 201,  32000,  345000},
+    {ENC, ESP_AUDIO_TYPE_LC3,   48000, 2, 480,  558840,  3758,  0, 600,  33600,  638400},
+    {ENC, ESP_AUDIO_TYPE_G722,  16000, 1, 320,  467520,  21299, 0, 342,  48000,  64000},
+    {DEC, ESP_AUDIO_TYPE_AAC,   48000, 2, 1024, 172800,  52429, 0, 1024, 0,      0},
+    {DEC, ESP_AUDIO_TYPE_G711A, 8000,  1, 160,  6720,    41,    0, 160,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_G711U, 8000,  1, 160,  6240,    41,    0, 160,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_AMRNB, 8000,  1, 160,  203040,  1843,  0, 160,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_AMRWB, 16000, 1, 320,  456000,  5530,  0, 320,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_ADPCM, 48000, 2, 505,  30679,   113,   0, 505,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_OPUS,  48000, 2, 960,  140640,  27238, 0, 960,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_MP3,   44100, 2, 1152, 256110,  28672, 0, 1152, 0,      0},
+    {DEC, ESP_AUDIO_TYPE_FLAC,  44100, 2, 4096, 891429,  91546, 0, 4096, 0,      0},
+    {DEC, ESP_AUDIO_TYPE_SBC,   48000, 2, 128,  26048,   215,   0, 128,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_LC3,   48000, 2, 480,  210000,  1393,  0, 480,  0,      0},
+    {DEC, ESP_AUDIO_TYPE_G722,  16000, 1, 320,  442080,  563,   0, 320,  0,      0},
+};
+
+static esp_audio_codec_cost_t *published_cost;
+static int                     published_num;
+
+static inline bool cost_key_match(const esp_audio_codec_cost_t *cost, esp_audio_codec_dir_t dir, esp_audio_type_t type,
+                                  uint32_t sample_rate, uint8_t channel)
+{
+    return cost->dir == dir && cost->type == type && cost->sample_rate == sample_rate && cost->channel == channel;
+}
+
+static esp_audio_codec_cost_t *find_published(esp_audio_codec_dir_t dir, esp_audio_type_t type, uint32_t sample_rate,
+                                              uint8_t channel)
+{
+    for (int i = 0; i < published_num; i++) {
+        if (cost_key_match(&published_cost[i], dir, type, sample_rate, channel)) {
+            return &published_cost[i];
+        }
+    }
+    return NULL;
+}
+
+static const esp_audio_codec_cost_t *find_cost(esp_audio_codec_dir_t dir, esp_audio_type_t type, uint32_t sample_rate,
+                                               uint8_t channel)
+{
+    const esp_audio_codec_cost_t *cost = find_published(dir, type, sample_rate, channel);
+    if (cost) {
+        return cost;
+    }
+    for (int i = 0; i < (int)(sizeof(builtin_cost) / sizeof(builtin_cost[0])); i++) {
+        if (cost_key_match(&builtin_cost[i], dir, type, sample_rate, channel)) {
+            return &builtin_cost[i];
+        }
+    }
+    return NULL;
+}
+
+static bool is_registered(esp_audio_codec_dir_t dir, esp_audio_type_t type)
+{
+    if (dir == ESP_AUDIO_CODEC_DIR_ENC) {
+        return esp_audio_enc_get_ops(type) != NULL;
+    }
+    return esp_audio_dec_get_ops(type) != NULL;
+}
+
+static bool check_candidate(const esp_audio_codec_cost_t *cost, esp_audio_codec_dir_t dir,
+                            esp_audio_codec_select_req_t *req, esp_audio_codec_select_res_t *res)
+{
+    if (cost->dir != dir || cost->channel != req->channel || cost->sample_rate < req->min_sample_rate ||
+        cost->frame_samples == 0 || is_registered(dir, cost->type) == false) {
+        return false;
+    }
+    if (req->max_bitrate && cost->min_bitrate > req->max_bitrate) {
+        return false;
+    }
+    if (req->max_ram_size && cost->ram_size > req->max_ram_size) {
+        return false;
+    }
+    uint64_t cycles = (uint64_t)cost->cycles_per_frame * cost->channel * cost->sample_rate / cost->frame_samples;
+    uint32_t delay_ms = (uint32_t)(((uint64_t)cost->delay_samples * 1000 + cost->sample_rate - 1) / cost->sample_rate);
+    if ((req->max_cycles && cycles > req->max_cycles) || (req->max_delay_ms && delay_ms > req->max_delay_ms)) {
+        return false;
+    }
+    res->cost = *cost;
+    res->cycles = cycles > UINT32_MAX ? UINT32_MAX : (uint32_t)cycles;
+    res->delay_ms = delay_ms;
+    res->bitrate = cost->max_bitrate;
+    if (req->max_bitrate && res->bitrate > req->max_bitrate) {
+        res->bitrate = req->max_bitrate;
+    }
+    return true;
+}
+
+static bool is_cheaper(esp_audio_codec_select_res_t *a, esp_audio_codec_select_res_t *b)
+{
+    if (a->cycles != b->cycles) {
+        return a->cycles < b->cycles;
+    }
+    uint32_t a_mem = a->cost.ram_size + a->cost.psram_size;
+    uint32_t b_mem = b->cost.ram_size + b->cost.psram_size;
+    if (a_mem != b_mem) {
+        return a_mem < b_mem;
+    }
+    return a->bitrate > b->bitrate;
+}
+
+esp_audio_err_t esp_audio_codec_cost_publish(const esp_audio_codec_cost_t *cost)
+{
+    if (cost == NULL || cost->sample_rate == 0 || cost->channel == 0 || cost->frame_samples == 0) {
+        ESP_LOGE(TAG, "Invalid parameter for cost %p", cost);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_audio_codec_cost_t *exist = find_published(cost->dir, cost->type, cost->sample_rate, cost->channel);
+    if (exist) {
+        *exist = *cost;
+        return ESP_AUDIO_ERR_OK;
+    }
+    esp_audio_codec_cost_t *new_cost = realloc(published_cost, (published_num + 1) * sizeof(esp_audio_codec_cost_t));
+    if (new_cost == NULL) {
+        ESP_LOGE(TAG, "No memory for cost figures");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    published_cost = new_cost;
+    published_cost[published_num++] = *cost;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_codec_cost_get(esp_audio_codec_dir_t dir, esp_audio_type_t type, uint32_t sample_rate,
+                                         uint8_t channel, esp_audio_codec_cost_t *cost)
+{
+    if (cost == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    const esp_audio_codec_cost_t *found = find_cost(dir, type, sample_rate, channel);
+    if (found == NULL) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    *cost = *found;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_codec_cost_measure_enc(esp_audio_enc_config_t *cfg, int frames, esp_audio_codec_cost_t *cost)
+{
+    if (cfg == NULL || frames <= 0 || cost == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p frames:%d cost:%p", cfg, frames, cost);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_audio_enc_frame_info_t frame_info = {0};
+    esp_audio_err_t ret = esp_audio_enc_get_frame_info_by_cfg(cfg, &frame_info);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to get frame info ret %d", ret);
+        return ret;
+    }
+    uint8_t *in_buf = malloc(frame_info.in_frame_size);
+    uint8_t *out_buf = malloc(frame_info.out_frame_size);
+    esp_audio_enc_handle_t encoder = NULL;
+    do {
+        if (in_buf == NULL || out_buf == NULL) {
+            ESP_LOGE(TAG, "No memory for measure buffer");
+            ret = ESP_AUDIO_ERR_MEM_LACK;
+            break;
+        }
+        // Noise like input to avoid silence shortcut inside encoder
+        uint32_t seed = 0x12345678;
+        for (int i = 0; i < frame_info.in_frame_size; i++) {
+            seed = seed * 1664525 + 1013904223;
+            in_buf[i] = (uint8_t)(seed >> 24);
+        }
+        size_t ram_free = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+        size_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+        ret = esp_audio_enc_open(cfg, &encoder);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to open encoder ret %d", ret);
+            break;
+        }
+        size_t ram_now = heap_caps_get_free_size(MALLOC_CAP_INTERNAL);
+        size_t psram_now = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+        esp_audio_enc_info_t info = {0};
+        ret = esp_audio_enc_get_info(encoder, &info);
+        if (ret != ESP_AUDIO_ERR_OK || info.channel == 0 || info.bits_per_sample < 8) {
+            ESP_LOGE(TAG, "Fail to get encoder info ret %d", ret);
+            ret = ESP_AUDIO_ERR_FAIL;
+            break;
+        }
+        uint64_t total_cycles = 0;
+        for (int i = 0; i < frames; i++) {
+            esp_audio_enc_in_frame_t in_frame = {
+                .buffer = in_buf,
+                .len = frame_info.in_frame_size,
+            };
+            esp_audio_enc_out_frame_t out_frame = {
+                .buffer = out_buf,
+                .len = frame_info.out_frame_size,
+            };
+            uint32_t start = GET_CYCLE_COUNT();
+            ret = esp_audio_enc_process(encoder, &in_frame, &out_frame);
+            total_cycles += (uint32_t)(GET_CYCLE_COUNT() - start);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                ESP_LOGE(TAG, "Fail to encode ret %d", ret);
+                break;
+            }
+        }
+        if (ret != ESP_AUDIO_ERR_OK) {
+            break;
+        }
+        memset(cost, 0, sizeof(esp_audio_codec_cost_t));
+        const esp_audio_codec_cost_t *exist = find_cost(ESP_AUDIO_CODEC_DIR_ENC, cfg->type, info.sample_rate,
+                                                        info.channel);
+        if (exist) {
+            *cost = *exist;
+        }
+        cost->dir = ESP_AUDIO_CODEC_DIR_ENC;
+        cost->type = cfg->type;
+        cost->sample_rate = info.sample_rate;
+        cost->channel = info.channel;
+        cost->frame_samples = frame_info.in_frame_size / (info.channel * (info.bits_per_sample >> 3));
+        cost->cycles_per_frame = (uint32_t)(total_cycles / frames / info.channel);
+        cost->ram_size = ram_free > ram_now ? ram_free - ram_now : 0;
+        cost->psram_size = psram_free > psram_now ? psram_free - psram_now : 0;
+        if (exist == NULL) {
+            cost->delay_samples = cost->frame_samples;
+            cost->min_bitrate = info.bitrate;
+            cost->max_bitrate = info.bitrate;
+        }
+    } while (0);
+    if (encoder) {
+        esp_audio_enc_close(encoder);
+    }
+    if (in_buf) {
+        free(in_buf);
+    }
+    if (out_buf) {
+        free(out_buf);
+    }
+    return ret;
+}
+
+esp_audio_err_t esp_audio_codec_cost_select(esp_audio_codec_dir_t dir, esp_audio_codec_select_req_t *req,
+                                            esp_audio_codec_select_res_t *res)
+{
+    if (req == NULL || res == NULL || req->channel == 0) {
+        ESP_LOGE(TAG, "Invalid parameter req:%p res:%p", req, res);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_audio_codec_select_res_t cur;
+    bool found = false;
+    for (int i = 0; i < published_num; i++) {
+        if (check_candidate(&published_cost[i], dir, req, &cur) && (found == false || is_cheaper(&cur, res))) {
+            *res = cur;
+            found = true;
+        }
+    }
+    for (int i = 0; i < (int)(sizeof(builtin_cost) / sizeof(builtin_cost[0])); i++) {
+        const esp_audio_codec_cost_t *cost = &builtin_cost[i];
+        // Skip built-in figures overridden by published ones
+        if (find_published(cost->dir, cost->type, cost->sample_rate, cost->channel)) {
+            continue;
+        }
+        if (check_candidate(cost, dir, req, &cur) && (found == false || is_cheaper(&cur, res))) {
+            *res = cur;
+            found = true;
+        }
+    }
+    return found ? ESP_AUDIO_ERR_OK : ESP_AUDIO_ERR_NOT_FOUND;
+}
+
+void esp_audio_codec_cost_clear(void)
+{
+    if (published_cost) {
+        free(published_cost);
+        published_cost = NULL;
+    }
+    published_num = 0;
+}
@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include "latm_mux.h"
+
+#define LATM_LOAS_SYNC_WORD (0x2B7)
+#define AAC_AOT_ESCAPE      (31)
+#define AAC_AOT_SBR         (5)
+#define AAC_AOT_PS          (29)
+
+static const uint32_t latm_sample_rates[] = {
+    96000, 88200, 64000, 48000, 44100, 32000, 24000, 22050, 16000, 12000, 11025, 8000, 7350,
+};
+
+static uint32_t latm_get_bits(latm_bits_t *bits, uint8_t n)
+{
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint32_t byte_pos = bits->pos >> 3;
+        v <<= 1;
+        if (byte_pos < bits->size) {
+            v |= (bits->data[byte_pos] >> (7 - (bits->pos & 7))) & 1;
+        }
+        // Keep counting after end so that overrun can be checked once
+        bits->pos++;
+    }
+    return v;
+}
+
+static inline bool latm_bits_overrun(latm_bits_t *bits)
+{
+    return bits->pos > bits->size * 8;
+}
+
+static uint32_t latm_get_value(latm_bits_t *bits)
+{
+    uint8_t bytes = latm_get_bits(bits, 2);
+    uint32_t v = 0;
+    for (uint8_t i = 0; i <= bytes; i++) {
+        v = (v << 8) | latm_get_bits(bits, 8);
+    }
+    return v;
+}
+
+static uint8_t latm_get_object_type(latm_bits_t *bits)
+{
+    uint8_t aot = latm_get_bits(bits, 5);
+    if (aot == AAC_AOT_ESCAPE) {
+        aot = 32 + latm_get_bits(bits, 6);
+    }
+    return aot;
+}
+
+static uint32_t latm_get_sample_rate(latm_bits_t *bits)
+{
+    uint8_t idx = latm_get_bits(bits, 4);
+    if (idx == 0xF) {
+        return latm_get_bits(bits, 24);
+    }
+    if (idx < sizeof(latm_sample_rates) / sizeof(latm_sample_rates[0])) {
+        return latm_sample_rates[idx];
+    }
+    return 0;
+}
+
+static bool latm_is_ga_object(uint8_t aot)
+{
+    switch (aot) {
+        case 1: case 2: case 3: case 4: case 6: case 7:
+        case 17: case 19: case 20: case 21: case 22: case 23:
+            return true;
+        default:
+            return false;
+    }
+}
+
+esp_audio_err_t latm_parse_asc(latm_bits_t *bits, latm_mux_cfg_t *cfg)
+{
+    uint8_t aot = latm_get_object_type(bits);
+    cfg->sample_rate = latm_get_sample_rate(bits);
+    uint8_t channel_cfg = latm_get_bits(bits, 4);
+    cfg->ext_sample_rate = 0;
+    if (aot == AAC_AOT_SBR || aot == AAC_AOT_PS) {
+        // Explicit hierarchical SBR signaling
+        cfg->ext_sample_rate = latm_get_sample_rate(bits);
+        aot = latm_get_object_type(bits);
+    }
+    if (latm_is_ga_object(aot) == false) {
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    // GASpecificConfig
+    cfg->frame_960 = latm_get_bits(bits, 1);
+    if (latm_get_bits(bits, 1)) {
+        // coreCoderDelay
+        latm_get_bits(bits, 14);
+    }
+    uint8_t ext_flag = latm_get_bits(bits, 1);
+    if (channel_cfg == 0 || channel_cfg > 7) {
+        // Program config element not supported
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    if (aot == 6 || aot == 20) {
+        // layerNr
+        latm_get_bits(bits, 3);
+    }
+    if (ext_flag) {
+        if (aot == 22) {
+            latm_get_bits(bits, 16);
+        }
+        if (aot == 17 || aot == 19 || aot == 20 || aot == 23) {
+            latm_get_bits(bits, 3);
+        }
+        // extensionFlag3
+        latm_get_bits(bits, 1);
+    }
+    if (aot >= 17 && aot <= 27) {
+        uint8_t ep_config = latm_get_bits(bits, 2);
+        if (ep_config >= 2) {
+            return ESP_AUDIO_ERR_NOT_SUPPORT;
+        }
+    }
+    if (cfg->sample_rate == 0) {
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    cfg->object_type = aot;
+    cfg->channel = (channel_cfg == 7) ? 8 : channel_cfg;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t latm_parse_stream_mux_config(latm_bits_t *bits, latm_mux_cfg_t *cfg)
+{
+    cfg->valid = false;
+    cfg->audio_mux_version = latm_get_bits(bits, 1);
+    if (cfg->audio_mux_version && latm_get_bits(bits, 1)) {
+        // audioMuxVersionA is reserved for future use
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    if (cfg->audio_mux_version) {
+        // taraBufferFullness
+        latm_get_value(bits);
+    }
+    uint8_t same_time_framing = latm_get_bits(bits, 1);
+    cfg->sub_frames = latm_get_bits(bits, 6) + 1;
+    uint8_t num_program = latm_get_bits(bits, 4);
+    uint8_t num_layer = latm_get_bits(bits, 3);
+    if (same_time_framing == 0 || num_program != 0 || num_layer != 0) {
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    esp_audio_err_t ret;
+    if (cfg->audio_mux_version == 0) {
+        ret = latm_parse_asc(bits, cfg);
+    } else {
+        uint32_t asc_len = latm_get_value(bits);
+        uint32_t asc_start = bits->pos;
+        ret = latm_parse_asc(bits, cfg);
+        uint32_t used = bits->pos - asc_start;
+        if (ret == ESP_AUDIO_ERR_OK && used > asc_len) {
+            return ESP_AUDIO_ERR_HEADER_PARSE;
+        }
+        // Skip fill bits and possible sync extension
+        bits->pos = asc_start + asc_len;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    uint8_t frame_length_type = latm_get_bits(bits, 3);
+    if (frame_length_type != 0) {
+        // Fixed length and CELP/HVXC framing are not used for AAC broadcast
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    // latmBufferFullness
+    latm_get_bits(bits, 8);
+    cfg->other_data_bits = 0;
+    if (latm_get_bits(bits, 1)) {
+        if (cfg->audio_mux_version) {
+            cfg->other_data_bits = latm_get_value(bits);
+        } else {
+            uint8_t esc;
+            do {
+                esc = latm_get_bits(bits, 1);
+                cfg->other_data_bits = (cfg->other_data_bits << 8) + latm_get_bits(bits, 8);
+            } while (esc && latm_bits_overrun(bits) == false);
+        }
+    }
+    if (latm_get_bits(bits, 1)) {
+        // crcCheckSum
+        latm_get_bits(bits, 8);
+    }
+    if (latm_bits_overrun(bits)) {
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    cfg->valid = true;
+    return ESP_AUDIO_ERR_OK;
+}
+
+uint32_t latm_loas_frame_size(const uint8_t *data, uint32_t size)
+{
+    if (size < LATM_LOAS_HEAD_SIZE) {
+        return 0;
+    }
+    if (((data[0] << 3) | (data[1] >> 5)) != LATM_LOAS_SYNC_WORD) {
+        return 0;
+    }
+    return LATM_LOAS_HEAD_SIZE + (((data[1] & 0x1F) << 8) | data[2]);
+}
+
+esp_audio_err_t latm_parse_mux_element(latm_bits_t *bits, latm_mux_cfg_t *cfg)
+{
+    uint8_t use_same_mux = latm_get_bits(bits, 1);
+    if (use_same_mux == 0) {
+        return latm_parse_stream_mux_config(bits, cfg);
+    }
+    return cfg->valid ? ESP_AUDIO_ERR_OK : ESP_AUDIO_ERR_NOT_FOUND;
+}
+
+uint32_t latm_read_payload_len(latm_bits_t *bits)
+{
+    uint32_t len = 0;
+    uint8_t tmp;
+    do {
+        tmp = latm_get_bits(bits, 8);
+        len += tmp;
+    } while (tmp == 255 && latm_bits_overrun(bits) == false);
+    return latm_bits_overrun(bits) ? 0 : len;
+}
+
+void latm_skip_other_data(latm_bits_t *bits, latm_mux_cfg_t *cfg)
+{
+    bits->pos += cfg->other_data_bits;
+    bits->pos = (bits->pos + 7) & ~7;
+}
+
+uint32_t latm_get_frame_samples(latm_mux_cfg_t *cfg)
+{
+    uint32_t samples = cfg->frame_960 ? 960 : 1024;
+    if (cfg->ext_sample_rate > cfg->sample_rate) {
+        samples <<= 1;
+    }
+    return samples;
+}
+
+int latm_read_payload(latm_bits_t *bits, uint8_t *dst, uint32_t size)
+{
+    if (bits->pos + size * 8 > bits->size * 8) {
+        return -1;
+    }
+    uint8_t shift = bits->pos & 7;
+    const uint8_t *src = bits->data + (bits->pos >> 3);
+    if (shift == 0) {
+        memcpy(dst, src, size);
+    } else {
+        // Payload follows PayloadLengthInfo directly so it is rarely byte aligned
+        uint32_t remain = bits->size - (bits->pos >> 3);
+        for (uint32_t i = 0; i < size; i++) {
+            uint8_t next = (i + 1 < remain) ? src[i + 1] : 0;
+            dst[i] = (uint8_t)((src[i] << shift) | (next >> (8 - shift)));
+        }
+    }
+    bits->pos += size * 8;
+    return 0;
+}
+
+static void latm_put_bits(uint8_t *buf, uint32_t *pos, uint32_t v, uint8_t n)
+{
+    for (int i = n - 1; i >= 0; i--) {
+        uint32_t byte_pos = *pos >> 3;
+        uint8_t shift = 7 - (*pos & 7);
+        if (shift == 7) {
+            buf[byte_pos] = 0;
+        }
+        buf[byte_pos] |= ((v >> i) & 1) << shift;
+        (*pos)++;
+    }
+}
+
+static void latm_put_sample_rate(uint8_t *buf, uint32_t *pos, uint32_t sample_rate)
+{
+    for (uint8_t i = 0; i < sizeof(latm_sample_rates) / sizeof(latm_sample_rates[0]); i++) {
+        if (latm_sample_rates[i] == sample_rate) {
+            latm_put_bits(buf, pos, i, 4);
+            return;
+        }
+    }
+    latm_put_bits(buf, pos, 0xF, 4);
+    latm_put_bits(buf, pos, sample_rate, 24);
+}
+
+static void latm_put_object_type(uint8_t *buf, uint32_t *pos, uint8_t aot)
+{
+    if (aot >= 32) {
+        latm_put_bits(buf, pos, AAC_AOT_ESCAPE, 5);
+        latm_put_bits(buf, pos, aot - 32, 6);
+    } else {
+        latm_put_bits(buf, pos, aot, 5);
+    }
+}
+
+uint32_t latm_write_asc(latm_mux_cfg_t *cfg, uint8_t *buf, uint32_t pos)
+{
+    uint8_t channel_cfg = (cfg->channel == 8) ? 7 : cfg->channel;
+    if (cfg->ext_sample_rate) {
+        latm_put_object_type(buf, &pos, AAC_AOT_SBR);
+        latm_put_sample_rate(buf, &pos, cfg->sample_rate);
+        latm_put_bits(buf, &pos, channel_cfg, 4);
+        latm_put_sample_rate(buf, &pos, cfg->ext_sample_rate);
+    } else {
+        latm_put_object_type(buf, &pos, cfg->object_type);
+        latm_put_sample_rate(buf, &pos, cfg->sample_rate);
+        latm_put_bits(buf, &pos, channel_cfg, 4);
+    }
+    if (cfg->ext_sample_rate) {
+        latm_put_object_type(buf, &pos, cfg->object_type);
+    }
+    // GASpecificConfig: frameLengthFlag, no core coder, no extension
+    latm_put_bits(buf, &pos, cfg->frame_960, 1);
+    latm_put_bits(buf, &pos, 0, 2);
+    return pos;
+}
+
+uint32_t latm_write_loas(latm_mux_cfg_t *cfg, bool with_cfg, const uint8_t *payload, uint32_t size, uint8_t *out)
+{
+    uint8_t *buf = out + LATM_LOAS_HEAD_SIZE;
+    uint32_t pos = 0;
+    latm_put_bits(buf, &pos, with_cfg ? 0 : 1, 1);
+    if (with_cfg) {
+        // audioMuxVersion 0, allStreamsSameTimeFraming 1, numSubFrames 0, numProgram 0, numLayer 0
+        latm_put_bits(buf, &pos, 0, 1);
+        latm_put_bits(buf, &pos, 1, 1);
+        latm_put_bits(buf, &pos, 0, 6 + 4 + 3);
+        pos = latm_write_asc(cfg, buf, pos);
+        // frameLengthType 0, latmBufferFullness 0xFF (VBR), no other data and CRC
+        latm_put_bits(buf, &pos, 0, 3);
+        latm_put_bits(buf, &pos, 0xFF, 8);
+        latm_put_bits(buf, &pos, 0, 2);
+    }
+    uint32_t len = size;
+    while (len >= 255) {
+        latm_put_bits(buf, &pos, 255, 8);
+        len -= 255;
+    }
+    latm_put_bits(buf, &pos, len, 8);
+    if ((pos & 7) == 0) {
+        memcpy(buf + (pos >> 3), payload, size);
+        pos += size * 8;
+    } else {
+        for (uint32_t i = 0; i < size; i++) {
+            latm_put_bits(buf, &pos, payload[i], 8);
+        }
+    }
+    uint32_t mux_size = (pos + 7) >> 3;
+    out[0] = LATM_LOAS_SYNC_WORD >> 3;
+    out[1] = ((LATM_LOAS_SYNC_WORD & 0x7) << 5) | (mux_size >> 8);
+    out[2] = mux_size & 0xFF;
+    return LATM_LOAS_HEAD_SIZE + mux_size;
+}
+
+uint32_t latm_get_loas_max_size(uint32_t payload_size, bool with_cfg)
+{
+    // Header, StreamMuxConfig (at most 16 bytes with escaped rate) and PayloadLengthInfo
+    return LATM_LOAS_HEAD_SIZE + (with_cfg ? 16 : 1) + payload_size / 255 + 1 + payload_size;
+}
@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_audio_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LATM_LOAS_HEAD_SIZE (3)
+#define LATM_LOAS_MAX_SIZE  (LATM_LOAS_HEAD_SIZE + 0x1FFF)
+
+/**
+ * @brief  Bit reader over AudioMuxElement
+ */
+typedef struct {
+    const uint8_t *data;
+    uint32_t       size;
+    uint32_t       pos;  /*!< Read position in bits */
+} latm_bits_t;
+
+/**
+ * @brief  Stream mux configuration of single program single layer stream (ISO/IEC 14496-3 1.7.3)
+ */
+typedef struct {
+    bool     valid;                  /*!< StreamMuxConfig already received */
+    uint8_t  audio_mux_version;      /*!< audioMuxVersion */
+    uint8_t  sub_frames;             /*!< PayloadMux count in one AudioMuxElement (numSubFrames + 1) */
+    uint32_t other_data_bits;        /*!< Other data bits after payload */
+    uint8_t  object_type;            /*!< Core audio object type */
+    uint32_t sample_rate;            /*!< Core sample rate */
+    uint32_t ext_sample_rate;        /*!< SBR output sample rate, 0 when SBR not signaled */
+    uint8_t  channel;                /*!< Channel count from channelConfiguration */
+    bool     frame_960;              /*!< frameLengthFlag, 960 samples per frame */
+} latm_mux_cfg_t;
+
+/**
+ * @brief  Get LOAS AudioSyncStream frame size
+ *
+ * @param  data  Data start with sync word
+ * @param  size  Data size, at least `LATM_LOAS_HEAD_SIZE`
+ *
+ * @return  Frame size include LOAS header, 0 when sync word not matched
+ */
+uint32_t latm_loas_frame_size(const uint8_t *data, uint32_t size);
+
+/**
+ * @brief  Parse AudioMuxElement(1) header till first PayloadLengthInfo
+ *
+ * @note  `cfg` keeps last StreamMuxConfig so that `useSameStreamMux` can reuse it
+ *
+ * @param  bits  Bit reader positioned at AudioMuxElement
+ * @param  cfg   Stream mux configuration
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK            On success
+ *       - ESP_AUDIO_ERR_NOT_FOUND     Configuration not received yet
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT   Multiple program or layer, not AAC object or frame length type not 0
+ *       - ESP_AUDIO_ERR_HEADER_PARSE  Broken configuration
+ */
+esp_audio_err_t latm_parse_mux_element(latm_bits_t *bits, latm_mux_cfg_t *cfg);
+
+/**
+ * @brief  Read PayloadLengthInfo of one sub frame
+ *
+ * @param  bits  Bit reader
+ *
+ * @return  Payload length in bytes, 0 when data is broken
+ */
+uint32_t latm_read_payload_len(latm_bits_t *bits);
+
+/**
+ * @brief  Skip other data and byte alignment after all sub frame payloads
+ *
+ * @param  bits  Bit reader
+ * @param  cfg   Stream mux configuration
+ */
+void latm_skip_other_data(latm_bits_t *bits, latm_mux_cfg_t *cfg);
+
+/**
+ * @brief  Get PCM sample number of one sub frame
+ *
+ * @param  cfg  Stream mux configuration
+ *
+ * @return  Sample number per channel
+ */
+uint32_t latm_get_frame_samples(latm_mux_cfg_t *cfg);
+
+/**
+ * @brief  Copy payload which may not be byte aligned
+ *
+ * @param  bits  Bit reader
+ * @param  dst   Destination buffer
+ * @param  size  Bytes to copy
+ *
+ * @return  0 on success, -1 when data is not enough
+ */
+int latm_read_payload(latm_bits_t *bits, uint8_t *dst, uint32_t size);
+
+/**
+ * @brief  Parse AudioSpecificConfig (ISO/IEC 14496-3 1.6.2.1) of AAC object
+ *
+ * @param  bits  Bit reader positioned at AudioSpecificConfig
+ * @param  cfg   Configuration to store object type, sample rate and channel
+ *
+ * @return
+ *       - ESP_AUDIO_ERR_OK            On success
+ *       - ESP_AUDIO_ERR_NOT_SUPPORT   Not AAC object or program config element used
+ *       - ESP_AUDIO_ERR_HEADER_PARSE  Invalid sample rate
+ */
+esp_audio_err_t latm_parse_asc(latm_bits_t *bits, latm_mux_cfg_t *cfg);
+
+/**
+ * @brief  Write AudioSpecificConfig of AAC object
+ *
+ * @note  Explicit hierarchical SBR signaling is written when `ext_sample_rate` is set
+ *
+ * @param  cfg  Configuration
+ * @param  buf  Buffer to write (at least 8 bytes after `pos`)
+ * @param  pos  Write position in bits
+ *
+ * @return  Write position in bits after AudioSpecificConfig
+ */
+uint32_t latm_write_asc(latm_mux_cfg_t *cfg, uint8_t *buf, uint32_t pos);
+
+/**
+ * @brief  Write one LOAS frame holding one payload
+ *
+ * @param  cfg       Configuration
+ * @param  with_cfg  Write StreamMuxConfig or set `useSameStreamMux`
+ * @param  payload   Raw AAC frame
+ * @param  size      Raw AAC frame size
+ * @param  out       Output buffer, size not less than `latm_get_loas_max_size`
+ *
+ * @return  LOAS frame size
+ */
+uint32_t latm_write_loas(latm_mux_cfg_t *cfg, bool with_cfg, const uint8_t *payload, uint32_t size, uint8_t *out);
+
+/**
+ * @brief  Get maximum LOAS frame size to hold payload
+ *
+ * @param  payload_size  Raw AAC frame size
+ * @param  with_cfg      Whether StreamMuxConfig is written
+ *
+ * @return  Maximum LOAS frame size
+ */
+uint32_t latm_get_loas_max_size(uint32_t payload_size, bool with_cfg);
+
+#ifdef __cplusplus
+}
+#endif
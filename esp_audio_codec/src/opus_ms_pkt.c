@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <string.h>
+#include "opus_ms_pkt.h"
+
+static const opus_ms_layout_t opus_ms_layouts[OPUS_MS_MAX_CHANNEL] = {
+    {1, 0, {0}},                      /* 1: mono */
+    {1, 1, {0, 1}},                   /* 2: stereo */
+    {2, 1, {0, 2, 1}},                /* 3: L, C, R */
+    {2, 2, {0, 1, 2, 3}},             /* 4: quadraphonic */
+    {3, 2, {0, 4, 1, 2, 3}},          /* 5: 5.0 surround */
+    {4, 2, {0, 4, 1, 2, 3, 5}},       /* 6: 5.1 surround */
+    {4, 3, {0, 4, 1, 2, 3, 5, 6}},    /* 7: 6.1 surround */
+    {5, 3, {0, 6, 1, 2, 3, 4, 5, 7}}, /* 8: 7.1 surround */
+};
+
+static int parse_size(const uint8_t *data, int len, int *size)
+{
+    if (len < 1) {
+        return -1;
+    }
+    if (data[0] < 252) {
+        *size = data[0];
+        return 1;
+    }
+    if (len < 2) {
+        return -1;
+    }
+    *size = data[0] + 4 * data[1];
+    return 2;
+}
+
+static int write_size(int size, uint8_t *data)
+{
+    if (size < 252) {
+        data[0] = (uint8_t)size;
+        return 1;
+    }
+    data[0] = (uint8_t)(252 + (size & 3));
+    data[1] = (uint8_t)((size - data[0]) >> 2);
+    return 2;
+}
+
+int opus_ms_pkt_parse(const uint8_t *data, int len, bool self_delimited, opus_ms_pkt_t *pkt)
+{
+    if (len < 1) {
+        return -1;
+    }
+    int pos = 1;
+    int cbr = 1;
+    int used = 0;
+    pkt->toc = data[0];
+    pkt->padding = 0;
+    pkt->delimit_len = 0;
+    switch (data[0] & 3) {
+        case 0:
+            pkt->frame_num = 1;
+            break;
+        case 1:
+            pkt->frame_num = 2;
+            break;
+        case 2:
+            pkt->frame_num = 2;
+            cbr = 0;
+            break;
+        default: {
+            if (len < 2) {
+                return -1;
+            }
+            uint8_t flag = data[pos++];
+            pkt->frame_num = flag & 0x3F;
+            cbr = !(flag & 0x80);
+            if (pkt->frame_num == 0 || pkt->frame_num > OPUS_MS_MAX_FRAMES) {
+                return -1;
+            }
+            if (flag & 0x40) {
+                uint8_t pad;
+                do {
+                    if (pos >= len) {
+                        return -1;
+                    }
+                    pad = data[pos++];
+                    pkt->padding += (pad == 255) ? 254 : pad;
+                } while (pad == 255);
+            }
+            break;
+        }
+    }
+    int sum = 0;
+    if (cbr == 0) {
+        for (int i = 0; i < pkt->frame_num - 1; i++) {
+            int size = 0;
+            used = parse_size(data + pos, len - pos, &size);
+            if (used < 0) {
+                return -1;
+            }
+            pos += used;
+            pkt->frame_len[i] = (uint16_t)size;
+            sum += size;
+        }
+    }
+    pkt->header_len = pos;
+    int last = 0;
+    if (self_delimited) {
+        used = parse_size(data + pos, len - pos, &last);
+        if (used < 0) {
+            return -1;
+        }
+        pkt->delimit_len = used;
+        pos += used;
+    } else {
+        last = len - pos - pkt->padding;
+        if (cbr) {
+            if (last < 0 || last % pkt->frame_num) {
+                return -1;
+            }
+            last /= pkt->frame_num;
+        } else {
+            last -= sum;
+        }
+    }
+    if (last < 0 || last > OPUS_MS_MAX_FRAME_BYTES) {
+        return -1;
+    }
+    if (cbr) {
+        for (int i = 0; i < pkt->frame_num; i++) {
+            pkt->frame_len[i] = (uint16_t)last;
+        }
+        sum = last * pkt->frame_num;
+    } else {
+        pkt->frame_len[pkt->frame_num - 1] = (uint16_t)last;
+        sum += last;
+    }
+    for (int i = 0; i < pkt->frame_num; i++) {
+        if (pkt->frame_len[i] > OPUS_MS_MAX_FRAME_BYTES) {
+            return -1;
+        }
+    }
+    pkt->size = pos + sum + pkt->padding;
+    return pkt->size > len ? -1 : 0;
+}
+
+int opus_ms_pkt_to_self_delimited(const uint8_t *src, int len, uint8_t *dst)
+{
+    opus_ms_pkt_t pkt;
+    if (opus_ms_pkt_parse(src, len, false, &pkt) != 0) {
+        return -1;
+    }
+    // Insert length of last frame after the header, other frame lengths are already coded or implied
+    memcpy(dst, src, pkt.header_len);
+    int pos = pkt.header_len;
+    pos += write_size(pkt.frame_len[pkt.frame_num - 1], dst + pos);
+    memcpy(dst + pos, src + pkt.header_len, pkt.size - pkt.header_len);
+    return pos + pkt.size - pkt.header_len;
+}
+
+int opus_ms_pkt_to_undelimited(const uint8_t *src, int len, uint8_t *dst, int *consumed)
+{
+    opus_ms_pkt_t pkt;
+    if (opus_ms_pkt_parse(src, len, true, &pkt) != 0) {
+        return -1;
+    }
+    memcpy(dst, src, pkt.header_len);
+    int data_pos = pkt.header_len + pkt.delimit_len;
+    memcpy(dst + pkt.header_len, src + data_pos, pkt.size - data_pos);
+    *consumed = pkt.size;
+    return pkt.size - pkt.delimit_len;
+}
+
+int opus_ms_pkt_get_samples(const opus_ms_pkt_t *pkt, int sample_rate)
+{
+    int config = pkt->toc >> 3;
+    int samples;
+    if (config < 12) {
+        // SILK only: 10, 20, 40, 60 ms
+        static const uint8_t silk_ms[] = {10, 20, 40, 60};
+        samples = 48 * silk_ms[config & 3];
+    } else if (config < 16) {
+        // Hybrid: 10, 20 ms
+        samples = (config & 1) ? 960 : 480;
+    } else {
+        // CELT only: 2.5, 5, 10, 20 ms
+        samples = 120 << (config & 3);
+    }
+    return (int)((int64_t)samples * pkt->frame_num * sample_rate / 48000);
+}
+
+const opus_ms_layout_t *opus_ms_get_layout(int channel)
+{
+    if (channel < 1 || channel > OPUS_MS_MAX_CHANNEL) {
+        return NULL;
+    }
+    return &opus_ms_layouts[channel - 1];
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OPUS_MS_MAX_CHANNEL     (8)
+#define OPUS_MS_MAX_FRAMES      (48)
+#define OPUS_MS_MAX_FRAME_BYTES (1275)
+#define OPUS_MS_HEAD_MIN_SIZE   (19)
+#define OPUS_MS_HEAD_MAX_SIZE   (OPUS_MS_HEAD_MIN_SIZE + 2 + OPUS_MS_MAX_CHANNEL)
+#define OPUS_MS_MAPPING_SILENT  (255)
+
+/**
+ * @brief  Framing of one Opus packet (RFC 6716 section 3.2)
+ */
+typedef struct {
+    uint8_t  toc;                            /*!< TOC byte */
+    uint8_t  frame_num;                      /*!< Frame count in packet */
+    int      header_len;                     /*!< Bytes before frame data in undelimited framing */
+    int      delimit_len;                    /*!< Bytes of self-delimiting length field, 0 for undelimited framing */
+    int      padding;                        /*!< Padding bytes at packet end */
+    int      size;                           /*!< Total packet size */
+    uint16_t frame_len[OPUS_MS_MAX_FRAMES];  /*!< Length of each frame */
+} opus_ms_pkt_t;
+
+/**
+ * @brief  Stream layout of channel mapping family 0 and 1 (RFC 7845 section 5.1.1)
+ */
+typedef struct {
+    uint8_t stream_count;
+    uint8_t coupled_count;
+    uint8_t mapping[OPUS_MS_MAX_CHANNEL];
+} opus_ms_layout_t;
+
+/**
+ * @brief  Parse framing of Opus packet
+ *
+ * @param  data            Packet data
+ * @param  len             Available data size, for self-delimited framing packet may end before it
+ * @param  self_delimited  Whether packet use self-delimited framing (RFC 6716 appendix B)
+ * @param  pkt             Parsed packet framing
+ *
+ * @return  0 on success, -1 for malformed packet
+ */
+int opus_ms_pkt_parse(const uint8_t *data, int len, bool self_delimited, opus_ms_pkt_t *pkt);
+
+/**
+ * @brief  Convert undelimited packet to self-delimited framing
+ *
+ * @note  `dst` must hold `len` + 2 bytes and must not overlap with `src`
+ *
+ * @return  Size of converted packet, -1 for malformed packet
+ */
+int opus_ms_pkt_to_self_delimited(const uint8_t *src, int len, uint8_t *dst);
+
+/**
+ * @brief  Convert self-delimited packet to undelimited framing
+ *
+ * @param  src       Self-delimited packet followed by other data
+ * @param  len       Available data size
+ * @param  dst       Output packet, must hold `len` bytes and must not overlap with `src`
+ * @param  consumed  Size of self-delimited packet in `src`
+ *
+ * @return  Size of converted packet, -1 for malformed packet
+ */
+int opus_ms_pkt_to_undelimited(const uint8_t *src, int len, uint8_t *dst, int *consumed);
+
+/**
+ * @brief  Get samples per channel of parsed packet at given sample rate
+ */
+int opus_ms_pkt_get_samples(const opus_ms_pkt_t *pkt, int sample_rate);
+
+/**
+ * @brief  Get default stream layout of Vorbis channel order for channel mapping family 1
+ *
+ * @return  Layout or NULL if channel not supported
+ */
+const opus_ms_layout_t *opus_ms_get_layout(int channel);
+
+/**
+ * @brief  Get stream index and channel inside stream for mapping value
+ *
+ * @return  Stream index, -1 for silent channel
+ */
+static inline int opus_ms_get_stream(uint8_t map, int coupled_count, int *sub_channel)
+{
+    if (map == OPUS_MS_MAPPING_SILENT) {
+        return -1;
+    }
+    if (map < 2 * coupled_count) {
+        *sub_channel = map & 1;
+        return map >> 1;
+    }
+    *sub_channel = 0;
+    return map - coupled_count;
+}
+
+#ifdef __cplusplus
+}
+#endif
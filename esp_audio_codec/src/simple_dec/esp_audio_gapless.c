@@ -0,0 +1,394 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "esp_audio_gapless.h"
+#include "esp_log.h"
+
+#define TAG "GAPLESS"
+
+#define MP3_DECODER_DELAY  (529)
+#define MP3_XING_FRAMES    (0x1)
+#define MP3_XING_BYTES     (0x2)
+#define MP3_XING_TOC       (0x4)
+#define MP3_XING_QUALITY   (0x8)
+#define MP3_LAME_TAG_SIZE  (24)
+#define MP3_SYNC_SEARCH    (4096)
+#define OPUS_SAMPLE_RATE   (48000)
+#define OPUS_HEAD_SIZE     (19)
+#define OGG_PAGE_HDR_SIZE  (27)
+#define OGG_EOS_FLAG       (0x4)
+#define SMPB_FIELDS        (4)
+
+typedef struct {
+    esp_audio_gapless_info_t info;
+    uint64_t                 pos;
+} gapless_trim_t;
+
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint64_t read_be64(const uint8_t *p)
+{
+    return ((uint64_t)read_be32(p) << 32) | read_be32(p + 4);
+}
+
+static inline uint64_t read_le64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+static const uint8_t *find_tag(const uint8_t *data, uint32_t size, const char *tag, uint32_t tag_len)
+{
+    for (uint32_t i = 0; i + tag_len <= size; i++) {
+        if (data[i] == (uint8_t)tag[0] && memcmp(data + i, tag, tag_len) == 0) {
+            return data + i;
+        }
+    }
+    return NULL;
+}
+
+static int mp3_side_info_size(uint8_t version, bool mono)
+{
+    // Version 3 is MPEG-1, others are MPEG-2 and MPEG-2.5
+    if (version == 3) {
+        return mono ? 17 : 32;
+    }
+    return mono ? 9 : 17;
+}
+
+static esp_audio_err_t parse_mp3(const uint8_t *data, uint32_t size, esp_audio_gapless_info_t *info)
+{
+    uint32_t pos = 0;
+    if (size >= 10 && memcmp(data, "ID3", 3) == 0) {
+        uint32_t tag_size = ((data[6] & 0x7F) << 21) | ((data[7] & 0x7F) << 14) | ((data[8] & 0x7F) << 7) | (data[9] & 0x7F);
+        pos = 10 + tag_size + ((data[5] & 0x10) ? 10 : 0);
+    }
+    if (pos >= size) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    uint32_t end = (size - pos > MP3_SYNC_SEARCH) ? pos + MP3_SYNC_SEARCH : size;
+    while (pos + 4 <= end) {
+        const uint8_t *h = data + pos;
+        // Layer III with valid version, bitrate and sample rate index
+        if (h[0] == 0xFF && (h[1] & 0xE0) == 0xE0 && ((h[1] >> 3) & 3) != 1 && ((h[1] >> 1) & 3) == 1 &&
+            (h[2] >> 4) != 0xF && ((h[2] >> 2) & 3) != 3) {
+            break;
+        }
+        pos++;
+    }
+    if (pos + 4 > end) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    const uint8_t *frame = data + pos;
+    uint8_t version = (frame[1] >> 3) & 3;
+    bool mono = ((frame[3] >> 6) == 3);
+    int samples_per_frame = (version == 3) ? 1152 : 576;
+    uint32_t off = pos + 4 + mp3_side_info_size(version, mono);
+    if (off + 8 > size || (memcmp(data + off, "Xing", 4) && memcmp(data + off, "Info", 4))) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    uint32_t flags = read_be32(data + off + 4);
+    off += 8;
+    uint32_t frames = 0;
+    if (flags & MP3_XING_FRAMES) {
+        if (off + 4 > size) {
+            return ESP_AUDIO_ERR_NOT_FOUND;
+        }
+        frames = read_be32(data + off);
+        off += 4;
+    }
+    off += (flags & MP3_XING_BYTES) ? 4 : 0;
+    off += (flags & MP3_XING_TOC) ? 100 : 0;
+    off += (flags & MP3_XING_QUALITY) ? 4 : 0;
+    uint32_t delay = 0, padding = 0;
+    bool has_lame = false;
+    if (off + MP3_LAME_TAG_SIZE <= size &&
+        (memcmp(data + off, "LAME", 4) == 0 || memcmp(data + off, "Lavf", 4) == 0 || memcmp(data + off, "Lavc", 4) == 0)) {
+        const uint8_t *p = data + off + 21;
+        delay = (p[0] << 4) | (p[1] >> 4);
+        padding = ((p[1] & 0xF) << 8) | p[2];
+        has_lame = true;
+    }
+    if (frames == 0 && has_lame == false) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    info->sample_rate = 0;
+    if (has_lame) {
+        info->enc_delay = delay;
+        info->dec_delay = MP3_DECODER_DELAY;
+        info->padding = padding;
+    }
+    if (frames) {
+        uint64_t total = (uint64_t)frames * samples_per_frame;
+        info->valid_samples = (total > delay + padding) ? total - delay - padding : 0;
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+static const uint8_t *find_box(const uint8_t *data, uint32_t size, const char *type, const uint8_t **box_end)
+{
+    const uint8_t *end = data + size;
+    const uint8_t *p = data;
+    while ((p = find_tag(p, end - p, type, 4)) != NULL) {
+        // Type is preceded by box size which must fit into data
+        if (p - data >= 4) {
+            uint32_t box_size = read_be32(p - 4);
+            if (box_size >= 8 && box_size <= (uint32_t)(end - (p - 4))) {
+                *box_end = p - 4 + box_size;
+                return p + 4;
+            }
+        }
+        p += 4;
+    }
+    return NULL;
+}
+
+static bool parse_smpb(const uint8_t *data, uint32_t size, esp_audio_gapless_info_t *info)
+{
+    const uint8_t *box_end = NULL;
+    const uint8_t *smpb = find_tag(data, size, "iTunSMPB", 8);
+    if (smpb == NULL) {
+        return false;
+    }
+    const uint8_t *p = find_box(smpb, data + size - smpb, "data", &box_end);
+    // Skip type indicator and locale of data box
+    if (p == NULL || box_end - p < 8) {
+        return false;
+    }
+    p += 8;
+    // Text like " 00000000 00000840 000001CA 00000000003F31F6 ..."
+    uint64_t fields[SMPB_FIELDS] = {0};
+    int n = 0;
+    while (p < box_end && n < SMPB_FIELDS) {
+        while (p < box_end && *p == ' ') {
+            p++;
+        }
+        int digits = 0;
+        uint64_t v = 0;
+        while (p < box_end && *p != ' ') {
+            uint8_t c = *p++;
+            int d = (c >= '0' && c <= '9') ? c - '0' : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+            if (d < 0) {
+                return false;
+            }
+            v = (v << 4) | d;
+            digits++;
+        }
+        if (digits == 0) {
+            break;
+        }
+        fields[n++] = v;
+    }
+    if (n < SMPB_FIELDS) {
+        return false;
+    }
+    info->sample_rate = 0;
+    info->enc_delay = (uint32_t)fields[1];
+    info->dec_delay = 0;
+    info->padding = (uint32_t)fields[2];
+    info->valid_samples = fields[3];
+    return true;
+}
+
+static bool parse_elst(const uint8_t *data, uint32_t size, esp_audio_gapless_info_t *info)
+{
+    const uint8_t *end = data + size;
+    const uint8_t *box_end = NULL;
+    const uint8_t *mvhd = find_box(data, size, "mvhd", &box_end);
+    if (mvhd == NULL || box_end - mvhd < 24) {
+        return false;
+    }
+    uint32_t movie_scale = read_be32(mvhd + (mvhd[0] == 1 ? 20 : 12));
+    const uint8_t *trak = data;
+    while ((trak = find_box(trak, end - trak, "trak", &box_end)) != NULL) {
+        const uint8_t *trak_end = box_end;
+        const uint8_t *hdlr = find_box(trak, trak_end - trak, "hdlr", &box_end);
+        const uint8_t *mdhd = find_box(trak, trak_end - trak, "mdhd", &box_end);
+        if (hdlr == NULL || mdhd == NULL || box_end - mdhd < 24 || trak_end - hdlr < 12 || memcmp(hdlr + 8, "soun", 4)) {
+            trak = trak_end;
+            continue;
+        }
+        uint32_t media_scale = read_be32(mdhd + (mdhd[0] == 1 ? 20 : 12));
+        const uint8_t *elst = find_box(trak, trak_end - trak, "elst", &box_end);
+        if (elst == NULL || box_end - elst < 8 || movie_scale == 0 || media_scale == 0) {
+            return false;
+        }
+        bool v1 = (elst[0] == 1);
+        uint32_t count = read_be32(elst + 4);
+        int entry_size = v1 ? 20 : 12;
+        const uint8_t *entry = elst + 8;
+        // Skip empty edits (media time -1) which only shift presentation
+        for (uint32_t i = 0; i < count && entry + entry_size <= box_end; i++, entry += entry_size) {
+            uint64_t duration = v1 ? read_be64(entry) : read_be32(entry);
+            int64_t media_time = v1 ? (int64_t)read_be64(entry + 8) : (int32_t)read_be32(entry + 4);
+            if (media_time < 0) {
+                continue;
+            }
+            info->sample_rate = media_scale;
+            info->enc_delay = (uint32_t)media_time;
+            info->dec_delay = 0;
+            info->valid_samples = duration * media_scale / movie_scale;
+            return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+static esp_audio_err_t parse_m4a(const uint8_t *data, uint32_t size, esp_audio_gapless_info_t *info)
+{
+    // iTunSMPB is preferred for it is the de facto convention of AAC in M4A
+    if (parse_smpb(data, size, info) || parse_elst(data, size, info)) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    return ESP_AUDIO_ERR_NOT_FOUND;
+}
+
+static esp_audio_err_t parse_ogg(const uint8_t *data, uint32_t size, esp_audio_gapless_info_t *info)
+{
+    bool found = false;
+    const uint8_t *head = find_tag(data, size, "OpusHead", 8);
+    if (head && data + size - head >= OPUS_HEAD_SIZE) {
+        info->sample_rate = OPUS_SAMPLE_RATE;
+        info->enc_delay = head[10] | (head[11] << 8);
+        info->dec_delay = 0;
+        found = true;
+    }
+    // Granule position of last page is end position including pre-skip
+    const uint8_t *end = data + size;
+    const uint8_t *page = data;
+    while ((page = find_tag(page, end - page, "OggS", 4)) != NULL) {
+        if (end - page >= OGG_PAGE_HDR_SIZE && page[4] == 0 && (page[5] & OGG_EOS_FLAG)) {
+            uint64_t granule = read_le64(page + 6);
+            if (info->sample_rate == OPUS_SAMPLE_RATE && granule > info->enc_delay) {
+                info->valid_samples = granule - info->enc_delay;
+                found = true;
+            }
+        }
+        page += 4;
+    }
+    return found ? ESP_AUDIO_ERR_OK : ESP_AUDIO_ERR_NOT_FOUND;
+}
+
+esp_audio_err_t esp_audio_gapless_parse(esp_audio_simple_dec_type_t type, const uint8_t *data, uint32_t size,
+                                        esp_audio_gapless_info_t *info)
+{
+    if (data == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    switch (type) {
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_MP3:
+            return parse_mp3(data, size, info);
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_M4A:
+            return parse_m4a(data, size, info);
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_OGG:
+            return parse_ogg(data, size, info);
+        default:
+            return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+}
+
+esp_audio_err_t esp_audio_gapless_open(esp_audio_gapless_info_t *info, esp_audio_gapless_handle_t *hd)
+{
+    if (info == NULL || hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *hd = NULL;
+    gapless_trim_t *trim = (gapless_trim_t *)calloc(1, sizeof(gapless_trim_t));
+    if (trim == NULL) {
+        ESP_LOGE(TAG, "No memory for gapless handle");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    trim->info = *info;
+    *hd = trim;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_gapless_set_info(esp_audio_gapless_handle_t hd, esp_audio_gapless_info_t *info)
+{
+    if (hd == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    gapless_trim_t *trim = (gapless_trim_t *)hd;
+    trim->info = *info;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static inline uint64_t scale_samples(uint64_t samples, uint32_t from_rate, uint32_t to_rate)
+{
+    if (from_rate == 0 || from_rate == to_rate) {
+        return samples;
+    }
+    return (samples * to_rate + from_rate / 2) / from_rate;
+}
+
+esp_audio_err_t esp_audio_gapless_process(esp_audio_gapless_handle_t hd, esp_audio_simple_dec_info_t *dec_info,
+                                          esp_audio_simple_dec_out_t *frame)
+{
+    if (hd == NULL || dec_info == NULL || frame == NULL || frame->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    gapless_trim_t *trim = (gapless_trim_t *)hd;
+    int sample_size = dec_info->channel * (dec_info->bits_per_sample >> 3);
+    if (sample_size == 0) {
+        ESP_LOGE(TAG, "Invalid decoder information");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    esp_audio_gapless_info_t *info = &trim->info;
+    uint64_t start = scale_samples((uint64_t)info->enc_delay + info->dec_delay, info->sample_rate, dec_info->sample_rate);
+    uint64_t stop = UINT64_MAX;
+    if (info->valid_samples) {
+        stop = start + scale_samples(info->valid_samples, info->sample_rate, dec_info->sample_rate);
+    }
+    uint64_t samples = frame->decoded_size / sample_size;
+    uint64_t frame_start = trim->pos;
+    uint64_t frame_end = trim->pos + samples;
+    trim->pos = frame_end;
+    uint64_t keep_start = frame_start > start ? frame_start : start;
+    uint64_t keep_end = frame_end < stop ? frame_end : stop;
+    if (keep_start >= keep_end) {
+        frame->decoded_size = 0;
+        return ESP_AUDIO_ERR_OK;
+    }
+    uint32_t keep_size = (uint32_t)(keep_end - keep_start) * sample_size;
+    if (keep_start > frame_start) {
+        memmove(frame->buffer, frame->buffer + (keep_start - frame_start) * sample_size, keep_size);
+    }
+    frame->decoded_size = keep_size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_gapless_reset(esp_audio_gapless_handle_t hd)
+{
+    if (hd == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    gapless_trim_t *trim = (gapless_trim_t *)hd;
+    trim->pos = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_audio_gapless_close(esp_audio_gapless_handle_t hd)
+{
+    if (hd) {
+        free(hd);
+    }
+}
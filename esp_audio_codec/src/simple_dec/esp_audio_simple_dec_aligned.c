@@ -0,0 +1,487 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "esp_audio_simple_dec_aligned.h"
+#include "esp_audio_dec_reg.h"
+#include "esp_log.h"
+
+#define TAG "SIMP_DEC_ALIGN"
+
+#define ALIGN_BOS_SIZE      (10)
+#define ALIGN_ID3_HEAD_SIZE (10)
+#define ALIGN_HEAD_MAX_SIZE (ALIGN_BOS_SIZE)
+
+typedef enum {
+    ALIGN_PARSE_OK        = 0,
+    ALIGN_PARSE_NEED_MORE = 1,
+} align_parse_ret_t;
+
+typedef struct {
+    esp_audio_simple_dec_type_t type;
+    const esp_audio_dec_ops_t  *ops;
+    void                       *dec;
+    esp_audio_dec_info_t        info;
+    bool                        info_ready;
+    bool                        parse_frame;
+    uint8_t                     head_size;
+    bool                        bos_checked;
+    uint32_t                    skip_remain;
+    uint8_t                    *cache;
+    uint32_t                    cache_size;
+    uint32_t                    cached;
+    uint32_t                    frame_size;
+    bool                        cache_pending;
+    uint32_t                    pending_consumed;
+    uint32_t                    resume_skip;
+} simple_dec_aligned_t;
+
+static const uint16_t mp3_bitrate[5][15] = {
+    {0, 32, 64, 96, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448}, // MPEG1 Layer I
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384},    // MPEG1 Layer II
+    {0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320},     // MPEG1 Layer III
+    {0, 32, 48, 56, 64, 80, 96, 112, 128, 144, 160, 176, 192, 224, 256},    // MPEG2/2.5 Layer I
+    {0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160},         // MPEG2/2.5 Layer II and III
+};
+
+static const uint16_t mp3_sample_rate[3] = {44100, 48000, 32000};
+
+// Frame size without header byte indexed by frame type
+static const uint8_t amrnb_size[16] = {12, 13, 15, 17, 19, 20, 26, 31, 5, 6, 5, 5, 0, 0, 0, 0};
+static const uint8_t amrwb_size[16] = {17, 23, 32, 36, 40, 46, 50, 58, 60, 5, 0, 0, 0, 0, 0, 0};
+
+static uint32_t parse_mp3_header(const uint8_t *h)
+{
+    if (h[0] != 0xFF || (h[1] & 0xE0) != 0xE0) {
+        return 0;
+    }
+    int version = (h[1] >> 3) & 3;  // 0: MPEG2.5, 2: MPEG2, 3: MPEG1
+    int layer = 4 - ((h[1] >> 1) & 3);
+    int bitrate_idx = h[2] >> 4;
+    int rate_idx = (h[2] >> 2) & 3;
+    int padding = (h[2] >> 1) & 1;
+    if (version == 1 || layer == 4 || bitrate_idx == 0 || bitrate_idx == 15 || rate_idx == 3) {
+        return 0;
+    }
+    int table = (version == 3) ? layer - 1 : (layer == 1 ? 3 : 4);
+    uint32_t bitrate = mp3_bitrate[table][bitrate_idx] * 1000;
+    uint32_t sample_rate = mp3_sample_rate[rate_idx] >> (3 - version - (version == 0));
+    if (layer == 1) {
+        return (12 * bitrate / sample_rate + padding) * 4;
+    }
+    if (layer == 3 && version != 3) {
+        return 72 * bitrate / sample_rate + padding;
+    }
+    return 144 * bitrate / sample_rate + padding;
+}
+
+static uint32_t parse_adts_header(const uint8_t *h)
+{
+    if (h[0] != 0xFF || (h[1] & 0xF6) != 0xF0 || ((h[2] >> 2) & 0xF) >= 13) {
+        return 0;
+    }
+    uint32_t size = ((h[3] & 0x03) << 11) | (h[4] << 3) | (h[5] >> 5);
+    return size > 7 ? size : 0;
+}
+
+static uint32_t parse_amr_header(const uint8_t *h, const uint8_t *sizes)
+{
+    // Padding bits must be 0
+    if (h[0] & 0x83) {
+        return 0;
+    }
+    uint8_t type = (h[0] >> 3) & 0xF;
+    if (type < 14 && sizes[type] == 0) {
+        return 0;
+    }
+    return sizes[type] + 1;
+}
+
+static uint32_t parse_header(simple_dec_aligned_t *aligned, const uint8_t *h)
+{
+    switch (aligned->type) {
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AAC:
+            return parse_adts_header(h);
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_MP3:
+            return parse_mp3_header(h);
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AMRNB:
+            return parse_amr_header(h, amrnb_size);
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AMRWB:
+            return parse_amr_header(h, amrwb_size);
+        default:
+            return 0;
+    }
+}
+
+static uint32_t check_bos(simple_dec_aligned_t *aligned, const uint8_t *buf, uint32_t len)
+{
+    if (aligned->type == ESP_AUDIO_SIMPLE_DEC_TYPE_MP3 && len >= ALIGN_ID3_HEAD_SIZE && memcmp(buf, "ID3", 3) == 0) {
+        // Tag size is syncsafe integer, footer present when flag bit 4 set
+        uint32_t size = ((buf[6] & 0x7F) << 21) | ((buf[7] & 0x7F) << 14) | ((buf[8] & 0x7F) << 7) | (buf[9] & 0x7F);
+        return size + ALIGN_ID3_HEAD_SIZE + ((buf[5] & 0x10) ? ALIGN_ID3_HEAD_SIZE : 0);
+    }
+    if (aligned->type == ESP_AUDIO_SIMPLE_DEC_TYPE_AMRNB && len >= 6 && memcmp(buf, "#!AMR\n", 6) == 0) {
+        return 6;
+    }
+    if (aligned->type == ESP_AUDIO_SIMPLE_DEC_TYPE_AMRWB && len >= 9 && memcmp(buf, "#!AMR-WB\n", 9) == 0) {
+        return 9;
+    }
+    return 0;
+}
+
+/* Find frame in place, `skip` reports data before frame (or data can be dropped when need more data) */
+static align_parse_ret_t find_frame(simple_dec_aligned_t *aligned, const uint8_t *buf, uint32_t len, bool eos,
+                                    uint32_t *skip, uint32_t *frame_size)
+{
+    uint32_t pos = 0;
+    if (aligned->skip_remain) {
+        pos = aligned->skip_remain < len ? aligned->skip_remain : len;
+        aligned->skip_remain -= pos;
+        if (aligned->skip_remain) {
+            *skip = pos;
+            return ALIGN_PARSE_NEED_MORE;
+        }
+    }
+    if (aligned->bos_checked == false) {
+        if (len - pos < ALIGN_BOS_SIZE && eos == false) {
+            *skip = pos;
+            return ALIGN_PARSE_NEED_MORE;
+        }
+        uint32_t bos_size = check_bos(aligned, buf + pos, len - pos);
+        aligned->bos_checked = true;
+        if (bos_size > len - pos) {
+            aligned->skip_remain = bos_size - (len - pos);
+            *skip = len;
+            return ALIGN_PARSE_NEED_MORE;
+        }
+        pos += bos_size;
+    }
+    for (; pos + aligned->head_size <= len; pos++) {
+        *frame_size = parse_header(aligned, buf + pos);
+        if (*frame_size) {
+            *skip = pos;
+            return ALIGN_PARSE_OK;
+        }
+    }
+    // Keep tail which may be start of next frame header
+    *skip = pos;
+    return ALIGN_PARSE_NEED_MORE;
+}
+
+static esp_audio_err_t prepare_cache(simple_dec_aligned_t *aligned, uint32_t size)
+{
+    if (size <= aligned->cache_size) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    uint8_t *cache = (uint8_t *)realloc(aligned->cache, size);
+    if (cache == NULL) {
+        ESP_LOGE(TAG, "No memory for cache size %d", (int)size);
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    aligned->cache = cache;
+    aligned->cache_size = size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t cache_data(simple_dec_aligned_t *aligned, const uint8_t *data, uint32_t size)
+{
+    if (size == 0) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    esp_audio_err_t ret = prepare_cache(aligned, aligned->cached + size);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    memcpy(aligned->cache + aligned->cached, data, size);
+    aligned->cached += size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static esp_audio_err_t decode_frame(simple_dec_aligned_t *aligned, uint8_t *data, uint32_t size,
+                                    esp_audio_simple_dec_raw_t *raw, esp_audio_simple_dec_out_t *frame, uint32_t *used)
+{
+    esp_audio_dec_in_raw_t dec_raw = {
+        .buffer = data,
+        .len = size,
+        .frame_recover = (esp_audio_dec_recovery_t)raw->frame_recover,
+    };
+    esp_audio_dec_out_frame_t dec_out = {
+        .buffer = frame->buffer,
+        .len = frame->len,
+    };
+    esp_audio_dec_info_t info = {0};
+    esp_audio_err_t ret = aligned->ops->decode(aligned->dec, &dec_raw, &dec_out, &info);
+    *used = dec_raw.consumed;
+    if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+        frame->needed_size = dec_out.needed_size;
+        return ret;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to decode ret %d", ret);
+        return ret;
+    }
+    frame->decoded_size = dec_out.decoded_size;
+    if (dec_out.decoded_size) {
+        aligned->info = info;
+        aligned->info_ready = true;
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+/* Decode frame completed in cache, leftover data is kept for next frame */
+static esp_audio_err_t decode_cache(simple_dec_aligned_t *aligned, esp_audio_simple_dec_raw_t *raw,
+                                    esp_audio_simple_dec_out_t *frame)
+{
+    uint32_t used = 0;
+    esp_audio_err_t ret = decode_frame(aligned, aligned->cache, aligned->frame_size, raw, frame, &used);
+    if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+        return ret;
+    }
+    // Drop frame even decode fail to avoid decoding it again
+    aligned->cached -= aligned->frame_size;
+    if (aligned->cached) {
+        memmove(aligned->cache, aligned->cache + aligned->frame_size, aligned->cached);
+    }
+    aligned->frame_size = 0;
+    return ret;
+}
+
+static esp_audio_err_t process_cache(simple_dec_aligned_t *aligned, esp_audio_simple_dec_raw_t *raw,
+                                     esp_audio_simple_dec_out_t *frame)
+{
+    uint32_t copied = 0;
+    esp_audio_err_t ret = ESP_AUDIO_ERR_OK;
+    if (aligned->frame_size == 0) {
+        // Fill header then search frame inside cache
+        if (aligned->cached < ALIGN_HEAD_MAX_SIZE) {
+            copied = ALIGN_HEAD_MAX_SIZE - aligned->cached;
+            copied = copied < raw->len ? copied : raw->len;
+            ret = cache_data(aligned, raw->buffer, copied);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+        }
+        uint32_t skip = 0;
+        bool eos = raw->eos && copied == raw->len;
+        align_parse_ret_t parse_ret = find_frame(aligned, aligned->cache, aligned->cached, eos, &skip,
+                                                 &aligned->frame_size);
+        if (skip) {
+            aligned->cached -= skip;
+            memmove(aligned->cache, aligned->cache + skip, aligned->cached);
+        }
+        if (parse_ret != ALIGN_PARSE_OK) {
+            if (eos) {
+                // Not enough for a frame at end of stream
+                aligned->cached = 0;
+            }
+            raw->consumed = copied;
+            return ESP_AUDIO_ERR_OK;
+        }
+    }
+    if (aligned->cached < aligned->frame_size) {
+        uint32_t need = aligned->frame_size - aligned->cached;
+        need = need < raw->len - copied ? need : raw->len - copied;
+        ret = cache_data(aligned, raw->buffer + copied, need);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        copied += need;
+        if (aligned->cached < aligned->frame_size) {
+            if (raw->eos && copied == raw->len) {
+                ESP_LOGW(TAG, "Drop incomplete frame %d/%d at end of stream", (int)aligned->cached,
+                         (int)aligned->frame_size);
+                aligned->cached = 0;
+                aligned->frame_size = 0;
+            }
+            raw->consumed = copied;
+            return ESP_AUDIO_ERR_OK;
+        }
+    }
+    ret = decode_cache(aligned, raw, frame);
+    if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+        // Input already copied, report it as consumed when retry succeeds
+        aligned->cache_pending = true;
+        aligned->pending_consumed = copied;
+        raw->consumed = 0;
+        return ret;
+    }
+    raw->consumed = copied;
+    return ret;
+}
+
+esp_audio_err_t esp_audio_simple_dec_aligned_open(esp_audio_simple_dec_cfg_t *cfg,
+                                                  esp_audio_simple_dec_aligned_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    const esp_audio_dec_ops_t *ops = esp_audio_dec_get_ops((esp_audio_type_t)cfg->dec_type);
+    if (ops == NULL || cfg->dec_type == ESP_AUDIO_SIMPLE_DEC_TYPE_FLAC) {
+        ESP_LOGE(TAG, "Not support decoder type %s", esp_audio_simple_dec_get_name(cfg->dec_type));
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    simple_dec_aligned_t *aligned = (simple_dec_aligned_t *)calloc(1, sizeof(simple_dec_aligned_t));
+    if (aligned == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    aligned->type = cfg->dec_type;
+    aligned->ops = ops;
+    switch (cfg->dec_type) {
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AAC:
+            aligned->head_size = 7;
+            break;
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_MP3:
+            aligned->head_size = 4;
+            break;
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AMRNB:
+        case ESP_AUDIO_SIMPLE_DEC_TYPE_AMRWB:
+            aligned->head_size = 1;
+            break;
+        default:
+            break;
+    }
+    aligned->parse_frame = (aligned->head_size != 0);
+    esp_audio_err_t ret = ops->open(cfg->dec_cfg, cfg->cfg_size, &aligned->dec);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to open decoder ret %d", ret);
+        free(aligned);
+        return ret;
+    }
+    *handle = aligned;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_aligned_process(esp_audio_simple_dec_aligned_handle_t handle,
+                                                     esp_audio_simple_dec_raw_t *raw,
+                                                     esp_audio_simple_dec_out_t *frame)
+{
+    if (handle == NULL || raw == NULL || frame == NULL || (raw->buffer == NULL && raw->len)) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_aligned_t *aligned = (simple_dec_aligned_t *)handle;
+    frame->decoded_size = 0;
+    raw->consumed = 0;
+    uint32_t used = 0;
+    esp_audio_err_t ret;
+    if (aligned->cache_pending) {
+        // Retry after output buffer reallocated
+        ret = decode_cache(aligned, raw, frame);
+        if (ret != ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+            aligned->cache_pending = false;
+            raw->consumed = aligned->pending_consumed;
+        }
+        return ret;
+    }
+    if (raw->len == 0 && raw->frame_recover == ESP_AUDIO_SIMPLE_DEC_RECOVERY_PLC) {
+        return decode_frame(aligned, NULL, 0, raw, frame, &used);
+    }
+    if (aligned->parse_frame == false) {
+        // Input is one or more frames, pass to decoder directly
+        if (raw->len == 0) {
+            return ESP_AUDIO_ERR_OK;
+        }
+        ret = decode_frame(aligned, raw->buffer, raw->len, raw, frame, &used);
+        if (ret == ESP_AUDIO_ERR_OK) {
+            raw->consumed = used ? used : raw->len;
+        }
+        return ret;
+    }
+    if (aligned->cached) {
+        return process_cache(aligned, raw, frame);
+    }
+    if (raw->len == 0) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    uint32_t skip = aligned->resume_skip;
+    uint32_t frame_size = 0;
+    align_parse_ret_t parse_ret = ALIGN_PARSE_OK;
+    if (skip) {
+        // Frame position already found before output buffer reallocated
+        aligned->resume_skip = 0;
+        frame_size = parse_header(aligned, raw->buffer + skip);
+    } else {
+        parse_ret = find_frame(aligned, raw->buffer, raw->len, raw->eos, &skip, &frame_size);
+    }
+    if (parse_ret == ALIGN_PARSE_OK && skip + frame_size <= raw->len) {
+        // Whole frame inside input, decode in place without copy
+        ret = decode_frame(aligned, raw->buffer + skip, frame_size, raw, frame, &used);
+        if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+            aligned->resume_skip = skip;
+            return ret;
+        }
+        raw->consumed = skip + frame_size;
+        return ret;
+    }
+    // Partial frame, cache left data until frame completed
+    if (raw->eos == false) {
+        ret = cache_data(aligned, raw->buffer + skip, raw->len - skip);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        aligned->frame_size = (parse_ret == ALIGN_PARSE_OK) ? frame_size : 0;
+    }
+    raw->consumed = raw->len;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_aligned_get_info(esp_audio_simple_dec_aligned_handle_t handle,
+                                                      esp_audio_simple_dec_info_t *info)
+{
+    if (handle == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_aligned_t *aligned = (simple_dec_aligned_t *)handle;
+    if (aligned->info_ready == false) {
+        return ESP_AUDIO_ERR_NOT_FOUND;
+    }
+    info->sample_rate = aligned->info.sample_rate;
+    info->bits_per_sample = aligned->info.bits_per_sample;
+    info->channel = aligned->info.channel;
+    info->bitrate = aligned->info.bitrate;
+    info->frame_size = aligned->info.frame_size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_aligned_reset(esp_audio_simple_dec_aligned_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_aligned_t *aligned = (simple_dec_aligned_t *)handle;
+    aligned->cached = 0;
+    aligned->frame_size = 0;
+    aligned->cache_pending = false;
+    aligned->pending_consumed = 0;
+    aligned->resume_skip = 0;
+    aligned->skip_remain = 0;
+    if (aligned->ops->reset) {
+        return aligned->ops->reset(aligned->dec);
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_audio_simple_dec_aligned_close(esp_audio_simple_dec_aligned_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    simple_dec_aligned_t *aligned = (simple_dec_aligned_t *)handle;
+    if (aligned->dec) {
+        aligned->ops->close(aligned->dec);
+    }
+    if (aligned->cache) {
+        free(aligned->cache);
+    }
+    free(aligned);
+}
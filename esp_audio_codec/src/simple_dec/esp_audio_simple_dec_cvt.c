@@ -0,0 +1,525 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_audio_simple_dec_cvt.h"
+#include "esp_log.h"
+
+#define TAG "SIMP_DEC_CVT"
+
+#define CVT_MAX_CHANNEL (8)
+#define CVT_TAPS        (16)
+#define CVT_MAX_RATIO   (6)
+#define CVT_PHASES      (64)
+#define CVT_CUTOFF      (0.92f)
+#define CVT_PI          (3.14159265f)
+#define CVT_PCM_SIZE    (4096)
+
+typedef struct {
+    esp_audio_simple_dec_handle_t  dec;
+    esp_audio_simple_dec_cvt_cfg_t cfg;
+    float                         *user_weight;
+    esp_audio_simple_dec_info_t    src_info;
+    bool                           ready;
+    bool                           direct;
+    uint32_t                       out_rate;
+    uint8_t                        out_ch;
+    uint8_t                        out_bits;
+    float                         *mix;
+    bool                           resample;
+    float                         *coef;
+    float                         *hist;
+    uint8_t                        hist_ch;
+    int                            taps;
+    int                            hist_taps;
+    int                            hist_pos;
+    uint32_t                       phase_num;
+    uint32_t                       wait;
+    bool                           flushed;
+    uint8_t                       *pcm;
+    uint32_t                       pcm_size;
+    uint32_t                       pending;
+    uint32_t                       pending_consumed;
+} simple_dec_cvt_t;
+
+static inline int32_t read_sample(const uint8_t *p, int bits)
+{
+    // Left aligned to 32 bits
+    if (bits == 16) {
+        return (int32_t)(*(const int16_t *)p) * 65536;
+    }
+    if (bits == 24) {
+        return (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24));
+    }
+    return *(const int32_t *)p;
+}
+
+static inline void write_sample(uint8_t *p, int bits, int32_t v)
+{
+    if (bits == 16) {
+        int32_t s = (v >> 16) + ((v >> 15) & 1);
+        *(int16_t *)p = (int16_t)(s > 32767 ? 32767 : s);
+    } else if (bits == 24) {
+        int32_t s = (v >> 8) + ((v >> 7) & 1);
+        s = s > 8388607 ? 8388607 : s;
+        p[0] = (uint8_t)s;
+        p[1] = (uint8_t)(s >> 8);
+        p[2] = (uint8_t)(s >> 16);
+    } else {
+        *(int32_t *)p = v;
+    }
+}
+
+static inline int32_t float_to_s32(float v)
+{
+    if (v >= 1.0f) {
+        return INT32_MAX;
+    }
+    if (v <= -1.0f) {
+        return INT32_MIN;
+    }
+    return (int32_t)lrintf(v * 2147483648.0f);
+}
+
+static void build_coef(float *coef, int taps, uint32_t in_rate, uint32_t out_rate)
+{
+    // Windowed sinc with cutoff follow the lower rate to avoid aliasing when down sampling
+    float fc = CVT_CUTOFF * (out_rate < in_rate ? (float)out_rate / in_rate : 1.0f);
+    int half = taps / 2;
+    for (int p = 0; p <= CVT_PHASES; p++) {
+        float *c = coef + p * taps;
+        float sum = 0;
+        for (int k = 0; k < taps; k++) {
+            float x = (float)(k - (half - 1)) - (float)p / CVT_PHASES;
+            float w = 0.42f + 0.5f * cosf(CVT_PI * x / half) + 0.08f * cosf(2 * CVT_PI * x / half);
+            float s = (x == 0.0f) ? 1.0f : sinf(CVT_PI * fc * x) / (CVT_PI * fc * x);
+            c[k] = s * w;
+            sum += c[k];
+        }
+        // Unity gain at DC for every phase
+        for (int k = 0; k < taps; k++) {
+            c[k] /= sum;
+        }
+    }
+}
+
+static void reset_history(simple_dec_cvt_t *cvt)
+{
+    if (cvt->hist) {
+        memset(cvt->hist, 0, cvt->out_ch * 2 * cvt->taps * sizeof(float));
+    }
+    cvt->hist_pos = 0;
+    cvt->phase_num = 0;
+    // Start output after half filter length so that output is aligned with input
+    cvt->wait = cvt->taps / 2;
+    cvt->flushed = false;
+}
+
+static esp_audio_err_t setup_convert(simple_dec_cvt_t *cvt, esp_audio_simple_dec_info_t *info)
+{
+    if (info->bits_per_sample != 16 && info->bits_per_sample != 24 && info->bits_per_sample != 32) {
+        ESP_LOGE(TAG, "Not support decoded bits %d", info->bits_per_sample);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    if (info->channel == 0 || info->channel > CVT_MAX_CHANNEL || info->sample_rate == 0) {
+        ESP_LOGE(TAG, "Not support decoded channel %d sample rate %d", info->channel, (int)info->sample_rate);
+        return ESP_AUDIO_ERR_NOT_SUPPORT;
+    }
+    esp_audio_simple_dec_cvt_cfg_t *cfg = &cvt->cfg;
+    uint8_t out_ch = cfg->channel ? cfg->channel : info->channel;
+    cvt->out_rate = cfg->sample_rate ? cfg->sample_rate : info->sample_rate;
+    cvt->out_bits = cfg->bits_per_sample ? cfg->bits_per_sample : info->bits_per_sample;
+    cvt->resample = (cvt->out_rate != info->sample_rate);
+    cvt->direct = (cvt->resample == false && out_ch == info->channel && cvt->out_bits == info->bits_per_sample);
+    if (cvt->mix) {
+        free(cvt->mix);
+        cvt->mix = NULL;
+    }
+    if (out_ch != info->channel) {
+        int mix_len = out_ch * info->channel;
+        if (cvt->user_weight && cfg->weight_len != (uint32_t)mix_len) {
+            ESP_LOGE(TAG, "Weight length %d not match %d to %d channel", (int)cfg->weight_len, info->channel, out_ch);
+            return ESP_AUDIO_ERR_NOT_SUPPORT;
+        }
+        cvt->mix = (float *)malloc(mix_len * sizeof(float));
+        if (cvt->mix == NULL) {
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+        for (int i = 0; i < mix_len; i++) {
+            cvt->mix[i] = cvt->user_weight ? cvt->user_weight[i] : 1.0f / info->channel;
+        }
+    }
+    if (cvt->resample) {
+        // Filter length grows with down sampling ratio to keep same transition band at output rate
+        uint32_t ratio = (info->sample_rate + cvt->out_rate - 1) / cvt->out_rate;
+        ratio = ratio > CVT_MAX_RATIO ? CVT_MAX_RATIO : (ratio == 0 ? 1 : ratio);
+        int taps = CVT_TAPS * (int)ratio;
+        if (taps > cvt->hist_taps || out_ch > cvt->hist_ch) {
+            if (cvt->coef) {
+                free(cvt->coef);
+            }
+            if (cvt->hist) {
+                free(cvt->hist);
+            }
+            cvt->coef = (float *)malloc((CVT_PHASES + 1) * taps * sizeof(float));
+            cvt->hist = (float *)malloc(out_ch * 2 * taps * sizeof(float));
+            cvt->hist_taps = taps;
+            cvt->hist_ch = out_ch;
+            if (cvt->coef == NULL || cvt->hist == NULL) {
+                cvt->hist_taps = 0;
+                cvt->hist_ch = 0;
+                ESP_LOGE(TAG, "No memory for rate conversion");
+                return ESP_AUDIO_ERR_MEM_LACK;
+            }
+        }
+        cvt->taps = taps;
+        build_coef(cvt->coef, taps, info->sample_rate, cvt->out_rate);
+    }
+    cvt->out_ch = out_ch;
+    reset_history(cvt);
+    cvt->src_info = *info;
+    cvt->ready = true;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static uint32_t get_max_out_frames(simple_dec_cvt_t *cvt, uint32_t in_frames)
+{
+    if (cvt->resample == false) {
+        return in_frames;
+    }
+    return (uint32_t)(((uint64_t)in_frames * cvt->out_rate + cvt->src_info.sample_rate - 1) / cvt->src_info.sample_rate) + 1;
+}
+
+static inline void emit_sample(simple_dec_cvt_t *cvt, uint8_t **out)
+{
+    float pf = (float)cvt->phase_num * CVT_PHASES / cvt->out_rate;
+    int p = (int)pf;
+    float a = pf - p;
+    int taps = cvt->taps;
+    const float *c0 = cvt->coef + p * taps;
+    const float *c1 = c0 + taps;
+    int out_bytes = cvt->out_bits >> 3;
+    for (int ch = 0; ch < cvt->out_ch; ch++) {
+        const float *h = cvt->hist + ch * 2 * taps + cvt->hist_pos;
+        float y0 = 0, y1 = 0;
+        for (int k = 0; k < taps; k++) {
+            y0 += h[k] * c0[k];
+            y1 += h[k] * c1[k];
+        }
+        write_sample(*out, cvt->out_bits, float_to_s32(y0 + a * (y1 - y0)));
+        *out += out_bytes;
+    }
+}
+
+static inline void resample_frame(simple_dec_cvt_t *cvt, const float *in, uint8_t **out)
+{
+    for (int ch = 0; ch < cvt->out_ch; ch++) {
+        float *h = cvt->hist + ch * 2 * cvt->taps;
+        h[cvt->hist_pos] = in[ch];
+        h[cvt->hist_pos + cvt->taps] = in[ch];
+    }
+    cvt->hist_pos = (cvt->hist_pos + 1) % cvt->taps;
+    while (cvt->wait == 0) {
+        emit_sample(cvt, out);
+        cvt->phase_num += cvt->src_info.sample_rate;
+        cvt->wait = cvt->phase_num / cvt->out_rate;
+        cvt->phase_num %= cvt->out_rate;
+    }
+    cvt->wait--;
+}
+
+/* Convert decoded frames in one pass: read, mix channel, resample then write in target bits */
+static uint32_t convert(simple_dec_cvt_t *cvt, const uint8_t *in, uint32_t frames, uint8_t *out)
+{
+    int src_ch = cvt->src_info.channel;
+    int in_bits = cvt->src_info.bits_per_sample;
+    int in_bytes = in_bits >> 3;
+    int out_bytes = cvt->out_bits >> 3;
+    uint8_t *out_start = out;
+    if (cvt->resample == false && cvt->mix == NULL) {
+        // Only bits change, keep integer path to stay bit exact
+        for (uint32_t i = 0; i < frames * src_ch; i++, in += in_bytes, out += out_bytes) {
+            write_sample(out, cvt->out_bits, read_sample(in, in_bits));
+        }
+        return frames;
+    }
+    float src[CVT_MAX_CHANNEL];
+    float dst[CVT_MAX_CHANNEL];
+    const float scale = 1.0f / 2147483648.0f;
+    for (uint32_t i = 0; i < frames; i++) {
+        for (int ch = 0; ch < src_ch; ch++, in += in_bytes) {
+            src[ch] = read_sample(in, in_bits) * scale;
+        }
+        const float *mixed = src;
+        if (cvt->mix) {
+            const float *w = cvt->mix;
+            for (int o = 0; o < cvt->out_ch; o++) {
+                float acc = 0;
+                for (int ch = 0; ch < src_ch; ch++) {
+                    acc += *(w++) * src[ch];
+                }
+                dst[o] = acc;
+            }
+            mixed = dst;
+        }
+        if (cvt->resample) {
+            resample_frame(cvt, mixed, &out);
+        } else {
+            for (int o = 0; o < cvt->out_ch; o++, out += out_bytes) {
+                write_sample(out, cvt->out_bits, float_to_s32(mixed[o]));
+            }
+        }
+    }
+    return (uint32_t)(out - out_start) / (cvt->out_ch * out_bytes);
+}
+
+static uint32_t flush_tail(simple_dec_cvt_t *cvt, uint8_t *out)
+{
+    float zero[CVT_MAX_CHANNEL] = {0};
+    uint8_t *pos = out;
+    for (int i = 0; i < cvt->taps / 2; i++) {
+        resample_frame(cvt, zero, &pos);
+    }
+    cvt->flushed = true;
+    return (uint32_t)(pos - out) / (cvt->out_ch * (cvt->out_bits >> 3));
+}
+
+static esp_audio_err_t output_pending(simple_dec_cvt_t *cvt, esp_audio_simple_dec_raw_t *raw,
+                                      esp_audio_simple_dec_out_t *frame, bool flush)
+{
+    uint32_t frames = cvt->pending / (cvt->src_info.channel * (cvt->src_info.bits_per_sample >> 3));
+    uint32_t out_frames = get_max_out_frames(cvt, frames);
+    if (flush) {
+        out_frames += get_max_out_frames(cvt, cvt->taps / 2);
+    }
+    uint32_t need = out_frames * cvt->out_ch * (cvt->out_bits >> 3);
+    if (frame->buffer == NULL || frame->len < need) {
+        // Keep decoded data, report input as not consumed until it is output
+        cvt->pending_consumed = raw->consumed;
+        raw->consumed = 0;
+        frame->needed_size = need;
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    uint32_t done = convert(cvt, cvt->pcm, frames, frame->buffer);
+    if (flush) {
+        done += flush_tail(cvt, frame->buffer + done * cvt->out_ch * (cvt->out_bits >> 3));
+    }
+    frame->decoded_size = done * cvt->out_ch * (cvt->out_bits >> 3);
+    cvt->pending = 0;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static bool format_changed(simple_dec_cvt_t *cvt, esp_audio_simple_dec_info_t *info)
+{
+    return cvt->ready == false || info->sample_rate != cvt->src_info.sample_rate ||
+           info->channel != cvt->src_info.channel || info->bits_per_sample != cvt->src_info.bits_per_sample;
+}
+
+static esp_audio_err_t prepare_pcm(simple_dec_cvt_t *cvt, uint32_t size)
+{
+    if (size <= cvt->pcm_size) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    uint8_t *pcm = (uint8_t *)realloc(cvt->pcm, size);
+    if (pcm == NULL) {
+        ESP_LOGE(TAG, "No memory for decode buffer size %d", (int)size);
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    cvt->pcm = pcm;
+    cvt->pcm_size = size;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_cvt_open(esp_audio_simple_dec_cvt_cfg_t *cfg,
+                                              esp_audio_simple_dec_cvt_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->channel > CVT_MAX_CHANNEL || (cfg->bits_per_sample && cfg->bits_per_sample != 16 &&
+        cfg->bits_per_sample != 24 && cfg->bits_per_sample != 32) || (cfg->weight && cfg->weight_len == 0)) {
+        ESP_LOGE(TAG, "Not support channel %d bits %d", cfg->channel, cfg->bits_per_sample);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_cvt_t *cvt = (simple_dec_cvt_t *)calloc(1, sizeof(simple_dec_cvt_t));
+    if (cvt == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    cvt->cfg = *cfg;
+    if (cfg->weight) {
+        cvt->user_weight = (float *)malloc(cfg->weight_len * sizeof(float));
+        if (cvt->user_weight == NULL) {
+            free(cvt);
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+        memcpy(cvt->user_weight, cfg->weight, cfg->weight_len * sizeof(float));
+        cvt->cfg.weight = cvt->user_weight;
+    }
+    esp_audio_err_t ret = prepare_pcm(cvt, CVT_PCM_SIZE);
+    if (ret == ESP_AUDIO_ERR_OK) {
+        ret = esp_audio_simple_dec_open(&cvt->cfg.dec_cfg, &cvt->dec);
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to open simple decoder ret %d", ret);
+        esp_audio_simple_dec_cvt_close(cvt);
+        return ret;
+    }
+    *handle = cvt;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_cvt_process(esp_audio_simple_dec_cvt_handle_t handle, esp_audio_simple_dec_raw_t *raw,
+                                                 esp_audio_simple_dec_out_t *frame)
+{
+    if (handle == NULL || raw == NULL || frame == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_cvt_t *cvt = (simple_dec_cvt_t *)handle;
+    frame->decoded_size = 0;
+    if (cvt->pending) {
+        // Retry after output buffer reallocated, input already decoded
+        raw->consumed = cvt->pending_consumed;
+        return output_pending(cvt, raw, frame, false);
+    }
+    esp_audio_err_t ret;
+    esp_audio_simple_dec_info_t info = {0};
+    if (cvt->direct) {
+        ret = esp_audio_simple_dec_process(cvt->dec, raw, frame);
+        if (ret != ESP_AUDIO_ERR_OK || frame->decoded_size == 0) {
+            return ret;
+        }
+        esp_audio_simple_dec_get_info(cvt->dec, &info);
+        if (format_changed(cvt, &info) == false) {
+            return ESP_AUDIO_ERR_OK;
+        }
+        // Format changed, move decoded data to internal buffer for conversion
+        ret = prepare_pcm(cvt, frame->decoded_size);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            return ret;
+        }
+        memcpy(cvt->pcm, frame->buffer, frame->decoded_size);
+        cvt->pending = frame->decoded_size;
+        frame->decoded_size = 0;
+    } else {
+        esp_audio_simple_dec_out_t dec_out = {0};
+        while (1) {
+            dec_out.buffer = cvt->pcm;
+            dec_out.len = cvt->pcm_size;
+            ret = esp_audio_simple_dec_process(cvt->dec, raw, &dec_out);
+            if (ret != ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+                break;
+            }
+            ret = prepare_pcm(cvt, dec_out.needed_size);
+            if (ret != ESP_AUDIO_ERR_OK) {
+                return ret;
+            }
+        }
+        if (ret != ESP_AUDIO_ERR_OK && !(raw->eos && raw->len == 0)) {
+            return ret;
+        }
+        if (ret != ESP_AUDIO_ERR_OK || dec_out.decoded_size == 0) {
+            // Flush filter tail at end of stream
+            if (raw->eos && raw->consumed >= raw->len && cvt->resample && cvt->flushed == false) {
+                return output_pending(cvt, raw, frame, true);
+            }
+            return ESP_AUDIO_ERR_OK;
+        }
+        esp_audio_simple_dec_get_info(cvt->dec, &info);
+        cvt->pending = dec_out.decoded_size;
+    }
+    if (format_changed(cvt, &info)) {
+        ret = setup_convert(cvt, &info);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            cvt->pending = 0;
+            return ret;
+        }
+        if (cvt->direct) {
+            // Already in target format, copy back once
+            if (frame->buffer == NULL || frame->len < cvt->pending) {
+                cvt->pending_consumed = raw->consumed;
+                raw->consumed = 0;
+                frame->needed_size = cvt->pending;
+                return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+            }
+            memcpy(frame->buffer, cvt->pcm, cvt->pending);
+            frame->decoded_size = cvt->pending;
+            cvt->pending = 0;
+            return ESP_AUDIO_ERR_OK;
+        }
+    }
+    return output_pending(cvt, raw, frame, false);
+}
+
+esp_audio_err_t esp_audio_simple_dec_cvt_get_info(esp_audio_simple_dec_cvt_handle_t handle,
+                                                  esp_audio_simple_dec_info_t *info)
+{
+    if (handle == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_cvt_t *cvt = (simple_dec_cvt_t *)handle;
+    esp_audio_err_t ret = esp_audio_simple_dec_get_info(cvt->dec, info);
+    if (ret != ESP_AUDIO_ERR_OK || cvt->ready == false) {
+        return ret == ESP_AUDIO_ERR_OK ? ESP_AUDIO_ERR_NOT_FOUND : ret;
+    }
+    info->sample_rate = cvt->out_rate;
+    info->channel = cvt->out_ch;
+    info->bits_per_sample = cvt->out_bits;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_audio_simple_dec_cvt_reset(esp_audio_simple_dec_cvt_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    simple_dec_cvt_t *cvt = (simple_dec_cvt_t *)handle;
+    esp_audio_err_t ret = esp_audio_simple_dec_reset(cvt->dec);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    cvt->pending = 0;
+    cvt->pending_consumed = 0;
+    if (cvt->ready) {
+        reset_history(cvt);
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+void esp_audio_simple_dec_cvt_close(esp_audio_simple_dec_cvt_handle_t handle)
+{
+    if (handle == NULL) {
+        return;
+    }
+    simple_dec_cvt_t *cvt = (simple_dec_cvt_t *)handle;
+    if (cvt->dec) {
+        esp_audio_simple_dec_close(cvt->dec);
+    }
+    if (cvt->user_weight) {
+        free(cvt->user_weight);
+    }
+    if (cvt->mix) {
+        free(cvt->mix);
+    }
+    if (cvt->coef) {
+        free(cvt->coef);
+    }
+    if (cvt->hist) {
+        free(cvt->hist);
+    }
+    if (cvt->pcm) {
+        free(cvt->pcm);
+    }
+    free(cvt);
+}
@@ -0,0 +1,229 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "impl/esp_latm_dec.h"
+#include "impl/esp_latm_parse.h"
+#include "esp_aac_dec.h"
+#include "esp_audio_simple_dec_reg.h"
+#include "latm_mux.h"
+#include "esp_log.h"
+
+#define TAG "LATM_DEC"
+
+typedef struct {
+    esp_latm_dec_cfg_t   cfg;
+    latm_mux_cfg_t       mux;
+    latm_mux_cfg_t       active;   /*!< Configuration used to open AAC decoder */
+    void                *aac_dec;
+    bool                 aac_plus;
+    uint8_t             *payload;
+    uint32_t             payload_size;
+    esp_audio_dec_info_t info;
+} latm_dec_t;
+
+static bool latm_dec_cfg_changed(latm_mux_cfg_t *a, latm_mux_cfg_t *b)
+{
+    return a->object_type != b->object_type || a->sample_rate != b->sample_rate ||
+           a->ext_sample_rate != b->ext_sample_rate || a->channel != b->channel || a->frame_960 != b->frame_960;
+}
+
+static esp_audio_err_t latm_dec_prepare(latm_dec_t *dec)
+{
+    if (dec->aac_dec && latm_dec_cfg_changed(&dec->active, &dec->mux) == false) {
+        return ESP_AUDIO_ERR_OK;
+    }
+    if (dec->aac_dec) {
+        ESP_LOGI(TAG, "Stream mux config changed, reopen decoder");
+        esp_aac_dec_close(dec->aac_dec);
+        dec->aac_dec = NULL;
+    }
+    dec->aac_plus = dec->cfg.aac_plus_enable || dec->mux.ext_sample_rate != 0;
+    esp_aac_dec_cfg_t aac_cfg = {
+        .sample_rate = dec->mux.sample_rate,
+        .channel = dec->mux.channel,
+        .bits_per_sample = 16,
+        .no_adts_header = true,
+        .aac_plus_enable = dec->aac_plus,
+    };
+    esp_audio_err_t ret = esp_aac_dec_open(&aac_cfg, sizeof(esp_aac_dec_cfg_t), &dec->aac_dec);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to open AAC decoder ret %d", ret);
+        return ret;
+    }
+    dec->active = dec->mux;
+    return ESP_AUDIO_ERR_OK;
+}
+
+static uint32_t latm_dec_max_out_size(latm_dec_t *dec)
+{
+    // SBR doubles samples and PS may upmix mono to stereo, reserve for the worst case
+    uint32_t samples = dec->aac_plus ? 2048 : latm_get_frame_samples(&dec->mux);
+    uint8_t channel = (dec->aac_plus && dec->mux.channel == 1) ? 2 : dec->mux.channel;
+    return samples * channel * sizeof(int16_t) * dec->mux.sub_frames;
+}
+
+esp_audio_err_t esp_latm_dec_open(void *cfg, uint32_t cfg_sz, void **dec_handle)
+{
+    if (dec_handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    *dec_handle = NULL;
+    esp_latm_dec_cfg_t *latm_cfg = NULL;
+    if (cfg && cfg_sz == sizeof(esp_es_parse_frame_info_t)) {
+        esp_es_parse_frame_info_t *frame_info = (esp_es_parse_frame_info_t *)cfg;
+        if (frame_info->dec_cfg && frame_info->dec_cfg_size == sizeof(esp_latm_dec_cfg_t)) {
+            latm_cfg = (esp_latm_dec_cfg_t *)frame_info->dec_cfg;
+        }
+    } else if (cfg && cfg_sz == sizeof(esp_latm_dec_cfg_t)) {
+        latm_cfg = (esp_latm_dec_cfg_t *)cfg;
+    } else if (cfg) {
+        ESP_LOGE(TAG, "Invalid configuration size %d", (int)cfg_sz);
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    latm_dec_t *dec = (latm_dec_t *)calloc(1, sizeof(latm_dec_t));
+    if (dec == NULL) {
+        ESP_LOGE(TAG, "No memory for instance");
+        return ESP_AUDIO_ERR_MEM_LACK;
+    }
+    if (latm_cfg) {
+        dec->cfg = *latm_cfg;
+    }
+    *dec_handle = dec;
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_latm_dec_decode(void *dec_handle, esp_audio_dec_in_raw_t *raw, esp_audio_dec_out_frame_t *frame,
+                                    esp_audio_dec_info_t *dec_info)
+{
+    if (dec_handle == NULL || raw == NULL || frame == NULL || raw->buffer == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    latm_dec_t *dec = (latm_dec_t *)dec_handle;
+    raw->consumed = 0;
+    frame->decoded_size = 0;
+    if (raw->len < LATM_LOAS_HEAD_SIZE) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    uint32_t frame_size = latm_loas_frame_size(raw->buffer, raw->len);
+    if (frame_size == 0) {
+        ESP_LOGE(TAG, "LOAS sync word not found");
+        return ESP_AUDIO_ERR_HEADER_PARSE;
+    }
+    if (raw->len < frame_size) {
+        return ESP_AUDIO_ERR_DATA_LACK;
+    }
+    latm_bits_t bits = {
+        .data = raw->buffer + LATM_LOAS_HEAD_SIZE,
+        .size = frame_size - LATM_LOAS_HEAD_SIZE,
+    };
+    esp_audio_err_t ret = latm_parse_mux_element(&bits, &dec->mux);
+    if (ret == ESP_AUDIO_ERR_NOT_FOUND) {
+        // Joined stream in the middle, drop until StreamMuxConfig arrives
+        raw->consumed = frame_size;
+        return ESP_AUDIO_ERR_OK;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to parse stream mux config ret %d", ret);
+        return ret;
+    }
+    ret = latm_dec_prepare(dec);
+    if (ret != ESP_AUDIO_ERR_OK) {
+        return ret;
+    }
+    // Check before decoding any sub frame so that retry with same input keeps decoder state
+    uint32_t max_out = latm_dec_max_out_size(dec);
+    if (frame->len < max_out) {
+        frame->needed_size = max_out;
+        return ESP_AUDIO_ERR_BUFF_NOT_ENOUGH;
+    }
+    if (dec->payload_size < frame_size) {
+        uint8_t *payload = (uint8_t *)realloc(dec->payload, frame_size);
+        if (payload == NULL) {
+            ESP_LOGE(TAG, "No memory for payload size %d", (int)frame_size);
+            return ESP_AUDIO_ERR_MEM_LACK;
+        }
+        dec->payload = payload;
+        dec->payload_size = frame_size;
+    }
+    for (uint8_t i = 0; i < dec->mux.sub_frames; i++) {
+        uint32_t payload_len = latm_read_payload_len(&bits);
+        if (payload_len == 0 || latm_read_payload(&bits, dec->payload, payload_len) != 0) {
+            ESP_LOGE(TAG, "Broken payload length %d", (int)payload_len);
+            ret = ESP_AUDIO_ERR_FAIL;
+            break;
+        }
+        esp_audio_dec_in_raw_t in = {
+            .buffer = dec->payload,
+            .len = payload_len,
+        };
+        esp_audio_dec_out_frame_t out = {
+            .buffer = frame->buffer + frame->decoded_size,
+            .len = frame->len - frame->decoded_size,
+        };
+        ret = esp_aac_dec_decode(dec->aac_dec, &in, &out, &dec->info);
+        if (ret != ESP_AUDIO_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to decode sub frame %d ret %d", i, ret);
+            break;
+        }
+        frame->decoded_size += out.decoded_size;
+    }
+    raw->consumed = frame_size;
+    if (dec_info) {
+        *dec_info = dec->info;
+    }
+    // Keep PCM of decoded sub frames when later one is broken
+    return frame->decoded_size ? ESP_AUDIO_ERR_OK : ret;
+}
+
+esp_audio_err_t esp_latm_dec_reset(void *dec_handle)
+{
+    if (dec_handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    latm_dec_t *dec = (latm_dec_t *)dec_handle;
+    if (dec->aac_dec) {
+        return esp_aac_dec_reset(dec->aac_dec);
+    }
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_latm_dec_close(void *dec_handle)
+{
+    if (dec_handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter");
+        return ESP_AUDIO_ERR_INVALID_PARAMETER;
+    }
+    latm_dec_t *dec = (latm_dec_t *)dec_handle;
+    if (dec->aac_dec) {
+        esp_aac_dec_close(dec->aac_dec);
+    }
+    if (dec->payload) {
+        free(dec->payload);
+    }
+    free(dec);
+    return ESP_AUDIO_ERR_OK;
+}
+
+esp_audio_err_t esp_latm_dec_register(void)
+{
+    esp_audio_simple_dec_reg_info_t reg_info = {
+        .decoder_ops = ESP_LATM_DEC_DEFAULT_OPS(),
+        .parser = esp_latm_parse_frame,
+        .free = esp_latm_parse_free_extra,
+    };
+    return esp_audio_simple_dec_register(ESP_AUDIO_SIMPLE_DEC_TYPE_LATM, &reg_info);
+}
+
+esp_audio_err_t esp_latm_dec_unregister(void)
+{
+    return esp_audio_simple_dec_unregister(ESP_AUDIO_SIMPLE_DEC_TYPE_LATM);
+}
@@ -0,0 +1,89 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include "impl/esp_latm_parse.h"
+#include "latm_mux.h"
+#include "esp_log.h"
+
+#define TAG "LATM_PARSE"
+
+static uint32_t latm_find_sync(uint8_t *buf, uint32_t len)
+{
+    uint32_t i = 1;
+    for (; i + 1 < len; i++) {
+        if (buf[i] == 0x56 && (buf[i + 1] & 0xE0) == 0xE0) {
+            break;
+        }
+    }
+    return i;
+}
+
+esp_es_parse_err_t esp_latm_parse_frame(esp_es_parse_raw_t *data, esp_es_parse_frame_info_t *info)
+{
+    if (data == NULL || info == NULL) {
+        return ESP_ES_PARSE_ERR_INVALID_ARG;
+    }
+    if (data->len < LATM_LOAS_HEAD_SIZE) {
+        return ESP_ES_PARSE_ERR_DATA_NOT_ENOUGH;
+    }
+    uint32_t frame_size = latm_loas_frame_size(data->buffer, data->len);
+    if (frame_size == 0) {
+        info->skipped_size = latm_find_sync(data->buffer, data->len);
+        return ESP_ES_PARSE_ERR_OK;
+    }
+    if (data->len < frame_size) {
+        if (data->eos) {
+            // Drop truncated tail frame
+            info->skipped_size = data->len;
+            return ESP_ES_PARSE_ERR_OK;
+        }
+        return ESP_ES_PARSE_ERR_DATA_NOT_ENOUGH;
+    }
+    latm_mux_cfg_t *mux = (latm_mux_cfg_t *)info->extra_data;
+    if (mux == NULL) {
+        mux = (latm_mux_cfg_t *)calloc(1, sizeof(latm_mux_cfg_t));
+        if (mux == NULL) {
+            ESP_LOGE(TAG, "No memory for mux config");
+            return ESP_ES_PARSE_ERR_NO_MEM;
+        }
+        info->extra_data = mux;
+    }
+    latm_bits_t bits = {
+        .data = data->buffer + LATM_LOAS_HEAD_SIZE,
+        .size = frame_size - LATM_LOAS_HEAD_SIZE,
+    };
+    esp_audio_err_t ret = latm_parse_mux_element(&bits, mux);
+    if (ret == ESP_AUDIO_ERR_NOT_FOUND) {
+        // Wait for StreamMuxConfig, decoder can not start without it
+        info->skipped_size = frame_size;
+        return ESP_ES_PARSE_ERR_OK;
+    }
+    if (ret == ESP_AUDIO_ERR_NOT_SUPPORT) {
+        ESP_LOGE(TAG, "Stream mux config not supported");
+        return ESP_ES_PARSE_ERR_NOT_SUPPORT;
+    }
+    if (ret != ESP_AUDIO_ERR_OK) {
+        // Sync word emulation inside payload, resync from next byte
+        info->skipped_size = 1;
+        return ESP_ES_PARSE_ERR_OK;
+    }
+    esp_es_aud_frame_info_t *aud_info = &info->aud_info;
+    aud_info->sample_rate = mux->ext_sample_rate > mux->sample_rate ? mux->ext_sample_rate : mux->sample_rate;
+    aud_info->channel = mux->channel;
+    aud_info->bits_per_sample = 16;
+    aud_info->sample_num = latm_get_frame_samples(mux) * mux->sub_frames;
+    info->frame_size = frame_size;
+    return ESP_ES_PARSE_ERR_OK;
+}
+
+void esp_latm_parse_free_extra(void *extra_data)
+{
+    if (extra_data) {
+        free(extra_data);
+    }
+}
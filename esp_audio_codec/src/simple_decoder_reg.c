@@ -26,6 +26,10 @@ esp_audio_err_t esp_audio_simple_dec_register_default(void)
 #ifdef CONFIG_AUDIO_SIMPLE_DEC_OGG_SUPPORT
     ret |= esp_ogg_dec_register();
 #endif /* CONFIG_AUDIO_SIMPLE_DEC_OGG_SUPPORT */
+
+#ifdef CONFIG_AUDIO_SIMPLE_DEC_LATM_SUPPORT
+    ret |= esp_latm_dec_register();
+#endif /* CONFIG_AUDIO_SIMPLE_DEC_LATM_SUPPORT */
     return ret;
 }
 
@@ -46,4 +50,8 @@ void esp_audio_simple_dec_unregister_default(void)
 #ifdef CONFIG_AUDIO_SIMPLE_DEC_OGG_SUPPORT
     esp_ogg_dec_unregister();
 #endif /* CONFIG_AUDIO_SIMPLE_DEC_OGG_SUPPORT */
+
+#ifdef CONFIG_AUDIO_SIMPLE_DEC_LATM_SUPPORT
+    esp_latm_dec_unregister();
+#endif /* CONFIG_AUDIO_SIMPLE_DEC_LATM_SUPPORT */
 }
@@ -21,8 +21,6 @@
 #include "test_common.h"
 #include "esp_board_manager.h"
 
-extern const char test_mp3_start[] asm("_binary_test_mp3_start");
-extern const char test_mp3_end[] asm("_binary_test_mp3_end");
 extern const char test_flac_start[] asm("_binary_test_flac_start");
 extern const char test_flac_end[] asm("_binary_test_flac_end");
 
@@ -107,6 +105,7 @@ static bool has_phase_shift(esp_audio_type_t type)
         case ESP_AUDIO_TYPE_LC3:
         case ESP_AUDIO_TYPE_ALAC:
         case ESP_AUDIO_TYPE_G722:
+        case ESP_AUDIO_TYPE_MP3:
             return true;
         default:
             break;
@@ -286,11 +285,6 @@ static bool encoder_use_test_data(esp_audio_type_t type)
     chain.test_send_size = 0;
     chain.test_file_size = 0;
     switch (type) {
-        case ESP_AUDIO_TYPE_MP3:
-            chain.parse_type = ESP_ES_PARSE_TYPE_MP3;
-            chain.test_file_size = (int)(test_mp3_end - test_mp3_start);
-            chain.test_frames = (uint8_t *)test_mp3_start;
-            return true;
         case ESP_AUDIO_TYPE_FLAC:
             chain.parse_type = ESP_ES_PARSE_TYPE_FLAC;
             chain.test_file_size = (int)(test_flac_end - test_flac_start);
@@ -463,7 +457,7 @@ static void chain_reset_test_thread(void *arg)
         }
         ESP_LOGI(TAG, "Start to do chain test for %s sample_rate %d channel %d", (char *)esp_audio_codec_get_name(types[i]),
                  new_sample_rate, new_channel);
-        if (types[i] != ESP_AUDIO_TYPE_MP3 && types[i] != ESP_AUDIO_TYPE_FLAC) {
+        if (types[i] != ESP_AUDIO_TYPE_FLAC) {
             snprintf(enc_file_name, sizeof(enc_file_name), "/sdcard/enc_%s.%s",
                      (char *)esp_audio_codec_get_name(types[i]), (char *)esp_audio_codec_get_name(types[i]));
             enc_file = fopen(enc_file_name, "wb");
@@ -502,7 +496,7 @@ static void chain_reset_test_thread(void *arg)
             chain.dec_file = NULL;
             dec_file = NULL;
         }
-        if (types[i] != ESP_AUDIO_TYPE_MP3 && types[i] != ESP_AUDIO_TYPE_FLAC) {
+        if (types[i] != ESP_AUDIO_TYPE_FLAC) {
             snprintf(enc_file_name, sizeof(enc_file_name), "/sdcard/enc_%s.%s",
                      (char *)esp_audio_codec_get_name(types[i]), (char *)esp_audio_codec_get_name(types[i]));
             enc_file = fopen(enc_file_name, "rb");
@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "sdkconfig.h"
 #include "unity.h"
 #include "esp_err.h"
@@ -14,6 +15,9 @@
 #include "audio_codec_test.h"
 #include "esp_audio_dec_default.h"
 #include "esp_audio_dec.h"
+#include "esp_opus_ms_enc.h"
+#include "esp_aac_enc.h"
+#include "esp_audio_dec_prime.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 
@@ -568,3 +572,265 @@ TEST_CASE("Decoder opus", CODEC_TEST_MODULE_NAME)
     // ==================== Cleanup Resources ====================
     free(out_frame.buffer);
 }
+
+TEST_CASE("Opus multistream encode and decode test", CODEC_TEST_MODULE_NAME)
+{
+    const int channels[] = {6, 8, 3, 2};
+    const int silent_ch = 1;
+    for (int n = 0; n < sizeof(channels) / sizeof(channels[0]); n++) {
+        esp_opus_ms_enc_config_t enc_cfg = ESP_OPUS_MS_ENC_CONFIG_DEFAULT();
+        enc_cfg.channel = channels[n];
+        enc_cfg.bitrate = 64000 * channels[n];
+        void *encoder = NULL;
+        TEST_ESP_OK(esp_opus_ms_enc_open(&enc_cfg, sizeof(esp_opus_ms_enc_config_t), &encoder));
+
+        // Check OpusHead for OGG muxer
+        esp_audio_enc_info_t enc_info = {0};
+        TEST_ESP_OK(esp_opus_ms_enc_get_info(encoder, &enc_info));
+        TEST_ASSERT_NOT_NULL(enc_info.codec_spec_info);
+        TEST_ASSERT_EQUAL_MEMORY("OpusHead", enc_info.codec_spec_info, 8);
+        TEST_ASSERT_EQUAL_INT(1, enc_info.codec_spec_info[8]);
+        TEST_ASSERT_EQUAL_INT(channels[n], enc_info.codec_spec_info[9]);
+        int family = channels[n] > 2 ? 1 : 0;
+        TEST_ASSERT_EQUAL_INT(family, enc_info.codec_spec_info[18]);
+        TEST_ASSERT_EQUAL_INT(family ? 21 + channels[n] : 19, enc_info.spec_info_len);
+
+        esp_opus_ms_dec_cfg_t dec_cfg = ESP_OPUS_MS_DEC_CONFIG_DEFAULT();
+        TEST_ESP_OK(esp_opus_ms_dec_parse_head(enc_info.codec_spec_info, enc_info.spec_info_len, &dec_cfg));
+        TEST_ASSERT_EQUAL_INT(channels[n], dec_cfg.channel);
+        if (channels[n] == 6) {
+            const uint8_t mapping_5_1[] = {0, 4, 1, 2, 3, 5};
+            TEST_ASSERT_EQUAL_INT(4, dec_cfg.stream_count);
+            TEST_ASSERT_EQUAL_INT(2, dec_cfg.coupled_count);
+            TEST_ASSERT_EQUAL_MEMORY(mapping_5_1, dec_cfg.mapping, 6);
+        }
+        dec_cfg.sample_rate = enc_cfg.sample_rate;
+        void *decoder = NULL;
+        TEST_ESP_OK(esp_opus_ms_dec_open(&dec_cfg, sizeof(esp_opus_ms_dec_cfg_t), &decoder));
+
+        int pcm_size = 0, raw_size = 0;
+        TEST_ESP_OK(esp_opus_ms_enc_get_frame_size(encoder, &pcm_size, &raw_size));
+        int16_t *pcm = malloc(pcm_size);
+        int16_t *out_pcm = malloc(pcm_size);
+        uint8_t *raw_data = malloc(raw_size);
+        TEST_ASSERT_NOT_NULL(pcm);
+        TEST_ASSERT_NOT_NULL(out_pcm);
+        TEST_ASSERT_NOT_NULL(raw_data);
+        int ch = channels[n];
+        int samples = pcm_size / ch / sizeof(int16_t);
+        double energy[ESP_OPUS_MS_ENC_MAX_CHANNEL] = {0};
+        int pos = 0;
+        for (int f = 0; f < 50; f++) {
+            // Each channel has its own tone except one silent channel to verify channel mapping
+            for (int i = 0; i < samples; i++, pos++) {
+                for (int c = 0; c < ch; c++) {
+                    pcm[i * ch + c] = (c == silent_ch) ? 0 :
+                        (int16_t)(8000 * sinf(6.2831853f * 300 * (c + 1) * pos / enc_cfg.sample_rate));
+                }
+            }
+            esp_audio_enc_in_frame_t in_frame = {
+                .buffer = (uint8_t *)pcm,
+                .len = pcm_size,
+            };
+            esp_audio_enc_out_frame_t out_frame = {
+                .buffer = raw_data,
+                .len = raw_size,
+            };
+            TEST_ESP_OK(esp_opus_ms_enc_process(encoder, &in_frame, &out_frame));
+            TEST_ASSERT_GREATER_THAN(0, out_frame.encoded_bytes);
+
+            esp_audio_dec_in_raw_t raw = {
+                .buffer = raw_data,
+                .len = out_frame.encoded_bytes,
+            };
+            esp_audio_dec_out_frame_t dec_frame = {
+                .buffer = (uint8_t *)out_pcm,
+                .len = pcm_size,
+            };
+            esp_audio_dec_info_t dec_info = {0};
+            TEST_ESP_OK(esp_opus_ms_dec_decode(decoder, &raw, &dec_frame, &dec_info));
+            TEST_ASSERT_EQUAL_INT(out_frame.encoded_bytes, raw.consumed);
+            TEST_ASSERT_EQUAL_INT(pcm_size, dec_frame.decoded_size);
+            TEST_ASSERT_EQUAL_INT(ch, dec_info.channel);
+            // Skip start up frames
+            if (f < 10) {
+                continue;
+            }
+            for (int i = 0; i < samples; i++) {
+                for (int c = 0; c < ch; c++) {
+                    energy[c] += (double)out_pcm[i * ch + c] * out_pcm[i * ch + c];
+                }
+            }
+        }
+        for (int c = 0; c < ch; c++) {
+            ESP_LOGI(TAG, "Channel %d/%d energy %.0f", c, ch, energy[c]);
+            if (c != silent_ch) {
+                TEST_ASSERT_TRUE(energy[c] > energy[silent_ch] * 100);
+            }
+        }
+        // Packet loss concealment for all streams
+        esp_audio_dec_in_raw_t lost = {
+            .frame_recover = ESP_AUDIO_DEC_RECOVERY_PLC,
+        };
+        esp_audio_dec_out_frame_t dec_frame = {
+            .buffer = (uint8_t *)out_pcm,
+            .len = pcm_size,
+        };
+        esp_audio_dec_info_t dec_info = {0};
+        TEST_ESP_OK(esp_opus_ms_dec_decode(decoder, &lost, &dec_frame, &dec_info));
+        TEST_ASSERT_EQUAL_INT(pcm_size, dec_frame.decoded_size);
+
+        esp_opus_ms_enc_close(encoder);
+        esp_opus_ms_dec_close(decoder);
+        free(pcm);
+        free(out_pcm);
+        free(raw_data);
+    }
+}
+
+static int prime_decode_frame(esp_audio_dec_handle_t decoder, uint8_t *data, int size, int16_t *pcm, int pcm_size)
+{
+    esp_audio_dec_in_raw_t raw = {
+        .buffer = data,
+        .len = size,
+    };
+    esp_audio_dec_out_frame_t out_frame = {
+        .buffer = (uint8_t *)pcm,
+        .len = pcm_size,
+    };
+    TEST_ESP_OK(esp_audio_dec_process(decoder, &raw, &out_frame));
+    TEST_ASSERT_EQUAL_INT(size, raw.consumed);
+    return out_frame.decoded_size;
+}
+
+TEST_CASE("Decoder prime after seek test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_aac_dec_register());
+    TEST_ESP_OK(esp_pcm_dec_register());
+    // Stateless decoder skip prime data without decoding
+    TEST_ASSERT_EQUAL_INT(0, esp_audio_dec_get_prime_frames(ESP_AUDIO_TYPE_PCM));
+    // MP3 count follows main_data_begin of target frame
+    const struct {
+        uint8_t head[6];
+        int     frames;
+    } mp3_prime[] = {
+        {{0xFF, 0xFB, 0x90, 0x00, 0x00, 0x00}, 1},  // MPEG1 128 kbps 44.1 kHz stereo, no reservoir used
+        {{0xFF, 0xFB, 0x90, 0x00, 0xFF, 0x80}, 3},  // 511 bytes back, 381 bytes main data per frame
+        {{0xFF, 0xFB, 0x14, 0xC0, 0xFF, 0x80}, 8},  // MPEG1 32 kbps 48 kHz mono, 75 bytes main data
+        {{0xFF, 0xF3, 0x14, 0xC0, 0xFF, 0x00}, 25},  // MPEG2 8 kbps 24 kHz mono, 255 bytes back, 11 bytes main data
+    };
+    for (int i = 0; i < sizeof(mp3_prime) / sizeof(mp3_prime[0]); i++) {
+        TEST_ASSERT_EQUAL_INT(mp3_prime[i].frames, esp_audio_dec_get_prime_frames_by_frame(ESP_AUDIO_TYPE_MP3,
+                                                                                            mp3_prime[i].head, 6));
+    }
+    // Header only falls back to type based count
+    TEST_ASSERT_EQUAL_INT(esp_audio_dec_get_prime_frames(ESP_AUDIO_TYPE_MP3),
+                          esp_audio_dec_get_prime_frames_by_frame(ESP_AUDIO_TYPE_MP3, mp3_prime[1].head, 4));
+    esp_pcm_dec_cfg_t pcm_cfg = {
+        .sample_rate = 44100,
+        .channel = 2,
+        .bits_per_sample = 16,
+    };
+    esp_audio_dec_cfg_t dec_cfg = {
+        .type = ESP_AUDIO_TYPE_PCM,
+        .cfg = &pcm_cfg,
+        .cfg_sz = sizeof(pcm_cfg),
+    };
+    esp_audio_dec_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_dec_open(&dec_cfg, &decoder));
+    esp_audio_dec_prime_handle_t prime = NULL;
+    TEST_ESP_OK(esp_audio_dec_prime_open(ESP_AUDIO_TYPE_PCM, decoder, &prime));
+    uint8_t pcm_data[256] = {0};
+    esp_audio_dec_in_raw_t raw = {
+        .buffer = pcm_data,
+        .len = sizeof(pcm_data),
+    };
+    TEST_ESP_OK(esp_audio_dec_prime_process(prime, &raw));
+    TEST_ASSERT_EQUAL_INT(sizeof(pcm_data), raw.consumed);
+    esp_audio_dec_prime_close(prime);
+    esp_audio_dec_close(decoder);
+
+    // Encode AAC tone frames
+    esp_aac_enc_config_t enc_cfg = ESP_AAC_ENC_CONFIG_DEFAULT();
+    void *encoder = NULL;
+    TEST_ESP_OK(esp_aac_enc_open(&enc_cfg, sizeof(enc_cfg), &encoder));
+    int in_size = 0, out_size = 0;
+    TEST_ESP_OK(esp_aac_enc_get_frame_size(encoder, &in_size, &out_size));
+    const int frames = 30;
+    uint8_t *pcm = malloc(in_size);
+    uint8_t *raw_data = malloc(frames * out_size);
+    int *raw_size = calloc(frames, sizeof(int));
+    int16_t *ref = malloc(frames * in_size);
+    int16_t *out = malloc(in_size);
+    TEST_ASSERT_NOT_NULL(pcm);
+    TEST_ASSERT_NOT_NULL(raw_data);
+    TEST_ASSERT_NOT_NULL(raw_size);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+    audio_info_t aud_info = {
+        .sample_rate = enc_cfg.sample_rate,
+        .bits_per_sample = enc_cfg.bits_per_sample,
+        .channel = enc_cfg.channel,
+    };
+    audio_codec_gen_pcm(&aud_info, pcm, in_size);
+    for (int i = 0; i < frames; i++) {
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = pcm,
+            .len = in_size,
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = raw_data + i * out_size,
+            .len = out_size,
+        };
+        TEST_ESP_OK(esp_aac_enc_process(encoder, &in_frame, &out_frame));
+        raw_size[i] = out_frame.encoded_bytes;
+    }
+    esp_aac_enc_close(encoder);
+
+    // Decode whole stream as reference
+    esp_aac_dec_cfg_t aac_cfg = {0};
+    dec_cfg.type = ESP_AUDIO_TYPE_AAC;
+    dec_cfg.cfg = &aac_cfg;
+    dec_cfg.cfg_sz = sizeof(aac_cfg);
+    TEST_ESP_OK(esp_audio_dec_open(&dec_cfg, &decoder));
+    int frame_samples = in_size / sizeof(int16_t);
+    for (int i = 0; i < frames; i++) {
+        int size = prime_decode_frame(decoder, raw_data + i * out_size, raw_size[i], ref + i * frame_samples, in_size);
+        TEST_ASSERT_EQUAL_INT(in_size, size);
+    }
+
+    // Seek to target frame, compare with and without prime
+    const int target = 20;
+    int prime_frames = esp_audio_dec_get_prime_frames(ESP_AUDIO_TYPE_AAC);
+    TEST_ASSERT_GREATER_THAN(0, prime_frames);
+    int64_t err[2] = {0};
+    for (int use_prime = 0; use_prime < 2; use_prime++) {
+        TEST_ESP_OK(esp_audio_dec_reset(decoder));
+        if (use_prime) {
+            TEST_ESP_OK(esp_audio_dec_prime_open(ESP_AUDIO_TYPE_AAC, decoder, &prime));
+            for (int i = target - prime_frames; i < target; i++) {
+                raw.buffer = raw_data + i * out_size;
+                raw.len = raw_size[i];
+                TEST_ESP_OK(esp_audio_dec_prime_process(prime, &raw));
+                TEST_ASSERT_EQUAL_INT(raw_size[i], raw.consumed);
+            }
+            esp_audio_dec_prime_close(prime);
+        }
+        prime_decode_frame(decoder, raw_data + target * out_size, raw_size[target], out, in_size);
+        int16_t *expect = ref + target * frame_samples;
+        for (int i = 0; i < frame_samples; i++) {
+            err[use_prime] += abs(out[i] - expect[i]);
+        }
+    }
+    ESP_LOGI(TAG, "Error without prime %d with prime %d", (int)err[0], (int)err[1]);
+    TEST_ASSERT_LESS_THAN(err[0] / 100, err[1]);
+
+    esp_audio_dec_close(decoder);
+    free(pcm);
+    free(raw_data);
+    free(raw_size);
+    free(ref);
+    free(out);
+    esp_audio_dec_unregister(ESP_AUDIO_TYPE_AAC);
+    esp_audio_dec_unregister(ESP_AUDIO_TYPE_PCM);
+}
@@ -0,0 +1,28 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include "unity.h"
+#include "unity_test_runner.h"
+
+/* Entry of the linux target build, prebuilt codecs are not available there so only DSP kernel cases are linked */
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void app_main(void)
+{
+    printf("Running esp_audio_codec DSP kernel tests on host\n");
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    UNITY_END();
+}
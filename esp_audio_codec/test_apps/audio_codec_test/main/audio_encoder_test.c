@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "sdkconfig.h"
 #include "unity.h"
 #include "esp_err.h"
@@ -16,6 +17,8 @@
 #include "esp_audio_enc_default.h"
 #include "esp_audio_enc_reg.h"
 #include "esp_audio_enc.h"
+#include "esp_aac_bsf.h"
+#include "esp_audio_codec_cost.h"
 #include "esp_timer.h"
 #include "esp_log.h"
 
@@ -34,6 +37,8 @@ typedef union {
     esp_sbc_enc_config_t   sbc_cfg;
     esp_lc3_enc_config_t   lc3_cfg;
     esp_g722_enc_config_t  g722_cfg;
+    esp_mp3_enc_config_t   mp3_cfg;
+    esp_flac_enc_config_t  flac_cfg;
 } enc_all_cfg_t;
 
 #define ASSIGN_BASIC_CFG(cfg) {                    \
@@ -131,6 +136,22 @@ static int get_encoder_config(esp_audio_type_t type, esp_audio_enc_config_t *enc
             enc_cfg->cfg_sz = sizeof(esp_g722_enc_config_t);
             break;
         }
+        case ESP_AUDIO_TYPE_MP3: {
+            esp_mp3_enc_config_t *cfg = &all_cfg->mp3_cfg;
+            ASSIGN_BASIC_CFG(cfg);
+            cfg->bitrate = 128000;
+            cfg->rc_mode = ESP_MP3_ENC_RC_MODE_CBR;
+            cfg->psy_mode = ESP_MP3_ENC_PSY_MODE_NORMAL;
+            enc_cfg->cfg_sz = sizeof(esp_mp3_enc_config_t);
+            break;
+        }
+        case ESP_AUDIO_TYPE_FLAC: {
+            esp_flac_enc_config_t *cfg = &all_cfg->flac_cfg;
+            ASSIGN_BASIC_CFG(cfg);
+            cfg->compression_level = ESP_FLAC_ENC_DEFAULT_COMPRESSION_LEVEL;
+            enc_cfg->cfg_sz = sizeof(esp_flac_enc_config_t);
+            break;
+        }
         default:
             ESP_LOGE(TAG, "Not supported encoder type %d", type);
             return -1;
@@ -364,6 +385,462 @@ TEST_CASE("AAC Encoder use Encoder API directly", CODEC_TEST_MODULE_NAME)
     TEST_ASSERT_EQUAL_INT(heap_size, (int)esp_get_free_heap_size());
 }
 
+static void gen_mc_pcm(int sample_rate, int channel, int bits_per_sample, uint8_t *data, int samples)
+{
+    int sample_bytes = bits_per_sample >> 3;
+    for (int i = 0; i < samples; i++) {
+        for (int ch = 0; ch < channel; ch++) {
+            // Different tone for each channel to check channel mapping by ear
+            float v = 0.3f * sinf(6.2831853f * 250 * (ch + 1) * i / sample_rate);
+            int32_t s = (int32_t)(v * 2147483647.0f);
+            // Little endian, keep most significant bytes
+            for (int b = 0; b < sample_bytes; b++) {
+                *(data++) = (uint8_t)(s >> (32 - (sample_bytes - b) * 8));
+            }
+        }
+    }
+}
+
+TEST_CASE("AAC multichannel encoder test", CODEC_TEST_MODULE_NAME)
+{
+    // Backup original heap size
+    int heap_size = esp_get_free_heap_size();
+    const struct {
+        int sample_rate;
+        int channel;
+        int bits_per_sample;
+        int bitrate;
+        int channel_config;
+        int coded_bitrate;
+    } mc_test_cfg[] = {
+        // 12 kbps is kept for LFE only in 5.1 and 7.1, 3 channels at 16 kHz are clamped to the mono minimum
+        {48000, 6, 16, 384000, 6, 384000},
+        {48000, 8, 24, 512000, 7, 511996},
+        {44100, 4, 32, 256000, 4, 256000},
+        {32000, 2, 24, 96000, 2, 96000},
+        {48000, 5, 16, 0, 5, 0},
+        {16000, 3, 16, 64000, 3, 66000},
+    };
+    for (int i = 0; i < sizeof(mc_test_cfg) / sizeof(mc_test_cfg[0]); i++) {
+        esp_aac_mc_enc_config_t mc_cfg = ESP_AAC_MC_ENC_CONFIG_DEFAULT();
+        mc_cfg.sample_rate = mc_test_cfg[i].sample_rate;
+        mc_cfg.channel = mc_test_cfg[i].channel;
+        mc_cfg.bits_per_sample = mc_test_cfg[i].bits_per_sample;
+        mc_cfg.bitrate = mc_test_cfg[i].bitrate;
+        esp_audio_enc_handle_t encoder = NULL;
+        TEST_ESP_OK(esp_aac_mc_enc_open(&mc_cfg, sizeof(esp_aac_mc_enc_config_t), &encoder));
+
+        int pcm_size = 0, raw_size = 0;
+        esp_aac_mc_enc_get_frame_size(encoder, &pcm_size, &raw_size);
+        int sample_size = mc_cfg.channel * mc_cfg.bits_per_sample >> 3;
+        TEST_ASSERT_EQUAL_INT(1024 * sample_size, pcm_size);
+        uint8_t *pcm_data = malloc(MAX_ENCODED_FRAMES * pcm_size);
+        uint8_t *raw_data = malloc(raw_size);
+        TEST_ASSERT_NOT_NULL(pcm_data);
+        TEST_ASSERT_NOT_NULL(raw_data);
+        gen_mc_pcm(mc_cfg.sample_rate, mc_cfg.channel, mc_cfg.bits_per_sample, pcm_data,
+                   MAX_ENCODED_FRAMES * pcm_size / sample_size);
+
+        int frame_count = 0;
+        for (int j = 0; j < MAX_ENCODED_FRAMES; j++) {
+            esp_audio_enc_in_frame_t in_frame = {
+                .buffer = pcm_data + pcm_size * j,
+                .len = pcm_size,
+            };
+            esp_audio_enc_out_frame_t out_frame = {
+                .buffer = raw_data,
+                .len = raw_size,
+            };
+            TEST_ESP_OK(esp_aac_mc_enc_process(encoder, &in_frame, &out_frame));
+            TEST_ASSERT_LESS_OR_EQUAL(raw_size, out_frame.encoded_bytes);
+            if (out_frame.encoded_bytes == 0) {
+                continue;
+            }
+            frame_count++;
+            // ADTS sync word and channel configuration
+            TEST_ASSERT_EQUAL_HEX8(0xFF, raw_data[0]);
+            TEST_ASSERT_EQUAL_HEX8(0xF0, raw_data[1] & 0xF6);
+            int channel_config = ((raw_data[2] & 1) << 2) | (raw_data[3] >> 6);
+            TEST_ASSERT_EQUAL_INT(mc_test_cfg[i].channel_config, channel_config);
+            int frame_len = ((raw_data[3] & 3) << 11) | (raw_data[4] << 3) | (raw_data[5] >> 5);
+            TEST_ASSERT_EQUAL_INT(out_frame.encoded_bytes, frame_len);
+        }
+        TEST_ASSERT_GREATER_THAN(0, frame_count);
+
+        esp_audio_enc_info_t enc_info = {0};
+        TEST_ESP_OK(esp_aac_mc_enc_get_info(encoder, &enc_info));
+        TEST_ASSERT_EQUAL_INT(mc_cfg.channel, enc_info.channel);
+        TEST_ASSERT_EQUAL_INT(mc_test_cfg[i].coded_bitrate, enc_info.bitrate);
+        TEST_ASSERT_EQUAL_INT(2, enc_info.spec_info_len);
+        TEST_ASSERT_EQUAL_INT(mc_test_cfg[i].channel_config, (enc_info.codec_spec_info[1] >> 3) & 0xF);
+
+        TEST_ESP_OK(esp_aac_mc_enc_reset(encoder));
+        esp_aac_mc_enc_close(encoder);
+        free(pcm_data);
+        free(raw_data);
+    }
+    // Unsupported channel layout
+    esp_aac_mc_enc_config_t mc_cfg = ESP_AAC_MC_ENC_CONFIG_DEFAULT();
+    mc_cfg.channel = 7;
+    esp_audio_enc_handle_t encoder = NULL;
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_INVALID_PARAMETER, esp_aac_mc_enc_open(&mc_cfg, sizeof(esp_aac_mc_enc_config_t), &encoder));
+    TEST_ASSERT_NULL(encoder);
+    TEST_ASSERT_EQUAL_INT(heap_size, (int)esp_get_free_heap_size());
+}
+
+static int aac_bsf_convert(esp_aac_bsf_cfg_t *cfg, uint8_t *in, int in_size, uint8_t *out, int *frames)
+{
+    esp_aac_bsf_handle_t bsf = NULL;
+    TEST_ESP_OK(esp_aac_bsf_open(cfg, &bsf));
+    esp_aac_bsf_out_t out_frame = {0};
+    int out_size = 0;
+    *frames = 0;
+    while (in_size > 0) {
+        esp_aac_bsf_in_t in_frame = {
+            .buffer = in,
+            .len = in_size,
+        };
+        esp_audio_err_t ret = esp_aac_bsf_process(bsf, &in_frame, &out_frame);
+        if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+            out_frame.buffer = realloc(out_frame.buffer, out_frame.needed_size);
+            TEST_ASSERT_NOT_NULL(out_frame.buffer);
+            out_frame.len = out_frame.needed_size;
+            continue;
+        }
+        TEST_ESP_OK(ret);
+        memcpy(out + out_size, out_frame.data, out_frame.size);
+        out_size += out_frame.size;
+        (*frames)++;
+        in += in_frame.consumed;
+        in_size -= in_frame.consumed;
+    }
+    if (out_frame.buffer) {
+        free(out_frame.buffer);
+    }
+    esp_aac_bsf_close(bsf);
+    return out_size;
+}
+
+TEST_CASE("AAC bitstream filter test", CODEC_TEST_MODULE_NAME)
+{
+    // Backup original heap size
+    int heap_size = esp_get_free_heap_size();
+    esp_aac_enc_config_t aac_cfg = ESP_AAC_ENC_CONFIG_DEFAULT();
+    void *encoder = NULL;
+    TEST_ESP_OK(esp_aac_enc_open(&aac_cfg, sizeof(esp_aac_enc_config_t), &encoder));
+    int pcm_size = 0, raw_size = 0;
+    TEST_ESP_OK(esp_aac_enc_get_frame_size(encoder, &pcm_size, &raw_size));
+    uint8_t *pcm = malloc(pcm_size);
+    int buf_size = MAX_ENCODED_FRAMES * (raw_size + 32);
+    uint8_t *adts = malloc(buf_size);
+    uint8_t *conv = malloc(buf_size);
+    uint8_t *back = malloc(buf_size);
+    TEST_ASSERT_NOT_NULL(pcm);
+    TEST_ASSERT_NOT_NULL(adts);
+    TEST_ASSERT_NOT_NULL(conv);
+    TEST_ASSERT_NOT_NULL(back);
+    gen_mc_pcm(aac_cfg.sample_rate, aac_cfg.channel, aac_cfg.bits_per_sample, pcm, pcm_size / 4);
+    int adts_size = 0;
+    for (int i = 0; i < MAX_ENCODED_FRAMES; i++) {
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = pcm,
+            .len = pcm_size,
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = adts + adts_size,
+            .len = raw_size,
+        };
+        TEST_ESP_OK(esp_aac_enc_process(encoder, &in_frame, &out_frame));
+        adts_size += out_frame.encoded_bytes;
+    }
+    esp_aac_enc_close(encoder);
+
+    // ADTS to raw is zero copy, ASC is generated from ADTS header
+    esp_aac_bsf_cfg_t cfg = {
+        .in_fmt = ESP_AAC_BSF_FMT_ADTS,
+        .out_fmt = ESP_AAC_BSF_FMT_RAW,
+    };
+    int frames = 0;
+    int raw_total = aac_bsf_convert(&cfg, adts, adts_size, conv, &frames);
+    TEST_ASSERT_EQUAL_INT(MAX_ENCODED_FRAMES, frames);
+    TEST_ASSERT_EQUAL_INT(adts_size - 7 * frames, raw_total);
+    esp_aac_bsf_asc_info_t info = {
+        .object_type = 2,
+        .sample_rate = aac_cfg.sample_rate,
+        .channel = aac_cfg.channel,
+    };
+    uint8_t asc[8];
+    uint8_t asc_len = sizeof(asc);
+    TEST_ESP_OK(esp_aac_bsf_gen_asc(&info, asc, &asc_len));
+    TEST_ASSERT_EQUAL_INT(2, asc_len);
+    // AAC-LC 44.1kHz stereo
+    TEST_ASSERT_EQUAL_HEX8(0x12, asc[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x10, asc[1]);
+
+    // Raw back to ADTS frame by frame must be bit exact
+    cfg.in_fmt = ESP_AAC_BSF_FMT_RAW;
+    cfg.out_fmt = ESP_AAC_BSF_FMT_ADTS;
+    cfg.asc = asc;
+    cfg.asc_len = asc_len;
+    esp_aac_bsf_handle_t bsf = NULL;
+    TEST_ESP_OK(esp_aac_bsf_open(&cfg, &bsf));
+    uint8_t *out_buf = malloc(raw_size + 7);
+    TEST_ASSERT_NOT_NULL(out_buf);
+    int pos = 0;
+    for (int i = 0; i < frames; i++) {
+        uint8_t *frame = adts + pos;
+        int frame_size = ((frame[3] & 3) << 11) | (frame[4] << 3) | (frame[5] >> 5);
+        esp_aac_bsf_in_t in_frame = {
+            .buffer = frame + 7,
+            .len = frame_size - 7,
+        };
+        esp_aac_bsf_out_t out_frame = {
+            .buffer = out_buf,
+            .len = raw_size + 7,
+        };
+        TEST_ESP_OK(esp_aac_bsf_process(bsf, &in_frame, &out_frame));
+        TEST_ASSERT_EQUAL_INT(frame_size, out_frame.size);
+        // Buffer fullness may differ, compare all other header bits and payload
+        TEST_ASSERT_EQUAL_MEMORY(frame, out_frame.data, 5);
+        TEST_ASSERT_EQUAL_MEMORY(frame + 7, out_frame.data + 7, frame_size - 7);
+        pos += frame_size;
+    }
+    esp_aac_bsf_close(bsf);
+    free(out_buf);
+
+    // ADTS frame with multiple raw data blocks is skipped as a whole
+    memcpy(back, adts, adts_size);
+    back[6] |= 1;
+    cfg = (esp_aac_bsf_cfg_t) {
+        .in_fmt = ESP_AAC_BSF_FMT_ADTS,
+        .out_fmt = ESP_AAC_BSF_FMT_RAW,
+    };
+    TEST_ESP_OK(esp_aac_bsf_open(&cfg, &bsf));
+    esp_aac_bsf_in_t multi_in = {
+        .buffer = back,
+        .len = adts_size,
+    };
+    esp_aac_bsf_out_t multi_out = {0};
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_NOT_SUPPORT, esp_aac_bsf_process(bsf, &multi_in, &multi_out));
+    int first_size = ((back[3] & 3) << 11) | (back[4] << 3) | (back[5] >> 5);
+    TEST_ASSERT_EQUAL_INT(first_size, multi_in.consumed);
+    TEST_ASSERT_EQUAL_INT(0, multi_out.size);
+    multi_in.buffer += multi_in.consumed;
+    multi_in.len -= multi_in.consumed;
+    TEST_ESP_OK(esp_aac_bsf_process(bsf, &multi_in, &multi_out));
+    TEST_ASSERT_GREATER_THAN(0, multi_out.size);
+    esp_aac_bsf_close(bsf);
+
+    // ADTS to LOAS and back
+    cfg = (esp_aac_bsf_cfg_t) {
+        .in_fmt = ESP_AAC_BSF_FMT_ADTS,
+        .out_fmt = ESP_AAC_BSF_FMT_LOAS,
+        .mux_config_interval = 5,
+    };
+    int loas_size = aac_bsf_convert(&cfg, adts, adts_size, conv, &frames);
+    TEST_ASSERT_EQUAL_INT(MAX_ENCODED_FRAMES, frames);
+    cfg = (esp_aac_bsf_cfg_t) {
+        .in_fmt = ESP_AAC_BSF_FMT_LOAS,
+        .out_fmt = ESP_AAC_BSF_FMT_RAW,
+    };
+    TEST_ASSERT_EQUAL_INT(raw_total, aac_bsf_convert(&cfg, conv, loas_size, back, &frames));
+    TEST_ASSERT_EQUAL_INT(MAX_ENCODED_FRAMES, frames);
+    cfg.in_fmt = ESP_AAC_BSF_FMT_ADTS;
+    TEST_ASSERT_EQUAL_INT(raw_total, aac_bsf_convert(&cfg, adts, adts_size, conv, &frames));
+    TEST_ASSERT_EQUAL_MEMORY(conv, back, raw_total);
+    free(pcm);
+    free(adts);
+    free(conv);
+    free(back);
+    TEST_ASSERT_EQUAL_INT(heap_size, (int)esp_get_free_heap_size());
+}
+
+TEST_CASE("MP3 Encoder rate control and psychoacoustic modes", CODEC_TEST_MODULE_NAME)
+{
+    // Backup original heap size
+    int heap_size = esp_get_free_heap_size();
+    const struct {
+        int                    sample_rate;
+        int                    channel;
+        int                    bitrate;
+        esp_mp3_enc_rc_mode_t  rc_mode;
+        esp_mp3_enc_psy_mode_t psy_mode;
+    } mp3_test_cfg[] = {
+        {44100, 2, 128000, ESP_MP3_ENC_RC_MODE_CBR, ESP_MP3_ENC_PSY_MODE_NORMAL},
+        {48000, 2, 320000, ESP_MP3_ENC_RC_MODE_CBR, ESP_MP3_ENC_PSY_MODE_FAST},
+        {32000, 1, 32000, ESP_MP3_ENC_RC_MODE_CBR, ESP_MP3_ENC_PSY_MODE_NORMAL},
+        {22050, 2, 64000, ESP_MP3_ENC_RC_MODE_CBR, ESP_MP3_ENC_PSY_MODE_NORMAL},
+        {16000, 1, 24000, ESP_MP3_ENC_RC_MODE_CBR, ESP_MP3_ENC_PSY_MODE_FAST},
+        {44100, 2, 192000, ESP_MP3_ENC_RC_MODE_VBR, ESP_MP3_ENC_PSY_MODE_NORMAL},
+        {24000, 1, 0, ESP_MP3_ENC_RC_MODE_VBR, ESP_MP3_ENC_PSY_MODE_FAST},
+    };
+    for (int i = 0; i < sizeof(mp3_test_cfg) / sizeof(mp3_test_cfg[0]); i++) {
+        esp_mp3_enc_config_t mp3_cfg = ESP_MP3_ENC_CONFIG_DEFAULT();
+        mp3_cfg.sample_rate = mp3_test_cfg[i].sample_rate;
+        mp3_cfg.channel = mp3_test_cfg[i].channel;
+        mp3_cfg.bitrate = mp3_test_cfg[i].bitrate;
+        mp3_cfg.rc_mode = mp3_test_cfg[i].rc_mode;
+        mp3_cfg.psy_mode = mp3_test_cfg[i].psy_mode;
+        esp_audio_enc_handle_t encoder = NULL;
+        TEST_ESP_OK(esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &encoder));
+
+        int pcm_size = 0, raw_size = 0;
+        esp_mp3_enc_get_frame_size(encoder, &pcm_size, &raw_size);
+        uint8_t *pcm_data = malloc(MAX_ENCODED_FRAMES * pcm_size);
+        uint8_t *raw_data = malloc(raw_size);
+        TEST_ASSERT_NOT_NULL(pcm_data);
+        TEST_ASSERT_NOT_NULL(raw_data);
+        audio_info_t aud_info = {
+            .sample_rate = mp3_cfg.sample_rate,
+            .bits_per_sample = mp3_cfg.bits_per_sample,
+            .channel = mp3_cfg.channel,
+        };
+        audio_codec_gen_pcm(&aud_info, pcm_data, MAX_ENCODED_FRAMES * pcm_size);
+
+        for (int j = 0; j < MAX_ENCODED_FRAMES; j++) {
+            esp_audio_enc_in_frame_t in_frame = {
+                .buffer = pcm_data + pcm_size * j,
+                .len = pcm_size,
+            };
+            esp_audio_enc_out_frame_t out_frame = {
+                .buffer = raw_data,
+                .len = raw_size,
+            };
+            TEST_ESP_OK(esp_mp3_enc_process(encoder, &in_frame, &out_frame));
+            TEST_ASSERT_GREATER_THAN(4, out_frame.encoded_bytes);
+            TEST_ASSERT_LESS_OR_EQUAL(raw_size, out_frame.encoded_bytes);
+            // Every output frame starts with frame sync
+            TEST_ASSERT_EQUAL_HEX8(0xFF, raw_data[0]);
+            TEST_ASSERT_EQUAL_HEX8(0xE0, raw_data[1] & 0xE0);
+        }
+        // Input less than one frame is rejected
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = pcm_data,
+            .len = pcm_size - 1,
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = raw_data,
+            .len = raw_size,
+        };
+        TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_DATA_LACK, esp_mp3_enc_process(encoder, &in_frame, &out_frame));
+        esp_mp3_enc_close(encoder);
+        free(pcm_data);
+        free(raw_data);
+    }
+    TEST_ASSERT_EQUAL_INT(heap_size, (int)esp_get_free_heap_size());
+}
+
+TEST_CASE("LC3 batch encoder multi-BIS test", CODEC_TEST_MODULE_NAME)
+{
+    // Backup original heap size
+    int heap_size = esp_get_free_heap_size();
+    // Auracast typical setup: 48kHz 10ms, stereo plus two language tracks
+    esp_lc3_batch_enc_config_t batch_cfg = ESP_LC3_BATCH_ENC_CONFIG_DEFAULT();
+    batch_cfg.bis_num = 4;
+    const uint16_t nbyte[] = {100, 100, 60, 40};
+    memcpy(batch_cfg.nbyte, nbyte, sizeof(nbyte));
+    esp_lc3_batch_enc_handle_t batch = NULL;
+    TEST_ESP_OK(esp_lc3_batch_enc_open(&batch_cfg, &batch));
+    int in_size = 0;
+    int out_size[ESP_LC3_BATCH_ENC_MAX_BIS] = {0};
+    TEST_ESP_OK(esp_lc3_batch_enc_get_frame_size(batch, &in_size, out_size));
+    TEST_ASSERT_EQUAL_INT(480 * sizeof(int16_t), in_size);
+
+    // Reference encoders for each BIS
+    void *single[4] = {NULL};
+    for (int i = 0; i < batch_cfg.bis_num; i++) {
+        esp_lc3_enc_config_t lc3_cfg = ESP_LC3_ENC_CONFIG_DEFAULT();
+        lc3_cfg.nbyte = nbyte[i];
+        TEST_ESP_OK(esp_lc3_enc_open(&lc3_cfg, sizeof(esp_lc3_enc_config_t), &single[i]));
+    }
+    const int frames = 10;
+    int pcm_size = in_size * batch_cfg.bis_num * frames;
+    uint8_t *pcm = malloc(pcm_size);
+    uint8_t *ch_pcm = malloc(in_size);
+    uint8_t *ref = malloc(out_size[0]);
+    TEST_ASSERT_NOT_NULL(pcm);
+    TEST_ASSERT_NOT_NULL(ch_pcm);
+    TEST_ASSERT_NOT_NULL(ref);
+    gen_mc_pcm(batch_cfg.sample_rate, batch_cfg.bis_num, batch_cfg.bits_per_sample, pcm, 480 * frames);
+    uint8_t *packet[4];
+    esp_audio_enc_out_frame_t out[4];
+    for (int i = 0; i < batch_cfg.bis_num; i++) {
+        packet[i] = malloc(out_size[i]);
+        TEST_ASSERT_NOT_NULL(packet[i]);
+    }
+    // Run 1 second and check each BIS packet equal to separated encoder
+    int64_t encode_time = 0;
+    const int loops = 100;
+    for (int n = 0; n < loops; n++) {
+        int16_t *frame_pcm = (int16_t *)(pcm + (n % frames) * in_size * batch_cfg.bis_num);
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = (uint8_t *)frame_pcm,
+            .len = in_size * batch_cfg.bis_num,
+        };
+        for (int i = 0; i < batch_cfg.bis_num; i++) {
+            out[i] = (esp_audio_enc_out_frame_t) {
+                .buffer = packet[i],
+                .len = out_size[i],
+            };
+        }
+        int64_t start = esp_timer_get_time();
+        TEST_ESP_OK(esp_lc3_batch_enc_process_interleaved(batch, &in_frame, out));
+        encode_time += esp_timer_get_time() - start;
+        TEST_ASSERT_EQUAL_INT(n * 10, (int)out[0].pts);
+        for (int i = 0; i < batch_cfg.bis_num; i++) {
+            int16_t *ch = (int16_t *)ch_pcm;
+            for (int s = 0; s < 480; s++) {
+                ch[s] = frame_pcm[s * batch_cfg.bis_num + i];
+            }
+            esp_audio_enc_in_frame_t ch_in = {
+                .buffer = ch_pcm,
+                .len = in_size,
+            };
+            esp_audio_enc_out_frame_t ref_out = {
+                .buffer = ref,
+                .len = out_size[0],
+            };
+            TEST_ESP_OK(esp_lc3_enc_process(single[i], &ch_in, &ref_out));
+            TEST_ASSERT_EQUAL_INT(nbyte[i], out[i].encoded_bytes);
+            TEST_ASSERT_EQUAL_INT(ref_out.encoded_bytes, out[i].encoded_bytes);
+            TEST_ASSERT_EQUAL_MEMORY(ref, packet[i], out[i].encoded_bytes);
+        }
+    }
+    float cpu_usage = (float)encode_time * 100 / (loops * 10000);
+    ESP_LOGI(TAG, "LC3 batch encoder 4 BIS 48kHz 10ms cpu: %.2f%%", cpu_usage);
+    TEST_ASSERT_LESS_THAN(100, (int)cpu_usage);
+
+    // Change bitrate of one BIS on the fly
+    TEST_ESP_OK(esp_lc3_batch_enc_set_nbyte(batch, 3, 80));
+    TEST_ESP_OK(esp_lc3_batch_enc_get_frame_size(batch, &in_size, out_size));
+    free(packet[3]);
+    packet[3] = malloc(out_size[3]);
+    TEST_ASSERT_NOT_NULL(packet[3]);
+    esp_audio_enc_in_frame_t in[4];
+    for (int i = 0; i < batch_cfg.bis_num; i++) {
+        in[i] = (esp_audio_enc_in_frame_t) {
+            .buffer = ch_pcm,
+            .len = in_size,
+        };
+        out[i] = (esp_audio_enc_out_frame_t) {
+            .buffer = packet[i],
+            .len = out_size[i],
+        };
+    }
+    TEST_ESP_OK(esp_lc3_batch_enc_process(batch, in, out));
+    TEST_ASSERT_EQUAL_INT(80, out[3].encoded_bytes);
+    TEST_ESP_OK(esp_lc3_batch_enc_reset(batch));
+    esp_lc3_batch_enc_close(batch);
+    for (int i = 0; i < batch_cfg.bis_num; i++) {
+        esp_lc3_enc_close(single[i]);
+        free(packet[i]);
+    }
+    free(pcm);
+    free(ch_pcm);
+    free(ref);
+    TEST_ASSERT_EQUAL_INT(heap_size, (int)esp_get_free_heap_size());
+}
+
 TEST_CASE("Encoder query frame information test", CODEC_TEST_MODULE_NAME)
 {
     esp_audio_enc_register_default();
@@ -515,6 +992,28 @@ TEST_CASE("Encoder query frame information test", CODEC_TEST_MODULE_NAME)
     TEST_ASSERT_NOT_EQUAL(prev_out_size, out_size);
     esp_g722_enc_close(enc_hd);
 
+    // test mp3
+    esp_mp3_enc_config_t mp3_cfg = ESP_MP3_ENC_CONFIG_DEFAULT();
+    esp_mp3_enc_get_frame_info_by_cfg(&mp3_cfg, &frame_info);
+    esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &enc_hd);
+    esp_mp3_enc_get_frame_size(enc_hd, &in_size, &out_size);
+    TEST_ASSERT_EQUAL_INT(frame_info.in_frame_size, in_size);
+    TEST_ASSERT_EQUAL_INT(frame_info.out_frame_size, out_size);
+    prev_out_size = out_size;
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_OK, esp_mp3_enc_set_bitrate(enc_hd, 64000));
+    esp_mp3_enc_get_frame_size(enc_hd, &in_size, &out_size);
+    TEST_ASSERT_NOT_EQUAL(prev_out_size, out_size);
+    esp_mp3_enc_close(enc_hd);
+
+    // test flac
+    esp_flac_enc_config_t flac_cfg = ESP_FLAC_ENC_CONFIG_DEFAULT();
+    esp_flac_enc_get_frame_info_by_cfg(&flac_cfg, &frame_info);
+    esp_flac_enc_open(&flac_cfg, sizeof(esp_flac_enc_config_t), &enc_hd);
+    esp_flac_enc_get_frame_size(enc_hd, &in_size, &out_size);
+    TEST_ASSERT_EQUAL_INT(frame_info.in_frame_size, in_size);
+    TEST_ASSERT_EQUAL_INT(frame_info.out_frame_size, out_size);
+    esp_flac_enc_close(enc_hd);
+
     esp_audio_enc_unregister_default();
 }
 
@@ -599,6 +1098,35 @@ TEST_CASE("Encoder bitrate test", CODEC_TEST_MODULE_NAME)
     TEST_ASSERT_EQUAL(enc_info.bitrate, 56000);
     esp_g722_enc_close(enc_hd);
 
+    esp_mp3_enc_config_t mp3_cfg = ESP_MP3_ENC_CONFIG_DEFAULT();
+    esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &enc_hd);
+    TEST_ASSERT_NOT_NULL(enc_hd);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_set_bitrate(enc_hd, 96000), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_get_info(enc_hd, &enc_info), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(enc_info.bitrate, 96000);
+    // Bitrate not in the table is reported as the coded one
+    TEST_ASSERT_EQUAL(esp_mp3_enc_set_bitrate(enc_hd, 100000), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_get_info(enc_hd, &enc_info), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(enc_info.bitrate, 96000);
+    esp_mp3_enc_close(enc_hd);
+    mp3_cfg.sample_rate = 24000;
+    mp3_cfg.bitrate = 320000;
+    esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &enc_hd);
+    TEST_ASSERT_NOT_NULL(enc_hd);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_get_info(enc_hd, &enc_info), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(enc_info.bitrate, 160000);
+    // 0 is only valid in VBR mode, same as open
+    TEST_ASSERT_EQUAL(esp_mp3_enc_set_bitrate(enc_hd, 0), ESP_AUDIO_ERR_INVALID_PARAMETER);
+    esp_mp3_enc_close(enc_hd);
+    mp3_cfg.rc_mode = ESP_MP3_ENC_RC_MODE_VBR;
+    mp3_cfg.bitrate = 64000;
+    esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &enc_hd);
+    TEST_ASSERT_NOT_NULL(enc_hd);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_set_bitrate(enc_hd, 0), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(esp_mp3_enc_get_info(enc_hd, &enc_info), ESP_AUDIO_ERR_OK);
+    TEST_ASSERT_EQUAL(enc_info.bitrate, 160000);
+    esp_mp3_enc_close(enc_hd);
+
     esp_audio_enc_unregister_default();
 }
 
@@ -609,3 +1137,61 @@ TEST_CASE("Encoder query type", CODEC_TEST_MODULE_NAME)
     TEST_ASSERT_EQUAL(esp_audio_enc_check_audio_type(ESP_AUDIO_TYPE_AMRNB), ESP_AUDIO_ERR_OK);
     esp_audio_enc_unregister_default();
 }
+
+TEST_CASE("Encoder cost model and selection", CODEC_TEST_MODULE_NAME)
+{
+    esp_audio_codec_select_req_t req = {
+        .min_sample_rate = 48000,
+        .channel = 2,
+        .max_bitrate = 256000,
+    };
+    esp_audio_codec_select_res_t res = {0};
+    // Only registered encoders take part in selection
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_NOT_FOUND, esp_audio_codec_cost_select(ESP_AUDIO_CODEC_DIR_ENC, &req, &res));
+    esp_audio_enc_register_default();
+    TEST_ESP_OK(esp_audio_codec_cost_select(ESP_AUDIO_CODEC_DIR_ENC, &req, &res));
+    ESP_LOGI(TAG, "Selected %s bitrate:%d cycles:%d delay:%dms", esp_audio_codec_get_name(res.cost.type),
+             (int)res.bitrate, (int)res.cycles, (int)res.delay_ms);
+    TEST_ASSERT_TRUE(res.bitrate <= req.max_bitrate);
+
+    // Measure AAC on current chip and publish it
+    esp_aac_enc_config_t aac_cfg = ESP_AAC_ENC_CONFIG_DEFAULT();
+    aac_cfg.sample_rate = 48000;
+    aac_cfg.bitrate = 128000;
+    esp_audio_enc_config_t enc_cfg = {
+        .type = ESP_AUDIO_TYPE_AAC,
+        .cfg = &aac_cfg,
+        .cfg_sz = sizeof(aac_cfg),
+    };
+    esp_audio_codec_cost_t cost = {0};
+    TEST_ESP_OK(esp_audio_codec_cost_measure_enc(&enc_cfg, 20, &cost));
+    ESP_LOGI(TAG, "AAC cycles per frame per channel:%d ram:%d psram:%d", (int)cost.cycles_per_frame,
+             (int)cost.ram_size, (int)cost.psram_size);
+    TEST_ASSERT_EQUAL(1024, cost.frame_samples);
+    TEST_ASSERT_TRUE(cost.cycles_per_frame > 0);
+    TEST_ASSERT_TRUE(cost.ram_size + cost.psram_size > 0);
+    // Delay and bitrate range are kept from built-in figures
+    TEST_ASSERT_EQUAL(2048, cost.delay_samples);
+    TEST_ESP_OK(esp_audio_codec_cost_publish(&cost));
+    esp_audio_codec_cost_t get_cost = {0};
+    TEST_ESP_OK(esp_audio_codec_cost_get(ESP_AUDIO_CODEC_DIR_ENC, ESP_AUDIO_TYPE_AAC, 48000, 2, &get_cost));
+    TEST_ASSERT_EQUAL_MEMORY(&cost, &get_cost, sizeof(cost));
+
+    // Downgrade under CPU pressure: budget lower than selected one picks a cheaper codec or none
+    req.max_cycles = res.cycles - 1;
+    esp_audio_codec_select_res_t low = {0};
+    esp_audio_err_t ret = esp_audio_codec_cost_select(ESP_AUDIO_CODEC_DIR_ENC, &req, &low);
+    if (ret == ESP_AUDIO_ERR_OK) {
+        TEST_ASSERT_TRUE(low.cycles < res.cycles);
+    } else {
+        TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_NOT_FOUND, ret);
+    }
+    // Latency target
+    req.max_cycles = 0;
+    req.max_delay_ms = 10;
+    if (esp_audio_codec_cost_select(ESP_AUDIO_CODEC_DIR_ENC, &req, &low) == ESP_AUDIO_ERR_OK) {
+        TEST_ASSERT_TRUE(low.delay_ms <= 10);
+    }
+    esp_audio_codec_cost_clear();
+    esp_audio_enc_unregister_default();
+}
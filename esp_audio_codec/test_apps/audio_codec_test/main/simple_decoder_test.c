@@ -7,6 +7,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "sdkconfig.h"
 #include "unity.h"
 #include "esp_err.h"
@@ -20,6 +21,9 @@
 #include "esp_audio_enc.h"
 #include "esp_audio_enc_reg.h"
 #include "esp_audio_enc_default.h"
+#include "esp_audio_gapless.h"
+#include "esp_audio_simple_dec_cvt.h"
+#include "esp_audio_simple_dec_aligned.h"
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "test_common.h"
@@ -805,6 +809,208 @@ TEST_CASE("AAC simple decoder with frame test", CODEC_TEST_MODULE_NAME)
     free(decode_data);
 }
 
+TEST_CASE("FLAC encoder lossless with simple decoder test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_flac_enc_register());
+    TEST_ESP_OK(esp_flac_dec_register());
+    TEST_ESP_OK(esp_audio_simple_dec_register_default());
+    const struct {
+        int     sample_rate;
+        uint8_t channel;
+        uint8_t compression_level;
+    } flac_test_cfg[] = {
+        {48000, 2, 0},
+        {48000, 2, 5},
+        {44100, 1, 8},
+    };
+    for (int i = 0; i < sizeof(flac_test_cfg) / sizeof(flac_test_cfg[0]); i++) {
+        esp_flac_enc_config_t flac_cfg = ESP_FLAC_ENC_CONFIG_DEFAULT();
+        flac_cfg.sample_rate = flac_test_cfg[i].sample_rate;
+        flac_cfg.channel = flac_test_cfg[i].channel;
+        flac_cfg.compression_level = flac_test_cfg[i].compression_level;
+        esp_audio_enc_config_t enc_cfg = {
+            .type = ESP_AUDIO_TYPE_FLAC,
+            .cfg = &flac_cfg,
+            .cfg_sz = sizeof(flac_cfg)};
+        esp_audio_enc_handle_t encoder = NULL;
+        TEST_ESP_OK(esp_audio_enc_open(&enc_cfg, &encoder));
+        int pcm_size = 0, raw_size = 0;
+        esp_audio_enc_get_frame_size(encoder, &pcm_size, &raw_size);
+        // Several full frames followed by a short last frame
+        int frames = 10;
+        int sample_size = flac_cfg.channel * (flac_cfg.bits_per_sample >> 3);
+        int total_pcm = frames * pcm_size + 100 * sample_size;
+        uint8_t *pcm_data = malloc(total_pcm);
+        uint8_t *raw_data = malloc((frames + 1) * raw_size + 64);
+        uint8_t *decode_data = malloc(total_pcm);
+        TEST_ASSERT_NOT_NULL(pcm_data);
+        TEST_ASSERT_NOT_NULL(raw_data);
+        TEST_ASSERT_NOT_NULL(decode_data);
+        audio_info_t aud_info = {
+            .sample_rate = flac_cfg.sample_rate,
+            .bits_per_sample = flac_cfg.bits_per_sample,
+            .channel = flac_cfg.channel,
+        };
+        audio_codec_gen_pcm(&aud_info, pcm_data, total_pcm);
+
+        int raw_len = 0;
+        esp_audio_enc_info_t enc_info = {};
+        TEST_ESP_OK(esp_audio_enc_get_info(encoder, &enc_info));
+        TEST_ASSERT_EQUAL(42, enc_info.spec_info_len);
+        raw_len = enc_info.spec_info_len;
+        for (int pos = 0; pos < total_pcm;) {
+            esp_audio_enc_in_frame_t in_frame = {
+                .buffer = pcm_data + pos,
+                .len = (total_pcm - pos) > pcm_size ? pcm_size : total_pcm - pos,
+            };
+            esp_audio_enc_out_frame_t out_frame = {
+                .buffer = raw_data + raw_len,
+                .len = raw_size,
+            };
+            TEST_ESP_OK(esp_audio_enc_process(encoder, &in_frame, &out_frame));
+            // Every output frame starts with frame sync of fixed block size
+            TEST_ASSERT_EQUAL_HEX8(0xFF, raw_data[raw_len]);
+            TEST_ASSERT_EQUAL_HEX8(0xF8, raw_data[raw_len + 1]);
+            raw_len += out_frame.encoded_bytes;
+            pos += in_frame.len;
+        }
+        // Stream header carries final frame size range and total samples
+        TEST_ESP_OK(esp_audio_enc_get_info(encoder, &enc_info));
+        memcpy(raw_data, enc_info.codec_spec_info, enc_info.spec_info_len);
+        TEST_ASSERT_EQUAL_MEMORY("fLaC", raw_data, 4);
+        TEST_ASSERT_LESS_THAN(total_pcm, raw_len);
+        esp_audio_enc_close(encoder);
+
+        simp_dec_all_t all_cfg = {};
+        esp_audio_simple_dec_cfg_t dec_cfg = {
+            .dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_FLAC,
+            .dec_cfg = &all_cfg,
+        };
+        esp_audio_simple_dec_handle_t decoder = NULL;
+        TEST_ESP_OK(esp_audio_simple_dec_open(&dec_cfg, &decoder));
+        esp_audio_simple_dec_raw_t dec_raw = {
+            .buffer = raw_data,
+            .len = raw_len,
+            .eos = true,
+        };
+        int decoded = 0;
+        while (dec_raw.len) {
+            esp_audio_simple_dec_out_t dec_out = {
+                .buffer = decode_data + decoded,
+                .len = total_pcm - decoded,
+            };
+            TEST_ESP_OK(esp_audio_simple_dec_process(decoder, &dec_raw, &dec_out));
+            decoded += dec_out.decoded_size;
+            dec_raw.len -= dec_raw.consumed;
+            dec_raw.buffer += dec_raw.consumed;
+        }
+        // Decoded data must be bit exact with original input
+        TEST_ASSERT_EQUAL_INT(total_pcm, decoded);
+        TEST_ASSERT_EQUAL_MEMORY(pcm_data, decode_data, total_pcm);
+        esp_audio_simple_dec_close(decoder);
+        free(pcm_data);
+        free(raw_data);
+        free(decode_data);
+    }
+    esp_audio_simple_dec_unregister_default();
+    esp_audio_dec_unregister_default();
+    esp_audio_enc_unregister_default();
+}
+
+TEST_CASE("MP3 gapless tag and trimming test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_mp3_dec_register());
+    TEST_ESP_OK(esp_audio_simple_dec_register_default());
+    esp_mp3_enc_config_t mp3_cfg = ESP_MP3_ENC_CONFIG_DEFAULT();
+    esp_audio_enc_handle_t encoder = NULL;
+    TEST_ESP_OK(esp_mp3_enc_open(&mp3_cfg, sizeof(esp_mp3_enc_config_t), &encoder));
+    int pcm_size = 0, raw_size = 0, tag_size = 0;
+    esp_mp3_enc_get_frame_size(encoder, &pcm_size, &raw_size);
+    TEST_ESP_OK(esp_mp3_enc_get_info_tag(encoder, 0, NULL, &tag_size));
+    int sample_size = mp3_cfg.channel * (mp3_cfg.bits_per_sample >> 3);
+    int frame_samples = pcm_size / sample_size;
+    // Valid samples not aligned to frame, append silence to flush encoder and decoder delay
+    int valid_samples = 10 * frame_samples + 333;
+    int frames = (valid_samples + ESP_MP3_ENC_DELAY_SAMPLES + ESP_MP3_ENC_DECODER_DELAY + frame_samples - 1) / frame_samples;
+    uint8_t *pcm_data = calloc(1, frames * pcm_size);
+    uint8_t *raw_data = malloc(tag_size + frames * raw_size);
+    uint8_t *decode_data = malloc((frames + 1) * pcm_size);
+    TEST_ASSERT_NOT_NULL(pcm_data);
+    TEST_ASSERT_NOT_NULL(raw_data);
+    TEST_ASSERT_NOT_NULL(decode_data);
+    audio_info_t aud_info = {
+        .sample_rate = mp3_cfg.sample_rate,
+        .bits_per_sample = mp3_cfg.bits_per_sample,
+        .channel = mp3_cfg.channel,
+    };
+    audio_codec_gen_pcm(&aud_info, pcm_data, valid_samples * sample_size);
+
+    // Reserve space for tag frame then encode all frames
+    int raw_len = tag_size;
+    for (int i = 0; i < frames; i++) {
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = pcm_data + i * pcm_size,
+            .len = pcm_size,
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = raw_data + raw_len,
+            .len = raw_size,
+        };
+        TEST_ESP_OK(esp_mp3_enc_process(encoder, &in_frame, &out_frame));
+        raw_len += out_frame.encoded_bytes;
+    }
+    // Valid samples must leave padding for decoder delay
+    int size = tag_size;
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_INVALID_PARAMETER, esp_mp3_enc_get_info_tag(encoder, frames * frame_samples, raw_data, &size));
+    TEST_ESP_OK(esp_mp3_enc_get_info_tag(encoder, valid_samples, raw_data, &size));
+    TEST_ASSERT_EQUAL_INT(tag_size, size);
+    esp_mp3_enc_close(encoder);
+
+    esp_audio_gapless_info_t gapless = {};
+    TEST_ESP_OK(esp_audio_gapless_parse(ESP_AUDIO_SIMPLE_DEC_TYPE_MP3, raw_data, raw_len, &gapless));
+    TEST_ASSERT_EQUAL_INT(ESP_MP3_ENC_DELAY_SAMPLES, gapless.enc_delay);
+    TEST_ASSERT_EQUAL_INT(ESP_MP3_ENC_DECODER_DELAY, gapless.dec_delay);
+    TEST_ASSERT_EQUAL_INT(valid_samples, (int)gapless.valid_samples);
+
+    esp_audio_simple_dec_cfg_t dec_cfg = {
+        .dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_MP3,
+    };
+    esp_audio_simple_dec_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_simple_dec_open(&dec_cfg, &decoder));
+    esp_audio_gapless_handle_t trim = NULL;
+    TEST_ESP_OK(esp_audio_gapless_open(&gapless, &trim));
+    esp_audio_simple_dec_raw_t dec_raw = {
+        .buffer = raw_data,
+        .len = raw_len,
+        .eos = true,
+    };
+    int decoded = 0;
+    while (dec_raw.len) {
+        esp_audio_simple_dec_out_t dec_out = {
+            .buffer = decode_data + decoded,
+            .len = (frames + 1) * pcm_size - decoded,
+        };
+        TEST_ESP_OK(esp_audio_simple_dec_process(decoder, &dec_raw, &dec_out));
+        if (dec_out.decoded_size) {
+            esp_audio_simple_dec_info_t dec_info = {};
+            TEST_ESP_OK(esp_audio_simple_dec_get_info(decoder, &dec_info));
+            TEST_ESP_OK(esp_audio_gapless_process(trim, &dec_info, &dec_out));
+        }
+        decoded += dec_out.decoded_size;
+        dec_raw.len -= dec_raw.consumed;
+        dec_raw.buffer += dec_raw.consumed;
+    }
+    // Output is trimmed to exactly the valid input samples
+    TEST_ASSERT_EQUAL_INT(valid_samples * sample_size, decoded);
+    esp_audio_gapless_close(trim);
+    esp_audio_simple_dec_close(decoder);
+    free(pcm_data);
+    free(raw_data);
+    free(decode_data);
+    esp_audio_simple_dec_unregister_default();
+    esp_audio_dec_unregister(ESP_AUDIO_TYPE_MP3);
+}
+
 TEST_CASE("Simple decoder decode with error data test", CODEC_TEST_MODULE_NAME)
 {
     esp_audio_simple_dec_type_t types[] = {
@@ -849,3 +1055,368 @@ TEST_CASE("Simple decoder decode with error data test", CODEC_TEST_MODULE_NAME)
     }
     esp_board_manager_deinit();
 }
+
+static int simple_dec_cvt_run(esp_pcm_dec_cfg_t *pcm_cfg, esp_audio_simple_dec_cvt_cfg_t *cfg,
+                              uint8_t *in, int in_size, uint8_t *out, int out_size)
+{
+    cfg->dec_cfg.dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_PCM;
+    cfg->dec_cfg.dec_cfg = pcm_cfg;
+    cfg->dec_cfg.cfg_size = sizeof(esp_pcm_dec_cfg_t);
+    esp_audio_simple_dec_cvt_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_simple_dec_cvt_open(cfg, &decoder));
+    esp_audio_simple_dec_raw_t raw = {
+        .buffer = in,
+        .len = in_size,
+        .eos = true,
+    };
+    // Start with small output buffer to verify buffer not enough handling
+    esp_audio_simple_dec_out_t frame = {
+        .buffer = malloc(64),
+        .len = 64,
+    };
+    TEST_ASSERT_NOT_NULL(frame.buffer);
+    int decoded = 0;
+    while (1) {
+        esp_audio_err_t ret = esp_audio_simple_dec_cvt_process(decoder, &raw, &frame);
+        if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+            TEST_ASSERT_EQUAL_INT(0, raw.consumed);
+            uint8_t *new_buf = realloc(frame.buffer, frame.needed_size);
+            TEST_ASSERT_NOT_NULL(new_buf);
+            frame.buffer = new_buf;
+            frame.len = frame.needed_size;
+            continue;
+        }
+        TEST_ESP_OK(ret);
+        TEST_ASSERT_LESS_OR_EQUAL(out_size, decoded + frame.decoded_size);
+        memcpy(out + decoded, frame.buffer, frame.decoded_size);
+        decoded += frame.decoded_size;
+        if (raw.len == 0 && frame.decoded_size == 0) {
+            break;
+        }
+        raw.buffer += raw.consumed;
+        raw.len -= raw.consumed;
+    }
+    esp_audio_simple_dec_info_t info = {};
+    TEST_ESP_OK(esp_audio_simple_dec_cvt_get_info(decoder, &info));
+    TEST_ASSERT_EQUAL_INT(cfg->sample_rate ? cfg->sample_rate : pcm_cfg->sample_rate, info.sample_rate);
+    TEST_ASSERT_EQUAL_INT(cfg->channel ? cfg->channel : pcm_cfg->channel, info.channel);
+    TEST_ASSERT_EQUAL_INT(cfg->bits_per_sample ? cfg->bits_per_sample : pcm_cfg->bits_per_sample, info.bits_per_sample);
+    esp_audio_simple_dec_cvt_close(decoder);
+    free(frame.buffer);
+    return decoded;
+}
+
+TEST_CASE("Simple decoder with output conversion test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_pcm_dec_register());
+    esp_pcm_dec_cfg_t pcm_cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+    };
+    // 100ms 1KHz stereo tone with different level on each channel
+    int samples = pcm_cfg.sample_rate / 10;
+    int16_t *pcm = (int16_t *)malloc(samples * 2 * sizeof(int16_t));
+    uint8_t *out = (uint8_t *)malloc(samples * 2 * sizeof(int32_t));
+    TEST_ASSERT_NOT_NULL(pcm);
+    TEST_ASSERT_NOT_NULL(out);
+    for (int i = 0; i < samples; i++) {
+        int16_t v = (int16_t)(16000 * sin(2 * M_PI * 1000 * i / pcm_cfg.sample_rate));
+        pcm[2 * i] = v;
+        pcm[2 * i + 1] = v / 2;
+    }
+    int out_size = samples * 2 * sizeof(int32_t);
+
+    // Bits only conversion is bit exact
+    esp_audio_simple_dec_cvt_cfg_t cfg = {
+        .bits_per_sample = 32,
+    };
+    int size = simple_dec_cvt_run(&pcm_cfg, &cfg, (uint8_t *)pcm, samples * 4, out, out_size);
+    TEST_ASSERT_EQUAL_INT(samples * 2 * sizeof(int32_t), size);
+    int32_t *out32 = (int32_t *)out;
+    for (int i = 0; i < samples * 2; i++) {
+        TEST_ASSERT_EQUAL_INT32((int32_t)pcm[i] * 65536, out32[i]);
+    }
+
+    // Down mix to mono use average of channels by default
+    cfg = (esp_audio_simple_dec_cvt_cfg_t) {
+        .channel = 1,
+    };
+    size = simple_dec_cvt_run(&pcm_cfg, &cfg, (uint8_t *)pcm, samples * 4, out, out_size);
+    TEST_ASSERT_EQUAL_INT(samples * sizeof(int16_t), size);
+    int16_t *out16 = (int16_t *)out;
+    for (int i = 0; i < samples; i++) {
+        TEST_ASSERT_INT_WITHIN(1, (pcm[2 * i] + pcm[2 * i + 1]) / 2, out16[i]);
+    }
+
+    // Customized weight select right channel only
+    float weight[] = {0.0f, 1.0f};
+    cfg = (esp_audio_simple_dec_cvt_cfg_t) {
+        .channel = 1,
+        .weight = weight,
+        .weight_len = 2,
+    };
+    size = simple_dec_cvt_run(&pcm_cfg, &cfg, (uint8_t *)pcm, samples * 4, out, out_size);
+    TEST_ASSERT_EQUAL_INT(samples * sizeof(int16_t), size);
+    for (int i = 0; i < samples; i++) {
+        TEST_ASSERT_INT_WITHIN(1, pcm[2 * i + 1], out16[i]);
+    }
+
+    // Mono 16KHz 24 bits in one pass, output is time aligned with input
+    cfg = (esp_audio_simple_dec_cvt_cfg_t) {
+        .sample_rate = 16000,
+        .channel = 1,
+        .bits_per_sample = 24,
+    };
+    size = simple_dec_cvt_run(&pcm_cfg, &cfg, (uint8_t *)pcm, samples * 4, out, out_size);
+    int out_samples = samples / 3;
+    TEST_ASSERT_EQUAL_INT(out_samples * 3, size);
+    // Skip edges affected by stream start and end
+    for (int i = 32; i < out_samples - 32; i++) {
+        uint8_t *p = out + i * 3;
+        int32_t v = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) / 65536;
+        int32_t expect = (int32_t)(12000 * sin(2 * M_PI * 1000 * i / 16000));
+        TEST_ASSERT_INT_WITHIN(20, expect, v);
+    }
+    free(pcm);
+    free(out);
+    esp_audio_dec_unregister(ESP_AUDIO_TYPE_PCM);
+}
+
+static int simple_dec_aligned_run(esp_audio_simple_dec_type_t type, uint8_t *data, int size, int chunk, uint32_t *hash)
+{
+    esp_audio_simple_dec_cfg_t cfg = {
+        .dec_type = type,
+    };
+    esp_audio_simple_dec_aligned_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_simple_dec_aligned_open(&cfg, &decoder));
+    esp_audio_simple_dec_out_t frame = {
+        .buffer = malloc(1024),
+        .len = 1024,
+    };
+    TEST_ASSERT_NOT_NULL(frame.buffer);
+    int pos = 0;
+    int decoded = 0;
+    *hash = 2166136261u;
+    while (pos < size) {
+        int len = (chunk && size - pos > chunk) ? chunk : size - pos;
+        esp_audio_simple_dec_raw_t raw = {
+            .buffer = data + pos,
+            .len = len,
+            .eos = (pos + len == size),
+        };
+        while (raw.len) {
+            esp_audio_err_t ret = esp_audio_simple_dec_aligned_process(decoder, &raw, &frame);
+            if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+                uint8_t *new_buf = realloc(frame.buffer, frame.needed_size);
+                TEST_ASSERT_NOT_NULL(new_buf);
+                frame.buffer = new_buf;
+                frame.len = frame.needed_size;
+                continue;
+            }
+            TEST_ESP_OK(ret);
+            for (int i = 0; i < frame.decoded_size; i++) {
+                *hash = (*hash ^ frame.buffer[i]) * 16777619u;
+            }
+            decoded += frame.decoded_size;
+            raw.buffer += raw.consumed;
+            raw.len -= raw.consumed;
+            pos += raw.consumed;
+        }
+    }
+    esp_audio_simple_dec_info_t info = {};
+    TEST_ESP_OK(esp_audio_simple_dec_aligned_get_info(decoder, &info));
+    TEST_ASSERT_GREATER_THAN(0, info.sample_rate);
+    esp_audio_simple_dec_aligned_close(decoder);
+    free(frame.buffer);
+    return decoded;
+}
+
+TEST_CASE("Simple decoder frame aligned zero copy test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_mp3_dec_register());
+    uint8_t *data = (uint8_t *)test_mp3_start;
+    int size = (int)(test_mp3_end - test_mp3_start);
+
+    // Reference decoded size from simple decoder
+    esp_audio_simple_dec_cfg_t cfg = {
+        .dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_MP3,
+    };
+    esp_audio_simple_dec_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_simple_dec_open(&cfg, &decoder));
+    esp_audio_simple_dec_out_t frame = {
+        .buffer = malloc(4608),
+        .len = 4608,
+    };
+    TEST_ASSERT_NOT_NULL(frame.buffer);
+    esp_audio_simple_dec_raw_t raw = {
+        .buffer = data,
+        .len = size,
+        .eos = true,
+    };
+    int ref_size = 0;
+    while (raw.len) {
+        TEST_ESP_OK(esp_audio_simple_dec_process(decoder, &raw, &frame));
+        ref_size += frame.decoded_size;
+        raw.buffer += raw.consumed;
+        raw.len -= raw.consumed;
+    }
+    esp_audio_simple_dec_close(decoder);
+    free(frame.buffer);
+
+    // Whole input is decoded in place, chunked input cache only split frames, output must be same
+    uint32_t hash = 0, chunk_hash = 0;
+    int whole_size = simple_dec_aligned_run(ESP_AUDIO_SIMPLE_DEC_TYPE_MP3, data, size, 0, &hash);
+    int chunk_size = simple_dec_aligned_run(ESP_AUDIO_SIMPLE_DEC_TYPE_MP3, data, size, 333, &chunk_hash);
+    ESP_LOGI(TAG, "Decoded simple decoder %d aligned %d chunked %d", ref_size, whole_size, chunk_size);
+    TEST_ASSERT_EQUAL_INT(whole_size, chunk_size);
+    TEST_ASSERT_EQUAL_UINT32(hash, chunk_hash);
+    // Simple decoder may drop Xing/Info frame
+    TEST_ASSERT_INT_WITHIN(4608, ref_size, whole_size);
+    esp_audio_dec_unregister(ESP_AUDIO_TYPE_MP3);
+}
+
+typedef struct {
+    uint8_t *data;
+    int      pos;
+} latm_bit_writer_t;
+
+static void latm_put_bits(latm_bit_writer_t *w, uint32_t v, int n)
+{
+    for (int i = n - 1; i >= 0; i--) {
+        if ((w->pos & 7) == 0) {
+            w->data[w->pos >> 3] = 0;
+        }
+        w->data[w->pos >> 3] |= ((v >> i) & 1) << (7 - (w->pos & 7));
+        w->pos++;
+    }
+}
+
+static int latm_mux_frame(uint8_t *payload, int size, bool with_cfg, uint8_t sr_idx, uint8_t channel, uint8_t *out)
+{
+    latm_bit_writer_t w = {
+        .data = out + 3,
+    };
+    latm_put_bits(&w, with_cfg ? 0 : 1, 1);
+    if (with_cfg) {
+        // audioMuxVersion 0, allStreamsSameTimeFraming 1, numSubFrames 0, numProgram 0, numLayer 0
+        latm_put_bits(&w, 0, 1);
+        latm_put_bits(&w, 1, 1);
+        latm_put_bits(&w, 0, 6 + 4 + 3);
+        // AudioSpecificConfig for AAC-LC with GASpecificConfig all zero
+        latm_put_bits(&w, 2, 5);
+        latm_put_bits(&w, sr_idx, 4);
+        latm_put_bits(&w, channel, 4);
+        latm_put_bits(&w, 0, 3);
+        // frameLengthType 0, latmBufferFullness, no other data and CRC
+        latm_put_bits(&w, 0, 3);
+        latm_put_bits(&w, 0xFF, 8);
+        latm_put_bits(&w, 0, 2);
+    }
+    int len = size;
+    while (len >= 255) {
+        latm_put_bits(&w, 255, 8);
+        len -= 255;
+    }
+    latm_put_bits(&w, len, 8);
+    for (int i = 0; i < size; i++) {
+        latm_put_bits(&w, payload[i], 8);
+    }
+    int mux_size = (w.pos + 7) >> 3;
+    out[0] = 0x56;
+    out[1] = 0xE0 | (mux_size >> 8);
+    out[2] = mux_size & 0xFF;
+    return mux_size + 3;
+}
+
+TEST_CASE("Simple decoder LATM/LOAS test", CODEC_TEST_MODULE_NAME)
+{
+    TEST_ESP_OK(esp_latm_dec_register());
+    esp_aac_enc_config_t enc_cfg = ESP_AAC_ENC_CONFIG_DEFAULT();
+    enc_cfg.adts_used = false;
+    void *encoder = NULL;
+    TEST_ESP_OK(esp_aac_enc_open(&enc_cfg, sizeof(enc_cfg), &encoder));
+    int in_size = 0, out_size = 0;
+    TEST_ESP_OK(esp_aac_enc_get_frame_size(encoder, &in_size, &out_size));
+    const int frames = 20;
+    // Receiver tuned in late, leading frames refer to StreamMuxConfig not received
+    const int lead_frames = 2;
+    uint8_t *pcm = malloc(in_size);
+    uint8_t *aac = malloc(out_size);
+    uint8_t *loas = malloc(frames * (out_size + 32) + 8);
+    TEST_ASSERT_NOT_NULL(pcm);
+    TEST_ASSERT_NOT_NULL(aac);
+    TEST_ASSERT_NOT_NULL(loas);
+    audio_info_t aud_info = {
+        .sample_rate = enc_cfg.sample_rate,
+        .bits_per_sample = enc_cfg.bits_per_sample,
+        .channel = enc_cfg.channel,
+    };
+    audio_codec_gen_pcm(&aud_info, pcm, in_size);
+    // Garbage before first sync word
+    int loas_size = 5;
+    memset(loas, 0, loas_size);
+    for (int i = 0; i < frames; i++) {
+        esp_audio_enc_in_frame_t in_frame = {
+            .buffer = pcm,
+            .len = in_size,
+        };
+        esp_audio_enc_out_frame_t out_frame = {
+            .buffer = aac,
+            .len = out_size,
+        };
+        TEST_ESP_OK(esp_aac_enc_process(encoder, &in_frame, &out_frame));
+        // Repeat StreamMuxConfig periodically as broadcast does
+        bool with_cfg = (i >= lead_frames) && ((i - lead_frames) % 5 == 0);
+        loas_size += latm_mux_frame(aac, out_frame.encoded_bytes, with_cfg, 4, enc_cfg.channel, loas + loas_size);
+    }
+    esp_aac_enc_close(encoder);
+
+    esp_audio_simple_dec_cfg_t cfg = {
+        .dec_type = ESP_AUDIO_SIMPLE_DEC_TYPE_LATM,
+    };
+    esp_audio_simple_dec_handle_t decoder = NULL;
+    TEST_ESP_OK(esp_audio_simple_dec_open(&cfg, &decoder));
+    esp_audio_simple_dec_out_t frame = {
+        .buffer = malloc(in_size),
+        .len = in_size,
+    };
+    TEST_ASSERT_NOT_NULL(frame.buffer);
+    int pos = 0;
+    int decoded = 0;
+    while (pos < loas_size) {
+        int len = loas_size - pos > 100 ? 100 : loas_size - pos;
+        esp_audio_simple_dec_raw_t raw = {
+            .buffer = loas + pos,
+            .len = len,
+            .eos = (pos + len == loas_size),
+        };
+        while (raw.len) {
+            esp_audio_err_t ret = esp_audio_simple_dec_process(decoder, &raw, &frame);
+            if (ret == ESP_AUDIO_ERR_BUFF_NOT_ENOUGH) {
+                uint8_t *new_buf = realloc(frame.buffer, frame.needed_size);
+                TEST_ASSERT_NOT_NULL(new_buf);
+                frame.buffer = new_buf;
+                frame.len = frame.needed_size;
+                continue;
+            }
+            TEST_ESP_OK(ret);
+            decoded += frame.decoded_size;
+            raw.buffer += raw.consumed;
+            raw.len -= raw.consumed;
+        }
+        pos += len;
+    }
+    esp_audio_simple_dec_info_t info = {};
+    TEST_ESP_OK(esp_audio_simple_dec_get_info(decoder, &info));
+    ESP_LOGI(TAG, "LATM decoded %d sample_rate %d channel %d", decoded, (int)info.sample_rate, info.channel);
+    TEST_ASSERT_EQUAL_INT(enc_cfg.sample_rate, info.sample_rate);
+    TEST_ASSERT_EQUAL_INT(enc_cfg.channel, info.channel);
+    TEST_ASSERT_EQUAL_INT((frames - lead_frames) * in_size, decoded);
+    esp_audio_simple_dec_close(decoder);
+    free(frame.buffer);
+    free(pcm);
+    free(aac);
+    free(loas);
+    esp_latm_dec_unregister();
+}
@@ -0,0 +1,221 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_log.h"
+#include "esp_audio_dsp.h"
+#include "audio_codec_test.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include "esp_cpu.h"
+#endif  /* CONFIG_IDF_TARGET_LINUX */
+
+#define TAG "TEST_DSP"
+
+#define DSP_TEST_LEN  (960)
+#define DSP_TEST_TAPS (32)
+#define DSP_TEST_MDCT (36)
+#define DSP_TEST_LOOP (20)
+
+/**
+ * Stored vectors below are worked out separately with plain integer arithmetic, so the reference backend is verified
+ * on its own and not only against the vector backend.
+ * On a Linux host (`idf.py --preview set-target linux`) the test app builds the DSP kernels and this file only,
+ * AUTO then picks the vector backend on AVX2 or AArch64 machines. Benchmark reads the monotonic clock in ns there.
+ */
+#define DSP_VEC_N    (8)
+#define DSP_VEC_TAPS (4)
+
+static const int32_t dsp_vec_in[DSP_VEC_N + DSP_VEC_TAPS - 1] = {
+    268435456, -268435456, 123456789, -98765432, 2147483647, -2147483647 - 1, 1, -1, 65535, -65536, 7,
+};
+static const int32_t dsp_vec_b[DSP_VEC_N] = {1073741823, -536870912, 12345, -54321, 3, -3, 1 << 20, -(1 << 20)};
+static const int32_t dsp_vec_coef[DSP_VEC_TAPS] = {1 << 20, -(1 << 19), 3 << 18, -12345};
+// MDCT output is not saturated, keep input small enough for Q30 kernel
+static const int32_t dsp_vec_mdct_in[DSP_VEC_N] = {1 << 27, -(1 << 27), 99999999, -12345678, 0, 1, -1, 100000000};
+static const int32_t dsp_vec_kern[DSP_VEC_N / 2 * DSP_VEC_N] = {
+    1073741824, -1073741824, 536870912, -536870912, 268435456, -268435456, 134217728, -134217728,
+    759250125, 759250125, -759250125, -759250125, 0, 1073741823, 0, -1073741823,
+    12345678, -23456789, 34567890, -45678901, 56789012, -67890123, 78901234, -89012345,
+    1, -1, 2, -2, 3, -3, 4, -4,
+};
+static const int16_t dsp_vec_pcm[DSP_VEC_N] = {32767, -32768, 1, -1, 12345, -12345, 0, 256};
+
+static const int64_t dsp_vec_dot_out = 432352465957223074LL;
+static const int32_t dsp_vec_fir_out[DSP_VEC_N] = {
+    496408552, -429520484, 1808734800, -2147483647 - 1, 2147483647, -2147483647 - 1, 49924, -81921,
+};
+static const int32_t dsp_vec_mdct_out[DSP_VEC_N / 2] = {312108294, -161980964, -70020, 0};
+static const int32_t dsp_vec_imdct_out[DSP_VEC_N] = {
+    197569651, -426644602, 270589731, -41513330, 78023370, -240003610, 39008392, 122973232,
+};
+static const int16_t dsp_vec_intlv_out[DSP_VEC_N] = {32767, 32767, -32768, -32768, 30141, 0, -24113, 0};
+static const int32_t dsp_vec_deintlv_out[DSP_VEC_N] = {
+    1073709056, 32768, 404520960, 0, -1073741824, -32768, -404520960, 8388608,
+};
+
+typedef struct {
+    int32_t a[DSP_TEST_LEN + DSP_TEST_TAPS];
+    int32_t b[DSP_TEST_LEN + DSP_TEST_TAPS];
+    int32_t out[2][DSP_TEST_LEN];
+    int16_t pcm[2][DSP_TEST_LEN * 2];
+    int32_t kern[DSP_TEST_MDCT * DSP_TEST_MDCT / 2];
+} dsp_test_buf_t;
+
+#if CONFIG_IDF_TARGET_LINUX
+static inline uint32_t dsp_get_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+#else
+static inline uint32_t dsp_get_cycles(void)
+{
+    return esp_cpu_get_cycle_count();
+}
+#endif  /* CONFIG_IDF_TARGET_LINUX */
+
+static uint32_t dsp_rand(uint32_t *seed)
+{
+    *seed = *seed * 1664525 + 1013904223;
+    return *seed;
+}
+
+static void dsp_bench(const char *name, const esp_audio_dsp_ops_t *ops, dsp_test_buf_t *buf)
+{
+    esp_audio_dsp_mdct_t mdct = {
+        .n = DSP_TEST_MDCT,
+        .kern = buf->kern,
+    };
+    const int32_t *planar[2] = {buf->a, buf->b};
+    int32_t *dst[2] = {buf->out[0], buf->out[1]};
+    uint32_t cycles[6] = {0};
+    volatile int64_t sum = 0;
+    for (int i = 0; i < DSP_TEST_LOOP; i++) {
+        uint32_t start = dsp_get_cycles();
+        sum += ops->dot(buf->a, buf->b, DSP_TEST_LEN);
+        uint32_t t0 = dsp_get_cycles();
+        ops->fir(buf->a, DSP_TEST_TAPS, buf->b, buf->out[0], DSP_TEST_LEN, 31);
+        uint32_t t1 = dsp_get_cycles();
+        ops->mdct(&mdct, buf->a, buf->out[0]);
+        uint32_t t2 = dsp_get_cycles();
+        ops->imdct(&mdct, buf->out[0], buf->out[1]);
+        uint32_t t3 = dsp_get_cycles();
+        ops->interleave_s16(planar, 2, DSP_TEST_LEN, 16, buf->pcm[0]);
+        uint32_t t4 = dsp_get_cycles();
+        ops->deinterleave_s16(buf->pcm[0], 2, DSP_TEST_LEN, 16, dst);
+        uint32_t t5 = dsp_get_cycles();
+        cycles[0] += t0 - start;
+        cycles[1] += t1 - t0;
+        cycles[2] += t2 - t1;
+        cycles[3] += t3 - t2;
+        cycles[4] += t4 - t3;
+        cycles[5] += t5 - t4;
+    }
+    ESP_LOGI(TAG, "%s cycles dot:%d fir:%d mdct:%d imdct:%d interleave:%d deinterleave:%d", name,
+             (int)(cycles[0] / DSP_TEST_LOOP), (int)(cycles[1] / DSP_TEST_LOOP), (int)(cycles[2] / DSP_TEST_LOOP),
+             (int)(cycles[3] / DSP_TEST_LOOP), (int)(cycles[4] / DSP_TEST_LOOP), (int)(cycles[5] / DSP_TEST_LOOP));
+}
+
+static void dsp_check_vectors(const esp_audio_dsp_ops_t *ops)
+{
+    int32_t out[DSP_VEC_N];
+    int16_t pcm[DSP_VEC_N];
+    TEST_ASSERT_TRUE(ops->dot(dsp_vec_in, dsp_vec_b, DSP_VEC_N) == dsp_vec_dot_out);
+    ops->fir(dsp_vec_coef, DSP_VEC_TAPS, dsp_vec_in, out, DSP_VEC_N, 20);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(dsp_vec_fir_out, out, DSP_VEC_N);
+    esp_audio_dsp_mdct_t mdct = {
+        .n = DSP_VEC_N,
+        .kern = dsp_vec_kern,
+    };
+    int32_t coef[DSP_VEC_N / 2];
+    ops->mdct(&mdct, dsp_vec_mdct_in, coef);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(dsp_vec_mdct_out, coef, DSP_VEC_N / 2);
+    ops->imdct(&mdct, coef, out);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(dsp_vec_imdct_out, out, DSP_VEC_N);
+    const int32_t *planar[2] = {dsp_vec_in, dsp_vec_in + DSP_VEC_N / 2};
+    ops->interleave_s16(planar, 2, DSP_VEC_N / 2, 12, pcm);
+    TEST_ASSERT_EQUAL_INT16_ARRAY(dsp_vec_intlv_out, pcm, DSP_VEC_N);
+    int32_t *dst[2] = {out, out + DSP_VEC_N / 2};
+    ops->deinterleave_s16(dsp_vec_pcm, 2, DSP_VEC_N / 2, 15, dst);
+    TEST_ASSERT_EQUAL_INT32_ARRAY(dsp_vec_deintlv_out, out, DSP_VEC_N);
+}
+
+TEST_CASE("Audio DSP kernel stored vector test", CODEC_TEST_MODULE_NAME)
+{
+    const esp_audio_dsp_ops_t *ref = esp_audio_dsp_get_backend_ops(ESP_AUDIO_DSP_BACKEND_REF);
+    TEST_ASSERT_NOT_NULL(ref);
+    dsp_check_vectors(ref);
+    const esp_audio_dsp_ops_t *vec = esp_audio_dsp_get_backend_ops(ESP_AUDIO_DSP_BACKEND_VECTOR);
+    if (vec) {
+        dsp_check_vectors(vec);
+    }
+}
+
+TEST_CASE("Audio DSP kernel bit-exact and benchmark test", CODEC_TEST_MODULE_NAME)
+{
+    const esp_audio_dsp_ops_t *ref = esp_audio_dsp_get_backend_ops(ESP_AUDIO_DSP_BACKEND_REF);
+    const esp_audio_dsp_ops_t *vec = esp_audio_dsp_get_backend_ops(ESP_AUDIO_DSP_BACKEND_VECTOR);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(esp_audio_dsp_get_ops());
+    dsp_test_buf_t *buf = calloc(1, sizeof(dsp_test_buf_t));
+    TEST_ASSERT_NOT_NULL(buf);
+    uint32_t seed = 1;
+    for (int i = 0; i < DSP_TEST_LEN + DSP_TEST_TAPS; i++) {
+        // Mix of large and small values to hit saturation and rounding
+        // Coefficients keep 25 bits so 64 bits accumulation of full scale input has headroom
+        buf->a[i] = (int32_t)dsp_rand(&seed) >> (6 + (i & 15));
+        buf->b[i] = (int32_t)dsp_rand(&seed) >> ((i >> 4) & 15);
+    }
+    esp_audio_dsp_mdct_gen_kernel(DSP_TEST_MDCT, NULL, 9.0, buf->kern);
+    dsp_bench("Reference", ref, buf);
+    if (vec == NULL) {
+        ESP_LOGW(TAG, "Vector backend not built");
+        free(buf);
+        return;
+    }
+    dsp_bench("Vector", vec, buf);
+    // Check vector backend bit-exact against reference on all lengths including tails
+    esp_audio_dsp_mdct_t mdct = {
+        .n = DSP_TEST_MDCT,
+        .kern = buf->kern,
+    };
+    for (int n = 1; n <= 67; n += 3) {
+        TEST_ASSERT_TRUE(ref->dot(buf->a, buf->b, n) == vec->dot(buf->a, buf->b, n));
+        for (int shift = 0; shift <= 40; shift += 20) {
+            ref->fir(buf->a, n % DSP_TEST_TAPS + 1, buf->b, buf->out[0], n, shift);
+            vec->fir(buf->a, n % DSP_TEST_TAPS + 1, buf->b, buf->out[1], n, shift);
+            TEST_ASSERT_EQUAL_MEMORY(buf->out[0], buf->out[1], n * sizeof(int32_t));
+        }
+        int ch = n % 2 + 1;
+        const int32_t *planar[2] = {buf->a, buf->b};
+        ref->interleave_s16(planar, ch, n, n % 24, buf->pcm[0]);
+        vec->interleave_s16(planar, ch, n, n % 24, buf->pcm[1]);
+        TEST_ASSERT_EQUAL_MEMORY(buf->pcm[0], buf->pcm[1], n * ch * sizeof(int16_t));
+        int32_t *dst0[2] = {buf->out[0], buf->out[0] + n};
+        int32_t *dst1[2] = {buf->out[1], buf->out[1] + n};
+        ref->deinterleave_s16(buf->pcm[0], ch, n, n % 16, dst0);
+        vec->deinterleave_s16(buf->pcm[0], ch, n, n % 16, dst1);
+        TEST_ASSERT_EQUAL_MEMORY(buf->out[0], buf->out[1], n * ch * sizeof(int32_t));
+    }
+    ref->mdct(&mdct, buf->a, buf->out[0]);
+    vec->mdct(&mdct, buf->a, buf->out[1]);
+    TEST_ASSERT_EQUAL_MEMORY(buf->out[0], buf->out[1], DSP_TEST_MDCT / 2 * sizeof(int32_t));
+    ref->imdct(&mdct, buf->a, buf->out[0]);
+    vec->imdct(&mdct, buf->a, buf->out[1]);
+    TEST_ASSERT_EQUAL_MEMORY(buf->out[0], buf->out[1], DSP_TEST_MDCT * sizeof(int32_t));
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_OK, esp_audio_dsp_init(ESP_AUDIO_DSP_BACKEND_REF));
+    TEST_ASSERT_TRUE(esp_audio_dsp_get_ops() == ref);
+    TEST_ASSERT_EQUAL(ESP_AUDIO_ERR_OK, esp_audio_dsp_init(ESP_AUDIO_DSP_BACKEND_AUTO));
+    free(buf);
+}
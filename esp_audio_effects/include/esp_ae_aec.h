@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Acoustic Echo Cancellation (AEC) removes the far-end signal played by the speaker (reference) from
+ *         the microphone signal, for full duplex intercom and VoIP.
+ *
+ *         The echo path is modeled by a frequency domain adaptive filter of `filter_ms` length, partitioned
+ *         into blocks of one frame (multi-delay block frequency domain NLMS). The FFT length is the same as
+ *         `esp_ae_howl` (512 points below 32 kHz, otherwise 1024) and the frame is half of it.
+ *         A background filter adapts continuously and is copied to the foreground filter that produces the
+ *         output only when it cancels better, so near-end speech during double talk does not disturb the
+ *         output filter.
+ *
+ *         When `max_delay_ms` is not 0, the bulk delay between reference and echo (playback buffering, codec
+ *         and I2S latency) is estimated by matching binary band spectra of the two signals, and the filter
+ *         is aligned to it. The filter then only needs to cover the room reverberation instead of the whole
+ *         system delay.
+ *
+ *         The optional nonlinear processor (NLP) further attenuates the residual echo by the coherence
+ *         between the output and the estimated echo, it delays the output by one frame.
+ *
+ *         AEC processing is frame-based on mono data, microphone, reference and output have the same format:
+ *         frame_size_bytes = esp_ae_aec_get_frame_size(...);
+ *         samples = frame_size_bytes / (bits_per_sample >> 3).
+ *         Each `esp_ae_aec_process` call must use exactly one such frame of every signal.
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Range of echo tail length covered by the adaptive filter in milliseconds
+ */
+#define ESP_AE_AEC_MIN_FILTER_MS (16)
+#define ESP_AE_AEC_MAX_FILTER_MS (512)
+
+/**
+ * @brief  Maximum bulk delay in milliseconds between reference and echo handled by delay estimation
+ */
+#define ESP_AE_AEC_MAX_DELAY_MS (500)
+
+/**
+ * @brief  Handle of acoustic echo cancellation
+ */
+typedef void *esp_ae_aec_handle_t;
+
+/**
+ * @brief  Configuration structure for acoustic echo cancellation
+ */
+typedef struct {
+    uint32_t  sample_rate;      /*!< The audio sample rate; supported: 8000, 16000, 24000, 32000, 44100, 48000 */
+    uint8_t   bits_per_sample;  /*!< The audio bits per sample; supports 16, 24, 32 bits */
+    uint16_t  filter_ms;        /*!< Echo tail length, range [ESP_AE_AEC_MIN_FILTER_MS, ESP_AE_AEC_MAX_FILTER_MS].
+                                     Longer filters cover more reverberant rooms at higher CPU and memory cost */
+    uint16_t  max_delay_ms;     /*!< Maximum bulk delay to estimate, range [0, ESP_AE_AEC_MAX_DELAY_MS].
+                                     0 disables delay estimation, then the filter must cover the whole delay */
+    bool      enable_nlp;       /*!< Enable nonlinear residual echo suppression */
+    bool      use_psram;        /*!< Allocate reference spectra history and filters in PSRAM */
+} esp_ae_aec_cfg_t;
+
+/**
+ * @brief  Create an acoustic echo cancellation handle through configuration
+ *
+ * @note  The reference spectra history takes about `8 * (hop + 1) * (max_delay_frames + filter_frames + 1)`
+ *        bytes and the two filters take `16 * (hop + 1) * filter_frames` bytes, where hop is the frame length
+ *
+ * @param[in]   cfg     Acoustic echo cancellation configuration
+ * @param[out]  handle  The acoustic echo cancellation handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_aec_open(esp_ae_aec_cfg_t *cfg, esp_ae_aec_handle_t *handle);
+
+/**
+ * @brief  Get the frame size in bytes of one process call
+ *
+ * @param[in]   handle      The acoustic echo cancellation handle
+ * @param[out]  frame_size  Frame size in bytes of each of microphone, reference and output buffers
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_aec_get_frame_size(esp_ae_aec_handle_t handle, uint32_t *frame_size);
+
+/**
+ * @brief  Cancel echo of one frame
+ *
+ * @note  The reference must be the signal sent to the speaker, captured at the same sample clock as
+ *        the microphone. `out_samples` can be the same as `mic_samples` for inplace processing
+ *
+ * @param[in]   handle       The acoustic echo cancellation handle
+ * @param[in]   mic_samples  Microphone samples of one frame
+ * @param[in]   ref_samples  Reference samples of one frame
+ * @param[out]  out_samples  Echo cancelled samples of one frame
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_aec_process(esp_ae_aec_handle_t handle, esp_ae_sample_t mic_samples,
+                                esp_ae_sample_t ref_samples, esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Get the estimated bulk delay between reference and echo
+ *
+ * @param[in]   handle  The acoustic echo cancellation handle
+ * @param[out]  delay   Estimated delay in sampling points with a resolution of one frame,
+ *                      0 before an estimate is available or when delay estimation is disabled
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_aec_get_delay(esp_ae_aec_handle_t handle, uint32_t *delay);
+
+/**
+ * @brief  Reset the internal processing state, filters and delay estimate are learned again
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The acoustic echo cancellation handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_aec_reset(esp_ae_aec_handle_t handle);
+
+/**
+ * @brief  Deinitialize the acoustic echo cancellation handle
+ *
+ * @param  handle  The acoustic echo cancellation handle
+ */
+void esp_ae_aec_close(esp_ae_aec_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
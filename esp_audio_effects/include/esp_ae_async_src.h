@@ -0,0 +1,235 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Asynchronous sample rate converter (ASRC) converts between arbitrary sample rates and allows the
+ *         conversion ratio to be adjusted in runtime. It is used to absorb clock drift between a stream source
+ *         (RTP, Bluetooth, multi-room) and the local playback clock (I2S DAC), where both sides nominally run
+ *         at known rates but their crystals differ by hundreds of ppm.
+ *
+ *         Conversion uses a windowed-sinc polyphase filter, coefficients between two adjacent phases are
+ *         linearly interpolated (first order Farrow structure), so any fractional position can be produced.
+ *         The ratio is nudged by `esp_ae_async_src_set_ratio_ppm`, or by the built-in PI controller fed with
+ *         buffer fill level through `esp_ae_async_src_update_level`.
+ *
+ *         Processing is based on sampling points as processing units.
+ *         The relationship between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ *
+ *         Unlike `esp_ae_rate_cvt`, sample rates are not limited to multiples of 4000 or 11025.
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Default clamp of ratio adjustment in ppm
+ */
+#define ESP_AE_ASYNC_SRC_DEFAULT_MAX_PPM (1000)
+
+/**
+ * @brief  The handle of asynchronous sample rate converter
+ */
+typedef void *esp_ae_async_src_handle_t;
+
+/**
+ * @brief  Asynchronous sample rate converter configuration
+ */
+typedef struct {
+    uint32_t src_rate;         /*!< The nominal sample rate of input audio stream, range [4000, 192000] */
+    uint32_t dest_rate;        /*!< The nominal sample rate of output audio stream, range [4000, 192000] */
+    uint8_t  channel;          /*!< The audio channel number */
+    uint8_t  bits_per_sample;  /*!< Support bits per sample: 16, 24, 32 bit */
+    uint8_t  complexity;       /*!< Filter complexity. Range: 1~3;
+                                    1: 16 taps, 64 phases (lowest CPU usage);
+                                    2: 32 taps, 128 phases;
+                                    3: 64 taps, 128 phases (best audio quality).
+                                    Taps are multiplied and phases divided (down to 4) by `ceil(src_rate / dest_rate)`
+                                    when downsampling, so alias rejection does not depend on the ratio.
+                                    CPU usage per output sample grows with the ratio, e.g. 192000 to 4000 Hz with
+                                    complexity 3 runs 3072 taps per output sample */
+    uint16_t max_ppm;          /*!< Clamp of ratio adjustment in ppm, 0 means `ESP_AE_ASYNC_SRC_DEFAULT_MAX_PPM` */
+} esp_ae_async_src_cfg_t;
+
+/**
+ * @brief  PI controller configuration for drift compensation
+ *
+ * @note  The controller targets the fill level of a buffer between the two clock domains, either the one feeding
+ *        the converter input (e.g. jitter buffer) or the one after the converter output (e.g. I2S ring buffer).
+ *        In both cases a level above `target_level` means the source runs faster than the sink, the converter
+ *        then produces fewer output samples per input sample (negative ppm), and vice versa.
+ *        The ppm applied on each update is: -(kp * error + ki * sum(error)), clamped by `max_ppm`
+ */
+typedef struct {
+    uint32_t target_level;  /*!< Target fill level in samples per channel */
+    float    kp;            /*!< Proportional gain, ppm per sample of error */
+    float    ki;            /*!< Integral gain, ppm per sample of accumulated error per update */
+} esp_ae_async_src_pi_cfg_t;
+
+/**
+ * @brief  Create asynchronous sample rate converter handle through configuration
+ *
+ * @param[in]   cfg     Asynchronous sample rate converter configuration
+ * @param[out]  handle  The asynchronous sample rate converter handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_open(esp_ae_async_src_cfg_t *cfg, esp_ae_async_src_handle_t *handle);
+
+/**
+ * @brief  Get the minimum required sample number for the output buffer
+ *
+ * @note  The result takes `max_ppm` into account, so it stays valid whatever ratio adjustment is applied
+ *
+ * @param[in]   handle          The asynchronous sample rate converter handle
+ * @param[in]   in_sample_num   The number of input sampling points to process
+ * @param[out]  out_sample_num  Minimum number of sampling points for the output buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_get_max_out_sample_num(esp_ae_async_src_handle_t handle, uint32_t in_sample_num,
+                                                     uint32_t *out_sample_num);
+
+/**
+ * @brief  Perform asynchronous sample rate conversion on interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        All input samples are consumed, samples not yet converted are kept internally for next call
+ *
+ * @param[in]      handle          The asynchronous sample rate converter handle
+ * @param[in]      in_samples      The input samples buffer
+ * @param[in]      in_sample_num   The input samples number
+ * @param[out]     out_samples     The output samples buffer
+ * @param[in,out]  out_sample_num  For the input parameter, it represents the maximum number of samples in the output buffer,
+ *                                 which must not be less than the value from `esp_ae_async_src_get_max_out_sample_num`.
+ *                                 For the output parameter, it represents the actual number of output samples
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_process(esp_ae_async_src_handle_t handle, esp_ae_sample_t in_samples,
+                                      uint32_t in_sample_num, esp_ae_sample_t out_samples,
+                                      uint32_t *out_sample_num);
+
+/**
+ * @brief  Perform asynchronous sample rate conversion on deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *
+ * @param[in]      handle          The asynchronous sample rate converter handle
+ * @param[in]      in_samples      Array of input buffer pointers with each channel
+ * @param[in]      in_sample_num   The input samples number
+ * @param[out]     out_samples     Array of output buffer pointers with each channel
+ * @param[in,out]  out_sample_num  For the input parameter, it represents the maximum number of samples in the output buffer,
+ *                                 which must not be less than the value from `esp_ae_async_src_get_max_out_sample_num`.
+ *                                 For the output parameter, it represents the actual number of output samples
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_deintlv_process(esp_ae_async_src_handle_t handle, esp_ae_sample_t in_samples[],
+                                              uint32_t in_sample_num, esp_ae_sample_t out_samples[],
+                                              uint32_t *out_sample_num);
+
+/**
+ * @brief  Adjust conversion ratio
+ *
+ * @note  Positive ppm produces more output samples per input sample, i.e. the effective ratio becomes
+ *        `dest_rate / src_rate * (1 + ppm / 1000000)`. It takes effect from the next output sample.
+ *        When PI controller is enabled, the value is overwritten on next `esp_ae_async_src_update_level`
+ *
+ * @param[in]  handle  The asynchronous sample rate converter handle
+ * @param[in]  ppm     Ratio adjustment in ppm, range [-max_ppm, max_ppm]
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_set_ratio_ppm(esp_ae_async_src_handle_t handle, float ppm);
+
+/**
+ * @brief  Get current ratio adjustment
+ *
+ * @param[in]   handle  The asynchronous sample rate converter handle
+ * @param[out]  ppm     Ratio adjustment in ppm
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_get_ratio_ppm(esp_ae_async_src_handle_t handle, float *ppm);
+
+/**
+ * @brief  Enable built-in PI controller
+ *
+ * @note  Integral state is re-initialized so that the current ratio adjustment is kept as starting point
+ *
+ * @param[in]  handle  The asynchronous sample rate converter handle
+ * @param[in]  pi_cfg  PI controller configuration, NULL to disable the controller
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_set_pi(esp_ae_async_src_handle_t handle, esp_ae_async_src_pi_cfg_t *pi_cfg);
+
+/**
+ * @brief  Feed buffer fill level to the built-in PI controller and update ratio adjustment
+ *
+ * @note  Call it periodically (e.g. once per process call) with the fill level measured at the same point
+ *
+ * @param[in]  handle  The asynchronous sample rate converter handle
+ * @param[in]  level   Buffer fill level in samples per channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_NOT_SUPPORT        PI controller not enabled
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_update_level(esp_ae_async_src_handle_t handle, uint32_t level);
+
+/**
+ * @brief  Reset the internal state of the asynchronous sample rate converter and clear cached data
+ *
+ * @note  Ratio adjustment and PI controller state are cleared as well.
+ *        This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The asynchronous sample rate converter handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_async_src_reset(esp_ae_async_src_handle_t handle);
+
+/**
+ * @brief  Deinitialize the asynchronous sample rate converter handle
+ *
+ * @param  handle  The asynchronous sample rate converter handle
+ */
+void esp_ae_async_src_close(esp_ae_async_src_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
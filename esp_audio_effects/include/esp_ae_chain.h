@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+#include "esp_ae_eq.h"
+#include "esp_ae_drc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * Effect chain runs an ordered list of effect modules as one processing unit.
+ *
+ * @note  Compared with opening every module and calling its `process` one by one, the chain:
+ *         1) Converts bit width only at chain edges. All stages run in one working format (`work_bits`),
+ *            so a 16 bits stream can be processed in 32 bits through the whole chain and rounded only once
+ *         2) Walks input in blocks of `block_size` samples through all stages, so the block stays in cache
+ *            (or internal RAM) between stages instead of streaming the whole buffer once per stage
+ *         3) Counts CPU cycles spent in every stage and in edge conversion
+ *
+ *         Stages process in place on the working block, module specific configuration (e.g. EQ filters) is
+ *         taken from `esp_ae_chain_stage_t.cfg`, while `sample_rate`, `channel` and `bits_per_sample` of the
+ *         module configuration are ignored and replaced by the chain settings.
+ *         Stage handle can be obtained by `esp_ae_chain_get_stage_handle` to change parameters in runtime
+ *         through the module API (e.g. `esp_ae_eq_set_filter_para`), but must not be closed or processed directly.
+ *         Module setters are not thread-safe against `esp_ae_chain_process` and take effect abruptly.
+ *
+ *         `esp_ae_chain_post_param` is the thread-safe alternative: updates go through a lock-free single producer
+ *         single consumer queue and are consumed at block boundaries inside `esp_ae_chain_process`.
+ *         Continuous parameters (EQ filter frequency, Q and gain, DRC curve and makeup gain, reverb and delay levels)
+ *         are ramped over `ramp_ms`: while a ramp runs, blocks are split into `ESP_AE_CHAIN_RAMP_STEP` samples and
+ *         the interpolated value is set before each of them, so filter coefficients and gains move in small steps
+ *         instead of one jump. Discrete parameters and incompatible changes (e.g. EQ filter type) apply at once.
+ *         The queue only covers the stage parameters listed in `esp_ae_chain_param_id_t`. Setters of modules that are
+ *         not chain stages (e.g. limiter, loudness, mbc_n, conv, ns, aec, mix_bus) keep the behavior described in
+ *         their own headers: calls must be serialized with their `process` by the caller.
+ *
+ *         Sample number is counted per channel: sample_num = data_length / (channel * (bits_per_sample >> 3))
+ */
+
+/**
+ * @brief  Default block size in samples per channel
+ */
+#define ESP_AE_CHAIN_DEFAULT_BLOCK_SIZE (256)
+
+/**
+ * @brief  Maximum stage number of one chain
+ */
+#define ESP_AE_CHAIN_MAX_STAGE_NUM (16)
+
+/**
+ * @brief  Default number of parameter updates the queue can hold
+ */
+#define ESP_AE_CHAIN_DEFAULT_PARAM_QUEUE_SIZE (16)
+
+/**
+ * @brief  Samples per channel between two interpolated parameter values while a ramp runs
+ */
+#define ESP_AE_CHAIN_RAMP_STEP (32)
+
+/**
+ * @brief  Maximum number of parameters ramping at the same time, further ramps apply at once
+ */
+#define ESP_AE_CHAIN_MAX_RAMP_NUM (16)
+
+/**
+ * @brief  Maximum DRC curve point number carried by one parameter update
+ */
+#define ESP_AE_CHAIN_DRC_MAX_POINT_NUM (6)
+
+/**
+ * @brief  Handle for effect chain
+ */
+typedef void *esp_ae_chain_handle_t;
+
+/**
+ * @brief  Effect module type of chain stage
+ */
+typedef enum {
+    ESP_AE_CHAIN_STAGE_ALC    = 0,  /*!< Automatic level control, cfg is `esp_ae_alc_cfg_t` */
+    ESP_AE_CHAIN_STAGE_EQ     = 1,  /*!< Equalizer, cfg is `esp_ae_eq_cfg_t` */
+    ESP_AE_CHAIN_STAGE_DRC    = 2,  /*!< Dynamic range control, cfg is `esp_ae_drc_cfg_t` */
+    ESP_AE_CHAIN_STAGE_MBC    = 3,  /*!< Multi-band compressor, cfg is `esp_ae_mbc_config_t` */
+    ESP_AE_CHAIN_STAGE_FADE   = 4,  /*!< Fade, cfg is `esp_ae_fade_cfg_t` */
+    ESP_AE_CHAIN_STAGE_DELAY  = 5,  /*!< Delay, cfg is `esp_ae_delay_cfg_t` */
+    ESP_AE_CHAIN_STAGE_REVERB = 6,  /*!< Reverb, cfg is `esp_ae_reverb_cfg_t` */
+    ESP_AE_CHAIN_STAGE_MAX,         /*!< The maximum value */
+} esp_ae_chain_stage_type_t;
+
+/**
+ * @brief  Parameter identifier of `esp_ae_chain_param_t`
+ */
+typedef enum {
+    ESP_AE_CHAIN_PARAM_EQ_FILTER         = 0,  /*!< EQ stage, `idx` is filter index, value is `eq_filter`. Frequency, Q
+                                                    and gain are ramped when the filter type is unchanged */
+    ESP_AE_CHAIN_PARAM_DRC_CURVE         = 1,  /*!< DRC stage, value is `drc_curve`. Output levels are ramped when the
+                                                    point number and input levels are unchanged */
+    ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN   = 2,  /*!< DRC stage, value is `f` in dB, ramped */
+    ESP_AE_CHAIN_PARAM_ALC_GAIN          = 3,  /*!< ALC stage, `idx` is channel index, value is `alc_gain` in dB.
+                                                    Applied at once, ALC smooths it by its own transit time */
+    ESP_AE_CHAIN_PARAM_REVERB_ROOM_SIZE  = 4,  /*!< Reverb stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_REVERB_DAMPING    = 5,  /*!< Reverb stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL  = 6,  /*!< Reverb stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_REVERB_DRY_LEVEL  = 7,  /*!< Reverb stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_DELAY_FEEDBACK    = 8,  /*!< Delay stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_DELAY_MIX         = 9,  /*!< Delay stage, value is `f`, ramped */
+    ESP_AE_CHAIN_PARAM_MAX,                    /*!< The maximum value */
+} esp_ae_chain_param_id_t;
+
+/**
+ * @brief  DRC curve carried by a parameter update
+ */
+typedef struct {
+    esp_ae_drc_curve_point  point[ESP_AE_CHAIN_DRC_MAX_POINT_NUM];  /*!< Curve points, same rules as
+                                                                         `esp_ae_drc_set_curve_points` */
+    uint8_t                 point_num;                              /*!< Number of valid points */
+} esp_ae_chain_drc_curve_t;
+
+/**
+ * @brief  One parameter update posted by `esp_ae_chain_post_param`
+ */
+typedef struct {
+    uint8_t                  stage_idx;  /*!< Stage index in `esp_ae_chain_cfg_t.stages` */
+    esp_ae_chain_param_id_t  id;         /*!< Parameter identifier, must match the stage type */
+    uint8_t                  idx;        /*!< Sub index, see `esp_ae_chain_param_id_t` */
+    union {
+        float                     f;          /*!< Scalar parameter */
+        int8_t                    alc_gain;   /*!< ALC gain */
+        esp_ae_eq_filter_para_t   eq_filter;  /*!< EQ filter parameter */
+        esp_ae_chain_drc_curve_t  drc_curve;  /*!< DRC curve */
+    } value;
+} esp_ae_chain_param_t;
+
+/**
+ * @brief  Configuration structure of one chain stage
+ */
+typedef struct {
+    esp_ae_chain_stage_type_t  type;  /*!< Effect module type */
+    void                      *cfg;   /*!< Pointer to module configuration matching `type`, only used in `esp_ae_chain_open`.
+                                           NULL is allowed for ALC */
+} esp_ae_chain_stage_t;
+
+/**
+ * @brief  Configuration structure for effect chain
+ */
+typedef struct {
+    uint32_t              sample_rate;      /*!< The audio sample rate */
+    uint8_t               channel;          /*!< The audio channel number */
+    uint8_t               bits_per_sample;  /*!< Bits per sample of chain input and output, supports 16, 24, 32 bits */
+    uint8_t               work_bits;        /*!< Bits per sample used by all stages, supports 16, 24, 32 bits.
+                                                 0 means same as `bits_per_sample` which skips edge conversion */
+    uint16_t              block_size;       /*!< Samples per channel processed through all stages at once,
+                                                 0 means `ESP_AE_CHAIN_DEFAULT_BLOCK_SIZE` */
+    esp_ae_chain_stage_t *stages;           /*!< Array of stages in processing order */
+    uint8_t               stage_num;        /*!< Number of stages, range [1, ESP_AE_CHAIN_MAX_STAGE_NUM] */
+    uint16_t              param_queue_size; /*!< Parameter updates the queue can hold,
+                                                 0 means `ESP_AE_CHAIN_DEFAULT_PARAM_QUEUE_SIZE` */
+    uint16_t              ramp_ms;          /*!< Ramp time of continuous parameters, 0 applies updates at once
+                                                 at the next block boundary */
+} esp_ae_chain_cfg_t;
+
+/**
+ * @brief  Create an effect chain handle and open all stages
+ *
+ * @param[in]   cfg     Pointer to the effect chain configuration
+ * @param[out]  handle  The effect chain handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ *       - Others                        Fail to open stage module
+ */
+esp_ae_err_t esp_ae_chain_open(esp_ae_chain_cfg_t *cfg, esp_ae_chain_handle_t *handle);
+
+/**
+ * @brief  Process interleaved audio data through all stages
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        `in_samples` and `out_samples` can be the same buffer (inplace processing)
+ *
+ * @param[in]   handle       The effect chain handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Input samples buffer, size not less than `sample_num * channel * bits_per_sample >> 3`
+ * @param[out]  out_samples  Output samples buffer, size not less than `sample_num * channel * bits_per_sample >> 3`
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ *       - Others                        Fail to process in stage module
+ */
+esp_ae_err_t esp_ae_chain_process(esp_ae_chain_handle_t handle, uint32_t sample_num,
+                                  esp_ae_sample_t in_samples, esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Get module handle of one stage
+ *
+ * @note  The module handle is owned by chain, it is only for runtime parameter setting and getting
+ *
+ * @param[in]   handle        The effect chain handle
+ * @param[in]   stage_idx     Stage index in `esp_ae_chain_cfg_t.stages`
+ * @param[out]  stage_handle  Module handle, cast it to the module handle type, e.g. `esp_ae_eq_handle_t`
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_chain_get_stage_handle(esp_ae_chain_handle_t handle, uint8_t stage_idx, void **stage_handle);
+
+/**
+ * @brief  Post a parameter update to be applied inside `esp_ae_chain_process`
+ *
+ * @note  This function can be called from one producer thread while another thread runs `esp_ae_chain_process`,
+ *        no lock is needed. Calling it from several threads at once needs external serialization.
+ *        Updates are consumed in posting order at the next block boundary. Values are checked by the module
+ *        setter at that time, invalid updates are logged and dropped. A new update of a parameter that is
+ *        still ramping starts a new ramp from the current value
+ *
+ * @param[in]  handle  The effect chain handle
+ * @param[in]  param   Parameter update, copied into the queue
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_FAIL               Queue is full, retry after the next process call
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter, stage index or identifier not matching the stage type
+ */
+esp_ae_err_t esp_ae_chain_post_param(esp_ae_chain_handle_t handle, const esp_ae_chain_param_t *param);
+
+/**
+ * @brief  Get accumulated CPU cycles of one stage
+ *
+ * @note  Cycles are counted from open or last `esp_ae_chain_reset`, and include interrupts happened in between.
+ *        Cycles per sample can be calculated as `cycles / processed samples`
+ *
+ * @param[in]   handle     The effect chain handle
+ * @param[in]   stage_idx  Stage index in `esp_ae_chain_cfg_t.stages`
+ * @param[out]  cycles     Accumulated CPU cycles
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_chain_get_stage_cycles(esp_ae_chain_handle_t handle, uint8_t stage_idx, uint64_t *cycles);
+
+/**
+ * @brief  Get accumulated CPU cycles of edge bit conversion
+ *
+ * @param[in]   handle  The effect chain handle
+ * @param[out]  cycles  Accumulated CPU cycles, always 0 when `work_bits` equals `bits_per_sample`
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_chain_get_edge_cycles(esp_ae_chain_handle_t handle, uint64_t *cycles);
+
+/**
+ * @brief  Get accumulated CPU cycles of parameter queue consumption and ramp steps
+ *
+ * @param[in]   handle  The effect chain handle
+ * @param[out]  cycles  Accumulated CPU cycles, including the module setters called for ramps
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_chain_get_param_cycles(esp_ae_chain_handle_t handle, uint64_t *cycles);
+
+/**
+ * @brief  Reset all stages and clear cycle statistics, running ramps jump to their final values
+ *
+ * @param[in]  handle  The effect chain handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_chain_reset(esp_ae_chain_handle_t handle);
+
+/**
+ * @brief  Close all stages and deinitialize effect chain handle
+ *
+ * @param[in]  handle  The effect chain handle
+ */
+void esp_ae_chain_close(esp_ae_chain_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Convolution (CONV) filters audio with a long FIR impulse response (IR), such as a measured room
+ *         IR for convolution reverb or a speaker correction filter with thousands of taps.
+ *
+ *         The IR is split into partitions of `partition_size` taps, each partition is multiplied in frequency
+ *         domain with the spectra of recent input blocks (uniformly partitioned overlap-save). The cost per
+ *         sample grows with `ir_len / partition_size` instead of `ir_len`, and the output is delayed by exactly
+ *         `partition_size` sampling points. Smaller partitions give lower latency at higher CPU cost.
+ *
+ *         The output is: output = dry_gain * input(n - latency) + wet_gain * (input * ir)(n - latency)
+ *
+ *         Processing is based on sampling points as processing units. Any `sample_num` can be given per call,
+ *         input is buffered internally until a partition is complete.
+ *         The relationship between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Maximum IR length in taps
+ */
+#define ESP_AE_CONV_MAX_IR_LEN (65536)
+
+/**
+ * @brief  Default partition size in sampling points
+ */
+#define ESP_AE_CONV_DEFAULT_PARTITION_SIZE (256)
+
+/**
+ * @brief  The handle of convolution
+ */
+typedef void *esp_ae_conv_handle_t;
+
+/**
+ * @brief  Convolution configuration
+ */
+typedef struct {
+    uint32_t      sample_rate;      /*!< The audio sample rate */
+    uint8_t       channel;          /*!< The audio channel number */
+    uint8_t       bits_per_sample;  /*!< Support bits per sample: 16, 24, 32 bit */
+    uint16_t      partition_size;   /*!< Partition size and latency in sampling points, power of 2 in range [32, 4096],
+                                         0 means `ESP_AE_CONV_DEFAULT_PARTITION_SIZE` */
+    const float **ir;               /*!< Array of `ir_channel` IR pointers, each holds `ir_len` taps in linear scale.
+                                         The IR is only read during open, it can stay in PSRAM or flash
+                                         and be released after open */
+    uint8_t       ir_channel;       /*!< Number of IR, 1 means all channels share one IR, otherwise equal to `channel` */
+    uint32_t      ir_len;           /*!< IR length in taps, range [1, ESP_AE_CONV_MAX_IR_LEN] */
+    float         dry_gain;         /*!< Linear gain of the delayed input, 0 for a pure filter */
+    float         wet_gain;         /*!< Linear gain of the convolved signal */
+    bool          use_psram;        /*!< Allocate IR spectra and input spectra history in PSRAM. Recommended for
+                                         IR longer than a few thousand taps, at some CPU cost */
+} esp_ae_conv_cfg_t;
+
+/**
+ * @brief  Create convolution handle through configuration
+ *
+ * @note  The IR spectra take about `ir_channel * 8 * ceil(ir_len / partition_size) * (partition_size + 1)` bytes,
+ *        the input spectra history takes the same per audio channel
+ *
+ * @param[in]   cfg     Convolution configuration
+ * @param[out]  handle  The convolution handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_open(esp_ae_conv_cfg_t *cfg, esp_ae_conv_handle_t *handle);
+
+/**
+ * @brief  Get the processing latency
+ *
+ * @param[in]   handle   The convolution handle
+ * @param[out]  latency  Latency in sampling points, equal to the partition size
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_get_latency(esp_ae_conv_handle_t handle, uint32_t *latency);
+
+/**
+ * @brief  Do convolution on interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The convolution handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   The input samples buffer
+ * @param[out]  out_samples  The output samples buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_process(esp_ae_conv_handle_t handle, uint32_t sample_num, esp_ae_sample_t in_samples,
+                                 esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Do convolution on deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The convolution handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of input buffer pointers with each channel
+ * @param[out]  out_samples  Array of output buffer pointers with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_deintlv_process(esp_ae_conv_handle_t handle, uint32_t sample_num,
+                                         esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Set dry and wet gain
+ *
+ * @note  It takes effect from the next completed partition
+ *
+ * @param[in]  handle    The convolution handle
+ * @param[in]  dry_gain  Linear gain of the delayed input
+ * @param[in]  wet_gain  Linear gain of the convolved signal
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_set_mix(esp_ae_conv_handle_t handle, float dry_gain, float wet_gain);
+
+/**
+ * @brief  Reset the internal processing state, buffered input and convolution tail are cleared
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The convolution handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_conv_reset(esp_ae_conv_handle_t handle);
+
+/**
+ * @brief  Deinitialize the convolution handle
+ *
+ * @param  handle  The convolution handle
+ */
+void esp_ae_conv_close(esp_ae_conv_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,217 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Limiter keeps the audio below a hard ceiling without the overshoot of envelope followers
+ *         such as `esp_ae_drc` and `esp_ae_alc`, which react after a fast transient has already clipped.
+ *
+ *         The input is delayed by a lookahead time while the peaks are detected. The gain needed by each
+ *         peak is held as a sliding window minimum over the lookahead, released by a one pole smoother and
+ *         then averaged over the lookahead, so the gain is already reduced when the peak reaches the output
+ *         and never changes abruptly. All channels share one gain to keep the stereo image.
+ *
+ *         In true peak mode the peaks between samples are estimated by 4x oversampling interpolation, so the
+ *         signal also stays below the ceiling after digital to analog conversion or resampling.
+ *         The output samples are finally clamped to the ceiling, which makes the ceiling hard in any mode.
+ *
+ *         Limiter processing is based on sampling points as processing units. The relationship
+ *         between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Lookahead time range in milliseconds
+ */
+#define ESP_AE_LIMITER_MIN_LOOKAHEAD_MS (0.5f)
+#define ESP_AE_LIMITER_MAX_LOOKAHEAD_MS (5.0f)
+
+/**
+ * @brief  Ceiling range in dBFS
+ */
+#define ESP_AE_LIMITER_MIN_CEILING_DB (-30.0f)
+#define ESP_AE_LIMITER_MAX_CEILING_DB (0.0f)
+
+/**
+ * @brief  Release time range in milliseconds
+ */
+#define ESP_AE_LIMITER_MIN_RELEASE_MS (1.0f)
+#define ESP_AE_LIMITER_MAX_RELEASE_MS (2000.0f)
+
+/**
+ * @brief  Extra latency in sampling points of true peak detection
+ */
+#define ESP_AE_LIMITER_TRUE_PEAK_DELAY (6)
+
+/**
+ * @brief  Handle of limiter
+ */
+typedef void *esp_ae_limiter_handle_t;
+
+/**
+ * @brief  Peak detection mode
+ */
+typedef enum {
+    ESP_AE_LIMITER_DETECT_SAMPLE_PEAK = 0,  /*!< Absolute value of samples */
+    ESP_AE_LIMITER_DETECT_TRUE_PEAK   = 1,  /*!< Samples and 3 interpolated points between each two samples */
+    ESP_AE_LIMITER_DETECT_MAX         = 2,  /*!< The maximum value */
+} esp_ae_limiter_detect_t;
+
+/**
+ * @brief  Configuration structure for limiter
+ */
+typedef struct {
+    uint32_t                 sample_rate;      /*!< The audio sample rate */
+    uint8_t                  channel;          /*!< The audio channel number */
+    uint8_t                  bits_per_sample;  /*!< Support bits per sample: 16, 24, 32 bit */
+    esp_ae_limiter_detect_t  detect_mode;      /*!< Peak detection mode */
+    float                    lookahead_ms;     /*!< Lookahead time, range [ESP_AE_LIMITER_MIN_LOOKAHEAD_MS,
+                                                    ESP_AE_LIMITER_MAX_LOOKAHEAD_MS]. Longer lookahead gives
+                                                    smoother gain reduction at more latency */
+    float                    ceiling_db;       /*!< Output ceiling in dBFS, range [ESP_AE_LIMITER_MIN_CEILING_DB,
+                                                    ESP_AE_LIMITER_MAX_CEILING_DB] */
+    float                    release_ms;       /*!< Release time constant, range [ESP_AE_LIMITER_MIN_RELEASE_MS,
+                                                    ESP_AE_LIMITER_MAX_RELEASE_MS] */
+} esp_ae_limiter_cfg_t;
+
+/**
+ * @brief  Create a limiter handle through configuration
+ *
+ * @param[in]   cfg     Limiter configuration
+ * @param[out]  handle  The limiter handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_open(esp_ae_limiter_cfg_t *cfg, esp_ae_limiter_handle_t *handle);
+
+/**
+ * @brief  Get the processing latency
+ *
+ * @param[in]   handle   The limiter handle
+ * @param[out]  latency  Latency in sampling points, the lookahead in sampling points plus
+ *                       `ESP_AE_LIMITER_TRUE_PEAK_DELAY` in true peak mode
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_get_latency(esp_ae_limiter_handle_t handle, uint32_t *latency);
+
+/**
+ * @brief  Do limiter processing on interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The limiter handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   The input samples buffer
+ * @param[out]  out_samples  The output samples buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_process(esp_ae_limiter_handle_t handle, uint32_t sample_num, esp_ae_sample_t in_samples,
+                                    esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Do limiter processing on deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The limiter handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of input buffer pointers with each channel
+ * @param[out]  out_samples  Array of output buffer pointers with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_deintlv_process(esp_ae_limiter_handle_t handle, uint32_t sample_num,
+                                            esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Set the output ceiling
+ *
+ * @note  A lower ceiling takes effect on the output only after the lookahead,
+ *        samples already in the lookahead are clamped to the new ceiling
+ *
+ * @param[in]  handle      The limiter handle
+ * @param[in]  ceiling_db  Output ceiling in dBFS, range [ESP_AE_LIMITER_MIN_CEILING_DB, ESP_AE_LIMITER_MAX_CEILING_DB]
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_set_ceiling(esp_ae_limiter_handle_t handle, float ceiling_db);
+
+/**
+ * @brief  Set the release time constant
+ *
+ * @param[in]  handle      The limiter handle
+ * @param[in]  release_ms  Release time, range [ESP_AE_LIMITER_MIN_RELEASE_MS, ESP_AE_LIMITER_MAX_RELEASE_MS]
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_set_release(esp_ae_limiter_handle_t handle, float release_ms);
+
+/**
+ * @brief  Get the gain reduction applied to the last output sampling point
+ *
+ * @param[in]   handle   The limiter handle
+ * @param[out]  gain_db  Gain in dB, 0 when not limiting, negative when limiting
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_get_gain_reduction(esp_ae_limiter_handle_t handle, float *gain_db);
+
+/**
+ * @brief  Reset the internal processing state, the lookahead buffer is cleared
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The limiter handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_limiter_reset(esp_ae_limiter_handle_t handle);
+
+/**
+ * @brief  Deinitialize the limiter handle
+ *
+ * @param  handle  The limiter handle
+ */
+void esp_ae_limiter_close(esp_ae_limiter_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
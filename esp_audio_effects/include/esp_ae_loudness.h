@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Loudness measures the perceived loudness of audio following ITU-R BS.1770-4 and EBU R128 (Tech 3341,
+ *         Tech 3342), and optionally normalizes the audio to a target loudness.
+ *
+ *         Each channel is filtered by the K-weighting filter (high shelf and high pass) and the mean square is
+ *         accumulated in sub-blocks of 100 ms. From the sub-blocks the following values are derived:
+ *         - Momentary loudness: 400 ms window
+ *         - Short-term loudness: 3 s window
+ *         - Integrated loudness: all 400 ms blocks since open or reset, with absolute gate -70 LUFS and
+ *           relative gate -10 LU
+ *         - Loudness range (LRA): distribution of 3 s blocks between the 10th and 95th percentile, with absolute
+ *           gate -70 LUFS and relative gate -20 LU
+ *         The gated values are computed from histograms of 0.1 LU resolution, so memory use stays fixed no
+ *         matter how long the measurement runs. The windows report the loudness of the available data until
+ *         they are full.
+ *
+ *         In normalizer mode a gain is applied that moves toward `target_lufs - short-term loudness` with the
+ *         `response_ms` time constant. Sub-blocks whose momentary loudness is below -70 LUFS or 20 LU below the
+ *         program average are pauses: they are left out of the short-term loudness used here and hold the gain.
+ *         Gain changes are ramped linearly over each sub-block.
+ *         Output samples are saturated, use `esp_ae_limiter` afterwards if the gain may boost peaks to full scale.
+ *
+ *         Channels are weighted as BS.1770 for mono, stereo and the surround layouts below in WAVE channel order,
+ *         other channel numbers weight every channel 1.0:
+ *         - 5 channels (5.0): L, R, C, Ls, Rs, Ls and Rs weighted 1.41 (+1.5 dB)
+ *         - 6 channels (5.1): L, R, C, LFE, Ls, Rs, LFE not measured, Ls and Rs weighted 1.41
+ *         - 8 channels (7.1): L, R, C, LFE, Lb, Rb, Ls, Rs, LFE not measured, Ls and Rs weighted 1.41
+ *         The measurement is done on the input before normalization.
+ *
+ *         Loudness processing is based on sampling points as processing units. The relationship
+ *         between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Loudness reported when no block is above the absolute gate or no data is measured
+ */
+#define ESP_AE_LOUDNESS_SILENCE_LUFS (-70.0f)
+
+/**
+ * @brief  Normalizer target loudness range in LUFS
+ */
+#define ESP_AE_LOUDNESS_MIN_TARGET_LUFS (-40.0f)
+#define ESP_AE_LOUDNESS_MAX_TARGET_LUFS (-5.0f)
+
+/**
+ * @brief  Maximum absolute normalizer gain range in dB
+ */
+#define ESP_AE_LOUDNESS_MIN_MAX_GAIN_DB (0.0f)
+#define ESP_AE_LOUDNESS_MAX_MAX_GAIN_DB (30.0f)
+
+/**
+ * @brief  Normalizer gain response time range in milliseconds
+ */
+#define ESP_AE_LOUDNESS_MIN_RESPONSE_MS (100.0f)
+#define ESP_AE_LOUDNESS_MAX_RESPONSE_MS (60000.0f)
+
+/**
+ * @brief  Handle of loudness
+ */
+typedef void *esp_ae_loudness_handle_t;
+
+/**
+ * @brief  Loudness working mode
+ */
+typedef enum {
+    ESP_AE_LOUDNESS_MODE_METER     = 0,  /*!< Measure only, output is a copy of input */
+    ESP_AE_LOUDNESS_MODE_NORMALIZE = 1,  /*!< Measure and apply the normalizer gain */
+    ESP_AE_LOUDNESS_MODE_MAX       = 2,  /*!< The maximum value */
+} esp_ae_loudness_mode_t;
+
+/**
+ * @brief  Configuration structure for loudness
+ */
+typedef struct {
+    uint32_t                sample_rate;      /*!< The audio sample rate, range [8000, 192000] */
+    uint8_t                 channel;          /*!< The audio channel number */
+    uint8_t                 bits_per_sample;  /*!< Support bits per sample: 16, 24, 32 bit */
+    esp_ae_loudness_mode_t  mode;             /*!< Working mode */
+    float                   target_lufs;      /*!< Normalizer target, range [ESP_AE_LOUDNESS_MIN_TARGET_LUFS,
+                                                   ESP_AE_LOUDNESS_MAX_TARGET_LUFS]. Only checked in normalizer mode */
+    float                   max_gain_db;      /*!< Limit of normalizer boost and cut, range
+                                                   [ESP_AE_LOUDNESS_MIN_MAX_GAIN_DB, ESP_AE_LOUDNESS_MAX_MAX_GAIN_DB].
+                                                   Only checked in normalizer mode */
+    float                   response_ms;      /*!< Normalizer gain time constant, range [ESP_AE_LOUDNESS_MIN_RESPONSE_MS,
+                                                   ESP_AE_LOUDNESS_MAX_RESPONSE_MS]. Only checked in normalizer mode */
+} esp_ae_loudness_cfg_t;
+
+/**
+ * @brief  Loudness measurement result
+ */
+typedef struct {
+    float  momentary;   /*!< Momentary loudness in LUFS */
+    float  short_term;  /*!< Short-term loudness in LUFS */
+    float  integrated;  /*!< Integrated loudness in LUFS */
+    float  range;       /*!< Loudness range in LU, 0 before enough 3 s blocks are measured */
+    float  gain_db;     /*!< Normalizer gain applied to the last output sampling point, 0 in meter mode */
+} esp_ae_loudness_info_t;
+
+/**
+ * @brief  Create a loudness handle through configuration
+ *
+ * @param[in]   cfg     Loudness configuration
+ * @param[out]  handle  The loudness handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_open(esp_ae_loudness_cfg_t *cfg, esp_ae_loudness_handle_t *handle);
+
+/**
+ * @brief  Do loudness processing on interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The loudness handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   The input samples buffer
+ * @param[out]  out_samples  The output samples buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_process(esp_ae_loudness_handle_t handle, uint32_t sample_num,
+                                     esp_ae_sample_t in_samples, esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Do loudness processing on deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The loudness handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of input buffer pointers with each channel
+ * @param[out]  out_samples  Array of output buffer pointers with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_deintlv_process(esp_ae_loudness_handle_t handle, uint32_t sample_num,
+                                             esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Get the loudness measurement
+ *
+ * @note  Integrated loudness and loudness range are computed from the histograms on each call,
+ *        which takes a few thousand operations, so query them at a user interface rate rather than per block
+ *
+ * @param[in]   handle  The loudness handle
+ * @param[out]  info    Measurement result
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_get_info(esp_ae_loudness_handle_t handle, esp_ae_loudness_info_t *info);
+
+/**
+ * @brief  Set the normalizer target loudness
+ *
+ * @param[in]  handle       The loudness handle
+ * @param[in]  target_lufs  Target loudness, range [ESP_AE_LOUDNESS_MIN_TARGET_LUFS, ESP_AE_LOUDNESS_MAX_TARGET_LUFS]
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_set_target(esp_ae_loudness_handle_t handle, float target_lufs);
+
+/**
+ * @brief  Reset the measurement and the normalizer gain, used at track or stream boundaries
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The loudness handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_loudness_reset(esp_ae_loudness_handle_t handle);
+
+/**
+ * @brief  Deinitialize the loudness handle
+ *
+ * @param  handle  The loudness handle
+ */
+void esp_ae_loudness_close(esp_ae_loudness_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,305 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_ae_types.h"
+#include "esp_ae_mbc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  N-band Multi-Band Compressor (MBC_N) splits the audio into 2 to 8 bands by `band_num - 1` crossover
+ *         frequencies and compresses each band with its own `esp_ae_mbc_para_t` parameters. Solo and bypass
+ *         work the same as in `esp_ae_mbc`.
+ *
+ *         Two crossover types are offered:
+ *         - ESP_AE_MBC_N_CROSSOVER_IIR: One Linkwitz-Riley 4th order tree without latency. Every crossover costs a
+ *           low pass pair and one allpass, the high pass is derived as allpass minus low pass. The lower bands are
+ *           phase aligned by one allpass per crossover applied on the partial sum after the band gains, so the sum
+ *           of unprocessed bands is an allpass with flat magnitude
+ *         - ESP_AE_MBC_N_CROSSOVER_LINEAR_PHASE: Complementary windowed sinc FIR band filters of `fir_len + 1`
+ *           taps run by overlap-save FFT. The sum of unprocessed bands is the input delayed by the latency,
+ *           no phase distortion around the crossovers. Latency is `fir_len * 3 / 2` sampling points
+ *
+ *         The band detectors are linked across channels. The gain is computed every
+ *         `ESP_AE_MBC_N_CONTROL_PERIOD` sampling points from the band peak and ramped linearly in between.
+ *
+ *         MBC_N processing is based on sampling points as processing units. The relationship
+ *         between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Band number range
+ */
+#define ESP_AE_MBC_N_MIN_BAND_NUM (2)
+#define ESP_AE_MBC_N_MAX_BAND_NUM (8)
+
+/**
+ * @brief  Minimum crossover frequency in Hz, crossovers must also be below half of the sample rate
+ */
+#define ESP_AE_MBC_N_MIN_FC (20)
+
+/**
+ * @brief  Linear phase filter length range and default, power of 2
+ */
+#define ESP_AE_MBC_N_MIN_FIR_LEN     (256)
+#define ESP_AE_MBC_N_MAX_FIR_LEN     (8192)
+#define ESP_AE_MBC_N_DEFAULT_FIR_LEN (1024)
+
+/**
+ * @brief  Sampling points between two gain computations
+ */
+#define ESP_AE_MBC_N_CONTROL_PERIOD (16)
+
+/**
+ * @brief  Handle of N-band MBC
+ */
+typedef void *esp_ae_mbc_n_handle_t;
+
+/**
+ * @brief  Crossover type
+ */
+typedef enum {
+    ESP_AE_MBC_N_CROSSOVER_IIR          = 0,  /*!< Linkwitz-Riley IIR tree, no latency */
+    ESP_AE_MBC_N_CROSSOVER_LINEAR_PHASE = 1,  /*!< FFT based linear phase FIR, latency fir_len * 3 / 2 */
+    ESP_AE_MBC_N_CROSSOVER_MAX          = 2,  /*!< The maximum value */
+} esp_ae_mbc_n_crossover_t;
+
+/**
+ * @brief  Configuration structure for N-band MBC
+ */
+typedef struct {
+    uint32_t                  sample_rate;                              /*!< The audio sample rate, range [8000, 192000] */
+    uint8_t                   channel;                                  /*!< The audio channel number */
+    uint8_t                   bits_per_sample;                          /*!< Support bits per sample: 16, 24, 32 bit */
+    uint8_t                   band_num;                                 /*!< Band number, range [ESP_AE_MBC_N_MIN_BAND_NUM,
+                                                                             ESP_AE_MBC_N_MAX_BAND_NUM] */
+    esp_ae_mbc_n_crossover_t  crossover;                                /*!< Crossover type */
+    uint16_t                  fir_len;                                  /*!< Linear phase filter length, power of 2 in
+                                                                             [ESP_AE_MBC_N_MIN_FIR_LEN, ESP_AE_MBC_N_MAX_FIR_LEN].
+                                                                             0 means ESP_AE_MBC_N_DEFAULT_FIR_LEN. Ignored by IIR */
+    uint32_t                  fc[ESP_AE_MBC_N_MAX_BAND_NUM - 1];        /*!< Crossover frequencies in ascending order, the first
+                                                                             `band_num - 1` are used */
+    esp_ae_mbc_para_t         mbc_para[ESP_AE_MBC_N_MAX_BAND_NUM];      /*!< Compressor parameter of each band from low to high,
+                                                                             the first `band_num` are used */
+} esp_ae_mbc_n_cfg_t;
+
+/**
+ * @brief  Create an N-band MBC handle through configuration
+ *
+ * @param[in]   cfg     N-band MBC configuration
+ * @param[out]  handle  The N-band MBC handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_open(esp_ae_mbc_n_cfg_t *cfg, esp_ae_mbc_n_handle_t *handle);
+
+/**
+ * @brief  Get the latency in sampling points, 0 for the IIR crossover
+ *
+ * @param[in]   handle   The N-band MBC handle
+ * @param[out]  latency  Latency in sampling points
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_latency(esp_ae_mbc_n_handle_t handle, uint32_t *latency);
+
+/**
+ * @brief  Do N-band MBC processing on interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The N-band MBC handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   The input samples buffer
+ * @param[out]  out_samples  The output samples buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_process(esp_ae_mbc_n_handle_t handle, uint32_t sample_num,
+                                  esp_ae_sample_t in_samples, esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Do N-band MBC processing on deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The N-band MBC handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of input buffer pointers with each channel
+ * @param[out]  out_samples  Array of output buffer pointers with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_deintlv_process(esp_ae_mbc_n_handle_t handle, uint32_t sample_num,
+                                          esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Set the compressor parameter of a band
+ *
+ * @param[in]  handle    The N-band MBC handle
+ * @param[in]  band_idx  Band index, 0 is the lowest band, range [0, band_num)
+ * @param[in]  para      The compressor parameter, same ranges as `esp_ae_mbc_para_t`
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_set_para(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, esp_ae_mbc_para_t *para);
+
+/**
+ * @brief  Get the compressor parameter of a band
+ *
+ * @param[in]   handle    The N-band MBC handle
+ * @param[in]   band_idx  Band index, range [0, band_num)
+ * @param[out]  para      The compressor parameter
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_para(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, esp_ae_mbc_para_t *para);
+
+/**
+ * @brief  Set the frequency of a crossover
+ *
+ * @note  With the linear phase crossover the band filters are redesigned, which costs about `band_num` FFTs
+ *        of `2 * fir_len` points. Call it between process calls of the same task
+ *
+ * @param[in]  handle  The N-band MBC handle
+ * @param[in]  fc_idx  Crossover index, range [0, band_num - 1)
+ * @param[in]  fc      Frequency in Hz, must stay between the neighbouring crossovers
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_set_fc(esp_ae_mbc_n_handle_t handle, uint8_t fc_idx, uint32_t fc);
+
+/**
+ * @brief  Get the frequency of a crossover
+ *
+ * @param[in]   handle  The N-band MBC handle
+ * @param[in]   fc_idx  Crossover index, range [0, band_num - 1)
+ * @param[out]  fc      Frequency in Hz
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_fc(esp_ae_mbc_n_handle_t handle, uint8_t fc_idx, uint32_t *fc);
+
+/**
+ * @brief  Set the solo state of a band, when any band is soloed the bands without solo are muted
+ *
+ * @param[in]  handle       The N-band MBC handle
+ * @param[in]  band_idx     Band index, range [0, band_num)
+ * @param[in]  enable_solo  True to solo the band
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_set_solo(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool enable_solo);
+
+/**
+ * @brief  Get the solo state of a band
+ *
+ * @param[in]   handle       The N-band MBC handle
+ * @param[in]   band_idx     Band index, range [0, band_num)
+ * @param[out]  enable_solo  Solo state
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_solo(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool *enable_solo);
+
+/**
+ * @brief  Set the bypass state of a band, a bypassed band passes with unity gain
+ *
+ * @param[in]  handle         The N-band MBC handle
+ * @param[in]  band_idx       Band index, range [0, band_num)
+ * @param[in]  enable_bypass  True to bypass the compressor of the band
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_set_bypass(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool enable_bypass);
+
+/**
+ * @brief  Get the bypass state of a band
+ *
+ * @param[in]   handle         The N-band MBC handle
+ * @param[in]   band_idx       Band index, range [0, band_num)
+ * @param[out]  enable_bypass  Bypass state
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_bypass(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool *enable_bypass);
+
+/**
+ * @brief  Get the current gain reduction of a band for metering, without makeup gain
+ *
+ * @param[in]   handle    The N-band MBC handle
+ * @param[in]   band_idx  Band index, range [0, band_num)
+ * @param[out]  gr_db     Gain reduction in dB, 0 or negative
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_get_gain_reduction(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, float *gr_db);
+
+/**
+ * @brief  Reset the filter and detector states while keeping the parameters
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The N-band MBC handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mbc_n_reset(esp_ae_mbc_n_handle_t handle);
+
+/**
+ * @brief  Deinitialize the N-band MBC handle
+ *
+ * @param  handle  The N-band MBC handle
+ */
+void esp_ae_mbc_n_close(esp_ae_mbc_n_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
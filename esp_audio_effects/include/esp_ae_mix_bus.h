@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Mix bus combines a changing set of audio sources which have the same sample_rate, channel
+ *         and bits_per_sample into one output, it is meant for products mixing many prompt, music
+ *         and voice sources where sources come and go during playback.
+ *         The formula is as follows:
+ *         output = saturate(g0 * input0 + g1 * input1 + g2 * input2 + ...)
+ *
+ *         Compared with `esp_ae_mixer`:
+ *         - Sources are added and removed at runtime through `esp_ae_mix_bus_add_source` and
+ *           `esp_ae_mix_bus_remove_source`, only `max_src_num` is fixed at open
+ *         - Each source has its own gain (linear or dB) and moves to a new gain by a linear ramp
+ *           lasting an exact number of sampling points, the ramp starts at the next processed sample
+ *         - Removed, paused, muted sources and sources whose input buffer is NULL or all zero
+ *           in a processing block are skipped without any multiply-add
+ *         - Sources accumulate in 64 bit integer with Q format gain and saturate only once at the output,
+ *           unity gain sources are mixed bit exactly
+ *
+ *         Mix bus processing is based on sampling points as processing units. The relationship
+ *         between processing data length and sampling points is as follows:
+ *         sample_num = data_length / (channel * (bits_per_sample >> 3))
+ */
+
+/**
+ * @brief  Maximum number of sources of one mix bus
+ */
+#define ESP_AE_MIX_BUS_MAX_SRC_NUM (32)
+
+/**
+ * @brief  Maximum source gain in linear scale (about +24 dB)
+ */
+#define ESP_AE_MIX_BUS_MAX_GAIN (16.0f)
+
+/**
+ * @brief  Gain in dB at or below which a source is treated as muted
+ */
+#define ESP_AE_MIX_BUS_MUTE_DB (-100.0f)
+
+/**
+ * @brief  The handle of mix bus
+ */
+typedef void *esp_ae_mix_bus_handle_t;
+
+/**
+ * @brief  Configuration structure for the mix bus
+ */
+typedef struct {
+    uint32_t sample_rate;      /*!< The audio sample rate */
+    uint8_t  channel;          /*!< The channel number of input and output streams */
+    uint8_t  bits_per_sample;  /*!< Support bits per sample: 16, 24, 32 bit */
+    uint8_t  max_src_num;      /*!< Maximum number of sources added at the same time,
+                                    range [1, ESP_AE_MIX_BUS_MAX_SRC_NUM] */
+} esp_ae_mix_bus_cfg_t;
+
+/**
+ * @brief  Create the mix bus handle through configuration
+ *
+ * @param[in]   cfg     Mix bus configuration
+ * @param[out]  handle  The mix bus handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_open(esp_ae_mix_bus_cfg_t *cfg, esp_ae_mix_bus_handle_t *handle);
+
+/**
+ * @brief  Add a source to the mix bus
+ *
+ * @note  The source id is the index into `in_samples` of the process functions,
+ *        the lowest free id in [0, max_src_num) is returned.
+ *        A new source is active and starts with `gain` directly without ramp
+ *
+ * @param[in]   handle  The mix bus handle
+ * @param[in]   gain    Initial linear gain, range [0, ESP_AE_MIX_BUS_MAX_GAIN]
+ * @param[out]  src_id  The id of the added source
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           All `max_src_num` sources are in use
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_add_source(esp_ae_mix_bus_handle_t handle, float gain, uint8_t *src_id);
+
+/**
+ * @brief  Remove a source from the mix bus, its id can be returned by a later `esp_ae_mix_bus_add_source`
+ *
+ * @note  Removal takes effect immediately, ramp the gain to 0 before removing to avoid a click
+ *
+ * @param[in]  handle  The mix bus handle
+ * @param[in]  src_id  The id of the source to remove
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter or source not added
+ */
+esp_ae_err_t esp_ae_mix_bus_remove_source(esp_ae_mix_bus_handle_t handle, uint8_t src_id);
+
+/**
+ * @brief  Pause or resume a source, a paused source keeps its gain and ramp state but is skipped
+ *
+ * @param[in]  handle  The mix bus handle
+ * @param[in]  src_id  The id of the source
+ * @param[in]  active  True to resume, false to pause
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter or source not added
+ */
+esp_ae_err_t esp_ae_mix_bus_set_active(esp_ae_mix_bus_handle_t handle, uint8_t src_id, bool active);
+
+/**
+ * @brief  Set the linear gain of a source
+ *
+ * @note  The gain moves linearly from its current value to `gain` over exactly `ramp_samples`
+ *        sampling points starting from the next processed sample, 0 applies the gain immediately.
+ *        Calling it during a ramp starts a new ramp from the current value.
+ *        A source skipped for NULL or all-zero input still advances its ramp
+ *
+ * @param[in]  handle        The mix bus handle
+ * @param[in]  src_id        The id of the source
+ * @param[in]  gain          Target linear gain, range [0, ESP_AE_MIX_BUS_MAX_GAIN]
+ * @param[in]  ramp_samples  Ramp length in sampling points
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter or source not added
+ */
+esp_ae_err_t esp_ae_mix_bus_set_gain(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float gain, uint32_t ramp_samples);
+
+/**
+ * @brief  Set the gain of a source in dB
+ *
+ * @note  Same as `esp_ae_mix_bus_set_gain` with `gain = 10 ^ (gain_db / 20)`,
+ *        a value at or below `ESP_AE_MIX_BUS_MUTE_DB` gives gain 0
+ *
+ * @param[in]  handle        The mix bus handle
+ * @param[in]  src_id        The id of the source
+ * @param[in]  gain_db       Target gain in dB, upper limit is 20 * log10(ESP_AE_MIX_BUS_MAX_GAIN)
+ * @param[in]  ramp_samples  Ramp length in sampling points
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter or source not added
+ */
+esp_ae_err_t esp_ae_mix_bus_set_gain_db(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float gain_db,
+                                        uint32_t ramp_samples);
+
+/**
+ * @brief  Get the current linear gain of a source, during a ramp it is the gain reached so far
+ *
+ * @param[in]   handle  The mix bus handle
+ * @param[in]   src_id  The id of the source
+ * @param[out]  gain    Current linear gain
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter or source not added
+ */
+esp_ae_err_t esp_ae_mix_bus_get_gain(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float *gain);
+
+/**
+ * @brief  Mix interleaved audio data of all active sources
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        A NULL pointer in `in_samples` skips that source for this call.
+ *        With no source contributing, the output is filled with silence
+ *
+ * @param[in]   handle       The mix bus handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of `max_src_num` input buffer pointers indexed by source id
+ * @param[out]  out_samples  The output samples buffer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_process(esp_ae_mix_bus_handle_t handle, uint32_t sample_num,
+                                    esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Mix deinterleaved audio data of all active sources
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        A NULL source entry, or a NULL buffer of any channel, skips that source for this call
+ *
+ * @param[in]   handle       The mix bus handle
+ * @param[in]   sample_num   Number of sampling points to process
+ * @param[in]   in_samples   Array of `max_src_num` pointers to per channel buffer arrays indexed by source id.
+ *                           Note: `esp_ae_sample_t *in_samples[]` equal to `in_samples[src_num][ch_num]`
+ * @param[out]  out_samples  Array for output samples buffer pointer with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_deintlv_process(esp_ae_mix_bus_handle_t handle, uint32_t sample_num,
+                                            esp_ae_sample_t *in_samples[], esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Get the number of sources mixed and skipped since open or last reset
+ *
+ * @note  Counted once per source per internal block of processing, useful to check that
+ *        silent sources are skipped
+ *
+ * @param[in]   handle     The mix bus handle
+ * @param[out]  mixed_num  Number of source blocks accumulated, can be NULL
+ * @param[out]  skip_num   Number of source blocks skipped for NULL, all-zero input or zero gain, can be NULL
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_get_stats(esp_ae_mix_bus_handle_t handle, uint32_t *mixed_num, uint32_t *skip_num);
+
+/**
+ * @brief  Remove all sources and clear statistics, the configuration is kept
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The mix bus handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_mix_bus_reset(esp_ae_mix_bus_handle_t handle);
+
+/**
+ * @brief  Deinitialize the mix bus handle
+ *
+ * @param  handle  The mix bus handle
+ */
+void esp_ae_mix_bus_close(esp_ae_mix_bus_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
@@ -0,0 +1,152 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif  /* __cplusplus */
+
+/**
+ * @brief  Noise Suppression (NS) reduces stationary background noise such as fan, air conditioner or
+ *         circuit hiss in voice signals, for intercom and VoIP uplinks.
+ *
+ *         Each channel is analyzed by a short time FFT with the same FFT length as `esp_ae_howl`
+ *         (512 points below 32 kHz, otherwise 1024) at 50% overlap. The noise spectrum is tracked by continuous
+ *         minimum statistics of the smoothed power spectrum, and each bin is attenuated by a Wiener gain with
+ *         decision directed SNR estimation, limited by `suppress_db`.
+ *
+ *         NS processing is frame-based, the frame is half of the FFT length:
+ *         frame_size_bytes = esp_ae_ns_get_frame_size(...);
+ *         samples_per_channel = frame_size_bytes / (channel * (bits_per_sample >> 3)).
+ *         Each `esp_ae_ns_process` / `esp_ae_ns_deintlv_process` call must use exactly one such frame.
+ *         The output is delayed by one frame.
+ *
+ *         Internal processing is in single precision float, chips with FPU are recommended.
+ */
+
+/**
+ * @brief  Range of the maximum noise attenuation in dB
+ */
+#define ESP_AE_NS_MIN_SUPPRESS_DB (-40.0f)
+#define ESP_AE_NS_MAX_SUPPRESS_DB (-3.0f)
+
+/**
+ * @brief  Handle of noise suppression
+ */
+typedef void *esp_ae_ns_handle_t;
+
+/**
+ * @brief  Configuration structure for noise suppression
+ */
+typedef struct {
+    uint32_t  sample_rate;      /*!< The audio sample rate; supported: 8000, 16000, 24000, 32000, 44100, 48000 */
+    uint8_t   channel;          /*!< The audio channel number, each channel is processed independently */
+    uint8_t   bits_per_sample;  /*!< The audio bits per sample; supports 16, 24, 32 bits */
+    float     suppress_db;      /*!< Maximum noise attenuation, range [ESP_AE_NS_MIN_SUPPRESS_DB, ESP_AE_NS_MAX_SUPPRESS_DB].
+                                     Deeper attenuation removes more noise at the cost of more artifacts */
+} esp_ae_ns_cfg_t;
+
+/**
+ * @brief  Create a noise suppression handle through configuration
+ *
+ * @param[in]   cfg     Noise suppression configuration
+ * @param[out]  handle  The noise suppression handle. If an error occurs, the result will be a NULL pointer
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_open(esp_ae_ns_cfg_t *cfg, esp_ae_ns_handle_t *handle);
+
+/**
+ * @brief  Get the frame size in bytes of one process call
+ *
+ * @param[in]   handle      The noise suppression handle
+ * @param[out]  frame_size  Frame size in bytes of interleaved data of all channels
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_get_frame_size(esp_ae_ns_handle_t handle, uint32_t *frame_size);
+
+/**
+ * @brief  Do noise suppression on one frame of interleaved audio data
+ *
+ * @note  The interleaved data is shown in the example:
+ *        sample_num=10, channel=2, the data layout like [L1,R1,...L10,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The noise suppression handle
+ * @param[in]   in_samples   The input samples buffer of one frame
+ * @param[out]  out_samples  The output samples buffer of one frame
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_process(esp_ae_ns_handle_t handle, esp_ae_sample_t in_samples, esp_ae_sample_t out_samples);
+
+/**
+ * @brief  Do noise suppression on one frame of deinterleaved audio data
+ *
+ * @note  The deinterleaved data is shown in the example:
+ *        sample_num=10, channel=2, the array layout like [L1,...,L10], [R1,...,R10]
+ *        Inplace processing is supported
+ *
+ * @param[in]   handle       The noise suppression handle
+ * @param[in]   in_samples   Array of input buffer pointers with each channel
+ * @param[out]  out_samples  Array of output buffer pointers with each channel
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_deintlv_process(esp_ae_ns_handle_t handle, esp_ae_sample_t in_samples[],
+                                       esp_ae_sample_t out_samples[]);
+
+/**
+ * @brief  Set the maximum noise attenuation
+ *
+ * @param[in]  handle       The noise suppression handle
+ * @param[in]  suppress_db  Maximum noise attenuation, range [ESP_AE_NS_MIN_SUPPRESS_DB, ESP_AE_NS_MAX_SUPPRESS_DB]
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_set_suppress(esp_ae_ns_handle_t handle, float suppress_db);
+
+/**
+ * @brief  Reset the internal processing state, the noise estimate is learned again
+ *
+ * @note  This function is not thread-safe, and users must ensure correct call sequencing
+ *        and avoid invoking this function while the process is running
+ *
+ * @param[in]  handle  The noise suppression handle
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Invalid input parameter
+ */
+esp_ae_err_t esp_ae_ns_reset(esp_ae_ns_handle_t handle);
+
+/**
+ * @brief  Deinitialize the noise suppression handle
+ *
+ * @param  handle  The noise suppression handle
+ */
+void esp_ae_ns_close(esp_ae_ns_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif  /* __cplusplus */
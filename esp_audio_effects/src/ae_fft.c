@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ae_fft.h"
+
+static void ae_fft_complex(ae_fft_t *fft, float *z)
+{
+    uint32_t n = fft->len >> 1;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t j = fft->bitrev[i];
+        if (i < j) {
+            float tr = z[2 * i];
+            float ti = z[2 * i + 1];
+            z[2 * i] = z[2 * j];
+            z[2 * i + 1] = z[2 * j + 1];
+            z[2 * j] = tr;
+            z[2 * j + 1] = ti;
+        }
+    }
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        uint32_t half = len >> 1;
+        uint32_t tstep = n / len;
+        for (uint32_t i = 0; i < n; i += len) {
+            for (uint32_t k = 0; k < half; k++) {
+                float wr = fft->twiddle[2 * k * tstep];
+                float wi = fft->twiddle[2 * k * tstep + 1];
+                float *a = z + 2 * (i + k);
+                float *b = z + 2 * (i + k + half);
+                float br = b[0] * wr - b[1] * wi;
+                float bi = b[0] * wi + b[1] * wr;
+                b[0] = a[0] - br;
+                b[1] = a[1] - bi;
+                a[0] += br;
+                a[1] += bi;
+            }
+        }
+    }
+}
+
+esp_ae_err_t ae_fft_init(ae_fft_t *fft, uint32_t len)
+{
+    memset(fft, 0, sizeof(ae_fft_t));
+    if (len < 4 || len > 65536 || (len & (len - 1))) {
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t n = len >> 1;
+    fft->len = len;
+    fft->twiddle = (float *)malloc(n * sizeof(float));
+    fft->rtwiddle = (float *)malloc(2 * n * sizeof(float));
+    fft->bitrev = (uint16_t *)malloc(n * sizeof(uint16_t));
+    if (fft->twiddle == NULL || fft->rtwiddle == NULL || fft->bitrev == NULL) {
+        ae_fft_deinit(fft);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    for (uint32_t k = 0; k < n / 2; k++) {
+        fft->twiddle[2 * k] = (float)cos(2.0 * M_PI * k / n);
+        fft->twiddle[2 * k + 1] = (float)-sin(2.0 * M_PI * k / n);
+    }
+    for (uint32_t k = 0; k < n; k++) {
+        fft->rtwiddle[2 * k] = (float)cos(M_PI * k / n);
+        fft->rtwiddle[2 * k + 1] = (float)-sin(M_PI * k / n);
+    }
+    int bits = 0;
+    while ((1u << bits) < n) {
+        bits++;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t r = 0;
+        for (int b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        fft->bitrev[i] = (uint16_t)r;
+    }
+    return ESP_AE_ERR_OK;
+}
+
+void ae_fft_real(ae_fft_t *fft, float *x, float *spec)
+{
+    uint32_t n = fft->len >> 1;
+    ae_fft_complex(fft, x);
+    spec[0] = x[0] + x[1];
+    spec[1] = 0.0f;
+    spec[2 * n] = x[0] - x[1];
+    spec[2 * n + 1] = 0.0f;
+    for (uint32_t k = 1; k < n; k++) {
+        float ar = x[2 * k];
+        float ai = x[2 * k + 1];
+        float br = x[2 * (n - k)];
+        float bi = x[2 * (n - k) + 1];
+        float er = 0.5f * (ar + br);
+        float ei = 0.5f * (ai - bi);
+        float or = 0.5f * (ai + bi);
+        float oi = -0.5f * (ar - br);
+        float wr = fft->rtwiddle[2 * k];
+        float wi = fft->rtwiddle[2 * k + 1];
+        spec[2 * k] = er + or * wr - oi * wi;
+        spec[2 * k + 1] = ei + or * wi + oi * wr;
+    }
+}
+
+void ae_fft_real_inverse(ae_fft_t *fft, const float *spec, float *x)
+{
+    uint32_t n = fft->len >> 1;
+    for (uint32_t k = 0; k < n; k++) {
+        float ar = spec[2 * k];
+        float ai = spec[2 * k + 1];
+        float br = spec[2 * (n - k)];
+        float bi = -spec[2 * (n - k) + 1];
+        float er = ar + br;
+        float ei = ai + bi;
+        float dr = ar - br;
+        float di = ai - bi;
+        // O = D * conj(W), Z = E + i * O, stored conjugated for inverse through forward FFT
+        float wr = fft->rtwiddle[2 * k];
+        float wi = -fft->rtwiddle[2 * k + 1];
+        float or = dr * wr - di * wi;
+        float oi = dr * wi + di * wr;
+        x[2 * k] = er - oi;
+        x[2 * k + 1] = -(ei + or);
+    }
+    ae_fft_complex(fft, x);
+    for (uint32_t k = 0; k < n; k++) {
+        x[2 * k + 1] = -x[2 * k + 1];
+    }
+}
+
+void ae_fft_deinit(ae_fft_t *fft)
+{
+    if (fft->twiddle) {
+        free(fft->twiddle);
+    }
+    if (fft->rtwiddle) {
+        free(fft->rtwiddle);
+    }
+    if (fft->bitrev) {
+        free(fft->bitrev);
+    }
+    memset(fft, 0, sizeof(ae_fft_t));
+}
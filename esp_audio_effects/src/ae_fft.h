@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Real FFT of `len` points computed by a `len / 2` points complex FFT on the even/odd packed input
+ *
+ * @note  A spectrum is `len / 2 + 1` bins of interleaved real and imaginary parts,
+ *        the imaginary parts of DC and Nyquist bins are 0
+ */
+typedef struct {
+    uint32_t  len;       /*!< Real FFT length, power of 2 in range [4, 65536] */
+    float    *twiddle;   /*!< exp(-2 * pi * i * k / (len / 2)), k < len / 4 */
+    float    *rtwiddle;  /*!< exp(-2 * pi * i * k / len), k < len / 2 */
+    uint16_t *bitrev;    /*!< Bit reversed index of the complex FFT */
+} ae_fft_t;
+
+/**
+ * @brief  Number of float of a spectrum of `len` points real FFT
+ */
+#define AE_FFT_SPEC_SIZE(len) ((len) + 2)
+
+/**
+ * @brief  Allocate tables of real FFT
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  `len` is not a supported power of 2
+ */
+esp_ae_err_t ae_fft_init(ae_fft_t *fft, uint32_t len);
+
+/**
+ * @brief  Forward real FFT, `x` holds `len` samples and is destroyed
+ */
+void ae_fft_real(ae_fft_t *fft, float *x, float *spec);
+
+/**
+ * @brief  Inverse real FFT to `len` samples in `x`, the result is scaled by `len`
+ */
+void ae_fft_real_inverse(ae_fft_t *fft, const float *spec, float *x);
+
+/**
+ * @brief  Free tables of real FFT, safe on a zeroed or partially initialized structure
+ */
+void ae_fft_deinit(ae_fft_t *fft);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ae_stft.h"
+
+uint32_t ae_stft_get_hop(uint32_t sample_rate)
+{
+    switch (sample_rate) {
+        case 8000:
+        case 16000:
+        case 24000:
+            return 256;
+        case 32000:
+        case 44100:
+        case 48000:
+            return 512;
+        default:
+            return 0;
+    }
+}
+
+esp_ae_err_t ae_stft_init(ae_stft_t *stft, uint32_t sample_rate)
+{
+    memset(stft, 0, sizeof(ae_stft_t));
+    uint32_t hop = ae_stft_get_hop(sample_rate);
+    if (hop == 0) {
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t len = 2 * hop;
+    esp_ae_err_t ret = ae_fft_init(&stft->fft, len);
+    if (ret != ESP_AE_ERR_OK) {
+        return ret;
+    }
+    stft->hop = hop;
+    stft->window = (float *)malloc(len * sizeof(float));
+    stft->work = (float *)malloc(len * sizeof(float));
+    if (stft->window == NULL || stft->work == NULL) {
+        ae_stft_deinit(stft);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        stft->window[i] = (float)sin(M_PI * i / len);
+    }
+    return ESP_AE_ERR_OK;
+}
+
+void ae_stft_analyze(ae_stft_t *stft, const float *frame, float *spec)
+{
+    uint32_t len = 2 * stft->hop;
+    for (uint32_t i = 0; i < len; i++) {
+        stft->work[i] = frame[i] * stft->window[i];
+    }
+    ae_fft_real(&stft->fft, stft->work, spec);
+}
+
+void ae_stft_synthesize(ae_stft_t *stft, const float *spec, float *tail, float *out)
+{
+    uint32_t hop = stft->hop;
+    float scale = 1.0f / (2 * hop);
+    ae_fft_real_inverse(&stft->fft, spec, stft->work);
+    for (uint32_t i = 0; i < hop; i++) {
+        out[i] = tail[i] + stft->work[i] * stft->window[i] * scale;
+        tail[i] = stft->work[hop + i] * stft->window[hop + i] * scale;
+    }
+}
+
+void ae_stft_deinit(ae_stft_t *stft)
+{
+    ae_fft_deinit(&stft->fft);
+    if (stft->window) {
+        free(stft->window);
+    }
+    if (stft->work) {
+        free(stft->work);
+    }
+    memset(stft, 0, sizeof(ae_stft_t));
+}
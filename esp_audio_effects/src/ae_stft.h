@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_ae_types.h"
+#include "ae_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Short time Fourier transform framing shared by the spectral voice modules
+ *
+ *         The FFT length follows howl (512 points below 32 kHz, otherwise 1024) and the hop is half of it.
+ *         Analysis and synthesis use a square root periodic Hann window, their product overlap-adds to 1 at
+ *         50% overlap, so an unmodified spectrum is reconstructed exactly with a latency of one hop
+ */
+typedef struct {
+    ae_fft_t  fft;
+    uint32_t  hop;     /*!< Frame length in sampling points, half of the FFT length */
+    float    *window;  /*!< FFT length square root Hann window */
+    float    *work;    /*!< FFT length scratch */
+} ae_stft_t;
+
+/**
+ * @brief  Get the hop of a sample rate
+ *
+ * @return
+ *       - 0       Unsupported sample rate
+ *       - Others  Hop in sampling points
+ */
+uint32_t ae_stft_get_hop(uint32_t sample_rate);
+
+/**
+ * @brief  Initialize framing of a sample rate
+ *
+ * @return
+ *       - ESP_AE_ERR_OK                 Operation succeeded
+ *       - ESP_AE_ERR_MEM_LACK           Fail to allocate memory
+ *       - ESP_AE_ERR_INVALID_PARAMETER  Unsupported sample rate
+ */
+esp_ae_err_t ae_stft_init(ae_stft_t *stft, uint32_t sample_rate);
+
+/**
+ * @brief  Windowed FFT of `2 * hop` samples (previous and current frame) to `hop + 1` bins
+ */
+void ae_stft_analyze(ae_stft_t *stft, const float *frame, float *spec);
+
+/**
+ * @brief  Inverse FFT and overlap-add, output `hop` samples and keep `hop` samples in `tail`
+ */
+void ae_stft_synthesize(ae_stft_t *stft, const float *spec, float *tail, float *out);
+
+/**
+ * @brief  Free framing resources, safe on a zeroed or partially initialized structure
+ */
+void ae_stft_deinit(ae_stft_t *stft);
+
+#ifdef __cplusplus
+}
+#endif
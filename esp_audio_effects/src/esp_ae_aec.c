@@ -0,0 +1,648 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_ae_aec.h"
+#include "ae_stft.h"
+
+#define TAG "AE_AEC"
+
+#define AEC_MU           (0.5f)    /*!< NLMS step size of the background filter */
+#define AEC_POWER_SMOOTH (0.9f)    /*!< Smoothing of reference power for step size normalization */
+#define AEC_FAR_POWER    (1e-6f)   /*!< Mean square of an active reference frame, -60 dBFS */
+#define AEC_REG_POWER    (1e-7f)   /*!< Step size regularization as mean square, -70 dBFS */
+#define AEC_COPY_RATIO   (0.5f)    /*!< Background error below this ratio of foreground error is better */
+#define AEC_COPY_FRAMES  (3)       /*!< Consecutive better frames before copying background to foreground */
+#define AEC_RESET_RATIO  (8.0f)    /*!< Background error above this ratio of foreground error is divergence */
+#define AEC_BANDS        (32)      /*!< Bands of binary spectra for delay estimation */
+#define AEC_BAND_MIN_HZ  (200)
+#define AEC_BAND_MAX_HZ  (4000)
+#define AEC_BAND_SMOOTH  (0.98f)   /*!< Smoothing of band power threshold of binary spectra */
+#define AEC_COST_SMOOTH  (0.95f)   /*!< Smoothing of binary spectra distance per candidate delay */
+#define AEC_DELAY_WARMUP (25)      /*!< Active frames before the first delay decision */
+#define AEC_DELAY_STABLE (10)      /*!< Frames a new candidate must stay the best */
+#define AEC_DELAY_CONF   (0.8f)    /*!< Best distance must be below this ratio of the average distance */
+#define AEC_NLP_SMOOTH   (0.9f)    /*!< Smoothing of auto and cross spectra of NLP */
+#define AEC_NLP_OVER     (2.0f)    /*!< Over suppression of the residual echo estimate */
+#define AEC_NLP_MIN_GAIN (0.03f)   /*!< About -30 dB */
+#define AEC_NLP_FLOOR    (1e-10f)
+
+/**
+ * Spectra are `hop + 1` interleaved complex bins of a `2 * hop` points real FFT.
+ * Reference spectra of every frame are kept in a ring, the filter partition `m` is applied to the spectrum
+ * `delay + m` frames ago (overlap-save multi-delay block filter)
+ */
+typedef struct {
+    uint8_t     bytes;
+    bool        nlp;
+    uint32_t    hop;
+    uint32_t    bins;
+    uint32_t    part_num;      /*!< Filter partitions of one frame */
+    uint32_t    delay_max;     /*!< Maximum estimated delay in frames, 0 means disabled */
+    uint32_t    hist_num;      /*!< Reference spectra in history */
+    uint32_t    hist_pos;      /*!< Slot of the newest reference spectrum */
+    uint32_t    delay;         /*!< Frames between the newest reference and the first filter partition */
+    float       scale;
+    float       out_limit;
+    float       reg;
+    ae_stft_t   stft;          /*!< FFT shared by the linear filter, delay estimation and NLP */
+    float      *ref_hist;      /*!< hist_num reference spectra */
+    float      *ref_energy;    /*!< hist_num reference frame mean squares */
+    float      *fg;            /*!< Foreground filter, part_num spectra */
+    float      *bg;            /*!< Background filter, part_num spectra */
+    float      *ref_pow;       /*!< Smoothed reference power per bin */
+    float      *ref_time;      /*!< Previous and current reference frame */
+    float      *mic;
+    float      *err_f;
+    float      *err_b;
+    float      *echo_f;
+    float      *echo_b;
+    float      *work;          /*!< 2 * hop scratch */
+    float      *spec;          /*!< Spectrum scratch */
+    float      *acc;           /*!< Spectrum scratch */
+    uint32_t    copy_count;
+    uint32_t    constrain_pos; /*!< Partition to apply the gradient constraint, one per frame */
+    /* Delay estimation */
+    float      *mic_time;
+    uint32_t   *ref_bits;      /*!< delay_max + 1 binary spectra ring */
+    float      *cost;          /*!< delay_max + 1 smoothed distances */
+    uint32_t    bits_pos;
+    uint32_t    band_lo;
+    uint32_t    band_width;
+    float       ref_mean[AEC_BANDS];
+    float       mic_mean[AEC_BANDS];
+    uint32_t    updates;
+    uint32_t    cand;
+    uint32_t    cand_count;
+    uint32_t    delay_est;
+    /* Nonlinear processing */
+    float      *e_buf;
+    float      *y_buf;
+    float      *tail;
+    float      *nlp_y;
+    float      *see;
+    float      *syy;
+    float      *sey;           /*!< Complex cross spectrum */
+} aec_t;
+
+static void *aec_malloc(size_t size, bool psram)
+{
+    if (psram) {
+        return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    return malloc(size);
+}
+
+static void aec_read(const uint8_t *in, uint8_t bytes, float *dst, uint32_t n, float inv_scale)
+{
+    switch (bytes) {
+        case 2:
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = ((const int16_t *)in)[i] * inv_scale;
+            }
+            break;
+        case 3:
+            for (uint32_t i = 0; i < n; i++) {
+                const uint8_t *p = in + i * 3;
+                dst[i] = ((int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8)
+                         * inv_scale;
+            }
+            break;
+        default:
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = (float)((const int32_t *)in)[i] * inv_scale;
+            }
+            break;
+    }
+}
+
+static void aec_write(const float *src, uint8_t bytes, uint8_t *out, uint32_t n, float scale, float limit)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        float v = src[i] * scale;
+        v = v > limit ? limit : v < -limit ? -limit : v;
+        int32_t s = (int32_t)lrintf(v);
+        switch (bytes) {
+            case 2:
+                ((int16_t *)out)[i] = (int16_t)s;
+                break;
+            case 3:
+                out[i * 3] = (uint8_t)s;
+                out[i * 3 + 1] = (uint8_t)(s >> 8);
+                out[i * 3 + 2] = (uint8_t)(s >> 16);
+                break;
+            default:
+                ((int32_t *)out)[i] = s;
+                break;
+        }
+    }
+}
+
+static inline uint32_t aec_slot(aec_t *aec, uint32_t lag)
+{
+    return aec->hist_pos >= lag ? aec->hist_pos - lag : aec->hist_pos + aec->hist_num - lag;
+}
+
+static void aec_clear_filter(aec_t *aec)
+{
+    size_t size = (size_t)aec->part_num * 2 * aec->bins * sizeof(float);
+    memset(aec->fg, 0, size);
+    memset(aec->bg, 0, size);
+    aec->copy_count = 0;
+    aec->constrain_pos = 0;
+}
+
+/**
+ * Echo estimate of the current frame by a filter
+ */
+static void aec_filter(aec_t *aec, const float *w, float *echo)
+{
+    uint32_t n = 2 * aec->bins;
+    float inv_len = 1.0f / (2 * aec->hop);
+    memset(aec->acc, 0, n * sizeof(float));
+    for (uint32_t m = 0; m < aec->part_num; m++) {
+        const float *x = aec->ref_hist + (size_t)aec_slot(aec, aec->delay + m) * n;
+        const float *h = w + (size_t)m * n;
+        for (uint32_t k = 0; k < n; k += 2) {
+            aec->acc[k] += x[k] * h[k] - x[k + 1] * h[k + 1];
+            aec->acc[k + 1] += x[k] * h[k + 1] + x[k + 1] * h[k];
+        }
+    }
+    ae_fft_real_inverse(&aec->stft.fft, aec->acc, aec->work);
+    for (uint32_t i = 0; i < aec->hop; i++) {
+        echo[i] = aec->work[aec->hop + i] * inv_len;
+    }
+}
+
+/**
+ * Normalized gradient step of the background filter, then constrain one partition to `hop` taps
+ */
+static void aec_adapt(aec_t *aec)
+{
+    uint32_t hop = aec->hop;
+    uint32_t n = 2 * aec->bins;
+    float inv_len = 1.0f / (2 * hop);
+    float *e = aec->spec;
+    memset(aec->work, 0, hop * sizeof(float));
+    memcpy(aec->work + hop, aec->err_b, hop * sizeof(float));
+    ae_fft_real(&aec->stft.fft, aec->work, e);
+    const float *x0 = aec->ref_hist + (size_t)aec_slot(aec, aec->delay) * n;
+    for (uint32_t k = 0; k < aec->bins; k++) {
+        float p = x0[2 * k] * x0[2 * k] + x0[2 * k + 1] * x0[2 * k + 1];
+        aec->ref_pow[k] = AEC_POWER_SMOOTH * aec->ref_pow[k] + (1.0f - AEC_POWER_SMOOTH) * p;
+        // The step of each bin is kept in the accumulation scratch
+        aec->acc[k] = AEC_MU / (aec->part_num * aec->ref_pow[k] + aec->reg);
+    }
+    for (uint32_t m = 0; m < aec->part_num; m++) {
+        const float *x = aec->ref_hist + (size_t)aec_slot(aec, aec->delay + m) * n;
+        float *h = aec->bg + (size_t)m * n;
+        for (uint32_t k = 0; k < aec->bins; k++) {
+            float xr = x[2 * k];
+            float xi = x[2 * k + 1];
+            float er = e[2 * k];
+            float ei = e[2 * k + 1];
+            float mu = aec->acc[k];
+            h[2 * k] += mu * (xr * er + xi * ei);
+            h[2 * k + 1] += mu * (xr * ei - xi * er);
+        }
+    }
+    float *h = aec->bg + (size_t)aec->constrain_pos * n;
+    ae_fft_real_inverse(&aec->stft.fft, h, aec->work);
+    for (uint32_t i = 0; i < hop; i++) {
+        aec->work[i] *= inv_len;
+    }
+    memset(aec->work + hop, 0, hop * sizeof(float));
+    ae_fft_real(&aec->stft.fft, aec->work, h);
+    aec->constrain_pos = aec->constrain_pos + 1 == aec->part_num ? 0 : aec->constrain_pos + 1;
+}
+
+static uint32_t aec_band_bits(aec_t *aec, const float *spec, float *mean, bool update)
+{
+    uint32_t bits = 0;
+    uint32_t k = aec->band_lo;
+    for (int b = 0; b < AEC_BANDS; b++) {
+        float p = 0.0f;
+        for (uint32_t j = 0; j < aec->band_width; j++, k++) {
+            p += spec[2 * k] * spec[2 * k] + spec[2 * k + 1] * spec[2 * k + 1];
+        }
+        if (p > mean[b]) {
+            bits |= 1u << b;
+        }
+        if (update) {
+            mean[b] = AEC_BAND_SMOOTH * mean[b] + (1.0f - AEC_BAND_SMOOTH) * p;
+        }
+    }
+    return bits;
+}
+
+/**
+ * Match binary band spectra of microphone with the recent reference ones, the filter follows a stable best match
+ */
+static void aec_estimate_delay(aec_t *aec, bool far_active, float mic_energy)
+{
+    uint32_t num = aec->delay_max + 1;
+    memcpy(aec->work, aec->mic_time, 2 * aec->hop * sizeof(float));
+    ae_fft_real(&aec->stft.fft, aec->work, aec->spec);
+    const float *x = aec->ref_hist + (size_t)aec->hist_pos * 2 * aec->bins;
+    aec->ref_bits[aec->bits_pos] = aec_band_bits(aec, x, aec->ref_mean, far_active);
+    bool near_active = mic_energy > AEC_FAR_POWER;
+    uint32_t mic_bits = aec_band_bits(aec, aec->spec, aec->mic_mean, near_active);
+    if (far_active && near_active) {
+        uint32_t best = 0;
+        float sum = 0.0f;
+        for (uint32_t d = 0; d < num; d++) {
+            uint32_t idx = aec->bits_pos >= d ? aec->bits_pos - d : aec->bits_pos + num - d;
+            float dist = (float)__builtin_popcount(mic_bits ^ aec->ref_bits[idx]);
+            aec->cost[d] = AEC_COST_SMOOTH * aec->cost[d] + (1.0f - AEC_COST_SMOOTH) * dist;
+            sum += aec->cost[d];
+            best = aec->cost[d] < aec->cost[best] ? d : best;
+        }
+        aec->updates++;
+        if (best == aec->cand) {
+            aec->cand_count++;
+        } else {
+            aec->cand = best;
+            aec->cand_count = 0;
+        }
+        if (aec->updates >= AEC_DELAY_WARMUP && aec->cand_count >= AEC_DELAY_STABLE
+            && aec->cost[best] < AEC_DELAY_CONF * sum / num && best != aec->delay_est) {
+            aec->delay_est = best;
+            // One frame of margin before the estimate for the echo arriving within the frame
+            uint32_t delay = best > 0 ? best - 1 : 0;
+            if (delay != aec->delay) {
+                ESP_LOGD(TAG, "Delay change %d to %d frames", (int)aec->delay, (int)delay);
+                aec->delay = delay;
+                aec_clear_filter(aec);
+            }
+        }
+    }
+    aec->bits_pos = aec->bits_pos + 1 == num ? 0 : aec->bits_pos + 1;
+}
+
+/**
+ * Suppress residual echo by the part of the output coherent with the echo estimate
+ */
+static void aec_nlp(aec_t *aec, float *out)
+{
+    uint32_t hop = aec->hop;
+    memcpy(aec->e_buf, aec->e_buf + hop, hop * sizeof(float));
+    memcpy(aec->e_buf + hop, aec->err_f, hop * sizeof(float));
+    memcpy(aec->y_buf, aec->y_buf + hop, hop * sizeof(float));
+    memcpy(aec->y_buf + hop, aec->echo_f, hop * sizeof(float));
+    ae_stft_analyze(&aec->stft, aec->y_buf, aec->nlp_y);
+    ae_stft_analyze(&aec->stft, aec->e_buf, aec->spec);
+    float *e = aec->spec;
+    const float *y = aec->nlp_y;
+    const float a = AEC_NLP_SMOOTH;
+    for (uint32_t k = 0; k < aec->bins; k++) {
+        float er = e[2 * k];
+        float ei = e[2 * k + 1];
+        float yr = y[2 * k];
+        float yi = y[2 * k + 1];
+        aec->see[k] = a * aec->see[k] + (1.0f - a) * (er * er + ei * ei);
+        aec->syy[k] = a * aec->syy[k] + (1.0f - a) * (yr * yr + yi * yi);
+        aec->sey[2 * k] = a * aec->sey[2 * k] + (1.0f - a) * (er * yr + ei * yi);
+        aec->sey[2 * k + 1] = a * aec->sey[2 * k + 1] + (1.0f - a) * (ei * yr - er * yi);
+        float cross = aec->sey[2 * k] * aec->sey[2 * k] + aec->sey[2 * k + 1] * aec->sey[2 * k + 1];
+        float residual = cross / (aec->syy[k] + AEC_NLP_FLOOR);
+        float gain = 1.0f - AEC_NLP_OVER * residual / (aec->see[k] + AEC_NLP_FLOOR);
+        gain = gain < AEC_NLP_MIN_GAIN ? AEC_NLP_MIN_GAIN : gain > 1.0f ? 1.0f : gain;
+        e[2 * k] = er * gain;
+        e[2 * k + 1] = ei * gain;
+    }
+    ae_stft_synthesize(&aec->stft, e, aec->tail, out);
+}
+
+static void aec_run(aec_t *aec, const uint8_t *mic_in, const uint8_t *ref_in, uint8_t *out)
+{
+    uint32_t hop = aec->hop;
+    float inv_scale = 1.0f / aec->scale;
+    // Read both inputs before writing so that inplace processing is safe
+    memcpy(aec->ref_time, aec->ref_time + hop, hop * sizeof(float));
+    aec_read(ref_in, aec->bytes, aec->ref_time + hop, hop, inv_scale);
+    aec_read(mic_in, aec->bytes, aec->mic, hop, inv_scale);
+    float ref_energy = 0.0f;
+    float mic_energy = 0.0f;
+    for (uint32_t i = 0; i < hop; i++) {
+        ref_energy += aec->ref_time[hop + i] * aec->ref_time[hop + i];
+        mic_energy += aec->mic[i] * aec->mic[i];
+    }
+    ref_energy /= hop;
+    mic_energy /= hop;
+    aec->hist_pos = aec->hist_pos + 1 == aec->hist_num ? 0 : aec->hist_pos + 1;
+    aec->ref_energy[aec->hist_pos] = ref_energy;
+    memcpy(aec->work, aec->ref_time, 2 * hop * sizeof(float));
+    ae_fft_real(&aec->stft.fft, aec->work, aec->ref_hist + (size_t)aec->hist_pos * 2 * aec->bins);
+    if (aec->delay_max > 0) {
+        memcpy(aec->mic_time, aec->mic_time + hop, hop * sizeof(float));
+        memcpy(aec->mic_time + hop, aec->mic, hop * sizeof(float));
+        aec_estimate_delay(aec, ref_energy > AEC_FAR_POWER, mic_energy);
+    }
+    // The echo of the aligned reference frame is in the current microphone frame
+    bool far_active = aec->ref_energy[aec_slot(aec, aec->delay)] > AEC_FAR_POWER;
+    aec_filter(aec, aec->fg, aec->echo_f);
+    aec_filter(aec, aec->bg, aec->echo_b);
+    float err_f = 0.0f;
+    float err_b = 0.0f;
+    for (uint32_t i = 0; i < hop; i++) {
+        aec->err_f[i] = aec->mic[i] - aec->echo_f[i];
+        aec->err_b[i] = aec->mic[i] - aec->echo_b[i];
+        err_f += aec->err_f[i] * aec->err_f[i];
+        err_b += aec->err_b[i] * aec->err_b[i];
+    }
+    if (far_active) {
+        size_t size = (size_t)aec->part_num * 2 * aec->bins * sizeof(float);
+        if (err_b < AEC_COPY_RATIO * err_f) {
+            if (++aec->copy_count >= AEC_COPY_FRAMES) {
+                memcpy(aec->fg, aec->bg, size);
+                aec->copy_count = 0;
+            }
+        } else {
+            aec->copy_count = 0;
+            // Background diverged by near-end speech, restart it from the foreground
+            if (err_b > AEC_RESET_RATIO * err_f) {
+                memcpy(aec->bg, aec->fg, size);
+            }
+        }
+        aec_adapt(aec);
+    }
+    if (aec->nlp) {
+        // Background echo estimate is no longer needed, reuse it for the NLP output
+        aec_nlp(aec, aec->echo_b);
+        aec_write(aec->echo_b, aec->bytes, out, hop, aec->scale, aec->out_limit);
+    } else {
+        aec_write(aec->err_f, aec->bytes, out, hop, aec->scale, aec->out_limit);
+    }
+}
+
+static void aec_clear(aec_t *aec)
+{
+    size_t spec_size = 2 * aec->bins * sizeof(float);
+    memset(aec->ref_hist, 0, aec->hist_num * spec_size);
+    memset(aec->ref_energy, 0, aec->hist_num * sizeof(float));
+    memset(aec->ref_pow, 0, aec->bins * sizeof(float));
+    memset(aec->ref_time, 0, 2 * aec->hop * sizeof(float));
+    aec_clear_filter(aec);
+    aec->hist_pos = 0;
+    aec->delay = 0;
+    if (aec->delay_max > 0) {
+        memset(aec->mic_time, 0, 2 * aec->hop * sizeof(float));
+        memset(aec->ref_bits, 0, (aec->delay_max + 1) * sizeof(uint32_t));
+        for (uint32_t d = 0; d <= aec->delay_max; d++) {
+            aec->cost[d] = AEC_BANDS / 2;
+        }
+        memset(aec->ref_mean, 0, sizeof(aec->ref_mean));
+        memset(aec->mic_mean, 0, sizeof(aec->mic_mean));
+    }
+    aec->bits_pos = 0;
+    aec->updates = 0;
+    aec->cand = 0;
+    aec->cand_count = 0;
+    aec->delay_est = 0;
+    if (aec->nlp) {
+        memset(aec->e_buf, 0, 2 * aec->hop * sizeof(float));
+        memset(aec->y_buf, 0, 2 * aec->hop * sizeof(float));
+        memset(aec->tail, 0, aec->hop * sizeof(float));
+        memset(aec->see, 0, aec->bins * sizeof(float));
+        memset(aec->syy, 0, aec->bins * sizeof(float));
+        memset(aec->sey, 0, spec_size);
+    }
+}
+
+esp_ae_err_t esp_ae_aec_open(esp_ae_aec_cfg_t *cfg, esp_ae_aec_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (ae_stft_get_hop(cfg->sample_rate) == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d", (int)cfg->sample_rate);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->filter_ms < ESP_AE_AEC_MIN_FILTER_MS || cfg->filter_ms > ESP_AE_AEC_MAX_FILTER_MS
+        || cfg->max_delay_ms > ESP_AE_AEC_MAX_DELAY_MS) {
+        ESP_LOGE(TAG, "Invalid filter_ms:%d max_delay_ms:%d", cfg->filter_ms, cfg->max_delay_ms);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    aec_t *aec = (aec_t *)calloc(1, sizeof(aec_t));
+    if (aec == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    esp_ae_err_t ret = ae_stft_init(&aec->stft, cfg->sample_rate);
+    if (ret != ESP_AE_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to init STFT of sample rate %d", (int)cfg->sample_rate);
+        esp_ae_aec_close(aec);
+        return ret;
+    }
+    uint32_t hop = aec->stft.hop;
+    aec->hop = hop;
+    aec->bins = hop + 1;
+    aec->bytes = cfg->bits_per_sample >> 3;
+    aec->nlp = cfg->enable_nlp;
+    aec->scale = (float)(1u << (cfg->bits_per_sample - 1));
+    aec->out_limit = aec->bytes == 2 ? 32767.0f : aec->bytes == 3 ? 8388607.0f : 2147483520.0f;
+    uint32_t tail = (uint32_t)((uint64_t)cfg->filter_ms * cfg->sample_rate / 1000);
+    aec->delay_max = (uint32_t)(((uint64_t)cfg->max_delay_ms * cfg->sample_rate / 1000 + hop - 1) / hop);
+    // The applied delay is one frame before the estimate, one more partition covers it
+    aec->part_num = (tail + hop - 1) / hop + (aec->delay_max > 0 ? 1 : 0);
+    aec->hist_num = aec->delay_max + aec->part_num;
+    aec->reg = aec->part_num * AEC_REG_POWER * 2 * hop;
+    aec->band_lo = AEC_BAND_MIN_HZ * 2 * hop / cfg->sample_rate;
+    uint32_t band_hi = cfg->sample_rate / 2 < AEC_BAND_MAX_HZ ? hop : AEC_BAND_MAX_HZ * 2 * hop / cfg->sample_rate;
+    aec->band_width = (band_hi - aec->band_lo) / AEC_BANDS;
+    size_t spec_size = 2 * aec->bins * sizeof(float);
+    size_t frame_size = hop * sizeof(float);
+    aec->ref_hist = (float *)aec_malloc(aec->hist_num * spec_size, cfg->use_psram);
+    aec->fg = (float *)aec_malloc(aec->part_num * spec_size, cfg->use_psram);
+    aec->bg = (float *)aec_malloc(aec->part_num * spec_size, cfg->use_psram);
+    aec->ref_energy = (float *)malloc(aec->hist_num * sizeof(float));
+    aec->ref_pow = (float *)malloc(aec->bins * sizeof(float));
+    aec->ref_time = (float *)malloc(2 * frame_size);
+    aec->mic = (float *)malloc(frame_size);
+    aec->err_f = (float *)malloc(frame_size);
+    aec->err_b = (float *)malloc(frame_size);
+    aec->echo_f = (float *)malloc(frame_size);
+    aec->echo_b = (float *)malloc(frame_size);
+    aec->work = (float *)malloc(2 * frame_size);
+    aec->spec = (float *)malloc(spec_size);
+    aec->acc = (float *)malloc(spec_size);
+    if (aec->ref_hist == NULL || aec->fg == NULL || aec->bg == NULL || aec->ref_energy == NULL
+        || aec->ref_pow == NULL || aec->ref_time == NULL || aec->mic == NULL || aec->err_f == NULL
+        || aec->err_b == NULL || aec->echo_f == NULL || aec->echo_b == NULL || aec->work == NULL
+        || aec->spec == NULL || aec->acc == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer, filter %d frames history %d frames", (int)aec->part_num,
+                 (int)aec->hist_num);
+        esp_ae_aec_close(aec);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    if (aec->delay_max > 0) {
+        aec->mic_time = (float *)malloc(2 * frame_size);
+        aec->ref_bits = (uint32_t *)malloc((aec->delay_max + 1) * sizeof(uint32_t));
+        aec->cost = (float *)malloc((aec->delay_max + 1) * sizeof(float));
+        if (aec->mic_time == NULL || aec->ref_bits == NULL || aec->cost == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate delay estimation buffer");
+            esp_ae_aec_close(aec);
+            return ESP_AE_ERR_MEM_LACK;
+        }
+    }
+    if (aec->nlp) {
+        aec->e_buf = (float *)malloc(2 * frame_size);
+        aec->y_buf = (float *)malloc(2 * frame_size);
+        aec->tail = (float *)malloc(frame_size);
+        aec->nlp_y = (float *)malloc(spec_size);
+        aec->see = (float *)malloc(aec->bins * sizeof(float));
+        aec->syy = (float *)malloc(aec->bins * sizeof(float));
+        aec->sey = (float *)malloc(spec_size);
+        if (aec->e_buf == NULL || aec->y_buf == NULL || aec->tail == NULL || aec->nlp_y == NULL || aec->see == NULL
+            || aec->syy == NULL || aec->sey == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate NLP buffer");
+            esp_ae_aec_close(aec);
+            return ESP_AE_ERR_MEM_LACK;
+        }
+    }
+    aec_clear(aec);
+    *handle = aec;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_aec_get_frame_size(esp_ae_aec_handle_t handle, uint32_t *frame_size)
+{
+    if (handle == NULL || frame_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p frame_size:%p", handle, frame_size);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    aec_t *aec = (aec_t *)handle;
+    *frame_size = aec->hop * aec->bytes;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_aec_process(esp_ae_aec_handle_t handle, esp_ae_sample_t mic_samples,
+                                esp_ae_sample_t ref_samples, esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || mic_samples == NULL || ref_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p mic:%p ref:%p out:%p", handle, mic_samples, ref_samples,
+                 out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    aec_run((aec_t *)handle, (const uint8_t *)mic_samples, (const uint8_t *)ref_samples, (uint8_t *)out_samples);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_aec_get_delay(esp_ae_aec_handle_t handle, uint32_t *delay)
+{
+    if (handle == NULL || delay == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p delay:%p", handle, delay);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    aec_t *aec = (aec_t *)handle;
+    *delay = aec->delay_est * aec->hop;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_aec_reset(esp_ae_aec_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    aec_clear((aec_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_aec_close(esp_ae_aec_handle_t handle)
+{
+    aec_t *aec = (aec_t *)handle;
+    if (aec == NULL) {
+        return;
+    }
+    if (aec->ref_hist) {
+        free(aec->ref_hist);
+    }
+    if (aec->fg) {
+        free(aec->fg);
+    }
+    if (aec->bg) {
+        free(aec->bg);
+    }
+    if (aec->ref_energy) {
+        free(aec->ref_energy);
+    }
+    if (aec->ref_pow) {
+        free(aec->ref_pow);
+    }
+    if (aec->ref_time) {
+        free(aec->ref_time);
+    }
+    if (aec->mic) {
+        free(aec->mic);
+    }
+    if (aec->err_f) {
+        free(aec->err_f);
+    }
+    if (aec->err_b) {
+        free(aec->err_b);
+    }
+    if (aec->echo_f) {
+        free(aec->echo_f);
+    }
+    if (aec->echo_b) {
+        free(aec->echo_b);
+    }
+    if (aec->work) {
+        free(aec->work);
+    }
+    if (aec->spec) {
+        free(aec->spec);
+    }
+    if (aec->acc) {
+        free(aec->acc);
+    }
+    if (aec->mic_time) {
+        free(aec->mic_time);
+    }
+    if (aec->ref_bits) {
+        free(aec->ref_bits);
+    }
+    if (aec->cost) {
+        free(aec->cost);
+    }
+    if (aec->e_buf) {
+        free(aec->e_buf);
+    }
+    if (aec->y_buf) {
+        free(aec->y_buf);
+    }
+    if (aec->tail) {
+        free(aec->tail);
+    }
+    if (aec->nlp_y) {
+        free(aec->nlp_y);
+    }
+    if (aec->see) {
+        free(aec->see);
+    }
+    if (aec->syy) {
+        free(aec->syy);
+    }
+    if (aec->sey) {
+        free(aec->sey);
+    }
+    ae_stft_deinit(&aec->stft);
+    free(aec);
+}
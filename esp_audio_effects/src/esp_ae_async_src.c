@@ -0,0 +1,431 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_async_src.h"
+
+#define TAG "AE_ASYNC_SRC"
+
+#define ASYNC_SRC_MIN_RATE   (4000)
+#define ASYNC_SRC_MAX_RATE   (192000)
+#define ASYNC_SRC_MIN_PHASES (4)
+#define ASYNC_SRC_CHUNK      (256)  /*!< Input samples buffered per channel besides filter history */
+#define ASYNC_SRC_ROLLOFF    (0.9)  /*!< Cutoff relative to the lower Nyquist frequency */
+#define ASYNC_SRC_Q32        (4294967296.0)
+
+typedef struct {
+    uint16_t taps;
+    uint16_t phases;
+    double   beta;  /*!< Kaiser window beta */
+} async_src_filter_t;
+
+static const async_src_filter_t async_src_filter[] = {
+    {16, 64, 6.0},
+    {32, 128, 8.0},
+    {64, 128, 10.0},
+};
+
+typedef struct {
+    uint32_t                   src_rate;
+    uint32_t                   dest_rate;
+    uint8_t                    channel;
+    uint8_t                    bytes;
+    uint16_t                   taps;
+    uint16_t                   phases;
+    float                     *coef;       /*!< (phases + 1) rows of taps */
+    float                     *cur_coef;   /*!< Taps interpolated for current output position */
+    float                     *buf;        /*!< Per channel input history, `buf_len` samples each */
+    uint32_t                   buf_len;
+    uint32_t                   fill;       /*!< Valid samples per channel in `buf` */
+    uint64_t                   pos;        /*!< Position of first tap in `buf`, Q32 */
+    uint64_t                   step;       /*!< Input samples advanced per output sample, Q32 */
+    double                     nominal_step;
+    float                      ppm;
+    float                      max_ppm;
+    bool                       pi_enable;
+    esp_ae_async_src_pi_cfg_t  pi;
+    double                     pi_integ;
+} async_src_t;
+
+static double async_src_bessel_i0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+static void async_src_gen_coef(async_src_t *src, double fc, double beta)
+{
+    // coef[p][k] = h(k - taps / 2 + 1 - p / phases), h is Kaiser windowed sinc with support [-taps / 2, taps / 2]
+    double half = src->taps / 2.0;
+    double i0_beta = async_src_bessel_i0(beta);
+    for (int p = 0; p <= src->phases; p++) {
+        float *row = src->coef + p * src->taps;
+        double sum = 0.0;
+        for (int k = 0; k < src->taps; k++) {
+            double t = k - half + 1.0 - (double)p / src->phases;
+            double x = t / half;
+            double w = fabs(x) >= 1.0 ? 0.0 : async_src_bessel_i0(beta * sqrt(1.0 - x * x)) / i0_beta;
+            double arg = M_PI * 2.0 * fc * t;
+            double h = 2.0 * fc * (fabs(arg) < 1e-12 ? 1.0 : sin(arg) / arg) * w;
+            row[k] = (float)h;
+            sum += h;
+        }
+        // Unity DC gain for every phase avoids ripple modulated by the fractional position
+        for (int k = 0; k < src->taps; k++) {
+            row[k] = (float)(row[k] / sum);
+        }
+    }
+}
+
+static void async_src_update_step(async_src_t *src)
+{
+    double step = src->nominal_step / (1.0 + src->ppm * 1e-6);
+    src->step = (uint64_t)(step * ASYNC_SRC_Q32 + 0.5);
+}
+
+static void async_src_clear(async_src_t *src)
+{
+    memset(src->buf, 0, (size_t)src->buf_len * src->channel * sizeof(float));
+    // Pre-fill history so that first output aligns with first input sample
+    src->fill = src->taps / 2 - 1;
+    src->pos = 0;
+    src->ppm = 0.0f;
+    src->pi_integ = 0.0;
+    async_src_update_step(src);
+}
+
+static inline float async_src_read(const uint8_t *p, uint8_t bytes)
+{
+    switch (bytes) {
+        case 2:
+            return *(const int16_t *)p * (1.0f / 32768.0f);
+        case 3: {
+            int32_t v = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+            return v * (1.0f / 8388608.0f);
+        }
+        default:
+            return *(const int32_t *)p * (1.0f / 2147483648.0f);
+    }
+}
+
+static inline void async_src_write(uint8_t *p, uint8_t bytes, float v)
+{
+    if (v > 1.0f) {
+        v = 1.0f;
+    } else if (v < -1.0f) {
+        v = -1.0f;
+    }
+    switch (bytes) {
+        case 2: {
+            int32_t s = (int32_t)lrintf(v * 32768.0f);
+            *(int16_t *)p = (int16_t)(s > INT16_MAX ? INT16_MAX : s);
+            break;
+        }
+        case 3: {
+            int32_t s = (int32_t)lrintf(v * 8388608.0f);
+            s = s > 0x7FFFFF ? 0x7FFFFF : s;
+            p[0] = (uint8_t)s;
+            p[1] = (uint8_t)(s >> 8);
+            p[2] = (uint8_t)(s >> 16);
+            break;
+        }
+        default: {
+            double d = (double)v * 2147483648.0;
+            *(int32_t *)p = d >= 2147483647.0 ? INT32_MAX : (int32_t)lrint(d);
+            break;
+        }
+    }
+}
+
+static esp_ae_err_t async_src_run(async_src_t *src, const uint8_t *in[], uint32_t in_stride, uint32_t in_num,
+                                  uint8_t *out[], uint32_t out_stride, uint32_t *out_num)
+{
+    uint32_t max_out = 0;
+    esp_ae_async_src_get_max_out_sample_num(src, in_num, &max_out);
+    if (*out_num < max_out) {
+        ESP_LOGE(TAG, "Output buffer too small %d, need %d", (int)*out_num, (int)max_out);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t consumed = 0;
+    uint32_t produced = 0;
+    uint32_t in_step = in_stride * src->bytes;
+    uint32_t out_step = out_stride * src->bytes;
+    while (1) {
+        uint32_t n = src->buf_len - src->fill;
+        if (n > in_num - consumed) {
+            n = in_num - consumed;
+        }
+        for (int c = 0; c < src->channel; c++) {
+            const uint8_t *p = in[c] + consumed * in_step;
+            float *dst = src->buf + c * src->buf_len + src->fill;
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = async_src_read(p, src->bytes);
+                p += in_step;
+            }
+        }
+        src->fill += n;
+        consumed += n;
+        while ((uint32_t)(src->pos >> 32) + src->taps <= src->fill) {
+            uint32_t idx = (uint32_t)(src->pos >> 32);
+            uint64_t phase = (src->pos & 0xFFFFFFFF) * src->phases;
+            uint32_t p = (uint32_t)(phase >> 32);
+            float mu = (float)(phase & 0xFFFFFFFF) * (float)(1.0 / ASYNC_SRC_Q32);
+            const float *c0 = src->coef + p * src->taps;
+            const float *c1 = c0 + src->taps;
+            for (int k = 0; k < src->taps; k++) {
+                src->cur_coef[k] = c0[k] + mu * (c1[k] - c0[k]);
+            }
+            for (int c = 0; c < src->channel; c++) {
+                const float *x = src->buf + c * src->buf_len + idx;
+                float acc = 0.0f;
+                for (int k = 0; k < src->taps; k++) {
+                    acc += x[k] * src->cur_coef[k];
+                }
+                async_src_write(out[c] + produced * out_step, src->bytes, acc);
+            }
+            produced++;
+            src->pos += src->step;
+        }
+        uint32_t drop = (uint32_t)(src->pos >> 32);
+        if (drop > src->fill) {
+            drop = src->fill;
+        }
+        if (drop) {
+            for (int c = 0; c < src->channel; c++) {
+                float *b = src->buf + c * src->buf_len;
+                memmove(b, b + drop, (src->fill - drop) * sizeof(float));
+            }
+            src->fill -= drop;
+            src->pos -= (uint64_t)drop << 32;
+        }
+        if (consumed >= in_num) {
+            break;
+        }
+    }
+    *out_num = produced;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_open(esp_ae_async_src_cfg_t *cfg, esp_ae_async_src_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->src_rate < ASYNC_SRC_MIN_RATE || cfg->src_rate > ASYNC_SRC_MAX_RATE
+        || cfg->dest_rate < ASYNC_SRC_MIN_RATE || cfg->dest_rate > ASYNC_SRC_MAX_RATE) {
+        ESP_LOGE(TAG, "Invalid sample rate src:%d dest:%d", (int)cfg->src_rate, (int)cfg->dest_rate);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->channel == 0 || (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+                              && cfg->bits_per_sample != ESP_AE_BIT32)) {
+        ESP_LOGE(TAG, "Invalid channel:%d bits:%d", cfg->channel, cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->complexity < 1 || cfg->complexity > 3) {
+        ESP_LOGE(TAG, "Invalid complexity:%d", cfg->complexity);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)calloc(1, sizeof(async_src_t));
+    if (src == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    const async_src_filter_t *filter = &async_src_filter[cfg->complexity - 1];
+    // Downsampling stretches the kernel by the ratio to keep the stopband attenuation. The stretched kernel is
+    // smoother between input samples, so the phase table shrinks by the same factor and memory stays bounded
+    uint32_t factor = (cfg->src_rate + cfg->dest_rate - 1) / cfg->dest_rate;
+    uint32_t phases = filter->phases / factor;
+    src->src_rate = cfg->src_rate;
+    src->dest_rate = cfg->dest_rate;
+    src->channel = cfg->channel;
+    src->bytes = cfg->bits_per_sample >> 3;
+    src->taps = filter->taps * factor;
+    src->phases = phases < ASYNC_SRC_MIN_PHASES ? ASYNC_SRC_MIN_PHASES : phases;
+    src->max_ppm = cfg->max_ppm ? cfg->max_ppm : ESP_AE_ASYNC_SRC_DEFAULT_MAX_PPM;
+    src->nominal_step = (double)cfg->src_rate / cfg->dest_rate;
+    src->buf_len = src->taps + ASYNC_SRC_CHUNK;
+    src->coef = (float *)malloc((src->phases + 1) * src->taps * sizeof(float));
+    src->cur_coef = (float *)malloc(src->taps * sizeof(float));
+    src->buf = (float *)malloc((size_t)src->buf_len * src->channel * sizeof(float));
+    if (src->coef == NULL || src->cur_coef == NULL || src->buf == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate filter");
+        esp_ae_async_src_close(src);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    double fc = 0.5 * ASYNC_SRC_ROLLOFF;
+    if (cfg->dest_rate < cfg->src_rate) {
+        fc *= (double)cfg->dest_rate / cfg->src_rate;
+    }
+    async_src_gen_coef(src, fc, filter->beta);
+    async_src_clear(src);
+    *handle = src;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_get_max_out_sample_num(esp_ae_async_src_handle_t handle, uint32_t in_sample_num,
+                                                     uint32_t *out_sample_num)
+{
+    if (handle == NULL || out_sample_num == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p out_sample_num:%p", handle, out_sample_num);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)handle;
+    double min_step = src->nominal_step / (1.0 + src->max_ppm * 1e-6);
+    *out_sample_num = (uint32_t)ceil(in_sample_num / min_step) + 2;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_process(esp_ae_async_src_handle_t handle, esp_ae_sample_t in_samples,
+                                      uint32_t in_sample_num, esp_ae_sample_t out_samples,
+                                      uint32_t *out_sample_num)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL || out_sample_num == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p out_num:%p", handle, in_samples, out_samples,
+                 out_sample_num);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)handle;
+    const uint8_t *in[src->channel];
+    uint8_t *out[src->channel];
+    for (int c = 0; c < src->channel; c++) {
+        in[c] = (const uint8_t *)in_samples + c * src->bytes;
+        out[c] = (uint8_t *)out_samples + c * src->bytes;
+    }
+    return async_src_run(src, in, src->channel, in_sample_num, out, src->channel, out_sample_num);
+}
+
+esp_ae_err_t esp_ae_async_src_deintlv_process(esp_ae_async_src_handle_t handle, esp_ae_sample_t in_samples[],
+                                              uint32_t in_sample_num, esp_ae_sample_t out_samples[],
+                                              uint32_t *out_sample_num)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL || out_sample_num == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p out_num:%p", handle, in_samples, out_samples,
+                 out_sample_num);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)handle;
+    for (int c = 0; c < src->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    return async_src_run(src, (const uint8_t **)in_samples, 1, in_sample_num, (uint8_t **)out_samples, 1,
+                         out_sample_num);
+}
+
+esp_ae_err_t esp_ae_async_src_set_ratio_ppm(esp_ae_async_src_handle_t handle, float ppm)
+{
+    async_src_t *src = (async_src_t *)handle;
+    if (src == NULL || ppm > src->max_ppm || ppm < -src->max_ppm) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p ppm:%.2f", handle, ppm);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    src->ppm = ppm;
+    async_src_update_step(src);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_get_ratio_ppm(esp_ae_async_src_handle_t handle, float *ppm)
+{
+    if (handle == NULL || ppm == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p ppm:%p", handle, ppm);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *ppm = ((async_src_t *)handle)->ppm;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_set_pi(esp_ae_async_src_handle_t handle, esp_ae_async_src_pi_cfg_t *pi_cfg)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)handle;
+    if (pi_cfg == NULL) {
+        src->pi_enable = false;
+        return ESP_AE_ERR_OK;
+    }
+    if (pi_cfg->kp < 0.0f || pi_cfg->ki < 0.0f) {
+        ESP_LOGE(TAG, "Invalid PI gain kp:%.4f ki:%.4f", pi_cfg->kp, pi_cfg->ki);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    src->pi = *pi_cfg;
+    // Start integral from current adjustment so enabling the controller does not cause a jump
+    src->pi_integ = src->pi.ki > 0.0f ? -src->ppm / src->pi.ki : 0.0;
+    src->pi_enable = true;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_update_level(esp_ae_async_src_handle_t handle, uint32_t level)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_t *src = (async_src_t *)handle;
+    if (src->pi_enable == false) {
+        return ESP_AE_ERR_NOT_SUPPORT;
+    }
+    double err = (double)level - src->pi.target_level;
+    double integ = src->pi_integ + err;
+    double ppm = -(src->pi.kp * err + src->pi.ki * integ);
+    if (ppm > src->max_ppm) {
+        ppm = src->max_ppm;
+    } else if (ppm < -src->max_ppm) {
+        ppm = -src->max_ppm;
+    } else {
+        // Only integrate when not saturated to avoid wind-up
+        src->pi_integ = integ;
+    }
+    src->ppm = (float)ppm;
+    async_src_update_step(src);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_async_src_reset(esp_ae_async_src_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    async_src_clear((async_src_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_async_src_close(esp_ae_async_src_handle_t handle)
+{
+    async_src_t *src = (async_src_t *)handle;
+    if (src == NULL) {
+        return;
+    }
+    if (src->coef) {
+        free(src->coef);
+    }
+    if (src->cur_coef) {
+        free(src->cur_coef);
+    }
+    if (src->buf) {
+        free(src->buf);
+    }
+    free(src);
+}
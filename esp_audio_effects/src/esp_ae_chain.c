@@ -0,0 +1,662 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <stdatomic.h>
+#include "esp_idf_version.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "esp_ae_chain.h"
+#include "esp_ae_alc.h"
+#include "esp_ae_eq.h"
+#include "esp_ae_drc.h"
+#include "esp_ae_mbc.h"
+#include "esp_ae_fade.h"
+#include "esp_ae_delay.h"
+#include "esp_ae_reverb.h"
+#include "esp_ae_bit_cvt.h"
+
+#define TAG "AE_CHAIN"
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#define GET_CYCLE_COUNT() esp_cpu_get_cycle_count()
+#else
+#define GET_CYCLE_COUNT() esp_cpu_get_ccount()
+#endif  /* ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0) */
+
+typedef esp_ae_err_t (*chain_process_func_t)(void *handle, uint32_t sample_num,
+                                             esp_ae_sample_t in_samples, esp_ae_sample_t out_samples);
+typedef esp_ae_err_t (*chain_reset_func_t)(void *handle);
+typedef void (*chain_close_func_t)(void *handle);
+
+typedef struct {
+    void                      *handle;
+    esp_ae_chain_stage_type_t  type;
+    chain_process_func_t       process;
+    chain_reset_func_t         reset;
+    chain_close_func_t         close;
+    uint64_t                   cycles;
+} chain_stage_t;
+
+typedef struct {
+    esp_ae_chain_param_t  from;  /*!< Value when the ramp started */
+    esp_ae_chain_param_t  to;    /*!< Final value, its identifiers locate the target */
+    uint32_t              pos;
+    uint32_t              len;
+} chain_ramp_t;
+
+typedef struct {
+    uint8_t                  channel;
+    uint8_t                  bytes;       /*!< Bytes per sample of chain edge */
+    uint8_t                  work_bytes;  /*!< Bytes per sample used by stages */
+    uint16_t                 block_size;
+    uint8_t                  stage_num;
+    chain_stage_t            stages[ESP_AE_CHAIN_MAX_STAGE_NUM];
+    esp_ae_bit_cvt_handle_t  in_cvt;
+    esp_ae_bit_cvt_handle_t  out_cvt;
+    uint8_t                 *work_buf;    /*!< One block in working format, only allocated with edge conversion */
+    uint64_t                 edge_cycles;
+    esp_ae_chain_param_t    *queue;
+    uint32_t                 queue_mask;  /*!< Queue size is a power of 2 */
+    atomic_uint              queue_head;  /*!< Free running read counter, only written by process */
+    atomic_uint              queue_tail;  /*!< Free running write counter, only written by post */
+    uint32_t                 ramp_len;    /*!< Ramp length in samples per channel */
+    uint8_t                  ramp_num;
+    chain_ramp_t             ramps[ESP_AE_CHAIN_MAX_RAMP_NUM];
+    uint64_t                 param_cycles;
+} chain_t;
+
+static const esp_ae_chain_stage_type_t chain_param_stage[ESP_AE_CHAIN_PARAM_MAX] = {
+    [ESP_AE_CHAIN_PARAM_EQ_FILTER] = ESP_AE_CHAIN_STAGE_EQ,
+    [ESP_AE_CHAIN_PARAM_DRC_CURVE] = ESP_AE_CHAIN_STAGE_DRC,
+    [ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN] = ESP_AE_CHAIN_STAGE_DRC,
+    [ESP_AE_CHAIN_PARAM_ALC_GAIN] = ESP_AE_CHAIN_STAGE_ALC,
+    [ESP_AE_CHAIN_PARAM_REVERB_ROOM_SIZE] = ESP_AE_CHAIN_STAGE_REVERB,
+    [ESP_AE_CHAIN_PARAM_REVERB_DAMPING] = ESP_AE_CHAIN_STAGE_REVERB,
+    [ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL] = ESP_AE_CHAIN_STAGE_REVERB,
+    [ESP_AE_CHAIN_PARAM_REVERB_DRY_LEVEL] = ESP_AE_CHAIN_STAGE_REVERB,
+    [ESP_AE_CHAIN_PARAM_DELAY_FEEDBACK] = ESP_AE_CHAIN_STAGE_DELAY,
+    [ESP_AE_CHAIN_PARAM_DELAY_MIX] = ESP_AE_CHAIN_STAGE_DELAY,
+};
+
+typedef union {
+    esp_ae_alc_cfg_t     alc;
+    esp_ae_eq_cfg_t      eq;
+    esp_ae_drc_cfg_t     drc;
+    esp_ae_mbc_config_t  mbc;
+    esp_ae_fade_cfg_t    fade;
+    esp_ae_delay_cfg_t   delay;
+    esp_ae_reverb_cfg_t  reverb;
+} chain_module_cfg_t;
+
+#define CHAIN_COPY_CFG(dst, src, rate, ch, bits) do {  \
+    if (src) {                                         \
+        memcpy(&(dst), (src), sizeof(dst));            \
+    }                                                  \
+    (dst).sample_rate = (rate);                        \
+    (dst).channel = (ch);                              \
+    (dst).bits_per_sample = (bits);                    \
+} while (0)
+
+static bool chain_is_valid_bits(uint8_t bits)
+{
+    return bits == ESP_AE_BIT16 || bits == ESP_AE_BIT24 || bits == ESP_AE_BIT32;
+}
+
+static esp_ae_err_t chain_open_stage(esp_ae_chain_cfg_t *cfg, uint8_t work_bits, esp_ae_chain_stage_t *stage_cfg,
+                                     chain_stage_t *stage)
+{
+    chain_module_cfg_t mod_cfg = {0};
+    esp_ae_err_t ret = ESP_AE_ERR_OK;
+    stage->type = stage_cfg->type;
+    if (stage_cfg->cfg == NULL && stage_cfg->type != ESP_AE_CHAIN_STAGE_ALC) {
+        ESP_LOGE(TAG, "Stage configuration of type %d is NULL", stage_cfg->type);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    switch (stage_cfg->type) {
+        case ESP_AE_CHAIN_STAGE_ALC:
+            CHAIN_COPY_CFG(mod_cfg.alc, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_alc_open(&mod_cfg.alc, &stage->handle);
+            stage->process = esp_ae_alc_process;
+            stage->reset = esp_ae_alc_reset;
+            stage->close = esp_ae_alc_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_EQ:
+            CHAIN_COPY_CFG(mod_cfg.eq, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_eq_open(&mod_cfg.eq, &stage->handle);
+            stage->process = esp_ae_eq_process;
+            stage->reset = esp_ae_eq_reset;
+            stage->close = esp_ae_eq_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_DRC:
+            CHAIN_COPY_CFG(mod_cfg.drc, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_drc_open(&mod_cfg.drc, &stage->handle);
+            stage->process = esp_ae_drc_process;
+            stage->reset = esp_ae_drc_reset;
+            stage->close = esp_ae_drc_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_MBC:
+            CHAIN_COPY_CFG(mod_cfg.mbc, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_mbc_open(&mod_cfg.mbc, &stage->handle);
+            stage->process = esp_ae_mbc_process;
+            stage->reset = esp_ae_mbc_reset;
+            stage->close = esp_ae_mbc_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_FADE:
+            CHAIN_COPY_CFG(mod_cfg.fade, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_fade_open(&mod_cfg.fade, &stage->handle);
+            stage->process = esp_ae_fade_process;
+            stage->reset = esp_ae_fade_reset;
+            stage->close = esp_ae_fade_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_DELAY:
+            CHAIN_COPY_CFG(mod_cfg.delay, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_delay_open(&mod_cfg.delay, &stage->handle);
+            stage->process = esp_ae_delay_process;
+            stage->reset = esp_ae_delay_reset;
+            stage->close = esp_ae_delay_close;
+            break;
+        case ESP_AE_CHAIN_STAGE_REVERB:
+            CHAIN_COPY_CFG(mod_cfg.reverb, stage_cfg->cfg, cfg->sample_rate, cfg->channel, work_bits);
+            ret = esp_ae_reverb_open(&mod_cfg.reverb, &stage->handle);
+            stage->process = esp_ae_reverb_process;
+            stage->reset = esp_ae_reverb_reset;
+            stage->close = esp_ae_reverb_close;
+            break;
+        default:
+            ESP_LOGE(TAG, "Not support stage type %d", stage_cfg->type);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (ret != ESP_AE_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to open stage type %d, ret %d", stage_cfg->type, ret);
+    }
+    return ret;
+}
+
+esp_ae_err_t esp_ae_chain_open(esp_ae_chain_cfg_t *cfg, esp_ae_chain_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    uint8_t work_bits = cfg->work_bits ? cfg->work_bits : cfg->bits_per_sample;
+    if (cfg->sample_rate == 0 || cfg->channel == 0 || !chain_is_valid_bits(cfg->bits_per_sample)
+        || !chain_is_valid_bits(work_bits)) {
+        ESP_LOGE(TAG, "Invalid audio info rate:%d ch:%d bits:%d work_bits:%d", (int)cfg->sample_rate,
+                 cfg->channel, cfg->bits_per_sample, work_bits);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->stages == NULL || cfg->stage_num == 0 || cfg->stage_num > ESP_AE_CHAIN_MAX_STAGE_NUM) {
+        ESP_LOGE(TAG, "Invalid stages:%p stage_num:%d", cfg->stages, cfg->stage_num);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    chain_t *chain = (chain_t *)calloc(1, sizeof(chain_t));
+    if (chain == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate chain");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    chain->channel = cfg->channel;
+    chain->bytes = cfg->bits_per_sample >> 3;
+    chain->work_bytes = work_bits >> 3;
+    chain->block_size = cfg->block_size ? cfg->block_size : ESP_AE_CHAIN_DEFAULT_BLOCK_SIZE;
+    chain->ramp_len = (uint32_t)((uint64_t)cfg->ramp_ms * cfg->sample_rate / 1000);
+    uint32_t queue_size = 1;
+    while (queue_size < (cfg->param_queue_size ? cfg->param_queue_size : ESP_AE_CHAIN_DEFAULT_PARAM_QUEUE_SIZE)) {
+        queue_size <<= 1;
+    }
+    chain->queue_mask = queue_size - 1;
+    atomic_init(&chain->queue_head, 0);
+    atomic_init(&chain->queue_tail, 0);
+    esp_ae_err_t ret = ESP_AE_ERR_OK;
+    chain->queue = (esp_ae_chain_param_t *)malloc(queue_size * sizeof(esp_ae_chain_param_t));
+    if (chain->queue == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate parameter queue");
+        ret = ESP_AE_ERR_MEM_LACK;
+        goto _exit;
+    }
+    for (int i = 0; i < cfg->stage_num; i++) {
+        ret = chain_open_stage(cfg, work_bits, &cfg->stages[i], &chain->stages[i]);
+        if (ret != ESP_AE_ERR_OK) {
+            goto _exit;
+        }
+        chain->stage_num++;
+    }
+    if (work_bits != cfg->bits_per_sample) {
+        esp_ae_bit_cvt_cfg_t cvt_cfg = {
+            .sample_rate = cfg->sample_rate,
+            .channel = cfg->channel,
+            .src_bits = cfg->bits_per_sample,
+            .dest_bits = work_bits,
+        };
+        ret = esp_ae_bit_cvt_open(&cvt_cfg, &chain->in_cvt);
+        if (ret != ESP_AE_ERR_OK) {
+            goto _exit;
+        }
+        cvt_cfg.src_bits = work_bits;
+        cvt_cfg.dest_bits = cfg->bits_per_sample;
+        ret = esp_ae_bit_cvt_open(&cvt_cfg, &chain->out_cvt);
+        if (ret != ESP_AE_ERR_OK) {
+            goto _exit;
+        }
+        chain->work_buf = (uint8_t *)malloc(chain->block_size * chain->channel * chain->work_bytes);
+        if (chain->work_buf == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate work buffer");
+            ret = ESP_AE_ERR_MEM_LACK;
+            goto _exit;
+        }
+    }
+    *handle = chain;
+    return ESP_AE_ERR_OK;
+_exit:
+    esp_ae_chain_close(chain);
+    return ret;
+}
+
+static esp_ae_err_t chain_set_param(chain_t *chain, const esp_ae_chain_param_t *param)
+{
+    void *handle = chain->stages[param->stage_idx].handle;
+    switch (param->id) {
+        case ESP_AE_CHAIN_PARAM_EQ_FILTER: {
+            esp_ae_eq_filter_para_t para = param->value.eq_filter;
+            return esp_ae_eq_set_filter_para(handle, param->idx, &para);
+        }
+        case ESP_AE_CHAIN_PARAM_DRC_CURVE: {
+            esp_ae_chain_drc_curve_t curve = param->value.drc_curve;
+            return esp_ae_drc_set_curve_points(handle, curve.point, curve.point_num);
+        }
+        case ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN:
+            return esp_ae_drc_set_makeup_gain(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_ALC_GAIN:
+            return esp_ae_alc_set_gain(handle, param->idx, param->value.alc_gain);
+        case ESP_AE_CHAIN_PARAM_REVERB_ROOM_SIZE:
+            return esp_ae_reverb_set_room_size(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_DAMPING:
+            return esp_ae_reverb_set_damping(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL:
+            return esp_ae_reverb_set_wet_level(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_DRY_LEVEL:
+            return esp_ae_reverb_set_dry_level(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_DELAY_FEEDBACK:
+            return esp_ae_delay_set_feedback(handle, param->value.f);
+        case ESP_AE_CHAIN_PARAM_DELAY_MIX:
+            return esp_ae_delay_set_mix(handle, param->value.f);
+        default:
+            return ESP_AE_ERR_NOT_SUPPORT;
+    }
+}
+
+/**
+ * Read the current value of the parameter addressed by `param` into `cur`
+ */
+static esp_ae_err_t chain_get_param(chain_t *chain, const esp_ae_chain_param_t *param, esp_ae_chain_param_t *cur)
+{
+    void *handle = chain->stages[param->stage_idx].handle;
+    *cur = *param;
+    switch (param->id) {
+        case ESP_AE_CHAIN_PARAM_EQ_FILTER:
+            return esp_ae_eq_get_filter_para(handle, param->idx, &cur->value.eq_filter);
+        case ESP_AE_CHAIN_PARAM_DRC_CURVE: {
+            uint8_t point_num = 0;
+            esp_ae_err_t ret = esp_ae_drc_get_curve_point_num(handle, &point_num);
+            if (ret != ESP_AE_ERR_OK || point_num > ESP_AE_CHAIN_DRC_MAX_POINT_NUM) {
+                return ESP_AE_ERR_NOT_SUPPORT;
+            }
+            cur->value.drc_curve.point_num = point_num;
+            return esp_ae_drc_get_curve_points(handle, cur->value.drc_curve.point);
+        }
+        case ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN:
+            return esp_ae_drc_get_makeup_gain(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_ROOM_SIZE:
+            return esp_ae_reverb_get_room_size(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_DAMPING:
+            return esp_ae_reverb_get_damping(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL:
+            return esp_ae_reverb_get_wet_level(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_REVERB_DRY_LEVEL:
+            return esp_ae_reverb_get_dry_level(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_DELAY_FEEDBACK:
+            return esp_ae_delay_get_feedback(handle, &cur->value.f);
+        case ESP_AE_CHAIN_PARAM_DELAY_MIX:
+            return esp_ae_delay_get_mix(handle, &cur->value.f);
+        default:
+            return ESP_AE_ERR_NOT_SUPPORT;
+    }
+}
+
+static bool chain_param_rampable(const esp_ae_chain_param_t *cur, const esp_ae_chain_param_t *param)
+{
+    switch (param->id) {
+        case ESP_AE_CHAIN_PARAM_ALC_GAIN:
+            return false;
+        case ESP_AE_CHAIN_PARAM_EQ_FILTER:
+            return cur->value.eq_filter.filter_type == param->value.eq_filter.filter_type
+                   && cur->value.eq_filter.fc > 0 && param->value.eq_filter.fc > 0
+                   && cur->value.eq_filter.q > 0.0f && param->value.eq_filter.q > 0.0f;
+        case ESP_AE_CHAIN_PARAM_DRC_CURVE:
+            if (cur->value.drc_curve.point_num != param->value.drc_curve.point_num) {
+                return false;
+            }
+            for (int i = 0; i < param->value.drc_curve.point_num; i++) {
+                if (cur->value.drc_curve.point[i].x != param->value.drc_curve.point[i].x) {
+                    return false;
+                }
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+/**
+ * Interpolation bounded by both ends, so intermediate values stay in the valid range of the setter
+ */
+static inline float chain_clamp(float v, float a, float b)
+{
+    float lo = a < b ? a : b;
+    float hi = a < b ? b : a;
+    return v < lo ? lo : v > hi ? hi : v;
+}
+
+static inline float chain_lerp(float a, float b, float t)
+{
+    return chain_clamp(a + (b - a) * t, a, b);
+}
+
+static void chain_ramp_value(const chain_ramp_t *ramp, float t, esp_ae_chain_param_t *value)
+{
+    const esp_ae_chain_param_t *a = &ramp->from;
+    const esp_ae_chain_param_t *b = &ramp->to;
+    *value = *b;
+    switch (b->id) {
+        case ESP_AE_CHAIN_PARAM_EQ_FILTER: {
+            // Frequency and Q move on a log scale, gain in dB moves linearly
+            const esp_ae_eq_filter_para_t *fa = &a->value.eq_filter;
+            const esp_ae_eq_filter_para_t *fb = &b->value.eq_filter;
+            float fc = expf(logf((float)fa->fc) + logf((float)fb->fc / fa->fc) * t);
+            value->value.eq_filter.fc = (uint32_t)lrintf(chain_clamp(fc, (float)fa->fc, (float)fb->fc));
+            float q = expf(logf(fa->q) + logf(fb->q / fa->q) * t);
+            value->value.eq_filter.q = chain_clamp(q, fa->q, fb->q);
+            value->value.eq_filter.gain = chain_lerp(fa->gain, fb->gain, t);
+            break;
+        }
+        case ESP_AE_CHAIN_PARAM_DRC_CURVE:
+            for (int i = 0; i < b->value.drc_curve.point_num; i++) {
+                value->value.drc_curve.point[i].y = chain_lerp(a->value.drc_curve.point[i].y,
+                                                               b->value.drc_curve.point[i].y, t);
+            }
+            break;
+        default:
+            value->value.f = chain_lerp(a->value.f, b->value.f, t);
+            break;
+    }
+}
+
+static int chain_find_ramp(chain_t *chain, const esp_ae_chain_param_t *param)
+{
+    for (int i = 0; i < chain->ramp_num; i++) {
+        esp_ae_chain_param_t *to = &chain->ramps[i].to;
+        if (to->stage_idx == param->stage_idx && to->id == param->id && to->idx == param->idx) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void chain_remove_ramp(chain_t *chain, int idx)
+{
+    chain->ramp_num--;
+    if (idx != chain->ramp_num) {
+        chain->ramps[idx] = chain->ramps[chain->ramp_num];
+    }
+}
+
+static void chain_start_param(chain_t *chain, const esp_ae_chain_param_t *param)
+{
+    int idx = chain_find_ramp(chain, param);
+    esp_ae_chain_param_t cur;
+    bool ramp = chain->ramp_len > 0 && chain_get_param(chain, param, &cur) == ESP_AE_ERR_OK
+                && chain_param_rampable(&cur, param);
+    if (ramp && idx < 0 && chain->ramp_num < ESP_AE_CHAIN_MAX_RAMP_NUM) {
+        idx = chain->ramp_num++;
+    } else if (!ramp || idx < 0) {
+        // Applied at once, a ramp of the same target must not overwrite it later
+        if (idx >= 0) {
+            chain_remove_ramp(chain, idx);
+        }
+        esp_ae_err_t ret = chain_set_param(chain, param);
+        if (ret != ESP_AE_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to set parameter %d of stage %d, ret %d", param->id, param->stage_idx, ret);
+        }
+        return;
+    }
+    // The current value is the last interpolated one when the target was already ramping
+    chain_ramp_t *r = &chain->ramps[idx];
+    r->from = cur;
+    r->to = *param;
+    r->pos = 0;
+    r->len = chain->ramp_len;
+}
+
+static void chain_consume_params(chain_t *chain)
+{
+    uint32_t head = atomic_load_explicit(&chain->queue_head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&chain->queue_tail, memory_order_acquire);
+    if (head == tail) {
+        return;
+    }
+    while (head != tail) {
+        chain_start_param(chain, &chain->queue[head & chain->queue_mask]);
+        head++;
+    }
+    atomic_store_explicit(&chain->queue_head, head, memory_order_release);
+}
+
+/**
+ * Set the value every ramp reaches at the end of the next `sample_num` samples
+ */
+static void chain_step_ramps(chain_t *chain, uint32_t sample_num)
+{
+    int i = 0;
+    while (i < chain->ramp_num) {
+        chain_ramp_t *r = &chain->ramps[i];
+        esp_ae_chain_param_t value;
+        r->pos += sample_num;
+        bool done = r->pos >= r->len;
+        if (done) {
+            value = r->to;
+        } else {
+            chain_ramp_value(r, (float)r->pos / r->len, &value);
+        }
+        esp_ae_err_t ret = chain_set_param(chain, &value);
+        if (ret != ESP_AE_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to ramp parameter %d of stage %d, ret %d", value.id, value.stage_idx, ret);
+            done = true;
+        }
+        if (done) {
+            chain_remove_ramp(chain, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+static inline esp_ae_err_t chain_run_stages(chain_t *chain, uint32_t sample_num, uint8_t *in, uint8_t *buf)
+{
+    for (int i = 0; i < chain->stage_num; i++) {
+        chain_stage_t *stage = &chain->stages[i];
+        uint32_t start = GET_CYCLE_COUNT();
+        // First stage reads from input directly, later stages work in place
+        esp_ae_err_t ret = stage->process(stage->handle, sample_num, i == 0 ? in : buf, buf);
+        stage->cycles += (uint32_t)(GET_CYCLE_COUNT() - start);
+        if (ret != ESP_AE_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to process stage %d, ret %d", i, ret);
+            return ret;
+        }
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_process(esp_ae_chain_handle_t handle, uint32_t sample_num,
+                                  esp_ae_sample_t in_samples, esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    chain_t *chain = (chain_t *)handle;
+    uint8_t *in = (uint8_t *)in_samples;
+    uint8_t *out = (uint8_t *)out_samples;
+    uint32_t frame_bytes = chain->channel * chain->bytes;
+    esp_ae_err_t ret = ESP_AE_ERR_OK;
+    while (sample_num > 0) {
+        uint32_t n = sample_num > chain->block_size ? chain->block_size : sample_num;
+        uint32_t start = GET_CYCLE_COUNT();
+        chain_consume_params(chain);
+        if (chain->ramp_num > 0) {
+            n = n > ESP_AE_CHAIN_RAMP_STEP ? ESP_AE_CHAIN_RAMP_STEP : n;
+            chain_step_ramps(chain, n);
+        }
+        chain->param_cycles += (uint32_t)(GET_CYCLE_COUNT() - start);
+        if (chain->work_buf == NULL) {
+            ret = chain_run_stages(chain, n, in, out);
+        } else {
+            start = GET_CYCLE_COUNT();
+            esp_ae_bit_cvt_process(chain->in_cvt, n, in, chain->work_buf);
+            chain->edge_cycles += (uint32_t)(GET_CYCLE_COUNT() - start);
+            ret = chain_run_stages(chain, n, chain->work_buf, chain->work_buf);
+            start = GET_CYCLE_COUNT();
+            esp_ae_bit_cvt_process(chain->out_cvt, n, chain->work_buf, out);
+            chain->edge_cycles += (uint32_t)(GET_CYCLE_COUNT() - start);
+        }
+        if (ret != ESP_AE_ERR_OK) {
+            return ret;
+        }
+        in += n * frame_bytes;
+        out += n * frame_bytes;
+        sample_num -= n;
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_post_param(esp_ae_chain_handle_t handle, const esp_ae_chain_param_t *param)
+{
+    chain_t *chain = (chain_t *)handle;
+    if (chain == NULL || param == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p param:%p", handle, param);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (param->stage_idx >= chain->stage_num || (uint32_t)param->id >= ESP_AE_CHAIN_PARAM_MAX
+        || chain_param_stage[param->id] != chain->stages[param->stage_idx].type
+        || (param->id == ESP_AE_CHAIN_PARAM_DRC_CURVE
+            && param->value.drc_curve.point_num > ESP_AE_CHAIN_DRC_MAX_POINT_NUM)) {
+        ESP_LOGE(TAG, "Invalid parameter stage_idx:%d id:%d", param->stage_idx, param->id);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t tail = atomic_load_explicit(&chain->queue_tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&chain->queue_head, memory_order_acquire);
+    if (tail - head > chain->queue_mask) {
+        ESP_LOGD(TAG, "Parameter queue is full");
+        return ESP_AE_ERR_FAIL;
+    }
+    chain->queue[tail & chain->queue_mask] = *param;
+    atomic_store_explicit(&chain->queue_tail, tail + 1, memory_order_release);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_get_stage_handle(esp_ae_chain_handle_t handle, uint8_t stage_idx, void **stage_handle)
+{
+    chain_t *chain = (chain_t *)handle;
+    if (chain == NULL || stage_handle == NULL || stage_idx >= chain->stage_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p stage_idx:%d", handle, stage_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *stage_handle = chain->stages[stage_idx].handle;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_get_stage_cycles(esp_ae_chain_handle_t handle, uint8_t stage_idx, uint64_t *cycles)
+{
+    chain_t *chain = (chain_t *)handle;
+    if (chain == NULL || cycles == NULL || stage_idx >= chain->stage_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p stage_idx:%d", handle, stage_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *cycles = chain->stages[stage_idx].cycles;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_get_edge_cycles(esp_ae_chain_handle_t handle, uint64_t *cycles)
+{
+    if (handle == NULL || cycles == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p cycles:%p", handle, cycles);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *cycles = ((chain_t *)handle)->edge_cycles;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_get_param_cycles(esp_ae_chain_handle_t handle, uint64_t *cycles)
+{
+    if (handle == NULL || cycles == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p cycles:%p", handle, cycles);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *cycles = ((chain_t *)handle)->param_cycles;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_chain_reset(esp_ae_chain_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    chain_t *chain = (chain_t *)handle;
+    esp_ae_err_t ret = ESP_AE_ERR_OK;
+    for (int i = 0; i < chain->ramp_num; i++) {
+        chain_set_param(chain, &chain->ramps[i].to);
+    }
+    chain->ramp_num = 0;
+    for (int i = 0; i < chain->stage_num; i++) {
+        esp_ae_err_t stage_ret = chain->stages[i].reset(chain->stages[i].handle);
+        if (stage_ret != ESP_AE_ERR_OK) {
+            ret = stage_ret;
+        }
+        chain->stages[i].cycles = 0;
+    }
+    chain->edge_cycles = 0;
+    chain->param_cycles = 0;
+    return ret;
+}
+
+void esp_ae_chain_close(esp_ae_chain_handle_t handle)
+{
+    chain_t *chain = (chain_t *)handle;
+    if (chain == NULL) {
+        return;
+    }
+    for (int i = 0; i < chain->stage_num; i++) {
+        chain->stages[i].close(chain->stages[i].handle);
+    }
+    if (chain->in_cvt) {
+        esp_ae_bit_cvt_close(chain->in_cvt);
+    }
+    if (chain->out_cvt) {
+        esp_ae_bit_cvt_close(chain->out_cvt);
+    }
+    if (chain->work_buf) {
+        free(chain->work_buf);
+    }
+    if (chain->queue) {
+        free(chain->queue);
+    }
+    free(chain);
+}
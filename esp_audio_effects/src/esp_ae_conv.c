@@ -0,0 +1,346 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_ae_conv.h"
+#include "ae_fft.h"
+
+#define TAG "AE_CONV"
+
+#define CONV_MIN_PARTITION (32)
+#define CONV_MAX_PARTITION (4096)
+
+/**
+ * Spectra are stored as `block + 1` interleaved complex bins of a `2 * block` point real FFT
+ */
+typedef struct {
+    uint8_t    channel;
+    uint8_t    bytes;
+    uint8_t    ir_channel;
+    uint32_t   block;      /*!< Partition size */
+    uint32_t   part_num;   /*!< Number of IR partitions */
+    float      dry_gain;
+    float      wet_gain;
+    ae_fft_t   fft;
+    float     *ir_spec;    /*!< ir_channel x part_num spectra, scaled for the inverse transform */
+    float     *fdl;        /*!< channel x part_num input spectra history (frequency domain delay line) */
+    float     *time;       /*!< channel x (previous block, current block) input */
+    float     *out_blk;    /*!< channel x block output ready for reading */
+    float     *work;       /*!< 2 * block time domain scratch */
+    float     *acc;        /*!< block + 1 complex accumulation */
+    uint32_t   fill;       /*!< Sampling points of current block received */
+    uint32_t   fdl_pos;    /*!< Slot of the newest input spectrum in `fdl` */
+} conv_t;
+
+static void *conv_malloc(size_t size, bool psram)
+{
+    if (psram) {
+        return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    return malloc(size);
+}
+
+static void conv_block(conv_t *cv)
+{
+    uint32_t n = cv->block;
+    uint32_t bins = 2 * (n + 1);
+    for (int c = 0; c < cv->channel; c++) {
+        float *t = cv->time + c * 2 * n;
+        float *fdl = cv->fdl + (size_t)c * cv->part_num * bins;
+        const float *h = cv->ir_spec + (size_t)(cv->ir_channel == 1 ? 0 : c) * cv->part_num * bins;
+        memcpy(cv->work, t, 2 * n * sizeof(float));
+        ae_fft_real(&cv->fft, cv->work, fdl + cv->fdl_pos * bins);
+        memset(cv->acc, 0, bins * sizeof(float));
+        uint32_t slot = cv->fdl_pos;
+        for (uint32_t p = 0; p < cv->part_num; p++) {
+            const float *x = fdl + slot * bins;
+            const float *hp = h + p * bins;
+            for (uint32_t k = 0; k < bins; k += 2) {
+                cv->acc[k] += x[k] * hp[k] - x[k + 1] * hp[k + 1];
+                cv->acc[k + 1] += x[k] * hp[k + 1] + x[k + 1] * hp[k];
+            }
+            slot = slot == 0 ? cv->part_num - 1 : slot - 1;
+        }
+        ae_fft_real_inverse(&cv->fft, cv->acc, cv->work);
+        // Overlap-save: the second half is the valid linear convolution of current block
+        float *o = cv->out_blk + c * n;
+        for (uint32_t i = 0; i < n; i++) {
+            o[i] = cv->wet_gain * cv->work[n + i] + cv->dry_gain * t[n + i];
+        }
+        memcpy(t, t + n, n * sizeof(float));
+    }
+    cv->fdl_pos = cv->fdl_pos + 1 == cv->part_num ? 0 : cv->fdl_pos + 1;
+}
+
+static void conv_read(const uint8_t *in, uint8_t bytes, uint32_t stride, float *dst, uint32_t n)
+{
+    switch (bytes) {
+        case 2:
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = ((const int16_t *)in)[i * stride];
+            }
+            break;
+        case 3:
+            for (uint32_t i = 0; i < n; i++) {
+                const uint8_t *p = in + i * stride * 3;
+                dst[i] = (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+            }
+            break;
+        default:
+            for (uint32_t i = 0; i < n; i++) {
+                dst[i] = (float)((const int32_t *)in)[i * stride];
+            }
+            break;
+    }
+}
+
+static void conv_write(const float *src, uint8_t bytes, uint32_t stride, uint8_t *out, uint32_t n)
+{
+    switch (bytes) {
+        case 2:
+            for (uint32_t i = 0; i < n; i++) {
+                float v = src[i];
+                ((int16_t *)out)[i * stride] = v >= 32767.0f ? INT16_MAX : v <= -32768.0f ? INT16_MIN : (int16_t)lrintf(v);
+            }
+            break;
+        case 3:
+            for (uint32_t i = 0; i < n; i++) {
+                float v = src[i];
+                int32_t s = v >= 8388607.0f ? 0x7FFFFF : v <= -8388608.0f ? -0x800000 : (int32_t)lrintf(v);
+                uint8_t *p = out + i * stride * 3;
+                p[0] = (uint8_t)s;
+                p[1] = (uint8_t)(s >> 8);
+                p[2] = (uint8_t)(s >> 16);
+            }
+            break;
+        default:
+            for (uint32_t i = 0; i < n; i++) {
+                float v = src[i];
+                ((int32_t *)out)[i * stride] = v >= 2147483647.0f ? INT32_MAX : v <= -2147483648.0f ? INT32_MIN : (int32_t)lrintf(v);
+            }
+            break;
+    }
+}
+
+static void conv_run(conv_t *cv, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                     uint32_t out_stride)
+{
+    uint32_t n = cv->block;
+    uint32_t done = 0;
+    while (done < sample_num) {
+        uint32_t m = n - cv->fill;
+        if (m > sample_num - done) {
+            m = sample_num - done;
+        }
+        // Read all channels before writing so that inplace processing is safe
+        for (int c = 0; c < cv->channel; c++) {
+            conv_read(in[c] + done * in_stride * cv->bytes, cv->bytes, in_stride, cv->time + c * 2 * n + n + cv->fill, m);
+        }
+        for (int c = 0; c < cv->channel; c++) {
+            conv_write(cv->out_blk + c * n + cv->fill, cv->bytes, out_stride, out[c] + done * out_stride * cv->bytes, m);
+        }
+        cv->fill += m;
+        done += m;
+        if (cv->fill == n) {
+            conv_block(cv);
+            cv->fill = 0;
+        }
+    }
+}
+
+static void conv_clear(conv_t *cv)
+{
+    uint32_t n = cv->block;
+    memset(cv->fdl, 0, (size_t)cv->channel * cv->part_num * 2 * (n + 1) * sizeof(float));
+    memset(cv->time, 0, cv->channel * 2 * n * sizeof(float));
+    memset(cv->out_blk, 0, cv->channel * n * sizeof(float));
+    cv->fill = 0;
+    cv->fdl_pos = 0;
+}
+
+esp_ae_err_t esp_ae_conv_open(esp_ae_conv_cfg_t *cfg, esp_ae_conv_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->sample_rate == 0 || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t block = cfg->partition_size ? cfg->partition_size : ESP_AE_CONV_DEFAULT_PARTITION_SIZE;
+    if (block < CONV_MIN_PARTITION || block > CONV_MAX_PARTITION || (block & (block - 1))) {
+        ESP_LOGE(TAG, "Invalid partition_size:%d", (int)block);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->ir == NULL || cfg->ir_len == 0 || cfg->ir_len > ESP_AE_CONV_MAX_IR_LEN
+        || (cfg->ir_channel != 1 && cfg->ir_channel != cfg->channel)) {
+        ESP_LOGE(TAG, "Invalid ir:%p ir_len:%d ir_channel:%d", cfg->ir, (int)cfg->ir_len, cfg->ir_channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    for (int c = 0; c < cfg->ir_channel; c++) {
+        if (cfg->ir[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter ir of channel %d is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    conv_t *cv = (conv_t *)calloc(1, sizeof(conv_t));
+    if (cv == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    uint32_t bins = 2 * (block + 1);
+    cv->channel = cfg->channel;
+    cv->bytes = cfg->bits_per_sample >> 3;
+    cv->ir_channel = cfg->ir_channel;
+    cv->block = block;
+    cv->part_num = (cfg->ir_len + block - 1) / block;
+    cv->dry_gain = cfg->dry_gain;
+    cv->wet_gain = cfg->wet_gain;
+    esp_ae_err_t ret = ae_fft_init(&cv->fft, 2 * block);
+    if (ret != ESP_AE_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to init FFT of %d points", (int)(2 * block));
+        goto _exit;
+    }
+    ret = ESP_AE_ERR_MEM_LACK;
+    cv->time = (float *)malloc(cfg->channel * 2 * block * sizeof(float));
+    cv->out_blk = (float *)malloc(cfg->channel * block * sizeof(float));
+    cv->work = (float *)malloc(2 * block * sizeof(float));
+    cv->acc = (float *)malloc(bins * sizeof(float));
+    cv->ir_spec = (float *)conv_malloc((size_t)cfg->ir_channel * cv->part_num * bins * sizeof(float), cfg->use_psram);
+    cv->fdl = (float *)conv_malloc((size_t)cfg->channel * cv->part_num * bins * sizeof(float), cfg->use_psram);
+    if (cv->time == NULL || cv->out_blk == NULL || cv->work == NULL || cv->acc == NULL || cv->ir_spec == NULL
+        || cv->fdl == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer, partition %d ir_len %d", (int)block, (int)cfg->ir_len);
+        goto _exit;
+    }
+    // IR partition p occupies the first half of a 2 * block frame for overlap-save
+    float scale = 1.0f / (2 * block);
+    for (int c = 0; c < cfg->ir_channel; c++) {
+        for (uint32_t p = 0; p < cv->part_num; p++) {
+            uint32_t start = p * block;
+            uint32_t len = cfg->ir_len - start < block ? cfg->ir_len - start : block;
+            memset(cv->work, 0, 2 * block * sizeof(float));
+            for (uint32_t i = 0; i < len; i++) {
+                cv->work[i] = cfg->ir[c][start + i] * scale;
+            }
+            ae_fft_real(&cv->fft, cv->work, cv->ir_spec + ((size_t)c * cv->part_num + p) * bins);
+        }
+    }
+    conv_clear(cv);
+    *handle = cv;
+    return ESP_AE_ERR_OK;
+_exit:
+    esp_ae_conv_close(cv);
+    return ret;
+}
+
+esp_ae_err_t esp_ae_conv_get_latency(esp_ae_conv_handle_t handle, uint32_t *latency)
+{
+    if (handle == NULL || latency == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p latency:%p", handle, latency);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *latency = ((conv_t *)handle)->block;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_conv_process(esp_ae_conv_handle_t handle, uint32_t sample_num, esp_ae_sample_t in_samples,
+                                 esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    conv_t *cv = (conv_t *)handle;
+    uint8_t *in[cv->channel];
+    uint8_t *out[cv->channel];
+    for (int c = 0; c < cv->channel; c++) {
+        in[c] = (uint8_t *)in_samples + c * cv->bytes;
+        out[c] = (uint8_t *)out_samples + c * cv->bytes;
+    }
+    conv_run(cv, sample_num, in, cv->channel, out, cv->channel);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_conv_deintlv_process(esp_ae_conv_handle_t handle, uint32_t sample_num,
+                                         esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[])
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    conv_t *cv = (conv_t *)handle;
+    for (int c = 0; c < cv->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    conv_run(cv, sample_num, (uint8_t **)in_samples, 1, (uint8_t **)out_samples, 1);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_conv_set_mix(esp_ae_conv_handle_t handle, float dry_gain, float wet_gain)
+{
+    if (handle == NULL || isnan(dry_gain) || isnan(wet_gain)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p dry:%.3f wet:%.3f", handle, dry_gain, wet_gain);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    conv_t *cv = (conv_t *)handle;
+    cv->dry_gain = dry_gain;
+    cv->wet_gain = wet_gain;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_conv_reset(esp_ae_conv_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    conv_clear((conv_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_conv_close(esp_ae_conv_handle_t handle)
+{
+    conv_t *cv = (conv_t *)handle;
+    if (cv == NULL) {
+        return;
+    }
+    ae_fft_deinit(&cv->fft);
+    if (cv->time) {
+        free(cv->time);
+    }
+    if (cv->out_blk) {
+        free(cv->out_blk);
+    }
+    if (cv->work) {
+        free(cv->work);
+    }
+    if (cv->acc) {
+        free(cv->acc);
+    }
+    if (cv->ir_spec) {
+        free(cv->ir_spec);
+    }
+    if (cv->fdl) {
+        free(cv->fdl);
+    }
+    free(cv);
+}
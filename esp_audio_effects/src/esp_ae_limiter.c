@@ -0,0 +1,413 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_limiter.h"
+
+#define TAG "AE_LIMITER"
+
+#define LIMITER_TP_TAPS   (2 * ESP_AE_LIMITER_TRUE_PEAK_DELAY)
+#define LIMITER_TP_PHASES (3)
+#define LIMITER_GAIN_ONE  (1 << 30)  /*!< Q30 gain in the averaging window, integer sum does not drift */
+
+typedef struct {
+    uint8_t                  channel;
+    uint8_t                  bytes;
+    esp_ae_limiter_detect_t  mode;
+    uint32_t                 sample_rate;
+    uint32_t                 window;        /*!< Lookahead in sampling points plus 1 */
+    uint32_t                 latency;
+    float                    ceiling;       /*!< Linear ceiling of normalized samples */
+    float                    out_limit;     /*!< Integer valued ceiling in output scale */
+    float                    scale;         /*!< Full scale of the integer format */
+    float                    release_coef;
+    float                    tp_coef[LIMITER_TP_PHASES][LIMITER_TP_TAPS];
+    float                   *tp_hist;       /*!< channel x (2 * taps), each sample written twice for a linear read */
+    uint32_t                 tp_pos;
+    float                    tp_prev;       /*!< Interpolated peak of the previous sample interval */
+    float                   *delay;         /*!< channel x (latency + 1) */
+    uint32_t                 delay_pos;
+    float                   *dq_val;        /*!< Monotonic queue of required gain for the sliding window minimum */
+    uint32_t                *dq_idx;
+    uint32_t                 dq_head;
+    uint32_t                 dq_num;
+    int32_t                 *box;           /*!< Q30 smoothed gain of the last `window` sampling points */
+    uint32_t                 box_pos;
+    int64_t                  box_sum;
+    float                    box_scale;
+    float                    smooth;
+    float                    gain;
+    uint32_t                 count;
+} limiter_t;
+
+static void limiter_set_ceiling(limiter_t *lim, float ceiling_db)
+{
+    float max_pos = lim->bytes == 2 ? 32767.0f : lim->bytes == 3 ? 8388607.0f : 2147483520.0f;
+    lim->ceiling = powf(10.0f, ceiling_db / 20.0f);
+    lim->out_limit = floorf(lim->ceiling * lim->scale);
+    if (lim->out_limit > max_pos) {
+        lim->out_limit = max_pos;
+    }
+}
+
+/**
+ * Windowed sinc interpolators for the points at 1/4, 2/4 and 3/4 between x[n - 6] and x[n - 5],
+ * coefficients are stored in the order of the history buffer (oldest first)
+ */
+static void limiter_init_true_peak(limiter_t *lim)
+{
+    for (int p = 0; p < LIMITER_TP_PHASES; p++) {
+        double frac = (p + 1) / 4.0;
+        double sum = 0.0;
+        double coef[LIMITER_TP_TAPS];
+        for (int j = 0; j < LIMITER_TP_TAPS; j++) {
+            double t = j - ESP_AE_LIMITER_TRUE_PEAK_DELAY + frac;
+            double sinc = fabs(t) < 1e-9 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+            double win = 0.5 + 0.5 * cos(M_PI * t / (ESP_AE_LIMITER_TRUE_PEAK_DELAY + 0.5));
+            coef[j] = sinc * win;
+            sum += coef[j];
+        }
+        for (int j = 0; j < LIMITER_TP_TAPS; j++) {
+            lim->tp_coef[p][LIMITER_TP_TAPS - 1 - j] = (float)(coef[j] / sum);
+        }
+    }
+}
+
+static inline float limiter_read(const uint8_t *in, uint8_t bytes)
+{
+    switch (bytes) {
+        case 2:
+            return *(const int16_t *)in;
+        case 3:
+            return (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24)) >> 8;
+        default:
+            return (float)*(const int32_t *)in;
+    }
+}
+
+static inline void limiter_write(uint8_t *out, uint8_t bytes, float v, float limit)
+{
+    v = v > limit ? limit : v < -limit ? -limit : v;
+    int32_t s = (int32_t)lrintf(v);
+    switch (bytes) {
+        case 2:
+            *(int16_t *)out = (int16_t)s;
+            break;
+        case 3:
+            out[0] = (uint8_t)s;
+            out[1] = (uint8_t)(s >> 8);
+            out[2] = (uint8_t)(s >> 16);
+            break;
+        default:
+            *(int32_t *)out = s;
+            break;
+    }
+}
+
+/**
+ * Peak of all channels of one sampling point, return the peak of the sample `detect delay` ago
+ */
+static inline float limiter_detect(limiter_t *lim, const float *x)
+{
+    float peak = 0.0f;
+    if (lim->mode == ESP_AE_LIMITER_DETECT_SAMPLE_PEAK) {
+        for (int c = 0; c < lim->channel; c++) {
+            float a = fabsf(x[c]);
+            peak = a > peak ? a : peak;
+        }
+        return peak;
+    }
+    float interval = 0.0f;
+    uint32_t pos = lim->tp_pos;
+    for (int c = 0; c < lim->channel; c++) {
+        float *h = lim->tp_hist + c * 2 * LIMITER_TP_TAPS;
+        h[pos] = x[c];
+        h[pos + LIMITER_TP_TAPS] = x[c];
+        // h[pos + 1 .. pos + taps] is the history from oldest to newest
+        const float *w = h + pos + 1;
+        for (int p = 0; p < LIMITER_TP_PHASES; p++) {
+            const float *k = lim->tp_coef[p];
+            float acc = 0.0f;
+            for (int j = 0; j < LIMITER_TP_TAPS; j++) {
+                acc += w[j] * k[j];
+            }
+            acc = fabsf(acc);
+            interval = acc > interval ? acc : interval;
+        }
+        float a = fabsf(w[LIMITER_TP_TAPS - 1 - ESP_AE_LIMITER_TRUE_PEAK_DELAY]);
+        peak = a > peak ? a : peak;
+    }
+    lim->tp_pos = pos + 1 == LIMITER_TP_TAPS ? 0 : pos + 1;
+    // The sample is bounded by the intervals on both sides
+    peak = interval > peak ? interval : peak;
+    peak = lim->tp_prev > peak ? lim->tp_prev : peak;
+    lim->tp_prev = interval;
+    return peak;
+}
+
+static inline float limiter_gain(limiter_t *lim, float peak)
+{
+    float need = peak > lim->ceiling ? lim->ceiling / peak : 1.0f;
+    // Sliding window minimum over `window` sampling points, amortized O(1)
+    uint32_t cap = lim->window;
+    if (lim->dq_num > 0 && lim->count - lim->dq_idx[lim->dq_head] >= cap) {
+        lim->dq_head = lim->dq_head + 1 == cap ? 0 : lim->dq_head + 1;
+        lim->dq_num--;
+    }
+    while (lim->dq_num > 0) {
+        uint32_t back = lim->dq_head + lim->dq_num - 1;
+        back = back >= cap ? back - cap : back;
+        if (lim->dq_val[back] < need) {
+            break;
+        }
+        lim->dq_num--;
+    }
+    uint32_t tail = lim->dq_head + lim->dq_num;
+    tail = tail >= cap ? tail - cap : tail;
+    lim->dq_val[tail] = need;
+    lim->dq_idx[tail] = lim->count;
+    lim->dq_num++;
+    lim->count++;
+    float hold = lim->dq_val[lim->dq_head];
+    // Instant attack keeps the hold, release moves up exponentially
+    if (hold < lim->smooth) {
+        lim->smooth = hold;
+    } else {
+        lim->smooth += lim->release_coef * (hold - lim->smooth);
+    }
+    // Averaging over the window reaches the held gain exactly when the peak leaves the delay line
+    int32_t q = (int32_t)(lim->smooth * LIMITER_GAIN_ONE);
+    lim->box_sum += q - lim->box[lim->box_pos];
+    lim->box[lim->box_pos] = q;
+    lim->box_pos = lim->box_pos + 1 == cap ? 0 : lim->box_pos + 1;
+    return (float)lim->box_sum * lim->box_scale;
+}
+
+static void limiter_run(limiter_t *lim, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                        uint32_t out_stride)
+{
+    float x[lim->channel];
+    uint32_t size = lim->latency + 1;
+    float inv_scale = 1.0f / lim->scale;
+    for (uint32_t i = 0; i < sample_num; i++) {
+        for (int c = 0; c < lim->channel; c++) {
+            x[c] = limiter_read(in[c] + i * in_stride * lim->bytes, lim->bytes) * inv_scale;
+        }
+        float gain = limiter_gain(lim, limiter_detect(lim, x));
+        uint32_t rd = lim->delay_pos + 1 == size ? 0 : lim->delay_pos + 1;
+        for (int c = 0; c < lim->channel; c++) {
+            float *d = lim->delay + c * size;
+            d[lim->delay_pos] = x[c];
+            limiter_write(out[c] + i * out_stride * lim->bytes, lim->bytes, d[rd] * gain * lim->scale, lim->out_limit);
+        }
+        lim->delay_pos = rd;
+        lim->gain = gain;
+    }
+}
+
+static void limiter_clear(limiter_t *lim)
+{
+    memset(lim->tp_hist, 0, lim->channel * 2 * LIMITER_TP_TAPS * sizeof(float));
+    memset(lim->delay, 0, lim->channel * (lim->latency + 1) * sizeof(float));
+    for (uint32_t i = 0; i < lim->window; i++) {
+        lim->box[i] = LIMITER_GAIN_ONE;
+    }
+    lim->box_sum = (int64_t)LIMITER_GAIN_ONE * lim->window;
+    lim->box_pos = 0;
+    lim->tp_pos = 0;
+    lim->tp_prev = 0.0f;
+    lim->delay_pos = 0;
+    lim->dq_head = 0;
+    lim->dq_num = 0;
+    lim->count = 0;
+    lim->smooth = 1.0f;
+    lim->gain = 1.0f;
+}
+
+static bool limiter_ceiling_valid(float ceiling_db)
+{
+    return ceiling_db >= ESP_AE_LIMITER_MIN_CEILING_DB && ceiling_db <= ESP_AE_LIMITER_MAX_CEILING_DB;
+}
+
+static bool limiter_release_valid(float release_ms)
+{
+    return release_ms >= ESP_AE_LIMITER_MIN_RELEASE_MS && release_ms <= ESP_AE_LIMITER_MAX_RELEASE_MS;
+}
+
+esp_ae_err_t esp_ae_limiter_open(esp_ae_limiter_cfg_t *cfg, esp_ae_limiter_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->sample_rate == 0 || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if ((uint32_t)cfg->detect_mode >= ESP_AE_LIMITER_DETECT_MAX) {
+        ESP_LOGE(TAG, "Invalid detect_mode:%d", cfg->detect_mode);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (!(cfg->lookahead_ms >= ESP_AE_LIMITER_MIN_LOOKAHEAD_MS && cfg->lookahead_ms <= ESP_AE_LIMITER_MAX_LOOKAHEAD_MS)
+        || !limiter_ceiling_valid(cfg->ceiling_db) || !limiter_release_valid(cfg->release_ms)) {
+        ESP_LOGE(TAG, "Invalid lookahead_ms:%.2f ceiling_db:%.2f release_ms:%.2f", cfg->lookahead_ms, cfg->ceiling_db,
+                 cfg->release_ms);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_t *lim = (limiter_t *)calloc(1, sizeof(limiter_t));
+    if (lim == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    uint32_t lookahead = (uint32_t)lrintf(cfg->lookahead_ms * cfg->sample_rate / 1000.0f);
+    lim->channel = cfg->channel;
+    lim->bytes = cfg->bits_per_sample >> 3;
+    lim->mode = cfg->detect_mode;
+    lim->sample_rate = cfg->sample_rate;
+    lim->window = (lookahead > 0 ? lookahead : 1) + 1;
+    lim->latency = lim->window - 1 + (lim->mode == ESP_AE_LIMITER_DETECT_TRUE_PEAK ? ESP_AE_LIMITER_TRUE_PEAK_DELAY : 0);
+    lim->scale = (float)(1u << (cfg->bits_per_sample - 1));
+    lim->box_scale = 1.0f / ((float)LIMITER_GAIN_ONE * lim->window);
+    limiter_set_ceiling(lim, cfg->ceiling_db);
+    lim->release_coef = 1.0f - expf(-1000.0f / (cfg->release_ms * cfg->sample_rate));
+    limiter_init_true_peak(lim);
+    lim->tp_hist = (float *)malloc(cfg->channel * 2 * LIMITER_TP_TAPS * sizeof(float));
+    lim->delay = (float *)malloc(cfg->channel * (lim->latency + 1) * sizeof(float));
+    lim->dq_val = (float *)malloc(lim->window * sizeof(float));
+    lim->dq_idx = (uint32_t *)malloc(lim->window * sizeof(uint32_t));
+    lim->box = (int32_t *)malloc(lim->window * sizeof(int32_t));
+    if (lim->tp_hist == NULL || lim->delay == NULL || lim->dq_val == NULL || lim->dq_idx == NULL || lim->box == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer, lookahead %d", (int)lookahead);
+        esp_ae_limiter_close(lim);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    limiter_clear(lim);
+    *handle = lim;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_get_latency(esp_ae_limiter_handle_t handle, uint32_t *latency)
+{
+    if (handle == NULL || latency == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p latency:%p", handle, latency);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *latency = ((limiter_t *)handle)->latency;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_process(esp_ae_limiter_handle_t handle, uint32_t sample_num, esp_ae_sample_t in_samples,
+                                    esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_t *lim = (limiter_t *)handle;
+    uint8_t *in[lim->channel];
+    uint8_t *out[lim->channel];
+    for (int c = 0; c < lim->channel; c++) {
+        in[c] = (uint8_t *)in_samples + c * lim->bytes;
+        out[c] = (uint8_t *)out_samples + c * lim->bytes;
+    }
+    limiter_run(lim, sample_num, in, lim->channel, out, lim->channel);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_deintlv_process(esp_ae_limiter_handle_t handle, uint32_t sample_num,
+                                            esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[])
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_t *lim = (limiter_t *)handle;
+    for (int c = 0; c < lim->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    limiter_run(lim, sample_num, (uint8_t **)in_samples, 1, (uint8_t **)out_samples, 1);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_set_ceiling(esp_ae_limiter_handle_t handle, float ceiling_db)
+{
+    if (handle == NULL || !limiter_ceiling_valid(ceiling_db)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p ceiling_db:%.2f", handle, ceiling_db);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_set_ceiling((limiter_t *)handle, ceiling_db);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_set_release(esp_ae_limiter_handle_t handle, float release_ms)
+{
+    if (handle == NULL || !limiter_release_valid(release_ms)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p release_ms:%.2f", handle, release_ms);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_t *lim = (limiter_t *)handle;
+    lim->release_coef = 1.0f - expf(-1000.0f / (release_ms * lim->sample_rate));
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_get_gain_reduction(esp_ae_limiter_handle_t handle, float *gain_db)
+{
+    if (handle == NULL || gain_db == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p gain_db:%p", handle, gain_db);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    float gain = ((limiter_t *)handle)->gain;
+    *gain_db = gain >= 1.0f ? 0.0f : 20.0f * log10f(gain);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_limiter_reset(esp_ae_limiter_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    limiter_clear((limiter_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_limiter_close(esp_ae_limiter_handle_t handle)
+{
+    limiter_t *lim = (limiter_t *)handle;
+    if (lim == NULL) {
+        return;
+    }
+    if (lim->tp_hist) {
+        free(lim->tp_hist);
+    }
+    if (lim->delay) {
+        free(lim->delay);
+    }
+    if (lim->dq_val) {
+        free(lim->dq_val);
+    }
+    if (lim->dq_idx) {
+        free(lim->dq_idx);
+    }
+    if (lim->box) {
+        free(lim->box);
+    }
+    free(lim);
+}
@@ -0,0 +1,544 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_loudness.h"
+
+#define TAG "AE_LOUDNESS"
+
+#define LOUDNESS_MIN_SAMPLE_RATE (8000)
+#define LOUDNESS_MAX_SAMPLE_RATE (192000)
+#define LOUDNESS_SUB_MS          (100)
+#define LOUDNESS_MOMENTARY_SUB   (4)   /*!< 400 ms */
+#define LOUDNESS_SHORT_TERM_SUB  (30)  /*!< 3 s */
+#define LOUDNESS_OFFSET          (-0.691f)
+#define LOUDNESS_HIST_MAX        (5.0f)
+#define LOUDNESS_HIST_RES        (10)  /*!< Bins per LU */
+#define LOUDNESS_HIST_NUM        ((int)((LOUDNESS_HIST_MAX - ESP_AE_LOUDNESS_SILENCE_LUFS) * LOUDNESS_HIST_RES))
+#define LOUDNESS_INTEGRATED_GATE (-10.0f)
+#define LOUDNESS_RANGE_GATE      (-20.0f)
+#define LOUDNESS_RANGE_LOW       (0.10f)
+#define LOUDNESS_RANGE_HIGH      (0.95f)
+#define LOUDNESS_NORM_GATE       (-20.0f)  /*!< Pause detection relative to the program average */
+#define LOUDNESS_SURROUND_WEIGHT (1.41f)   /*!< BS.1770 weight of channels at 60 to 120 degree azimuth */
+
+typedef struct {
+    float  b0;
+    float  b1;
+    float  b2;
+    float  a1;
+    float  a2;
+} loudness_biquad_t;
+
+typedef struct {
+    uint8_t                 channel;
+    uint8_t                 bytes;
+    esp_ae_loudness_mode_t  mode;
+    uint32_t                sample_rate;
+    float                   scale;          /*!< Full scale of the integer format */
+    float                   max_pos;
+    loudness_biquad_t       shelf;          /*!< K-weighting stage 1, head related high shelf */
+    loudness_biquad_t       hpf;            /*!< K-weighting stage 2, RLB high pass */
+    float                  *state;          /*!< channel x 4, transposed direct form II states of both stages */
+    float                  *weight;         /*!< Per channel BS.1770 weight, shares allocation with state */
+    uint32_t                sub_len;
+    uint32_t                sub_pos;
+    float                   sub_sum;        /*!< Sum of K-weighted squares of all channels in current sub-block */
+    float                   sub_energy[LOUDNESS_SHORT_TERM_SUB];
+    bool                    sub_active[LOUDNESS_SHORT_TERM_SUB];  /*!< Sub-block passes the normalizer pause gate */
+    uint32_t                sub_idx;
+    uint32_t                sub_count;      /*!< Completed sub-blocks, saturated at LOUDNESS_SHORT_TERM_SUB */
+    float                   momentary;
+    float                   short_term;
+    uint32_t               *hist_m;         /*!< Histogram of 400 ms block loudness above the absolute gate */
+    double                 *hist_m_sum;     /*!< Energy sum of the 400 ms blocks in each bin */
+    uint32_t               *hist_s;         /*!< Histogram of 3 s block loudness above the absolute gate */
+    double                  gate_sum;       /*!< Energy sum of 400 ms blocks above the absolute gate */
+    uint32_t                gate_num;
+    float                   target;
+    float                   max_gain;
+    float                   response_coef;
+    float                   gain_db;        /*!< Smoothed normalizer gain at the end of current sub-block */
+    float                   gain;           /*!< Linear gain of the last output sampling point */
+    float                   gain_step;
+} loudness_t;
+
+/**
+ * K-weighting filter coefficients for any sample rate, derived from the 48 kHz filters of BS.1770
+ */
+static void loudness_init_filter(loudness_t *ld)
+{
+    double k = tan(M_PI * 1681.974450955533 / ld->sample_rate);
+    double q = 0.7071752369554196;
+    double vh = pow(10.0, 3.999843853973347 / 20.0);
+    double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    ld->shelf.b0 = (float)((vh + vb * k / q + k * k) / a0);
+    ld->shelf.b1 = (float)(2.0 * (k * k - vh) / a0);
+    ld->shelf.b2 = (float)((vh - vb * k / q + k * k) / a0);
+    ld->shelf.a1 = (float)(2.0 * (k * k - 1.0) / a0);
+    ld->shelf.a2 = (float)((1.0 - k / q + k * k) / a0);
+    k = tan(M_PI * 38.13547087602444 / ld->sample_rate);
+    q = 0.5003270373238773;
+    a0 = 1.0 + k / q + k * k;
+    ld->hpf.b0 = 1.0f;
+    ld->hpf.b1 = -2.0f;
+    ld->hpf.b2 = 1.0f;
+    ld->hpf.a1 = (float)(2.0 * (k * k - 1.0) / a0);
+    ld->hpf.a2 = (float)((1.0 - k / q + k * k) / a0);
+}
+
+static inline float loudness_biquad(const loudness_biquad_t *bq, float *s, float x)
+{
+    float y = bq->b0 * x + s[0];
+    s[0] = bq->b1 * x - bq->a1 * y + s[1];
+    s[1] = bq->b2 * x - bq->a2 * y;
+    return y;
+}
+
+static inline float loudness_lufs(float energy)
+{
+    if (energy <= 0.0f) {
+        return ESP_AE_LOUDNESS_SILENCE_LUFS - 1.0f;
+    }
+    return LOUDNESS_OFFSET + 10.0f * log10f(energy);
+}
+
+static inline float loudness_report(float lufs)
+{
+    return lufs < ESP_AE_LOUDNESS_SILENCE_LUFS ? ESP_AE_LOUDNESS_SILENCE_LUFS : lufs;
+}
+
+static inline int loudness_bin(float lufs)
+{
+    int bin = (int)((lufs - ESP_AE_LOUDNESS_SILENCE_LUFS) * LOUDNESS_HIST_RES);
+    return bin >= LOUDNESS_HIST_NUM ? LOUDNESS_HIST_NUM - 1 : bin;
+}
+
+static inline float loudness_bin_lufs(int bin)
+{
+    return ESP_AE_LOUDNESS_SILENCE_LUFS + (bin + 0.5f) / LOUDNESS_HIST_RES;
+}
+
+static inline float loudness_bin_energy(int bin)
+{
+    return powf(10.0f, (loudness_bin_lufs(bin) - LOUDNESS_OFFSET) / 10.0f);
+}
+
+/**
+ * First bin whose center is at or above the gate
+ */
+static inline int loudness_gate_bin(float gate)
+{
+    int start = (int)ceilf((gate - ESP_AE_LOUDNESS_SILENCE_LUFS) * LOUDNESS_HIST_RES - 0.5f);
+    return start < 0 ? 0 : start;
+}
+
+static float loudness_integrated(loudness_t *ld)
+{
+    if (ld->gate_num == 0) {
+        return ESP_AE_LOUDNESS_SILENCE_LUFS;
+    }
+    int start = loudness_gate_bin(loudness_lufs((float)(ld->gate_sum / ld->gate_num)) + LOUDNESS_INTEGRATED_GATE);
+    // Bins keep the exact block energy, only the gate is quantized to the bin width
+    double sum = 0.0;
+    uint32_t num = 0;
+    for (int i = start; i < LOUDNESS_HIST_NUM; i++) {
+        sum += ld->hist_m_sum[i];
+        num += ld->hist_m[i];
+    }
+    return num ? loudness_report(loudness_lufs((float)(sum / num))) : ESP_AE_LOUDNESS_SILENCE_LUFS;
+}
+
+static float loudness_range(loudness_t *ld)
+{
+    double sum = 0.0;
+    uint32_t num = 0;
+    for (int i = 0; i < LOUDNESS_HIST_NUM; i++) {
+        if (ld->hist_s[i]) {
+            sum += (double)ld->hist_s[i] * loudness_bin_energy(i);
+            num += ld->hist_s[i];
+        }
+    }
+    if (num == 0) {
+        return 0.0f;
+    }
+    int start = loudness_gate_bin(loudness_lufs((float)(sum / num)) + LOUDNESS_RANGE_GATE);
+    num = 0;
+    for (int i = start; i < LOUDNESS_HIST_NUM; i++) {
+        num += ld->hist_s[i];
+    }
+    if (num == 0) {
+        return 0.0f;
+    }
+    // Nearest rank percentiles
+    uint32_t rank_low = (uint32_t)(LOUDNESS_RANGE_LOW * (num - 1));
+    uint32_t rank_high = (uint32_t)(LOUDNESS_RANGE_HIGH * (num - 1));
+    int bin_low = -1;
+    int bin_high = -1;
+    uint32_t cum = 0;
+    for (int i = start; i < LOUDNESS_HIST_NUM && bin_high < 0; i++) {
+        cum += ld->hist_s[i];
+        if (bin_low < 0 && cum > rank_low) {
+            bin_low = i;
+        }
+        if (cum > rank_high) {
+            bin_high = i;
+        }
+    }
+    return (float)(bin_high - bin_low) / LOUDNESS_HIST_RES;
+}
+
+static float loudness_window(loudness_t *ld, uint32_t sub_num)
+{
+    uint32_t num = ld->sub_count < sub_num ? ld->sub_count : sub_num;
+    uint32_t idx = ld->sub_idx;
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < num; i++) {
+        idx = idx == 0 ? LOUDNESS_SHORT_TERM_SUB - 1 : idx - 1;
+        sum += ld->sub_energy[idx];
+    }
+    return sum / num;
+}
+
+/**
+ * Move the gain toward the target using the short-term loudness of active sub-blocks only,
+ * so that pauses neither raise the gain nor drag the following program loudness down
+ */
+static void loudness_update_gain(loudness_t *ld, uint32_t last)
+{
+    if (ld->sub_active[last]) {
+        float sum = 0.0f;
+        uint32_t num = 0;
+        for (uint32_t i = 0; i < ld->sub_count; i++) {
+            if (ld->sub_active[i]) {
+                sum += ld->sub_energy[i];
+                num++;
+            }
+        }
+        float want = ld->target - loudness_lufs(sum / num);
+        want = want > ld->max_gain ? ld->max_gain : want < -ld->max_gain ? -ld->max_gain : want;
+        ld->gain_db += ld->response_coef * (want - ld->gain_db);
+    }
+    ld->gain_step = (powf(10.0f, ld->gain_db / 20.0f) - ld->gain) / ld->sub_len;
+}
+
+static void loudness_sub_block_end(loudness_t *ld)
+{
+    uint32_t last = ld->sub_idx;
+    ld->sub_energy[last] = ld->sub_sum / ld->sub_len;
+    ld->sub_idx = ld->sub_idx + 1 == LOUDNESS_SHORT_TERM_SUB ? 0 : ld->sub_idx + 1;
+    if (ld->sub_count < LOUDNESS_SHORT_TERM_SUB) {
+        ld->sub_count++;
+    }
+    ld->sub_sum = 0.0f;
+    ld->sub_pos = 0;
+    float energy_m = loudness_window(ld, LOUDNESS_MOMENTARY_SUB);
+    float momentary = loudness_lufs(energy_m);
+    float short_term = loudness_lufs(loudness_window(ld, LOUDNESS_SHORT_TERM_SUB));
+    ld->momentary = loudness_report(momentary);
+    ld->short_term = loudness_report(short_term);
+    bool active = momentary >= ESP_AE_LOUDNESS_SILENCE_LUFS;
+    if (active && ld->gate_num) {
+        active = momentary >= loudness_lufs((float)(ld->gate_sum / ld->gate_num)) + LOUDNESS_NORM_GATE;
+    }
+    ld->sub_active[last] = active;
+    // Gating blocks need a full window
+    if (ld->sub_count >= LOUDNESS_MOMENTARY_SUB && momentary >= ESP_AE_LOUDNESS_SILENCE_LUFS) {
+        int bin = loudness_bin(momentary);
+        ld->hist_m[bin]++;
+        ld->hist_m_sum[bin] += energy_m;
+        ld->gate_sum += energy_m;
+        ld->gate_num++;
+    }
+    if (ld->sub_count >= LOUDNESS_SHORT_TERM_SUB && short_term >= ESP_AE_LOUDNESS_SILENCE_LUFS) {
+        ld->hist_s[loudness_bin(short_term)]++;
+    }
+    if (ld->mode == ESP_AE_LOUDNESS_MODE_NORMALIZE) {
+        // Land exactly on the previous target to avoid ramp drift
+        ld->gain = powf(10.0f, ld->gain_db / 20.0f);
+        loudness_update_gain(ld, last);
+    }
+}
+
+static inline float loudness_read(const uint8_t *in, uint8_t bytes)
+{
+    switch (bytes) {
+        case 2:
+            return *(const int16_t *)in;
+        case 3:
+            return (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24)) >> 8;
+        default:
+            return (float)*(const int32_t *)in;
+    }
+}
+
+static inline void loudness_write(uint8_t *out, uint8_t bytes, float v, float max_pos, float min_neg)
+{
+    v = v > max_pos ? max_pos : v < min_neg ? min_neg : v;
+    int32_t s = (int32_t)lrintf(v);
+    switch (bytes) {
+        case 2:
+            *(int16_t *)out = (int16_t)s;
+            break;
+        case 3:
+            out[0] = (uint8_t)s;
+            out[1] = (uint8_t)(s >> 8);
+            out[2] = (uint8_t)(s >> 16);
+            break;
+        default:
+            *(int32_t *)out = s;
+            break;
+    }
+}
+
+static void loudness_run(loudness_t *ld, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                         uint32_t out_stride)
+{
+    bool normalize = ld->mode == ESP_AE_LOUDNESS_MODE_NORMALIZE;
+    float inv_scale = 1.0f / ld->scale;
+    float min_neg = -ld->scale;
+    for (uint32_t i = 0; i < sample_num; i++) {
+        float gain = ld->gain + ld->gain_step;
+        for (int c = 0; c < ld->channel; c++) {
+            float x = loudness_read(in[c] + i * in_stride * ld->bytes, ld->bytes);
+            float *s = ld->state + c * 4;
+            float y = loudness_biquad(&ld->shelf, s, x * inv_scale);
+            y = loudness_biquad(&ld->hpf, s + 2, y);
+            ld->sub_sum += ld->weight[c] * y * y;
+            if (normalize) {
+                loudness_write(out[c] + i * out_stride * ld->bytes, ld->bytes, x * gain, ld->max_pos, min_neg);
+            }
+        }
+        ld->gain = gain;
+        if (++ld->sub_pos == ld->sub_len) {
+            loudness_sub_block_end(ld);
+        }
+    }
+}
+
+/**
+ * Surround layouts in WAVE channel order: 5.0 is L, R, C, Ls, Rs, 5.1 is L, R, C, LFE, Ls, Rs and
+ * 7.1 is L, R, C, LFE, Lb, Rb, Ls, Rs. LFE is not measured, side channels get +1.5 dB and back channels
+ * beyond 120 degree stay at 1.0. Other channel numbers weight every channel 1.0
+ */
+static void loudness_init_weight(loudness_t *ld)
+{
+    for (int c = 0; c < ld->channel; c++) {
+        ld->weight[c] = 1.0f;
+    }
+    switch (ld->channel) {
+        case 5:
+            ld->weight[3] = LOUDNESS_SURROUND_WEIGHT;
+            ld->weight[4] = LOUDNESS_SURROUND_WEIGHT;
+            break;
+        case 6:
+            ld->weight[3] = 0.0f;
+            ld->weight[4] = LOUDNESS_SURROUND_WEIGHT;
+            ld->weight[5] = LOUDNESS_SURROUND_WEIGHT;
+            break;
+        case 8:
+            ld->weight[3] = 0.0f;
+            ld->weight[6] = LOUDNESS_SURROUND_WEIGHT;
+            ld->weight[7] = LOUDNESS_SURROUND_WEIGHT;
+            break;
+        default:
+            break;
+    }
+}
+
+static void loudness_clear(loudness_t *ld)
+{
+    memset(ld->state, 0, ld->channel * 4 * sizeof(float));
+    memset(ld->hist_m, 0, 2 * LOUDNESS_HIST_NUM * sizeof(uint32_t));
+    memset(ld->hist_m_sum, 0, LOUDNESS_HIST_NUM * sizeof(double));
+    memset(ld->sub_energy, 0, sizeof(ld->sub_energy));
+    memset(ld->sub_active, 0, sizeof(ld->sub_active));
+    ld->sub_pos = 0;
+    ld->sub_sum = 0.0f;
+    ld->sub_idx = 0;
+    ld->sub_count = 0;
+    ld->momentary = ESP_AE_LOUDNESS_SILENCE_LUFS;
+    ld->short_term = ESP_AE_LOUDNESS_SILENCE_LUFS;
+    ld->gate_sum = 0.0;
+    ld->gate_num = 0;
+    ld->gain_db = 0.0f;
+    ld->gain = 1.0f;
+    ld->gain_step = 0.0f;
+}
+
+static bool loudness_target_valid(float target_lufs)
+{
+    return target_lufs >= ESP_AE_LOUDNESS_MIN_TARGET_LUFS && target_lufs <= ESP_AE_LOUDNESS_MAX_TARGET_LUFS;
+}
+
+esp_ae_err_t esp_ae_loudness_open(esp_ae_loudness_cfg_t *cfg, esp_ae_loudness_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->sample_rate < LOUDNESS_MIN_SAMPLE_RATE || cfg->sample_rate > LOUDNESS_MAX_SAMPLE_RATE
+        || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if ((uint32_t)cfg->mode >= ESP_AE_LOUDNESS_MODE_MAX) {
+        ESP_LOGE(TAG, "Invalid mode:%d", cfg->mode);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->mode == ESP_AE_LOUDNESS_MODE_NORMALIZE
+        && (!loudness_target_valid(cfg->target_lufs)
+            || !(cfg->max_gain_db >= ESP_AE_LOUDNESS_MIN_MAX_GAIN_DB && cfg->max_gain_db <= ESP_AE_LOUDNESS_MAX_MAX_GAIN_DB)
+            || !(cfg->response_ms >= ESP_AE_LOUDNESS_MIN_RESPONSE_MS && cfg->response_ms <= ESP_AE_LOUDNESS_MAX_RESPONSE_MS))) {
+        ESP_LOGE(TAG, "Invalid target_lufs:%.2f max_gain_db:%.2f response_ms:%.2f", cfg->target_lufs, cfg->max_gain_db,
+                 cfg->response_ms);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    loudness_t *ld = (loudness_t *)calloc(1, sizeof(loudness_t));
+    if (ld == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    ld->channel = cfg->channel;
+    ld->bytes = cfg->bits_per_sample >> 3;
+    ld->mode = cfg->mode;
+    ld->sample_rate = cfg->sample_rate;
+    ld->scale = (float)(1u << (cfg->bits_per_sample - 1));
+    ld->max_pos = ld->bytes == 2 ? 32767.0f : ld->bytes == 3 ? 8388607.0f : 2147483520.0f;
+    ld->sub_len = (cfg->sample_rate * LOUDNESS_SUB_MS + 500) / 1000;
+    ld->target = cfg->target_lufs;
+    ld->max_gain = cfg->max_gain_db;
+    if (cfg->mode == ESP_AE_LOUDNESS_MODE_NORMALIZE) {
+        ld->response_coef = 1.0f - expf(-LOUDNESS_SUB_MS / cfg->response_ms);
+    }
+    loudness_init_filter(ld);
+    ld->state = (float *)malloc(cfg->channel * 5 * sizeof(float));
+    // Both histograms share one allocation
+    ld->hist_m = (uint32_t *)malloc(2 * LOUDNESS_HIST_NUM * sizeof(uint32_t));
+    ld->hist_m_sum = (double *)malloc(LOUDNESS_HIST_NUM * sizeof(double));
+    if (ld->state == NULL || ld->hist_m == NULL || ld->hist_m_sum == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer");
+        esp_ae_loudness_close(ld);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    ld->hist_s = ld->hist_m + LOUDNESS_HIST_NUM;
+    ld->weight = ld->state + cfg->channel * 4;
+    loudness_init_weight(ld);
+    loudness_clear(ld);
+    *handle = ld;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_loudness_process(esp_ae_loudness_handle_t handle, uint32_t sample_num,
+                                     esp_ae_sample_t in_samples, esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    loudness_t *ld = (loudness_t *)handle;
+    uint8_t *in[ld->channel];
+    uint8_t *out[ld->channel];
+    for (int c = 0; c < ld->channel; c++) {
+        in[c] = (uint8_t *)in_samples + c * ld->bytes;
+        out[c] = (uint8_t *)out_samples + c * ld->bytes;
+    }
+    loudness_run(ld, sample_num, in, ld->channel, out, ld->channel);
+    if (ld->mode == ESP_AE_LOUDNESS_MODE_METER && in_samples != out_samples) {
+        memcpy(out_samples, in_samples, sample_num * ld->channel * ld->bytes);
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_loudness_deintlv_process(esp_ae_loudness_handle_t handle, uint32_t sample_num,
+                                             esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[])
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    loudness_t *ld = (loudness_t *)handle;
+    for (int c = 0; c < ld->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    loudness_run(ld, sample_num, (uint8_t **)in_samples, 1, (uint8_t **)out_samples, 1);
+    if (ld->mode == ESP_AE_LOUDNESS_MODE_METER) {
+        for (int c = 0; c < ld->channel; c++) {
+            if (in_samples[c] != out_samples[c]) {
+                memcpy(out_samples[c], in_samples[c], sample_num * ld->bytes);
+            }
+        }
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_loudness_get_info(esp_ae_loudness_handle_t handle, esp_ae_loudness_info_t *info)
+{
+    if (handle == NULL || info == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p info:%p", handle, info);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    loudness_t *ld = (loudness_t *)handle;
+    info->momentary = ld->momentary;
+    info->short_term = ld->short_term;
+    info->integrated = loudness_integrated(ld);
+    info->range = loudness_range(ld);
+    info->gain_db = ld->mode == ESP_AE_LOUDNESS_MODE_NORMALIZE ? 20.0f * log10f(ld->gain) : 0.0f;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_loudness_set_target(esp_ae_loudness_handle_t handle, float target_lufs)
+{
+    if (handle == NULL || !loudness_target_valid(target_lufs)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p target_lufs:%.2f", handle, target_lufs);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ((loudness_t *)handle)->target = target_lufs;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_loudness_reset(esp_ae_loudness_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    loudness_clear((loudness_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_loudness_close(esp_ae_loudness_handle_t handle)
+{
+    loudness_t *ld = (loudness_t *)handle;
+    if (ld == NULL) {
+        return;
+    }
+    if (ld->state) {
+        free(ld->state);
+    }
+    if (ld->hist_m) {
+        free(ld->hist_m);
+    }
+    if (ld->hist_m_sum) {
+        free(ld->hist_m_sum);
+    }
+    free(ld);
+}
@@ -0,0 +1,761 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_mbc_n.h"
+#include "ae_fft.h"
+
+#define TAG "AE_MBC_N"
+
+#define MBC_N_MIN_SAMPLE_RATE (8000)
+#define MBC_N_MAX_SAMPLE_RATE (192000)
+#define MBC_N_MAX_FC_NUM      (ESP_AE_MBC_N_MAX_BAND_NUM - 1)
+#define MBC_N_XOVER_STATE     (8)        /*!< Floats per crossover and channel: low pass x2, allpass, compensation */
+#define MBC_N_PEAK_FLOOR      (1e-10f)   /*!< -200 dBFS, keeps the log finite on silence */
+
+typedef struct {
+    float  b0;
+    float  b1;
+    float  b2;
+    float  a1;
+    float  a2;
+} mbc_n_biquad_t;
+
+typedef struct {
+    esp_ae_mbc_para_t  para;
+    float              attack_coef;
+    float              release_coef;
+    uint32_t           hold;          /*!< Hold time in control periods */
+    uint32_t           hold_cnt;
+    float              gr_db;         /*!< Smoothed gain reduction */
+    float              peak;          /*!< Band peak of current control period over all channels */
+    float              gain;          /*!< Linear gain of the last processed sampling point */
+    float              gain_step;
+    float              target;        /*!< Linear gain at the end of current control period */
+    bool               solo;
+    bool               bypass;
+} mbc_n_band_t;
+
+/**
+ * Band signals are stored as channel x band_num x band_len floats
+ */
+typedef struct {
+    uint8_t                   channel;
+    uint8_t                   bytes;
+    uint8_t                   band_num;
+    esp_ae_mbc_n_crossover_t  crossover;
+    uint32_t                  sample_rate;
+    float                     scale;         /*!< Full scale of the integer format */
+    float                     max_pos;
+    uint32_t                  fc[MBC_N_MAX_FC_NUM];
+    mbc_n_band_t              band[ESP_AE_MBC_N_MAX_BAND_NUM];
+    uint32_t                  ctrl_pos;      /*!< Sampling points of current control period processed */
+    uint32_t                  band_len;
+    float                    *band_buf;
+    mbc_n_biquad_t            lp[MBC_N_MAX_FC_NUM];
+    mbc_n_biquad_t            ap[MBC_N_MAX_FC_NUM];
+    float                    *state;         /*!< IIR: channel x (band_num - 1) x MBC_N_XOVER_STATE */
+    uint32_t                  block;         /*!< Linear phase: block and filter length */
+    ae_fft_t                  fft;
+    float                    *band_spec;     /*!< band_num filter spectra, scaled for the inverse transform */
+    float                    *time;          /*!< channel x (previous block, current block) input */
+    float                    *out_blk;       /*!< channel x block output ready for reading */
+    float                    *spec;          /*!< Input spectrum */
+    float                    *acc;           /*!< Filtered spectrum */
+    float                    *work;          /*!< 2 * block time domain scratch */
+    uint32_t                  fill;          /*!< Sampling points of current block received */
+} mbc_n_t;
+
+/**
+ * Butterworth low pass and allpass of the same corner, two low pass sections make the Linkwitz-Riley low pass
+ * and allpass minus it gives the matching high pass
+ */
+static void mbc_n_design_iir(mbc_n_t *m, int idx)
+{
+    double k = tan(M_PI * m->fc[idx] / m->sample_rate);
+    double q = M_SQRT1_2;
+    double a0 = 1.0 + k / q + k * k;
+    float a1 = (float)(2.0 * (k * k - 1.0) / a0);
+    float a2 = (float)((1.0 - k / q + k * k) / a0);
+    mbc_n_biquad_t *lp = &m->lp[idx];
+    lp->b0 = (float)(k * k / a0);
+    lp->b1 = 2.0f * lp->b0;
+    lp->b2 = lp->b0;
+    lp->a1 = a1;
+    lp->a2 = a2;
+    mbc_n_biquad_t *ap = &m->ap[idx];
+    ap->b0 = a2;
+    ap->b1 = a1;
+    ap->b2 = 1.0f;
+    ap->a1 = a1;
+    ap->a2 = a2;
+}
+
+/**
+ * Linear phase band filters: windowed sinc low pass of every crossover, band k is the difference of the low
+ * passes around it, so all bands sum to a pure delay of `block / 2`
+ */
+static void mbc_n_design_fir(mbc_n_t *m)
+{
+    uint32_t n = m->block;
+    uint32_t taps = n + 1;
+    uint32_t bins = 2 * (n + 1);
+    float scale = 1.0f / (2 * n);
+    float *lp_prev = m->acc;
+    float *lp = m->spec;
+    for (uint32_t i = 0; i < bins; i++) {
+        lp_prev[i] = 0.0f;
+    }
+    for (int b = 0; b < m->band_num; b++) {
+        // The highest band uses the delay as its upper low pass
+        memset(m->work, 0, 2 * n * sizeof(float));
+        if (b == m->band_num - 1) {
+            m->work[n / 2] = 1.0f;
+        } else {
+            double wc = 2.0 * m->fc[b] / m->sample_rate;
+            double sum = 0.0;
+            for (uint32_t i = 0; i < taps; i++) {
+                double t = (double)i - n / 2.0;
+                double sinc = t == 0.0 ? wc : sin(M_PI * wc * t) / (M_PI * t);
+                double win = 0.42 - 0.5 * cos(2.0 * M_PI * i / n) + 0.08 * cos(4.0 * M_PI * i / n);
+                m->work[i] = (float)(sinc * win);
+                sum += m->work[i];
+            }
+            // Unity gain at DC keeps the bands complementary
+            for (uint32_t i = 0; i < taps; i++) {
+                m->work[i] = (float)(m->work[i] / sum);
+            }
+        }
+        for (uint32_t i = 0; i < 2 * n; i++) {
+            m->work[i] *= scale;
+        }
+        ae_fft_real(&m->fft, m->work, lp);
+        float *spec = m->band_spec + b * bins;
+        for (uint32_t i = 0; i < bins; i++) {
+            spec[i] = lp[i] - lp_prev[i];
+            lp_prev[i] = lp[i];
+        }
+    }
+}
+
+static void mbc_n_set_band_para(mbc_n_t *m, mbc_n_band_t *band, esp_ae_mbc_para_t *para)
+{
+    float period = (float)ESP_AE_MBC_N_CONTROL_PERIOD / m->sample_rate * 1000.0f;
+    band->para = *para;
+    band->attack_coef = para->attack_time ? 1.0f - expf(-period / para->attack_time) : 1.0f;
+    band->release_coef = para->release_time ? 1.0f - expf(-period / para->release_time) : 1.0f;
+    band->hold = (uint32_t)(para->hold_time / period);
+}
+
+static bool mbc_n_para_valid(esp_ae_mbc_para_t *para)
+{
+    return para->threshold > -100.0f && para->threshold <= 0.0f && para->ratio >= 1.0f
+           && para->makeup_gain >= -10.0f && para->makeup_gain <= 10.0f && para->attack_time <= 500
+           && para->release_time <= 500 && para->hold_time <= 100 && para->knee_width >= 0.0f
+           && para->knee_width <= 10.0f;
+}
+
+static bool mbc_n_fc_valid(uint32_t sample_rate, const uint32_t *fc, int fc_num)
+{
+    for (int i = 0; i < fc_num; i++) {
+        if (fc[i] < ESP_AE_MBC_N_MIN_FC || fc[i] >= sample_rate / 2 || (i > 0 && fc[i] <= fc[i - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Static curve with optional soft knee, returns the gain reduction in dB
+ */
+static inline float mbc_n_curve(const esp_ae_mbc_para_t *para, float level)
+{
+    float over = level - para->threshold;
+    float slope = 1.0f / para->ratio - 1.0f;
+    float knee = para->knee_width;
+    if (2.0f * over <= -knee) {
+        return 0.0f;
+    }
+    if (2.0f * fabsf(over) < knee) {
+        float x = over + knee / 2.0f;
+        return slope * x * x / (2.0f * knee);
+    }
+    return slope * over;
+}
+
+/**
+ * End of a control period: update the gain reduction from the band peak and ramp toward the new gain
+ */
+static void mbc_n_update_gain(mbc_n_t *m)
+{
+    bool any_solo = false;
+    for (int b = 0; b < m->band_num; b++) {
+        any_solo |= m->band[b].solo;
+    }
+    for (int b = 0; b < m->band_num; b++) {
+        mbc_n_band_t *band = &m->band[b];
+        float level = 20.0f * log10f(band->peak > MBC_N_PEAK_FLOOR ? band->peak : MBC_N_PEAK_FLOOR);
+        float gr = mbc_n_curve(&band->para, level);
+        if (gr < band->gr_db) {
+            band->gr_db += band->attack_coef * (gr - band->gr_db);
+            band->hold_cnt = band->hold;
+        } else if (band->hold_cnt > 0) {
+            band->hold_cnt--;
+        } else {
+            band->gr_db += band->release_coef * (gr - band->gr_db);
+        }
+        float target = 1.0f;
+        if (any_solo && !band->solo) {
+            target = 0.0f;
+        } else if (!band->bypass) {
+            target = powf(10.0f, (band->gr_db + band->para.makeup_gain) / 20.0f);
+        }
+        // Land exactly on the previous target to avoid ramp drift
+        band->gain = band->target;
+        band->target = target;
+        band->gain_step = (target - band->gain) / ESP_AE_MBC_N_CONTROL_PERIOD;
+        band->peak = 0.0f;
+    }
+}
+
+/**
+ * Detect and apply band gains in place on `n` sampling points from `off` of the band signals,
+ * `off + n` never crosses a control period
+ */
+static void mbc_n_apply_gain(mbc_n_t *m, uint32_t off, uint32_t n)
+{
+    uint32_t stride = m->band_num * m->band_len;
+    for (int b = 0; b < m->band_num; b++) {
+        mbc_n_band_t *band = &m->band[b];
+        float *x = m->band_buf + b * m->band_len + off;
+        float gain = band->gain;
+        float peak = band->peak;
+        for (uint32_t i = 0; i < n; i++) {
+            gain += band->gain_step;
+            for (int c = 0; c < m->channel; c++) {
+                float v = x[c * stride + i];
+                float a = fabsf(v);
+                peak = a > peak ? a : peak;
+                x[c * stride + i] = v * gain;
+            }
+        }
+        band->gain = gain;
+        band->peak = peak;
+    }
+    m->ctrl_pos += n;
+    if (m->ctrl_pos == ESP_AE_MBC_N_CONTROL_PERIOD) {
+        mbc_n_update_gain(m);
+        m->ctrl_pos = 0;
+    }
+}
+
+static inline float mbc_n_biquad(const mbc_n_biquad_t *bq, float *s, float x)
+{
+    float y = bq->b0 * x + s[0];
+    s[0] = bq->b1 * x - bq->a1 * y + s[1];
+    s[1] = bq->b2 * x - bq->a2 * y;
+    return y;
+}
+
+static inline float mbc_n_read(const uint8_t *in, uint8_t bytes)
+{
+    switch (bytes) {
+        case 2:
+            return *(const int16_t *)in;
+        case 3:
+            return (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24)) >> 8;
+        default:
+            return (float)*(const int32_t *)in;
+    }
+}
+
+static inline void mbc_n_write(uint8_t *out, uint8_t bytes, float v, float max_pos, float min_neg)
+{
+    v = v > max_pos ? max_pos : v < min_neg ? min_neg : v;
+    int32_t s = (int32_t)lrintf(v);
+    switch (bytes) {
+        case 2:
+            *(int16_t *)out = (int16_t)s;
+            break;
+        case 3:
+            out[0] = (uint8_t)s;
+            out[1] = (uint8_t)(s >> 8);
+            out[2] = (uint8_t)(s >> 16);
+            break;
+        default:
+            *(int32_t *)out = s;
+            break;
+    }
+}
+
+/**
+ * IIR tree: split from the lowest crossover upward, then sum from the lowest band upward passing the partial
+ * sum through the allpass of every crossover above the bands already in it
+ */
+static void mbc_n_run_iir(mbc_n_t *m, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                          uint32_t out_stride)
+{
+    int xover_num = m->band_num - 1;
+    uint32_t len = m->band_len;
+    float inv_scale = 1.0f / m->scale;
+    float min_neg = -m->scale;
+    uint32_t done = 0;
+    while (done < sample_num) {
+        uint32_t n = ESP_AE_MBC_N_CONTROL_PERIOD - m->ctrl_pos;
+        if (n > sample_num - done) {
+            n = sample_num - done;
+        }
+        // Read all channels before writing so that inplace processing is safe
+        for (int c = 0; c < m->channel; c++) {
+            float *st = m->state + c * xover_num * MBC_N_XOVER_STATE;
+            float *band = m->band_buf + c * m->band_num * len;
+            const uint8_t *src = in[c] + done * in_stride * m->bytes;
+            for (uint32_t i = 0; i < n; i++) {
+                float x = mbc_n_read(src + i * in_stride * m->bytes, m->bytes) * inv_scale;
+                for (int k = 0; k < xover_num; k++) {
+                    float *s = st + k * MBC_N_XOVER_STATE;
+                    float lo = mbc_n_biquad(&m->lp[k], s, x);
+                    lo = mbc_n_biquad(&m->lp[k], s + 2, lo);
+                    x = mbc_n_biquad(&m->ap[k], s + 4, x) - lo;
+                    band[k * len + i] = lo;
+                }
+                band[xover_num * len + i] = x;
+            }
+        }
+        mbc_n_apply_gain(m, 0, n);
+        for (int c = 0; c < m->channel; c++) {
+            float *st = m->state + c * xover_num * MBC_N_XOVER_STATE;
+            const float *band = m->band_buf + c * m->band_num * len;
+            uint8_t *dst = out[c] + done * out_stride * m->bytes;
+            for (uint32_t i = 0; i < n; i++) {
+                float acc = band[i];
+                for (int k = 1; k < xover_num; k++) {
+                    acc = mbc_n_biquad(&m->ap[k], st + k * MBC_N_XOVER_STATE + 6, acc) + band[k * len + i];
+                }
+                acc += band[xover_num * len + i];
+                mbc_n_write(dst + i * out_stride * m->bytes, m->bytes, acc * m->scale, m->max_pos, min_neg);
+            }
+        }
+        done += n;
+    }
+}
+
+static void mbc_n_fir_block(mbc_n_t *m)
+{
+    uint32_t n = m->block;
+    uint32_t bins = 2 * (n + 1);
+    for (int c = 0; c < m->channel; c++) {
+        float *t = m->time + c * 2 * n;
+        float *band = m->band_buf + c * m->band_num * n;
+        memcpy(m->work, t, 2 * n * sizeof(float));
+        ae_fft_real(&m->fft, m->work, m->spec);
+        for (int b = 0; b < m->band_num; b++) {
+            const float *h = m->band_spec + b * bins;
+            for (uint32_t k = 0; k < bins; k += 2) {
+                m->acc[k] = m->spec[k] * h[k] - m->spec[k + 1] * h[k + 1];
+                m->acc[k + 1] = m->spec[k] * h[k + 1] + m->spec[k + 1] * h[k];
+            }
+            ae_fft_real_inverse(&m->fft, m->acc, m->work);
+            // Overlap-save: the second half is the valid linear convolution of current block
+            memcpy(band + b * n, m->work + n, n * sizeof(float));
+        }
+        memcpy(t, t + n, n * sizeof(float));
+    }
+    // Linear phase bands sum to the delayed input, no phase compensation is needed
+    for (uint32_t off = 0; off < n; off += ESP_AE_MBC_N_CONTROL_PERIOD) {
+        mbc_n_apply_gain(m, off, ESP_AE_MBC_N_CONTROL_PERIOD);
+    }
+    for (int c = 0; c < m->channel; c++) {
+        const float *band = m->band_buf + c * m->band_num * n;
+        float *o = m->out_blk + c * n;
+        memcpy(o, band, n * sizeof(float));
+        for (int b = 1; b < m->band_num; b++) {
+            for (uint32_t i = 0; i < n; i++) {
+                o[i] += band[b * n + i];
+            }
+        }
+    }
+}
+
+static void mbc_n_run_fir(mbc_n_t *m, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                          uint32_t out_stride)
+{
+    uint32_t n = m->block;
+    float inv_scale = 1.0f / m->scale;
+    float min_neg = -m->scale;
+    uint32_t done = 0;
+    while (done < sample_num) {
+        uint32_t cnt = n - m->fill;
+        if (cnt > sample_num - done) {
+            cnt = sample_num - done;
+        }
+        for (int c = 0; c < m->channel; c++) {
+            const uint8_t *src = in[c] + done * in_stride * m->bytes;
+            float *t = m->time + c * 2 * n + n + m->fill;
+            for (uint32_t i = 0; i < cnt; i++) {
+                t[i] = mbc_n_read(src + i * in_stride * m->bytes, m->bytes) * inv_scale;
+            }
+        }
+        for (int c = 0; c < m->channel; c++) {
+            uint8_t *dst = out[c] + done * out_stride * m->bytes;
+            const float *o = m->out_blk + c * n + m->fill;
+            for (uint32_t i = 0; i < cnt; i++) {
+                mbc_n_write(dst + i * out_stride * m->bytes, m->bytes, o[i] * m->scale, m->max_pos, min_neg);
+            }
+        }
+        m->fill += cnt;
+        done += cnt;
+        if (m->fill == n) {
+            mbc_n_fir_block(m);
+            m->fill = 0;
+        }
+    }
+}
+
+static void mbc_n_run(mbc_n_t *m, uint32_t sample_num, uint8_t *in[], uint32_t in_stride, uint8_t *out[],
+                      uint32_t out_stride)
+{
+    if (m->crossover == ESP_AE_MBC_N_CROSSOVER_IIR) {
+        mbc_n_run_iir(m, sample_num, in, in_stride, out, out_stride);
+    } else {
+        mbc_n_run_fir(m, sample_num, in, in_stride, out, out_stride);
+    }
+}
+
+static void mbc_n_clear(mbc_n_t *m)
+{
+    if (m->state) {
+        memset(m->state, 0, m->channel * (m->band_num - 1) * MBC_N_XOVER_STATE * sizeof(float));
+    }
+    if (m->time) {
+        memset(m->time, 0, m->channel * 2 * m->block * sizeof(float));
+        memset(m->out_blk, 0, m->channel * m->block * sizeof(float));
+    }
+    m->fill = 0;
+    m->ctrl_pos = 0;
+    for (int b = 0; b < m->band_num; b++) {
+        mbc_n_band_t *band = &m->band[b];
+        band->hold_cnt = 0;
+        band->gr_db = 0.0f;
+        band->peak = 0.0f;
+        band->gain_step = 0.0f;
+    }
+    // Start from the static gain of silence so that makeup, solo and bypass apply from the first sampling point
+    mbc_n_update_gain(m);
+    for (int b = 0; b < m->band_num; b++) {
+        m->band[b].gain = m->band[b].target;
+        m->band[b].gain_step = 0.0f;
+    }
+}
+
+esp_ae_err_t esp_ae_mbc_n_open(esp_ae_mbc_n_cfg_t *cfg, esp_ae_mbc_n_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->sample_rate < MBC_N_MIN_SAMPLE_RATE || cfg->sample_rate > MBC_N_MAX_SAMPLE_RATE || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->band_num < ESP_AE_MBC_N_MIN_BAND_NUM || cfg->band_num > ESP_AE_MBC_N_MAX_BAND_NUM
+        || (uint32_t)cfg->crossover >= ESP_AE_MBC_N_CROSSOVER_MAX) {
+        ESP_LOGE(TAG, "Invalid band_num:%d crossover:%d", cfg->band_num, cfg->crossover);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t block = cfg->fir_len ? cfg->fir_len : ESP_AE_MBC_N_DEFAULT_FIR_LEN;
+    if (cfg->crossover == ESP_AE_MBC_N_CROSSOVER_LINEAR_PHASE
+        && (block < ESP_AE_MBC_N_MIN_FIR_LEN || block > ESP_AE_MBC_N_MAX_FIR_LEN || (block & (block - 1)))) {
+        ESP_LOGE(TAG, "Invalid fir_len:%d", (int)block);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (!mbc_n_fc_valid(cfg->sample_rate, cfg->fc, cfg->band_num - 1)) {
+        ESP_LOGE(TAG, "Invalid crossover frequencies, need ascending in [%d, %d)", ESP_AE_MBC_N_MIN_FC,
+                 (int)cfg->sample_rate / 2);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    for (int b = 0; b < cfg->band_num; b++) {
+        if (!mbc_n_para_valid(&cfg->mbc_para[b])) {
+            ESP_LOGE(TAG, "Invalid compressor parameter of band %d", b);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    mbc_n_t *m = (mbc_n_t *)calloc(1, sizeof(mbc_n_t));
+    if (m == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    m->channel = cfg->channel;
+    m->bytes = cfg->bits_per_sample >> 3;
+    m->band_num = cfg->band_num;
+    m->crossover = cfg->crossover;
+    m->sample_rate = cfg->sample_rate;
+    m->scale = (float)(1u << (cfg->bits_per_sample - 1));
+    m->max_pos = m->bytes == 2 ? 32767.0f : m->bytes == 3 ? 8388607.0f : 2147483520.0f;
+    memcpy(m->fc, cfg->fc, (cfg->band_num - 1) * sizeof(uint32_t));
+    for (int b = 0; b < cfg->band_num; b++) {
+        mbc_n_set_band_para(m, &m->band[b], &cfg->mbc_para[b]);
+        m->band[b].target = 1.0f;
+    }
+    esp_ae_err_t ret = ESP_AE_ERR_MEM_LACK;
+    if (cfg->crossover == ESP_AE_MBC_N_CROSSOVER_IIR) {
+        m->band_len = ESP_AE_MBC_N_CONTROL_PERIOD;
+        for (int k = 0; k < cfg->band_num - 1; k++) {
+            mbc_n_design_iir(m, k);
+        }
+        m->state = (float *)malloc(cfg->channel * (cfg->band_num - 1) * MBC_N_XOVER_STATE * sizeof(float));
+        if (m->state == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate filter state");
+            goto _exit;
+        }
+    } else {
+        m->block = block;
+        m->band_len = block;
+        ret = ae_fft_init(&m->fft, 2 * block);
+        if (ret != ESP_AE_ERR_OK) {
+            ESP_LOGE(TAG, "Fail to init FFT of %d points", (int)(2 * block));
+            goto _exit;
+        }
+        ret = ESP_AE_ERR_MEM_LACK;
+        uint32_t bins = 2 * (block + 1);
+        m->band_spec = (float *)malloc(cfg->band_num * bins * sizeof(float));
+        m->time = (float *)malloc(cfg->channel * 2 * block * sizeof(float));
+        m->out_blk = (float *)malloc(cfg->channel * block * sizeof(float));
+        m->spec = (float *)malloc(bins * sizeof(float));
+        m->acc = (float *)malloc(bins * sizeof(float));
+        m->work = (float *)malloc(2 * block * sizeof(float));
+        if (m->band_spec == NULL || m->time == NULL || m->out_blk == NULL || m->spec == NULL || m->acc == NULL
+            || m->work == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate buffer, fir_len %d band_num %d", (int)block, cfg->band_num);
+            goto _exit;
+        }
+        mbc_n_design_fir(m);
+    }
+    m->band_buf = (float *)malloc(cfg->channel * cfg->band_num * m->band_len * sizeof(float));
+    if (m->band_buf == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate band buffer");
+        goto _exit;
+    }
+    mbc_n_clear(m);
+    *handle = m;
+    return ESP_AE_ERR_OK;
+_exit:
+    esp_ae_mbc_n_close(m);
+    return ret;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_latency(esp_ae_mbc_n_handle_t handle, uint32_t *latency)
+{
+    if (handle == NULL || latency == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p latency:%p", handle, latency);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mbc_n_t *m = (mbc_n_t *)handle;
+    *latency = m->crossover == ESP_AE_MBC_N_CROSSOVER_IIR ? 0 : m->block + m->block / 2;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_process(esp_ae_mbc_n_handle_t handle, uint32_t sample_num,
+                                  esp_ae_sample_t in_samples, esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mbc_n_t *m = (mbc_n_t *)handle;
+    uint8_t *in[m->channel];
+    uint8_t *out[m->channel];
+    for (int c = 0; c < m->channel; c++) {
+        in[c] = (uint8_t *)in_samples + c * m->bytes;
+        out[c] = (uint8_t *)out_samples + c * m->bytes;
+    }
+    mbc_n_run(m, sample_num, in, m->channel, out, m->channel);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_deintlv_process(esp_ae_mbc_n_handle_t handle, uint32_t sample_num,
+                                          esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples[])
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mbc_n_t *m = (mbc_n_t *)handle;
+    for (int c = 0; c < m->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    mbc_n_run(m, sample_num, (uint8_t **)in_samples, 1, (uint8_t **)out_samples, 1);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_set_para(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, esp_ae_mbc_para_t *para)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || para == NULL || band_idx >= m->band_num || !mbc_n_para_valid(para)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d para:%p", handle, band_idx, para);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mbc_n_set_band_para(m, &m->band[band_idx], para);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_para(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, esp_ae_mbc_para_t *para)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || para == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d para:%p", handle, band_idx, para);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *para = m->band[band_idx].para;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_set_fc(esp_ae_mbc_n_handle_t handle, uint8_t fc_idx, uint32_t fc)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || fc_idx >= m->band_num - 1) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p fc_idx:%d", handle, fc_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    uint32_t fcs[MBC_N_MAX_FC_NUM];
+    memcpy(fcs, m->fc, sizeof(fcs));
+    fcs[fc_idx] = fc;
+    if (!mbc_n_fc_valid(m->sample_rate, fcs, m->band_num - 1)) {
+        ESP_LOGE(TAG, "Invalid fc:%d of index %d", (int)fc, fc_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    m->fc[fc_idx] = fc;
+    if (m->crossover == ESP_AE_MBC_N_CROSSOVER_IIR) {
+        mbc_n_design_iir(m, fc_idx);
+    } else {
+        mbc_n_design_fir(m);
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_fc(esp_ae_mbc_n_handle_t handle, uint8_t fc_idx, uint32_t *fc)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || fc == NULL || fc_idx >= m->band_num - 1) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p fc_idx:%d fc:%p", handle, fc_idx, fc);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *fc = m->fc[fc_idx];
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_set_solo(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool enable_solo)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d", handle, band_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    m->band[band_idx].solo = enable_solo;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_solo(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool *enable_solo)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || enable_solo == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d enable_solo:%p", handle, band_idx, enable_solo);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *enable_solo = m->band[band_idx].solo;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_set_bypass(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool enable_bypass)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d", handle, band_idx);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    m->band[band_idx].bypass = enable_bypass;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_bypass(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, bool *enable_bypass)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || enable_bypass == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d enable_bypass:%p", handle, band_idx, enable_bypass);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *enable_bypass = m->band[band_idx].bypass;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_get_gain_reduction(esp_ae_mbc_n_handle_t handle, uint8_t band_idx, float *gr_db)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL || gr_db == NULL || band_idx >= m->band_num) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p band_idx:%d gr_db:%p", handle, band_idx, gr_db);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *gr_db = m->band[band_idx].gr_db;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mbc_n_reset(esp_ae_mbc_n_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mbc_n_clear((mbc_n_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_mbc_n_close(esp_ae_mbc_n_handle_t handle)
+{
+    mbc_n_t *m = (mbc_n_t *)handle;
+    if (m == NULL) {
+        return;
+    }
+    ae_fft_deinit(&m->fft);
+    if (m->state) {
+        free(m->state);
+    }
+    if (m->band_buf) {
+        free(m->band_buf);
+    }
+    if (m->band_spec) {
+        free(m->band_spec);
+    }
+    if (m->time) {
+        free(m->time);
+    }
+    if (m->out_blk) {
+        free(m->out_blk);
+    }
+    if (m->spec) {
+        free(m->spec);
+    }
+    if (m->acc) {
+        free(m->acc);
+    }
+    if (m->work) {
+        free(m->work);
+    }
+    free(m);
+}
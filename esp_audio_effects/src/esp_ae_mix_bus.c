@@ -0,0 +1,440 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_mix_bus.h"
+
+#define TAG "AE_MIX_BUS"
+
+#define MIX_BUS_BLOCK  (256)  /*!< Sampling points accumulated per internal block */
+#define MIX_BUS_GAIN_Q (22)   /*!< Fraction bits of gain, s32 x MAX_GAIN x MAX_SRC_NUM stays within int64 */
+
+typedef struct {
+    bool     used;
+    bool     active;
+    float    gain;       /*!< Gain reached at the end of last processed sample */
+    float    target;
+    float    step;       /*!< Gain increment per sampling point during ramp */
+    uint32_t remaining;  /*!< Sampling points left in current ramp */
+} mix_bus_src_t;
+
+typedef struct {
+    uint8_t          channel;
+    uint8_t          bytes;
+    uint8_t          max_src_num;
+    mix_bus_src_t    src[ESP_AE_MIX_BUS_MAX_SRC_NUM];
+    int64_t         *acc;       /*!< MIX_BUS_BLOCK interleaved frames in MIX_BUS_GAIN_Q format */
+    int32_t         *ramp;      /*!< Per sampling point Q format gain of one block */
+    const uint8_t  **in_ptr;    /*!< max_src_num x channel input pointers of current call */
+    uint32_t         mixed_num;
+    uint32_t         skip_num;
+} mix_bus_t;
+
+static inline mix_bus_src_t *mix_bus_get_src(mix_bus_t *bus, uint8_t src_id)
+{
+    if (bus == NULL || src_id >= bus->max_src_num || bus->src[src_id].used == false) {
+        return NULL;
+    }
+    return &bus->src[src_id];
+}
+
+static void mix_bus_advance(mix_bus_src_t *src, uint32_t n)
+{
+    if (src->remaining > n) {
+        src->gain += src->step * n;
+        src->remaining -= n;
+    } else {
+        src->gain = src->target;
+        src->remaining = 0;
+    }
+}
+
+static inline bool mix_bus_is_zero(const uint8_t *p, uint32_t len)
+{
+    return p[0] == 0 && memcmp(p, p + 1, len - 1) == 0;
+}
+
+static bool mix_bus_src_is_zero(mix_bus_t *bus, const uint8_t **ptr, uint32_t stride, uint32_t n)
+{
+    if (stride != 1) {
+        return mix_bus_is_zero(ptr[0], n * bus->channel * bus->bytes);
+    }
+    for (int c = 0; c < bus->channel; c++) {
+        if (mix_bus_is_zero(ptr[c], n * bus->bytes) == false) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline int32_t mix_bus_read(const uint8_t *in, uint8_t bytes, uint32_t idx)
+{
+    switch (bytes) {
+        case 2:
+            return ((const int16_t *)in)[idx];
+        case 3: {
+            const uint8_t *p = in + idx * 3;
+            return (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+        }
+        default:
+            return ((const int32_t *)in)[idx];
+    }
+}
+
+static inline int32_t mix_bus_gain_q(float gain)
+{
+    return (int32_t)lrintf(gain * (float)(1 << MIX_BUS_GAIN_Q));
+}
+
+static void mix_bus_accumulate(mix_bus_t *bus, const uint8_t *in, uint32_t stride, int64_t *acc, uint32_t n,
+                               const int32_t *ramp, int32_t gain)
+{
+    // Samples are scaled by the Q format gain, unity gain is an exact power of two scale so it stays bit exact
+    uint32_t ch = bus->channel;
+    uint8_t bytes = bus->bytes;
+    const int64_t unity = (int64_t)1 << MIX_BUS_GAIN_Q;
+    if (ramp) {
+        for (uint32_t i = 0; i < n; i++) {
+            acc[i * ch] += (int64_t)mix_bus_read(in, bytes, i * stride) * ramp[i];
+        }
+    } else if (gain == unity) {
+        for (uint32_t i = 0; i < n; i++) {
+            acc[i * ch] += mix_bus_read(in, bytes, i * stride) * unity;
+        }
+    } else {
+        for (uint32_t i = 0; i < n; i++) {
+            acc[i * ch] += (int64_t)mix_bus_read(in, bytes, i * stride) * gain;
+        }
+    }
+}
+
+static inline int64_t mix_bus_round(int64_t v)
+{
+    return (v + (1 << (MIX_BUS_GAIN_Q - 1))) >> MIX_BUS_GAIN_Q;
+}
+
+static void mix_bus_output(mix_bus_t *bus, const int64_t *acc, uint8_t *out, uint32_t stride, uint32_t n)
+{
+    uint32_t ch = bus->channel;
+    switch (bus->bytes) {
+        case 2: {
+            int16_t *p = (int16_t *)out;
+            for (uint32_t i = 0; i < n; i++) {
+                int64_t v = mix_bus_round(acc[i * ch]);
+                p[i * stride] = v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+            }
+            break;
+        }
+        case 3:
+            for (uint32_t i = 0; i < n; i++) {
+                int64_t v = mix_bus_round(acc[i * ch]);
+                int32_t s = v > 0x7FFFFF ? 0x7FFFFF : v < -0x800000 ? -0x800000 : (int32_t)v;
+                uint8_t *p = out + i * stride * 3;
+                p[0] = (uint8_t)s;
+                p[1] = (uint8_t)(s >> 8);
+                p[2] = (uint8_t)(s >> 16);
+            }
+            break;
+        default: {
+            int32_t *p = (int32_t *)out;
+            for (uint32_t i = 0; i < n; i++) {
+                int64_t v = mix_bus_round(acc[i * ch]);
+                p[i * stride] = v > INT32_MAX ? INT32_MAX : v < INT32_MIN ? INT32_MIN : (int32_t)v;
+            }
+            break;
+        }
+    }
+}
+
+static void mix_bus_run(mix_bus_t *bus, uint32_t sample_num, uint32_t in_stride, uint8_t *out[], uint32_t out_stride)
+{
+    uint32_t ch = bus->channel;
+    for (uint32_t off = 0; off < sample_num; off += MIX_BUS_BLOCK) {
+        uint32_t n = sample_num - off < MIX_BUS_BLOCK ? sample_num - off : MIX_BUS_BLOCK;
+        bool mixed = false;
+        for (int s = 0; s < bus->max_src_num; s++) {
+            mix_bus_src_t *src = &bus->src[s];
+            if (src->used == false || src->active == false) {
+                continue;
+            }
+            const uint8_t **ptr = bus->in_ptr + s * ch;
+            if (ptr[0] == NULL || (src->gain == 0.0f && src->remaining == 0)
+                || mix_bus_src_is_zero(bus, ptr, in_stride, n)) {
+                bus->skip_num++;
+                mix_bus_advance(src, n);
+                continue;
+            }
+            if (mixed == false) {
+                memset(bus->acc, 0, n * ch * sizeof(int64_t));
+                mixed = true;
+            }
+            const int32_t *ramp = NULL;
+            if (src->remaining) {
+                uint32_t ramp_num = src->remaining < n ? src->remaining : n;
+                for (uint32_t i = 0; i < ramp_num; i++) {
+                    bus->ramp[i] = mix_bus_gain_q(src->gain + src->step * (i + 1));
+                }
+                int32_t target = mix_bus_gain_q(src->target);
+                for (uint32_t i = ramp_num; i < n; i++) {
+                    bus->ramp[i] = target;
+                }
+                ramp = bus->ramp;
+            }
+            int32_t gain = mix_bus_gain_q(src->gain);
+            for (uint32_t c = 0; c < ch; c++) {
+                mix_bus_accumulate(bus, ptr[c], in_stride, bus->acc + c, n, ramp, gain);
+            }
+            mix_bus_advance(src, n);
+            bus->mixed_num++;
+        }
+        for (uint32_t c = 0; c < ch; c++) {
+            uint8_t *o = out[c] + off * out_stride * bus->bytes;
+            if (mixed) {
+                mix_bus_output(bus, bus->acc + c, o, out_stride, n);
+            } else if (out_stride == 1) {
+                memset(o, 0, n * bus->bytes);
+            } else if (c == 0) {
+                memset(o, 0, n * ch * bus->bytes);
+            }
+        }
+        // Move per source pointers to next block
+        for (uint32_t i = 0; i < bus->max_src_num * ch; i++) {
+            if (bus->in_ptr[i]) {
+                bus->in_ptr[i] += n * in_stride * bus->bytes;
+            }
+        }
+    }
+}
+
+esp_ae_err_t esp_ae_mix_bus_open(esp_ae_mix_bus_cfg_t *cfg, esp_ae_mix_bus_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (cfg->sample_rate == 0 || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->max_src_num == 0 || cfg->max_src_num > ESP_AE_MIX_BUS_MAX_SRC_NUM) {
+        ESP_LOGE(TAG, "Invalid max_src_num:%d", cfg->max_src_num);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mix_bus_t *bus = (mix_bus_t *)calloc(1, sizeof(mix_bus_t));
+    if (bus == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    bus->channel = cfg->channel;
+    bus->bytes = cfg->bits_per_sample >> 3;
+    bus->max_src_num = cfg->max_src_num;
+    bus->acc = (int64_t *)malloc(MIX_BUS_BLOCK * cfg->channel * sizeof(int64_t));
+    bus->ramp = (int32_t *)malloc(MIX_BUS_BLOCK * sizeof(int32_t));
+    bus->in_ptr = (const uint8_t **)calloc(cfg->max_src_num * cfg->channel, sizeof(uint8_t *));
+    if (bus->acc == NULL || bus->ramp == NULL || bus->in_ptr == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer");
+        esp_ae_mix_bus_close(bus);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    *handle = bus;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_add_source(esp_ae_mix_bus_handle_t handle, float gain, uint8_t *src_id)
+{
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    if (bus == NULL || src_id == NULL || !(gain >= 0.0f && gain <= ESP_AE_MIX_BUS_MAX_GAIN)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p src_id:%p gain:%.3f", handle, src_id, gain);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    for (int i = 0; i < bus->max_src_num; i++) {
+        if (bus->src[i].used == false) {
+            bus->src[i] = (mix_bus_src_t) {
+                .used = true,
+                .active = true,
+                .gain = gain,
+                .target = gain,
+            };
+            *src_id = i;
+            return ESP_AE_ERR_OK;
+        }
+    }
+    ESP_LOGE(TAG, "All %d sources are in use", bus->max_src_num);
+    return ESP_AE_ERR_MEM_LACK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_remove_source(esp_ae_mix_bus_handle_t handle, uint8_t src_id)
+{
+    mix_bus_src_t *src = mix_bus_get_src((mix_bus_t *)handle, src_id);
+    if (src == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p src_id:%d", handle, src_id);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    src->used = false;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_set_active(esp_ae_mix_bus_handle_t handle, uint8_t src_id, bool active)
+{
+    mix_bus_src_t *src = mix_bus_get_src((mix_bus_t *)handle, src_id);
+    if (src == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p src_id:%d", handle, src_id);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    src->active = active;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_set_gain(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float gain, uint32_t ramp_samples)
+{
+    mix_bus_src_t *src = mix_bus_get_src((mix_bus_t *)handle, src_id);
+    if (src == NULL || !(gain >= 0.0f && gain <= ESP_AE_MIX_BUS_MAX_GAIN)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p src_id:%d gain:%.3f", handle, src_id, gain);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    src->target = gain;
+    src->remaining = ramp_samples;
+    if (ramp_samples == 0) {
+        src->gain = gain;
+    } else {
+        src->step = (gain - src->gain) / ramp_samples;
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_set_gain_db(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float gain_db,
+                                        uint32_t ramp_samples)
+{
+    if (isnan(gain_db)) {
+        ESP_LOGE(TAG, "Invalid parameter gain_db is NaN");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    float gain = 0.0f;
+    if (gain_db > ESP_AE_MIX_BUS_MUTE_DB) {
+        gain = powf(10.0f, gain_db / 20.0f);
+        // Tolerate rounding of 20 * log10(ESP_AE_MIX_BUS_MAX_GAIN) given by user
+        if (gain > ESP_AE_MIX_BUS_MAX_GAIN && gain < ESP_AE_MIX_BUS_MAX_GAIN * 1.001f) {
+            gain = ESP_AE_MIX_BUS_MAX_GAIN;
+        }
+    }
+    return esp_ae_mix_bus_set_gain(handle, src_id, gain, ramp_samples);
+}
+
+esp_ae_err_t esp_ae_mix_bus_get_gain(esp_ae_mix_bus_handle_t handle, uint8_t src_id, float *gain)
+{
+    mix_bus_src_t *src = mix_bus_get_src((mix_bus_t *)handle, src_id);
+    if (src == NULL || gain == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p src_id:%d gain:%p", handle, src_id, gain);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *gain = src->gain;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_process(esp_ae_mix_bus_handle_t handle, uint32_t sample_num,
+                                    esp_ae_sample_t in_samples[], esp_ae_sample_t out_samples)
+{
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    if (bus == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    for (int s = 0; s < bus->max_src_num; s++) {
+        for (int c = 0; c < bus->channel; c++) {
+            bus->in_ptr[s * bus->channel + c] = in_samples[s] ? (const uint8_t *)in_samples[s] + c * bus->bytes : NULL;
+        }
+    }
+    uint8_t *out[bus->channel];
+    for (int c = 0; c < bus->channel; c++) {
+        out[c] = (uint8_t *)out_samples + c * bus->bytes;
+    }
+    mix_bus_run(bus, sample_num, bus->channel, out, bus->channel);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_deintlv_process(esp_ae_mix_bus_handle_t handle, uint32_t sample_num,
+                                            esp_ae_sample_t *in_samples[], esp_ae_sample_t out_samples[])
+{
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    if (bus == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    for (int c = 0; c < bus->channel; c++) {
+        if (out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter output channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    for (int s = 0; s < bus->max_src_num; s++) {
+        bool valid = in_samples[s] != NULL;
+        for (int c = 0; valid && c < bus->channel; c++) {
+            valid = in_samples[s][c] != NULL;
+        }
+        for (int c = 0; c < bus->channel; c++) {
+            bus->in_ptr[s * bus->channel + c] = valid ? (const uint8_t *)in_samples[s][c] : NULL;
+        }
+    }
+    mix_bus_run(bus, sample_num, 1, (uint8_t **)out_samples, 1);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_get_stats(esp_ae_mix_bus_handle_t handle, uint32_t *mixed_num, uint32_t *skip_num)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    if (mixed_num) {
+        *mixed_num = bus->mixed_num;
+    }
+    if (skip_num) {
+        *skip_num = bus->skip_num;
+    }
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_mix_bus_reset(esp_ae_mix_bus_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    memset(bus->src, 0, sizeof(bus->src));
+    bus->mixed_num = 0;
+    bus->skip_num = 0;
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_mix_bus_close(esp_ae_mix_bus_handle_t handle)
+{
+    mix_bus_t *bus = (mix_bus_t *)handle;
+    if (bus == NULL) {
+        return;
+    }
+    if (bus->acc) {
+        free(bus->acc);
+    }
+    if (bus->ramp) {
+        free(bus->ramp);
+    }
+    if (bus->in_ptr) {
+        free(bus->in_ptr);
+    }
+    free(bus);
+}
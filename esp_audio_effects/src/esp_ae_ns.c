@@ -0,0 +1,343 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "esp_log.h"
+#include "esp_ae_ns.h"
+#include "ae_stft.h"
+
+#define TAG "AE_NS"
+
+#define NS_PSD_SMOOTH   (0.7f)    /*!< Recursive smoothing of the power spectrum */
+#define NS_MIN_GAMMA    (0.998f)  /*!< Continuous minimum tracking, Doblinger */
+#define NS_MIN_BETA     (0.96f)
+#define NS_NOISE_BIAS   (2.0f)    /*!< Compensate the tracked minimum below the mean noise power */
+#define NS_DD_ALPHA     (0.98f)   /*!< Decision directed a priori SNR smoothing of 10 ms frames */
+#define NS_INIT_FRAMES  (10)      /*!< Frames averaged as the initial noise estimate */
+#define NS_POWER_FLOOR  (1e-12f)
+
+typedef struct {
+    float *in_buf;  /*!< Previous and current frame, 2 * hop */
+    float *tail;    /*!< Overlap-add tail, hop */
+    float *psd;     /*!< Smoothed power spectrum */
+    float *psd_min;
+    float *noise;
+    float *clean;   /*!< Clean power of the previous frame for decision directed estimation */
+} ns_chan_t;
+
+typedef struct {
+    uint8_t     channel;
+    uint8_t     bytes;
+    uint32_t    hop;
+    uint32_t    bins;
+    uint32_t    frames;
+    float       scale;
+    float       out_limit;
+    float       gain_min;
+    float       dd_alpha;
+    ae_stft_t   stft;
+    float      *spec;
+    float      *frame;
+    ns_chan_t  *chan;
+} ns_t;
+
+static inline float ns_read(const uint8_t *in, uint8_t bytes)
+{
+    switch (bytes) {
+        case 2:
+            return *(const int16_t *)in;
+        case 3:
+            return (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24)) >> 8;
+        default:
+            return (float)*(const int32_t *)in;
+    }
+}
+
+static inline void ns_write(uint8_t *out, uint8_t bytes, float v, float limit)
+{
+    v = v > limit ? limit : v < -limit ? -limit : v;
+    int32_t s = (int32_t)lrintf(v);
+    switch (bytes) {
+        case 2:
+            *(int16_t *)out = (int16_t)s;
+            break;
+        case 3:
+            out[0] = (uint8_t)s;
+            out[1] = (uint8_t)(s >> 8);
+            out[2] = (uint8_t)(s >> 16);
+            break;
+        default:
+            *(int32_t *)out = s;
+            break;
+    }
+}
+
+static void ns_update_noise(ns_t *ns, ns_chan_t *ch, const float *power)
+{
+    if (ns->frames == 0) {
+        for (uint32_t k = 0; k < ns->bins; k++) {
+            ch->psd[k] = power[k];
+            ch->psd_min[k] = power[k];
+            ch->noise[k] = power[k];
+        }
+        return;
+    }
+    for (uint32_t k = 0; k < ns->bins; k++) {
+        float s = NS_PSD_SMOOTH * ch->psd[k] + (1.0f - NS_PSD_SMOOTH) * power[k];
+        // Minimum follows rises slowly and drops immediately
+        if (ch->psd_min[k] < s) {
+            ch->psd_min[k] = NS_MIN_GAMMA * ch->psd_min[k]
+                             + (1.0f - NS_MIN_GAMMA) / (1.0f - NS_MIN_BETA) * (s - NS_MIN_BETA * ch->psd[k]);
+        } else {
+            ch->psd_min[k] = s;
+        }
+        ch->psd[k] = s;
+        if (ns->frames < NS_INIT_FRAMES) {
+            ch->noise[k] += (power[k] - ch->noise[k]) / (ns->frames + 1);
+        } else {
+            ch->noise[k] = NS_NOISE_BIAS * ch->psd_min[k];
+        }
+    }
+}
+
+static void ns_suppress(ns_t *ns, ns_chan_t *ch)
+{
+    float *spec = ns->spec;
+    uint32_t bins = ns->bins;
+    float power[bins];
+    for (uint32_t k = 0; k < bins; k++) {
+        power[k] = spec[2 * k] * spec[2 * k] + spec[2 * k + 1] * spec[2 * k + 1];
+    }
+    ns_update_noise(ns, ch, power);
+    for (uint32_t k = 0; k < bins; k++) {
+        float noise = ch->noise[k] + NS_POWER_FLOOR;
+        float post = power[k] / noise;
+        float prio = ns->dd_alpha * ch->clean[k] / noise + (1.0f - ns->dd_alpha) * (post > 1.0f ? post - 1.0f : 0.0f);
+        float gain = prio / (1.0f + prio);
+        gain = gain < ns->gain_min ? ns->gain_min : gain;
+        ch->clean[k] = gain * gain * power[k];
+        spec[2 * k] *= gain;
+        spec[2 * k + 1] *= gain;
+    }
+}
+
+static void ns_run(ns_t *ns, uint8_t *in[], uint32_t in_stride, uint8_t *out[], uint32_t out_stride)
+{
+    uint32_t hop = ns->hop;
+    float inv_scale = 1.0f / ns->scale;
+    // Read all channels before writing so that inplace interleaved processing is safe
+    for (int c = 0; c < ns->channel; c++) {
+        float *buf = ns->chan[c].in_buf;
+        memcpy(buf, buf + hop, hop * sizeof(float));
+        for (uint32_t i = 0; i < hop; i++) {
+            buf[hop + i] = ns_read(in[c] + i * in_stride * ns->bytes, ns->bytes) * inv_scale;
+        }
+    }
+    for (int c = 0; c < ns->channel; c++) {
+        ns_chan_t *ch = &ns->chan[c];
+        ae_stft_analyze(&ns->stft, ch->in_buf, ns->spec);
+        ns_suppress(ns, ch);
+        ae_stft_synthesize(&ns->stft, ns->spec, ch->tail, ns->frame);
+        for (uint32_t i = 0; i < hop; i++) {
+            ns_write(out[c] + i * out_stride * ns->bytes, ns->bytes, ns->frame[i] * ns->scale, ns->out_limit);
+        }
+    }
+    ns->frames = ns->frames < NS_INIT_FRAMES ? ns->frames + 1 : ns->frames;
+}
+
+static void ns_clear(ns_t *ns)
+{
+    for (int c = 0; c < ns->channel; c++) {
+        ns_chan_t *ch = &ns->chan[c];
+        memset(ch->in_buf, 0, 2 * ns->hop * sizeof(float));
+        memset(ch->tail, 0, ns->hop * sizeof(float));
+        memset(ch->clean, 0, ns->bins * sizeof(float));
+    }
+    ns->frames = 0;
+}
+
+static bool ns_suppress_valid(float suppress_db)
+{
+    return suppress_db >= ESP_AE_NS_MIN_SUPPRESS_DB && suppress_db <= ESP_AE_NS_MAX_SUPPRESS_DB;
+}
+
+esp_ae_err_t esp_ae_ns_open(esp_ae_ns_cfg_t *cfg, esp_ae_ns_handle_t *handle)
+{
+    if (cfg == NULL || handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter cfg:%p handle:%p", cfg, handle);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    *handle = NULL;
+    if (ae_stft_get_hop(cfg->sample_rate) == 0 || cfg->channel == 0) {
+        ESP_LOGE(TAG, "Invalid sample_rate:%d channel:%d", (int)cfg->sample_rate, cfg->channel);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (cfg->bits_per_sample != ESP_AE_BIT16 && cfg->bits_per_sample != ESP_AE_BIT24
+        && cfg->bits_per_sample != ESP_AE_BIT32) {
+        ESP_LOGE(TAG, "Invalid bits_per_sample:%d", cfg->bits_per_sample);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    if (!ns_suppress_valid(cfg->suppress_db)) {
+        ESP_LOGE(TAG, "Invalid suppress_db:%.2f", cfg->suppress_db);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ns_t *ns = (ns_t *)calloc(1, sizeof(ns_t));
+    if (ns == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate handle");
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    ns->channel = cfg->channel;
+    ns->bytes = cfg->bits_per_sample >> 3;
+    ns->scale = (float)(1u << (cfg->bits_per_sample - 1));
+    ns->out_limit = ns->bytes == 2 ? 32767.0f : ns->bytes == 3 ? 8388607.0f : 2147483520.0f;
+    ns->gain_min = powf(10.0f, cfg->suppress_db / 20.0f);
+    esp_ae_err_t ret = ae_stft_init(&ns->stft, cfg->sample_rate);
+    if (ret != ESP_AE_ERR_OK) {
+        ESP_LOGE(TAG, "Fail to init STFT of sample rate %d", (int)cfg->sample_rate);
+        esp_ae_ns_close(ns);
+        return ret;
+    }
+    ns->hop = ns->stft.hop;
+    ns->bins = ns->hop + 1;
+    // Same smoothing time for every frame duration
+    ns->dd_alpha = powf(NS_DD_ALPHA, ns->hop * 100.0f / cfg->sample_rate);
+    ns->spec = (float *)malloc(AE_FFT_SPEC_SIZE(2 * ns->hop) * sizeof(float));
+    ns->frame = (float *)malloc(ns->hop * sizeof(float));
+    ns->chan = (ns_chan_t *)calloc(ns->channel, sizeof(ns_chan_t));
+    if (ns->spec == NULL || ns->frame == NULL || ns->chan == NULL) {
+        ESP_LOGE(TAG, "Fail to allocate buffer");
+        esp_ae_ns_close(ns);
+        return ESP_AE_ERR_MEM_LACK;
+    }
+    for (int c = 0; c < ns->channel; c++) {
+        ns_chan_t *ch = &ns->chan[c];
+        ch->in_buf = (float *)malloc(2 * ns->hop * sizeof(float));
+        ch->tail = (float *)malloc(ns->hop * sizeof(float));
+        ch->psd = (float *)malloc(ns->bins * sizeof(float));
+        ch->psd_min = (float *)malloc(ns->bins * sizeof(float));
+        ch->noise = (float *)malloc(ns->bins * sizeof(float));
+        ch->clean = (float *)malloc(ns->bins * sizeof(float));
+        if (ch->in_buf == NULL || ch->tail == NULL || ch->psd == NULL || ch->psd_min == NULL
+            || ch->noise == NULL || ch->clean == NULL) {
+            ESP_LOGE(TAG, "Fail to allocate buffer of channel %d", c);
+            esp_ae_ns_close(ns);
+            return ESP_AE_ERR_MEM_LACK;
+        }
+    }
+    ns_clear(ns);
+    *handle = ns;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_ns_get_frame_size(esp_ae_ns_handle_t handle, uint32_t *frame_size)
+{
+    if (handle == NULL || frame_size == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p frame_size:%p", handle, frame_size);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ns_t *ns = (ns_t *)handle;
+    *frame_size = ns->hop * ns->channel * ns->bytes;
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_ns_process(esp_ae_ns_handle_t handle, esp_ae_sample_t in_samples, esp_ae_sample_t out_samples)
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ns_t *ns = (ns_t *)handle;
+    uint8_t *in[ns->channel];
+    uint8_t *out[ns->channel];
+    for (int c = 0; c < ns->channel; c++) {
+        in[c] = (uint8_t *)in_samples + c * ns->bytes;
+        out[c] = (uint8_t *)out_samples + c * ns->bytes;
+    }
+    ns_run(ns, in, ns->channel, out, ns->channel);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_ns_deintlv_process(esp_ae_ns_handle_t handle, esp_ae_sample_t in_samples[],
+                                       esp_ae_sample_t out_samples[])
+{
+    if (handle == NULL || in_samples == NULL || out_samples == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p in:%p out:%p", handle, in_samples, out_samples);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ns_t *ns = (ns_t *)handle;
+    for (int c = 0; c < ns->channel; c++) {
+        if (in_samples[c] == NULL || out_samples[c] == NULL) {
+            ESP_LOGE(TAG, "Invalid parameter channel %d buffer is NULL", c);
+            return ESP_AE_ERR_INVALID_PARAMETER;
+        }
+    }
+    ns_run(ns, (uint8_t **)in_samples, 1, (uint8_t **)out_samples, 1);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_ns_set_suppress(esp_ae_ns_handle_t handle, float suppress_db)
+{
+    if (handle == NULL || !ns_suppress_valid(suppress_db)) {
+        ESP_LOGE(TAG, "Invalid parameter handle:%p suppress_db:%.2f", handle, suppress_db);
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ((ns_t *)handle)->gain_min = powf(10.0f, suppress_db / 20.0f);
+    return ESP_AE_ERR_OK;
+}
+
+esp_ae_err_t esp_ae_ns_reset(esp_ae_ns_handle_t handle)
+{
+    if (handle == NULL) {
+        ESP_LOGE(TAG, "Invalid parameter handle is NULL");
+        return ESP_AE_ERR_INVALID_PARAMETER;
+    }
+    ns_clear((ns_t *)handle);
+    return ESP_AE_ERR_OK;
+}
+
+void esp_ae_ns_close(esp_ae_ns_handle_t handle)
+{
+    ns_t *ns = (ns_t *)handle;
+    if (ns == NULL) {
+        return;
+    }
+    if (ns->chan) {
+        for (int c = 0; c < ns->channel; c++) {
+            ns_chan_t *ch = &ns->chan[c];
+            if (ch->in_buf) {
+                free(ch->in_buf);
+            }
+            if (ch->tail) {
+                free(ch->tail);
+            }
+            if (ch->psd) {
+                free(ch->psd);
+            }
+            if (ch->psd_min) {
+                free(ch->psd_min);
+            }
+            if (ch->noise) {
+                free(ch->noise);
+            }
+            if (ch->clean) {
+                free(ch->clean);
+            }
+        }
+        free(ns->chan);
+    }
+    if (ns->spec) {
+        free(ns->spec);
+    }
+    if (ns->frame) {
+        free(ns->frame);
+    }
+    ae_stft_deinit(&ns->stft);
+    free(ns);
+}
@@ -1,45 +1,25 @@
 /*
- * ESPRESSIF MIT License
- *
- * Copyright (c) 2024 <ESPRESSIF SYSTEMS (SHANGHAI) PTE LTD>
- *
- * Permission is hereby granted for use on all ESPRESSIF SYSTEMS products, in which case,
- * it is free of charge, to any person obtaining a copy of this software and associated
- * documentation files (the "Software"), to deal in the Software without restriction, including
- * without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
- * and/or sell copies of the Software, and to permit persons to whom the Software is furnished
- * to do so, subject to the following conditions:
- *
- * The above copyright notice and this permission notice shall be included in all copies or
- * substantial portions of the Software.
- *
- * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
- * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
- * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
- * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
- * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ * SPDX-FileCopyrightText: 2024-2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
  *
+ * See LICENSE file for details.
  */
-#if 0
+
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include <math.h>
-#include <time.h>
+#include "sdkconfig.h"
 #include "unity.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "freertos/queue.h"
-#include "freertos/semphr.h"
 #include "esp_system.h"
 #include "esp_heap_caps.h"
+#include "esp_idf_version.h"
 #include "esp_log.h"
 #include "esp_err.h"
-#include "esp_timer.h"
-#include "test_common.h"
 #include "esp_ae_alc.h"
 #include "esp_ae_bit_cvt.h"
 #include "esp_ae_ch_cvt.h"
+#include "esp_ae_data_weaver.h"
 #include "esp_ae_sonic.h"
 #include "esp_ae_eq.h"
 #include "esp_ae_fade.h"
@@ -50,1001 +30,831 @@
 #include "esp_ae_howl.h"
 #include "esp_ae_reverb.h"
 #include "esp_ae_delay.h"
-#include "media_lib_adapter.h"
-#include "media_lib_mem_trace.h"
+#include "esp_ae_chain.h"
+#include "esp_ae_async_src.h"
+#include "esp_ae_mix_bus.h"
+#include "esp_ae_conv.h"
+#include "esp_ae_limiter.h"
+#include "esp_ae_aec.h"
+#include "esp_ae_ns.h"
+#include "esp_ae_loudness.h"
+#include "esp_ae_mbc_n.h"
+#include "ae_common.h"
+#if CONFIG_IDF_TARGET_LINUX
+#include <time.h>
+#else
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#endif  /* CONFIG_IDF_TARGET_LINUX */
 
 #define TAG "TEST_AE_PERFORMANCE"
 
-void wrap_read_8(uint8_t *buf, int byte_len)
+/**
+ * Every module runs over the matrix of `perf_sample_rate` x `perf_bits` x `perf_channel` x layout,
+ * each case processes `AE_PERF_DURATION_MS` of white noise and prints one line for regression tracking:
+ *
+ *   AE_PERF,module,sample_rate,channel,bits,layout,samples_per_sec,cycles_per_sample,cpu_load,peak_heap
+ *
+ * samples_per_sec    Sample points (per channel) processed per second of CPU time
+ * cycles_per_sample  CPU cycles per sample point (all channels)
+ * cpu_load           CPU loading (%) for real-time processing
+ * peak_heap          Peak heap (bytes) used by the module during open and process
+ *
+ * On a Linux host (`idf.py --preview set-target linux`) only the modules built from source are measured, the
+ * prebuilt library and the chain whose stages come from it exist for chip targets only. Time is read from the
+ * monotonic clock as 1 GHz cycles and peak_heap is reported as 0
+ */
+#define AE_PERF_DURATION_MS  (500)
+#define AE_PERF_BLOCK_SIZE   (512)
+#define AE_PERF_MAX_BLOCK    (1024)
+#define AE_PERF_MAX_CH       (2)
+#define AE_PERF_OUT_FACTOR   (8)  /*!< Output headroom for rate conversion up to 6x */
+#define AE_PERF_HEAP_CAPS    (MALLOC_CAP_8BIT)
+
+#if CONFIG_IDF_TARGET_LINUX
+#define AE_PERF_PREBUILT (0)
+#else
+#define AE_PERF_PREBUILT (1)
+#endif  /* CONFIG_IDF_TARGET_LINUX */
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0) && AE_PERF_PREBUILT
+#define AE_PERF_LOCAL_MIN_HEAP (1)
+#endif  /* ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0) && AE_PERF_PREBUILT */
+
+typedef struct {
+    uint32_t         sample_rate;
+    uint8_t          channel;
+    uint8_t          bits;
+    void            *handle;
+    uint32_t         block;  /*!< Input samples per call, set by open when the module is frame based */
+    uint8_t         *in;
+    uint8_t         *out;
+    esp_ae_sample_t  in_ch[AE_PERF_MAX_CH];
+    esp_ae_sample_t  out_ch[AE_PERF_MAX_CH];
+} ae_perf_ctx_t;
+
+typedef struct {
+    const char *name;
+    esp_ae_err_t (*open)(ae_perf_ctx_t *ctx);  /*!< ESP_AE_ERR_NOT_SUPPORT skips the case */
+    esp_ae_err_t (*process)(ae_perf_ctx_t *ctx);
+    esp_ae_err_t (*deintlv_process)(ae_perf_ctx_t *ctx);  /*!< NULL if not supported */
+    void (*close)(ae_perf_ctx_t *ctx);
+} ae_perf_module_t;
+
+static uint32_t perf_sample_rate[] = {8000, 16000, 44100, 48000};
+static uint8_t  perf_bits[]        = {16, 24, 32};
+static uint8_t  perf_channel[]     = {1, 2};
+
+#if AE_PERF_PREBUILT
+static esp_ae_drc_curve_point perf_drc_point[] = {{.x = 0.0f, .y = -20.0f}, {.x = -40.0f, .y = -40.0f}, {.x = -100.0f, .y = -100.0f}};
+static esp_ae_eq_filter_para_t perf_eq_para[] = {
+    {.filter_type = ESP_AE_EQ_FILTER_PEAK, .fc = 2000, .q = 1.0f, .gain = 5.0f},
+};
+
+#define AE_PERF_DRC_PARA {                                 \
+    .point = perf_drc_point,                               \
+    .point_num = sizeof(perf_drc_point) / sizeof(perf_drc_point[0]), \
+    .makeup_gain = 0.0f,                                   \
+    .knee_width = 1.0f,                                    \
+    .attack_time = 10,                                     \
+    .release_time = 80,                                    \
+    .hold_time = 3,                                        \
+}
+#endif  /* AE_PERF_PREBUILT */
+
+#define AE_PERF_SIMPLE_OPS(mod)                                                                  \
+static esp_ae_err_t perf_##mod##_process(ae_perf_ctx_t *ctx)                                    \
+{                                                                                                \
+    return esp_ae_##mod##_process(ctx->handle, ctx->block, ctx->in, ctx->out);                   \
+}                                                                                                \
+static esp_ae_err_t perf_##mod##_deintlv_process(ae_perf_ctx_t *ctx)                            \
+{                                                                                                \
+    return esp_ae_##mod##_deintlv_process(ctx->handle, ctx->block, ctx->in_ch, ctx->out_ch);     \
+}                                                                                                \
+static void perf_##mod##_close(ae_perf_ctx_t *ctx)                                               \
+{                                                                                                \
+    esp_ae_##mod##_close(ctx->handle);                                                           \
+}
+
+AE_PERF_SIMPLE_OPS(conv)
+AE_PERF_SIMPLE_OPS(limiter)
+AE_PERF_SIMPLE_OPS(loudness)
+AE_PERF_SIMPLE_OPS(mbc_n)
+
+#if AE_PERF_PREBUILT
+AE_PERF_SIMPLE_OPS(alc)
+AE_PERF_SIMPLE_OPS(bit_cvt)
+AE_PERF_SIMPLE_OPS(ch_cvt)
+AE_PERF_SIMPLE_OPS(eq)
+AE_PERF_SIMPLE_OPS(fade)
+AE_PERF_SIMPLE_OPS(drc)
+AE_PERF_SIMPLE_OPS(mbc)
+AE_PERF_SIMPLE_OPS(reverb)
+AE_PERF_SIMPLE_OPS(delay)
+
+static esp_ae_err_t perf_alc_open(ae_perf_ctx_t *ctx)
 {
-    srand(time(NULL));
-    for (int i = 0; i < byte_len; i++) {
-        buf[i] = (uint8_t)((rand() % (1 << 8)));
+    esp_ae_alc_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+    };
+    esp_ae_err_t ret = esp_ae_alc_open(&cfg, &ctx->handle);
+    for (int i = 0; ret == ESP_AE_ERR_OK && i < ctx->channel; i++) {
+        ret = esp_ae_alc_set_gain(ctx->handle, i, -5);
     }
+    return ret;
 }
 
-void wrap_read_16(int16_t *buf, int byte_len)
+static esp_ae_err_t perf_bit_cvt_open(ae_perf_ctx_t *ctx)
 {
-    srand(time(NULL));
-    for (int i = 0; i < byte_len; i++) {
-        buf[i] = (short)((rand() % (1 << 16)) - (1 << 15));
-    }
+    esp_ae_bit_cvt_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .src_bits = ctx->bits,
+        .dest_bits = ctx->bits == ESP_AE_BIT16 ? ESP_AE_BIT32 : ESP_AE_BIT16,
+    };
+    return esp_ae_bit_cvt_open(&cfg, &ctx->handle);
 }
 
-void wrap_read_24(int8_t *buf, int byte_len)
+static esp_ae_err_t perf_ch_cvt_open(ae_perf_ctx_t *ctx)
 {
-    srand(time(NULL));
-    for (int i = 0; i < byte_len; i++) {
-        *(buf++) = 0;
-        int16_t *out = (int16_t *)buf;
-        *out = (int16_t)((rand() % (1 << 16)) - (1 << 15));
-        buf += 2;
-    }
+    esp_ae_ch_cvt_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .bits_per_sample = ctx->bits,
+        .src_ch = ctx->channel,
+        .dest_ch = ctx->channel == 1 ? 2 : 1,
+    };
+    return esp_ae_ch_cvt_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_data_weaver_process(ae_perf_ctx_t *ctx)
+{
+    return esp_ae_deintlv_process(ctx->channel, ctx->bits, ctx->block, ctx->in, ctx->out_ch);
 }
 
-void wrap_read_32(int16_t *buf, int byte_len)
+static esp_ae_err_t perf_data_weaver_deintlv_process(ae_perf_ctx_t *ctx)
 {
-    srand(time(NULL));
-    memset(buf, 0, byte_len * 4);
-    int16_t *out = buf;
-    out++;
-    for (int i = 0; i < byte_len; i++) {
-        *out = (int16_t)((rand() % (1 << 16)) - (1 << 15));
-        out += 2;
+    return esp_ae_intlv_process(ctx->channel, ctx->bits, ctx->block, ctx->in_ch, ctx->out);
+}
+
+static esp_ae_err_t perf_eq_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_eq_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .filter_num = sizeof(perf_eq_para) / sizeof(perf_eq_para[0]),
+        .para = perf_eq_para,
+    };
+    esp_ae_err_t ret = esp_ae_eq_open(&cfg, &ctx->handle);
+    for (int i = 0; ret == ESP_AE_ERR_OK && i < cfg.filter_num; i++) {
+        ret = esp_ae_eq_enable_filter(ctx->handle, i);
     }
+    return ret;
+}
+
+static esp_ae_err_t perf_fade_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_fade_cfg_t cfg = {
+        .mode = ESP_AE_FADE_MODE_FADE_IN,
+        .curve = ESP_AE_FADE_CURVE_QUAD,
+        .transit_time = 120000,
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+    };
+    return esp_ae_fade_open(&cfg, &ctx->handle);
 }
 
-void wrap_read(void *buf, int byte_len, int bit)
+static esp_ae_err_t perf_mixer_open(ae_perf_ctx_t *ctx)
 {
-    switch (bit) {
-        case 8:
-            wrap_read_8((uint8_t *)buf, byte_len);
-            break;
-        case 16:
-            wrap_read_16((int16_t *)buf, byte_len);
-            break;
-        case 24:
-            wrap_read_24((int8_t *)buf, byte_len);
-            break;
-        case 32:
-            wrap_read_32((int16_t *)buf, byte_len);
-            break;
-        default:
-            break;
+    esp_ae_mixer_info_t src_info[2] = {
+        {.weight1 = 0.0f, .weight2 = 1.0f, .transit_time = 500},
+        {.weight1 = 0.0f, .weight2 = 1.0f, .transit_time = 500},
+    };
+    esp_ae_mixer_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .src_num = 2,
+        .src_info = src_info,
+    };
+    esp_ae_err_t ret = esp_ae_mixer_open(&cfg, &ctx->handle);
+    for (int i = 0; ret == ESP_AE_ERR_OK && i < cfg.src_num; i++) {
+        ret = esp_ae_mixer_set_mode(ctx->handle, i, ESP_AE_MIXER_MODE_FADE_UPWARD);
     }
+    return ret;
 }
 
-void start_mem_cnt()
+static esp_ae_err_t perf_mixer_process(ae_perf_ctx_t *ctx)
 {
-    media_lib_mem_trace_cfg_t cfg = {0};
-    cfg.trace_type |= MEDIA_LIB_MEM_TRACE_MODULE_USAGE;
-#ifdef CONFIG_MEDIA_LIB_MEM_TRACE_DEPTH
-    cfg.stack_depth = CONFIG_MEDIA_LIB_MEM_TRACE_DEPTH;
-#else
-    cfg.stack_depth = 3;
-#endif
-#ifdef CONFIG_MEDIA_LIB_MEM_TRACE_NUM
-    cfg.record_num = CONFIG_MEDIA_LIB_MEM_TRACE_NUM;
-#else
-    cfg.record_num = 1024;
-#endif
-    media_lib_start_mem_trace(&cfg);
+    esp_ae_sample_t in[2] = {ctx->in, ctx->in};
+    return esp_ae_mixer_process(ctx->handle, ctx->block, in, ctx->out);
 }
 
-void end_mem_cnt()
+static esp_ae_err_t perf_mixer_deintlv_process(ae_perf_ctx_t *ctx)
 {
-    media_lib_stop_mem_trace();
-    uint32_t used_mem = 0;
-    uint32_t peak_mem = 0;
-    media_lib_get_mem_usage(NULL, &used_mem, &peak_mem);
+    esp_ae_sample_t *in[2] = {ctx->in_ch, ctx->in_ch};
+    return esp_ae_mixer_deintlv_process(ctx->handle, ctx->block, in, ctx->out_ch);
 }
 
-TEST_CASE("Alc performance test", "AUDIO_EFFECTS")
+static void perf_mixer_close(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "alc test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int gain[3] = {-5, 0, 5};
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 3; k++) {
-        for (int i = 0; i < 3; i++) {
-            void *alc_hd = NULL;
-            char *in_buf = NULL;
-            char *out_buf = NULL;
-            int cnt = 0;
-            int in_num = 0;
-            int out_num = 0;
-            // config
-            esp_ae_alc_cfg_t cfg;
-            cfg.sample_rate = sample_rate;
-            cfg.channel = channel;
-            cfg.bits_per_sample = bit[k];
-            start_mem_cnt();
-            int ret = esp_ae_alc_open(&cfg, &alc_hd);
-            TEST_ASSERT_NOT_EQUAL(alc_hd, NULL);
-            in_num = 512;
-            out_num = 512;
-            in_buf = calloc(1, in_num * channel * (bit[k] >> 3));
-            TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-            out_buf = calloc(1, out_num * channel * (bit[k] >> 3));
-            TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-            for (int j = 0; j < channel; j++) {
-                esp_ae_alc_set_gain(alc_hd, j, gain[i]);
-            }
-            diff = 0;
-            sample_cnt = 0;
-            while (cnt <= 2000) {
-                wrap_read(in_buf, in_num * channel, bit[k]);
-                sample_cnt += in_num;
-                st = esp_timer_get_time();
-                ret = esp_ae_alc_process(alc_hd, in_num, (void *)in_buf, (void *)out_buf);
-                et = esp_timer_get_time();
-                TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-                diff += et - st;
-                cnt++;
-            }
-            uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-            ESP_LOGI(TAG, "alc: bit:%d, vol:%d, ratio:%02f", bit[k], gain[i], (double)diff / (duration * 10));
-            esp_ae_alc_close(alc_hd);
-            end_mem_cnt();
-            free(in_buf);
-            free(out_buf);
-        }
-    }
-    media_lib_stop_mem_trace();
+    esp_ae_mixer_close(ctx->handle);
 }
+#endif  /* AE_PERF_PREBUILT */
+
+#define AE_PERF_MIX_BUS_SRC_NUM (4)
 
-TEST_CASE("Bit convert performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_mix_bus_open(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "bit cvt test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int bit[4] = {8, 16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            void *bit_hd = NULL;
-            char *in_buf = NULL;
-            char *out_buf = NULL;
-            int cnt = 0;
-            int in_num = 0;
-            int out_num = 0;
-            esp_ae_bit_cvt_cfg_t cfg = {.sample_rate = sample_rate, .channel = channel, .src_bits = bit[i], .dest_bits = bit[j]};
-            start_mem_cnt();
-            esp_ae_bit_cvt_open(&cfg, &bit_hd);
-            TEST_ASSERT_NOT_EQUAL(bit_hd, NULL);
-            in_num = 512;
-            out_num = 512;
-            in_buf = calloc(1, in_num * channel * (bit[i] >> 3));
-            TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-            out_buf = calloc(1, out_num * channel * (bit[j] >> 3));
-            TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-            diff = 0;
-            sample_cnt = 0;
-            while (cnt <= 2000) {
-                wrap_read(in_buf, in_num * channel, bit[i]);
-                st = esp_timer_get_time();
-                esp_ae_bit_cvt_process(bit_hd, in_num, in_buf, out_buf);
-                et = esp_timer_get_time();
-                diff += et - st;
-                sample_cnt += in_num;
-                cnt++;
-            }
-            uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-            ESP_LOGI(TAG, "bitcvt: src_bit:%d, dest_bit:%d, ratio:%02f", bit[i], bit[j], (double)diff / (duration * 10));
-            esp_ae_bit_cvt_close(bit_hd);
-            end_mem_cnt();
-            free(in_buf);
-            free(out_buf);
+    esp_ae_mix_bus_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .max_src_num = AE_PERF_MIX_BUS_SRC_NUM,
+    };
+    esp_ae_err_t ret = esp_ae_mix_bus_open(&cfg, &ctx->handle);
+    for (int i = 0; ret == ESP_AE_ERR_OK && i < AE_PERF_MIX_BUS_SRC_NUM; i++) {
+        uint8_t id = 0;
+        ret = esp_ae_mix_bus_add_source(ctx->handle, 0.0f, &id);
+        if (ret == ESP_AE_ERR_OK) {
+            ret = esp_ae_mix_bus_set_gain(ctx->handle, id, 0.25f, ctx->sample_rate / 2);
         }
     }
-    media_lib_stop_mem_trace();
+    return ret;
 }
 
-TEST_CASE("Channel convert performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_mix_bus_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "ch cvt test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int bit[3] = {16, 24, 32};
-    int src_ch = 2;
-    int dest_ch = 1;
-    float weight[2] = {0.5, 0.5};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int i = 0; i < 3; i++) {
-        void *ch_hd = NULL;
-        char *in_buf = NULL;
-        char *out_buf = NULL;
-        int cnt = 0;
-        int in_num = 0;
-        int out_num = 0;
-        // config
-        esp_ae_ch_cvt_cfg_t cfg = {0};
-        cfg.sample_rate = sample_rate;
-        cfg.src_ch = src_ch;
-        cfg.dest_ch = dest_ch;
-        cfg.bits_per_sample = bit[i];
-        cfg.weight = weight;
-        cfg.weight_len = dest_ch * src_ch;
-        in_num = 512;
-        out_num = 512;
-        in_buf = calloc(1, in_num * src_ch * (bit[i] >> 3));
-        TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-        out_buf = calloc(1, out_num * dest_ch * (bit[i] >> 3));
-        TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-        start_mem_cnt();
-        int ret = esp_ae_ch_cvt_open(&cfg, &ch_hd);
-        TEST_ASSERT_NOT_EQUAL(ch_hd, NULL);
-        (void)ret;
-        diff = 0;
-        sample_cnt = 0;
-        while (cnt <= 2000) {
-            wrap_read(in_buf, in_num * src_ch, bit[i]);
-            st = esp_timer_get_time();
-            esp_ae_ch_cvt_process(ch_hd, in_num, in_buf, out_buf);
-            et = esp_timer_get_time();
-            diff += et - st;
-            sample_cnt += in_num;
-            cnt++;
-        }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "chcvt: bit:%d, ratio:%02f", bit[i], (double)diff / (duration * 10));
-        esp_ae_ch_cvt_close(ch_hd);
-        end_mem_cnt();
-        free(in_buf);
-        free(out_buf);
+    esp_ae_sample_t in[AE_PERF_MIX_BUS_SRC_NUM] = {ctx->in, ctx->in, ctx->in, ctx->in};
+    return esp_ae_mix_bus_process(ctx->handle, ctx->block, in, ctx->out);
+}
+
+static esp_ae_err_t perf_mix_bus_deintlv_process(ae_perf_ctx_t *ctx)
+{
+    esp_ae_sample_t *in[AE_PERF_MIX_BUS_SRC_NUM] = {ctx->in_ch, ctx->in_ch, ctx->in_ch, ctx->in_ch};
+    return esp_ae_mix_bus_deintlv_process(ctx->handle, ctx->block, in, ctx->out_ch);
+}
+
+static void perf_mix_bus_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_mix_bus_close(ctx->handle);
+}
+
+#if AE_PERF_PREBUILT
+static esp_ae_err_t perf_rate_cvt_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_rate_cvt_cfg_t cfg = {
+        .src_rate = ctx->sample_rate,
+        .dest_rate = ctx->sample_rate == 48000 ? 44100 : 48000,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .complexity = 2,
+        .perf_type = ESP_AE_RATE_CVT_PERF_TYPE_SPEED,
+    };
+    return esp_ae_rate_cvt_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_rate_cvt_process(ae_perf_ctx_t *ctx)
+{
+    uint32_t out_num = AE_PERF_MAX_BLOCK * AE_PERF_OUT_FACTOR;
+    return esp_ae_rate_cvt_process(ctx->handle, ctx->in, ctx->block, ctx->out, &out_num);
+}
+
+static esp_ae_err_t perf_rate_cvt_deintlv_process(ae_perf_ctx_t *ctx)
+{
+    uint32_t out_num = AE_PERF_MAX_BLOCK * AE_PERF_OUT_FACTOR;
+    return esp_ae_rate_cvt_deintlv_process(ctx->handle, ctx->in_ch, ctx->block, ctx->out_ch, &out_num);
+}
+
+static void perf_rate_cvt_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_rate_cvt_close(ctx->handle);
+}
+#endif  /* AE_PERF_PREBUILT */
+
+static esp_ae_err_t perf_async_src_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_async_src_cfg_t cfg = {
+        .src_rate = ctx->sample_rate,
+        .dest_rate = ctx->sample_rate == 48000 ? 44100 : 48000,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .complexity = 2,
+    };
+    esp_ae_err_t ret = esp_ae_async_src_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_async_src_set_ratio_ppm(ctx->handle, 500.0f);
     }
-    media_lib_stop_mem_trace();
+    return ret;
 }
 
-TEST_CASE("Eq performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_async_src_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "eq test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int i = 0; i < 3; i++) {
-        void *eq_hd = NULL;
-        char *in_buf = NULL;
-        char *out_buf = NULL;
-        int cnt = 0;
-        int in_num = 0;
-        int out_num = 0;
-        // config
-        esp_ae_eq_cfg_t *cfg = calloc(1, sizeof(esp_ae_eq_cfg_t));
-        TEST_ASSERT_NOT_EQUAL(cfg, NULL);
-        cfg->bits_per_sample = bit[i];
-        cfg->sample_rate = sample_rate;
-        cfg->channel = channel;
-        cfg->filter_num = 1;
-        cfg->para = calloc(1, sizeof(esp_ae_eq_filter_para_t) * cfg->filter_num);
-        TEST_ASSERT_NOT_EQUAL(cfg->para, NULL);
-        cfg->para->filter_type = ESP_AE_EQ_FILTER_PEAK;
-        if (cfg->para->filter_type == ESP_AE_EQ_FILTER_HIGH_PASS
-            || cfg->para->filter_type == ESP_AE_EQ_FILTER_LOW_PASS) {
-            cfg->para->fc = 2000;
-            cfg->para->q = 1.0;
-        } else {
-            cfg->para->fc = 2000;
-            cfg->para->q = 1.0;
-            cfg->para->gain = 5.0;
-        }
-        // create handle
-        start_mem_cnt();
-        int ret = esp_ae_eq_open(cfg, &eq_hd);
-        TEST_ASSERT_NOT_EQUAL(eq_hd, NULL);
-        (void)ret;
-        in_num = 512;
-        out_num = 512;
-        in_buf = calloc(1, in_num * channel * (bit[i] >> 3));
-        TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-        out_buf = calloc(1, out_num * channel * (bit[i] >> 3));
-        TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-        diff = 0;
-        sample_cnt = 0;
-        while (cnt <= 2000) {
-            wrap_read(in_buf, in_num * channel, bit[i]);
-            st = esp_timer_get_time();
-            esp_ae_eq_process(eq_hd, in_num, in_buf, out_buf);
-            et = esp_timer_get_time();
-            diff += et - st;
-            sample_cnt += in_num;
-            cnt++;
-        }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "eq: bit:%d, ratio:%02f", bit[i], (double)diff / (duration * 10));
-        esp_ae_eq_close(eq_hd);
-        end_mem_cnt();
-        free(in_buf);
-        free(out_buf);
-        if (cfg != NULL) {
-            if (cfg->para != NULL) {
-                free(cfg->para);
-            }
-            free(cfg);
-        }
+    uint32_t out_num = AE_PERF_MAX_BLOCK * AE_PERF_OUT_FACTOR;
+    return esp_ae_async_src_process(ctx->handle, ctx->in, ctx->block, ctx->out, &out_num);
+}
+
+static esp_ae_err_t perf_async_src_deintlv_process(ae_perf_ctx_t *ctx)
+{
+    uint32_t out_num = AE_PERF_MAX_BLOCK * AE_PERF_OUT_FACTOR;
+    return esp_ae_async_src_deintlv_process(ctx->handle, ctx->in_ch, ctx->block, ctx->out_ch, &out_num);
+}
+
+static void perf_async_src_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_async_src_close(ctx->handle);
+}
+
+#if AE_PERF_PREBUILT
+static esp_ae_err_t perf_sonic_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_sonic_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+    };
+    esp_ae_err_t ret = esp_ae_sonic_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_sonic_set_speed(ctx->handle, 1.5f);
+    }
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_sonic_set_pitch(ctx->handle, 1.25f);
     }
-    media_lib_stop_mem_trace();
+    return ret;
 }
 
-TEST_CASE("Fade performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_sonic_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "fade test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 3; k++) {
-        esp_ae_fade_handle_t fade_hd = NULL;
-        char *in_buf = NULL;
-        char *out_buf = NULL;
-        int cnt = 0;
-        int in_num = 0;
-        int out_num = 0;
-        // config
-        esp_ae_fade_cfg_t cfg = {0};
-        cfg.mode = ESP_AE_FADE_MODE_FADE_IN;
-        cfg.curve = ESP_AE_FADE_CURVE_QUAD;
-        cfg.transit_time = 120000;
-        cfg.sample_rate = sample_rate;
-        cfg.channel = channel;
-        cfg.bits_per_sample = bit[k];
-        // create handle
-        start_mem_cnt();
-        int ret = esp_ae_fade_open(&cfg, &fade_hd);
-        TEST_ASSERT_NOT_EQUAL(fade_hd, NULL);
-        // allocate buffer
-        in_num = 512;
-        out_num = 512;
-        in_buf = calloc(1, in_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-        out_buf = calloc(1, out_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-        diff = 0;
-        sample_cnt = 0;
-        // process
-        while (cnt <= 2000) {
-            wrap_read(in_buf, in_num * channel, bit[k]);
-            st = esp_timer_get_time();
-            ret = esp_ae_fade_process(fade_hd, in_num, in_buf, out_buf);
-            et = esp_timer_get_time();
-            diff += et - st;
-            sample_cnt += in_num;
-            cnt++;
+    uint32_t frame_size = ctx->channel * (ctx->bits >> 3);
+    esp_ae_sonic_in_data_t in = {.samples = ctx->in, .num = ctx->block};
+    esp_ae_sonic_out_data_t out = {.samples = ctx->out, .needed_num = AE_PERF_MAX_BLOCK * AE_PERF_OUT_FACTOR};
+    while (in.num > 0) {
+        esp_ae_err_t ret = esp_ae_sonic_process(ctx->handle, &in, &out);
+        if (ret != ESP_AE_ERR_OK || (in.consume_num == 0 && out.out_num == 0)) {
+            return ret;
         }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "fade: bit:%d, ratio:%02f", bit[k], (double)diff / (duration * 10));
-        // deinit
-        esp_ae_fade_close(fade_hd);
-        end_mem_cnt();
-        free(in_buf);
-        free(out_buf);
+        in.samples = (uint8_t *)in.samples + in.consume_num * frame_size;
+        in.num -= in.consume_num;
     }
-    media_lib_stop_mem_trace();
+    return ESP_AE_ERR_OK;
 }
 
-TEST_CASE("Mixer performance test", "AUDIO_EFFECT")
+static void perf_sonic_close(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "mixer test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int i = 0; i < 3; i++) {
-        int cnt = 0;
-        int in_num = 0;
-        int out_num = 0;
-        void *downmix_hd = NULL;
-        // config
-        esp_ae_mixer_info_t source_info[2] = {0};
-        esp_ae_mixer_info_t info1 = {
-            .weight1 = 0.0,
-            .weight2 = 1.0,
-            .transit_time = 12000,
-        };
-        source_info[0] = info1;
-        esp_ae_mixer_info_t info2 = {
-            .weight1 = 0.0,
-            .weight2 = 1.0,
-            .transit_time = 12000,
-        };
-        source_info[1] = info2;
-        esp_ae_mixer_cfg_t cfg;
-        cfg.sample_rate = sample_rate,
-        cfg.channel = channel,
-        cfg.bits_per_sample = bit[i],
-        cfg.src_info = source_info;
-        cfg.src_num = 2;
-        // create handle
-        start_mem_cnt();
-        int ret = esp_ae_mixer_open(&cfg, &downmix_hd);
-        TEST_ASSERT_NOT_EQUAL(downmix_hd, NULL);
-        // allocate buffer
-        in_num = 512;
-        out_num = 512;
-        unsigned char *inbuf1 = heap_caps_aligned_calloc(16, 1, in_num * channel * (bit[i] >> 3), MALLOC_CAP_SPIRAM);
-        TEST_ASSERT_NOT_EQUAL(inbuf1, NULL);
-        unsigned char *inbuf2 = heap_caps_aligned_calloc(16, 1, in_num * channel * (bit[i] >> 3), MALLOC_CAP_SPIRAM);
-        TEST_ASSERT_NOT_EQUAL(inbuf2, NULL);
-        unsigned char *in[3];
-        in[0] = inbuf1;
-        in[1] = inbuf2;
-        unsigned char *outbuf = heap_caps_aligned_calloc(16, 1, out_num * channel * (bit[i] >> 3), MALLOC_CAP_SPIRAM);
-        TEST_ASSERT_NOT_EQUAL(outbuf, NULL);
-        diff = 0;
-        sample_cnt = 0;
-        esp_ae_mixer_set_mode(downmix_hd, 0, ESP_AE_MIXER_MODE_FADE_UPWARD);
-        esp_ae_mixer_set_mode(downmix_hd, 1, ESP_AE_MIXER_MODE_FADE_UPWARD);
-        while (cnt <= 200) {
-            wrap_read(inbuf1, in_num * channel, bit[i]);
-            wrap_read(inbuf2, in_num * channel, bit[i]);
-            st = esp_timer_get_time();
-            ret = esp_ae_mixer_process(downmix_hd, in_num, (void **)in, outbuf);
-            et = esp_timer_get_time();
-            diff += et - st;
-            sample_cnt += in_num;
-            cnt++;
-        }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "mixer: bit:%d, ratio:%02f", bit[i], (double)diff / (duration * 10));
-        esp_ae_mixer_close(downmix_hd);
-        end_mem_cnt();
-        free(inbuf1);
-        free(inbuf2);
-        free(outbuf);
+    esp_ae_sonic_close(ctx->handle);
+}
+
+static esp_ae_err_t perf_drc_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_drc_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .drc_para = AE_PERF_DRC_PARA,
+    };
+    return esp_ae_drc_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_mbc_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_mbc_config_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .fc = {200, 2000, 3000},
+        .mbc_para = {
+            {.threshold = -20.0f, .ratio = 3.0f, .makeup_gain = 2.0f, .attack_time = 10, .release_time = 100, .hold_time = 5, .knee_width = 2.0f},
+            {.threshold = -15.0f, .ratio = 2.5f, .makeup_gain = 1.5f, .attack_time = 5, .release_time = 80, .hold_time = 3, .knee_width = 1.5f},
+            {.threshold = -10.0f, .ratio = 2.0f, .makeup_gain = 1.0f, .attack_time = 3, .release_time = 60, .hold_time = 2, .knee_width = 1.0f},
+            {.threshold = -25.0f, .ratio = 4.0f, .makeup_gain = 3.0f, .attack_time = 15, .release_time = 120, .hold_time = 8, .knee_width = 2.5f},
+        },
+    };
+    return esp_ae_mbc_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_howl_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_howl_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .papr_th = 10.0f,
+        .phpr_th = 45.0f,
+        .pnpr_th = 45.0f,
+        .imsd_th = 10.0f,
+        .enable_imsd = false,
+    };
+    uint32_t frame_size = 0;
+    esp_ae_err_t ret = esp_ae_howl_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_howl_get_frame_size(ctx->handle, &frame_size);
+        ctx->block = frame_size / (ctx->channel * (ctx->bits >> 3));
     }
-    media_lib_stop_mem_trace();
+    return ret;
 }
 
-TEST_CASE("Rsp performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_howl_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "rsp test");
-    media_lib_add_default_adapter();
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    int in_rate[20] = {8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000, 64000, 88200, 96000};
-    int out_rate[20] = {8000, 11025, 12000, 16000, 22050, 24000, 32000, 44100, 48000, 64000, 88200, 96000};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 3; k++) {
-        for (int i = 0; i < 12; i++) {
-            for (int j = 0; j < 12; j++) {
-                for (int l = 1; l <= 3; l++) {
-                    int complexity = l;
-                    void *rsp_hd = NULL;
-                    char *in_buf = NULL;
-                    char *out_buf = NULL;
-                    int cnt = 0;
-                    uint32_t in_num = 0;
-                    uint32_t out_num = 0;
-                    uint32_t out_samples = 0;
-                    // config
-                    esp_ae_rate_cvt_cfg_t cfg;
-                    cfg.bits_per_sample = bit[k];
-                    cfg.src_rate = in_rate[i];
-                    cfg.dest_rate = out_rate[j];
-                    cfg.channel = channel;
-                    cfg.complexity = complexity;
-                    start_mem_cnt();
-                    int ret = esp_ae_rate_cvt_open(&cfg, &rsp_hd);
-                    TEST_ASSERT_NOT_EQUAL(rsp_hd, NULL);
-                    // create buffer
-                    in_num = 512;
-                    in_buf = calloc(1, in_num * channel * (bit[k] >> 3));
-                    TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-                    esp_ae_rate_cvt_get_max_out_sample_num(rsp_hd, in_num, &out_num);
-                    out_buf = calloc(1, out_num * channel * (bit[k] >> 3));
-                    TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-                    diff = 0;
-                    sample_cnt = 0;
-                    while (cnt <= 2000) {
-                        wrap_read(in_buf, in_num * channel, bit[k]);
-                        out_samples = out_num;
-                        st = esp_timer_get_time();
-                        ret = esp_ae_rate_cvt_process(rsp_hd, in_buf, in_num, out_buf, &out_samples);
-                        et = esp_timer_get_time();
-                        diff += et - st;
-                        sample_cnt += in_num;
-                        cnt++;
-                    }
-                    uint64_t duration = 1000.0 * (double)sample_cnt / (double)cfg.src_rate;
-                    ESP_LOGI(TAG, "rsp: src_rate:%d, dest_rate:%d, bit:%d, com:%d, ratio:%02f",
-                           in_rate[i], out_rate[j], bit[k], complexity, (double)diff / (duration * 10));
-                    esp_ae_rate_cvt_close(rsp_hd);
-                    end_mem_cnt();
-                    free(in_buf);
-                    free(out_buf);
-                }
-            }
-        }
+    return esp_ae_howl_process(ctx->handle, ctx->in, ctx->out);
+}
+
+static esp_ae_err_t perf_howl_deintlv_process(ae_perf_ctx_t *ctx)
+{
+    return esp_ae_howl_deintlv_process(ctx->handle, ctx->in_ch, ctx->out_ch);
+}
+
+static void perf_howl_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_howl_close(ctx->handle);
+}
+
+static esp_ae_err_t perf_reverb_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_reverb_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .reverb_para = {
+            .room_size = 0.5f,
+            .damping = 0.5f,
+            .wet_level = -6.0f,
+            .dry_level = 0.0f,
+            .pre_delay_ms = 10,
+        },
+    };
+    return esp_ae_reverb_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_delay_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_delay_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .max_delay_ms = 500,
+        .delay_para = {
+            .delay_time_ms = 250,
+            .feedback = 0.5f,
+            .mix = 0.35f,
+        },
+    };
+    return esp_ae_delay_open(&cfg, &ctx->handle);
+}
+#endif  /* AE_PERF_PREBUILT */
+
+#define AE_PERF_CONV_IR_LEN (4096)
+
+static esp_ae_err_t perf_conv_open(ae_perf_ctx_t *ctx)
+{
+    // Decaying noise IR, only needed during open
+    float *ir_data = (float *)malloc(AE_PERF_CONV_IR_LEN * sizeof(float));
+    if (ir_data == NULL) {
+        return ESP_AE_ERR_MEM_LACK;
     }
-    media_lib_stop_mem_trace();
+    uint32_t seed = 0x5678;
+    for (int i = 0; i < AE_PERF_CONV_IR_LEN; i++) {
+        seed = seed * 1664525 + 1013904223;
+        ir_data[i] = 0.05f * (float)(int32_t)seed / 2147483648.0f * expf(-5.0f * i / AE_PERF_CONV_IR_LEN);
+    }
+    const float *ir[1] = {ir_data};
+    esp_ae_conv_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .partition_size = 256,
+        .ir = ir,
+        .ir_channel = 1,
+        .ir_len = AE_PERF_CONV_IR_LEN,
+        .dry_gain = 1.0f,
+        .wet_gain = 0.5f,
+    };
+    esp_ae_err_t ret = esp_ae_conv_open(&cfg, &ctx->handle);
+    free(ir_data);
+    return ret;
 }
 
-TEST_CASE("Sonic performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_limiter_open(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "sonic test");
-    media_lib_add_default_adapter();
-    float para[6] = {0.5, 0.75, 1.25, 1.5, 1.75, 2.0};
-    int sample_rate = 8000;
-    int channel = 1;
-    int mode[2] = {1, 2};
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 2; k++) {
-        for (int j = 0; j < 3; j++) {
-            for (int i = 0; i < 6; i++) {
-                int cnt = 0;
-                esp_ae_sonic_in_data_t in_samples = {0};
-                esp_ae_sonic_out_data_t out_samples = {0};
-                int in_num = 0;
-                int out_num = 0;
-                short *inbuf = NULL;
-                short *outbuf = NULL;
-                void *sonic_handle = NULL;
-                int ret = 0;
-                // config
-                esp_ae_sonic_cfg_t cfg = {0};
-                cfg.sample_rate = sample_rate;
-                cfg.channel = channel;
-                cfg.bits_per_sample = bit[j];
-                // buffer allocate
-                in_num = 512;
-                out_num = 512;
-                inbuf = calloc(1, in_num * channel * (bit[j] >> 3));
-                TEST_ASSERT_NOT_EQUAL(inbuf, NULL);
-                outbuf = calloc(1, out_num * channel * (bit[j] >> 3));
-                TEST_ASSERT_NOT_EQUAL(outbuf, NULL);
-                in_samples.samples = inbuf;
-                out_samples.samples = outbuf;
-                // create handle
-                start_mem_cnt();
-                esp_ae_sonic_open(&cfg, &sonic_handle);
-                TEST_ASSERT_NOT_EQUAL(sonic_handle, NULL);
-                // para set
-                if (mode[k] == 1) {
-                    esp_ae_sonic_set_speed(sonic_handle, para[i]);
-                } else if (mode[k] == 2) {
-                    esp_ae_sonic_set_pitch(sonic_handle, para[i]);
-                }
-                while (cnt <= 2000) {
-                    int in_read = in_num * channel * (bit[j] >> 3);
-                    wrap_read(inbuf, in_num * channel, bit[j]);
-                    int sample_num = in_read / (channel * (bit[j] >> 3));
-                    int remain_num = sample_num;
-                    in_samples.samples = inbuf;
-                    in_samples.num = sample_num;
-                    out_samples.needed_num = 512;
-                    diff = 0;
-                    sample_cnt = 0;
-                    sample_cnt += in_num;
-                    while (remain_num > 0 || out_samples.out_num > 0) {
-                        st = esp_timer_get_time();
-                        ret = esp_ae_sonic_process(sonic_handle, &in_samples, &out_samples);
-                        et = esp_timer_get_time();
-                        diff += et - st;
-                        if (ret != 0) {
-                            ESP_LOGI(TAG, "error");
-                            break;
-                        }
-                        short *in = inbuf + in_samples.consume_num;
-                        remain_num -= in_samples.consume_num;
-                        in_samples.num = remain_num;
-                        in_samples.samples = in;
-                    }
-                    cnt++;
-                }
-                uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-                ESP_LOGI(TAG, "sonic: bit:%d, mode:%d, para:%02f, ratio:%02f",
-                       bit[j], mode[k], para[i], (double)diff / (duration * 10));
-                esp_ae_sonic_close(sonic_handle);
-                end_mem_cnt();
-                free(inbuf);
-                inbuf = NULL;
-                free(outbuf);
-                outbuf = NULL;
-            }
-        }
+    esp_ae_limiter_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .detect_mode = ESP_AE_LIMITER_DETECT_TRUE_PEAK,
+        .lookahead_ms = 1.5f,
+        .ceiling_db = -3.0f,
+        .release_ms = 50.0f,
+    };
+    return esp_ae_limiter_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_aec_open(ae_perf_ctx_t *ctx)
+{
+    // Microphone and reference are mono
+    if (ctx->channel != 1) {
+        return ESP_AE_ERR_NOT_SUPPORT;
     }
-    media_lib_stop_mem_trace();
+    esp_ae_aec_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .bits_per_sample = ctx->bits,
+        .filter_ms = 128,
+        .max_delay_ms = 200,
+        .enable_nlp = true,
+    };
+    uint32_t frame_size = 0;
+    esp_ae_err_t ret = esp_ae_aec_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_aec_get_frame_size(ctx->handle, &frame_size);
+        ctx->block = frame_size / (ctx->bits >> 3);
+    }
+    return ret;
 }
 
-TEST_CASE("DRC performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_aec_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "drc test");
-    media_lib_add_default_adapter();
-    int sample_rate = 8000;
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 3; k++) {
-        void *drc_hd = NULL;
-        char *in_buf = NULL;
-        char *out_buf = NULL;
-        int cnt = 0;
-        int in_num = 512;
-        int out_num = 512;
-
-        // DRC configuration
-        esp_ae_drc_cfg_t cfg = {0};
-        cfg.sample_rate = sample_rate;
-        cfg.channel = channel;
-        cfg.bits_per_sample = bit[k];
-        esp_ae_drc_curve_point points[3] = {
-            { -100.0f, -100.0f },
-            { -20.0f,  -30.0f  },
-            {   0.0f,    0.0f  },
-        };
-        cfg.drc_para.point = points;
-        cfg.drc_para.point_num = 3;
-        cfg.drc_para.makeup_gain = 0.0f;
-        cfg.drc_para.knee_width = 1.0f;
-        cfg.drc_para.attack_time = 10;
-        cfg.drc_para.release_time = 80;
-        cfg.drc_para.hold_time = 3;
-
-        start_mem_cnt();
-        int ret = esp_ae_drc_open(&cfg, (esp_ae_drc_handle_t *)&drc_hd);
-        TEST_ASSERT_NOT_EQUAL(drc_hd, NULL);
-
-        in_buf = calloc(1, in_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-        out_buf = calloc(1, out_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-
-        diff = 0;
-        sample_cnt = 0;
-        while (cnt <= 2000) {
-            wrap_read(in_buf, in_num * channel, bit[k]);
-            sample_cnt += in_num;
-            st = esp_timer_get_time();
-            ret = esp_ae_drc_process((esp_ae_drc_handle_t)drc_hd, in_num, (void *)in_buf, (void *)out_buf);
-            et = esp_timer_get_time();
-            TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-            diff += et - st;
-            cnt++;
-        }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "drc: bit:%d, ratio:%02f, duration:%02f", bit[k], (double)diff / (duration * 10), duration);
-        esp_ae_drc_close((esp_ae_drc_handle_t)drc_hd);
-        end_mem_cnt();
-        free(in_buf);
-        free(out_buf);
+    // The reference is the noise right after the microphone frame
+    return esp_ae_aec_process(ctx->handle, ctx->in, ctx->in + ctx->block * (ctx->bits >> 3), ctx->out);
+}
+
+static void perf_aec_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_aec_close(ctx->handle);
+}
+
+static esp_ae_err_t perf_ns_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_ns_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .suppress_db = -20.0f,
+    };
+    uint32_t frame_size = 0;
+    esp_ae_err_t ret = esp_ae_ns_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_ns_get_frame_size(ctx->handle, &frame_size);
+        ctx->block = frame_size / (ctx->channel * (ctx->bits >> 3));
     }
-    media_lib_stop_mem_trace();
+    return ret;
 }
 
-TEST_CASE("MBC performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_ns_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "mbc test");
-    media_lib_add_default_adapter();
-    int sample_rate = 48000;
-    int channel = 1;
-    int bit[3] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int k = 0; k < 3; k++) {
-        void *mbc_hd = NULL;
-        char *in_buf = NULL;
-        char *out_buf = NULL;
-        int cnt = 0;
-        int in_num = 512;
-        int out_num = 512;
-
-        // MBC configuration
-        esp_ae_mbc_config_t cfg = {0};
-        cfg.sample_rate = sample_rate;
-        cfg.channel = channel;
-        cfg.bits_per_sample = bit[k];
-        cfg.fc[0] = 200;   // low_fc
-        cfg.fc[1] = 2000;  // mid_fc
-        cfg.fc[2] = 3000;  // high_fc
-        // Low band
-        cfg.mbc_para[0].threshold = -20.0f;
-        cfg.mbc_para[0].ratio = 3.0f;
-        cfg.mbc_para[0].makeup_gain = 2.0f;
-        cfg.mbc_para[0].attack_time = 10;
-        cfg.mbc_para[0].release_time = 100;
-        cfg.mbc_para[0].hold_time = 5;
-        cfg.mbc_para[0].knee_width = 2.0f;
-        // Low-Mid band
-        cfg.mbc_para[1].threshold = -15.0f;
-        cfg.mbc_para[1].ratio = 2.5f;
-        cfg.mbc_para[1].makeup_gain = 1.5f;
-        cfg.mbc_para[1].attack_time = 5;
-        cfg.mbc_para[1].release_time = 80;
-        cfg.mbc_para[1].hold_time = 3;
-        cfg.mbc_para[1].knee_width = 1.5f;
-        // Mid-High band
-        cfg.mbc_para[2].threshold = -10.0f;
-        cfg.mbc_para[2].ratio = 2.0f;
-        cfg.mbc_para[2].makeup_gain = 1.0f;
-        cfg.mbc_para[2].attack_time = 3;
-        cfg.mbc_para[2].release_time = 60;
-        cfg.mbc_para[2].hold_time = 2;
-        cfg.mbc_para[2].knee_width = 1.0f;
-        // High band
-        cfg.mbc_para[3].threshold = -25.0f;
-        cfg.mbc_para[3].ratio = 4.0f;
-        cfg.mbc_para[3].makeup_gain = 3.0f;
-        cfg.mbc_para[3].attack_time = 15;
-        cfg.mbc_para[3].release_time = 120;
-        cfg.mbc_para[3].hold_time = 8;
-        cfg.mbc_para[3].knee_width = 2.5f;
-
-        start_mem_cnt();
-        int ret = esp_ae_mbc_open(&cfg, (esp_ae_mbc_handle_t *)&mbc_hd);
-        TEST_ASSERT_NOT_EQUAL(mbc_hd, NULL);
-
-        in_buf = calloc(1, in_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-        out_buf = calloc(1, out_num * channel * (bit[k] >> 3));
-        TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-
-        diff = 0;
-        sample_cnt = 0;
-        while (cnt <= 2000) {
-            wrap_read(in_buf, in_num * channel, bit[k]);
-            sample_cnt += in_num;
-            st = esp_timer_get_time();
-            ret = esp_ae_mbc_process((esp_ae_mbc_handle_t)mbc_hd, in_num, (void *)in_buf, (void *)out_buf);
-            et = esp_timer_get_time();
-            TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-            diff += et - st;
-            cnt++;
-        }
-        uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate;
-        ESP_LOGI(TAG, "mbc: bit:%d, ratio:%02f, duration:%02f", bit[k], (double)diff / (duration * 10), duration);
-        esp_ae_mbc_close((esp_ae_mbc_handle_t)mbc_hd);
-        end_mem_cnt();
-        free(in_buf);
-        free(out_buf);
+    return esp_ae_ns_process(ctx->handle, ctx->in, ctx->out);
+}
+
+static esp_ae_err_t perf_ns_deintlv_process(ae_perf_ctx_t *ctx)
+{
+    return esp_ae_ns_deintlv_process(ctx->handle, ctx->in_ch, ctx->out_ch);
+}
+
+static void perf_ns_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_ns_close(ctx->handle);
+}
+
+static esp_ae_err_t perf_loudness_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_loudness_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .mode = ESP_AE_LOUDNESS_MODE_NORMALIZE,
+        .target_lufs = -16.0f,
+        .max_gain_db = 12.0f,
+        .response_ms = 3000.0f,
+    };
+    return esp_ae_loudness_open(&cfg, &ctx->handle);
+}
+
+static esp_ae_err_t perf_mbc_n_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_mbc_n_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .band_num = 4,
+        .crossover = ESP_AE_MBC_N_CROSSOVER_IIR,
+        .fc = {200, 2000, 3000},
+        .mbc_para = {
+            {.threshold = -20.0f, .ratio = 3.0f, .makeup_gain = 2.0f, .attack_time = 10, .release_time = 100, .hold_time = 5, .knee_width = 2.0f},
+            {.threshold = -15.0f, .ratio = 2.5f, .makeup_gain = 1.5f, .attack_time = 5, .release_time = 80, .hold_time = 3, .knee_width = 1.5f},
+            {.threshold = -10.0f, .ratio = 2.0f, .makeup_gain = 1.0f, .attack_time = 3, .release_time = 60, .hold_time = 2, .knee_width = 1.0f},
+            {.threshold = -25.0f, .ratio = 4.0f, .makeup_gain = 3.0f, .attack_time = 15, .release_time = 120, .hold_time = 8, .knee_width = 2.5f},
+        },
+    };
+    return esp_ae_mbc_n_open(&cfg, &ctx->handle);
+}
+
+#if AE_PERF_PREBUILT
+static esp_ae_err_t perf_chain_open(ae_perf_ctx_t *ctx)
+{
+    esp_ae_eq_cfg_t eq_cfg = {
+        .filter_num = sizeof(perf_eq_para) / sizeof(perf_eq_para[0]),
+        .para = perf_eq_para,
+    };
+    esp_ae_drc_cfg_t drc_cfg = {
+        .drc_para = AE_PERF_DRC_PARA,
+    };
+    esp_ae_chain_stage_t stages[] = {
+        {.type = ESP_AE_CHAIN_STAGE_EQ, .cfg = &eq_cfg},
+        {.type = ESP_AE_CHAIN_STAGE_DRC, .cfg = &drc_cfg},
+        {.type = ESP_AE_CHAIN_STAGE_ALC, .cfg = NULL},
+    };
+    esp_ae_chain_cfg_t cfg = {
+        .sample_rate = ctx->sample_rate,
+        .channel = ctx->channel,
+        .bits_per_sample = ctx->bits,
+        .stages = stages,
+        .stage_num = sizeof(stages) / sizeof(stages[0]),
+    };
+    void *eq = NULL;
+    esp_ae_err_t ret = esp_ae_chain_open(&cfg, &ctx->handle);
+    if (ret == ESP_AE_ERR_OK) {
+        ret = esp_ae_chain_get_stage_handle(ctx->handle, 0, &eq);
     }
-    media_lib_stop_mem_trace();
+    for (int i = 0; ret == ESP_AE_ERR_OK && i < eq_cfg.filter_num; i++) {
+        ret = esp_ae_eq_enable_filter(eq, i);
+    }
+    return ret;
 }
 
-TEST_CASE("Howl performance test", "AUDIO_EFFECT")
+static esp_ae_err_t perf_chain_process(ae_perf_ctx_t *ctx)
 {
-    ESP_LOGI(TAG, "howl test");
-    media_lib_add_default_adapter();
-    int sample_rate[] = {8000, 16000, 48000};
-    int channel[] = {1, 2};
-    int bit[] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    bool enable_imsd[] = {false, true};
-    for (int sr_i = 0; sr_i < 3; sr_i++) {
-        for (int ch_i = 0; ch_i < 2; ch_i++) {
-            for (int b_i = 0; b_i < 3; b_i++) {
-                for (int imsd_i = 0; imsd_i < 2; imsd_i++) {
-                esp_ae_howl_handle_t howl_hd = NULL;
-                char *in_buf = NULL;
-                char *out_buf = NULL;
-                int cnt = 0;
-                uint32_t frame_size = 0;
-                esp_ae_howl_cfg_t cfg;
-
-                memset(&cfg, 0, sizeof(cfg));
-                cfg.sample_rate = (uint32_t)sample_rate[sr_i];
-                cfg.channel = (uint8_t)channel[ch_i];
-                cfg.bits_per_sample = (uint8_t)bit[b_i];
-                cfg.papr_th = 10.0f;
-                cfg.phpr_th = 45.0f;
-                cfg.pnpr_th = 45.0f;
-                cfg.imsd_th = 10.0f;
-                cfg.enable_imsd = enable_imsd[imsd_i];
-
-                start_mem_cnt();
-                int ret = esp_ae_howl_open(&cfg, &howl_hd);
-                TEST_ASSERT_NOT_EQUAL(howl_hd, NULL);
-                ret = esp_ae_howl_get_frame_size(howl_hd, &frame_size);
-                TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-                TEST_ASSERT_GREATER_THAN(0, frame_size);
-
-                in_buf = calloc(1, frame_size);
-                out_buf = calloc(1, frame_size);
-                TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-                TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-
-                int bytes_per_sample = bit[b_i] >> 3;
-                int samples_total_per_frame = (int)(frame_size / (unsigned)bytes_per_sample);
-                int block_len = samples_total_per_frame / channel[ch_i];
-
-                diff = 0;
-                sample_cnt = 0;
-                while (cnt <= 2000) {
-                    wrap_read(in_buf, samples_total_per_frame, bit[b_i]);
-                    sample_cnt += block_len;
-                    st = esp_timer_get_time();
-                    ret = esp_ae_howl_process(howl_hd, in_buf, out_buf);
-                    et = esp_timer_get_time();
-                    TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-                    diff += et - st;
-                    cnt++;
-                }
-                uint64_t duration = 1000.0 * (double)sample_cnt / (double)cfg.sample_rate;
-                ESP_LOGI(TAG, "howl: enable_imsd:%d sr:%"PRIu32" ch:%d bit:%d ratio:%02f",
-                         enable_imsd[imsd_i], cfg.sample_rate, cfg.channel, cfg.bits_per_sample,
-                         (double)diff / (duration * 10));
-                esp_ae_howl_close(howl_hd);
-                end_mem_cnt();
-                free(in_buf);
-                free(out_buf);
-                }
-            }
-        }
+    return esp_ae_chain_process(ctx->handle, ctx->block, ctx->in, ctx->out);
+}
+
+static void perf_chain_close(ae_perf_ctx_t *ctx)
+{
+    esp_ae_chain_close(ctx->handle);
+}
+#endif  /* AE_PERF_PREBUILT */
+
+static const ae_perf_module_t perf_modules[] = {
+#if AE_PERF_PREBUILT
+    {"alc", perf_alc_open, perf_alc_process, perf_alc_deintlv_process, perf_alc_close},
+    {"bit_cvt", perf_bit_cvt_open, perf_bit_cvt_process, perf_bit_cvt_deintlv_process, perf_bit_cvt_close},
+    {"ch_cvt", perf_ch_cvt_open, perf_ch_cvt_process, perf_ch_cvt_deintlv_process, perf_ch_cvt_close},
+    {"data_weaver", NULL, perf_data_weaver_process, perf_data_weaver_deintlv_process, NULL},
+    {"eq", perf_eq_open, perf_eq_process, perf_eq_deintlv_process, perf_eq_close},
+    {"fade", perf_fade_open, perf_fade_process, perf_fade_deintlv_process, perf_fade_close},
+    {"mixer", perf_mixer_open, perf_mixer_process, perf_mixer_deintlv_process, perf_mixer_close},
+#endif  /* AE_PERF_PREBUILT */
+    {"mix_bus", perf_mix_bus_open, perf_mix_bus_process, perf_mix_bus_deintlv_process, perf_mix_bus_close},
+#if AE_PERF_PREBUILT
+    {"rate_cvt", perf_rate_cvt_open, perf_rate_cvt_process, perf_rate_cvt_deintlv_process, perf_rate_cvt_close},
+#endif  /* AE_PERF_PREBUILT */
+    {"async_src", perf_async_src_open, perf_async_src_process, perf_async_src_deintlv_process, perf_async_src_close},
+#if AE_PERF_PREBUILT
+    {"sonic", perf_sonic_open, perf_sonic_process, NULL, perf_sonic_close},
+    {"drc", perf_drc_open, perf_drc_process, perf_drc_deintlv_process, perf_drc_close},
+    {"mbc", perf_mbc_open, perf_mbc_process, perf_mbc_deintlv_process, perf_mbc_close},
+    {"howl", perf_howl_open, perf_howl_process, perf_howl_deintlv_process, perf_howl_close},
+    {"reverb", perf_reverb_open, perf_reverb_process, perf_reverb_deintlv_process, perf_reverb_close},
+    {"delay", perf_delay_open, perf_delay_process, perf_delay_deintlv_process, perf_delay_close},
+#endif  /* AE_PERF_PREBUILT */
+    {"conv", perf_conv_open, perf_conv_process, perf_conv_deintlv_process, perf_conv_close},
+    {"limiter", perf_limiter_open, perf_limiter_process, perf_limiter_deintlv_process, perf_limiter_close},
+    {"aec", perf_aec_open, perf_aec_process, NULL, perf_aec_close},
+    {"ns", perf_ns_open, perf_ns_process, perf_ns_deintlv_process, perf_ns_close},
+    {"loudness", perf_loudness_open, perf_loudness_process, perf_loudness_deintlv_process, perf_loudness_close},
+    {"mbc_n", perf_mbc_n_open, perf_mbc_n_process, perf_mbc_n_deintlv_process, perf_mbc_n_close},
+#if AE_PERF_PREBUILT
+    {"chain", perf_chain_open, perf_chain_process, NULL, perf_chain_close},
+#endif  /* AE_PERF_PREBUILT */
+};
+
+#if CONFIG_IDF_TARGET_LINUX
+static inline uint32_t perf_get_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+static inline uint32_t perf_get_cpu_mhz(void)
+{
+    return 1000;
+}
+
+static inline size_t perf_get_free_size(void)
+{
+    return 0;
+}
+#else
+static inline uint32_t perf_get_cycles(void)
+{
+    return esp_cpu_get_cycle_count();
+}
+
+static inline uint32_t perf_get_cpu_mhz(void)
+{
+    return esp_rom_get_cpu_ticks_per_us();
+}
+
+static inline size_t perf_get_free_size(void)
+{
+    return heap_caps_get_free_size(AE_PERF_HEAP_CAPS);
+}
+#endif  /* CONFIG_IDF_TARGET_LINUX */
+
+static void perf_gen_noise(uint8_t *buf, uint32_t size)
+{
+    // Fixed seed keeps input identical between runs
+    uint32_t seed = 0x12345678;
+    for (uint32_t i = 0; i < size; i++) {
+        seed = seed * 1664525 + 1013904223;
+        buf[i] = (uint8_t)(seed >> 24);
     }
-    media_lib_stop_mem_trace();
 }
 
-TEST_CASE("Reverb performance test", "AUDIO_EFFECT")
+static void perf_run_case(const ae_perf_module_t *module, ae_perf_ctx_t *ctx, bool deintlv)
 {
-    ESP_LOGI(TAG, "reverb test");
-    media_lib_add_default_adapter();
-    int sample_rate[] = {16000, 48000};
-    int channel[] = {1, 2};
-    int bit[] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int sr_i = 0; sr_i < 2; sr_i++) {
-        for (int ch_i = 0; ch_i < 2; ch_i++) {
-            for (int b_i = 0; b_i < 3; b_i++) {
-                void *reverb_hd = NULL;
-                char *in_buf = NULL;
-                char *out_buf = NULL;
-                int cnt = 0;
-                int in_num = 512;
-
-                esp_ae_reverb_cfg_t cfg = {
-                    .sample_rate = sample_rate[sr_i],
-                    .channel = channel[ch_i],
-                    .bits_per_sample = bit[b_i],
-                    .reverb_para = {
-                        .room_size = 0.7f,
-                        .damping = 0.5f,
-                        .wet_level = -6.0f,
-                        .dry_level = 0.0f,
-                        .pre_delay_ms = 20,
-                    },
-                };
-                start_mem_cnt();
-                int ret = esp_ae_reverb_open(&cfg, &reverb_hd);
-                TEST_ASSERT_NOT_EQUAL(reverb_hd, NULL);
-
-                in_buf = calloc(1, in_num * channel[ch_i] * (bit[b_i] >> 3));
-                TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-                out_buf = calloc(1, in_num * channel[ch_i] * (bit[b_i] >> 3));
-                TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-
-                diff = 0;
-                sample_cnt = 0;
-                while (cnt <= 2000) {
-                    wrap_read(in_buf, in_num * channel[ch_i], bit[b_i]);
-                    sample_cnt += in_num;
-                    st = esp_timer_get_time();
-                    ret = esp_ae_reverb_process(reverb_hd, in_num, (void *)in_buf, (void *)out_buf);
-                    et = esp_timer_get_time();
-                    TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-                    diff += et - st;
-                    cnt++;
-                }
-                uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate[sr_i];
-                ESP_LOGI(TAG, "reverb: sr:%d ch:%d bit:%d ratio:%02f",
-                         sample_rate[sr_i], channel[ch_i], bit[b_i],
-                         (double)diff / (duration * 10));
-                esp_ae_reverb_close(reverb_hd);
-                end_mem_cnt();
-                free(in_buf);
-                free(out_buf);
-            }
+    ctx->handle = NULL;
+    ctx->block = AE_PERF_BLOCK_SIZE;
+    size_t free_before = perf_get_free_size();
+#ifdef AE_PERF_LOCAL_MIN_HEAP
+    heap_caps_monitor_local_minimum_free_size_start();
+#endif  /* AE_PERF_LOCAL_MIN_HEAP */
+    if (module->open) {
+        esp_ae_err_t ret = module->open(ctx);
+        if (ret == ESP_AE_ERR_NOT_SUPPORT) {
+#ifdef AE_PERF_LOCAL_MIN_HEAP
+            heap_caps_monitor_local_minimum_free_size_stop();
+#endif  /* AE_PERF_LOCAL_MIN_HEAP */
+            return;
         }
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, ret);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(AE_PERF_MAX_BLOCK, ctx->block);
+    size_t free_min = perf_get_free_size();
+    uint32_t total = AE_PERF_DURATION_MS * ctx->sample_rate / 1000;
+    uint32_t processed = 0;
+    uint64_t cycles = 0;
+    while (processed < total) {
+        uint32_t start = perf_get_cycles();
+        esp_ae_err_t ret = deintlv ? module->deintlv_process(ctx) : module->process(ctx);
+        cycles += (uint32_t)(perf_get_cycles() - start);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, ret);
+        processed += ctx->block;
     }
-    media_lib_stop_mem_trace();
+#ifdef AE_PERF_LOCAL_MIN_HEAP
+    free_min = heap_caps_get_minimum_free_size(AE_PERF_HEAP_CAPS);
+    heap_caps_monitor_local_minimum_free_size_stop();
+#endif  /* AE_PERF_LOCAL_MIN_HEAP */
+    if (module->close) {
+        module->close(ctx);
+    }
+    double cpu_hz = (double)perf_get_cpu_mhz() * 1000000.0;
+    double samples_per_sec = cycles ? processed * cpu_hz / cycles : 0;
+    double cycles_per_sample = (double)cycles / processed;
+    double cpu_load = cycles_per_sample * ctx->sample_rate * 100.0 / cpu_hz;
+    uint32_t peak_heap = free_before > free_min ? (uint32_t)(free_before - free_min) : 0;
+    printf("AE_PERF,%s,%d,%d,%d,%s,%.0f,%.2f,%.3f,%d\n", module->name, (int)ctx->sample_rate, ctx->channel,
+           ctx->bits, deintlv ? "deintlv" : "intlv", samples_per_sec, cycles_per_sample, cpu_load, (int)peak_heap);
 }
 
-TEST_CASE("Delay performance test", "AUDIO_EFFECT")
+static void perf_run_module(const ae_perf_module_t *module, uint8_t *in, uint8_t *out)
 {
-    ESP_LOGI(TAG, "delay test");
-    media_lib_add_default_adapter();
-    int sample_rate[] = {16000, 48000};
-    int channel[] = {1, 2};
-    int bit[] = {16, 24, 32};
-    uint64_t st;
-    uint64_t et;
-    uint64_t diff;
-    uint64_t sample_cnt = 0;
-    for (int sr_i = 0; sr_i < 2; sr_i++) {
-        for (int ch_i = 0; ch_i < 2; ch_i++) {
-            for (int b_i = 0; b_i < 3; b_i++) {
-                void *delay_hd = NULL;
-                char *in_buf = NULL;
-                char *out_buf = NULL;
-                int cnt = 0;
-                int in_num = 512;
-
-                esp_ae_delay_cfg_t cfg = {
-                    .sample_rate = sample_rate[sr_i],
-                    .channel = channel[ch_i],
-                    .bits_per_sample = bit[b_i],
-                    .max_delay_ms = 500,
-                    .delay_para = {
-                        .delay_time_ms = 250,
-                        .feedback = 0.5f,
-                        .mix = 0.35f,
-                    },
-                };
-                start_mem_cnt();
-                int ret = esp_ae_delay_open(&cfg, &delay_hd);
-                TEST_ASSERT_NOT_EQUAL(delay_hd, NULL);
-
-                in_buf = calloc(1, in_num * channel[ch_i] * (bit[b_i] >> 3));
-                TEST_ASSERT_NOT_EQUAL(in_buf, NULL);
-                out_buf = calloc(1, in_num * channel[ch_i] * (bit[b_i] >> 3));
-                TEST_ASSERT_NOT_EQUAL(out_buf, NULL);
-
-                diff = 0;
-                sample_cnt = 0;
-                while (cnt <= 2000) {
-                    wrap_read(in_buf, in_num * channel[ch_i], bit[b_i]);
-                    sample_cnt += in_num;
-                    st = esp_timer_get_time();
-                    ret = esp_ae_delay_process(delay_hd, in_num, (void *)in_buf, (void *)out_buf);
-                    et = esp_timer_get_time();
-                    TEST_ASSERT_EQUAL(ret, ESP_AE_ERR_OK);
-                    diff += et - st;
-                    cnt++;
+    ae_perf_ctx_t ctx = {.in = in, .out = out};
+    for (int sr_idx = 0; sr_idx < AE_TEST_PARAM_NUM(perf_sample_rate); sr_idx++) {
+        for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(perf_bits); bit_idx++) {
+            for (int ch_idx = 0; ch_idx < AE_TEST_PARAM_NUM(perf_channel); ch_idx++) {
+                ctx.sample_rate = perf_sample_rate[sr_idx];
+                ctx.bits = perf_bits[bit_idx];
+                ctx.channel = perf_channel[ch_idx];
+                // Planar buffers share the same memory as interleaved ones, only one layout is used per case
+                uint32_t in_ch_size = AE_PERF_MAX_BLOCK * (ctx.bits >> 3);
+                uint32_t out_ch_size = in_ch_size * AE_PERF_OUT_FACTOR;
+                for (int i = 0; i < AE_PERF_MAX_CH; i++) {
+                    ctx.in_ch[i] = in + i * in_ch_size;
+                    ctx.out_ch[i] = out + i * out_ch_size;
+                }
+                perf_run_case(module, &ctx, false);
+                if (module->deintlv_process) {
+                    perf_run_case(module, &ctx, true);
                 }
-                uint64_t duration = 1000.0 * (double)sample_cnt / (double)sample_rate[sr_i];
-                ESP_LOGI(TAG, "delay: sr:%d ch:%d bit:%d ratio:%02f",
-                         sample_rate[sr_i], channel[ch_i], bit[b_i],
-                         (double)diff / (duration * 10));
-                esp_ae_delay_close(delay_hd);
-                end_mem_cnt();
-                free(in_buf);
-                free(out_buf);
             }
         }
     }
-    media_lib_stop_mem_trace();
 }
 
-#endif
+TEST_CASE("Audio effects performance test", "AUDIO_EFFECT")
+{
+    uint32_t in_size = AE_PERF_MAX_BLOCK * AE_PERF_MAX_CH * sizeof(int32_t);
+    uint32_t out_size = in_size * AE_PERF_OUT_FACTOR;
+    uint8_t *in = (uint8_t *)malloc(in_size);
+    uint8_t *out = (uint8_t *)malloc(out_size);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    perf_gen_noise(in, in_size);
+    ESP_LOGI(TAG, "CPU %d MHz, %d ms audio per case", (int)perf_get_cpu_mhz(), AE_PERF_DURATION_MS);
+    printf("AE_PERF,module,sample_rate,channel,bits,layout,samples_per_sec,cycles_per_sample,cpu_load,peak_heap\n");
+    for (int i = 0; i < AE_TEST_PARAM_NUM(perf_modules); i++) {
+        perf_run_module(&perf_modules[i], in, out);
+    }
+    free(in);
+    free(out);
+}
@@ -0,0 +1,418 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_aec.h"
+#include "ae_common.h"
+
+#define TAG                  "TEST_AEC"
+#define TEST_DURATION_MS     8000
+#define TEST_DOUBLE_TALK_MS  5000
+#define TEST_CONVERGE_MS     2500
+#define TEST_ECHO_DELAY_MS   40
+#define TEST_ROOM_MS         24
+#define TEST_FILTER_MS       64
+#define TEST_MAX_DELAY_MS    200
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static bool     enable_nlp[]      = {false, true};
+
+/**
+ * Offline test vectors of a loudspeaker call: far-end reference, microphone with echo and near-end speech
+ * in the double talk part, and the near-end speech alone for comparison
+ */
+typedef struct {
+    uint32_t  sample_num;
+    float    *ref;
+    float    *mic;
+    float    *near;
+} aec_test_vector_t;
+
+static double aec_test_get(const uint8_t *buf, uint8_t bits, uint32_t idx)
+{
+    double scale = (double)(1ULL << (bits - 1));
+    switch (bits) {
+        case 16:
+            return ((const int16_t *)buf)[idx] / scale;
+        case 24: {
+            const uint8_t *p = buf + idx * 3;
+            return ((int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8) / scale;
+        }
+        default:
+            return ((const int32_t *)buf)[idx] / scale;
+    }
+}
+
+static void aec_test_set(uint8_t *buf, uint8_t bits, uint32_t idx, double v)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    v *= max_val + 1.0;
+    v = v > max_val ? max_val : v < -max_val - 1.0 ? -max_val - 1.0 : v;
+    int32_t s = (int32_t)lrint(v);
+    switch (bits) {
+        case 16:
+            ((int16_t *)buf)[idx] = (int16_t)s;
+            break;
+        case 24: {
+            uint8_t *p = buf + idx * 3;
+            p[0] = (uint8_t)s;
+            p[1] = (uint8_t)(s >> 8);
+            p[2] = (uint8_t)(s >> 16);
+            break;
+        }
+        default:
+            ((int32_t *)buf)[idx] = s;
+            break;
+    }
+}
+
+static double aec_test_rand(uint32_t *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return (double)(int32_t)*seed / 2147483648.0;
+}
+
+/**
+ * Far-end: lowpass noise with a syllable rate envelope at about -20 dBFS
+ * Echo: far-end delayed by `TEST_ECHO_DELAY_MS` through a decaying noise room response of `TEST_ROOM_MS`
+ * Near-end: voiced speech of gliding pitch at about -20 dBFS in the double talk part
+ */
+static void aec_test_gen(aec_test_vector_t *vec, uint32_t srate)
+{
+    uint32_t n = vec->sample_num;
+    uint32_t seed = 2026u;
+    double lp = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        lp = 0.6 * lp + aec_test_rand(&seed);
+        double env = 0.3 + 0.7 * fabs(sin(M_PI * 2.5 * i / srate));
+        vec->ref[i] = (float)(0.12 * env * lp);
+    }
+    uint32_t room = TEST_ROOM_MS * srate / 1000;
+    uint32_t delay = TEST_ECHO_DELAY_MS * srate / 1000;
+    float *ir = (float *)calloc(room, sizeof(float));
+    TEST_ASSERT_NOT_NULL(ir);
+    double energy = 0.0;
+    for (uint32_t j = 0; j < room; j++) {
+        ir[j] = (float)(exp(-6.9 * j / room) * aec_test_rand(&seed));
+        energy += (double)ir[j] * ir[j];
+    }
+    // Echo 6 dB below the reference
+    for (uint32_t j = 0; j < room; j++) {
+        ir[j] *= (float)(0.5 / sqrt(energy));
+    }
+    uint32_t dt = (uint32_t)((uint64_t)TEST_DOUBLE_TALK_MS * srate / 1000);
+    double phase = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double echo = 0.0;
+        for (uint32_t j = 0; j < room && j + delay <= i; j++) {
+            echo += (double)ir[j] * vec->ref[i - delay - j];
+        }
+        double near = 0.0;
+        if (i >= dt) {
+            uint32_t pos = (i - dt) % (srate / 2);
+            double f0 = 140.0 + 40.0 * pos / (srate / 2);
+            phase += 2.0 * M_PI * f0 / srate;
+            for (int h = 1; h <= 15 && h * f0 < 4000.0; h++) {
+                near += 0.05 * sin(h * phase) / h;
+            }
+            near *= sin(M_PI * pos / (srate / 2));
+        }
+        vec->near[i] = (float)near;
+        vec->mic[i] = (float)(echo + near + 3e-4 * aec_test_rand(&seed));
+    }
+    free(ir);
+}
+
+static void aec_test_vector_init(aec_test_vector_t *vec, uint32_t srate)
+{
+    vec->sample_num = (uint32_t)((uint64_t)TEST_DURATION_MS * srate / 1000);
+    vec->ref = (float *)calloc(vec->sample_num, sizeof(float));
+    vec->mic = (float *)calloc(vec->sample_num, sizeof(float));
+    vec->near = (float *)calloc(vec->sample_num, sizeof(float));
+    TEST_ASSERT_NOT_NULL(vec->ref);
+    TEST_ASSERT_NOT_NULL(vec->mic);
+    TEST_ASSERT_NOT_NULL(vec->near);
+    aec_test_gen(vec, srate);
+}
+
+static void aec_test_vector_deinit(aec_test_vector_t *vec)
+{
+    free(vec->ref);
+    free(vec->mic);
+    free(vec->near);
+}
+
+TEST_CASE("AEC branch test", "AUDIO_EFFECT")
+{
+    esp_ae_aec_handle_t handle = NULL;
+    esp_ae_aec_cfg_t cfg = {
+        .sample_rate = 16000,
+        .bits_per_sample = 16,
+        .filter_ms = 64,
+        .max_delay_ms = 100,
+        .enable_nlp = true,
+    };
+    ESP_LOGI(TAG, "esp_ae_aec_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, NULL));
+    cfg.sample_rate = 11025;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.sample_rate = 16000;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.filter_ms = ESP_AE_AEC_MIN_FILTER_MS - 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, &handle));
+    cfg.filter_ms = ESP_AE_AEC_MAX_FILTER_MS + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, &handle));
+    cfg.filter_ms = 64;
+    cfg.max_delay_ms = ESP_AE_AEC_MAX_DELAY_MS + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_open(&cfg, &handle));
+    cfg.max_delay_ms = 100;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_aec_get_frame_size");
+    uint32_t frame_size = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_get_frame_size(NULL, &frame_size));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_get_frame_size(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_get_frame_size(handle, &frame_size));
+    TEST_ASSERT_EQUAL(256 * sizeof(int16_t), frame_size);
+
+    ESP_LOGI(TAG, "esp_ae_aec_process");
+    int16_t mic[256] = {0};
+    int16_t ref[256] = {0};
+    int16_t out[256] = {0};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_process(NULL, mic, ref, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_process(handle, NULL, ref, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_process(handle, mic, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_process(handle, mic, ref, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_process(handle, mic, ref, out));
+    for (int i = 0; i < 256; i++) {
+        TEST_ASSERT_EQUAL(0, out[i]);
+    }
+
+    ESP_LOGI(TAG, "esp_ae_aec_get_delay");
+    uint32_t delay = 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_get_delay(NULL, &delay));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_get_delay(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_get_delay(handle, &delay));
+    TEST_ASSERT_EQUAL(0, delay);
+
+    ESP_LOGI(TAG, "esp_ae_aec_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_aec_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_reset(handle));
+    esp_ae_aec_close(handle);
+    esp_ae_aec_close(NULL);
+
+    // Minimum filter without delay estimation and NLP, and the highest sample rate
+    cfg.sample_rate = 48000;
+    cfg.filter_ms = ESP_AE_AEC_MIN_FILTER_MS;
+    cfg.max_delay_ms = 0;
+    cfg.enable_nlp = false;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_open(&cfg, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_get_frame_size(handle, &frame_size));
+    TEST_ASSERT_EQUAL(512 * sizeof(int16_t), frame_size);
+    esp_ae_aec_close(handle);
+}
+
+TEST_CASE("AEC echo cancellation quality test", "AUDIO_EFFECT")
+{
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        uint32_t srate = sample_rate[r];
+        aec_test_vector_t vec = {0};
+        aec_test_vector_init(&vec, srate);
+        uint32_t n = vec.sample_num;
+        uint32_t converge = TEST_CONVERGE_MS * srate / 1000;
+        uint32_t dt = TEST_DOUBLE_TALK_MS * srate / 1000;
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int l = 0; l < AE_TEST_PARAM_NUM(enable_nlp); l++) {
+                uint8_t bits = bits_per_sample[b];
+                uint8_t bytes = bits >> 3;
+                esp_ae_aec_cfg_t cfg = {
+                    .sample_rate = srate,
+                    .bits_per_sample = bits,
+                    .filter_ms = TEST_FILTER_MS,
+                    .max_delay_ms = TEST_MAX_DELAY_MS,
+                    .enable_nlp = enable_nlp[l],
+                };
+                esp_ae_aec_handle_t handle = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_open(&cfg, &handle));
+                uint32_t frame_size = 0;
+                esp_ae_aec_get_frame_size(handle, &frame_size);
+                uint32_t hop = frame_size / bytes;
+                uint32_t latency = enable_nlp[l] ? hop : 0;
+                uint8_t *mic = (uint8_t *)calloc(n, bytes);
+                uint8_t *ref = (uint8_t *)calloc(n, bytes);
+                uint8_t *out = (uint8_t *)calloc(n, bytes);
+                TEST_ASSERT_NOT_NULL(mic);
+                TEST_ASSERT_NOT_NULL(ref);
+                TEST_ASSERT_NOT_NULL(out);
+                for (uint32_t i = 0; i < n; i++) {
+                    aec_test_set(mic, bits, i, vec.mic[i]);
+                    aec_test_set(ref, bits, i, vec.ref[i]);
+                }
+                uint32_t frames = n / hop;
+                for (uint32_t f = 0; f < frames; f++) {
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_process(handle, mic + f * frame_size,
+                                                                        ref + f * frame_size, out + f * frame_size));
+                }
+                // Echo return loss enhancement of the far-end only part after convergence
+                double mic_pow = 0.0;
+                double out_pow = 0.0;
+                for (uint32_t i = converge; i < dt - latency; i++) {
+                    mic_pow += pow(aec_test_get(mic, bits, i), 2);
+                    out_pow += pow(aec_test_get(out, bits, i + latency), 2);
+                }
+                // Near-end speech kept during double talk
+                double near_pow = 0.0;
+                double dt_err = 0.0;
+                double dt_in_err = 0.0;
+                for (uint32_t i = dt + hop * 10; i + latency < frames * hop; i++) {
+                    near_pow += (double)vec.near[i] * vec.near[i];
+                    dt_err += pow(aec_test_get(out, bits, i + latency) - vec.near[i], 2);
+                    dt_in_err += pow(aec_test_get(mic, bits, i) - vec.near[i], 2);
+                }
+                uint32_t delay = 0;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_get_delay(handle, &delay));
+                double erle = 10.0 * log10(mic_pow / out_pow);
+                double near_in = 10.0 * log10(near_pow / dt_in_err);
+                double near_out = 10.0 * log10(near_pow / dt_err);
+                ESP_LOGI(TAG, "rate %d bits %d nlp %d ERLE %.2f dB delay %d near-end SNR %.2f -> %.2f dB",
+                         (int)srate, bits, enable_nlp[l], erle, (int)delay, near_in, near_out);
+                TEST_ASSERT_TRUE(erle > (enable_nlp[l] ? 35.0 : 30.0));
+                TEST_ASSERT_INT_WITHIN(hop * 3 / 2, TEST_ECHO_DELAY_MS * srate / 1000, delay);
+                // NLP trades some near-end distortion during double talk for residual echo suppression
+                TEST_ASSERT_TRUE(near_out > (enable_nlp[l] ? 10.0 : 30.0));
+                esp_ae_aec_close(handle);
+                free(mic);
+                free(ref);
+                free(out);
+            }
+        }
+        aec_test_vector_deinit(&vec);
+    }
+}
+
+TEST_CASE("AEC fixed delay and reset test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 16000;
+    aec_test_vector_t vec = {0};
+    aec_test_vector_init(&vec, srate);
+    uint32_t dt = TEST_DOUBLE_TALK_MS * srate / 1000;
+    uint32_t converge = TEST_CONVERGE_MS * srate / 1000;
+    // Without delay estimation the filter covers echo delay and room response, inplace processing
+    esp_ae_aec_cfg_t cfg = {
+        .sample_rate = srate,
+        .bits_per_sample = 16,
+        .filter_ms = TEST_ECHO_DELAY_MS + TEST_FILTER_MS,
+        .max_delay_ms = 0,
+        .enable_nlp = false,
+    };
+    esp_ae_aec_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_open(&cfg, &handle));
+    uint32_t frame_size = 0;
+    esp_ae_aec_get_frame_size(handle, &frame_size);
+    uint32_t hop = frame_size / sizeof(int16_t);
+    int16_t *mic = (int16_t *)calloc(dt, sizeof(int16_t));
+    int16_t *ref = (int16_t *)calloc(dt, sizeof(int16_t));
+    int16_t *out = (int16_t *)calloc(dt, sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(mic);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+    for (uint32_t i = 0; i < dt; i++) {
+        aec_test_set((uint8_t *)mic, 16, i, vec.mic[i]);
+        aec_test_set((uint8_t *)ref, 16, i, vec.ref[i]);
+    }
+    for (int loop = 0; loop < 2; loop++) {
+        memcpy(out, mic, dt * sizeof(int16_t));
+        for (uint32_t pos = 0; pos + hop <= dt; pos += hop) {
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_process(handle, out + pos, ref + pos, out + pos));
+        }
+        double mic_pow = 0.0;
+        double out_pow = 0.0;
+        for (uint32_t i = converge; i < dt / hop * hop; i++) {
+            mic_pow += (double)mic[i] * mic[i];
+            out_pow += (double)out[i] * out[i];
+        }
+        double erle = 10.0 * log10(mic_pow / out_pow);
+        uint32_t delay = 1;
+        esp_ae_aec_get_delay(handle, &delay);
+        ESP_LOGI(TAG, "Fixed delay loop %d ERLE %.2f dB", loop, erle);
+        TEST_ASSERT_TRUE(erle > 30.0);
+        TEST_ASSERT_EQUAL(0, delay);
+        // Same result after reset
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_reset(handle));
+    }
+    esp_ae_aec_close(handle);
+    free(mic);
+    free(ref);
+    free(out);
+    aec_test_vector_deinit(&vec);
+}
+
+TEST_CASE("AEC performance test", "AUDIO_EFFECT")
+{
+    uint16_t filter_ms[] = {64, 128, 256};
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        uint32_t srate = sample_rate[r];
+        aec_test_vector_t vec = {0};
+        aec_test_vector_init(&vec, srate);
+        for (int f = 0; f < AE_TEST_PARAM_NUM(filter_ms); f++) {
+            for (int l = 0; l < AE_TEST_PARAM_NUM(enable_nlp); l++) {
+                esp_ae_aec_cfg_t cfg = {
+                    .sample_rate = srate,
+                    .bits_per_sample = 16,
+                    .filter_ms = filter_ms[f],
+                    .max_delay_ms = TEST_MAX_DELAY_MS,
+                    .enable_nlp = enable_nlp[l],
+                };
+                esp_ae_aec_handle_t handle = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_aec_open(&cfg, &handle));
+                uint32_t frame_size = 0;
+                esp_ae_aec_get_frame_size(handle, &frame_size);
+                uint32_t hop = frame_size / sizeof(int16_t);
+                int16_t *mic = (int16_t *)calloc(hop, sizeof(int16_t));
+                int16_t *ref = (int16_t *)calloc(hop, sizeof(int16_t));
+                int16_t *out = (int16_t *)calloc(hop, sizeof(int16_t));
+                TEST_ASSERT_NOT_NULL(mic);
+                TEST_ASSERT_NOT_NULL(ref);
+                TEST_ASSERT_NOT_NULL(out);
+                // One second of the test vectors with active adaptation and delay estimation
+                uint32_t frames = srate / hop;
+                uint64_t cycles = 0;
+                for (uint32_t k = 0; k < frames; k++) {
+                    for (uint32_t i = 0; i < hop; i++) {
+                        aec_test_set((uint8_t *)mic, 16, i, vec.mic[k * hop + i]);
+                        aec_test_set((uint8_t *)ref, 16, i, vec.ref[k * hop + i]);
+                    }
+                    uint32_t start = esp_cpu_get_cycle_count();
+                    esp_ae_aec_process(handle, mic, ref, out);
+                    cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+                }
+                printf("AEC_PERF,sample_rate=%d,filter_ms=%d,nlp=%d,frame=%d,cycles_per_frame=%d,"
+                       "cycles_per_sample=%.2f\n",
+                       (int)srate, filter_ms[f], enable_nlp[l], (int)hop, (int)(cycles / frames),
+                       (float)cycles / (hop * frames));
+                esp_ae_aec_close(handle);
+                free(mic);
+                free(ref);
+                free(out);
+            }
+        }
+        aec_test_vector_deinit(&vec);
+    }
+}
@@ -0,0 +1,409 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_async_src.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_ASYNC_SRC"
+#define TEST_TONE_FREQ   1000.0
+#define TEST_BLOCK_SIZE  480
+#define TEST_SKIP_SAMPLE 256
+
+static float test_ppm[] = {-500.0f, 0.0f, 500.0f};
+static uint8_t test_bits[] = {16, 24, 32};
+
+/**
+ * Least squares fit of `a * cos(w * n) + b * sin(w * n) + c` on the output channel,
+ * the residual over the fitted tone is THD+N in dB
+ */
+static double async_src_test_thdn(uint8_t *out, uint8_t bits, uint8_t ch, uint32_t num, double w)
+{
+    double s[3][3] = {0};
+    double b[3] = {0};
+    uint32_t frame = ch * (bits >> 3);
+    for (uint32_t i = 0; i < num; i++) {
+        double v[3] = {cos(w * i), sin(w * i), 1.0};
+        double y = ae_test_read_sample(out + i * frame, bits);
+        for (int r = 0; r < 3; r++) {
+            b[r] += v[r] * y;
+            for (int c = 0; c < 3; c++) {
+                s[r][c] += v[r] * v[c];
+            }
+        }
+    }
+    // Gaussian elimination of the 3x3 normal equation
+    for (int k = 0; k < 3; k++) {
+        for (int r = k + 1; r < 3; r++) {
+            double f = s[r][k] / s[k][k];
+            for (int c = k; c < 3; c++) {
+                s[r][c] -= f * s[k][c];
+            }
+            b[r] -= f * b[k];
+        }
+    }
+    double x[3];
+    for (int k = 2; k >= 0; k--) {
+        x[k] = b[k];
+        for (int c = k + 1; c < 3; c++) {
+            x[k] -= s[k][c] * x[c];
+        }
+        x[k] /= s[k][k];
+    }
+    double err = 0.0;
+    double sig = 0.0;
+    for (uint32_t i = 0; i < num; i++) {
+        double fit = x[0] * cos(w * i) + x[1] * sin(w * i) + x[2];
+        double y = ae_test_read_sample(out + i * frame, bits);
+        err += (y - fit) * (y - fit);
+        sig += fit * fit;
+    }
+    return 10.0 * log10(err / sig);
+}
+
+TEST_CASE("Async SRC branch test", "AUDIO_EFFECT")
+{
+    esp_ae_async_src_handle_t handle = NULL;
+    esp_ae_async_src_cfg_t cfg = {
+        .src_rate = 44100,
+        .dest_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .complexity = 2,
+    };
+    ESP_LOGI(TAG, "esp_ae_async_src_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, NULL));
+    cfg.src_rate = 3999;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.src_rate = 44100;
+    cfg.dest_rate = 192001;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    cfg.dest_rate = 48000;
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.complexity = 4;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    cfg.complexity = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_open(&cfg, &handle));
+    cfg.complexity = 2;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_async_src_get_max_out_sample_num");
+    uint32_t max_out = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_get_max_out_sample_num(NULL, 441, &max_out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_get_max_out_sample_num(handle, 441, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_get_max_out_sample_num(handle, 441, &max_out));
+    TEST_ASSERT_GREATER_OR_EQUAL(481, max_out);
+
+    ESP_LOGI(TAG, "esp_ae_async_src_process");
+    int16_t in[441 * 2] = {0};
+    int16_t out[600 * 2] = {0};
+    void *in_ch[2] = {in, in + 441};
+    void *out_ch[2] = {out, out + 600};
+    uint32_t out_num = max_out;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_process(NULL, in, 441, out, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_process(handle, NULL, 441, out, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_process(handle, in, 441, NULL, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_process(handle, in, 441, out, NULL));
+    out_num = max_out - 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_process(handle, in, 441, out, &out_num));
+    out_num = max_out;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_process(handle, in, 441, out, &out_num));
+    TEST_ASSERT_LESS_OR_EQUAL(max_out, out_num);
+
+    ESP_LOGI(TAG, "esp_ae_async_src_deintlv_process");
+    out_num = max_out;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_deintlv_process(NULL, in_ch, 441, out_ch, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_deintlv_process(handle, NULL, 441, out_ch, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_deintlv_process(handle, in_ch, 441, NULL, &out_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_deintlv_process(handle, in_ch, 441, out_ch, &out_num));
+
+    ESP_LOGI(TAG, "esp_ae_async_src_set_ratio_ppm");
+    float ppm = 0.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_set_ratio_ppm(NULL, 100.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_set_ratio_ppm(handle, 1001.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_set_ratio_ppm(handle, -1001.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_set_ratio_ppm(handle, -250.5f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_get_ratio_ppm(NULL, &ppm));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_get_ratio_ppm(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_get_ratio_ppm(handle, &ppm));
+    TEST_ASSERT_EQUAL_FLOAT(-250.5f, ppm);
+
+    ESP_LOGI(TAG, "esp_ae_async_src_set_pi");
+    esp_ae_async_src_pi_cfg_t pi_cfg = {.target_level = 960, .kp = 50.0f, .ki = 0.5f};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_NOT_SUPPORT, esp_ae_async_src_update_level(handle, 960));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_update_level(NULL, 960));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_set_pi(NULL, &pi_cfg));
+    pi_cfg.kp = -1.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_set_pi(handle, &pi_cfg));
+    pi_cfg.kp = 50.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_set_pi(handle, &pi_cfg));
+    // Zero error keeps the current adjustment
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_update_level(handle, 960));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_get_ratio_ppm(handle, &ppm));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -250.5f, ppm);
+    // Large error saturates at `max_ppm`
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_update_level(handle, 96000));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_get_ratio_ppm(handle, &ppm));
+    TEST_ASSERT_EQUAL_FLOAT(-ESP_AE_ASYNC_SRC_DEFAULT_MAX_PPM, ppm);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_set_pi(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_NOT_SUPPORT, esp_ae_async_src_update_level(handle, 960));
+
+    ESP_LOGI(TAG, "esp_ae_async_src_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_async_src_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_reset(handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_get_ratio_ppm(handle, &ppm));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, ppm);
+    esp_ae_async_src_close(handle);
+    esp_ae_async_src_close(NULL);
+}
+
+TEST_CASE("Async SRC THD+N test", "AUDIO_EFFECT")
+{
+    uint32_t rate[][2] = {{48000, 48000}, {44100, 48000}, {48000, 44100}, {48000, 16000}};
+    uint8_t ch = 2;
+    for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(test_bits); bit_idx++) {
+        uint8_t bits = test_bits[bit_idx];
+        uint32_t frame = ch * (bits >> 3);
+        for (int r = 0; r < AE_TEST_PARAM_NUM(rate); r++) {
+            uint32_t in_total = rate[r][0] / 2;
+            uint8_t *in = (uint8_t *)calloc(in_total, frame);
+            TEST_ASSERT_NOT_NULL(in);
+            ae_test_generate_sine_signal(in, 500, rate[r][0], -6.0f, bits, ch, TEST_TONE_FREQ);
+            for (int p = 0; p < AE_TEST_PARAM_NUM(test_ppm); p++) {
+                esp_ae_async_src_cfg_t cfg = {
+                    .src_rate = rate[r][0],
+                    .dest_rate = rate[r][1],
+                    .channel = ch,
+                    .bits_per_sample = bits,
+                    .complexity = 2,
+                };
+                esp_ae_async_src_handle_t handle = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_set_ratio_ppm(handle, test_ppm[p]));
+                uint32_t max_out = 0;
+                esp_ae_async_src_get_max_out_sample_num(handle, in_total, &max_out);
+                uint8_t *out = (uint8_t *)calloc(max_out, frame);
+                TEST_ASSERT_NOT_NULL(out);
+                uint32_t out_total = 0;
+                for (uint32_t pos = 0; pos < in_total; pos += TEST_BLOCK_SIZE) {
+                    uint32_t n = in_total - pos < TEST_BLOCK_SIZE ? in_total - pos : TEST_BLOCK_SIZE;
+                    uint32_t out_num = 0;
+                    esp_ae_async_src_get_max_out_sample_num(handle, n, &out_num);
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_process(handle, in + pos * frame, n,
+                                                                              out + out_total * frame, &out_num));
+                    out_total += out_num;
+                }
+                double step = (double)rate[r][0] / rate[r][1] / (1.0 + test_ppm[p] * 1e-6);
+                double expect = in_total / step;
+                double thdn = async_src_test_thdn(out + TEST_SKIP_SAMPLE * frame, bits, ch, out_total - 2 * TEST_SKIP_SAMPLE,
+                                                  2.0 * M_PI * TEST_TONE_FREQ / rate[r][0] * step);
+                ESP_LOGI(TAG, "bits %d %d -> %d ppm %.0f out %d expect %.1f THD+N %.1f dB", bits, (int)rate[r][0],
+                         (int)rate[r][1], test_ppm[p], (int)out_total, expect, thdn);
+                // Output count differs from ideal only by the filter delay still kept inside
+                TEST_ASSERT_FLOAT_WITHIN(40.0, expect, (double)out_total);
+                TEST_ASSERT_LESS_THAN(-80, (int)thdn);
+                esp_ae_async_src_close(handle);
+                free(out);
+            }
+            free(in);
+        }
+    }
+}
+
+TEST_CASE("Async SRC alias rejection test", "AUDIO_EFFECT")
+{
+    // Tone above the output Nyquist frequency must be removed, not folded back into the pass band,
+    // 32 bits keeps the residual above the quantization floor
+    uint32_t rate[][2] = {{48000, 8000}, {96000, 8000}, {192000, 4000}};
+    float alias_limit[] = {-80.0f, -100.0f, -115.0f};
+    for (int r = 0; r < AE_TEST_PARAM_NUM(rate); r++) {
+        for (uint8_t cx = 1; cx <= 3; cx++) {
+            uint32_t in_total = rate[r][0] / 4;
+            int32_t *in = (int32_t *)calloc(in_total, sizeof(int32_t));
+            TEST_ASSERT_NOT_NULL(in);
+            ae_test_generate_sine_signal(in, 250, rate[r][0], -6.0f, 32, 1, rate[r][1] * 0.7f);
+            esp_ae_async_src_cfg_t cfg = {
+                .src_rate = rate[r][0],
+                .dest_rate = rate[r][1],
+                .channel = 1,
+                .bits_per_sample = 32,
+                .complexity = cx,
+            };
+            esp_ae_async_src_handle_t handle = NULL;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+            uint32_t out_num = 0;
+            esp_ae_async_src_get_max_out_sample_num(handle, in_total, &out_num);
+            int32_t *out = (int32_t *)calloc(out_num, sizeof(int32_t));
+            TEST_ASSERT_NOT_NULL(out);
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_process(handle, in, in_total, out, &out_num));
+            // Skip the filter start up
+            uint32_t skip = out_num / 4;
+            float level = ae_test_calculate_rms_dbfs(out + skip, out_num - skip, 32, 1);
+            ESP_LOGI(TAG, "%d -> %d complexity %d alias level %.1f dBFS", (int)rate[r][0], (int)rate[r][1], cx, level);
+            // Rejection depends on complexity only, not on the decimation ratio
+            TEST_ASSERT_LESS_THAN(alias_limit[cx - 1], level);
+            esp_ae_async_src_close(handle);
+            free(in);
+            free(out);
+        }
+    }
+}
+
+TEST_CASE("Async SRC PI drift compensation test", "AUDIO_EFFECT")
+{
+    // Source clock runs `drift` ppm apart from sink, sink drains 480 samples per 10 ms tick from
+    // the buffer after the converter, the controller must hold the level and cancel the drift
+    float drift[] = {-300.0f, 200.0f};
+    uint32_t target = 960;
+    for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(test_bits); bit_idx++) {
+        for (int d = 0; d < AE_TEST_PARAM_NUM(drift); d++) {
+            esp_ae_async_src_cfg_t cfg = {
+                .src_rate = 48000,
+                .dest_rate = 48000,
+                .channel = 1,
+                .bits_per_sample = test_bits[bit_idx],
+                .complexity = 1,
+            };
+            esp_ae_async_src_pi_cfg_t pi_cfg = {.target_level = target, .kp = 50.0f, .ki = 0.5f};
+            esp_ae_async_src_handle_t handle = NULL;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_set_pi(handle, &pi_cfg));
+            // Sized for 32 bits samples, also holds 16 and 24 bits
+            int32_t in[TEST_BLOCK_SIZE + 8] = {0};
+            int32_t out[TEST_BLOCK_SIZE + 16];
+            int32_t level = target;
+            double frac = 0.0;
+            float ppm = 0.0f;
+            for (int tick = 0; tick < 1500; tick++) {
+                frac += TEST_BLOCK_SIZE * (1.0 + drift[d] * 1e-6);
+                uint32_t in_num = (uint32_t)frac;
+                frac -= in_num;
+                uint32_t out_num = AE_TEST_PARAM_NUM(out);
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_process(handle, in, in_num, out, &out_num));
+                level += (int32_t)out_num - TEST_BLOCK_SIZE;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_update_level(handle, level));
+            }
+            esp_ae_async_src_get_ratio_ppm(handle, &ppm);
+            ESP_LOGI(TAG, "bits %d drift %.0f ppm, level %d, ratio adjustment %.1f ppm", test_bits[bit_idx], drift[d],
+                     (int)level, ppm);
+            TEST_ASSERT_INT_WITHIN(2, target, level);
+            TEST_ASSERT_FLOAT_WITHIN(60.0f, -drift[d], ppm);
+            esp_ae_async_src_close(handle);
+        }
+    }
+}
+
+TEST_CASE("Async SRC same rate passthrough test", "AUDIO_EFFECT")
+{
+    // Same rate without adjustment keeps every output at an integer input position, the output is the
+    // input band limited to `0.45 * rate` and aligned with it
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint32_t total = srate / 4;
+    for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(test_bits); bit_idx++) {
+        uint8_t bits = test_bits[bit_idx];
+        uint32_t frame = ch * (bits >> 3);
+        uint8_t *in = (uint8_t *)calloc(total, frame);
+        uint8_t *out = (uint8_t *)calloc(total + 64, frame);
+        TEST_ASSERT_NOT_NULL(in);
+        TEST_ASSERT_NOT_NULL(out);
+        ae_test_generate_sine_signal(in, 250, srate, -1.0f, bits, ch, TEST_TONE_FREQ);
+        esp_ae_async_src_cfg_t cfg = {
+            .src_rate = srate,
+            .dest_rate = srate,
+            .channel = ch,
+            .bits_per_sample = bits,
+            .complexity = 3,
+        };
+        esp_ae_async_src_handle_t handle = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+        uint32_t out_total = 0;
+        for (uint32_t pos = 0; pos < total; pos += TEST_BLOCK_SIZE) {
+            uint32_t out_num = TEST_BLOCK_SIZE + 64;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_process(handle, in + pos * frame, TEST_BLOCK_SIZE,
+                                                                      out + out_total * frame, &out_num));
+            out_total += out_num;
+        }
+        // Exactly one output per input once the history is filled
+        TEST_ASSERT_INT_WITHIN(64, total, out_total);
+        // The tone is far inside the pass band, output matches input within the filter ripple
+        double max_in = 0.0;
+        double max_err = 0.0;
+        for (uint32_t i = TEST_SKIP_SAMPLE; i + TEST_SKIP_SAMPLE < out_total; i++) {
+            for (int c = 0; c < ch; c++) {
+                double x = ae_test_read_sample(in + i * frame + c * (bits >> 3), bits);
+                double y = ae_test_read_sample(out + i * frame + c * (bits >> 3), bits);
+                max_in = fmax(max_in, fabs(x));
+                max_err = fmax(max_err, fabs(y - x));
+            }
+        }
+        double err_db = 20.0 * log10(max_err / max_in + 1e-20);
+        ESP_LOGI(TAG, "bits %d passthrough out %d peak error %.1f dB", bits, (int)out_total, err_db);
+        TEST_ASSERT_LESS_THAN(-60, (int)err_db);
+        esp_ae_async_src_close(handle);
+        free(in);
+        free(out);
+    }
+}
+
+TEST_CASE("Async SRC performance test", "AUDIO_EFFECT")
+{
+    uint32_t rate[][2] = {{48000, 48000}, {44100, 48000}};
+    uint8_t ch = 2;
+    uint32_t in_total = 48000;
+    int16_t *in = (int16_t *)calloc(in_total, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(TEST_BLOCK_SIZE * 2, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    for (int r = 0; r < AE_TEST_PARAM_NUM(rate); r++) {
+        ae_test_generate_sweep_signal(in, 1000, rate[r][0], -3.0f, 16, ch);
+        for (uint8_t cx = 1; cx <= 3; cx++) {
+            for (int p = 0; p < AE_TEST_PARAM_NUM(test_ppm); p++) {
+                esp_ae_async_src_cfg_t cfg = {
+                    .src_rate = rate[r][0],
+                    .dest_rate = rate[r][1],
+                    .channel = ch,
+                    .bits_per_sample = 16,
+                    .complexity = cx,
+                };
+                esp_ae_async_src_handle_t handle = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_async_src_open(&cfg, &handle));
+                esp_ae_async_src_set_ratio_ppm(handle, test_ppm[p]);
+                uint64_t cycles = 0;
+                uint32_t out_total = 0;
+                uint32_t in_num = in_total * rate[r][0] / 48000;
+                for (uint32_t pos = 0; pos + TEST_BLOCK_SIZE <= in_num; pos += TEST_BLOCK_SIZE) {
+                    uint32_t out_num = TEST_BLOCK_SIZE * 2;
+                    uint32_t start = esp_cpu_get_cycle_count();
+                    esp_ae_async_src_process(handle, in + pos * ch, TEST_BLOCK_SIZE, out, &out_num);
+                    cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+                    out_total += out_num;
+                }
+                printf("ASYNC_SRC_PERF,%d,%d,complexity=%d,ppm=%.0f,cycles_per_out_sample=%.2f\n", (int)rate[r][0],
+                       (int)rate[r][1], cx, test_ppm[p], (float)cycles / out_total);
+                esp_ae_async_src_close(handle);
+            }
+        }
+    }
+    free(in);
+    free(out);
+}
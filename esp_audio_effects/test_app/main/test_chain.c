@@ -0,0 +1,501 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_chain.h"
+#include "esp_ae_alc.h"
+#include "esp_ae_eq.h"
+#include "esp_ae_drc.h"
+#include "esp_ae_delay.h"
+#include "esp_ae_reverb.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_CHAIN"
+#define TEST_DURATION_MS 500
+#define TEST_BLOCK_SIZE  256
+#define TEST_STAGE_NUM   5
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+
+static esp_ae_eq_filter_para_t eq_para[] = {
+    {.filter_type = ESP_AE_EQ_FILTER_HIGH_PASS, .fc = 100, .q = 0.7f, .gain = 0},
+    {.filter_type = ESP_AE_EQ_FILTER_PEAK, .fc = 1000, .q = 1.0f, .gain = 6.0f},
+};
+static esp_ae_drc_curve_point drc_point[] = {{.x = 0, .y = -6}, {.x = -30, .y = -30}, {.x = -100, .y = -100}};
+
+static esp_ae_alc_cfg_t    alc_cfg;
+static esp_ae_eq_cfg_t     eq_cfg;
+static esp_ae_drc_cfg_t    drc_cfg;
+static esp_ae_delay_cfg_t  delay_cfg;
+static esp_ae_reverb_cfg_t reverb_cfg;
+
+static esp_ae_chain_stage_t chain_stages[TEST_STAGE_NUM] = {
+    {.type = ESP_AE_CHAIN_STAGE_EQ, .cfg = &eq_cfg},
+    {.type = ESP_AE_CHAIN_STAGE_DRC, .cfg = &drc_cfg},
+    {.type = ESP_AE_CHAIN_STAGE_ALC, .cfg = &alc_cfg},
+    {.type = ESP_AE_CHAIN_STAGE_DELAY, .cfg = &delay_cfg},
+    {.type = ESP_AE_CHAIN_STAGE_REVERB, .cfg = &reverb_cfg},
+};
+
+typedef struct {
+    esp_ae_eq_handle_t     eq;
+    esp_ae_drc_handle_t    drc;
+    esp_ae_alc_handle_t    alc;
+    esp_ae_delay_handle_t  delay;
+    esp_ae_reverb_handle_t reverb;
+} chain_test_seq_t;
+
+static void chain_test_init_cfg(uint32_t srate, uint8_t ch, uint8_t bits)
+{
+    alc_cfg = (esp_ae_alc_cfg_t) {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+    };
+    eq_cfg = (esp_ae_eq_cfg_t) {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .filter_num = AE_TEST_PARAM_NUM(eq_para),
+        .para = eq_para,
+    };
+    drc_cfg = (esp_ae_drc_cfg_t) {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .drc_para = {
+            .point = drc_point,
+            .point_num = AE_TEST_PARAM_NUM(drc_point),
+            .makeup_gain = 0.0f,
+            .knee_width = 0.0f,
+            .attack_time = 10,
+            .release_time = 100,
+            .hold_time = 0,
+        },
+    };
+    delay_cfg = (esp_ae_delay_cfg_t) {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .max_delay_ms = 200,
+        .delay_para = {
+            .delay_time_ms = 120,
+            .feedback = 0.4f,
+            .mix = 0.3f,
+        },
+    };
+    reverb_cfg = (esp_ae_reverb_cfg_t) {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .reverb_para = {
+            .room_size = 0.5f,
+            .damping = 0.5f,
+            .wet_level = -12.0f,
+            .dry_level = 0.0f,
+            .pre_delay_ms = 10,
+        },
+    };
+}
+
+static void chain_test_config_eq_alc(esp_ae_eq_handle_t eq, esp_ae_alc_handle_t alc, uint8_t ch)
+{
+    for (int i = 0; i < AE_TEST_PARAM_NUM(eq_para); i++) {
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_enable_filter(eq, i));
+    }
+    for (int i = 0; i < ch; i++) {
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_alc_set_gain(alc, i, -3));
+    }
+}
+
+static void chain_test_seq_open(chain_test_seq_t *seq, uint8_t ch)
+{
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_open(&eq_cfg, &seq->eq));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_drc_open(&drc_cfg, &seq->drc));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_alc_open(&alc_cfg, &seq->alc));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_delay_open(&delay_cfg, &seq->delay));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_reverb_open(&reverb_cfg, &seq->reverb));
+    chain_test_config_eq_alc(seq->eq, seq->alc, ch);
+}
+
+static void chain_test_seq_process(chain_test_seq_t *seq, uint32_t sample_num, uint8_t *buf, uint64_t cycles[])
+{
+    uint32_t start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_process(seq->eq, sample_num, buf, buf));
+    cycles[0] += (uint32_t)(esp_cpu_get_cycle_count() - start);
+    start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_drc_process(seq->drc, sample_num, buf, buf));
+    cycles[1] += (uint32_t)(esp_cpu_get_cycle_count() - start);
+    start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_alc_process(seq->alc, sample_num, buf, buf));
+    cycles[2] += (uint32_t)(esp_cpu_get_cycle_count() - start);
+    start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_delay_process(seq->delay, sample_num, buf, buf));
+    cycles[3] += (uint32_t)(esp_cpu_get_cycle_count() - start);
+    start = esp_cpu_get_cycle_count();
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_reverb_process(seq->reverb, sample_num, buf, buf));
+    cycles[4] += (uint32_t)(esp_cpu_get_cycle_count() - start);
+}
+
+static void chain_test_seq_close(chain_test_seq_t *seq)
+{
+    esp_ae_eq_close(seq->eq);
+    esp_ae_drc_close(seq->drc);
+    esp_ae_alc_close(seq->alc);
+    esp_ae_delay_close(seq->delay);
+    esp_ae_reverb_close(seq->reverb);
+}
+
+static esp_ae_chain_handle_t chain_test_open(uint32_t srate, uint8_t ch, uint8_t bits, uint8_t work_bits)
+{
+    esp_ae_chain_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .work_bits = work_bits,
+        .block_size = TEST_BLOCK_SIZE,
+        .stages = chain_stages,
+        .stage_num = TEST_STAGE_NUM,
+    };
+    esp_ae_chain_handle_t chain = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_open(&cfg, &chain));
+    TEST_ASSERT_NOT_NULL(chain);
+    void *eq = NULL;
+    void *alc = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_handle(chain, 0, &eq));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_handle(chain, 2, &alc));
+    chain_test_config_eq_alc(eq, alc, ch);
+    return chain;
+}
+
+static void chain_test_consistency(uint32_t srate, uint8_t ch, uint8_t bits)
+{
+    ESP_LOGI(TAG, "Consistency rate:%d ch:%d bits:%d", (int)srate, ch, bits);
+    uint32_t sample_num = TEST_DURATION_MS * srate / 1000;
+    uint32_t frame_size = ch * (bits >> 3);
+    uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+    uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+    uint8_t *ref = (uint8_t *)calloc(sample_num, frame_size);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_NOT_NULL(ref);
+    ae_test_generate_sweep_signal(in, TEST_DURATION_MS, srate, -3.0f, bits, ch);
+    chain_test_init_cfg(srate, ch, bits);
+
+    // Sequential handles walk the same block pattern so that output must be identical
+    chain_test_seq_t seq = {0};
+    uint64_t seq_cycles[TEST_STAGE_NUM] = {0};
+    chain_test_seq_open(&seq, ch);
+    memcpy(ref, in, sample_num * frame_size);
+    for (uint32_t pos = 0; pos < sample_num; pos += TEST_BLOCK_SIZE) {
+        uint32_t n = sample_num - pos > TEST_BLOCK_SIZE ? TEST_BLOCK_SIZE : sample_num - pos;
+        chain_test_seq_process(&seq, n, ref + pos * frame_size, seq_cycles);
+    }
+    chain_test_seq_close(&seq);
+
+    esp_ae_chain_handle_t chain = chain_test_open(srate, ch, bits, 0);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, sample_num * frame_size);
+
+    // Reset restores initial state, inplace processing gives the same output
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_reset(chain));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, sample_num, in, in));
+    TEST_ASSERT_EQUAL_MEMORY(ref, in, sample_num * frame_size);
+    esp_ae_chain_close(chain);
+    free(in);
+    free(out);
+    free(ref);
+}
+
+TEST_CASE("Chain branch test", "AUDIO_EFFECT")
+{
+    chain_test_init_cfg(48000, 2, 16);
+    esp_ae_chain_cfg_t cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .stages = chain_stages,
+        .stage_num = TEST_STAGE_NUM,
+    };
+    esp_ae_chain_handle_t chain = NULL;
+    uint8_t buf[16] = {0};
+    uint64_t cycles = 0;
+    void *stage = NULL;
+    ESP_LOGI(TAG, "esp_ae_chain_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(NULL, &chain));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, NULL));
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    cfg.bits_per_sample = 16;
+    cfg.work_bits = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    cfg.work_bits = 0;
+    cfg.stage_num = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    cfg.stage_num = ESP_AE_CHAIN_MAX_STAGE_NUM + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    cfg.stage_num = TEST_STAGE_NUM;
+    esp_ae_chain_stage_t bad_stage[] = {{.type = ESP_AE_CHAIN_STAGE_MAX, .cfg = &alc_cfg}};
+    cfg.stages = bad_stage;
+    cfg.stage_num = 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    bad_stage[0].type = ESP_AE_CHAIN_STAGE_EQ;
+    bad_stage[0].cfg = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_open(&cfg, &chain));
+    TEST_ASSERT_NULL(chain);
+    cfg.stages = chain_stages;
+    cfg.stage_num = TEST_STAGE_NUM;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_open(&cfg, &chain));
+
+    ESP_LOGI(TAG, "esp_ae_chain_process");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_process(NULL, 4, buf, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_process(chain, 4, NULL, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_process(chain, 4, buf, NULL));
+
+    ESP_LOGI(TAG, "esp_ae_chain_get_stage_handle and cycles");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_stage_handle(NULL, 0, &stage));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_stage_handle(chain, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_stage_handle(chain, TEST_STAGE_NUM, &stage));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_stage_cycles(chain, TEST_STAGE_NUM, &cycles));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_stage_cycles(chain, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_edge_cycles(NULL, &cycles));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_edge_cycles(chain, &cycles));
+    TEST_ASSERT_EQUAL(0, cycles);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_param_cycles(NULL, &cycles));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_get_param_cycles(chain, NULL));
+
+    ESP_LOGI(TAG, "esp_ae_chain_post_param");
+    esp_ae_chain_param_t param = {.stage_idx = 1, .id = ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN, .value.f = 2.0f};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(NULL, &param));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(chain, NULL));
+    param.stage_idx = TEST_STAGE_NUM;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(chain, &param));
+    param.stage_idx = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(chain, &param));
+    param.stage_idx = 1;
+    param.id = ESP_AE_CHAIN_PARAM_MAX;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(chain, &param));
+    param.id = ESP_AE_CHAIN_PARAM_DRC_CURVE;
+    param.value.drc_curve.point_num = ESP_AE_CHAIN_DRC_MAX_POINT_NUM + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_post_param(chain, &param));
+    param.id = ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN;
+    param.value.f = 2.0f;
+    for (int i = 0; i < ESP_AE_CHAIN_DEFAULT_PARAM_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &param));
+    }
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_FAIL, esp_ae_chain_post_param(chain, &param));
+    // Processing drains the queue
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, 4, buf, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &param));
+
+    ESP_LOGI(TAG, "esp_ae_chain_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_chain_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_reset(chain));
+    esp_ae_chain_close(chain);
+    esp_ae_chain_close(NULL);
+}
+
+TEST_CASE("Chain vs sequential handles consistency test", "AUDIO_EFFECT")
+{
+    for (int sr_idx = 0; sr_idx < AE_TEST_PARAM_NUM(sample_rate); sr_idx++) {
+        for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(bits_per_sample); bit_idx++) {
+            for (int ch_idx = 0; ch_idx < AE_TEST_PARAM_NUM(channel); ch_idx++) {
+                chain_test_consistency(sample_rate[sr_idx], channel[ch_idx], bits_per_sample[bit_idx]);
+            }
+        }
+    }
+}
+
+TEST_CASE("Chain parameter update test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    uint16_t ramp_ms = 20;
+    uint32_t ramp_len = ramp_ms * srate / 1000;
+    uint32_t sample_num = 2 * ramp_len;
+    uint8_t *buf = (uint8_t *)calloc(sample_num, ch * (bits >> 3));
+    TEST_ASSERT_NOT_NULL(buf);
+    chain_test_init_cfg(srate, ch, bits);
+    esp_ae_chain_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .stages = chain_stages,
+        .stage_num = TEST_STAGE_NUM,
+        .ramp_ms = ramp_ms,
+    };
+    uint16_t ramp_cfg[] = {0, ramp_ms};
+    for (int r = 0; r < AE_TEST_PARAM_NUM(ramp_cfg); r++) {
+        cfg.ramp_ms = ramp_cfg[r];
+        esp_ae_chain_handle_t chain = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_open(&cfg, &chain));
+        void *eq = NULL;
+        void *drc = NULL;
+        void *reverb = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_handle(chain, 0, &eq));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_handle(chain, 1, &drc));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_handle(chain, 4, &reverb));
+        esp_ae_chain_param_t eq_param = {
+            .stage_idx = 0,
+            .id = ESP_AE_CHAIN_PARAM_EQ_FILTER,
+            .idx = 1,
+            .value.eq_filter = {.filter_type = ESP_AE_EQ_FILTER_PEAK, .fc = 4000, .q = 2.0f, .gain = -6.0f},
+        };
+        esp_ae_chain_param_t wet_param = {.stage_idx = 4, .id = ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL, .value.f = -3.0f};
+        esp_ae_chain_param_t curve_param = {.stage_idx = 1, .id = ESP_AE_CHAIN_PARAM_DRC_CURVE};
+        memcpy(curve_param.value.drc_curve.point, drc_point, sizeof(drc_point));
+        curve_param.value.drc_curve.point_num = AE_TEST_PARAM_NUM(drc_point);
+        curve_param.value.drc_curve.point[0].y = -12.0f;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &eq_param));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &wet_param));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &curve_param));
+
+        // Nothing changes until process takes the updates at a block boundary
+        esp_ae_eq_filter_para_t filter = {0};
+        float wet = 0.0f;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_get_filter_para(eq, 1, &filter));
+        TEST_ASSERT_EQUAL(eq_para[1].fc, filter.fc);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, ramp_len / 2, buf, buf));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_get_filter_para(eq, 1, &filter));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_reverb_get_wet_level(reverb, &wet));
+        if (cfg.ramp_ms == 0) {
+            TEST_ASSERT_EQUAL(eq_param.value.eq_filter.fc, filter.fc);
+            TEST_ASSERT_EQUAL_FLOAT(wet_param.value.f, wet);
+        } else {
+            // Halfway on a log scale for frequency and Q, linear for levels in dB
+            TEST_ASSERT_INT_WITHIN(20, 2000, filter.fc);
+            TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.414f, filter.q);
+            TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, filter.gain);
+            TEST_ASSERT_FLOAT_WITHIN(0.1f, -7.5f, wet);
+        }
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, sample_num - ramp_len / 2, buf, buf));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_get_filter_para(eq, 1, &filter));
+        TEST_ASSERT_EQUAL(eq_param.value.eq_filter.fc, filter.fc);
+        TEST_ASSERT_EQUAL_FLOAT(eq_param.value.eq_filter.q, filter.q);
+        TEST_ASSERT_EQUAL_FLOAT(eq_param.value.eq_filter.gain, filter.gain);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_reverb_get_wet_level(reverb, &wet));
+        TEST_ASSERT_EQUAL_FLOAT(wet_param.value.f, wet);
+        esp_ae_drc_curve_point point[AE_TEST_PARAM_NUM(drc_point)];
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_drc_get_curve_points(drc, point));
+        TEST_ASSERT_EQUAL_FLOAT(-12.0f, point[0].y);
+
+        // A changed filter type cannot be interpolated and is applied at once
+        eq_param.value.eq_filter.filter_type = ESP_AE_EQ_FILTER_HIGH_SHELF;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &eq_param));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, 1, buf, buf));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_eq_get_filter_para(eq, 1, &filter));
+        TEST_ASSERT_EQUAL(ESP_AE_EQ_FILTER_HIGH_SHELF, filter.filter_type);
+
+        // Reset completes running ramps
+        wet_param.value.f = -20.0f;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &wet_param));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, 1, buf, buf));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_reset(chain));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_reverb_get_wet_level(reverb, &wet));
+        TEST_ASSERT_EQUAL_FLOAT(wet_param.value.f, wet);
+        esp_ae_chain_close(chain);
+    }
+    free(buf);
+}
+
+TEST_CASE("Chain performance test", "AUDIO_EFFECT")
+{
+    static const char *stage_name[TEST_STAGE_NUM] = {"eq", "drc", "alc", "delay", "reverb"};
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    uint32_t sample_num = 1000 * srate / 1000;
+    uint32_t frame_size = ch * (bits >> 3);
+    uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+    uint8_t *buf = (uint8_t *)calloc(sample_num, frame_size);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(buf);
+    ae_test_generate_sweep_signal(in, 1000, srate, -3.0f, bits, ch);
+    chain_test_init_cfg(srate, ch, bits);
+
+    // Baseline: every handle walks the whole buffer once
+    chain_test_seq_t seq = {0};
+    uint64_t seq_cycles[TEST_STAGE_NUM] = {0};
+    uint64_t seq_total = 0;
+    chain_test_seq_open(&seq, ch);
+    memcpy(buf, in, sample_num * frame_size);
+    chain_test_seq_process(&seq, sample_num, buf, seq_cycles);
+    chain_test_seq_close(&seq);
+    for (int i = 0; i < TEST_STAGE_NUM; i++) {
+        seq_total += seq_cycles[i];
+    }
+    float seq_rms = ae_test_calculate_rms_dbfs(buf, sample_num, bits, ch);
+
+    uint8_t work_bits[] = {0, 32};
+    for (int w = 0; w < AE_TEST_PARAM_NUM(work_bits); w++) {
+        esp_ae_chain_handle_t chain = chain_test_open(srate, ch, bits, work_bits[w]);
+        uint32_t start = esp_cpu_get_cycle_count();
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, sample_num, in, buf));
+        uint64_t chain_total = (uint32_t)(esp_cpu_get_cycle_count() - start);
+        float chain_rms = ae_test_calculate_rms_dbfs(buf, sample_num, bits, ch);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, seq_rms, chain_rms);
+        for (int i = 0; i < TEST_STAGE_NUM; i++) {
+            uint64_t cycles = 0;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_stage_cycles(chain, i, &cycles));
+            printf("CHAIN_PERF,work_bits=%d,stage=%s,seq_cycles=%llu,chain_cycles=%llu\n", work_bits[w],
+                   stage_name[i], (unsigned long long)seq_cycles[i], (unsigned long long)cycles);
+        }
+        uint64_t edge_cycles = 0;
+        esp_ae_chain_get_edge_cycles(chain, &edge_cycles);
+        printf("CHAIN_PERF,work_bits=%d,stage=total,seq_cycles=%llu,chain_cycles=%llu,edge_cycles=%llu,"
+               "seq_cycles_per_sample=%.2f,chain_cycles_per_sample=%.2f\n",
+               work_bits[w], (unsigned long long)seq_total, (unsigned long long)chain_total,
+               (unsigned long long)edge_cycles, (float)seq_total / sample_num, (float)chain_total / sample_num);
+        esp_ae_chain_close(chain);
+    }
+
+    // Parameter handling cost with an empty queue and with ramps running the whole buffer
+    esp_ae_chain_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .block_size = TEST_BLOCK_SIZE,
+        .stages = chain_stages,
+        .stage_num = TEST_STAGE_NUM,
+        .ramp_ms = 1000,
+    };
+    esp_ae_chain_param_t params[] = {
+        {.stage_idx = 0, .id = ESP_AE_CHAIN_PARAM_EQ_FILTER, .idx = 1,
+         .value.eq_filter = {.filter_type = ESP_AE_EQ_FILTER_PEAK, .fc = 3000, .q = 2.0f, .gain = -6.0f}},
+        {.stage_idx = 1, .id = ESP_AE_CHAIN_PARAM_DRC_MAKEUP_GAIN, .value.f = 3.0f},
+        {.stage_idx = 4, .id = ESP_AE_CHAIN_PARAM_REVERB_WET_LEVEL, .value.f = -3.0f},
+    };
+    for (int ramp = 0; ramp < 2; ramp++) {
+        esp_ae_chain_handle_t chain = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_open(&cfg, &chain));
+        for (int i = 0; ramp && i < AE_TEST_PARAM_NUM(params); i++) {
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_post_param(chain, &params[i]));
+        }
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_process(chain, sample_num, in, buf));
+        uint64_t param_cycles = 0;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_chain_get_param_cycles(chain, &param_cycles));
+        printf("CHAIN_PARAM_PERF,ramp=%d,param_cycles=%llu,cycles_per_sample=%.3f\n", ramp,
+               (unsigned long long)param_cycles, (float)param_cycles / sample_num);
+        esp_ae_chain_close(chain);
+    }
+    free(in);
+    free(buf);
+}
@@ -0,0 +1,377 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_conv.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_CONV"
+#define TEST_DURATION_MS 100
+#define TEST_CALL_SIZE   77
+#define TEST_IR_LEN      1000
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+static uint16_t partition_size[]  = {32, 128, 512};
+
+static int64_t conv_test_get(const uint8_t *buf, uint8_t bits, uint32_t idx)
+{
+    switch (bits) {
+        case 16:
+            return ((const int16_t *)buf)[idx];
+        case 24: {
+            const uint8_t *p = buf + idx * 3;
+            return (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+        }
+        default:
+            return ((const int32_t *)buf)[idx];
+    }
+}
+
+/**
+ * Exponentially decaying noise, a simple model of a room IR
+ */
+static void conv_test_gen_ir(float *ir, uint32_t len, uint32_t seed, float scale)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        seed = seed * 1664525 + 1013904223;
+        float noise = (float)(int32_t)seed / 2147483648.0f;
+        ir[i] = scale * noise * expf(-5.0f * i / len);
+    }
+}
+
+/**
+ * Compare with direct convolution in double precision delayed by `latency`, return error to signal ratio in dB
+ */
+static float conv_test_check(const uint8_t *in, const uint8_t *out, const float *ir[], uint32_t ir_len,
+                             uint32_t sample_num, uint8_t bits, uint8_t ch, uint32_t latency)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    double sig = 0.0;
+    double err = 0.0;
+    for (uint32_t i = latency; i < sample_num; i++) {
+        uint32_t n = i - latency;
+        for (int c = 0; c < ch; c++) {
+            const float *h = ir[c];
+            double ref = 0.0;
+            for (uint32_t k = 0; k < ir_len && k <= n; k++) {
+                ref += (double)h[k] * conv_test_get(in, bits, (n - k) * ch + c);
+            }
+            ref = ref > max_val ? max_val : ref < -max_val - 1 ? -max_val - 1 : ref;
+            double diff = ref - (double)conv_test_get(out, bits, i * ch + c);
+            sig += ref * ref;
+            err += diff * diff;
+        }
+    }
+    return (float)(10.0 * log10((err + 1e-30) / (sig + 1e-30)));
+}
+
+TEST_CASE("Convolution branch test", "AUDIO_EFFECT")
+{
+    float ir_data[64] = {1.0f};
+    const float *ir[2] = {ir_data, ir_data};
+    esp_ae_conv_handle_t handle = NULL;
+    esp_ae_conv_cfg_t cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .partition_size = 64,
+        .ir = ir,
+        .ir_channel = 1,
+        .ir_len = 64,
+        .dry_gain = 0.0f,
+        .wet_gain = 1.0f,
+    };
+    ESP_LOGI(TAG, "esp_ae_conv_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, NULL));
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.partition_size = 100;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.partition_size = 16;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.partition_size = 8192;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.partition_size = 64;
+    cfg.ir = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.ir = ir;
+    cfg.ir_len = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.ir_len = ESP_AE_CONV_MAX_IR_LEN + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.ir_len = 64;
+    cfg.ir_channel = 3;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    cfg.ir_channel = 2;
+    ir[1] = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_open(&cfg, &handle));
+    ir[1] = ir_data;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+    esp_ae_conv_close(handle);
+    cfg.ir_channel = 1;
+    cfg.partition_size = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_conv_get_latency");
+    uint32_t latency = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_get_latency(NULL, &latency));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_get_latency(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_get_latency(handle, &latency));
+    TEST_ASSERT_EQUAL(ESP_AE_CONV_DEFAULT_PARTITION_SIZE, latency);
+
+    ESP_LOGI(TAG, "esp_ae_conv_process");
+    int16_t in[64 * 2] = {0};
+    int16_t out[64 * 2] = {0};
+    esp_ae_sample_t in_ch[2] = {in, in + 64};
+    esp_ae_sample_t out_ch[2] = {out, out + 64};
+    esp_ae_sample_t out_bad[2] = {out, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_process(NULL, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_process(handle, 64, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_process(handle, 64, in, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_process(handle, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_deintlv_process(NULL, 64, in_ch, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_deintlv_process(handle, 64, NULL, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_deintlv_process(handle, 64, in_ch, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_deintlv_process(handle, 64, in_ch, out_bad));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_deintlv_process(handle, 64, in_ch, out_ch));
+
+    ESP_LOGI(TAG, "esp_ae_conv_set_mix");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_set_mix(NULL, 1.0f, 0.5f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_set_mix(handle, NAN, 0.5f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_set_mix(handle, 1.0f, NAN));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_set_mix(handle, 1.0f, 0.5f));
+
+    ESP_LOGI(TAG, "esp_ae_conv_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_conv_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_reset(handle));
+    esp_ae_conv_close(handle);
+    esp_ae_conv_close(NULL);
+}
+
+TEST_CASE("Convolution accuracy test", "AUDIO_EFFECT")
+{
+    float *ir_data[2] = {0};
+    for (int c = 0; c < 2; c++) {
+        ir_data[c] = (float *)malloc(TEST_IR_LEN * sizeof(float));
+        TEST_ASSERT_NOT_NULL(ir_data[c]);
+        conv_test_gen_ir(ir_data[c], TEST_IR_LEN, 0x1234 + c, 0.05f);
+    }
+    const float *ir[2] = {ir_data[0], ir_data[1]};
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+                for (int p = 0; p < AE_TEST_PARAM_NUM(partition_size); p++) {
+                    uint8_t bits = bits_per_sample[b];
+                    uint8_t ch = channel[c];
+                    uint8_t bytes = bits >> 3;
+                    uint32_t sample_num = TEST_DURATION_MS * sample_rate[r] / 1000;
+                    uint32_t frame_size = ch * bytes;
+                    uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *out_cmp = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *in_ch[2] = {0};
+                    uint8_t *out_ch[2] = {0};
+                    TEST_ASSERT_NOT_NULL(in);
+                    TEST_ASSERT_NOT_NULL(out);
+                    TEST_ASSERT_NOT_NULL(out_cmp);
+                    for (int k = 0; k < ch; k++) {
+                        in_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                        out_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                        TEST_ASSERT_NOT_NULL(in_ch[k]);
+                        TEST_ASSERT_NOT_NULL(out_ch[k]);
+                    }
+                    ae_test_generate_sweep_signal(in, TEST_DURATION_MS, sample_rate[r], -12.0f, bits, ch);
+                    for (uint32_t i = 0; i < sample_num; i++) {
+                        for (int k = 0; k < ch; k++) {
+                            memcpy(in_ch[k] + i * bytes, in + (i * ch + k) * bytes, bytes);
+                        }
+                    }
+                    esp_ae_conv_cfg_t cfg = {
+                        .sample_rate = sample_rate[r],
+                        .channel = ch,
+                        .bits_per_sample = bits,
+                        .partition_size = partition_size[p],
+                        .ir = ir,
+                        .ir_channel = ch,
+                        .ir_len = TEST_IR_LEN,
+                        .dry_gain = 0.0f,
+                        .wet_gain = 1.0f,
+                    };
+                    esp_ae_conv_handle_t intlv = NULL;
+                    esp_ae_conv_handle_t deintlv = NULL;
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_open(&cfg, &intlv));
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_open(&cfg, &deintlv));
+                    // Call size not aligned to partition to cover buffering across calls
+                    for (uint32_t pos = 0; pos < sample_num; pos += TEST_CALL_SIZE) {
+                        uint32_t n = sample_num - pos < TEST_CALL_SIZE ? sample_num - pos : TEST_CALL_SIZE;
+                        esp_ae_sample_t src_ch[2];
+                        esp_ae_sample_t dst_ch[2];
+                        for (int k = 0; k < ch; k++) {
+                            src_ch[k] = in_ch[k] + pos * bytes;
+                            dst_ch[k] = out_ch[k] + pos * bytes;
+                        }
+                        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_process(intlv, n, in + pos * frame_size,
+                                                                             out + pos * frame_size));
+                        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_deintlv_process(deintlv, n, src_ch, dst_ch));
+                    }
+                    float err_db = conv_test_check(in, out, ir, TEST_IR_LEN, sample_num, bits, ch, partition_size[p]);
+                    ESP_LOGI(TAG, "rate %d bits %d ch %d partition %d error %.1f dB", (int)sample_rate[r], bits, ch,
+                             partition_size[p], err_db);
+                    // 16 bit output is limited by quantization, wider output by float precision
+                    TEST_ASSERT_LESS_THAN(bits == 16 ? -70.0f : -100.0f, err_db);
+                    for (uint32_t i = 0; i < sample_num; i++) {
+                        for (int k = 0; k < ch; k++) {
+                            memcpy(out_cmp + (i * ch + k) * bytes, out_ch[k] + i * bytes, bytes);
+                        }
+                    }
+                    TEST_ASSERT_EQUAL_MEMORY(out, out_cmp, sample_num * frame_size);
+                    esp_ae_conv_close(intlv);
+                    esp_ae_conv_close(deintlv);
+                    for (int k = 0; k < ch; k++) {
+                        free(in_ch[k]);
+                        free(out_ch[k]);
+                    }
+                    free(in);
+                    free(out);
+                    free(out_cmp);
+                }
+            }
+        }
+    }
+    free(ir_data[0]);
+    free(ir_data[1]);
+}
+
+TEST_CASE("Convolution latency and mix test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint32_t sample_num = 4800;
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sine_signal(in, sample_num * 1000 / srate, srate, -6.0f, 16, ch, 1000.0f);
+    // A unit impulse IR longer than one partition keeps the input unchanged apart from the latency
+    float ir_data[300] = {1.0f};
+    const float *ir[1] = {ir_data};
+    esp_ae_conv_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = 16,
+        .partition_size = 128,
+        .ir = ir,
+        .ir_channel = 1,
+        .ir_len = AE_TEST_PARAM_NUM(ir_data),
+        .dry_gain = 0.0f,
+        .wet_gain = 1.0f,
+    };
+    esp_ae_conv_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_open(&cfg, &handle));
+    uint32_t latency = 0;
+    esp_ae_conv_get_latency(handle, &latency);
+    TEST_ASSERT_EQUAL(128, latency);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_process(handle, sample_num, in, out));
+    for (uint32_t i = 0; i < latency * ch; i++) {
+        TEST_ASSERT_EQUAL(0, out[i]);
+    }
+    for (uint32_t i = latency * ch; i < sample_num * ch; i++) {
+        TEST_ASSERT_INT_WITHIN(1, in[i - latency * ch], out[i]);
+    }
+
+    // Dry only after reset gives the exactly delayed input, processed inplace
+    int16_t *buf = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(buf);
+    memcpy(buf, in, sample_num * sizeof(int16_t) * ch);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_reset(handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_set_mix(handle, 1.0f, 0.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_process(handle, sample_num, buf, buf));
+    TEST_ASSERT_EQUAL_MEMORY(in, buf + latency * ch, (sample_num - latency) * sizeof(int16_t) * ch);
+
+    // Dry and wet in opposite phase cancel
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_reset(handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_set_mix(handle, 1.0f, -1.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_conv_process(handle, sample_num, in, out));
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        TEST_ASSERT_INT_WITHIN(1, 0, out[i]);
+    }
+    esp_ae_conv_close(handle);
+    free(in);
+    free(out);
+    free(buf);
+}
+
+TEST_CASE("Convolution performance test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint32_t ir_len[] = {1024, 4096, 16384, 32768};
+    uint32_t sample_num = 480;
+    uint32_t loop = 100;
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t));
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t));
+    float *ir_data = (float *)malloc(ir_len[AE_TEST_PARAM_NUM(ir_len) - 1] * sizeof(float));
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_NOT_NULL(ir_data);
+    ae_test_generate_sine_signal(in, 10, srate, -20.0f, 16, 1, 1000.0f);
+    // Long IR spectra need PSRAM on most boards
+    bool use_psram = heap_caps_get_free_size(MALLOC_CAP_SPIRAM) > 0;
+    const float *ir[1] = {ir_data};
+    for (int l = 0; l < AE_TEST_PARAM_NUM(ir_len); l++) {
+        conv_test_gen_ir(ir_data, ir_len[l], 0x5678, 0.05f);
+        for (int p = 0; p < AE_TEST_PARAM_NUM(partition_size); p++) {
+            esp_ae_conv_cfg_t cfg = {
+                .sample_rate = srate,
+                .channel = 1,
+                .bits_per_sample = 16,
+                .partition_size = partition_size[p],
+                .ir = ir,
+                .ir_channel = 1,
+                .ir_len = ir_len[l],
+                .dry_gain = 0.0f,
+                .wet_gain = 1.0f,
+                .use_psram = use_psram,
+            };
+            esp_ae_conv_handle_t handle = NULL;
+            if (esp_ae_conv_open(&cfg, &handle) != ESP_AE_ERR_OK) {
+                ESP_LOGW(TAG, "Skip ir_len %d partition %d for memory", (int)ir_len[l], partition_size[p]);
+                continue;
+            }
+            uint64_t cycles = 0;
+            for (uint32_t i = 0; i < loop; i++) {
+                uint32_t start = esp_cpu_get_cycle_count();
+                esp_ae_conv_process(handle, sample_num, in, out);
+                cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+            }
+            printf("CONV_PERF,ir_len=%d,partition=%d,psram=%d,latency_ms=%.2f,cycles_per_sample=%.2f\n",
+                   (int)ir_len[l], partition_size[p], use_psram, partition_size[p] * 1000.0f / srate,
+                   (float)cycles / (sample_num * loop));
+            esp_ae_conv_close(handle);
+        }
+    }
+    free(in);
+    free(out);
+    free(ir_data);
+}
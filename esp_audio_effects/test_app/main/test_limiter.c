@@ -0,0 +1,391 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_limiter.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_LIMITER"
+#define TEST_DURATION_MS 200
+#define TEST_CALL_SIZE   100
+#define TEST_CEILING_DB  (-1.0f)
+#define TEST_REF_TAPS    64
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+static esp_ae_limiter_detect_t detect_mode[] = {ESP_AE_LIMITER_DETECT_SAMPLE_PEAK, ESP_AE_LIMITER_DETECT_TRUE_PEAK};
+
+static double limiter_test_get(const uint8_t *buf, uint8_t bits, uint32_t idx)
+{
+    double scale = (double)(1ULL << (bits - 1));
+    switch (bits) {
+        case 16:
+            return ((const int16_t *)buf)[idx] / scale;
+        case 24: {
+            const uint8_t *p = buf + idx * 3;
+            return ((int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8) / scale;
+        }
+        default:
+            return ((const int32_t *)buf)[idx] / scale;
+    }
+}
+
+static void limiter_test_set(uint8_t *buf, uint8_t bits, uint32_t idx, double v)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    v *= max_val + 1.0;
+    v = v > max_val ? max_val : v < -max_val - 1.0 ? -max_val - 1.0 : v;
+    int32_t s = (int32_t)lrint(v);
+    switch (bits) {
+        case 16:
+            ((int16_t *)buf)[idx] = (int16_t)s;
+            break;
+        case 24: {
+            uint8_t *p = buf + idx * 3;
+            p[0] = (uint8_t)s;
+            p[1] = (uint8_t)(s >> 8);
+            p[2] = (uint8_t)(s >> 16);
+            break;
+        }
+        default:
+            ((int32_t *)buf)[idx] = s;
+            break;
+    }
+}
+
+/**
+ * Quiet tone with loud bursts and single sample clicks, the bursts are a quarter of the sample rate at 45 degree
+ * phase so that the true peak is 3 dB above the sample peak
+ */
+static void limiter_test_gen(uint8_t *buf, uint32_t sample_num, uint32_t srate, uint8_t bits, uint8_t ch)
+{
+    for (uint32_t i = 0; i < sample_num; i++) {
+        double v = 0.1 * sin(2.0 * M_PI * 997.0 * i / srate);
+        uint32_t seg = i * 8 / sample_num;
+        if (seg == 2 || seg == 5) {
+            v += 0.95 * sin(M_PI / 2.0 * i + M_PI / 4.0);
+        }
+        if (i % 1000 == 777) {
+            v = (i / 1000) & 1 ? -1.0 : 1.0;
+        }
+        for (int c = 0; c < ch; c++) {
+            limiter_test_set(buf, bits, i * ch + c, c ? -v : v);
+        }
+    }
+}
+
+/**
+ * Reference true peak by 4x oversampling with a long windowed sinc interpolator
+ */
+static double limiter_test_true_peak(const uint8_t *buf, uint32_t sample_num, uint8_t bits, uint8_t ch)
+{
+    double peak = 0.0;
+    for (int c = 0; c < ch; c++) {
+        for (uint32_t i = TEST_REF_TAPS; i + TEST_REF_TAPS < sample_num; i++) {
+            for (int p = 0; p < 4; p++) {
+                double acc = 0.0;
+                for (int j = -TEST_REF_TAPS + 1; j <= TEST_REF_TAPS; j++) {
+                    double t = p / 4.0 - j;
+                    double sinc = fabs(t) < 1e-9 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+                    double win = 0.42 + 0.5 * cos(M_PI * t / TEST_REF_TAPS) + 0.08 * cos(2.0 * M_PI * t / TEST_REF_TAPS);
+                    acc += limiter_test_get(buf, bits, (i + j) * ch + c) * sinc * win;
+                }
+                peak = fabs(acc) > peak ? fabs(acc) : peak;
+            }
+        }
+    }
+    return peak;
+}
+
+TEST_CASE("Limiter branch test", "AUDIO_EFFECT")
+{
+    esp_ae_limiter_handle_t handle = NULL;
+    esp_ae_limiter_cfg_t cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .detect_mode = ESP_AE_LIMITER_DETECT_TRUE_PEAK,
+        .lookahead_ms = 1.5f,
+        .ceiling_db = -1.0f,
+        .release_ms = 50.0f,
+    };
+    ESP_LOGI(TAG, "esp_ae_limiter_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, NULL));
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.detect_mode = ESP_AE_LIMITER_DETECT_MAX;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.detect_mode = ESP_AE_LIMITER_DETECT_TRUE_PEAK;
+    cfg.lookahead_ms = 0.4f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.lookahead_ms = 5.1f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.lookahead_ms = 1.5f;
+    cfg.ceiling_db = 0.1f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.ceiling_db = NAN;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.ceiling_db = -1.0f;
+    cfg.release_ms = 0.5f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_open(&cfg, &handle));
+    cfg.release_ms = 50.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_limiter_get_latency");
+    uint32_t latency = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_get_latency(NULL, &latency));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_get_latency(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_get_latency(handle, &latency));
+    TEST_ASSERT_EQUAL(72 + ESP_AE_LIMITER_TRUE_PEAK_DELAY, latency);
+
+    ESP_LOGI(TAG, "esp_ae_limiter_process");
+    int16_t in[64 * 2] = {0};
+    int16_t out[64 * 2] = {0};
+    esp_ae_sample_t in_ch[2] = {in, in + 64};
+    esp_ae_sample_t out_ch[2] = {out, out + 64};
+    esp_ae_sample_t out_bad[2] = {out, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_process(NULL, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_process(handle, 64, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_process(handle, 64, in, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_process(handle, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_deintlv_process(NULL, 64, in_ch, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_deintlv_process(handle, 64, NULL, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_deintlv_process(handle, 64, in_ch, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_deintlv_process(handle, 64, in_ch, out_bad));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_deintlv_process(handle, 64, in_ch, out_ch));
+
+    ESP_LOGI(TAG, "esp_ae_limiter_set_ceiling");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_set_ceiling(NULL, -3.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_set_ceiling(handle, -31.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_set_ceiling(handle, NAN));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_set_ceiling(handle, -3.0f));
+
+    ESP_LOGI(TAG, "esp_ae_limiter_set_release");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_set_release(NULL, 100.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_set_release(handle, 2001.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_set_release(handle, 100.0f));
+
+    ESP_LOGI(TAG, "esp_ae_limiter_get_gain_reduction");
+    float gain_db = -1.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_get_gain_reduction(NULL, &gain_db));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_get_gain_reduction(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_get_gain_reduction(handle, &gain_db));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gain_db);
+
+    ESP_LOGI(TAG, "esp_ae_limiter_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_limiter_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_reset(handle));
+    esp_ae_limiter_close(handle);
+    esp_ae_limiter_close(NULL);
+}
+
+TEST_CASE("Limiter ceiling test", "AUDIO_EFFECT")
+{
+    double ceiling = pow(10.0, TEST_CEILING_DB / 20.0);
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+                for (int m = 0; m < AE_TEST_PARAM_NUM(detect_mode); m++) {
+                    uint8_t bits = bits_per_sample[b];
+                    uint8_t ch = channel[c];
+                    uint8_t bytes = bits >> 3;
+                    uint32_t sample_num = TEST_DURATION_MS * sample_rate[r] / 1000;
+                    uint32_t frame_size = ch * bytes;
+                    uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *out_cmp = (uint8_t *)calloc(sample_num, frame_size);
+                    uint8_t *in_ch[2] = {0};
+                    uint8_t *out_ch[2] = {0};
+                    TEST_ASSERT_NOT_NULL(in);
+                    TEST_ASSERT_NOT_NULL(out);
+                    TEST_ASSERT_NOT_NULL(out_cmp);
+                    for (int k = 0; k < ch; k++) {
+                        in_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                        out_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                        TEST_ASSERT_NOT_NULL(in_ch[k]);
+                        TEST_ASSERT_NOT_NULL(out_ch[k]);
+                    }
+                    limiter_test_gen(in, sample_num, sample_rate[r], bits, ch);
+                    for (uint32_t i = 0; i < sample_num; i++) {
+                        for (int k = 0; k < ch; k++) {
+                            memcpy(in_ch[k] + i * bytes, in + (i * ch + k) * bytes, bytes);
+                        }
+                    }
+                    esp_ae_limiter_cfg_t cfg = {
+                        .sample_rate = sample_rate[r],
+                        .channel = ch,
+                        .bits_per_sample = bits,
+                        .detect_mode = detect_mode[m],
+                        .lookahead_ms = 2.0f,
+                        .ceiling_db = TEST_CEILING_DB,
+                        .release_ms = 50.0f,
+                    };
+                    esp_ae_limiter_handle_t intlv = NULL;
+                    esp_ae_limiter_handle_t deintlv = NULL;
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_open(&cfg, &intlv));
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_open(&cfg, &deintlv));
+                    for (uint32_t pos = 0; pos < sample_num; pos += TEST_CALL_SIZE) {
+                        uint32_t n = sample_num - pos < TEST_CALL_SIZE ? sample_num - pos : TEST_CALL_SIZE;
+                        esp_ae_sample_t src_ch[2];
+                        esp_ae_sample_t dst_ch[2];
+                        for (int k = 0; k < ch; k++) {
+                            src_ch[k] = in_ch[k] + pos * bytes;
+                            dst_ch[k] = out_ch[k] + pos * bytes;
+                        }
+                        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_process(intlv, n, in + pos * frame_size,
+                                                                                out + pos * frame_size));
+                        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_deintlv_process(deintlv, n, src_ch, dst_ch));
+                    }
+                    // Sample peak never exceeds the ceiling in any mode
+                    double sample_peak = 0.0;
+                    for (uint32_t i = 0; i < sample_num * ch; i++) {
+                        double v = fabs(limiter_test_get(out, bits, i));
+                        sample_peak = v > sample_peak ? v : sample_peak;
+                    }
+                    double true_peak = limiter_test_true_peak(out, sample_num, bits, ch);
+                    ESP_LOGI(TAG, "rate %d bits %d ch %d mode %d sample peak %.2f dB true peak %.2f dB",
+                             (int)sample_rate[r], bits, ch, detect_mode[m], 20.0 * log10(sample_peak),
+                             20.0 * log10(true_peak));
+                    TEST_ASSERT_TRUE(sample_peak <= ceiling);
+                    // Limiting must really happen on the bursts instead of only clamping
+                    TEST_ASSERT_TRUE(sample_peak > ceiling * 0.8);
+                    if (detect_mode[m] == ESP_AE_LIMITER_DETECT_TRUE_PEAK) {
+                        TEST_ASSERT_TRUE(20.0 * log10(true_peak / ceiling) < 0.2);
+                    }
+                    for (uint32_t i = 0; i < sample_num; i++) {
+                        for (int k = 0; k < ch; k++) {
+                            memcpy(out_cmp + (i * ch + k) * bytes, out_ch[k] + i * bytes, bytes);
+                        }
+                    }
+                    TEST_ASSERT_EQUAL_MEMORY(out, out_cmp, sample_num * frame_size);
+                    esp_ae_limiter_close(intlv);
+                    esp_ae_limiter_close(deintlv);
+                    for (int k = 0; k < ch; k++) {
+                        free(in_ch[k]);
+                        free(out_ch[k]);
+                    }
+                    free(in);
+                    free(out);
+                    free(out_cmp);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Limiter transparency and gain reduction test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint32_t sample_num = 9600;
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    esp_ae_limiter_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = 16,
+        .detect_mode = ESP_AE_LIMITER_DETECT_TRUE_PEAK,
+        .lookahead_ms = 1.0f,
+        .ceiling_db = -1.0f,
+        .release_ms = 20.0f,
+    };
+    esp_ae_limiter_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_open(&cfg, &handle));
+    uint32_t latency = 0;
+    esp_ae_limiter_get_latency(handle, &latency);
+    TEST_ASSERT_EQUAL(48 + ESP_AE_LIMITER_TRUE_PEAK_DELAY, latency);
+
+    // Below the ceiling the input only gets delayed, inplace processing
+    ae_test_generate_sine_signal(in, sample_num * 1000 / srate, srate, -6.0f, 16, ch, 1000.0f);
+    memcpy(out, in, sample_num * sizeof(int16_t) * ch);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_process(handle, sample_num, out, out));
+    for (uint32_t i = 0; i < latency * ch; i++) {
+        TEST_ASSERT_EQUAL(0, out[i]);
+    }
+    TEST_ASSERT_EQUAL_MEMORY(in, out + latency * ch, (sample_num - latency) * sizeof(int16_t) * ch);
+    float gain_db = -1.0f;
+    esp_ae_limiter_get_gain_reduction(handle, &gain_db);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gain_db);
+
+    // Lower ceiling by 6 dB gives about 6 dB gain reduction once settled
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_set_ceiling(handle, -12.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_process(handle, sample_num, in, out));
+    esp_ae_limiter_get_gain_reduction(handle, &gain_db);
+    ESP_LOGI(TAG, "Gain reduction %.2f dB", gain_db);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -6.0f, gain_db);
+    int16_t limit = (int16_t)(32768.0f * powf(10.0f, -12.0f / 20.0f));
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        TEST_ASSERT_TRUE(abs(out[i]) <= limit);
+    }
+
+    // Release back to no reduction after the ceiling is raised
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_set_ceiling(handle, 0.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_process(handle, sample_num, in, out));
+    esp_ae_limiter_get_gain_reduction(handle, &gain_db);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, gain_db);
+    esp_ae_limiter_close(handle);
+    free(in);
+    free(out);
+}
+
+TEST_CASE("Limiter performance test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint32_t sample_num = 480;
+    uint32_t loop = 100;
+    float lookahead_ms[] = {0.5f, 5.0f};
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sine_signal(in, 10, srate, 0.0f, 16, ch, 1000.0f);
+    for (int m = 0; m < AE_TEST_PARAM_NUM(detect_mode); m++) {
+        for (int l = 0; l < AE_TEST_PARAM_NUM(lookahead_ms); l++) {
+            esp_ae_limiter_cfg_t cfg = {
+                .sample_rate = srate,
+                .channel = ch,
+                .bits_per_sample = 16,
+                .detect_mode = detect_mode[m],
+                .lookahead_ms = lookahead_ms[l],
+                .ceiling_db = -3.0f,
+                .release_ms = 50.0f,
+            };
+            esp_ae_limiter_handle_t handle = NULL;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_limiter_open(&cfg, &handle));
+            uint64_t cycles = 0;
+            for (uint32_t i = 0; i < loop; i++) {
+                uint32_t start = esp_cpu_get_cycle_count();
+                esp_ae_limiter_process(handle, sample_num, in, out);
+                cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+            }
+            printf("LIMITER_PERF,mode=%s,lookahead_ms=%.1f,channel=%d,cycles_per_sample=%.2f\n",
+                   detect_mode[m] == ESP_AE_LIMITER_DETECT_TRUE_PEAK ? "true_peak" : "sample_peak", lookahead_ms[l], ch,
+                   (float)cycles / (sample_num * loop));
+            esp_ae_limiter_close(handle);
+        }
+    }
+    free(in);
+    free(out);
+}
@@ -0,0 +1,439 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_loudness.h"
+#include "ae_common.h"
+
+#define TAG            "TEST_LOUDNESS"
+#define TEST_CALL_SIZE 1000
+#define TEST_TONE_HZ   1000.0
+
+static uint32_t sample_rate[]     = {16000, 44100, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+
+typedef struct {
+    uint32_t  sample_rate;
+    uint8_t   channel;
+    uint8_t   bits;
+    uint32_t  pos;  /*!< Tone phase in sampling points */
+    uint8_t  *buf;  /*!< TEST_CALL_SIZE interleaved sampling points */
+} loudness_test_src_t;
+
+static void loudness_test_set(uint8_t *buf, uint8_t bits, uint32_t idx, double v)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    v *= max_val + 1.0;
+    v = v > max_val ? max_val : v < -max_val - 1.0 ? -max_val - 1.0 : v;
+    int32_t s = (int32_t)lrint(v);
+    switch (bits) {
+        case 16:
+            ((int16_t *)buf)[idx] = (int16_t)s;
+            break;
+        case 24: {
+            uint8_t *p = buf + idx * 3;
+            p[0] = (uint8_t)s;
+            p[1] = (uint8_t)(s >> 8);
+            p[2] = (uint8_t)(s >> 16);
+            break;
+        }
+        default:
+            ((int32_t *)buf)[idx] = s;
+            break;
+    }
+}
+
+/**
+ * Fill one call of 1 kHz tone at `level_db` dBFS peak on all channels, 0 level gives silence
+ */
+static uint32_t loudness_test_fill(loudness_test_src_t *src, float level_db, uint32_t remain)
+{
+    uint32_t n = remain < TEST_CALL_SIZE ? remain : TEST_CALL_SIZE;
+    double amp = level_db < 0.0f ? pow(10.0, level_db / 20.0) : 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double v = amp * sin(2.0 * M_PI * TEST_TONE_HZ * (src->pos + i) / src->sample_rate);
+        for (int c = 0; c < src->channel; c++) {
+            loudness_test_set(src->buf, src->bits, i * src->channel + c, v);
+        }
+    }
+    src->pos += n;
+    return n;
+}
+
+static void loudness_test_feed(esp_ae_loudness_handle_t handle, loudness_test_src_t *src, float level_db, float second)
+{
+    uint32_t remain = (uint32_t)(second * src->sample_rate);
+    while (remain > 0) {
+        uint32_t n = loudness_test_fill(src, level_db, remain);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_process(handle, n, src->buf, src->buf));
+        remain -= n;
+    }
+}
+
+TEST_CASE("Loudness branch test", "AUDIO_EFFECT")
+{
+    esp_ae_loudness_handle_t handle = NULL;
+    esp_ae_loudness_cfg_t cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .mode = ESP_AE_LOUDNESS_MODE_NORMALIZE,
+        .target_lufs = -16.0f,
+        .max_gain_db = 12.0f,
+        .response_ms = 3000.0f,
+    };
+    ESP_LOGI(TAG, "esp_ae_loudness_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, NULL));
+    cfg.sample_rate = 4000;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.sample_rate = 48000;
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.mode = ESP_AE_LOUDNESS_MODE_MAX;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.mode = ESP_AE_LOUDNESS_MODE_NORMALIZE;
+    cfg.target_lufs = -41.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.target_lufs = NAN;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.target_lufs = -16.0f;
+    cfg.max_gain_db = 31.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    cfg.max_gain_db = 12.0f;
+    cfg.response_ms = 50.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_open(&cfg, &handle));
+    // Normalizer parameters are not checked in meter mode
+    cfg.mode = ESP_AE_LOUDNESS_MODE_METER;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+    esp_ae_loudness_close(handle);
+    cfg.mode = ESP_AE_LOUDNESS_MODE_NORMALIZE;
+    cfg.response_ms = 3000.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_loudness_process");
+    int16_t in[64 * 2] = {0};
+    int16_t out[64 * 2] = {0};
+    esp_ae_sample_t in_ch[2] = {in, in + 64};
+    esp_ae_sample_t out_ch[2] = {out, out + 64};
+    esp_ae_sample_t out_bad[2] = {out, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_process(NULL, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_process(handle, 64, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_process(handle, 64, in, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_process(handle, 64, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_deintlv_process(NULL, 64, in_ch, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_deintlv_process(handle, 64, NULL, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_deintlv_process(handle, 64, in_ch, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_deintlv_process(handle, 64, in_ch, out_bad));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_deintlv_process(handle, 64, in_ch, out_ch));
+
+    ESP_LOGI(TAG, "esp_ae_loudness_get_info");
+    esp_ae_loudness_info_t info = {0};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_get_info(NULL, &info));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_get_info(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_get_info(handle, &info));
+    TEST_ASSERT_EQUAL_FLOAT(ESP_AE_LOUDNESS_SILENCE_LUFS, info.momentary);
+    TEST_ASSERT_EQUAL_FLOAT(ESP_AE_LOUDNESS_SILENCE_LUFS, info.integrated);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, info.range);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, info.gain_db);
+
+    ESP_LOGI(TAG, "esp_ae_loudness_set_target");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_set_target(NULL, -23.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_set_target(handle, -4.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_set_target(handle, -23.0f));
+
+    ESP_LOGI(TAG, "esp_ae_loudness_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_loudness_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_reset(handle));
+    esp_ae_loudness_close(handle);
+    esp_ae_loudness_close(NULL);
+}
+
+TEST_CASE("Loudness meter accuracy test", "AUDIO_EFFECT")
+{
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+                loudness_test_src_t src = {
+                    .sample_rate = sample_rate[r],
+                    .channel = channel[c],
+                    .bits = bits_per_sample[b],
+                };
+                src.buf = (uint8_t *)calloc(TEST_CALL_SIZE, src.channel * (src.bits >> 3));
+                TEST_ASSERT_NOT_NULL(src.buf);
+                esp_ae_loudness_cfg_t cfg = {
+                    .sample_rate = src.sample_rate,
+                    .channel = src.channel,
+                    .bits_per_sample = src.bits,
+                    .mode = ESP_AE_LOUDNESS_MODE_METER,
+                };
+                esp_ae_loudness_handle_t handle = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+                // EBU Tech 3341 case 3 shortened: the quiet parts are removed by the relative gate,
+                // a 1 kHz stereo tone at -23 dBFS reads -23 LUFS and mono reads 3 dB less
+                float expect = -23.0f + 10.0f * log10f(src.channel / 2.0f);
+                esp_ae_loudness_info_t info = {0};
+                loudness_test_feed(handle, &src, -36.0f, 5.0f);
+                loudness_test_feed(handle, &src, -23.0f, 20.0f);
+                esp_ae_loudness_get_info(handle, &info);
+                ESP_LOGI(TAG, "rate %d bits %d ch %d momentary %.2f short-term %.2f", (int)src.sample_rate, src.bits,
+                         src.channel, info.momentary, info.short_term);
+                TEST_ASSERT_FLOAT_WITHIN(0.1f, expect, info.momentary);
+                TEST_ASSERT_FLOAT_WITHIN(0.1f, expect, info.short_term);
+                loudness_test_feed(handle, &src, -36.0f, 5.0f);
+                esp_ae_loudness_get_info(handle, &info);
+                ESP_LOGI(TAG, "integrated %.2f range %.2f", info.integrated, info.range);
+                TEST_ASSERT_FLOAT_WITHIN(0.1f, expect, info.integrated);
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, info.gain_db);
+                // Reset starts a new measurement
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_reset(handle));
+                loudness_test_feed(handle, &src, 0.0f, 1.0f);
+                esp_ae_loudness_get_info(handle, &info);
+                TEST_ASSERT_EQUAL_FLOAT(ESP_AE_LOUDNESS_SILENCE_LUFS, info.short_term);
+                TEST_ASSERT_EQUAL_FLOAT(ESP_AE_LOUDNESS_SILENCE_LUFS, info.integrated);
+                esp_ae_loudness_close(handle);
+                free(src.buf);
+            }
+        }
+    }
+}
+
+/**
+ * Momentary loudness of 1 s of 1 kHz tone at -23 dBFS on channel `target` only of a `ch` channel stream
+ */
+static float loudness_test_single_channel(uint8_t ch, uint8_t target)
+{
+    uint32_t srate = 48000;
+    uint8_t bits = 16;
+    int16_t *buf = (int16_t *)calloc(srate, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(buf);
+    double amp = pow(10.0, -23.0 / 20.0);
+    for (uint32_t i = 0; i < srate; i++) {
+        loudness_test_set((uint8_t *)buf, bits, i * ch + target, amp * sin(2.0 * M_PI * TEST_TONE_HZ * i / srate));
+    }
+    esp_ae_loudness_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .mode = ESP_AE_LOUDNESS_MODE_METER,
+    };
+    esp_ae_loudness_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_process(handle, srate, buf, buf));
+    esp_ae_loudness_info_t info = {0};
+    esp_ae_loudness_get_info(handle, &info);
+    esp_ae_loudness_close(handle);
+    free(buf);
+    return info.momentary;
+}
+
+TEST_CASE("Loudness surround channel weight test", "AUDIO_EFFECT")
+{
+    // One channel of a -23 dBFS stereo tone reads 3 dB less, side surround channels read 1.5 dB more
+    float front = -26.01f;
+    float side = front + 10.0f * log10f(1.41f);
+    const struct {
+        uint8_t channel;
+        uint8_t target;
+        float   expect;
+    } weight_cfg[] = {
+        {5, 2, front},
+        {5, 3, side},
+        {6, 0, front},
+        {6, 3, ESP_AE_LOUDNESS_SILENCE_LUFS},
+        {6, 5, side},
+        {8, 3, ESP_AE_LOUDNESS_SILENCE_LUFS},
+        {8, 4, front},
+        {8, 6, side},
+        {4, 3, front},
+    };
+    for (int i = 0; i < AE_TEST_PARAM_NUM(weight_cfg); i++) {
+        float momentary = loudness_test_single_channel(weight_cfg[i].channel, weight_cfg[i].target);
+        ESP_LOGI(TAG, "ch %d target %d momentary %.2f", weight_cfg[i].channel, weight_cfg[i].target, momentary);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, weight_cfg[i].expect, momentary);
+    }
+}
+
+TEST_CASE("Loudness range test", "AUDIO_EFFECT")
+{
+    // EBU Tech 3342 cases 1 and 2: 20 s of tone at two levels gives the level difference as loudness range
+    float low_db[] = {-30.0f, -35.0f};
+    float expect[] = {10.0f, 5.0f};
+    loudness_test_src_t src = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits = 16,
+    };
+    src.buf = (uint8_t *)calloc(TEST_CALL_SIZE, src.channel * (src.bits >> 3));
+    TEST_ASSERT_NOT_NULL(src.buf);
+    esp_ae_loudness_cfg_t cfg = {
+        .sample_rate = src.sample_rate,
+        .channel = src.channel,
+        .bits_per_sample = src.bits,
+        .mode = ESP_AE_LOUDNESS_MODE_METER,
+    };
+    esp_ae_loudness_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+    for (int i = 0; i < AE_TEST_PARAM_NUM(low_db); i++) {
+        esp_ae_loudness_reset(handle);
+        float high_db = low_db[i] + expect[i];
+        loudness_test_feed(handle, &src, high_db, 20.0f);
+        loudness_test_feed(handle, &src, low_db[i], 20.0f);
+        esp_ae_loudness_info_t info = {0};
+        esp_ae_loudness_get_info(handle, &info);
+        ESP_LOGI(TAG, "Levels %.1f/%.1f dBFS range %.2f LU", high_db, low_db[i], info.range);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, expect[i], info.range);
+    }
+    esp_ae_loudness_close(handle);
+    free(src.buf);
+}
+
+TEST_CASE("Loudness normalizer test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    float target = -18.0f;
+    esp_ae_loudness_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = 16,
+        .mode = ESP_AE_LOUDNESS_MODE_NORMALIZE,
+        .target_lufs = target,
+        .max_gain_db = 20.0f,
+        .response_ms = 1000.0f,
+    };
+    esp_ae_loudness_handle_t intlv = NULL;
+    esp_ae_loudness_handle_t deintlv = NULL;
+    esp_ae_loudness_handle_t meter = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &intlv));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &deintlv));
+    cfg.mode = ESP_AE_LOUDNESS_MODE_METER;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &meter));
+    loudness_test_src_t src = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits = 16,
+    };
+    src.buf = (uint8_t *)calloc(TEST_CALL_SIZE, ch * sizeof(int16_t));
+    int16_t *out = (int16_t *)calloc(TEST_CALL_SIZE, ch * sizeof(int16_t));
+    int16_t *in_ch[2] = {0};
+    int16_t *out_ch[2] = {0};
+    TEST_ASSERT_NOT_NULL(src.buf);
+    TEST_ASSERT_NOT_NULL(out);
+    for (int k = 0; k < ch; k++) {
+        in_ch[k] = (int16_t *)calloc(TEST_CALL_SIZE, sizeof(int16_t));
+        out_ch[k] = (int16_t *)calloc(TEST_CALL_SIZE, sizeof(int16_t));
+        TEST_ASSERT_NOT_NULL(in_ch[k]);
+        TEST_ASSERT_NOT_NULL(out_ch[k]);
+    }
+    // Quiet program is boosted, the pause holds the gain, loud program is cut
+    float level_db[] = {-30.0f, 0.0f, -10.0f};
+    float second[] = {10.0f, 5.0f, 10.0f};
+    float expect_gain[] = {12.0f, 12.0f, -8.0f};
+    for (int s = 0; s < AE_TEST_PARAM_NUM(level_db); s++) {
+        uint32_t remain = (uint32_t)(second[s] * srate);
+        while (remain > 0) {
+            uint32_t n = loudness_test_fill(&src, level_db[s], remain);
+            int16_t *in = (int16_t *)src.buf;
+            for (uint32_t i = 0; i < n; i++) {
+                for (int k = 0; k < ch; k++) {
+                    in_ch[k][i] = in[i * ch + k];
+                }
+            }
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_process(intlv, n, src.buf, out));
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_deintlv_process(deintlv, n, (esp_ae_sample_t *)in_ch,
+                                                                             (esp_ae_sample_t *)out_ch));
+            for (uint32_t i = 0; i < n; i++) {
+                for (int k = 0; k < ch; k++) {
+                    TEST_ASSERT_EQUAL_INT16(out[i * ch + k], out_ch[k][i]);
+                }
+            }
+            esp_ae_loudness_process(meter, n, out, out);
+            remain -= n;
+        }
+        esp_ae_loudness_info_t info = {0};
+        esp_ae_loudness_info_t out_info = {0};
+        esp_ae_loudness_get_info(intlv, &info);
+        esp_ae_loudness_get_info(meter, &out_info);
+        ESP_LOGI(TAG, "Input %.2f LUFS gain %.2f dB output %.2f LUFS", info.short_term, info.gain_db,
+                 out_info.short_term);
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, expect_gain[s], info.gain_db);
+        if (level_db[s] < 0.0f) {
+            TEST_ASSERT_FLOAT_WITHIN(1.0f, target, out_info.short_term);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_reset(intlv));
+    esp_ae_loudness_info_t info = {0};
+    esp_ae_loudness_get_info(intlv, &info);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, info.gain_db);
+    esp_ae_loudness_close(intlv);
+    esp_ae_loudness_close(deintlv);
+    esp_ae_loudness_close(meter);
+    for (int k = 0; k < ch; k++) {
+        free(in_ch[k]);
+        free(out_ch[k]);
+    }
+    free(src.buf);
+    free(out);
+}
+
+TEST_CASE("Loudness performance test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint32_t sample_num = 480;
+    uint32_t loop = 100;
+    esp_ae_loudness_mode_t mode[] = {ESP_AE_LOUDNESS_MODE_METER, ESP_AE_LOUDNESS_MODE_NORMALIZE};
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sine_signal(in, 10, srate, -20.0f, 16, ch, 1000.0f);
+    for (int m = 0; m < AE_TEST_PARAM_NUM(mode); m++) {
+        esp_ae_loudness_cfg_t cfg = {
+            .sample_rate = srate,
+            .channel = ch,
+            .bits_per_sample = 16,
+            .mode = mode[m],
+            .target_lufs = -16.0f,
+            .max_gain_db = 12.0f,
+            .response_ms = 3000.0f,
+        };
+        esp_ae_loudness_handle_t handle = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_loudness_open(&cfg, &handle));
+        uint64_t cycles = 0;
+        for (uint32_t i = 0; i < loop; i++) {
+            uint32_t start = esp_cpu_get_cycle_count();
+            esp_ae_loudness_process(handle, sample_num, in, out);
+            cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+        }
+        esp_ae_loudness_info_t info = {0};
+        uint32_t start = esp_cpu_get_cycle_count();
+        esp_ae_loudness_get_info(handle, &info);
+        uint32_t info_cycles = esp_cpu_get_cycle_count() - start;
+        printf("LOUDNESS_PERF,mode=%s,channel=%d,cycles_per_sample=%.2f,get_info_cycles=%d\n",
+               mode[m] == ESP_AE_LOUDNESS_MODE_METER ? "meter" : "normalize", ch, (float)cycles / (sample_num * loop),
+               (int)info_cycles);
+        esp_ae_loudness_close(handle);
+    }
+    free(in);
+    free(out);
+}
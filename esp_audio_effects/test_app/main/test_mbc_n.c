@@ -0,0 +1,388 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_mbc_n.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_MBC_N"
+#define TEST_DURATION_MS 500
+#define TEST_CALL_SIZE   300
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+static uint8_t  band_num[]        = {2, 4, 8};
+
+static const uint32_t test_fc[ESP_AE_MBC_N_MAX_BAND_NUM - 1] = {80, 200, 500, 1000, 2000, 4000, 6000};
+
+static const char *crossover_name[ESP_AE_MBC_N_CROSSOVER_MAX] = {"iir", "linear_phase"};
+
+static void mbc_n_test_init_cfg(esp_ae_mbc_n_cfg_t *cfg, uint32_t srate, uint8_t ch, uint8_t bits, uint8_t bands,
+                                esp_ae_mbc_n_crossover_t crossover)
+{
+    memset(cfg, 0, sizeof(esp_ae_mbc_n_cfg_t));
+    cfg->sample_rate = srate;
+    cfg->channel = ch;
+    cfg->bits_per_sample = bits;
+    cfg->band_num = bands;
+    cfg->crossover = crossover;
+    // Spread the crossovers over the test table so that every band count covers low to high frequencies
+    for (int i = 0; i < bands - 1; i++) {
+        cfg->fc[i] = test_fc[(i + 1) * (ESP_AE_MBC_N_MAX_BAND_NUM - 1) / bands];
+    }
+    for (int i = 0; i < bands; i++) {
+        cfg->mbc_para[i] = (esp_ae_mbc_para_t) {
+            .threshold = -20.0f,
+            .ratio = 1.0f,
+            .makeup_gain = 0.0f,
+            .attack_time = 5,
+            .release_time = 100,
+            .hold_time = 0,
+            .knee_width = 0.0f,
+        };
+    }
+}
+
+static void mbc_n_test_process(esp_ae_mbc_n_handle_t handle, uint8_t *buf, uint32_t sample_num, uint32_t frame_size)
+{
+    for (uint32_t pos = 0; pos < sample_num; pos += TEST_CALL_SIZE) {
+        uint32_t n = sample_num - pos > TEST_CALL_SIZE ? TEST_CALL_SIZE : sample_num - pos;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_process(handle, n, buf + pos * frame_size, buf + pos * frame_size));
+    }
+}
+
+/**
+ * RMS in dBFS of a tone processed by the handle, measured on the second half after the filters settle.
+ * A NULL handle measures the unprocessed tone
+ */
+static float mbc_n_test_tone(esp_ae_mbc_n_handle_t handle, uint32_t srate, uint8_t ch, uint8_t bits, float freq,
+                             float level_db)
+{
+    uint32_t sample_num = TEST_DURATION_MS * srate / 1000;
+    uint32_t frame_size = ch * (bits >> 3);
+    uint8_t *buf = (uint8_t *)calloc(sample_num, frame_size);
+    TEST_ASSERT_NOT_NULL(buf);
+    ae_test_generate_sine_signal(buf, TEST_DURATION_MS, srate, level_db, bits, ch, freq);
+    if (handle) {
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_reset(handle));
+        mbc_n_test_process(handle, buf, sample_num, frame_size);
+    }
+    float rms = ae_test_calculate_rms_dbfs(buf + sample_num / 2 * frame_size, sample_num / 2, bits, ch);
+    free(buf);
+    return rms;
+}
+
+/**
+ * With all ratios 1 the IIR tree is an allpass and the linear phase bank is a pure delay
+ */
+static void mbc_n_test_reconstruct(uint32_t srate, uint8_t ch, uint8_t bits, uint8_t bands,
+                                   esp_ae_mbc_n_crossover_t crossover)
+{
+    ESP_LOGI(TAG, "Reconstruct %s rate:%d ch:%d bits:%d bands:%d", crossover_name[crossover], (int)srate, ch, bits,
+             bands);
+    esp_ae_mbc_n_cfg_t cfg;
+    mbc_n_test_init_cfg(&cfg, srate, ch, bits, bands, crossover);
+    esp_ae_mbc_n_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_open(&cfg, &handle));
+    if (crossover == ESP_AE_MBC_N_CROSSOVER_IIR) {
+        float freq[] = {100.0f, 1000.0f, 3000.0f, srate * 0.4f};
+        for (int i = 0; i < AE_TEST_PARAM_NUM(freq); i++) {
+            float ref = mbc_n_test_tone(NULL, srate, ch, bits, freq[i], -6.0f);
+            float out = mbc_n_test_tone(handle, srate, ch, bits, freq[i], -6.0f);
+            TEST_ASSERT_FLOAT_WITHIN(0.1f, ref, out);
+        }
+    } else {
+        uint32_t latency = 0;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_latency(handle, &latency));
+        TEST_ASSERT_EQUAL(cfg.fir_len ? cfg.fir_len * 3 / 2 : ESP_AE_MBC_N_DEFAULT_FIR_LEN * 3 / 2, latency);
+        uint32_t sample_num = TEST_DURATION_MS * srate / 1000;
+        uint32_t frame_size = ch * (bits >> 3);
+        uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+        uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+        TEST_ASSERT_NOT_NULL(in);
+        TEST_ASSERT_NOT_NULL(out);
+        ae_test_generate_sweep_signal(in, TEST_DURATION_MS, srate, -3.0f, bits, ch);
+        memcpy(out, in, sample_num * frame_size);
+        mbc_n_test_process(handle, out, sample_num, frame_size);
+        // Error allowance of a few LSB of 16 bit for float rounding in the FFT
+        int32_t tolerance = 4 << (bits - 16);
+        for (uint32_t i = latency; i < sample_num; i++) {
+            for (int c = 0; c < ch; c++) {
+                int32_t x = ae_test_read_sample(in + (i - latency) * frame_size + c * (bits >> 3), bits);
+                int32_t y = ae_test_read_sample(out + i * frame_size + c * (bits >> 3), bits);
+                TEST_ASSERT_INT_WITHIN(tolerance, x, y);
+            }
+        }
+        free(in);
+        free(out);
+    }
+    esp_ae_mbc_n_close(handle);
+}
+
+TEST_CASE("MBC_N branch test", "AUDIO_EFFECT")
+{
+    esp_ae_mbc_n_cfg_t cfg;
+    mbc_n_test_init_cfg(&cfg, 48000, 2, 16, 4, ESP_AE_MBC_N_CROSSOVER_IIR);
+    esp_ae_mbc_n_handle_t handle = NULL;
+    uint8_t buf[64] = {0};
+    void *in_ch[2] = {buf, buf + 32};
+    void *bad_ch[2] = {buf, NULL};
+    esp_ae_mbc_para_t para = {0};
+    uint32_t fc = 0;
+    uint32_t latency = 0;
+    bool state = false;
+    float gr = 0.0f;
+    ESP_LOGI(TAG, "esp_ae_mbc_n_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, NULL));
+    cfg.sample_rate = 4000;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.sample_rate = 48000;
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.band_num = ESP_AE_MBC_N_MIN_BAND_NUM - 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.band_num = ESP_AE_MBC_N_MAX_BAND_NUM + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.band_num = 4;
+    cfg.crossover = ESP_AE_MBC_N_CROSSOVER_MAX;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.crossover = ESP_AE_MBC_N_CROSSOVER_LINEAR_PHASE;
+    cfg.fir_len = 1000;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.fir_len = ESP_AE_MBC_N_MAX_FIR_LEN * 2;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.fir_len = 0;
+    cfg.crossover = ESP_AE_MBC_N_CROSSOVER_IIR;
+    cfg.fc[1] = cfg.fc[0];
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.fc[1] = 1000;
+    cfg.fc[2] = 24000;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.fc[2] = 6000;
+    cfg.fc[0] = ESP_AE_MBC_N_MIN_FC - 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.fc[0] = 200;
+    cfg.mbc_para[3].ratio = 0.5f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    cfg.mbc_para[3].ratio = 2.0f;
+    cfg.mbc_para[3].attack_time = 501;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.mbc_para[3].attack_time = 5;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_process");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_process(NULL, 4, buf, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_process(handle, 4, NULL, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_process(handle, 4, buf, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_process(handle, 4, buf, buf));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_deintlv_process(NULL, 4, in_ch, in_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_deintlv_process(handle, 4, bad_ch, in_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_deintlv_process(handle, 4, in_ch, bad_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_deintlv_process(handle, 4, in_ch, in_ch));
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_set_para and get_para");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_para(NULL, 0, &para));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_para(handle, 4, &para));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_para(handle, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_para(handle, 3, &para));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, para.ratio);
+    para.makeup_gain = 11.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_para(handle, 0, &para));
+    para.makeup_gain = 3.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_para(NULL, 0, &para));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_para(handle, 4, &para));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_para(handle, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_para(handle, 0, &para));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_para(handle, 0, &para));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, para.makeup_gain);
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_set_fc and get_fc");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_fc(NULL, 0, 300));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_fc(handle, 3, 300));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_fc(handle, 0, 2000));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_fc(handle, 0, 300));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_fc(handle, 3, &fc));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_fc(handle, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_fc(handle, 0, &fc));
+    TEST_ASSERT_EQUAL(300, fc);
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_set_solo and set_bypass");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_solo(NULL, 0, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_solo(handle, 4, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_solo(handle, 1, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_solo(handle, 1, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_solo(handle, 1, &state));
+    TEST_ASSERT_TRUE(state);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_bypass(NULL, 0, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_set_bypass(handle, 4, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_bypass(handle, 2, true));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_bypass(handle, 2, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_bypass(handle, 2, &state));
+    TEST_ASSERT_TRUE(state);
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_get_latency and get_gain_reduction");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_latency(NULL, &latency));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_latency(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_latency(handle, &latency));
+    TEST_ASSERT_EQUAL(0, latency);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_gain_reduction(handle, 4, &gr));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_get_gain_reduction(handle, 0, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_gain_reduction(handle, 0, &gr));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gr);
+
+    ESP_LOGI(TAG, "esp_ae_mbc_n_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mbc_n_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_reset(handle));
+    esp_ae_mbc_n_close(handle);
+    esp_ae_mbc_n_close(NULL);
+}
+
+TEST_CASE("MBC_N crossover reconstruction test", "AUDIO_EFFECT")
+{
+    for (int x = 0; x < ESP_AE_MBC_N_CROSSOVER_MAX; x++) {
+        for (int sr_idx = 0; sr_idx < AE_TEST_PARAM_NUM(sample_rate); sr_idx++) {
+            for (int bit_idx = 0; bit_idx < AE_TEST_PARAM_NUM(bits_per_sample); bit_idx++) {
+                for (int ch_idx = 0; ch_idx < AE_TEST_PARAM_NUM(channel); ch_idx++) {
+                    for (int b_idx = 0; b_idx < AE_TEST_PARAM_NUM(band_num); b_idx++) {
+                        mbc_n_test_reconstruct(sample_rate[sr_idx], channel[ch_idx], bits_per_sample[bit_idx],
+                                               band_num[b_idx], (esp_ae_mbc_n_crossover_t)x);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("MBC_N band split and solo test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    // Tone in the middle of band 2 on a log scale, wide enough that the crossover slopes stay below 0.1 dB
+    float freq = sqrtf(500.0f * 10000.0f);
+    for (int x = 0; x < ESP_AE_MBC_N_CROSSOVER_MAX; x++) {
+        esp_ae_mbc_n_cfg_t cfg;
+        mbc_n_test_init_cfg(&cfg, srate, ch, bits, 4, (esp_ae_mbc_n_crossover_t)x);
+        cfg.fc[0] = 100;
+        cfg.fc[1] = 500;
+        cfg.fc[2] = 10000;
+        esp_ae_mbc_n_handle_t handle = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_open(&cfg, &handle));
+        float ref = mbc_n_test_tone(handle, srate, ch, bits, freq, -6.0f);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_solo(handle, 2, true));
+        float solo = mbc_n_test_tone(handle, srate, ch, bits, freq, -6.0f);
+        ESP_LOGI(TAG, "%s ref:%.2f solo band 2:%.2f", crossover_name[x], ref, solo);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, ref, solo);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_solo(handle, 2, false));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_solo(handle, 0, true));
+        solo = mbc_n_test_tone(handle, srate, ch, bits, freq, -6.0f);
+        ESP_LOGI(TAG, "%s solo band 0:%.2f", crossover_name[x], solo);
+        TEST_ASSERT_LESS_THAN(ref - 40.0f, solo);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_solo(handle, 0, false));
+
+        // Heavy compression of every band, bypass of the band holding the tone restores the level
+        for (int b = 0; b < cfg.band_num; b++) {
+            esp_ae_mbc_para_t para = cfg.mbc_para[b];
+            para.ratio = 10.0f;
+            para.threshold = -30.0f;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_para(handle, b, &para));
+        }
+        float comp = mbc_n_test_tone(handle, srate, ch, bits, freq, -6.0f);
+        TEST_ASSERT_LESS_THAN(ref - 15.0f, comp);
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_bypass(handle, 2, true));
+        float bypass = mbc_n_test_tone(handle, srate, ch, bits, freq, -6.0f);
+        ESP_LOGI(TAG, "%s compressed:%.2f bypass:%.2f", crossover_name[x], comp, bypass);
+        TEST_ASSERT_FLOAT_WITHIN(0.5f, ref, bypass);
+        esp_ae_mbc_n_close(handle);
+    }
+}
+
+TEST_CASE("MBC_N compression curve test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    float freq = 5000.0f;
+    float level = -6.0f;
+    esp_ae_mbc_n_cfg_t cfg;
+    mbc_n_test_init_cfg(&cfg, srate, ch, bits, 2, ESP_AE_MBC_N_CROSSOVER_IIR);
+    cfg.fc[0] = 1000;
+    esp_ae_mbc_n_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_open(&cfg, &handle));
+    float ref = mbc_n_test_tone(handle, srate, ch, bits, freq, level);
+    // Hard knee: 14 dB over the threshold at ratio 4 leaves 3.5 dB
+    esp_ae_mbc_para_t para = cfg.mbc_para[1];
+    para.ratio = 4.0f;
+    para.makeup_gain = 2.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_para(handle, 1, &para));
+    float out = mbc_n_test_tone(handle, srate, ch, bits, freq, level);
+    float gr = 0.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_gain_reduction(handle, 1, &gr));
+    ESP_LOGI(TAG, "Hard knee ref:%.2f out:%.2f gr:%.2f", ref, out, gr);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, -10.5f, gr);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, ref - 10.5f + 2.0f, out);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_gain_reduction(handle, 0, &gr));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gr);
+    // Soft knee centered on the level: a quarter of the knee slope
+    para.threshold = level;
+    para.knee_width = 10.0f;
+    para.makeup_gain = 0.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_set_para(handle, 1, &para));
+    out = mbc_n_test_tone(handle, srate, ch, bits, freq, level);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_get_gain_reduction(handle, 1, &gr));
+    ESP_LOGI(TAG, "Soft knee out:%.2f gr:%.2f", out, gr);
+    TEST_ASSERT_FLOAT_WITHIN(0.3f, -0.9375f, gr);
+    esp_ae_mbc_n_close(handle);
+}
+
+TEST_CASE("MBC_N performance test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    uint32_t sample_num = 1000 * srate / 1000;
+    uint32_t frame_size = ch * (bits >> 3);
+    uint8_t *in = (uint8_t *)calloc(sample_num, frame_size);
+    uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sweep_signal(in, 1000, srate, -3.0f, bits, ch);
+    for (int x = 0; x < ESP_AE_MBC_N_CROSSOVER_MAX; x++) {
+        for (uint8_t bands = ESP_AE_MBC_N_MIN_BAND_NUM; bands <= ESP_AE_MBC_N_MAX_BAND_NUM; bands++) {
+            esp_ae_mbc_n_cfg_t cfg;
+            mbc_n_test_init_cfg(&cfg, srate, ch, bits, bands, (esp_ae_mbc_n_crossover_t)x);
+            for (int b = 0; b < bands; b++) {
+                cfg.mbc_para[b].ratio = 3.0f;
+            }
+            esp_ae_mbc_n_handle_t handle = NULL;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_open(&cfg, &handle));
+            uint32_t start = esp_cpu_get_cycle_count();
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mbc_n_process(handle, sample_num, in, out));
+            uint32_t cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+            printf("MBC_N_PERF,crossover=%s,band_num=%d,cycles=%lu,cycles_per_sample=%.2f\n", crossover_name[x],
+                   bands, (unsigned long)cycles, (float)cycles / sample_num);
+            esp_ae_mbc_n_close(handle);
+        }
+    }
+    free(in);
+    free(out);
+}
@@ -0,0 +1,478 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_mix_bus.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_MIX_BUS"
+#define TEST_SRC_NUM     4
+#define TEST_MAX_SRC     16
+#define TEST_DURATION_MS 100
+#define TEST_CALL_SIZE   300
+#define TEST_RAMP_SIZE   1000
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+
+static float test_gain[TEST_SRC_NUM]  = {0.5f, 1.0f, 0.25f, 0.0f};
+static float test_freq[TEST_SRC_NUM]  = {300.0f, 1000.0f, 2500.0f, 5000.0f};
+
+static int64_t mix_bus_test_get(const uint8_t *buf, uint8_t bits, uint32_t idx)
+{
+    switch (bits) {
+        case 16:
+            return ((const int16_t *)buf)[idx];
+        case 24: {
+            const uint8_t *p = buf + idx * 3;
+            return (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8;
+        }
+        default:
+            return ((const int32_t *)buf)[idx];
+    }
+}
+
+static void mix_bus_test_deintlv(const uint8_t *in, uint8_t *out[], uint32_t sample_num, uint8_t bits, uint8_t ch)
+{
+    uint8_t bytes = bits >> 3;
+    for (uint32_t i = 0; i < sample_num; i++) {
+        for (int c = 0; c < ch; c++) {
+            memcpy(out[c] + i * bytes, in + (i * ch + c) * bytes, bytes);
+        }
+    }
+}
+
+/**
+ * Reference: double precision sum of `gain * input`, source 3 ramps from 0 to 1 over `TEST_RAMP_SIZE` samples
+ */
+static void mix_bus_test_check(uint8_t *in[], uint8_t *out, uint32_t sample_num, uint8_t bits, uint8_t ch)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    // Ramp gains are quantized to 22 fraction bits
+    double tol = bits == 32 ? 1024.0 : bits == 24 ? 2.0 : 1.0;
+    for (uint32_t i = 0; i < sample_num; i++) {
+        for (int c = 0; c < ch; c++) {
+            double ref = 0.0;
+            for (int s = 0; s < TEST_SRC_NUM; s++) {
+                double g = test_gain[s];
+                if (s == 3) {
+                    g = i < TEST_RAMP_SIZE ? (double)(i + 1) / TEST_RAMP_SIZE : 1.0;
+                }
+                ref += g * mix_bus_test_get(in[s], bits, i * ch + c);
+            }
+            ref = ref > max_val ? max_val : ref < -max_val - 1 ? -max_val - 1 : ref;
+            double diff = fabs(ref - (double)mix_bus_test_get(out, bits, i * ch + c));
+            if (diff > tol) {
+                ESP_LOGE(TAG, "Mismatch at %d ch %d ref %.1f diff %.1f", (int)i, c, ref, diff);
+                TEST_ASSERT_LESS_OR_EQUAL(tol, diff);
+            }
+        }
+    }
+}
+
+TEST_CASE("Mix bus branch test", "AUDIO_EFFECT")
+{
+    esp_ae_mix_bus_handle_t handle = NULL;
+    esp_ae_mix_bus_cfg_t cfg = {
+        .sample_rate = 48000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .max_src_num = 2,
+    };
+    ESP_LOGI(TAG, "esp_ae_mix_bus_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(&cfg, NULL));
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.max_src_num = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(&cfg, &handle));
+    cfg.max_src_num = ESP_AE_MIX_BUS_MAX_SRC_NUM + 1;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_open(&cfg, &handle));
+    cfg.max_src_num = 2;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_add_source");
+    uint8_t id0 = 0xFF;
+    uint8_t id1 = 0xFF;
+    uint8_t id2 = 0xFF;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_add_source(NULL, 1.0f, &id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_add_source(handle, 1.0f, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_add_source(handle, -0.1f, &id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_add_source(handle, ESP_AE_MIX_BUS_MAX_GAIN + 1.0f, &id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 1.0f, &id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 0.5f, &id1));
+    TEST_ASSERT_EQUAL(0, id0);
+    TEST_ASSERT_EQUAL(1, id1);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_MEM_LACK, esp_ae_mix_bus_add_source(handle, 1.0f, &id2));
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_remove_source");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_remove_source(NULL, id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_remove_source(handle, 2));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_remove_source(handle, id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_remove_source(handle, id0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 1.0f, &id2));
+    TEST_ASSERT_EQUAL(id0, id2);
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_set_gain");
+    float gain = 0.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain(NULL, id1, 1.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain(handle, 2, 1.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain(handle, id1, -1.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain(handle, id1, NAN, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_gain(handle, id1, 2.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_get_gain(NULL, id1, &gain));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_get_gain(handle, id1, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_gain(handle, id1, &gain));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, gain);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain_db(handle, id1, 25.0f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_gain_db(handle, id1, NAN, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_gain_db(handle, id1, -6.0206f, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_gain(handle, id1, &gain));
+    TEST_ASSERT_FLOAT_WITHIN(0.0001f, 0.5f, gain);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_gain_db(handle, id1, ESP_AE_MIX_BUS_MUTE_DB, 0));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_gain(handle, id1, &gain));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, gain);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_active(NULL, id1, false));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_set_active(handle, 2, false));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_active(handle, id1, false));
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_process");
+    int16_t in[64 * 2] = {0};
+    int16_t out[64 * 2] = {0};
+    esp_ae_sample_t in_src[2] = {in, NULL};
+    esp_ae_sample_t in_ch[2] = {in, in + 64};
+    esp_ae_sample_t *in_deintlv[2] = {in_ch, NULL};
+    esp_ae_sample_t out_ch[2] = {out, out + 64};
+    esp_ae_sample_t out_bad[2] = {out, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_process(NULL, 64, in_src, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_process(handle, 64, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_process(handle, 64, in_src, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, 64, in_src, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_deintlv_process(NULL, 64, in_deintlv, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_deintlv_process(handle, 64, NULL, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_deintlv_process(handle, 64, in_deintlv, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_deintlv_process(handle, 64, in_deintlv, out_bad));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_deintlv_process(handle, 64, in_deintlv, out_ch));
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_get_stats");
+    uint32_t mixed_num = 0;
+    uint32_t skip_num = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_get_stats(NULL, &mixed_num, &skip_num));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_stats(handle, &mixed_num, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_stats(handle, NULL, &skip_num));
+    // Source 0 is all zero in both calls, source 1 is paused and not counted
+    TEST_ASSERT_EQUAL(0, mixed_num);
+    TEST_ASSERT_EQUAL(2, skip_num);
+
+    ESP_LOGI(TAG, "esp_ae_mix_bus_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_reset(handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_mix_bus_get_gain(handle, id1, &gain));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_get_stats(handle, &mixed_num, &skip_num));
+    TEST_ASSERT_EQUAL(0, skip_num);
+    esp_ae_mix_bus_close(handle);
+    esp_ae_mix_bus_close(NULL);
+}
+
+TEST_CASE("Mix bus gain ramp accuracy test", "AUDIO_EFFECT")
+{
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+                uint8_t bits = bits_per_sample[b];
+                uint8_t ch = channel[c];
+                uint32_t sample_num = TEST_DURATION_MS * sample_rate[r] / 1000;
+                uint32_t frame_size = ch * (bits >> 3);
+                uint8_t *in[TEST_SRC_NUM] = {0};
+                uint8_t *in_ch[TEST_SRC_NUM][2] = {0};
+                for (int s = 0; s < TEST_SRC_NUM; s++) {
+                    in[s] = (uint8_t *)calloc(sample_num, frame_size);
+                    TEST_ASSERT_NOT_NULL(in[s]);
+                    ae_test_generate_sine_signal(in[s], TEST_DURATION_MS, sample_rate[r], -6.0f, bits, ch, test_freq[s]);
+                    for (int k = 0; k < ch; k++) {
+                        in_ch[s][k] = (uint8_t *)calloc(sample_num, bits >> 3);
+                        TEST_ASSERT_NOT_NULL(in_ch[s][k]);
+                    }
+                    mix_bus_test_deintlv(in[s], in_ch[s], sample_num, bits, ch);
+                }
+                uint8_t *out = (uint8_t *)calloc(sample_num, frame_size);
+                uint8_t *out_ch[2] = {0};
+                uint8_t *out_cmp = (uint8_t *)calloc(sample_num, frame_size);
+                TEST_ASSERT_NOT_NULL(out);
+                TEST_ASSERT_NOT_NULL(out_cmp);
+                for (int k = 0; k < ch; k++) {
+                    out_ch[k] = (uint8_t *)calloc(sample_num, bits >> 3);
+                    TEST_ASSERT_NOT_NULL(out_ch[k]);
+                }
+                esp_ae_mix_bus_cfg_t cfg = {
+                    .sample_rate = sample_rate[r],
+                    .channel = ch,
+                    .bits_per_sample = bits,
+                    .max_src_num = TEST_SRC_NUM,
+                };
+                esp_ae_mix_bus_handle_t intlv = NULL;
+                esp_ae_mix_bus_handle_t deintlv = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &intlv));
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &deintlv));
+                for (int s = 0; s < TEST_SRC_NUM; s++) {
+                    uint8_t id = 0;
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(intlv, test_gain[s], &id));
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(deintlv, test_gain[s], &id));
+                }
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_gain(intlv, 3, 1.0f, TEST_RAMP_SIZE));
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_set_gain(deintlv, 3, 1.0f, TEST_RAMP_SIZE));
+                // Call size not aligned to internal block to cover ramps across calls
+                for (uint32_t pos = 0; pos < sample_num; pos += TEST_CALL_SIZE) {
+                    uint32_t n = sample_num - pos < TEST_CALL_SIZE ? sample_num - pos : TEST_CALL_SIZE;
+                    uint32_t byte_pos = pos * frame_size;
+                    uint32_t ch_pos = pos * (bits >> 3);
+                    esp_ae_sample_t src[TEST_SRC_NUM];
+                    esp_ae_sample_t src_ch[TEST_SRC_NUM][2];
+                    esp_ae_sample_t *src_deintlv[TEST_SRC_NUM];
+                    esp_ae_sample_t dst_ch[2];
+                    for (int s = 0; s < TEST_SRC_NUM; s++) {
+                        src[s] = in[s] + byte_pos;
+                        for (int k = 0; k < ch; k++) {
+                            src_ch[s][k] = in_ch[s][k] + ch_pos;
+                        }
+                        src_deintlv[s] = src_ch[s];
+                    }
+                    for (int k = 0; k < ch; k++) {
+                        dst_ch[k] = out_ch[k] + ch_pos;
+                    }
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(intlv, n, src, out + byte_pos));
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_deintlv_process(deintlv, n, src_deintlv, dst_ch));
+                }
+                float gain = 0.0f;
+                esp_ae_mix_bus_get_gain(intlv, 3, &gain);
+                TEST_ASSERT_EQUAL_FLOAT(1.0f, gain);
+                mix_bus_test_check(in, out, sample_num, bits, ch);
+                // Deinterleaved path must give the same result
+                uint8_t *out_ch_u8[2] = {out_ch[0], out_ch[1]};
+                for (uint32_t i = 0; i < sample_num; i++) {
+                    for (int k = 0; k < ch; k++) {
+                        memcpy(out_cmp + (i * ch + k) * (bits >> 3), out_ch_u8[k] + i * (bits >> 3), bits >> 3);
+                    }
+                }
+                TEST_ASSERT_EQUAL_MEMORY(out, out_cmp, sample_num * frame_size);
+                esp_ae_mix_bus_close(intlv);
+                esp_ae_mix_bus_close(deintlv);
+                for (int s = 0; s < TEST_SRC_NUM; s++) {
+                    free(in[s]);
+                    for (int k = 0; k < ch; k++) {
+                        free(in_ch[s][k]);
+                    }
+                }
+                for (int k = 0; k < ch; k++) {
+                    free(out_ch[k]);
+                }
+                free(out);
+                free(out_cmp);
+            }
+        }
+    }
+}
+
+TEST_CASE("Mix bus sparse source and saturation test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    uint32_t sample_num = 1024;
+    int16_t *tone = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *silence = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *full = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *ref = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(tone);
+    TEST_ASSERT_NOT_NULL(silence);
+    TEST_ASSERT_NOT_NULL(full);
+    TEST_ASSERT_NOT_NULL(out);
+    TEST_ASSERT_NOT_NULL(ref);
+    ae_test_generate_sine_signal(tone, sample_num * 1000 / srate, srate, -20.0f, bits, ch, 1000.0f);
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        full[i] = INT16_MAX;
+    }
+    esp_ae_mix_bus_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .max_src_num = TEST_MAX_SRC,
+    };
+    esp_ae_mix_bus_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &handle));
+    uint8_t id = 0;
+    for (int s = 0; s < TEST_MAX_SRC; s++) {
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 1.0f, &id));
+    }
+    // Only source 0 is audible: others are silent, NULL, paused or muted
+    esp_ae_sample_t in[TEST_MAX_SRC];
+    for (int s = 0; s < TEST_MAX_SRC; s++) {
+        in[s] = silence;
+    }
+    in[0] = tone;
+    in[1] = NULL;
+    in[2] = full;
+    in[3] = full;
+    esp_ae_mix_bus_set_active(handle, 2, false);
+    esp_ae_mix_bus_set_gain(handle, 3, 0.0f, 0);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(tone, out, sample_num * ch * sizeof(int16_t));
+    uint32_t mixed_num = 0;
+    uint32_t skip_num = 0;
+    esp_ae_mix_bus_get_stats(handle, &mixed_num, &skip_num);
+    // 1024 samples are 4 internal blocks, the paused source is not counted
+    TEST_ASSERT_EQUAL(4, mixed_num);
+    TEST_ASSERT_EQUAL(4 * (TEST_MAX_SRC - 2), skip_num);
+
+    // Four full scale sources saturate once at the output instead of wrapping
+    esp_ae_mix_bus_set_active(handle, 2, true);
+    esp_ae_mix_bus_set_gain(handle, 3, 1.0f, 0);
+    in[1] = full;
+    in[4] = full;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(full, out, sample_num * ch * sizeof(int16_t));
+
+    // Positive and negative sources cancel in the wide accumulator before saturation
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        ref[i] = -INT16_MAX;
+    }
+    in[0] = silence;
+    in[1] = full;
+    in[2] = full;
+    in[3] = ref;
+    in[4] = ref;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(silence, out, sample_num * ch * sizeof(int16_t));
+
+    // Everything silent gives silence without mixing
+    for (int s = 0; s < TEST_MAX_SRC; s++) {
+        in[s] = silence;
+    }
+    memset(out, 0x55, sample_num * ch * sizeof(int16_t));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(silence, out, sample_num * ch * sizeof(int16_t));
+    esp_ae_mix_bus_close(handle);
+    free(tone);
+    free(silence);
+    free(full);
+    free(out);
+    free(ref);
+}
+
+TEST_CASE("Mix bus s32 unity passthrough test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 32;
+    uint32_t sample_num = 1024;
+    int32_t *tone = (int32_t *)calloc(sample_num, sizeof(int32_t) * ch);
+    int32_t *neg = (int32_t *)calloc(sample_num, sizeof(int32_t) * ch);
+    int32_t *out = (int32_t *)calloc(sample_num, sizeof(int32_t) * ch);
+    TEST_ASSERT_NOT_NULL(tone);
+    TEST_ASSERT_NOT_NULL(neg);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sine_signal(tone, sample_num * 1000 / srate, srate, -1.0f, bits, ch, 997.0f);
+    // Odd low bits would be lost by a 24 bit mantissa accumulator
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        tone[i] |= 1;
+        neg[i] = -tone[i];
+    }
+    esp_ae_mix_bus_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .max_src_num = TEST_MAX_SRC,
+    };
+    esp_ae_mix_bus_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &handle));
+    uint8_t id = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 1.0f, &id));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_add_source(handle, 1.0f, &id));
+    esp_ae_sample_t in[TEST_MAX_SRC] = {tone, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(tone, out, sample_num * ch * sizeof(int32_t));
+
+    // Full scale source plus its negation cancels exactly
+    in[1] = neg;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    for (uint32_t i = 0; i < sample_num * ch; i++) {
+        TEST_ASSERT_EQUAL_INT32(0, out[i]);
+    }
+
+    // Two half gain copies add back to the original
+    in[1] = tone;
+    esp_ae_mix_bus_set_gain(handle, 0, 0.5f, 0);
+    esp_ae_mix_bus_set_gain(handle, 1, 0.5f, 0);
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_process(handle, sample_num, in, out));
+    TEST_ASSERT_EQUAL_MEMORY(tone, out, sample_num * ch * sizeof(int32_t));
+    esp_ae_mix_bus_close(handle);
+    free(tone);
+    free(neg);
+    free(out);
+}
+
+TEST_CASE("Mix bus performance test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 48000;
+    uint8_t ch = 2;
+    uint8_t bits = 16;
+    uint32_t sample_num = 480;
+    uint32_t loop = 100;
+    int16_t *tone = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *silence = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t) * ch);
+    TEST_ASSERT_NOT_NULL(tone);
+    TEST_ASSERT_NOT_NULL(silence);
+    TEST_ASSERT_NOT_NULL(out);
+    ae_test_generate_sine_signal(tone, 10, srate, -20.0f, bits, ch, 1000.0f);
+    esp_ae_mix_bus_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = ch,
+        .bits_per_sample = bits,
+        .max_src_num = TEST_MAX_SRC,
+    };
+    uint8_t active_num[] = {16, 8, 4, 1};
+    for (int a = 0; a < AE_TEST_PARAM_NUM(active_num); a++) {
+        esp_ae_mix_bus_handle_t handle = NULL;
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_mix_bus_open(&cfg, &handle));
+        esp_ae_sample_t in[TEST_MAX_SRC];
+        for (int s = 0; s < TEST_MAX_SRC; s++) {
+            uint8_t id = 0;
+            esp_ae_mix_bus_add_source(handle, 1.0f / TEST_MAX_SRC, &id);
+            in[s] = s < active_num[a] ? tone : silence;
+        }
+        // Keep one source ramping to include per sample gain cost
+        esp_ae_mix_bus_set_gain(handle, 0, 0.5f, sample_num * loop);
+        uint64_t cycles = 0;
+        for (uint32_t i = 0; i < loop; i++) {
+            uint32_t start = esp_cpu_get_cycle_count();
+            esp_ae_mix_bus_process(handle, sample_num, in, out);
+            cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+        }
+        printf("MIX_BUS_PERF,src=%d,active=%d,cycles_per_sample=%.2f\n", TEST_MAX_SRC, active_num[a],
+               (float)cycles / (sample_num * loop));
+        esp_ae_mix_bus_close(handle);
+    }
+    free(tone);
+    free(silence);
+    free(out);
+}
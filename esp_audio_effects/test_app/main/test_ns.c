@@ -0,0 +1,383 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO., LTD
+ * SPDX-License-Identifier: LicenseRef-Espressif-Modified-MIT
+ *
+ * See LICENSE file for details.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_system.h"
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_cpu.h"
+#include "esp_ae_ns.h"
+#include "ae_common.h"
+
+#define TAG              "TEST_NS"
+#define TEST_DURATION_MS 6000
+#define TEST_SUPPRESS_DB (-20.0f)
+#define TEST_SPEECH_DB   (-20.0)
+#define TEST_NOISE_DB    (-32.0)
+#define TEST_SETTLE_MS   1500
+
+static uint32_t sample_rate[]     = {16000, 48000};
+static uint8_t  bits_per_sample[] = {16, 24, 32};
+static uint8_t  channel[]         = {1, 2};
+
+static double ns_test_get(const uint8_t *buf, uint8_t bits, uint32_t idx)
+{
+    double scale = (double)(1ULL << (bits - 1));
+    switch (bits) {
+        case 16:
+            return ((const int16_t *)buf)[idx] / scale;
+        case 24: {
+            const uint8_t *p = buf + idx * 3;
+            return ((int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 24)) >> 8) / scale;
+        }
+        default:
+            return ((const int32_t *)buf)[idx] / scale;
+    }
+}
+
+static void ns_test_set(uint8_t *buf, uint8_t bits, uint32_t idx, double v)
+{
+    double max_val = (double)((1ULL << (bits - 1)) - 1);
+    v *= max_val + 1.0;
+    v = v > max_val ? max_val : v < -max_val - 1.0 ? -max_val - 1.0 : v;
+    int32_t s = (int32_t)lrint(v);
+    switch (bits) {
+        case 16:
+            ((int16_t *)buf)[idx] = (int16_t)s;
+            break;
+        case 24: {
+            uint8_t *p = buf + idx * 3;
+            p[0] = (uint8_t)s;
+            p[1] = (uint8_t)(s >> 8);
+            p[2] = (uint8_t)(s >> 16);
+            break;
+        }
+        default:
+            ((int32_t *)buf)[idx] = s;
+            break;
+    }
+}
+
+/**
+ * Voiced syllables of gliding pitch with 1/h harmonics, 250 ms on and 200 ms off after `TEST_SETTLE_MS` of silence,
+ * scaled to `TEST_SPEECH_DB` RMS while active
+ */
+static void ns_test_gen_speech(float *clean, uint32_t sample_num, uint32_t srate)
+{
+    uint32_t settle = TEST_SETTLE_MS * srate / 1000;
+    uint32_t period = 450 * srate / 1000;
+    uint32_t active = 250 * srate / 1000;
+    double phase = 0.0;
+    double norm = 0.0;
+    for (int h = 1; h <= 20; h++) {
+        norm += 0.5 / (h * h);
+    }
+    double amp = pow(10.0, TEST_SPEECH_DB / 20.0) / sqrt(norm);
+    for (uint32_t i = 0; i < sample_num; i++) {
+        clean[i] = 0.0f;
+        if (i < settle || (i - settle) % period >= active) {
+            continue;
+        }
+        uint32_t pos = (i - settle) % period;
+        double f0 = 120.0 + 30.0 * pos / active;
+        phase += 2.0 * M_PI * f0 / srate;
+        double env = sin(M_PI * pos / active);
+        double v = 0.0;
+        for (int h = 1; h <= 20 && h * f0 < 4000.0; h++) {
+            v += sin(h * phase) / h;
+        }
+        clean[i] = (float)(amp * env * v);
+    }
+}
+
+/**
+ * Stationary noise with a gently falling spectrum like a fan, uniform white noise through a one pole lowpass
+ */
+static void ns_test_gen_noise(float *noise, uint32_t sample_num, uint32_t seed)
+{
+    uint32_t rnd = seed;
+    double lp = 0.0;
+    double sum = 0.0;
+    for (uint32_t i = 0; i < sample_num; i++) {
+        rnd = rnd * 1664525u + 1013904223u;
+        double w = (double)(int32_t)rnd / 2147483648.0;
+        lp = 0.5 * lp + w;
+        noise[i] = (float)lp;
+        sum += lp * lp;
+    }
+    double gain = pow(10.0, TEST_NOISE_DB / 20.0) / sqrt(sum / sample_num);
+    for (uint32_t i = 0; i < sample_num; i++) {
+        noise[i] *= (float)gain;
+    }
+}
+
+TEST_CASE("NS branch test", "AUDIO_EFFECT")
+{
+    esp_ae_ns_handle_t handle = NULL;
+    esp_ae_ns_cfg_t cfg = {
+        .sample_rate = 16000,
+        .channel = 2,
+        .bits_per_sample = 16,
+        .suppress_db = -20.0f,
+    };
+    ESP_LOGI(TAG, "esp_ae_ns_open");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(NULL, &handle));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, NULL));
+    cfg.sample_rate = 22050;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    TEST_ASSERT_NULL(handle);
+    cfg.sample_rate = 16000;
+    cfg.channel = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    cfg.channel = 2;
+    cfg.bits_per_sample = 8;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    cfg.bits_per_sample = 16;
+    cfg.suppress_db = -41.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    cfg.suppress_db = -2.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    cfg.suppress_db = NAN;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_open(&cfg, &handle));
+    cfg.suppress_db = -20.0f;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_open(&cfg, &handle));
+    TEST_ASSERT_NOT_NULL(handle);
+
+    ESP_LOGI(TAG, "esp_ae_ns_get_frame_size");
+    uint32_t frame_size = 0;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_get_frame_size(NULL, &frame_size));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_get_frame_size(handle, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_get_frame_size(handle, &frame_size));
+    TEST_ASSERT_EQUAL(256 * 2 * sizeof(int16_t), frame_size);
+
+    ESP_LOGI(TAG, "esp_ae_ns_process");
+    int16_t in[256 * 2] = {0};
+    int16_t out[256 * 2] = {0};
+    esp_ae_sample_t in_ch[2] = {in, in + 256};
+    esp_ae_sample_t out_ch[2] = {out, out + 256};
+    esp_ae_sample_t out_bad[2] = {out, NULL};
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_process(NULL, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_process(handle, NULL, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_process(handle, in, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_process(handle, in, out));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_deintlv_process(NULL, in_ch, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_deintlv_process(handle, NULL, out_ch));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_deintlv_process(handle, in_ch, NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_deintlv_process(handle, in_ch, out_bad));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_deintlv_process(handle, in_ch, out_ch));
+    for (int i = 0; i < 256 * 2; i++) {
+        TEST_ASSERT_EQUAL(0, out[i]);
+    }
+
+    ESP_LOGI(TAG, "esp_ae_ns_set_suppress");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_set_suppress(NULL, -10.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_set_suppress(handle, -50.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_set_suppress(handle, 0.0f));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_set_suppress(handle, -10.0f));
+
+    ESP_LOGI(TAG, "esp_ae_ns_reset");
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_INVALID_PARAMETER, esp_ae_ns_reset(NULL));
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_reset(handle));
+    esp_ae_ns_close(handle);
+    esp_ae_ns_close(NULL);
+}
+
+TEST_CASE("NS noise reduction quality test", "AUDIO_EFFECT")
+{
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        uint32_t srate = sample_rate[r];
+        uint32_t sample_num = TEST_DURATION_MS * srate / 1000;
+        uint32_t settle = TEST_SETTLE_MS * srate / 1000;
+        float *clean = (float *)calloc(sample_num, sizeof(float));
+        float *noise = (float *)calloc(sample_num, sizeof(float));
+        TEST_ASSERT_NOT_NULL(clean);
+        TEST_ASSERT_NOT_NULL(noise);
+        ns_test_gen_speech(clean, sample_num, srate);
+        for (int b = 0; b < AE_TEST_PARAM_NUM(bits_per_sample); b++) {
+            for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+                uint8_t bits = bits_per_sample[b];
+                uint8_t ch = channel[c];
+                uint8_t bytes = bits >> 3;
+                esp_ae_ns_cfg_t cfg = {
+                    .sample_rate = srate,
+                    .channel = ch,
+                    .bits_per_sample = bits,
+                    .suppress_db = TEST_SUPPRESS_DB,
+                };
+                esp_ae_ns_handle_t intlv = NULL;
+                esp_ae_ns_handle_t deintlv = NULL;
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_open(&cfg, &intlv));
+                TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_open(&cfg, &deintlv));
+                uint32_t frame_size = 0;
+                esp_ae_ns_get_frame_size(intlv, &frame_size);
+                uint32_t hop = frame_size / (ch * bytes);
+                uint32_t frames = sample_num / hop;
+                uint8_t *in = (uint8_t *)calloc(sample_num, ch * bytes);
+                uint8_t *out = (uint8_t *)calloc(sample_num, ch * bytes);
+                uint8_t *in_ch[2] = {0};
+                uint8_t *out_ch[2] = {0};
+                TEST_ASSERT_NOT_NULL(in);
+                TEST_ASSERT_NOT_NULL(out);
+                for (int k = 0; k < ch; k++) {
+                    in_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                    out_ch[k] = (uint8_t *)calloc(sample_num, bytes);
+                    TEST_ASSERT_NOT_NULL(in_ch[k]);
+                    TEST_ASSERT_NOT_NULL(out_ch[k]);
+                }
+                // Every channel has its own noise
+                for (int k = 0; k < ch; k++) {
+                    ns_test_gen_noise(noise, sample_num, 12345u + k);
+                    for (uint32_t i = 0; i < sample_num; i++) {
+                        ns_test_set(in, bits, i * ch + k, clean[i] + noise[i]);
+                        memcpy(in_ch[k] + i * bytes, in + (i * ch + k) * bytes, bytes);
+                    }
+                }
+                for (uint32_t f = 0; f < frames; f++) {
+                    esp_ae_sample_t src_ch[2];
+                    esp_ae_sample_t dst_ch[2];
+                    for (int k = 0; k < ch; k++) {
+                        src_ch[k] = in_ch[k] + f * hop * bytes;
+                        dst_ch[k] = out_ch[k] + f * hop * bytes;
+                    }
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_process(intlv, in + f * frame_size, out + f * frame_size));
+                    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_deintlv_process(deintlv, src_ch, dst_ch));
+                }
+                for (int k = 0; k < ch; k++) {
+                    // Noise only part after the estimate settled, output is delayed by one frame
+                    double in_noise = 0.0;
+                    double out_noise = 0.0;
+                    for (uint32_t i = settle / 2; i < settle - hop; i++) {
+                        in_noise += pow(ns_test_get(in, bits, i * ch + k), 2);
+                        out_noise += pow(ns_test_get(out, bits, (i + hop) * ch + k), 2);
+                    }
+                    // SNR against the clean speech over the speech part
+                    double sig = 0.0;
+                    double in_err = 0.0;
+                    double out_err = 0.0;
+                    for (uint32_t i = settle; i + hop < frames * hop; i++) {
+                        sig += (double)clean[i] * clean[i];
+                        in_err += pow(ns_test_get(in, bits, i * ch + k) - clean[i], 2);
+                        out_err += pow(ns_test_get(out, bits, (i + hop) * ch + k) - clean[i], 2);
+                    }
+                    double atten_db = 10.0 * log10(out_noise / in_noise);
+                    double snr_in = 10.0 * log10(sig / in_err);
+                    double snr_out = 10.0 * log10(sig / out_err);
+                    ESP_LOGI(TAG, "rate %d bits %d ch %d/%d noise attenuation %.2f dB SNR %.2f -> %.2f dB",
+                             (int)srate, bits, k, ch, atten_db, snr_in, snr_out);
+                    TEST_ASSERT_TRUE(atten_db < TEST_SUPPRESS_DB + 4.0);
+                    TEST_ASSERT_TRUE(atten_db > TEST_SUPPRESS_DB - 1.0);
+                    TEST_ASSERT_TRUE(snr_out > snr_in + 2.0);
+                }
+                for (int k = 0; k < ch; k++) {
+                    for (uint32_t i = 0; i < frames * hop; i++) {
+                        TEST_ASSERT_EQUAL_MEMORY(out + (i * ch + k) * bytes, out_ch[k] + i * bytes, bytes);
+                    }
+                }
+                esp_ae_ns_close(intlv);
+                esp_ae_ns_close(deintlv);
+                for (int k = 0; k < ch; k++) {
+                    free(in_ch[k]);
+                    free(out_ch[k]);
+                }
+                free(in);
+                free(out);
+            }
+        }
+        free(clean);
+        free(noise);
+    }
+}
+
+TEST_CASE("NS suppress level and reset test", "AUDIO_EFFECT")
+{
+    uint32_t srate = 16000;
+    uint32_t sample_num = 2 * srate;
+    float suppress_db[] = {-6.0f, -12.0f, -20.0f};
+    float *noise = (float *)calloc(sample_num, sizeof(float));
+    int16_t *in = (int16_t *)calloc(sample_num, sizeof(int16_t));
+    int16_t *out = (int16_t *)calloc(sample_num, sizeof(int16_t));
+    TEST_ASSERT_NOT_NULL(noise);
+    TEST_ASSERT_NOT_NULL(in);
+    TEST_ASSERT_NOT_NULL(out);
+    ns_test_gen_noise(noise, sample_num, 777u);
+    for (uint32_t i = 0; i < sample_num; i++) {
+        ns_test_set((uint8_t *)in, 16, i, noise[i]);
+    }
+    esp_ae_ns_cfg_t cfg = {
+        .sample_rate = srate,
+        .channel = 1,
+        .bits_per_sample = 16,
+        .suppress_db = -3.0f,
+    };
+    esp_ae_ns_handle_t handle = NULL;
+    TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_open(&cfg, &handle));
+    uint32_t frame_size = 0;
+    esp_ae_ns_get_frame_size(handle, &frame_size);
+    uint32_t hop = frame_size / sizeof(int16_t);
+    for (int s = 0; s < AE_TEST_PARAM_NUM(suppress_db); s++) {
+        // Stationary noise is attenuated to the configured level, inplace processing
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_reset(handle));
+        TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_set_suppress(handle, suppress_db[s]));
+        memcpy(out, in, sample_num * sizeof(int16_t));
+        for (uint32_t pos = 0; pos + hop <= sample_num; pos += hop) {
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_process(handle, out + pos, out + pos));
+        }
+        double in_pow = 0.0;
+        double out_pow = 0.0;
+        for (uint32_t i = sample_num / 2; i < sample_num - 2 * hop; i++) {
+            in_pow += (double)in[i] * in[i];
+            out_pow += (double)out[i + hop] * out[i + hop];
+        }
+        double atten_db = 10.0 * log10(out_pow / in_pow);
+        ESP_LOGI(TAG, "suppress %.1f dB noise attenuation %.2f dB", suppress_db[s], atten_db);
+        TEST_ASSERT_FLOAT_WITHIN(3.0f, suppress_db[s], (float)atten_db);
+    }
+    esp_ae_ns_close(handle);
+    free(noise);
+    free(in);
+    free(out);
+}
+
+TEST_CASE("NS performance test", "AUDIO_EFFECT")
+{
+    uint32_t loop = 50;
+    for (int r = 0; r < AE_TEST_PARAM_NUM(sample_rate); r++) {
+        for (int c = 0; c < AE_TEST_PARAM_NUM(channel); c++) {
+            esp_ae_ns_cfg_t cfg = {
+                .sample_rate = sample_rate[r],
+                .channel = channel[c],
+                .bits_per_sample = 16,
+                .suppress_db = TEST_SUPPRESS_DB,
+            };
+            esp_ae_ns_handle_t handle = NULL;
+            TEST_ASSERT_EQUAL(ESP_AE_ERR_OK, esp_ae_ns_open(&cfg, &handle));
+            uint32_t frame_size = 0;
+            esp_ae_ns_get_frame_size(handle, &frame_size);
+            uint32_t hop = frame_size / (channel[c] * sizeof(int16_t));
+            int16_t *in = (int16_t *)calloc(1, frame_size);
+            int16_t *out = (int16_t *)calloc(1, frame_size);
+            TEST_ASSERT_NOT_NULL(in);
+            TEST_ASSERT_NOT_NULL(out);
+            ae_test_generate_sine_signal(in, hop * 1000 / sample_rate[r], sample_rate[r], -20.0f, 16, channel[c],
+                                         1000.0f);
+            uint64_t cycles = 0;
+            for (uint32_t i = 0; i < loop; i++) {
+                uint32_t start = esp_cpu_get_cycle_count();
+                esp_ae_ns_process(handle, in, out);
+                cycles += (uint32_t)(esp_cpu_get_cycle_count() - start);
+            }
+            printf("NS_PERF,sample_rate=%d,channel=%d,frame=%d,cycles_per_frame=%d,cycles_per_sample=%.2f\n",
+                   (int)sample_rate[r], channel[c], (int)hop, (int)(cycles / loop), (float)cycles / (hop * loop));
+            esp_ae_ns_close(handle);
+            free(in);
+            free(out);
+        }
+    }
+}